@@ -12,6 +12,7 @@
  */
 #include "postgres.h"
 
+#include <float.h>
 #include <limits.h>
 
 #include "access/parallel.h"
@@ -20,6 +21,7 @@
 #include "commands/explain_state.h"
 #include "common/pg_prng.h"
 #include "executor/instrument.h"
+#include "nodes/nodeFuncs.h"
 #include "utils/guc.h"
 
 PG_MODULE_MAGIC_EXT(
@@ -41,6 +43,7 @@ static int	auto_explain_log_format = EXPLAIN_FORMAT_TEXT;
 static int	auto_explain_log_level = LOG;
 static bool auto_explain_log_nested_statements = false;
 static double auto_explain_sample_rate = 1;
+static double auto_explain_log_misestimate_factor = 0;	/* 0 disables */
 
 static const struct config_enum_entry format_options[] = {
 	{"text", EXPLAIN_FORMAT_TEXT, false},
@@ -87,6 +90,7 @@ static void explain_ExecutorRun(QueryDesc *queryDesc,
 								uint64 count);
 static void explain_ExecutorFinish(QueryDesc *queryDesc);
 static void explain_ExecutorEnd(QueryDesc *queryDesc);
+static bool explain_misestimate_walker(PlanState *planstate, void *context);
 
 
 /*
@@ -232,6 +236,18 @@ _PG_init(void)
 							 NULL,
 							 NULL);
 
+	DefineCustomRealVariable("auto_explain.log_misestimate_factor",
+							 "Log plans in which a node's actual row count is off from the planner's estimate by this factor.",
+							 "Zero disables misestimate-based logging. This has no effect unless log_analyze is also set.",
+							 &auto_explain_log_misestimate_factor,
+							 0.0,
+							 0.0, DBL_MAX,
+							 PGC_SUSET,
+							 0,
+							 NULL,
+							 NULL,
+							 NULL);
+
 	DefineCustomRealVariable("auto_explain.sample_rate",
 							 "Fraction of queries to process.",
 							 NULL,
@@ -387,9 +403,12 @@ explain_ExecutorEnd(QueryDesc *queryDesc)
 		 */
 		InstrEndLoop(queryDesc->totaltime);
 
-		/* Log plan if duration is exceeded. */
+		/* Log plan if duration is exceeded or the plan was misestimated. */
 		msec = queryDesc->totaltime->total * 1000.0;
-		if (msec >= auto_explain_log_min_duration)
+		if (msec >= auto_explain_log_min_duration ||
+			(auto_explain_log_misestimate_factor > 0 &&
+			 queryDesc->instrument_options && auto_explain_log_analyze &&
+			 explain_misestimate_walker(queryDesc->planstate, NULL)))
 		{
 			ExplainState *es = NewExplainState();
 
@@ -445,3 +464,42 @@ explain_ExecutorEnd(QueryDesc *queryDesc)
 	else
 		standard_ExecutorEnd(queryDesc);
 }
+
+/*
+ * Walk the planstate tree to find a node whose actual row count diverged from
+ * the planner's estimate by at least auto_explain_log_misestimate_factor.
+ *
+ * Chronic misestimates are usually caused by correlated predicates, and the
+ * offending plan nodes point at the columns that could use extended
+ * statistics, so they are worth logging even when the query happens to finish
+ * below log_min_duration.
+ */
+static bool
+explain_misestimate_walker(PlanState *planstate, void *context)
+{
+	Instrumentation *instr = planstate->instrument;
+
+	if (instr != NULL)
+	{
+		/* Make sure stats accumulation is done, as ExplainNode() would */
+		InstrEndLoop(instr);
+
+		if (instr->nloops > 0)
+		{
+			double		estimated = planstate->plan->plan_rows;
+			double		actual = instr->ntuples / instr->nloops;
+
+			/*
+			 * Clamp the smaller row count to 1 so that nodes expected to
+			 * produce few rows and actually producing none don't qualify.
+			 */
+			if (Max(estimated, actual) >=
+				auto_explain_log_misestimate_factor *
+				Max(1.0, Min(estimated, actual)))
+				return true;
+		}
+	}
+
+	return planstate_tree_walker(planstate, explain_misestimate_walker,
+								 context);
+}
@@ -135,6 +135,35 @@ unlike(
 	qr/Query Identifier:/,
 	"query identifier not logged with compute_query_id=regress, text mode");
 
+# Misestimated query logged despite finishing below log_min_duration.
+# unnest's default row estimate is 100, but it returns a single row here.
+$log_contents = query_log(
+	$node,
+	"SELECT * FROM unnest(ARRAY[1]);",
+	{
+		"auto_explain.log_min_duration" => "1h",
+		"auto_explain.log_misestimate_factor" => "50"
+	});
+
+like(
+	$log_contents,
+	qr/Function Scan on unnest/,
+	"misestimated query logged");
+
+# Accurately estimated query is not logged below log_min_duration.
+$log_contents = query_log(
+	$node,
+	"SELECT 1;",
+	{
+		"auto_explain.log_min_duration" => "1h",
+		"auto_explain.log_misestimate_factor" => "50"
+	});
+
+unlike(
+	$log_contents,
+	qr/Query Text:/,
+	"accurately estimated query not logged");
+
 # JSON format.
 $log_contents = query_log(
 	$node,
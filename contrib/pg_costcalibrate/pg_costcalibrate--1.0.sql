@@ -0,0 +1,22 @@
+/* contrib/pg_costcalibrate/pg_costcalibrate--1.0.sql */
+
+-- complain if script is sourced in psql, rather than via CREATE EXTENSION
+\echo Use "CREATE EXTENSION pg_costcalibrate" to load this file. \quit
+
+CREATE FUNCTION pg_calibrate_page_costs(regclass,
+										nblocks int4 default 1024,
+										OUT seq_page_usec float8,
+										OUT random_page_usec float8,
+										OUT suggested_random_page_cost float8)
+RETURNS record
+AS 'MODULE_PATHNAME', 'pg_calibrate_page_costs'
+LANGUAGE C STRICT PARALLEL UNSAFE;
+
+CREATE FUNCTION pg_calibrate_tuple_cost(regclass,
+										seq_page_usec float8,
+										OUT ntuples int8,
+										OUT tuple_usec float8,
+										OUT suggested_cpu_tuple_cost float8)
+RETURNS record
+AS 'MODULE_PATHNAME', 'pg_calibrate_tuple_cost'
+LANGUAGE C STRICT PARALLEL UNSAFE;
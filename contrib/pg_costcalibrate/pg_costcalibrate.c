@@ -0,0 +1,238 @@
+/*-------------------------------------------------------------------------
+ *
+ * pg_costcalibrate.c
+ *		  probes for calibrating planner cost constants
+ *
+ * Copyright (c) 2010-2025, PostgreSQL Global Development Group
+ *
+ * IDENTIFICATION
+ *		  contrib/pg_costcalibrate/pg_costcalibrate.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/relation.h"
+#include "access/tableam.h"
+#include "common/pg_prng.h"
+#include "fmgr.h"
+#include "funcapi.h"
+#include "miscadmin.h"
+#include "optimizer/optimizer.h"
+#include "portability/instr_time.h"
+#include "storage/bufmgr.h"
+#include "storage/smgr.h"
+#include "utils/acl.h"
+#include "utils/builtins.h"
+#include "utils/lsyscache.h"
+#include "utils/rel.h"
+#include "utils/snapmgr.h"
+
+PG_MODULE_MAGIC_EXT(
+					.name = "pg_costcalibrate",
+					.version = PG_VERSION
+);
+
+PG_FUNCTION_INFO_V1(pg_calibrate_page_costs);
+PG_FUNCTION_INFO_V1(pg_calibrate_tuple_cost);
+
+static PGIOAlignedBlock blockbuffer;
+
+/*
+ * Open a relation for probing and verify that the caller may read it and
+ * that it has storage.
+ */
+static Relation
+open_probe_relation(Oid relOid)
+{
+	Relation	rel;
+	AclResult	aclresult;
+
+	rel = relation_open(relOid, AccessShareLock);
+	aclresult = pg_class_aclcheck(relOid, GetUserId(), ACL_SELECT);
+	if (aclresult != ACLCHECK_OK)
+		aclcheck_error(aclresult, get_relkind_objtype(rel->rd_rel->relkind),
+					   get_rel_name(relOid));
+
+	if (!RELKIND_HAS_STORAGE(rel->rd_rel->relkind))
+		ereport(ERROR,
+				(errcode(ERRCODE_WRONG_OBJECT_TYPE),
+				 errmsg("relation \"%s\" does not have storage",
+						RelationGetRelationName(rel)),
+				 errdetail_relkind_not_supported(rel->rd_rel->relkind)));
+
+	return rel;
+}
+
+/*
+ * pg_calibrate_page_costs(regclass, nblocks int4)
+ *
+ * Measure per-page sequential and random read times for the given relation
+ * by reading through the regular smgr path, bypassing shared buffers so that
+ * repeated runs are not satisfied from them.  The sequential probe reads a
+ * run of consecutive blocks from the first half of the relation; the random
+ * probe reads randomly chosen blocks from the second half, so that neither
+ * probe touches pages the other one just pulled into the OS cache.
+ *
+ * Returns per-page times in microseconds plus a random_page_cost suggestion
+ * derived from the measured ratio and the current seq_page_cost setting.
+ * The result reflects whatever part of the relation the OS has cached; for a
+ * cold-cache answer, probe a relation considerably larger than RAM.
+ */
+Datum
+pg_calibrate_page_costs(PG_FUNCTION_ARGS)
+{
+	Oid			relOid = PG_GETARG_OID(0);
+	int32		nblocks = PG_GETARG_INT32(1);
+	Relation	rel;
+	BlockNumber relblocks;
+	BlockNumber half;
+	BlockNumber probe;
+	BlockNumber start;
+	instr_time	start_time;
+	instr_time	end_time;
+	double		seq_usec;
+	double		random_usec;
+	TupleDesc	tupdesc;
+	Datum		values[3];
+	bool		nulls[3] = {false, false, false};
+
+	if (nblocks <= 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("number of probe blocks must be positive")));
+
+	rel = open_probe_relation(relOid);
+
+	relblocks = RelationGetNumberOfBlocksInFork(rel, MAIN_FORKNUM);
+	half = relblocks / 2;
+	if (half < 1)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("relation \"%s\" is too small to calibrate",
+						RelationGetRelationName(rel)),
+				 errhint("The relation must be at least two blocks long.")));
+	probe = Min((BlockNumber) nblocks, half);
+
+	/* Sequential probe: consecutive blocks from the first half. */
+	if (half - probe > 0)
+		start = (BlockNumber) pg_prng_uint64_range(&pg_global_prng_state,
+												   0, half - probe);
+	else
+		start = 0;
+
+	INSTR_TIME_SET_CURRENT(start_time);
+	for (BlockNumber i = 0; i < probe; i++)
+	{
+		CHECK_FOR_INTERRUPTS();
+		smgrread(RelationGetSmgr(rel), MAIN_FORKNUM, start + i,
+				 blockbuffer.data);
+	}
+	INSTR_TIME_SET_CURRENT(end_time);
+	INSTR_TIME_SUBTRACT(end_time, start_time);
+	seq_usec = INSTR_TIME_GET_MICROSEC(end_time) / (double) probe;
+
+	/* Random probe: randomly chosen blocks from the second half. */
+	INSTR_TIME_SET_CURRENT(start_time);
+	for (BlockNumber i = 0; i < probe; i++)
+	{
+		BlockNumber blkno;
+
+		CHECK_FOR_INTERRUPTS();
+		blkno = (BlockNumber) pg_prng_uint64_range(&pg_global_prng_state,
+												   half, relblocks - 1);
+		smgrread(RelationGetSmgr(rel), MAIN_FORKNUM, blkno,
+				 blockbuffer.data);
+	}
+	INSTR_TIME_SET_CURRENT(end_time);
+	INSTR_TIME_SUBTRACT(end_time, start_time);
+	random_usec = INSTR_TIME_GET_MICROSEC(end_time) / (double) probe;
+
+	relation_close(rel, AccessShareLock);
+
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	values[0] = Float8GetDatum(seq_usec);
+	values[1] = Float8GetDatum(random_usec);
+	if (seq_usec > 0.0)
+		values[2] = Float8GetDatum(seq_page_cost * (random_usec / seq_usec));
+	else
+		nulls[2] = true;
+
+	PG_RETURN_DATUM(HeapTupleGetDatum(heap_form_tuple(tupdesc, values, nulls)));
+}
+
+/*
+ * pg_calibrate_tuple_cost(regclass, seq_page_usec float8)
+ *
+ * Measure per-tuple processing time by scanning the given relation through
+ * the table access method, and derive a cpu_tuple_cost suggestion from the
+ * ratio of that time to the supplied per-page sequential read time (as
+ * measured by pg_calibrate_page_costs on the same hardware).  The relation
+ * is scanned twice and only the second pass is timed, so that the timing
+ * covers tuple processing with the pages already in cache rather than I/O.
+ */
+Datum
+pg_calibrate_tuple_cost(PG_FUNCTION_ARGS)
+{
+	Oid			relOid = PG_GETARG_OID(0);
+	double		seq_page_usec = PG_GETARG_FLOAT8(1);
+	Relation	rel;
+	TupleTableSlot *slot;
+	TableScanDesc scan;
+	int64		ntuples = 0;
+	instr_time	start_time;
+	instr_time	end_time;
+	double		tuple_usec;
+	TupleDesc	tupdesc;
+	Datum		values[3];
+	bool		nulls[3] = {false, false, false};
+
+	if (seq_page_usec <= 0.0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("sequential page read time must be positive")));
+
+	rel = open_probe_relation(relOid);
+
+	slot = table_slot_create(rel, NULL);
+
+	/* Priming pass: pull the relation into cache, untimed. */
+	scan = table_beginscan(rel, GetActiveSnapshot(), 0, NULL);
+	while (table_scan_getnextslot(scan, ForwardScanDirection, slot))
+		CHECK_FOR_INTERRUPTS();
+	table_endscan(scan);
+
+	/* Measured pass. */
+	scan = table_beginscan(rel, GetActiveSnapshot(), 0, NULL);
+	INSTR_TIME_SET_CURRENT(start_time);
+	while (table_scan_getnextslot(scan, ForwardScanDirection, slot))
+	{
+		CHECK_FOR_INTERRUPTS();
+		ntuples++;
+	}
+	INSTR_TIME_SET_CURRENT(end_time);
+	table_endscan(scan);
+
+	ExecDropSingleTupleTableSlot(slot);
+	relation_close(rel, AccessShareLock);
+
+	if (ntuples == 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("relation \"%s\" contains no visible tuples",
+						get_rel_name(relOid))));
+
+	INSTR_TIME_SUBTRACT(end_time, start_time);
+	tuple_usec = INSTR_TIME_GET_MICROSEC(end_time) / (double) ntuples;
+
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	values[0] = Int64GetDatum(ntuples);
+	values[1] = Float8GetDatum(tuple_usec);
+	values[2] = Float8GetDatum(seq_page_cost * (tuple_usec / seq_page_usec));
+
+	PG_RETURN_DATUM(HeapTupleGetDatum(heap_form_tuple(tupdesc, values, nulls)));
+}
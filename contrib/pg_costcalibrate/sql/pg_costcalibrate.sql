@@ -0,0 +1,23 @@
+CREATE EXTENSION pg_costcalibrate;
+
+-- A few pages' worth of data to probe.
+CREATE TABLE calib_test AS
+  SELECT g AS id, repeat('x', 100) AS filler FROM generate_series(1, 5000) g;
+VACUUM ANALYZE calib_test;
+
+-- Timings vary, so only check that the probes produce sensible values.
+SELECT seq_page_usec > 0 AS seq_ok,
+       random_page_usec > 0 AS random_ok,
+       suggested_random_page_cost > 0 AS suggestion_ok
+  FROM pg_calibrate_page_costs('calib_test', 8);
+
+SELECT ntuples = 5000 AS count_ok,
+       tuple_usec > 0 AS tuple_ok,
+       suggested_cpu_tuple_cost > 0 AS suggestion_ok
+  FROM pg_calibrate_tuple_cost('calib_test', 100.0);
+
+-- Error cases.
+SELECT * FROM pg_calibrate_page_costs('calib_test', 0);
+SELECT * FROM pg_calibrate_tuple_cost('calib_test', 0);
+
+DROP TABLE calib_test;
@@ -59,6 +59,7 @@ typedef struct BlockInfoRecord
 	RelFileNumber filenumber;
 	ForkNumber	forknum;
 	BlockNumber blocknum;
+	uint32		usagecount;		/* buffer usage count at dump time */
 } BlockInfoRecord;
 
 /* Shared state information for autoprewarm bgworker. */
@@ -118,6 +119,7 @@ static AutoPrewarmSharedState *apw_state = NULL;
 /* GUC variables. */
 static bool autoprewarm = true; /* start worker? */
 static int	autoprewarm_interval = 300; /* dump interval */
+static int	autoprewarm_min_usage_count = 0;	/* usage count cutoff */
 
 /*
  * Module load callback.
@@ -137,6 +139,18 @@ _PG_init(void)
 							NULL,
 							NULL);
 
+	DefineCustomIntVariable("pg_prewarm.autoprewarm_min_usage_count",
+							"Minimum buffer usage count for a block to be prewarmed.",
+							"Blocks whose usage count at dump time was below this value are not reloaded.",
+							&autoprewarm_min_usage_count,
+							0,
+							0, BM_MAX_USAGE_COUNT,
+							PGC_SIGHUP,
+							0,
+							NULL,
+							NULL,
+							NULL);
+
 	if (!process_shared_preload_libraries_in_progress)
 		return;
 
@@ -350,17 +364,41 @@ apw_load_buffers(void)
 	{
 		unsigned	forknum;
 
-		if (fscanf(file, "%u,%u,%u,%u,%u\n", &blkinfo[i].database,
+		if (fscanf(file, "%u,%u,%u,%u,%u", &blkinfo[i].database,
 				   &blkinfo[i].tablespace, &blkinfo[i].filenumber,
 				   &forknum, &blkinfo[i].blocknum) != 5)
 			ereport(ERROR,
 					(errmsg("autoprewarm block dump file is corrupted at line %d",
 							i + 1)));
 		blkinfo[i].forknum = forknum;
+
+		/*
+		 * The usage count is absent from files written by older pg_prewarm
+		 * versions; treat such blocks as cold but still reloadable.
+		 */
+		if (fscanf(file, ",%u", &blkinfo[i].usagecount) != 1)
+			blkinfo[i].usagecount = 0;
 	}
 
 	FreeFile(file);
 
+	/*
+	 * If a usage count cutoff is configured, discard blocks that were below
+	 * it at dump time, so that only the hotter part of the working set is
+	 * reloaded.
+	 */
+	if (autoprewarm_min_usage_count > 0)
+	{
+		int			num_kept = 0;
+
+		for (i = 0; i < num_elements; i++)
+		{
+			if (blkinfo[i].usagecount >= (uint32) autoprewarm_min_usage_count)
+				blkinfo[num_kept++] = blkinfo[i];
+		}
+		num_elements = num_kept;
+	}
+
 	/* Sort the blocks to be loaded. */
 	qsort(blkinfo, num_elements, sizeof(BlockInfoRecord),
 		  apw_compare_blockinfo);
@@ -729,6 +767,8 @@ apw_dump_now(bool is_bgworker, bool dump_unlogged)
 			block_info_array[num_blocks].forknum =
 				BufTagGetForkNum(&bufHdr->tag);
 			block_info_array[num_blocks].blocknum = bufHdr->tag.blockNum;
+			block_info_array[num_blocks].usagecount =
+				BUF_STATE_GET_USAGECOUNT(buf_state);
 			++num_blocks;
 		}
 
@@ -761,12 +801,13 @@ apw_dump_now(bool is_bgworker, bool dump_unlogged)
 	{
 		CHECK_FOR_INTERRUPTS();
 
-		ret = fprintf(file, "%u,%u,%u,%u,%u\n",
+		ret = fprintf(file, "%u,%u,%u,%u,%u,%u\n",
 					  block_info_array[i].database,
 					  block_info_array[i].tablespace,
 					  block_info_array[i].filenumber,
 					  (uint32) block_info_array[i].forknum,
-					  block_info_array[i].blocknum);
+					  block_info_array[i].blocknum,
+					  block_info_array[i].usagecount);
 		if (ret < 0)
 		{
 			int			save_errno = errno;
@@ -991,9 +1032,13 @@ do { \
  *
  * We depend on all records for a particular database being consecutive
  * in the dump file; each per-database worker will preload blocks until
- * it sees a block for some other database.  Sorting by tablespace,
- * filenumber, forknum, and blocknum isn't critical for correctness, but
- * helps us get a sequential I/O pattern.
+ * it sees a block for some other database.  Within a database, blocks
+ * with a higher usage count at dump time sort first, so that the hottest
+ * part of the working set is warm again soonest.  Since usage counts
+ * only range up to BM_MAX_USAGE_COUNT, this merely partitions each
+ * database's blocks into a few bands; sorting by tablespace,
+ * filenumber, forknum, and blocknum within a band isn't critical for
+ * correctness, but helps us get a sequential I/O pattern.
  */
 static int
 apw_compare_blockinfo(const void *p, const void *q)
@@ -1002,6 +1047,13 @@ apw_compare_blockinfo(const void *p, const void *q)
 	const BlockInfoRecord *b = (const BlockInfoRecord *) q;
 
 	cmp_member_elem(database);
+
+	/* note the reversed sense: hotter blocks sort first */
+	if (a->usagecount > b->usagecount)
+		return -1;
+	else if (a->usagecount < b->usagecount)
+		return 1;
+
 	cmp_member_elem(tablespace);
 	cmp_member_elem(filenumber);
 	cmp_member_elem(forknum);
@@ -2111,20 +2111,51 @@ entry_alloc(pgssHashKey *key, Size query_offset, int query_len, int encoding,
 }
 
 /*
- * qsort comparator for sorting into increasing usage order
+ * Partially reorder entries[0..n-1] by increasing usage, so that entries[k]
+ * holds the value it would have after a full sort, everything before it
+ * compares less than or equal, and everything after it greater than or
+ * equal.  This is a standard quickselect; it runs in O(n) on average, versus
+ * O(n log n) for sorting the whole array, which matters because we do this
+ * while holding pgss->lock exclusively.
  */
-static int
-entry_cmp(const void *lhs, const void *rhs)
+static void
+entry_qselect(pgssEntry **entries, int n, int k)
 {
-	double		l_usage = (*(pgssEntry *const *) lhs)->counters.usage;
-	double		r_usage = (*(pgssEntry *const *) rhs)->counters.usage;
+	int			lo = 0;
+	int			hi = n - 1;
 
-	if (l_usage < r_usage)
-		return -1;
-	else if (l_usage > r_usage)
-		return +1;
-	else
-		return 0;
+	Assert(k >= 0 && k < n);
+
+	while (lo < hi)
+	{
+		double		pivot = entries[(lo + hi) / 2]->counters.usage;
+		int			i = lo;
+		int			j = hi;
+
+		while (i <= j)
+		{
+			while (entries[i]->counters.usage < pivot)
+				i++;
+			while (entries[j]->counters.usage > pivot)
+				j--;
+			if (i <= j)
+			{
+				pgssEntry  *tmp = entries[i];
+
+				entries[i] = entries[j];
+				entries[j] = tmp;
+				i++;
+				j--;
+			}
+		}
+
+		if (k <= j)
+			hi = j;
+		else if (k >= i)
+			lo = i;
+		else
+			break;
+	}
 }
 
 /*
@@ -2144,7 +2175,7 @@ entry_dealloc(void)
 	int			nvalidtexts;
 
 	/*
-	 * Sort entries by usage and deallocate USAGE_DEALLOC_PERCENT of them.
+	 * Find the USAGE_DEALLOC_PERCENT least-used entries and deallocate them.
 	 * While we're scanning the table, apply the decay factor to the usage
 	 * values, and update the mean query length.
 	 *
@@ -2178,12 +2209,18 @@ entry_dealloc(void)
 		}
 	}
 
-	/* Sort into increasing order by usage */
-	qsort(entries, i, sizeof(pgssEntry *), entry_cmp);
+	/*
+	 * We need only two order statistics, the median usage and the set of
+	 * lowest-usage victims, so use quickselect rather than sorting the whole
+	 * array.
+	 */
 
 	/* Record the (approximate) median usage */
 	if (i > 0)
+	{
+		entry_qselect(entries, i, i / 2);
 		pgss->cur_median_usage = entries[i / 2]->counters.usage;
+	}
 	/* Record the mean query length */
 	if (nvalidtexts > 0)
 		pgss->mean_query_len = tottextlen / nvalidtexts;
@@ -2194,6 +2231,10 @@ entry_dealloc(void)
 	nvictims = Max(10, i * USAGE_DEALLOC_PERCENT / 100);
 	nvictims = Min(nvictims, i);
 
+	/* Move the nvictims lowest-usage entries to the front of the array */
+	if (nvictims > 0 && nvictims < i)
+		entry_qselect(entries, i, nvictims - 1);
+
 	for (i = 0; i < nvictims; i++)
 	{
 		hash_search(pgss_hash, &entries[i]->key, HASH_REMOVE, NULL);
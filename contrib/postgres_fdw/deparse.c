@@ -205,6 +205,7 @@ static bool is_subquery_var(Var *node, RelOptInfo *foreignrel,
 							int *relno, int *colno);
 static void get_relation_column_alias_ids(Var *node, RelOptInfo *foreignrel,
 										  int *relno, int *colno);
+static bool partial_agg_ok(Aggref *agg);
 
 
 /*
@@ -915,8 +916,26 @@ foreign_expr_walker(Node *node,
 				if (!IS_UPPER_REL(glob_cxt->foreignrel))
 					return false;
 
-				/* Only non-split aggregates are pushable. */
-				if (agg->aggsplit != AGGSPLIT_SIMPLE)
+				/*
+				 * The aggregate must match the grouping rel we are deparsing
+				 * for: plain aggregates belong to a fully grouped rel, while
+				 * partial aggregates belong to a partially grouped one.  A
+				 * partial aggregate is pushable only if the result of running
+				 * the plain aggregate remotely is the very transition value
+				 * the local finalization step expects; see partial_agg_ok.
+				 */
+				if (agg->aggsplit == AGGSPLIT_SIMPLE)
+				{
+					if (fpinfo->stage == UPPERREL_PARTIAL_GROUP_AGG)
+						return false;
+				}
+				else if (DO_AGGSPLIT_SKIPFINAL(agg->aggsplit))
+				{
+					if (fpinfo->stage != UPPERREL_PARTIAL_GROUP_AGG ||
+						!partial_agg_ok(agg))
+						return false;
+				}
+				else
 					return false;
 
 				/* As usual, it must be shippable. */
@@ -3663,8 +3682,13 @@ deparseAggref(Aggref *node, deparse_expr_cxt *context)
 	StringInfo	buf = context->buf;
 	bool		use_variadic;
 
-	/* Only basic, non-split aggregation accepted. */
-	Assert(node->aggsplit == AGGSPLIT_SIMPLE);
+	/*
+	 * Only basic aggregation, or partial aggregation whose remote result is
+	 * directly usable as the transition value, is accepted; in either case
+	 * the aggregate is written out in its plain SQL form.
+	 */
+	Assert(node->aggsplit == AGGSPLIT_SIMPLE ||
+		   DO_AGGSPLIT_SKIPFINAL(node->aggsplit));
 
 	/* Check if need to print VARIADIC (cf. ruleutils.c) */
 	use_variadic = node->aggvariadic;
@@ -4210,3 +4234,43 @@ get_relation_column_alias_ids(Var *node, RelOptInfo *foreignrel,
 	/* Shouldn't get here */
 	elog(ERROR, "unexpected expression in subquery output");
 }
+
+/*
+ * Returns true if it's semantically OK to evaluate the given partial
+ * aggregate by running the plain aggregate on the remote server.
+ *
+ * A partial aggregate's output is its transition value, so this works only
+ * for aggregates without a finalize function, where the plain aggregate's
+ * result *is* the transition value.  The transition type must also be a
+ * genuine SQL type (not INTERNAL), else the value couldn't be transferred;
+ * for such aggregates no serialization function is involved either, even
+ * though the planner requested AGGSPLIT_INITIAL_SERIAL.
+ */
+static bool
+partial_agg_ok(Aggref *agg)
+{
+	HeapTuple	aggtup;
+	Form_pg_aggregate aggform;
+	bool		ok;
+
+	Assert(DO_AGGSPLIT_SKIPFINAL(agg->aggsplit));
+
+	if (agg->aggtranstype == INTERNALOID)
+		return false;
+
+	aggtup = SearchSysCache1(AGGFNOID, ObjectIdGetDatum(agg->aggfnoid));
+	if (!HeapTupleIsValid(aggtup))
+		elog(ERROR, "cache lookup failed for aggregate %u", agg->aggfnoid);
+	aggform = (Form_pg_aggregate) GETSTRUCT(aggtup);
+
+	/*
+	 * With no finalize function the aggregate's declared result type equals
+	 * its transition type, so the remote result is exactly the transition
+	 * value the local finalization step expects.
+	 */
+	ok = !OidIsValid(aggform->aggfinalfn);
+
+	ReleaseSysCache(aggtup);
+
+	return ok;
+}
@@ -3836,11 +3836,20 @@ fetch_more_data(ForeignScanState *node)
 	MemoryContext oldcontext;
 
 	/*
-	 * We'll store the tuples in the batch_cxt.  First, flush the previous
-	 * batch.
+	 * We'll store the tuples in the batch_cxt.  Normally the previous batch
+	 * has been handed out in full by now and we flush it first; but if this
+	 * fetch was begun as a prefetch by postgresForeignAsyncNotify and some
+	 * other use of the connection forces it to be harvested early, tuples of
+	 * the current batch remain undelivered, and the new batch must be
+	 * appended to them instead.
 	 */
-	fsstate->tuples = NULL;
-	MemoryContextReset(fsstate->batch_cxt);
+	if (fsstate->next_tuple >= fsstate->num_tuples)
+	{
+		fsstate->tuples = NULL;
+		fsstate->num_tuples = 0;
+		fsstate->next_tuple = 0;
+		MemoryContextReset(fsstate->batch_cxt);
+	}
 	oldcontext = MemoryContextSwitchTo(fsstate->batch_cxt);
 
 	/* PGresult must be released before leaving this function. */
@@ -3882,15 +3891,19 @@ fetch_more_data(ForeignScanState *node)
 
 		/* Convert the data into HeapTuples */
 		numrows = PQntuples(res);
-		fsstate->tuples = (HeapTuple *) palloc0(numrows * sizeof(HeapTuple));
-		fsstate->num_tuples = numrows;
-		fsstate->next_tuple = 0;
+		if (fsstate->tuples == NULL)
+			fsstate->tuples = (HeapTuple *) palloc0(numrows * sizeof(HeapTuple));
+		else
+			fsstate->tuples = (HeapTuple *)
+				repalloc0(fsstate->tuples,
+						  fsstate->num_tuples * sizeof(HeapTuple),
+						  (fsstate->num_tuples + numrows) * sizeof(HeapTuple));
 
 		for (i = 0; i < numrows; i++)
 		{
 			Assert(IsA(node->ss.ps.plan, ForeignScan));
 
-			fsstate->tuples[i] =
+			fsstate->tuples[fsstate->num_tuples + i] =
 				make_tuple_from_result_row(res, i,
 										   fsstate->rel,
 										   fsstate->attinmeta,
@@ -3898,6 +3911,7 @@ fetch_more_data(ForeignScanState *node)
 										   node,
 										   fsstate->temp_cxt);
 		}
+		fsstate->num_tuples += numrows;
 
 		/* Update fetch_ct_2 */
 		if (fsstate->fetch_ct_2 < 2)
@@ -6745,7 +6759,9 @@ foreign_grouping_ok(PlannerInfo *root, RelOptInfo *grouped_rel,
 	 * to the base relation name mustn't include any digits, or it'll confuse
 	 * postgresExplainForeignScan.
 	 */
-	fpinfo->relation_name = psprintf("Aggregate on (%s)",
+	fpinfo->relation_name = psprintf("%s on (%s)",
+									 fpinfo->stage == UPPERREL_PARTIAL_GROUP_AGG ?
+									 "Partial aggregate" : "Aggregate",
 									 ofpinfo->relation_name);
 
 	return true;
@@ -6773,6 +6789,7 @@ postgresGetForeignUpperPaths(PlannerInfo *root, UpperRelationKind stage,
 
 	/* Ignore stages we don't support; and skip any duplicate calls. */
 	if ((stage != UPPERREL_GROUP_AGG &&
+		 stage != UPPERREL_PARTIAL_GROUP_AGG &&
 		 stage != UPPERREL_ORDERED &&
 		 stage != UPPERREL_FINAL) ||
 		output_rel->fdw_private)
@@ -6786,6 +6803,7 @@ postgresGetForeignUpperPaths(PlannerInfo *root, UpperRelationKind stage,
 	switch (stage)
 	{
 		case UPPERREL_GROUP_AGG:
+		case UPPERREL_PARTIAL_GROUP_AGG:
 			add_foreign_grouping_paths(root, input_rel, output_rel,
 									   (GroupPathExtraData *) extra);
 			break;
@@ -6807,7 +6825,9 @@ postgresGetForeignUpperPaths(PlannerInfo *root, UpperRelationKind stage,
  *		Add foreign path for grouping and/or aggregation.
  *
  * Given input_rel represents the underlying scan.  The paths are added to the
- * given grouped_rel.
+ * given grouped_rel, which may be either a fully or a partially grouped rel;
+ * in the latter case only the partial-aggregation step is pushed down, and
+ * finalization happens locally.
  */
 static void
 add_foreign_grouping_paths(PlannerInfo *root, RelOptInfo *input_rel,
@@ -6829,7 +6849,8 @@ add_foreign_grouping_paths(PlannerInfo *root, RelOptInfo *input_rel,
 		!root->hasHavingQual)
 		return;
 
-	Assert(extra->patype == PARTITIONWISE_AGGREGATE_NONE ||
+	Assert(fpinfo->stage == UPPERREL_PARTIAL_GROUP_AGG ||
+		   extra->patype == PARTITIONWISE_AGGREGATE_NONE ||
 		   extra->patype == PARTITIONWISE_AGGREGATE_FULL);
 
 	/* save the input_rel as outerrel in fpinfo */
@@ -6848,9 +6869,13 @@ add_foreign_grouping_paths(PlannerInfo *root, RelOptInfo *input_rel,
 	 * Assess if it is safe to push down aggregation and grouping.
 	 *
 	 * Use HAVING qual from extra. In case of child partition, it will have
-	 * translated Vars.
+	 * translated Vars.  When only partial aggregation is pushed down, the
+	 * HAVING qual must be applied locally after finalization, so don't pass
+	 * it; any aggregates it needs are already in the rel's target.
 	 */
-	if (!foreign_grouping_ok(root, grouped_rel, extra->havingQual))
+	if (!foreign_grouping_ok(root, grouped_rel,
+							 fpinfo->stage == UPPERREL_GROUP_AGG ?
+							 extra->havingQual : NULL))
 		return;
 
 	/*
@@ -7429,6 +7454,16 @@ postgresForeignAsyncNotify(AsyncRequest *areq)
 	fetch_more_data(node);
 
 	produce_tuple_asynchronously(areq, true);
+
+	/*
+	 * If more data is expected and the connection is now idle, prefetch the
+	 * next batch, so that its network round trip overlaps with the requestor
+	 * draining the batch we just stored instead of costing a full round trip
+	 * once the batch runs out.  Any other use of the connection in the
+	 * meantime completes the fetch first via process_pending_request.
+	 */
+	if (!fsstate->eof_reached && !fsstate->conn_state->pendingAreq)
+		fetch_more_data_begin(areq);
 }
 
 /*
@@ -7442,8 +7477,13 @@ produce_tuple_asynchronously(AsyncRequest *areq, bool fetch)
 	AsyncRequest *pendingAreq = fsstate->conn_state->pendingAreq;
 	TupleTableSlot *result;
 
-	/* This should not be called if the request is currently in-process */
-	Assert(areq != pendingAreq);
+	/*
+	 * The request may be in-process here only if it is a prefetch of the
+	 * next batch begun by postgresForeignAsyncNotify, in which case we still
+	 * have tuples of the current batch to hand out.
+	 */
+	Assert(areq != pendingAreq ||
+		   fsstate->next_tuple < fsstate->num_tuples);
 
 	/* Fetch some more tuples, if we've run out */
 	if (fsstate->next_tuple >= fsstate->num_tuples)
@@ -7538,14 +7578,20 @@ process_pending_request(AsyncRequest *areq)
 	ForeignScanState *node = (ForeignScanState *) areq->requestee;
 	PgFdwScanState *fsstate = (PgFdwScanState *) node->fdw_state;
 
-	/* The request would have been pending for a callback */
-	Assert(areq->callback_pending);
-
 	/* The request should be currently in-process */
 	Assert(fsstate->conn_state->pendingAreq == areq);
 
 	fetch_more_data(node);
 
+	/*
+	 * If the request is not pending for a callback, the in-process fetch was
+	 * a prefetch of the next batch; the tuples just stored will be handed
+	 * out when the requestor gets back to this node, so there is nothing
+	 * more to do here.
+	 */
+	if (!areq->callback_pending)
+		return;
+
 	/*
 	 * If we didn't get any tuples, must be end of data; complete the request
 	 * now.  Otherwise, we postpone completing the request until we are called
@@ -0,0 +1,24 @@
+-- predictability
+SET synchronous_commit = on;
+
+SELECT 'init' FROM pg_create_logical_replication_slot('regression_slot', 'test_decoding');
+
+CREATE TABLE filter_change_tbl (id int primary key, val text);
+
+BEGIN;
+INSERT INTO filter_change_tbl VALUES (1, 'one');
+INSERT INTO filter_change_tbl VALUES (2, 'two');
+UPDATE filter_change_tbl SET val = 'TWO' WHERE id = 2;
+DELETE FROM filter_change_tbl WHERE id = 1;
+COMMIT;
+
+-- inserts are discarded before they reach the reorder buffer; updates and
+-- deletes go through
+SELECT data FROM pg_logical_slot_peek_changes('regression_slot', NULL, NULL, 'include-xids', '0', 'skip-empty-xacts', '1', 'filter-inserts', '1');
+
+-- with filtering disabled the same changes decode in full
+SELECT data FROM pg_logical_slot_get_changes('regression_slot', NULL, NULL, 'include-xids', '0', 'skip-empty-xacts', '1');
+
+DROP TABLE filter_change_tbl;
+
+SELECT 'init' FROM pg_drop_replication_slot('regression_slot');
@@ -34,6 +34,7 @@ typedef struct
 	bool		include_timestamp;
 	bool		skip_empty_xacts;
 	bool		only_local;
+	bool		filter_inserts;
 } TestDecodingData;
 
 /*
@@ -71,6 +72,9 @@ static void pg_decode_truncate(LogicalDecodingContext *ctx,
 							   ReorderBufferChange *change);
 static bool pg_decode_filter(LogicalDecodingContext *ctx,
 							 RepOriginId origin_id);
+static bool pg_decode_filter_change(LogicalDecodingContext *ctx,
+									RelFileLocator *rlocator,
+									ReorderBufferChange *change);
 static void pg_decode_message(LogicalDecodingContext *ctx,
 							  ReorderBufferTXN *txn, XLogRecPtr lsn,
 							  bool transactional, const char *prefix,
@@ -136,6 +140,7 @@ _PG_output_plugin_init(OutputPluginCallbacks *cb)
 	cb->truncate_cb = pg_decode_truncate;
 	cb->commit_cb = pg_decode_commit_txn;
 	cb->filter_by_origin_cb = pg_decode_filter;
+	cb->filter_change_cb = pg_decode_filter_change;
 	cb->shutdown_cb = pg_decode_shutdown;
 	cb->message_cb = pg_decode_message;
 	cb->filter_prepare_cb = pg_decode_filter_prepare;
@@ -171,6 +176,7 @@ pg_decode_startup(LogicalDecodingContext *ctx, OutputPluginOptions *opt,
 	data->include_timestamp = false;
 	data->skip_empty_xacts = false;
 	data->only_local = false;
+	data->filter_inserts = false;
 
 	ctx->output_plugin_private = data;
 
@@ -241,6 +247,17 @@ pg_decode_startup(LogicalDecodingContext *ctx, OutputPluginOptions *opt,
 						 errmsg("could not parse value \"%s\" for parameter \"%s\"",
 								strVal(elem->arg), elem->defname)));
 		}
+		else if (strcmp(elem->defname, "filter-inserts") == 0)
+		{
+
+			if (elem->arg == NULL)
+				data->filter_inserts = true;
+			else if (!parse_bool(strVal(elem->arg), &data->filter_inserts))
+				ereport(ERROR,
+						(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+						 errmsg("could not parse value \"%s\" for parameter \"%s\"",
+								strVal(elem->arg), elem->defname)));
+		}
 		else if (strcmp(elem->defname, "include-rewrites") == 0)
 		{
 
@@ -470,6 +487,21 @@ pg_decode_filter(LogicalDecodingContext *ctx,
 	return false;
 }
 
+/*
+ * Discard INSERT changes before they are queued into the reorder buffer, if
+ * asked to.  This exists mainly to exercise the filter_change callback.
+ */
+static bool
+pg_decode_filter_change(LogicalDecodingContext *ctx,
+						RelFileLocator *rlocator,
+						ReorderBufferChange *change)
+{
+	TestDecodingData *data = ctx->output_plugin_private;
+
+	return data->filter_inserts &&
+		change->action == REORDER_BUFFER_CHANGE_INSERT;
+}
+
 /*
  * Print literal `outputstr' already represented as string of type `typid'
  * into stringbuf `s'.
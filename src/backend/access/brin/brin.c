@@ -924,17 +924,18 @@ bringetbitmap(IndexScanDesc scan, TIDBitmap *tbm)
 		/* add the pages in the range to the output bitmap, if needed */
 		if (addrange)
 		{
+			BlockNumber lastpage;
 			BlockNumber pageno;
 
-			for (pageno = heapBlk;
-				 pageno <= Min(nblocks, heapBlk + opaque->bo_pagesPerRange) - 1;
-				 pageno++)
+			lastpage = Min(nblocks, heapBlk + opaque->bo_pagesPerRange) - 1;
+
+			MemoryContextSwitchTo(oldcxt);
+			for (pageno = heapBlk; pageno <= lastpage; pageno++)
 			{
-				MemoryContextSwitchTo(oldcxt);
 				tbm_add_page(tbm, pageno);
 				totalpages++;
-				MemoryContextSwitchTo(perRangeCxt);
 			}
+			MemoryContextSwitchTo(perRangeCxt);
 		}
 	}
 
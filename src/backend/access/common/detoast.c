@@ -245,15 +245,13 @@ detoast_attr_slice(struct varlena *attr,
 			/*
 			 * Determine maximum amount of compressed data needed for a prefix
 			 * of a given length (after decompression).
-			 *
-			 * At least for now, if it's LZ4 data, we'll have to fetch the
-			 * whole thing, because there doesn't seem to be an API call to
-			 * determine how much compressed data we need to be sure of being
-			 * able to decompress the required slice.
 			 */
 			if (VARATT_EXTERNAL_GET_COMPRESS_METHOD(toast_pointer) ==
 				TOAST_PGLZ_COMPRESSION_ID)
 				max_size = pglz_maximum_compressed_size(slicelimit, max_size);
+			else if (VARATT_EXTERNAL_GET_COMPRESS_METHOD(toast_pointer) ==
+					 TOAST_LZ4_COMPRESSION_ID)
+				max_size = lz4_maximum_compressed_size(slicelimit, max_size);
 
 			/*
 			 * Fetch enough compressed slices (compressed marker will get set
@@ -19,6 +19,7 @@
 #include "libpq/pqformat.h"
 #include "libpq/protocol.h"
 #include "tcop/pquery.h"
+#include "utils/fmgroids.h"
 #include "utils/lsyscache.h"
 #include "utils/memdebug.h"
 #include "utils/memutils.h"
@@ -42,15 +43,58 @@ static void printtup_destroy(DestReceiver *self);
  * we are using for this column.
  * ----------------
  */
+/*
+ * Fixed-width binary send fast path: when a column's binary output function
+ * resolves to one of the well-known fixed-width ones, printtup emits the
+ * network-order bytes itself instead of calling it, saving a function call
+ * and a transient bytea per datum.  PRINTTUP_SEND_FUNC means no shortcut
+ * applies and the send function must be called.
+ */
+typedef enum PrinttupSendMode
+{
+	PRINTTUP_SEND_FUNC = 0,
+	PRINTTUP_SEND_BYTE1,		/* boolsend */
+	PRINTTUP_SEND_INT2,			/* int2send */
+	PRINTTUP_SEND_INT4,			/* int4send, oidsend, date_send */
+	PRINTTUP_SEND_INT8,			/* int8send, time/timestamp(tz)_send */
+	PRINTTUP_SEND_FLOAT4,		/* float4send */
+	PRINTTUP_SEND_FLOAT8,		/* float8send */
+} PrinttupSendMode;
+
 typedef struct
 {								/* Per-attribute information */
 	Oid			typoutput;		/* Oid for the type's text output fn */
 	Oid			typsend;		/* Oid for the type's binary output fn */
 	bool		typisvarlena;	/* is it varlena (ie possibly toastable)? */
 	int16		format;			/* format code for this column */
+	PrinttupSendMode sendmode;	/* fixed-width shortcut for binary format */
 	FmgrInfo	finfo;			/* Precomputed call info for output fn */
 } PrinttupAttrInfo;
 
+/*
+ * Memoized output-function lookup data for one result column.  When we are
+ * printing from a long-lived CachedPlan, an array of these is stashed in the
+ * plan (see its result_outinfo field) so that repeated executions of the
+ * same prepared statement can skip the catalog lookups below.  Each side is
+ * filled lazily on first use, because looking up a binary output function
+ * that doesn't exist raises an error, and we don't know which formats will
+ * ever be requested.
+ */
+typedef struct PrinttupOutputInfo
+{
+	Oid			typoutput;		/* text output fn, or InvalidOid if this side
+								 * hasn't been looked up yet */
+	Oid			typsend;		/* binary output fn, likewise */
+	bool		typout_isvarlena;
+	bool		typsend_isvarlena;
+} PrinttupOutputInfo;
+
+typedef struct PrinttupOutputCache
+{
+	int			natts;			/* # of result columns we were built for */
+	PrinttupOutputInfo attrs[FLEXIBLE_ARRAY_MEMBER];
+} PrinttupOutputCache;
+
 typedef struct
 {
 	DestReceiver pub;			/* publicly-known function pointers */
@@ -250,6 +294,8 @@ static void
 printtup_prepare_info(DR_printtup *myState, TupleDesc typeinfo, int numAttrs)
 {
 	int16	   *formats = myState->portal->formats;
+	CachedPlan *cplan = myState->portal->cplan;
+	PrinttupOutputCache *outcache = NULL;
 	int			i;
 
 	/* get rid of any old data */
@@ -262,6 +308,31 @@ printtup_prepare_info(DR_printtup *myState, TupleDesc typeinfo, int numAttrs)
 	if (numAttrs <= 0)
 		return;
 
+	/*
+	 * If we're printing from a long-lived cached plan, memoize the output
+	 * function lookups in the plan, so that later executions of the same
+	 * prepared statement skip the syscache traffic here.  A CachedPlan's
+	 * result descriptor cannot change within its lifetime, so no explicit
+	 * invalidation is needed: a replan produces a fresh CachedPlan with an
+	 * empty cache.  (The FmgrInfos are still set up per-receiver, since
+	 * output functions treat fn_extra as call-site scratch space.)
+	 */
+	if (cplan != NULL && !cplan->is_oneshot)
+	{
+		outcache = (PrinttupOutputCache *) cplan->result_outinfo;
+		if (outcache == NULL)
+		{
+			outcache = (PrinttupOutputCache *)
+				MemoryContextAllocZero(cplan->context,
+									   offsetof(PrinttupOutputCache, attrs) +
+									   numAttrs * sizeof(PrinttupOutputInfo));
+			outcache->natts = numAttrs;
+			cplan->result_outinfo = outcache;
+		}
+		else if (outcache->natts != numAttrs)
+			outcache = NULL;	/* shouldn't happen, but play safe */
+	}
+
 	myState->myinfo = (PrinttupAttrInfo *)
 		palloc0(numAttrs * sizeof(PrinttupAttrInfo));
 
@@ -274,17 +345,77 @@ printtup_prepare_info(DR_printtup *myState, TupleDesc typeinfo, int numAttrs)
 		thisState->format = format;
 		if (format == 0)
 		{
-			getTypeOutputInfo(attr->atttypid,
-							  &thisState->typoutput,
-							  &thisState->typisvarlena);
+			if (outcache != NULL)
+			{
+				PrinttupOutputInfo *outinfo = &outcache->attrs[i];
+
+				if (!OidIsValid(outinfo->typoutput))
+					getTypeOutputInfo(attr->atttypid,
+									  &outinfo->typoutput,
+									  &outinfo->typout_isvarlena);
+				thisState->typoutput = outinfo->typoutput;
+				thisState->typisvarlena = outinfo->typout_isvarlena;
+			}
+			else
+				getTypeOutputInfo(attr->atttypid,
+								  &thisState->typoutput,
+								  &thisState->typisvarlena);
 			fmgr_info(thisState->typoutput, &thisState->finfo);
 		}
 		else if (format == 1)
 		{
-			getTypeBinaryOutputInfo(attr->atttypid,
-									&thisState->typsend,
-									&thisState->typisvarlena);
+			if (outcache != NULL)
+			{
+				PrinttupOutputInfo *outinfo = &outcache->attrs[i];
+
+				if (!OidIsValid(outinfo->typsend))
+					getTypeBinaryOutputInfo(attr->atttypid,
+											&outinfo->typsend,
+											&outinfo->typsend_isvarlena);
+				thisState->typsend = outinfo->typsend;
+				thisState->typisvarlena = outinfo->typsend_isvarlena;
+			}
+			else
+				getTypeBinaryOutputInfo(attr->atttypid,
+										&thisState->typsend,
+										&thisState->typisvarlena);
 			fmgr_info(thisState->typsend, &thisState->finfo);
+
+			/*
+			 * Recognize the built-in fixed-width send functions, so that
+			 * printtup can emit their output directly.  Testing the resolved
+			 * function's OID makes this exact: a domain or custom type that
+			 * maps to another function just takes the generic path.
+			 */
+			switch (thisState->finfo.fn_oid)
+			{
+				case F_BOOLSEND:
+					thisState->sendmode = PRINTTUP_SEND_BYTE1;
+					break;
+				case F_INT2SEND:
+					thisState->sendmode = PRINTTUP_SEND_INT2;
+					break;
+				case F_INT4SEND:
+				case F_OIDSEND:
+				case F_DATE_SEND:
+					thisState->sendmode = PRINTTUP_SEND_INT4;
+					break;
+				case F_INT8SEND:
+				case F_TIME_SEND:
+				case F_TIMESTAMP_SEND:
+				case F_TIMESTAMPTZ_SEND:
+					thisState->sendmode = PRINTTUP_SEND_INT8;
+					break;
+				case F_FLOAT4SEND:
+					thisState->sendmode = PRINTTUP_SEND_FLOAT4;
+					break;
+				case F_FLOAT8SEND:
+					thisState->sendmode = PRINTTUP_SEND_FLOAT8;
+					break;
+				default:
+					thisState->sendmode = PRINTTUP_SEND_FUNC;
+					break;
+			}
 		}
 		else
 			ereport(ERROR,
@@ -360,6 +491,41 @@ printtup(TupleTableSlot *slot, DestReceiver *self)
 			outputstr = OutputFunctionCall(&thisState->finfo, attr);
 			pq_sendcountedtext(buf, outputstr, strlen(outputstr));
 		}
+		else if (thisState->sendmode != PRINTTUP_SEND_FUNC)
+		{
+			/* Binary output, well-known fixed-width type */
+			switch (thisState->sendmode)
+			{
+				case PRINTTUP_SEND_BYTE1:
+					pq_sendint32(buf, 1);
+					pq_sendbyte(buf, DatumGetBool(attr) ? 1 : 0);
+					break;
+				case PRINTTUP_SEND_INT2:
+					pq_sendint32(buf, 2);
+					pq_sendint16(buf, DatumGetInt16(attr));
+					break;
+				case PRINTTUP_SEND_INT4:
+					pq_sendint32(buf, 4);
+					pq_sendint32(buf, DatumGetInt32(attr));
+					break;
+				case PRINTTUP_SEND_INT8:
+					pq_sendint32(buf, 8);
+					pq_sendint64(buf, DatumGetInt64(attr));
+					break;
+				case PRINTTUP_SEND_FLOAT4:
+					pq_sendint32(buf, 4);
+					pq_sendfloat4(buf, DatumGetFloat4(attr));
+					break;
+				case PRINTTUP_SEND_FLOAT8:
+					pq_sendint32(buf, 8);
+					pq_sendfloat8(buf, DatumGetFloat8(attr));
+					break;
+				default:
+					elog(ERROR, "unexpected printtup send mode: %d",
+						 (int) thisState->sendmode);
+					break;
+			}
+		}
 		else
 		{
 			/* Binary output */
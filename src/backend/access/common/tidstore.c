@@ -416,6 +416,108 @@ TidStoreSetBlockOffsets(TidStore *ts, BlockNumber blkno, OffsetNumber *offsets,
 		local_ts_set(ts->tree.local, blkno, page);
 }
 
+/*
+ * Add a single TID to the store.
+ *
+ * Unlike TidStoreSetBlockOffsets(), this adds to any existing entry for the
+ * block instead of replacing it, so it can be used when TIDs arrive one at a
+ * time in no particular order, as in CREATE INDEX CONCURRENTLY's validation
+ * scan.  Adding a TID that is already present is a no-op.
+ *
+ * Only local TidStores are supported; growing an entry in place would require
+ * locking considerations that no current caller needs.
+ */
+void
+TidStoreSetOffset(TidStore *ts, BlockNumber blkno, OffsetNumber off)
+{
+	BlocktableEntry *page;
+	int			wordnum;
+
+	Assert(!TidStoreIsShared(ts));
+
+	/* safety check to ensure we don't overrun bit array bounds */
+	if (off == InvalidOffsetNumber || off > MAX_OFFSET_IN_BITMAP)
+		elog(ERROR, "tuple offset out of range: %u", off);
+
+	page = local_ts_find(ts->tree.local, blkno);
+
+	/* No entry for this block yet; make one holding just this offset */
+	if (page == NULL)
+	{
+		TidStoreSetBlockOffsets(ts, blkno, &off, 1);
+		return;
+	}
+
+	if (page->header.nwords == 0)
+	{
+		/* we have offsets in the header */
+		OffsetNumber offsets[NUM_FULL_OFFSETS + 1];
+		int			num_offsets = 0;
+		bool		inserted = false;
+
+		/*
+		 * Merge the new offset into the existing ones, keeping them sorted as
+		 * TidStoreSetBlockOffsets() would store them.
+		 */
+		for (int i = 0; i < NUM_FULL_OFFSETS; i++)
+		{
+			OffsetNumber prev = page->header.full_offsets[i];
+
+			if (prev == off)
+				return;
+			if (prev == InvalidOffsetNumber)
+				break;
+			if (!inserted && off < prev)
+			{
+				offsets[num_offsets++] = off;
+				inserted = true;
+			}
+			offsets[num_offsets++] = prev;
+		}
+		if (!inserted)
+			offsets[num_offsets++] = off;
+
+		if (num_offsets <= NUM_FULL_OFFSETS)
+		{
+			/* still fits; rewrite the header in place */
+			for (int i = 0; i < NUM_FULL_OFFSETS; i++)
+				page->header.full_offsets[i] =
+					(i < num_offsets) ? offsets[i] : InvalidOffsetNumber;
+			return;
+		}
+
+		/* header is full, convert the entry to a bitmap */
+		TidStoreSetBlockOffsets(ts, blkno, offsets, num_offsets);
+		return;
+	}
+
+	wordnum = WORDNUM(off);
+	if (wordnum < page->header.nwords)
+	{
+		/* the existing bitmap covers this offset; set the bit in place */
+		page->words[wordnum] |= ((bitmapword) 1 << BITNUM(off));
+	}
+	else
+	{
+		/* need a wider bitmap; build one and replace the entry */
+		union
+		{
+			char		data[MaxBlocktableEntrySize];
+			BlocktableEntry force_align_entry;
+		}			data;
+		BlocktableEntry *newpage = (BlocktableEntry *) data.data;
+
+		memset(newpage, 0, offsetof(BlocktableEntry, words));
+		memset(newpage->words, 0, sizeof(bitmapword) * (wordnum + 1));
+		memcpy(newpage->words, page->words,
+			   sizeof(bitmapword) * page->header.nwords);
+		newpage->words[wordnum] |= ((bitmapword) 1 << BITNUM(off));
+		newpage->header.nwords = wordnum + 1;
+
+		local_ts_set(ts->tree.local, blkno, newpage);
+	}
+}
+
 /* Return true if the given TID is present in the TidStore */
 bool
 TidStoreIsMember(TidStore *ts, ItemPointer tid)
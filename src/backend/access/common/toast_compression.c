@@ -208,6 +208,45 @@ lz4_decompress_datum(const struct varlena *value)
 #endif
 }
 
+/*
+ * Determine how much compressed data is needed to guarantee that a prefix of
+ * slicelength bytes can be decompressed, given the total compressed size.
+ * This is the LZ4 counterpart of pglz_maximum_compressed_size.
+ */
+int32
+lz4_maximum_compressed_size(int32 slicelength, int32 total_compressed_size)
+{
+#ifndef USE_LZ4
+	NO_LZ4_SUPPORT();
+	return 0;					/* keep compiler quiet */
+#else
+	int32		result;
+
+	/*
+	 * Decoding from a truncated compressed input relies on the partial
+	 * decoding behavior of v1.9.0 or newer, which clamps a literal run to
+	 * the requested output size before checking the input bound.
+	 */
+	if (LZ4_versionNumber() < 10900)
+		return total_compressed_size;
+
+	/*
+	 * In the worst case the requested prefix is encoded entirely as
+	 * literals, costing one extra length byte per 255 literal bytes on top
+	 * of the sequence tokens; matches only ever shrink the input needed.
+	 * That worst case is exactly what LZ4_compressBound() computes (plus a
+	 * little slack), so that many compressed bytes always suffice.  A zero
+	 * or negative result means the length is out of range; fetch everything
+	 * then.
+	 */
+	result = LZ4_compressBound(slicelength);
+	if (result <= 0 || result >= total_compressed_size)
+		return total_compressed_size;
+
+	return result;
+#endif
+}
+
 /*
  * Decompress part of a varlena that was compressed using LZ4.
  */
@@ -15,6 +15,10 @@
 #include "postgres.h"
 
 #include "access/gin_private.h"
+#include "port/pg_bitutils.h"
+#ifdef WORDS_BIGENDIAN
+#include "port/pg_bswap.h"
+#endif
 
 #ifdef USE_ASSERT_CHECKING
 #define CHECK_ENCODING_ROUNDTRIP
@@ -182,6 +186,80 @@ decode_varbyte(unsigned char **ptr)
 	return val;
 }
 
+/*
+ * Variant of decode_varbyte() for use when at least 8 bytes are known to be
+ * readable at *ptr.  Decoding with a single 8-byte load avoids the chain of
+ * data-dependent branches in decode_varbyte(), which matters when decoding
+ * large posting trees.
+ */
+static inline uint64
+decode_varbyte_fast(unsigned char **ptr)
+{
+	uint64		chunk;
+	uint64		terminators;
+	int			nbytes;
+	uint64		val;
+
+	memcpy(&chunk, *ptr, sizeof(chunk));
+#ifdef WORDS_BIGENDIAN
+	chunk = pg_bswap64(chunk);
+#endif
+
+	/*
+	 * The integer ends at the first byte with the continuation bit clear.
+	 * With no terminator among the loaded bytes this would be a 7-byte
+	 * integer whose last byte we haven't loaded; that's rare enough to just
+	 * punt to the byte-at-a-time path.
+	 */
+	terminators = ~chunk & UINT64CONST(0x8080808080808080);
+	if (unlikely(terminators == 0))
+		return decode_varbyte(ptr);
+
+	nbytes = pg_rightmost_one_pos64(terminators) / BITS_PER_BYTE + 1;
+	*ptr += nbytes;
+
+	/* zap the bytes that belong to the next integer */
+	chunk &= UINT64CONST(0xFFFFFFFFFFFFFFFF) >> (64 - BITS_PER_BYTE * nbytes);
+
+	/* squeeze out the continuation bits, packing 7 data bits per byte */
+	val = chunk & 0x7F;
+	val |= (chunk >> 1) & (UINT64CONST(0x7F) << 7);
+	val |= (chunk >> 2) & (UINT64CONST(0x7F) << 14);
+	val |= (chunk >> 3) & (UINT64CONST(0x7F) << 21);
+	val |= (chunk >> 4) & (UINT64CONST(0x7F) << 28);
+	val |= (chunk >> 5) & (UINT64CONST(0x7F) << 35);
+	val |= (chunk >> 6) & (UINT64CONST(0x7F) << 42);
+
+	return val;
+}
+
+/*
+ * Count the number of integers encoded in 'nbytes' bytes of varbyte data.
+ * Each integer's last byte has the continuation bit clear, so it suffices to
+ * count the bytes with the high bit unset.
+ */
+static int
+count_encoded_integers(const unsigned char *ptr, int nbytes)
+{
+	int			count = 0;
+	int			i = 0;
+
+	for (; i + (int) sizeof(uint64) <= nbytes; i += sizeof(uint64))
+	{
+		uint64		chunk;
+
+		memcpy(&chunk, ptr + i, sizeof(chunk));
+		count += pg_popcount64(~chunk & UINT64CONST(0x8080808080808080));
+	}
+	for (; i < nbytes; i++)
+	{
+		if ((ptr[i] & 0x80) == 0)
+			count++;
+	}
+
+	return count;
+}
+
 /*
  * Encode a posting list.
  *
@@ -297,29 +375,28 @@ ItemPointer
 ginPostingListDecodeAllSegments(GinPostingList *segment, int len, int *ndecoded_out)
 {
 	ItemPointer result;
-	int			nallocated;
+	int			nitems;
 	uint64		val;
 	char	   *endseg = ((char *) segment) + len;
 	int			ndecoded;
 	unsigned char *ptr;
 	unsigned char *endptr;
+	GinPostingList *seg;
 
 	/*
-	 * Guess an initial size of the array.
+	 * Compute the exact number of items, so that the result array can be
+	 * allocated to the right size up front and the decode loops below need no
+	 * overflow checks.
 	 */
-	nallocated = segment->nbytes * 2 + 1;
-	result = palloc(nallocated * sizeof(ItemPointerData));
+	nitems = 0;
+	for (seg = segment; (char *) seg < endseg; seg = GinNextPostingListSegment(seg))
+		nitems += 1 + count_encoded_integers(seg->bytes, seg->nbytes);
+
+	result = palloc(nitems * sizeof(ItemPointerData));
 
 	ndecoded = 0;
 	while ((char *) segment < endseg)
 	{
-		/* enlarge output array if needed */
-		if (ndecoded >= nallocated)
-		{
-			nallocated *= 2;
-			result = repalloc(result, nallocated * sizeof(ItemPointerData));
-		}
-
 		/* copy the first item */
 		Assert(OffsetNumberIsValid(ItemPointerGetOffsetNumber(&segment->first)));
 		Assert(ndecoded == 0 || ginCompareItemPointers(&segment->first, &result[ndecoded - 1]) > 0);
@@ -329,15 +406,20 @@ ginPostingListDecodeAllSegments(GinPostingList *segment, int len, int *ndecoded_
 		val = itemptr_to_uint64(&segment->first);
 		ptr = segment->bytes;
 		endptr = segment->bytes + segment->nbytes;
-		while (ptr < endptr)
+
+		/*
+		 * Use the word-at-a-time decoder as long as a full 8-byte load cannot
+		 * read past the end of the segment, then finish off byte-at-a-time.
+		 */
+		while (ptr + sizeof(uint64) <= endptr)
 		{
-			/* enlarge output array if needed */
-			if (ndecoded >= nallocated)
-			{
-				nallocated *= 2;
-				result = repalloc(result, nallocated * sizeof(ItemPointerData));
-			}
+			val += decode_varbyte_fast(&ptr);
 
+			uint64_to_itemptr(val, &result[ndecoded]);
+			ndecoded++;
+		}
+		while (ptr < endptr)
+		{
 			val += decode_varbyte(&ptr);
 
 			uint64_to_itemptr(val, &result[ndecoded]);
@@ -346,6 +428,8 @@ ginPostingListDecodeAllSegments(GinPostingList *segment, int len, int *ndecoded_
 		segment = GinNextPostingListSegment(segment);
 	}
 
+	Assert(ndecoded == nitems);
+
 	if (ndecoded_out)
 		*ndecoded_out = ndecoded;
 	return result;
@@ -1759,3 +1759,30 @@ gist_point_sortsupport(PG_FUNCTION_ARGS)
 	}
 	PG_RETURN_VOID();
 }
+
+/*
+ * Sort support routine for fast GiST index build by sorting, for opclasses
+ * that store a BOX leaf key (box_ops, poly_ops and circle_ops).
+ *
+ * point_ops stores points as zero-area boxes, so the Z-order comparison
+ * routines above already operate on BOX keys; sorting real boxes by the
+ * Z-value of their lower-left corner works just as well.
+ */
+Datum
+gist_box_sortsupport(PG_FUNCTION_ARGS)
+{
+	SortSupport ssup = (SortSupport) PG_GETARG_POINTER(0);
+
+	if (ssup->abbreviate)
+	{
+		ssup->comparator = ssup_datum_unsigned_cmp;
+		ssup->abbrev_converter = gist_bbox_zorder_abbrev_convert;
+		ssup->abbrev_abort = gist_bbox_zorder_abbrev_abort;
+		ssup->abbrev_full_comparator = gist_bbox_zorder_cmp;
+	}
+	else
+	{
+		ssup->comparator = gist_bbox_zorder_cmp;
+	}
+	PG_RETURN_VOID();
+}
@@ -20,26 +20,143 @@
 
 #include "access/hash.h"
 #include "access/hash_xlog.h"
+#include "access/parallel.h"
 #include "access/relscan.h"
 #include "access/stratnum.h"
+#include "access/table.h"
 #include "access/tableam.h"
 #include "access/xloginsert.h"
+#include "catalog/index.h"
 #include "commands/progress.h"
 #include "commands/vacuum.h"
+#include "executor/instrument.h"
 #include "miscadmin.h"
 #include "nodes/execnodes.h"
 #include "optimizer/plancat.h"
 #include "pgstat.h"
+#include "tcop/tcopprot.h"
 #include "utils/fmgrprotos.h"
 #include "utils/index_selfuncs.h"
 #include "utils/rel.h"
 
+/* Magic numbers for parallel state sharing */
+#define PARALLEL_KEY_HASH_SHARED		UINT64CONST(0xC000000000000001)
+#define PARALLEL_KEY_TUPLESORT			UINT64CONST(0xC000000000000002)
+#define PARALLEL_KEY_QUERY_TEXT			UINT64CONST(0xC000000000000003)
+#define PARALLEL_KEY_WAL_USAGE			UINT64CONST(0xC000000000000004)
+#define PARALLEL_KEY_BUFFER_USAGE		UINT64CONST(0xC000000000000005)
+
+/*
+ * Status for parallel index builds.  This is allocated in a dynamic shared
+ * memory segment.  Note that there is a separate tuplesort TOC entry,
+ * private to tuplesort.c but allocated by this module on its behalf.
+ */
+typedef struct HashShared
+{
+	/*
+	 * These fields are not modified during the build.  They primarily exist
+	 * for the benefit of worker processes that need to create spool state
+	 * corresponding to that used by the leader.
+	 */
+	Oid			heaprelid;
+	Oid			indexrelid;
+	bool		isconcurrent;
+	uint32		num_buckets;
+	int			scantuplesortstates;
+
+	/* Query ID, for report in worker processes */
+	int64		queryid;
+
+	/*
+	 * workersdonecv is used to monitor the progress of workers.  All parallel
+	 * participants must indicate that they are done before leader can use
+	 * mutable state that workers maintain during scan (and before leader can
+	 * proceed to tuplesort_performsort()).
+	 */
+	ConditionVariable workersdonecv;
+
+	/*
+	 * mutex protects all following fields
+	 *
+	 * These fields contain status information of interest to hash index
+	 * builds that must work just the same when an index is built in
+	 * parallel.
+	 */
+	slock_t		mutex;
+
+	/*
+	 * Mutable state that is maintained by workers, and reported back to
+	 * leader at end of the scans.
+	 *
+	 * nparticipantsdone is number of worker processes finished.
+	 *
+	 * reltuples is the total number of input heap tuples.
+	 *
+	 * indtuples is the total number of tuples that made it into the sort.
+	 */
+	int			nparticipantsdone;
+	double		reltuples;
+	double		indtuples;
+
+	/*
+	 * ParallelTableScanDescData data follows. Can't directly embed here, as
+	 * implementations of the parallel table scan desc interface might need
+	 * stronger alignment.
+	 */
+} HashShared;
+
+/*
+ * Return pointer to a HashShared's parallel table scan.
+ *
+ * c.f. shm_toc_allocate as to why BUFFERALIGN is used, rather than just
+ * MAXALIGN.
+ */
+#define ParallelTableScanFromHashShared(shared) \
+	(ParallelTableScanDesc) ((char *) (shared) + BUFFERALIGN(sizeof(HashShared)))
+
+/*
+ * Status for leader in parallel index build.
+ */
+typedef struct HashLeader
+{
+	/* parallel context itself */
+	ParallelContext *pcxt;
+
+	/*
+	 * nparticipanttuplesorts is the exact number of worker processes
+	 * successfully launched, plus one leader process if it participates as a
+	 * worker.
+	 */
+	int			nparticipanttuplesorts;
+
+	/*
+	 * Leader process convenience pointers to shared state (leader avoids TOC
+	 * lookups).
+	 *
+	 * hashshared is the shared state for entire build.  sharedsort is the
+	 * shared, tuplesort-managed state passed to each process tuplesort.
+	 * snapshot is the snapshot used by the scan iff an MVCC snapshot is
+	 * required.
+	 */
+	HashShared *hashshared;
+	Sharedsort *sharedsort;
+	Snapshot	snapshot;
+	WalUsage   *walusage;
+	BufferUsage *bufferusage;
+} HashLeader;
+
 /* Working state for hashbuild and its callback */
-typedef struct
+typedef struct HashBuildState
 {
 	HSpool	   *spool;			/* NULL if not using spooling */
 	double		indtuples;		/* # tuples accepted into index */
 	Relation	heapRel;		/* heap relation descriptor */
+
+	/*
+	 * hleader is only present when a parallel index build is performed, and
+	 * only in the leader process.
+	 */
+	HashLeader *hleader;
 } HashBuildState;
 
 static void hashbuildCallback(Relation index,
@@ -48,6 +165,18 @@ static void hashbuildCallback(Relation index,
 							  bool *isnull,
 							  bool tupleIsAlive,
 							  void *state);
+static void _h_begin_parallel(HashBuildState *buildstate, Relation heap,
+							  Relation index, uint32 num_buckets,
+							  bool isconcurrent, int request);
+static void _h_end_parallel(HashLeader *hleader);
+static Size _h_parallel_estimate_shared(Relation heap, Snapshot snapshot);
+static double _h_parallel_heapscan(HashBuildState *buildstate);
+static void _h_leader_participate_as_worker(HashBuildState *buildstate,
+											Relation heap, Relation index);
+static void _h_parallel_scan_and_sort(Relation heap, Relation index,
+									  HashShared *hashshared,
+									  Sharedsort *sharedsort,
+									  int sortmem, bool progress);
 
 
 /*
@@ -77,7 +206,7 @@ hashhandler(PG_FUNCTION_ARGS)
 	amroutine->amclusterable = false;
 	amroutine->ampredlocks = true;
 	amroutine->amcanparallel = false;
-	amroutine->amcanbuildparallel = false;
+	amroutine->amcanbuildparallel = true;
 	amroutine->amcaninclude = false;
 	amroutine->amusemaintenanceworkmem = false;
 	amroutine->amsummarizing = false;
@@ -167,19 +296,56 @@ hashbuild(Relation heap, Relation index, IndexInfo *indexInfo)
 	else
 		sort_threshold = Min(sort_threshold, NLocBuffer);
 
-	if (num_buckets >= sort_threshold)
-		buildstate.spool = _h_spoolinit(heap, index, num_buckets);
-	else
-		buildstate.spool = NULL;
-
 	/* prepare to build the index */
+	buildstate.spool = NULL;
 	buildstate.indtuples = 0;
 	buildstate.heapRel = heap;
+	buildstate.hleader = NULL;
+
+	if (num_buckets >= sort_threshold)
+	{
+		SortCoordinate coordinate = NULL;
 
-	/* do the heap scan */
-	reltuples = table_index_build_scan(heap, index, indexInfo, true, true,
-									   hashbuildCallback,
-									   &buildstate, NULL);
+		/*
+		 * Attempt to launch parallel worker scan when required.  Parallelism
+		 * is only used on the spooling path, since the expensive part of a
+		 * large build is the bucket-order sort, which workers can share.
+		 */
+		if (indexInfo->ii_ParallelWorkers > 0)
+			_h_begin_parallel(&buildstate, heap, index, num_buckets,
+							  indexInfo->ii_Concurrent,
+							  indexInfo->ii_ParallelWorkers);
+
+		/*
+		 * If parallel build requested and at least one worker process was
+		 * successfully launched, set up coordination state
+		 */
+		if (buildstate.hleader)
+		{
+			coordinate = (SortCoordinate) palloc0(sizeof(SortCoordinateData));
+			coordinate->isWorker = false;
+			coordinate->nParticipants =
+				buildstate.hleader->nparticipanttuplesorts;
+			coordinate->sharedsort = buildstate.hleader->sharedsort;
+		}
+
+		/*
+		 * Begin the serial/leader tuplesort.  The leader gets the same share
+		 * of maintenance_work_mem as a serial sort; worker tuplesorts will
+		 * have received only a fraction of it (see notes about parallelism
+		 * and maintenance_work_mem in nbtsort.c's _bt_spools_heapscan).
+		 */
+		buildstate.spool = _h_spoolinit(heap, index, num_buckets, coordinate,
+										maintenance_work_mem);
+	}
+
+	/* do the heap scan, either serially or by joining the parallel scan */
+	if (!buildstate.hleader)
+		reltuples = table_index_build_scan(heap, index, indexInfo, true, true,
+										   hashbuildCallback,
+										   &buildstate, NULL);
+	else
+		reltuples = _h_parallel_heapscan(&buildstate);
 	pgstat_progress_update_param(PROGRESS_CREATEIDX_TUPLES_TOTAL,
 								 buildstate.indtuples);
 
@@ -189,6 +355,8 @@ hashbuild(Relation heap, Relation index, IndexInfo *indexInfo)
 		_h_indexbuild(buildstate.spool, buildstate.heapRel);
 		_h_spooldestroy(buildstate.spool);
 	}
+	if (buildstate.hleader)
+		_h_end_parallel(buildstate.hleader);
 
 	/*
 	 * Return statistics
@@ -248,6 +416,432 @@ hashbuildCallback(Relation index,
 	buildstate->indtuples += 1;
 }
 
+/*
+ * Create parallel context, and launch workers for leader.
+ *
+ * buildstate argument should be initialized (with the exception of the
+ * spool, which is created afterwards based on shared state initially set
+ * up here).
+ *
+ * isconcurrent indicates if operation is CREATE INDEX CONCURRENTLY.
+ *
+ * request is the target number of parallel worker processes to launch.
+ *
+ * Sets buildstate's HashLeader, which caller must use to shut down parallel
+ * mode by passing it to _h_end_parallel() at the very end of its index
+ * build.  If not even a single worker process can be launched, this is
+ * never set, and caller should proceed with a serial index build.
+ */
+static void
+_h_begin_parallel(HashBuildState *buildstate, Relation heap, Relation index,
+				  uint32 num_buckets, bool isconcurrent, int request)
+{
+	ParallelContext *pcxt;
+	int			scantuplesortstates;
+	Snapshot	snapshot;
+	Size		esthashshared;
+	Size		estsort;
+	HashShared *hashshared;
+	Sharedsort *sharedsort;
+	HashLeader *hleader = (HashLeader *) palloc0(sizeof(HashLeader));
+	WalUsage   *walusage;
+	BufferUsage *bufferusage;
+	bool		leaderparticipates = true;
+	int			querylen;
+
+	/*
+	 * Enter parallel mode, and create context for parallel build of hash
+	 * index
+	 */
+	EnterParallelMode();
+	Assert(request > 0);
+	pcxt = CreateParallelContext("postgres", "_h_parallel_build_main",
+								 request);
+
+	scantuplesortstates = leaderparticipates ? request + 1 : request;
+
+	/*
+	 * Prepare for scan of the base relation.  In a normal index build, we use
+	 * SnapshotAny because we must retrieve all tuples and do our own time
+	 * qual checks (because we have to index RECENTLY_DEAD tuples).  In a
+	 * concurrent build, we take a regular MVCC snapshot and index whatever's
+	 * live according to that.
+	 */
+	if (!isconcurrent)
+		snapshot = SnapshotAny;
+	else
+		snapshot = RegisterSnapshot(GetTransactionSnapshot());
+
+	/*
+	 * Estimate size for our own PARALLEL_KEY_HASH_SHARED workspace, and
+	 * PARALLEL_KEY_TUPLESORT tuplesort workspace
+	 */
+	esthashshared = _h_parallel_estimate_shared(heap, snapshot);
+	shm_toc_estimate_chunk(&pcxt->estimator, esthashshared);
+	estsort = tuplesort_estimate_shared(scantuplesortstates);
+	shm_toc_estimate_chunk(&pcxt->estimator, estsort);
+	shm_toc_estimate_keys(&pcxt->estimator, 2);
+
+	/*
+	 * Estimate space for WalUsage and BufferUsage -- PARALLEL_KEY_WAL_USAGE
+	 * and PARALLEL_KEY_BUFFER_USAGE.
+	 *
+	 * If there are no extensions loaded that care, we could skip this.  We
+	 * have no way of knowing whether anyone's looking at pgWalUsage or
+	 * pgBufferUsage, so do it unconditionally.
+	 */
+	shm_toc_estimate_chunk(&pcxt->estimator,
+						   mul_size(sizeof(WalUsage), pcxt->nworkers));
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+	shm_toc_estimate_chunk(&pcxt->estimator,
+						   mul_size(sizeof(BufferUsage), pcxt->nworkers));
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+
+	/* Finally, estimate PARALLEL_KEY_QUERY_TEXT space */
+	if (debug_query_string)
+	{
+		querylen = strlen(debug_query_string);
+		shm_toc_estimate_chunk(&pcxt->estimator, querylen + 1);
+		shm_toc_estimate_keys(&pcxt->estimator, 1);
+	}
+	else
+		querylen = 0;			/* keep compiler quiet */
+
+	/* Everyone's had a chance to ask for space, so now create the DSM */
+	InitializeParallelDSM(pcxt);
+
+	/* If no DSM segment was available, back out (do serial build) */
+	if (pcxt->seg == NULL)
+	{
+		if (IsMVCCSnapshot(snapshot))
+			UnregisterSnapshot(snapshot);
+		DestroyParallelContext(pcxt);
+		ExitParallelMode();
+		return;
+	}
+
+	/* Store shared build state, for which we reserved space */
+	hashshared = (HashShared *) shm_toc_allocate(pcxt->toc, esthashshared);
+	/* Initialize immutable state */
+	hashshared->heaprelid = RelationGetRelid(heap);
+	hashshared->indexrelid = RelationGetRelid(index);
+	hashshared->isconcurrent = isconcurrent;
+	hashshared->num_buckets = num_buckets;
+	hashshared->scantuplesortstates = scantuplesortstates;
+	hashshared->queryid = pgstat_get_my_query_id();
+	ConditionVariableInit(&hashshared->workersdonecv);
+	SpinLockInit(&hashshared->mutex);
+	/* Initialize mutable state */
+	hashshared->nparticipantsdone = 0;
+	hashshared->reltuples = 0.0;
+	hashshared->indtuples = 0.0;
+	table_parallelscan_initialize(heap,
+								  ParallelTableScanFromHashShared(hashshared),
+								  snapshot);
+
+	/*
+	 * Store shared tuplesort-private state, for which we reserved space.
+	 * Then, initialize opaque state using tuplesort routine.
+	 */
+	sharedsort = (Sharedsort *) shm_toc_allocate(pcxt->toc, estsort);
+	tuplesort_initialize_shared(sharedsort, scantuplesortstates,
+								pcxt->seg);
+
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_HASH_SHARED, hashshared);
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_TUPLESORT, sharedsort);
+
+	/* Store query string for workers */
+	if (debug_query_string)
+	{
+		char	   *sharedquery;
+
+		sharedquery = (char *) shm_toc_allocate(pcxt->toc, querylen + 1);
+		memcpy(sharedquery, debug_query_string, querylen + 1);
+		shm_toc_insert(pcxt->toc, PARALLEL_KEY_QUERY_TEXT, sharedquery);
+	}
+
+	/*
+	 * Allocate space for each worker's WalUsage and BufferUsage; no need to
+	 * initialize.
+	 */
+	walusage = shm_toc_allocate(pcxt->toc,
+								mul_size(sizeof(WalUsage), pcxt->nworkers));
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_WAL_USAGE, walusage);
+	bufferusage = shm_toc_allocate(pcxt->toc,
+								   mul_size(sizeof(BufferUsage), pcxt->nworkers));
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_BUFFER_USAGE, bufferusage);
+
+	/* Launch workers, saving status for leader/caller */
+	LaunchParallelWorkers(pcxt);
+	hleader->pcxt = pcxt;
+	hleader->nparticipanttuplesorts = pcxt->nworkers_launched;
+	if (leaderparticipates)
+		hleader->nparticipanttuplesorts++;
+	hleader->hashshared = hashshared;
+	hleader->sharedsort = sharedsort;
+	hleader->snapshot = snapshot;
+	hleader->walusage = walusage;
+	hleader->bufferusage = bufferusage;
+
+	/* If no workers were successfully launched, back out (do serial build) */
+	if (pcxt->nworkers_launched == 0)
+	{
+		_h_end_parallel(hleader);
+		return;
+	}
+
+	/* Save leader state now that it's clear build will be parallel */
+	buildstate->hleader = hleader;
+
+	/* Join heap scan ourselves */
+	if (leaderparticipates)
+		_h_leader_participate_as_worker(buildstate, heap, index);
+
+	/*
+	 * Caller needs to wait for all launched workers when we return.  Make
+	 * sure that the failure-to-start case will not hang forever.
+	 */
+	WaitForParallelWorkersToAttach(pcxt);
+}
+
+/*
+ * Shut down workers, destroy parallel context, and end parallel mode.
+ */
+static void
+_h_end_parallel(HashLeader *hleader)
+{
+	int			i;
+
+	/* Shutdown worker processes */
+	WaitForParallelWorkersToFinish(hleader->pcxt);
+
+	/*
+	 * Next, accumulate WAL usage.  (This must wait for the workers to finish,
+	 * or we might get incomplete data.)
+	 */
+	for (i = 0; i < hleader->pcxt->nworkers_launched; i++)
+		InstrAccumParallelQuery(&hleader->bufferusage[i], &hleader->walusage[i]);
+
+	/* Free last reference to MVCC snapshot, if one was used */
+	if (IsMVCCSnapshot(hleader->snapshot))
+		UnregisterSnapshot(hleader->snapshot);
+	DestroyParallelContext(hleader->pcxt);
+	ExitParallelMode();
+}
+
+/*
+ * Returns size of shared memory required to store state for a parallel
+ * hash index build based on the snapshot its parallel scan will use.
+ */
+static Size
+_h_parallel_estimate_shared(Relation heap, Snapshot snapshot)
+{
+	/* c.f. shm_toc_allocate as to why BUFFERALIGN is used */
+	return add_size(BUFFERALIGN(sizeof(HashShared)),
+					table_parallelscan_estimate(heap, snapshot));
+}
+
+/*
+ * Within leader, wait for end of heap scan.
+ *
+ * When called, parallel heap scan started by _h_begin_parallel() will
+ * already be underway within worker processes (when leader participates
+ * as a worker, we should end up here just as workers are finishing).
+ *
+ * Fills in fields needed for ambuild statistics.
+ *
+ * Returns the total number of heap tuples scanned.
+ */
+static double
+_h_parallel_heapscan(HashBuildState *buildstate)
+{
+	HashShared *hashshared = buildstate->hleader->hashshared;
+	int			nparticipanttuplesorts;
+	double		reltuples;
+
+	nparticipanttuplesorts = buildstate->hleader->nparticipanttuplesorts;
+	for (;;)
+	{
+		SpinLockAcquire(&hashshared->mutex);
+		if (hashshared->nparticipantsdone == nparticipanttuplesorts)
+		{
+			buildstate->indtuples = hashshared->indtuples;
+			reltuples = hashshared->reltuples;
+			SpinLockRelease(&hashshared->mutex);
+			break;
+		}
+		SpinLockRelease(&hashshared->mutex);
+
+		ConditionVariableSleep(&hashshared->workersdonecv,
+							   WAIT_EVENT_PARALLEL_CREATE_INDEX_SCAN);
+	}
+
+	ConditionVariableCancelSleep();
+
+	return reltuples;
+}
+
+/*
+ * Within leader, participate as a parallel worker.
+ */
+static void
+_h_leader_participate_as_worker(HashBuildState *buildstate, Relation heap,
+								Relation index)
+{
+	HashLeader *hleader = buildstate->hleader;
+	int			sortmem;
+
+	/*
+	 * Might as well use reliable figure when doling out maintenance_work_mem
+	 * (when requested number of workers were not launched, this will be
+	 * somewhat higher than it is for other workers).
+	 */
+	sortmem = maintenance_work_mem / hleader->nparticipanttuplesorts;
+
+	/* Perform work common to all participants */
+	_h_parallel_scan_and_sort(heap, index, hleader->hashshared,
+							  hleader->sharedsort, sortmem, true);
+}
+
+/*
+ * Perform work within a launched parallel process.
+ */
+void
+_h_parallel_build_main(dsm_segment *seg, shm_toc *toc)
+{
+	char	   *sharedquery;
+	HashShared *hashshared;
+	Sharedsort *sharedsort;
+	Relation	heapRel;
+	Relation	indexRel;
+	LOCKMODE	heapLockmode;
+	LOCKMODE	indexLockmode;
+	WalUsage   *walusage;
+	BufferUsage *bufferusage;
+	int			sortmem;
+
+	/*
+	 * The only possible status flag that can be set to the parallel worker is
+	 * PROC_IN_SAFE_IC.
+	 */
+	Assert((MyProc->statusFlags == 0) ||
+		   (MyProc->statusFlags == PROC_IN_SAFE_IC));
+
+	/* Set debug_query_string for individual workers first */
+	sharedquery = shm_toc_lookup(toc, PARALLEL_KEY_QUERY_TEXT, true);
+	debug_query_string = sharedquery;
+
+	/* Report the query string from leader */
+	pgstat_report_activity(STATE_RUNNING, debug_query_string);
+
+	/* Look up hash shared state */
+	hashshared = shm_toc_lookup(toc, PARALLEL_KEY_HASH_SHARED, false);
+
+	/* Open relations using lock modes known to be obtained by index.c */
+	if (!hashshared->isconcurrent)
+	{
+		heapLockmode = ShareLock;
+		indexLockmode = AccessExclusiveLock;
+	}
+	else
+	{
+		heapLockmode = ShareUpdateExclusiveLock;
+		indexLockmode = RowExclusiveLock;
+	}
+
+	/* Track query ID */
+	pgstat_report_query_id(hashshared->queryid, false);
+
+	/* Open relations within worker */
+	heapRel = table_open(hashshared->heaprelid, heapLockmode);
+	indexRel = index_open(hashshared->indexrelid, indexLockmode);
+
+	/* Look up shared state private to tuplesort.c */
+	sharedsort = shm_toc_lookup(toc, PARALLEL_KEY_TUPLESORT, false);
+	tuplesort_attach_shared(sharedsort, seg);
+
+	/* Prepare to track buffer usage during parallel execution */
+	InstrStartParallelQuery();
+
+	/* Perform sorting of spool */
+	sortmem = maintenance_work_mem / hashshared->scantuplesortstates;
+	_h_parallel_scan_and_sort(heapRel, indexRel, hashshared, sharedsort,
+							  sortmem, false);
+
+	/* Report WAL/buffer usage during parallel execution */
+	bufferusage = shm_toc_lookup(toc, PARALLEL_KEY_BUFFER_USAGE, false);
+	walusage = shm_toc_lookup(toc, PARALLEL_KEY_WAL_USAGE, false);
+	InstrEndParallelQuery(&bufferusage[ParallelWorkerNumber],
+						  &walusage[ParallelWorkerNumber]);
+
+	index_close(indexRel, indexLockmode);
+	table_close(heapRel, heapLockmode);
+}
+
+/*
+ * Perform a participant's portion of a parallel sort.
+ *
+ * This generates a spool (and tuplesort) for the participant, scans the
+ * participant's portion of the parallel heap scan into it, and sorts the
+ * spooled tuples by bucket number.  The sorted runs of all participants
+ * are merged by the leader's tuplesort in _h_indexbuild; only the leader
+ * inserts into the index.
+ *
+ * sortmem is the amount of working memory to use within each participant,
+ * expressed in KBs.
+ *
+ * When this returns, workers are done, and need only release resources.
+ */
+static void
+_h_parallel_scan_and_sort(Relation heap, Relation index,
+						  HashShared *hashshared, Sharedsort *sharedsort,
+						  int sortmem, bool progress)
+{
+	SortCoordinate coordinate;
+	HashBuildState buildstate;
+	TableScanDesc scan;
+	double		reltuples;
+	IndexInfo  *indexInfo;
+
+	/* Initialize local tuplesort coordination state */
+	coordinate = palloc0(sizeof(SortCoordinateData));
+	coordinate->isWorker = true;
+	coordinate->nParticipants = -1;
+	coordinate->sharedsort = sharedsort;
+
+	/* Begin "partial" tuplesort, wrapped in this participant's spool */
+	buildstate.spool = _h_spoolinit(heap, index, hashshared->num_buckets,
+									coordinate, sortmem);
+	buildstate.indtuples = 0;
+	buildstate.heapRel = heap;
+	buildstate.hleader = NULL;
+
+	/* Join parallel scan */
+	indexInfo = BuildIndexInfo(index);
+	indexInfo->ii_Concurrent = hashshared->isconcurrent;
+	scan = table_beginscan_parallel(heap,
+									ParallelTableScanFromHashShared(hashshared));
+	reltuples = table_index_build_scan(heap, index, indexInfo,
+									   true, progress, hashbuildCallback,
+									   &buildstate, scan);
+
+	/* Execute this participant's part of the sort */
+	_h_performsort(buildstate.spool);
+
+	/* Done.  Record ambuild statistics. */
+	SpinLockAcquire(&hashshared->mutex);
+	hashshared->nparticipantsdone++;
+	hashshared->reltuples += reltuples;
+	hashshared->indtuples += buildstate.indtuples;
+	SpinLockRelease(&hashshared->mutex);
+
+	/* Notify leader */
+	ConditionVariableSignal(&hashshared->workersdonecv);
+
+	/* We can end tuplesorts immediately */
+	_h_spooldestroy(buildstate.spool);
+}
+
 /*
  *	hashinsert() -- insert an index tuple into a hash table.
  *
@@ -55,9 +55,15 @@ struct HSpool
 
 /*
  * create and initialize a spool structure
+ *
+ * In a parallel build, each participant spools into its own HSpool, tied
+ * together by the caller-supplied coordinate state; serial builds pass a
+ * NULL coordinate.  sortmem is this participant's share of the sort memory
+ * budget, in KB.
  */
 HSpool *
-_h_spoolinit(Relation heap, Relation index, uint32 num_buckets)
+_h_spoolinit(Relation heap, Relation index, uint32 num_buckets,
+			 SortCoordinate coordinate, int sortmem)
 {
 	HSpool	   *hspool = (HSpool *) palloc0(sizeof(HSpool));
 
@@ -76,17 +82,17 @@ _h_spoolinit(Relation heap, Relation index, uint32 num_buckets)
 	hspool->max_buckets = num_buckets - 1;
 
 	/*
-	 * We size the sort area as maintenance_work_mem rather than work_mem to
-	 * speed index creation.  This should be OK since a single backend can't
-	 * run multiple index creations in parallel.
+	 * Serial callers size the sort area as maintenance_work_mem rather than
+	 * work_mem to speed index creation.  This should be OK since a single
+	 * backend can't run multiple index creations in parallel.
 	 */
 	hspool->sortstate = tuplesort_begin_index_hash(heap,
 												   index,
 												   hspool->high_mask,
 												   hspool->low_mask,
 												   hspool->max_buckets,
-												   maintenance_work_mem,
-												   NULL,
+												   sortmem,
+												   coordinate,
 												   TUPLESORT_NONE);
 
 	return hspool;
@@ -112,6 +118,18 @@ _h_spool(HSpool *hspool, ItemPointer self, const Datum *values, const bool *isnu
 								  self, values, isnull);
 }
 
+/*
+ * sort the tuples spooled by one participant of a parallel build.
+ *
+ * The sorted run is left behind for the leader to merge; only the leader
+ * inserts into the index, via _h_indexbuild on its own spool.
+ */
+void
+_h_performsort(HSpool *hspool)
+{
+	tuplesort_performsort(hspool->sortstate);
+}
+
 /*
  * given a spool loaded by successive calls to _h_spool,
  * create an entire index.
@@ -258,7 +258,9 @@ heap_scan_stream_read_next_parallel(ReadStream *stream,
 		/* parallel scan */
 		table_block_parallelscan_startblock_init(scan->rs_base.rs_rd,
 												 scan->rs_parallelworkerdata,
-												 (ParallelBlockTableScanDesc) scan->rs_base.rs_parallel);
+												 (ParallelBlockTableScanDesc) scan->rs_base.rs_parallel,
+												 scan->rs_startblock,
+												 scan->rs_numblocks);
 
 		/* may return InvalidBlockNumber if there are no more blocks */
 		scan->rs_prefetch_block = table_block_parallelscan_nextpage(scan->rs_base.rs_rd,
@@ -397,7 +399,19 @@ initscan(HeapScanDesc scan, ScanKey key, bool keep_startblock)
 	{
 		/* During a rescan, keep the previous strategy object. */
 		if (scan->rs_strategy == NULL)
-			scan->rs_strategy = GetAccessStrategy(BAS_BULKREAD);
+		{
+			/*
+			 * Let bulk_read_buffer_usage_limit override the automatic ring
+			 * sizing; a value of 0 disables the ring entirely, allowing the
+			 * scan to use the whole buffer pool.
+			 */
+			if (BulkReadBufferUsageLimit < 0)
+				scan->rs_strategy = GetAccessStrategy(BAS_BULKREAD);
+			else
+				scan->rs_strategy =
+					GetAccessStrategyWithSize(BAS_BULKREAD,
+											  BulkReadBufferUsageLimit);
+		}
 	}
 	else
 	{
@@ -413,6 +427,13 @@ initscan(HeapScanDesc scan, ScanKey key, bool keep_startblock)
 			scan->rs_base.rs_flags |= SO_ALLOW_SYNC;
 		else
 			scan->rs_base.rs_flags &= ~SO_ALLOW_SYNC;
+
+		/*
+		 * The startblock is determined by the parallel scan machinery in
+		 * table_block_parallelscan_startblock_init(), unless a specific
+		 * start page has been requested with heap_setscanlimits().
+		 */
+		scan->rs_startblock = InvalidBlockNumber;
 	}
 	else if (keep_startblock)
 	{
@@ -2301,7 +2322,9 @@ heap_prepare_insert(Relation relation, HeapTuple tup, TransactionId xid,
 		Assert(!HeapTupleHasExternal(tup));
 		return tup;
 	}
-	else if (HeapTupleHasExternal(tup) || tup->t_len > TOAST_TUPLE_THRESHOLD)
+	else if (HeapTupleHasExternal(tup) ||
+			 tup->t_len > RelationGetToastTupleTarget(relation,
+													  TOAST_TUPLE_THRESHOLD))
 		return heap_toast_insert_or_update(relation, tup, NULL, options);
 	else
 		return tup;
@@ -3007,7 +3030,7 @@ l1:
 	 * being visible to the scan (i.e., an exclusive buffer content lock is
 	 * continuously held from this point until the tuple delete is visible).
 	 */
-	CheckForSerializableConflictIn(relation, tid, BufferGetBlockNumber(buffer));
+	CheckForSerializableConflictIn(relation, tid, block);
 
 	/* replace cid with a combo CID if necessary */
 	HeapTupleHeaderAdjustCmax(tp.t_data, &cid, &iscombo);
@@ -3048,7 +3071,7 @@ l1:
 	{
 		all_visible_cleared = true;
 		PageClearAllVisible(page);
-		visibilitymap_clear(relation, BufferGetBlockNumber(buffer),
+		visibilitymap_clear(relation, block,
 							vmbuffer, VISIBILITYMAP_VALID_BITS);
 	}
 
@@ -3805,7 +3828,8 @@ l2:
 	else
 		need_toast = (HeapTupleHasExternal(&oldtup) ||
 					  HeapTupleHasExternal(newtup) ||
-					  newtup->t_len > TOAST_TUPLE_THRESHOLD);
+					  newtup->t_len > RelationGetToastTupleTarget(relation,
+																  TOAST_TUPLE_THRESHOLD));
 
 	pagefree = PageGetHeapFreeSpace(page);
 
@@ -30,8 +30,15 @@
 #include "access/heaptoast.h"
 #include "access/toast_helper.h"
 #include "access/toast_internals.h"
+#include "storage/bufmgr.h"
 #include "utils/fmgroids.h"
 
+/*
+ * Minimum number of chunks a slice must span before heap_fetch_toast_slice
+ * bothers with a read-ahead pass over the chunk heap blocks.
+ */
+#define TOAST_PREFETCH_MIN_CHUNKS	4
+
 
 /* ----------
  * heap_toast_delete -
@@ -683,6 +690,46 @@ heap_fetch_toast_slice(Relation toastrel, Oid valueid, int32 attrsize,
 		nscankeys = 3;
 	}
 
+	/*
+	 * If the slice spans enough chunks to make it worthwhile, make a
+	 * TID-only pass over the index first and start read-ahead of the heap
+	 * blocks holding the chunks, so that the fetch loop below overlaps its
+	 * I/O instead of stalling once per block.  The chunks of one value are
+	 * almost always laid down in consecutive heap pages, but asking the
+	 * index is hardly more expensive than guessing: this pass touches only
+	 * the same few index leaf pages the main scan is about to read, and no
+	 * heap blocks.
+	 */
+	if (effective_io_concurrency > 0 &&
+		endchunk - startchunk >= TOAST_PREFETCH_MIN_CHUNKS)
+	{
+		IndexScanDesc prefetchscan;
+		ItemPointer tid;
+		BlockNumber lastblk = InvalidBlockNumber;
+		int			nprefetched = 0;
+
+		prefetchscan = index_beginscan(toastrel, toastidxs[validIndex],
+									   get_toast_snapshot(), NULL,
+									   nscankeys, 0);
+		index_rescan(prefetchscan, toastkey, nscankeys, NULL, 0);
+
+		while ((tid = index_getnext_tid(prefetchscan,
+										ForwardScanDirection)) != NULL)
+		{
+			BlockNumber blk = ItemPointerGetBlockNumber(tid);
+
+			if (blk == lastblk)
+				continue;
+			PrefetchBuffer(toastrel, MAIN_FORKNUM, blk);
+			lastblk = blk;
+
+			/* Don't issue more read-ahead than the storage can absorb. */
+			if (++nprefetched >= effective_io_concurrency)
+				break;
+		}
+		index_endscan(prefetchscan);
+	}
+
 	/* Prepare for scan */
 	toastscan = systable_beginscan_ordered(toastrel, toastidxs[validIndex],
 										   get_toast_snapshot(), nscankeys, toastkey);
@@ -221,24 +221,23 @@ GetVisibilityMapPins(Relation relation, Buffer buffer1, Buffer buffer2,
  * into the FSM. Typically there is no contention when we can't use the FSM.
  *
  * We do have to limit the number of pages to extend by to some value, as the
- * buffers for all the extended pages need to, temporarily, be pinned. For now
- * we define MAX_BUFFERS_TO_EXTEND_BY to be 64 buffers, it's hard to see
- * benefits with higher numbers. This partially is because copyfrom.c's
- * MAX_BUFFERED_TUPLES / MAX_BUFFERED_BYTES prevents larger multi_inserts.
+ * buffers for all the extended pages need to, temporarily, be pinned. We
+ * define MAX_BUFFERS_TO_EXTEND_BY to be 256 buffers; with many concurrent
+ * bulk loaders into one relation, larger chunks make each loader visit the
+ * extension lock correspondingly less often, and 2MB chunks let
+ * mdzeroextend() fall through to a single sizable posix_fallocate() call.
+ * To avoid bloating small relations, we never extend beyond 64 pages by
+ * more than the relation's current size.
  *
  * Returns a buffer for a newly extended block. If possible, the buffer is
  * returned exclusively locked. *did_unlock is set to true if the lock had to
  * be released, false otherwise.
- *
- *
- * XXX: It would likely be beneficial for some workloads to extend more
- * aggressively, e.g. using a heuristic based on the relation size.
  */
 static Buffer
 RelationAddBlocks(Relation relation, BulkInsertState bistate,
 				  int num_pages, bool use_fsm, bool *did_unlock)
 {
-#define MAX_BUFFERS_TO_EXTEND_BY 64
+#define MAX_BUFFERS_TO_EXTEND_BY 256
 	Buffer		victim_buffers[MAX_BUFFERS_TO_EXTEND_BY];
 	BlockNumber first_block = InvalidBlockNumber;
 	BlockNumber last_block = InvalidBlockNumber;
@@ -305,6 +304,17 @@ RelationAddBlocks(Relation relation, BulkInsertState bistate,
 		 * them all concurrently.
 		 */
 		extend_by_pages = Min(extend_by_pages, MAX_BUFFERS_TO_EXTEND_BY);
+
+		/*
+		 * Past 64 pages, don't extend by more than the relation's current
+		 * size.  That limits the bloat in case a bulk load into a small
+		 * relation stops early, while still allowing the extension size to
+		 * double each round until it reaches MAX_BUFFERS_TO_EXTEND_BY.  The
+		 * smgr-cached size makes this check cheap.
+		 */
+		if (extend_by_pages > 64)
+			extend_by_pages = Max(64, Min(extend_by_pages,
+										  RelationGetNumberOfBlocks(relation)));
 	}
 
 	/*
@@ -572,6 +582,22 @@ RelationGetBufferForTuple(Relation relation, Size len,
 	 */
 	if (bistate && bistate->current_buf != InvalidBuffer)
 		targetBlock = BufferGetBlockNumber(bistate->current_buf);
+	else if (otherBuffer != InvalidBuffer && use_fsm &&
+			 RelationUsesClusteredInserts(relation))
+	{
+		/*
+		 * We're placing a new version of an existing row, and the table asks
+		 * for cluster-preserving placement: prefer a page near the old
+		 * version over the page we last inserted on, so that whatever
+		 * physical ordering the table has (e.g. established by CLUSTER)
+		 * decays as slowly as possible.  If there's no free space nearby,
+		 * fall through to the usual placement logic.
+		 */
+		targetBlock = GetPageWithFreeSpaceNear(relation, otherBlock,
+											   targetFreeSpace);
+		if (targetBlock == InvalidBlockNumber)
+			targetBlock = RelationGetTargetBlock(relation);
+	}
 	else
 		targetBlock = RelationGetTargetBlock(relation);
 
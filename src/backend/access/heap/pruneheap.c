@@ -214,15 +214,6 @@ heap_page_prune_opt(Relation relation, Buffer buffer)
 	if (!TransactionIdIsValid(prune_xid))
 		return;
 
-	/*
-	 * Check whether prune_xid indicates that there may be dead rows that can
-	 * be cleaned up.
-	 */
-	vistest = GlobalVisTestFor(relation);
-
-	if (!GlobalVisTestIsRemovableXid(vistest, prune_xid))
-		return;
-
 	/*
 	 * We prune when a previous UPDATE failed to find enough space on the page
 	 * for a new tuple version, or when free space falls below the relation's
@@ -234,6 +225,12 @@ heap_page_prune_opt(Relation relation, Buffer buffer)
 	 * or pd_upper is probably atomic.  Avoiding taking a lock seems more
 	 * important than sometimes getting a wrong answer in what is after all
 	 * just a heuristic estimate.
+	 *
+	 * Apply this heuristic before determining whether prune_xid is
+	 * removable: deciding that can force a recomputation of the visibility
+	 * horizons (see GlobalVisTestIsRemovableXid), which is far too expensive
+	 * to pay on every page a scan touches after an update burst, when pages
+	 * with a prune_xid abound but most still have ample free space.
 	 */
 	minfree = RelationGetTargetPageFreeSpace(relation,
 											 HEAP_DEFAULT_FILLFACTOR);
@@ -241,6 +238,15 @@ heap_page_prune_opt(Relation relation, Buffer buffer)
 
 	if (PageIsFull(page) || PageGetHeapFreeSpace(page) < minfree)
 	{
+		/*
+		 * Check whether prune_xid indicates that there may be dead rows that
+		 * can be cleaned up.
+		 */
+		vistest = GlobalVisTestFor(relation);
+
+		if (!GlobalVisTestIsRemovableXid(vistest, prune_xid))
+			return;
+
 		/* OK, try to get exclusive buffer lock */
 		if (!ConditionalLockBufferForCleanup(buffer))
 			return;
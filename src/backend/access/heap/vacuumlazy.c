@@ -135,6 +135,7 @@
 #include "access/heapam.h"
 #include "access/htup_details.h"
 #include "access/multixact.h"
+#include "access/parallel.h"
 #include "access/tidstore.h"
 #include "access/transam.h"
 #include "access/visibilitymap.h"
@@ -419,6 +420,20 @@ typedef struct LVSavedErrInfo
 	VacErrPhase phase;
 } LVSavedErrInfo;
 
+/*
+ * State for the read stream used by vacuum's third phase.  Each participant
+ * in a parallel vacuum removes dead items from the subset of heap blocks
+ * whose block number is congruent to its participant number modulo the
+ * number of participants; a serial vacuum has a single participant covering
+ * every block.
+ */
+typedef struct LVReapState
+{
+	TidStoreIter *iter;
+	int			participant_id;
+	int			nparticipants;
+} LVReapState;
+
 
 /* non-export function prototypes */
 static void lazy_scan_heap(LVRelState *vacrel);
@@ -441,6 +456,9 @@ static bool lazy_scan_noprune(LVRelState *vacrel, Buffer buf,
 static void lazy_vacuum(LVRelState *vacrel);
 static bool lazy_vacuum_all_indexes(LVRelState *vacrel);
 static void lazy_vacuum_heap_rel(LVRelState *vacrel);
+static BlockNumber lazy_vacuum_heap_stripe(LVRelState *vacrel,
+										   int participant_id,
+										   int nparticipants);
 static void lazy_vacuum_heap_page(LVRelState *vacrel, BlockNumber blkno,
 								  Buffer buffer, OffsetNumber *deadoffsets,
 								  int num_offsets, Buffer vmbuffer);
@@ -1735,9 +1753,28 @@ find_next_unskippable_block(LVRelState *vacrel, bool *skipsallvis)
 		/*
 		 * All-frozen pages cannot contain XIDs < OldestXmin (XIDs that aren't
 		 * already frozen by now), so this page can be skipped.
+		 *
+		 * Large, mostly-static tables tend to contain very long runs of
+		 * all-frozen pages, and probing each block's bits individually makes
+		 * the cost of deciding what to skip proportional to the table size
+		 * even when almost nothing needs scanning.  Skip ahead over such runs
+		 * a whole word of the visibility map at a time, stopping short of the
+		 * last page and of the next eager scan region start so that the
+		 * checks above still get applied at those blocks.
 		 */
 		if ((mapbits & VISIBILITYMAP_ALL_FROZEN) != 0)
+		{
+			BlockNumber bound = Min(rel_pages - 1,
+									vacrel->next_eager_scan_region_start);
+
+			if (next_unskippable_block + 1 < bound)
+				next_unskippable_block =
+					visibilitymap_next_unfrozen(vacrel->rel,
+												next_unskippable_block + 1,
+												bound,
+												&next_unskippable_vmbuffer) - 1;
 			continue;
+		}
 
 		/*
 		 * Aggressive vacuums cannot skip any all-visible pages that are not
@@ -2673,8 +2710,8 @@ lazy_vacuum_all_indexes(LVRelState *vacrel)
 
 /*
  * Read stream callback for vacuum's third phase (second pass over the heap).
- * Gets the next block from the TID store and returns it or InvalidBlockNumber
- * if there are no further blocks to vacuum.
+ * Gets the next block in this participant's stripe from the TID store and
+ * returns it or InvalidBlockNumber if there are no further blocks to vacuum.
  *
  * NB: Assumed to be safe to use with READ_STREAM_USE_BATCHING.
  */
@@ -2683,20 +2720,27 @@ vacuum_reap_lp_read_stream_next(ReadStream *stream,
 								void *callback_private_data,
 								void *per_buffer_data)
 {
-	TidStoreIter *iter = callback_private_data;
+	LVReapState *reap = callback_private_data;
 	TidStoreIterResult *iter_result;
 
-	iter_result = TidStoreIterateNext(iter);
-	if (iter_result == NULL)
-		return InvalidBlockNumber;
+	while ((iter_result = TidStoreIterateNext(reap->iter)) != NULL)
+	{
+		/* Skip blocks belonging to other parallel vacuum participants */
+		if (iter_result->blkno % (BlockNumber) reap->nparticipants !=
+			(BlockNumber) reap->participant_id)
+			continue;
 
-	/*
-	 * Save the TidStoreIterResult for later, so we can extract the offsets.
-	 * It is safe to copy the result, according to TidStoreIterateNext().
-	 */
-	memcpy(per_buffer_data, iter_result, sizeof(*iter_result));
+		/*
+		 * Save the TidStoreIterResult for later, so we can extract the
+		 * offsets.  It is safe to copy the result, according to
+		 * TidStoreIterateNext().
+		 */
+		memcpy(per_buffer_data, iter_result, sizeof(*iter_result));
 
-	return iter_result->blkno;
+		return iter_result->blkno;
+	}
+
+	return InvalidBlockNumber;
 }
 
 /*
@@ -2719,11 +2763,10 @@ vacuum_reap_lp_read_stream_next(ReadStream *stream,
 static void
 lazy_vacuum_heap_rel(LVRelState *vacrel)
 {
-	ReadStream *stream;
-	BlockNumber vacuumed_pages = 0;
-	Buffer		vmbuffer = InvalidBuffer;
+	BlockNumber vacuumed_pages;
 	LVSavedErrInfo saved_err_info;
-	TidStoreIter *iter;
+	int			nparticipants = 1;
+	int			nworkers_launched = 0;
 
 	Assert(vacrel->do_index_vacuuming);
 	Assert(vacrel->do_index_cleanup);
@@ -2738,15 +2781,95 @@ lazy_vacuum_heap_rel(LVRelState *vacrel)
 							 VACUUM_ERRCB_PHASE_VACUUM_HEAP,
 							 InvalidBlockNumber, InvalidOffsetNumber);
 
-	iter = TidStoreBeginIterate(vacrel->dead_items);
+	/*
+	 * A parallel vacuum divides this phase among the worker processes: each
+	 * participant removes dead items from its own stripe of the heap blocks.
+	 * The dead_items store is not modified during this phase, so the
+	 * participants can iterate over it concurrently without locking.
+	 */
+	if (ParallelVacuumIsActive(vacrel))
+		nparticipants = parallel_vacuum_heap_begin(vacrel->pvs,
+												   vacrel->cutoffs.OldestXmin,
+												   &nworkers_launched);
+
+	if (VacuumActiveNWorkers)
+		pg_atomic_add_fetch_u32(VacuumActiveNWorkers, 1);
+
+	/* Process the leader's stripe (all blocks in a serial vacuum) */
+	vacuumed_pages = lazy_vacuum_heap_stripe(vacrel, 0, nparticipants);
+
+	/*
+	 * If fewer workers were launched than planned, also process the absent
+	 * workers' stripes, so that every dead item gets removed.
+	 */
+	for (int id = nworkers_launched + 1; id < nparticipants; id++)
+		vacuumed_pages += lazy_vacuum_heap_stripe(vacrel, id, nparticipants);
+
+	if (VacuumActiveNWorkers)
+		pg_atomic_sub_fetch_u32(VacuumActiveNWorkers, 1);
+
+	if (ParallelVacuumIsActive(vacrel))
+	{
+		BlockNumber worker_vacuumed_pages;
+		BlockNumber worker_vm_new_visible_pages;
+		BlockNumber worker_vm_new_visible_frozen_pages;
+
+		parallel_vacuum_heap_end(vacrel->pvs,
+								 &worker_vacuumed_pages,
+								 &worker_vm_new_visible_pages,
+								 &worker_vm_new_visible_frozen_pages);
+
+		vacuumed_pages += worker_vacuumed_pages;
+		vacrel->vm_new_visible_pages += worker_vm_new_visible_pages;
+		vacrel->vm_new_visible_frozen_pages += worker_vm_new_visible_frozen_pages;
+	}
+
+	vacrel->blkno = InvalidBlockNumber;
+
+	/*
+	 * We set all LP_DEAD items from the first heap pass to LP_UNUSED during
+	 * the second heap pass.  No more, no less.
+	 */
+	Assert(vacrel->num_index_scans > 1 ||
+		   (vacrel->dead_items_info->num_items == vacrel->lpdead_items &&
+			vacuumed_pages == vacrel->lpdead_item_pages));
+
+	ereport(DEBUG2,
+			(errmsg("table \"%s\": removed %" PRId64 " dead item identifiers in %u pages",
+					vacrel->relname, vacrel->dead_items_info->num_items,
+					vacuumed_pages)));
+
+	/* Revert to the previous phase information for error traceback */
+	restore_vacuum_error_info(vacrel, &saved_err_info);
+}
+
+/*
+ *	lazy_vacuum_heap_stripe() -- remove dead items from one participant's
+ *		stripe of the heap blocks
+ *
+ * Processes the blocks in vacrel->dead_items whose block number is congruent
+ * to participant_id modulo nparticipants, and returns the number of heap
+ * pages vacuumed.  A serial vacuum has a single participant that processes
+ * every block.
+ */
+static BlockNumber
+lazy_vacuum_heap_stripe(LVRelState *vacrel, int participant_id,
+						int nparticipants)
+{
+	ReadStream *stream;
+	BlockNumber vacuumed_pages = 0;
+	Buffer		vmbuffer = InvalidBuffer;
+	LVReapState reap;
+
+	reap.iter = TidStoreBeginIterate(vacrel->dead_items);
+	reap.participant_id = participant_id;
+	reap.nparticipants = nparticipants;
 
 	/*
 	 * Set up the read stream for vacuum's second pass through the heap.
 	 *
 	 * It is safe to use batchmode, as vacuum_reap_lp_read_stream_next() does
-	 * not need to wait for IO and does not perform locking. Once we support
-	 * parallelism it should still be fine, as presumably the holder of locks
-	 * would never be blocked by IO while holding the lock.
+	 * not need to wait for IO and does not perform locking.
 	 */
 	stream = read_stream_begin_relation(READ_STREAM_MAINTENANCE |
 										READ_STREAM_USE_BATCHING,
@@ -2754,7 +2877,7 @@ lazy_vacuum_heap_rel(LVRelState *vacrel)
 										vacrel->rel,
 										MAIN_FORKNUM,
 										vacuum_reap_lp_read_stream_next,
-										iter,
+										&reap,
 										sizeof(TidStoreIterResult));
 
 	while (true)
@@ -2771,7 +2894,7 @@ lazy_vacuum_heap_rel(LVRelState *vacrel)
 
 		buf = read_stream_next_buffer(stream, (void **) &iter_result);
 
-		/* The relation is exhausted */
+		/* The stripe is exhausted */
 		if (!BufferIsValid(buf))
 			break;
 
@@ -2803,27 +2926,75 @@ lazy_vacuum_heap_rel(LVRelState *vacrel)
 	}
 
 	read_stream_end(stream);
-	TidStoreEndIterate(iter);
+	TidStoreEndIterate(reap.iter);
 
-	vacrel->blkno = InvalidBlockNumber;
 	if (BufferIsValid(vmbuffer))
 		ReleaseBuffer(vmbuffer);
 
+	return vacuumed_pages;
+}
+
+/*
+ *	heap_parallel_vacuum_heap_rel() -- parallel worker entry point for
+ *		vacuum's third phase
+ *
+ * Called by parallel vacuum workers to remove dead items from the stripe of
+ * heap blocks identified by participant_id and nparticipants.  oldest_xmin is
+ * the leader's visibility cutoff, so that all participants apply the same
+ * horizon when re-checking whether a vacuumed page has become all-visible.
+ * The number of pages vacuumed and of visibility map bits newly set are
+ * returned via the output arguments for the leader to aggregate.
+ */
+void
+heap_parallel_vacuum_heap_rel(Relation rel, TidStore *dead_items,
+							  VacDeadItemsInfo *dead_items_info,
+							  TransactionId oldest_xmin,
+							  BufferAccessStrategy bstrategy,
+							  int participant_id, int nparticipants,
+							  BlockNumber *vacuumed_pages,
+							  BlockNumber *vm_new_visible_pages,
+							  BlockNumber *vm_new_visible_frozen_pages)
+{
+	LVRelState	vacrel = {0};
+	ErrorContextCallback errcallback;
+
+	Assert(IsParallelWorker());
+	Assert(participant_id > 0 && participant_id < nparticipants);
+
 	/*
-	 * We set all LP_DEAD items from the first heap pass to LP_UNUSED during
-	 * the second heap pass.  No more, no less.
+	 * Set up the subset of the leader's LVRelState that the third phase
+	 * relies upon.
 	 */
-	Assert(vacrel->num_index_scans > 1 ||
-		   (vacrel->dead_items_info->num_items == vacrel->lpdead_items &&
-			vacuumed_pages == vacrel->lpdead_item_pages));
+	vacrel.rel = rel;
+	vacrel.dbname = get_database_name(MyDatabaseId);
+	vacrel.relnamespace = get_namespace_name(RelationGetNamespace(rel));
+	vacrel.relname = pstrdup(RelationGetRelationName(rel));
+	vacrel.indname = NULL;
+	vacrel.phase = VACUUM_ERRCB_PHASE_VACUUM_HEAP;
+	vacrel.blkno = InvalidBlockNumber;
+	vacrel.offnum = InvalidOffsetNumber;
+	vacrel.do_index_vacuuming = true;
+	vacrel.do_index_cleanup = true;
+	vacrel.num_index_scans = 1;
+	vacrel.bstrategy = bstrategy;
+	vacrel.dead_items = dead_items;
+	vacrel.dead_items_info = dead_items_info;
+	vacrel.cutoffs.OldestXmin = oldest_xmin;
+
+	/* Setup error traceback support for ereport() */
+	errcallback.callback = vacuum_error_callback;
+	errcallback.arg = &vacrel;
+	errcallback.previous = error_context_stack;
+	error_context_stack = &errcallback;
 
-	ereport(DEBUG2,
-			(errmsg("table \"%s\": removed %" PRId64 " dead item identifiers in %u pages",
-					vacrel->relname, vacrel->dead_items_info->num_items,
-					vacuumed_pages)));
+	*vacuumed_pages = lazy_vacuum_heap_stripe(&vacrel, participant_id,
+											  nparticipants);
 
-	/* Revert to the previous phase information for error traceback */
-	restore_vacuum_error_info(vacrel, &saved_err_info);
+	/* Pop the error context stack */
+	error_context_stack = errcallback.previous;
+
+	*vm_new_visible_pages = vacrel.vm_new_visible_pages;
+	*vm_new_visible_frozen_pages = vacrel.vm_new_visible_frozen_pages;
 }
 
 /*
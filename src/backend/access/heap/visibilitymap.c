@@ -16,6 +16,7 @@
  *		visibilitymap_pin_ok - check whether correct map page is already pinned
  *		visibilitymap_set	 - set a bit in a previously pinned page
  *		visibilitymap_get_status - get status of bits
+ *		visibilitymap_next_unfrozen - find the next block not marked all-frozen
  *		visibilitymap_count  - count number of bits set in visibility map
  *		visibilitymap_prepare_truncate -
  *			prepare for truncation of the visibility map
@@ -122,6 +123,9 @@
 #define VISIBLE_MASK8	(0x55)	/* The lower bit of each bit pair */
 #define FROZEN_MASK8	(0xaa)	/* The upper bit of each bit pair */
 
+/* The all-frozen bits of a whole word's worth of bit pairs */
+#define FROZEN_MASK64	UINT64CONST(0xaaaaaaaaaaaaaaaa)
+
 /* prototypes for internal routines */
 static Buffer vm_readbuf(Relation rel, BlockNumber blkno, bool extend);
 static Buffer vm_extend(Relation rel, BlockNumber vm_nblocks);
@@ -378,6 +382,95 @@ visibilitymap_get_status(Relation rel, BlockNumber heapBlk, Buffer *vmbuf)
 	return result;
 }
 
+/*
+ *	visibilitymap_next_unfrozen - find the next block not marked all-frozen
+ *
+ * Returns the smallest block number in the range [heapBlk, bound) whose
+ * all-frozen bit is not set in the visibility map, or 'bound' if every block
+ * in the range is marked all-frozen.  This is equivalent to calling
+ * visibilitymap_get_status for each block in turn, but long runs of
+ * all-frozen blocks are skipped a whole word of the map at a time, making it
+ * much cheaper on large, mostly-frozen tables.
+ *
+ * On entry, *vmbuf should be InvalidBuffer or a valid buffer returned by an
+ * earlier call to visibilitymap_pin or visibilitymap_get_status on the same
+ * relation.  On return, *vmbuf is a valid buffer with the map page containing
+ * the bit for the returned block, or InvalidBuffer.  The caller is
+ * responsible for releasing *vmbuf after it's done.
+ *
+ * As with visibilitymap_get_status, we don't lock the map pages, so the
+ * result can be immediately stale; it is the caller's responsibility to deal
+ * with all concurrency issues.
+ */
+BlockNumber
+visibilitymap_next_unfrozen(Relation rel, BlockNumber heapBlk,
+							BlockNumber bound, Buffer *vmbuf)
+{
+	while (heapBlk < bound)
+	{
+		BlockNumber mapBlock = HEAPBLK_TO_MAPBLOCK(heapBlk);
+		uint32		mapByte = HEAPBLK_TO_MAPBYTE(heapBlk);
+		uint8		mapOffset = HEAPBLK_TO_OFFSET(heapBlk);
+		char	   *map;
+
+		/* Reuse the old pinned buffer if possible */
+		if (BufferIsValid(*vmbuf) && BufferGetBlockNumber(*vmbuf) != mapBlock)
+		{
+			ReleaseBuffer(*vmbuf);
+			*vmbuf = InvalidBuffer;
+		}
+
+		if (!BufferIsValid(*vmbuf))
+		{
+			*vmbuf = vm_readbuf(rel, mapBlock, false);
+
+			/* blocks beyond the end of the map have no bits set */
+			if (!BufferIsValid(*vmbuf))
+				return heapBlk;
+		}
+
+		map = PageGetContents(BufferGetPage(*vmbuf));
+
+		/*
+		 * Walk block-by-block until we reach a word boundary, then compare a
+		 * whole word's worth of all-frozen bits at a time.  PageGetContents
+		 * guarantees maxaligned data, so the word accesses are aligned.
+		 */
+		while (heapBlk < bound)
+		{
+			if (mapOffset == 0 && mapByte % sizeof(uint64) == 0 &&
+				heapBlk + HEAPBLOCKS_PER_BYTE * sizeof(uint64) <= bound)
+			{
+				uint64		word = ((uint64 *) map)[mapByte / sizeof(uint64)];
+
+				if ((word & FROZEN_MASK64) == FROZEN_MASK64)
+				{
+					heapBlk += HEAPBLOCKS_PER_BYTE * sizeof(uint64);
+					mapByte += sizeof(uint64);
+					if (mapByte >= MAPSIZE)
+						break;	/* on to the next map page */
+					continue;
+				}
+			}
+
+			if (((map[mapByte] >> mapOffset) & VISIBILITYMAP_ALL_FROZEN) == 0)
+				return heapBlk;
+
+			heapBlk++;
+			mapOffset += BITS_PER_HEAPBLOCK;
+			if (mapOffset >= BITS_PER_BYTE)
+			{
+				mapOffset = 0;
+				mapByte++;
+				if (mapByte >= MAPSIZE)
+					break;		/* on to the next map page */
+			}
+		}
+	}
+
+	return bound;
+}
+
 /*
  *	visibilitymap_count  - count number of bits set in visibility map
  *
@@ -361,6 +361,12 @@ btbeginscan(Relation rel, int nkeys, int norderbys)
 	so->orderProcs = NULL;
 	so->arrayContext = NULL;
 
+	/*
+	 * Note that we carry so->lastLeafBlkno across btrescan calls: the whole
+	 * point of the hint is to speed up rescans probing nearby keys.
+	 */
+	so->lastLeafBlkno = InvalidBlockNumber;
+
 	so->killedItems = NULL;		/* until needed */
 	so->numKilled = 0;
 
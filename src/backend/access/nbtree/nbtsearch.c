@@ -20,15 +20,18 @@
 #include "access/xact.h"
 #include "miscadmin.h"
 #include "pgstat.h"
+#include "storage/bufmgr.h"
 #include "storage/predicate.h"
 #include "utils/lsyscache.h"
 #include "utils/rel.h"
 
 
 static inline void _bt_drop_lock_and_maybe_pin(Relation rel, BTScanOpaque so);
+static void _bt_prefetchheappages(IndexScanDesc scan, BTScanPosData *pos);
 static Buffer _bt_moveright(Relation rel, Relation heaprel, BTScanInsert key,
 							Buffer buf, bool forupdate, BTStack stack,
 							int access);
+static bool _bt_leaf_covers_inskey(Relation rel, BTScanInsert key, Buffer buf);
 static OffsetNumber _bt_binsrch(Relation rel, BTScanInsert key, Buffer buf);
 static int	_bt_binsrch_posting(BTScanInsert key, Page page,
 								OffsetNumber offnum);
@@ -325,6 +328,51 @@ _bt_moveright(Relation rel,
 	return buf;
 }
 
+/*
+ *	_bt_leaf_covers_inskey() -- would a fresh descent land on this leaf page?
+ *
+ * Used by _bt_first to revalidate the leaf page reached by the scan's
+ * previous descent before paying for another root-to-leaf descent.  Caller
+ * must have the page read-locked; we only examine its current contents.
+ *
+ * Returns true iff _bt_search would return this very page for key: the page
+ * must be a live leaf page, the key must not belong past the page's high key
+ * (the _bt_moveright condition), and the key must not belong before the
+ * page's first data item.  The latter test proves that no earlier page can
+ * cover the key, since every tuple on earlier pages compares <= the left
+ * sibling's high key, which compares <= our first data item.
+ */
+static bool
+_bt_leaf_covers_inskey(Relation rel, BTScanInsert key, Buffer buf)
+{
+	Page		page = BufferGetPage(buf);
+	BTPageOpaque opaque;
+	int32		cmpval = key->nextkey ? 0 : 1;
+
+	if (PageIsNew(page))
+		return false;
+
+	opaque = BTPageGetOpaque(page);
+	if (!P_ISLEAF(opaque) || P_IGNORE(opaque))
+		return false;
+
+	/* an empty page can't attest to its own key space */
+	if (PageGetMaxOffsetNumber(page) < P_FIRSTDATAKEY(opaque))
+		return false;
+
+	/* does the key belong past this page's high key? */
+	if (!P_RIGHTMOST(opaque) &&
+		_bt_compare(rel, key, page, P_HIKEY) >= cmpval)
+		return false;
+
+	/* could the key belong on an earlier page? */
+	if (!P_LEFTMOST(opaque) &&
+		_bt_compare(rel, key, page, P_FIRSTDATAKEY(opaque)) < cmpval)
+		return false;
+
+	return true;
+}
+
 /*
  *	_bt_binsrch() -- Do a binary search for a key on a particular page.
  *
@@ -1515,10 +1563,40 @@ _bt_first(IndexScanDesc scan, ScanDirection dir)
 	 * position ourselves on the target leaf page.
 	 */
 	Assert(ScanDirectionIsBackward(dir) == inskey.backward);
-	stack = _bt_search(rel, NULL, &inskey, &so->currPos.buf, BT_READ);
 
-	/* don't need to keep the stack around... */
-	_bt_freestack(stack);
+	/*
+	 * Before descending from the root, consider the leaf page that this
+	 * scan's previous descent landed on.  When probe keys arrive in order
+	 * (e.g. the inner side of a nested loop join whose outer side is
+	 * sorted, or successive primitive scans for an array key), consecutive
+	 * descents tend to land on the same leaf page, and revalidating the
+	 * cached page costs a single buffer lock instead of a root-to-leaf
+	 * walk.  The block number is just a hint; _bt_leaf_covers_inskey
+	 * re-checks it against the page's current contents.
+	 */
+	if (!inskey.backward && scan->parallel_scan == NULL &&
+		so->lastLeafBlkno != InvalidBlockNumber)
+	{
+		Buffer		buf = ReadBuffer(rel, so->lastLeafBlkno);
+
+		_bt_lockbuf(rel, buf, BT_READ);
+		if (_bt_leaf_covers_inskey(rel, &inskey, buf))
+			so->currPos.buf = buf;
+		else
+		{
+			/* No good; forget the hint and descend from the root */
+			_bt_relbuf(rel, buf);
+			so->lastLeafBlkno = InvalidBlockNumber;
+		}
+	}
+
+	if (!BufferIsValid(so->currPos.buf))
+	{
+		stack = _bt_search(rel, NULL, &inskey, &so->currPos.buf, BT_READ);
+
+		/* don't need to keep the stack around... */
+		_bt_freestack(stack);
+	}
 
 	if (!BufferIsValid(so->currPos.buf))
 	{
@@ -1547,6 +1625,9 @@ _bt_first(IndexScanDesc scan, ScanDirection dir)
 		}
 	}
 
+	/* remember where we landed, to seed the next descent's fastpath check */
+	so->lastLeafBlkno = BufferGetBlockNumber(so->currPos.buf);
+
 	/* position to the precise item on the page */
 	offnum = _bt_binsrch(rel, &inskey, so->currPos.buf);
 
@@ -2243,6 +2324,61 @@ _bt_steppage(IndexScanDesc scan, ScanDirection dir)
 	return _bt_readnextpage(scan, blkno, lastcurrblkno, dir, false);
 }
 
+/*
+ *	_bt_prefetchheappages() -- Hint at the heap fetches implied by currPos
+ *
+ * After _bt_readpage has filled pos->items, btgettuple will hand the TIDs to
+ * the executor one at a time, each typically triggering a synchronous heap
+ * page read.  Issue prefetch requests for the distinct heap pages of the
+ * first few items (in the scan's direction of travel) so those reads can
+ * overlap.  The number of requests is capped by effective_io_concurrency;
+ * consecutive duplicate block numbers, common for clustered data, are only
+ * requested once.
+ *
+ * Only plain index scans benefit: bitmap scans have no heapRelation here,
+ * and index-only scans mostly avoid the heap altogether.
+ */
+static void
+_bt_prefetchheappages(IndexScanDesc scan, BTScanPosData *pos)
+{
+	BlockNumber lastblkno = InvalidBlockNumber;
+	int			nprefetched = 0;
+
+	if (scan->heapRelation == NULL || scan->xs_want_itup)
+		return;
+	if (effective_io_concurrency <= 0)
+		return;
+
+	if (ScanDirectionIsForward(pos->dir))
+	{
+		for (int i = pos->firstItem; i <= pos->lastItem; i++)
+		{
+			BlockNumber blkno = ItemPointerGetBlockNumber(&pos->items[i].heapTid);
+
+			if (blkno == lastblkno)
+				continue;
+			PrefetchBuffer(scan->heapRelation, MAIN_FORKNUM, blkno);
+			lastblkno = blkno;
+			if (++nprefetched >= effective_io_concurrency)
+				break;
+		}
+	}
+	else
+	{
+		for (int i = pos->lastItem; i >= pos->firstItem; i--)
+		{
+			BlockNumber blkno = ItemPointerGetBlockNumber(&pos->items[i].heapTid);
+
+			if (blkno == lastblkno)
+				continue;
+			PrefetchBuffer(scan->heapRelation, MAIN_FORKNUM, blkno);
+			lastblkno = blkno;
+			if (++nprefetched >= effective_io_concurrency)
+				break;
+		}
+	}
+}
+
 /*
  *	_bt_readfirstpage() -- Read first page containing valid data for _bt_first
  *
@@ -2310,6 +2446,7 @@ _bt_readfirstpage(IndexScanDesc scan, OffsetNumber offnum, ScanDirection dir)
 		 */
 		Assert(BTScanPosIsPinned(so->currPos));
 		_bt_drop_lock_and_maybe_pin(rel, so);
+		_bt_prefetchheappages(scan, &so->currPos);
 		return true;
 	}
 
@@ -2470,6 +2607,7 @@ _bt_readnextpage(IndexScanDesc scan, BlockNumber blkno,
 	Assert(so->currPos.currPage == blkno);
 	Assert(BTScanPosIsPinned(so->currPos));
 	_bt_drop_lock_and_maybe_pin(rel, so);
+	_bt_prefetchheappages(scan, &so->currPos);
 
 	return true;
 }
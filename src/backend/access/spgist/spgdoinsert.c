@@ -502,11 +502,13 @@ moveLeafs(Relation index, SpGistState *state,
 
 	/*
 	 * Now delete the old tuples, leaving a redirection pointer behind for the
-	 * first one, unless we're doing an index build; in which case there can't
-	 * be any concurrent scan so we need not provide a redirect.
+	 * first one, unless we're doing a serial index build; in which case there
+	 * can't be any concurrent activity so we need not provide a redirect.
+	 * (Parallel build workers behave like regular inserters here.)
 	 */
 	spgPageIndexMultiDelete(state, current->page, toDelete, nDelete,
-							state->isBuild ? SPGIST_PLACEHOLDER : SPGIST_REDIRECT,
+							(state->isBuild && !state->isBuildParallel) ?
+							SPGIST_PLACEHOLDER : SPGIST_REDIRECT,
 							SPGIST_PLACEHOLDER,
 							nblkno, r);
 
@@ -1144,10 +1146,10 @@ doPickSplit(Relation index, SpGistState *state,
 	{
 		/*
 		 * Init buffer instead of deleting individual tuples, but only if
-		 * there aren't any other live tuples and only during build; otherwise
-		 * we need to set a redirection tuple for concurrent scans.
+		 * there aren't any other live tuples and only during a serial build;
+		 * otherwise we need to set a redirection tuple for concurrent scans.
 		 */
-		if (state->isBuild &&
+		if (state->isBuild && !state->isBuildParallel &&
 			nToDelete + SpGistPageGetOpaque(current->page)->nPlaceholder ==
 			PageGetMaxOffsetNumber(current->page))
 		{
@@ -1164,7 +1166,7 @@ doPickSplit(Relation index, SpGistState *state,
 		{
 			xlrec.nDelete = nToDelete;
 
-			if (!state->isBuild)
+			if (!state->isBuild || state->isBuildParallel)
 			{
 				/*
 				 * Need to create redirect tuple (it will point to new inner
@@ -1184,8 +1186,8 @@ doPickSplit(Relation index, SpGistState *state,
 			else
 			{
 				/*
-				 * During index build there is not concurrent searches, so we
-				 * don't need to create redirection tuple.
+				 * During a serial index build there are no concurrent
+				 * searches, so we don't need to create redirection tuple.
 				 */
 				spgPageIndexMultiDelete(state, current->page,
 										toDelete, nToDelete,
@@ -1641,12 +1643,12 @@ spgAddNodeAction(Relation index, SpGistState *state,
 
 		/*
 		 * Replace old tuple with a placeholder or redirection tuple.  Unless
-		 * doing an index build, we have to insert a redirection tuple for
-		 * possible concurrent scans.  We can't just delete it in any case,
+		 * doing a serial index build, we have to insert a redirection tuple
+		 * for possible concurrent scans.  We can't just delete it in any case,
 		 * because that could change the offsets of other tuples on the page,
 		 * breaking downlinks from their parents.
 		 */
-		if (state->isBuild)
+		if (state->isBuild && !state->isBuildParallel)
 			dt = spgFormDeadTuple(state, SPGIST_PLACEHOLDER,
 								  InvalidBlockNumber, InvalidOffsetNumber);
 		else
@@ -1660,7 +1662,7 @@ spgAddNodeAction(Relation index, SpGistState *state,
 			elog(ERROR, "failed to add item of size %u to SPGiST index page",
 				 dt->size);
 
-		if (state->isBuild)
+		if (state->isBuild && !state->isBuildParallel)
 			SpGistPageGetOpaque(saveCurrent.page)->nPlaceholder++;
 		else
 			SpGistPageGetOpaque(saveCurrent.page)->nRedirection++;
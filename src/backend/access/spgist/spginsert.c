@@ -17,25 +17,106 @@
 #include "postgres.h"
 
 #include "access/genam.h"
+#include "access/parallel.h"
 #include "access/spgist_private.h"
+#include "access/table.h"
 #include "access/tableam.h"
 #include "access/xloginsert.h"
+#include "catalog/index.h"
+#include "executor/instrument.h"
 #include "miscadmin.h"
 #include "nodes/execnodes.h"
+#include "pgstat.h"
 #include "storage/bufmgr.h"
 #include "storage/bulk_write.h"
+#include "tcop/tcopprot.h"
 #include "utils/memutils.h"
 #include "utils/rel.h"
+#include "utils/snapmgr.h"
 
+/* Magic numbers for parallel state sharing */
+#define PARALLEL_KEY_SPGIST_SHARED		UINT64CONST(0xB200000000000001)
+#define PARALLEL_KEY_QUERY_TEXT			UINT64CONST(0xB200000000000002)
+#define PARALLEL_KEY_WAL_USAGE			UINT64CONST(0xB200000000000003)
+#define PARALLEL_KEY_BUFFER_USAGE		UINT64CONST(0xB200000000000004)
+
+/*
+ * Status for parallel index builds, which is allocated in a dynamic shared
+ * memory segment.
+ *
+ * Unlike the other index AMs' parallel builds, there is no tuplesort and no
+ * merge step: SP-GiST insertions are safe to perform concurrently, so each
+ * participant simply inserts its share of the heap tuples into the (shared)
+ * index, the same way concurrent inserters do in normal operation.
+ */
+typedef struct SpGistShared
+{
+	/*
+	 * These fields are not modified during the build.  They primarily exist
+	 * for the benefit of worker processes that need to create state
+	 * corresponding to that used by the leader.
+	 */
+	Oid			heaprelid;
+	Oid			indexrelid;
+	bool		isconcurrent;
+	uint64		queryid;
+
+	/*
+	 * Mutable state, protected by mutex.  Participants accumulate their
+	 * ambuild statistics here when they are done.
+	 */
+	slock_t		mutex;
+	double		reltuples;
+	int64		indtuples;
+
+	/*
+	 * ParallelTableScanDescData data follows. Can't directly embed here, as
+	 * implementations of the parallel table scan desc interface might need
+	 * stronger alignment.
+	 */
+} SpGistShared;
+
+#define ParallelTableScanFromSpGistShared(shared) \
+	(ParallelTableScanDesc) ((char *) (shared) + BUFFERALIGN(sizeof(SpGistShared)))
+
+/*
+ * Status for leader in parallel index build.
+ */
+typedef struct SpGistLeader
+{
+	/* parallel context itself */
+	ParallelContext *pcxt;
+
+	/*
+	 * Pointers to shared state allocated in the parallel context's toc.
+	 */
+	SpGistShared *spgshared;
+	Snapshot	snapshot;
+	WalUsage   *walusage;
+	BufferUsage *bufferusage;
+} SpGistLeader;
 
 typedef struct
 {
 	SpGistState spgstate;		/* SPGiST's working state */
 	int64		indtuples;		/* total number of tuples indexed */
 	MemoryContext tmpCtx;		/* per-tuple temporary context */
+
+	SpGistLeader *spgleader;	/* parallel build state, if any */
 } SpGistBuildState;
 
 
+static void _spg_begin_parallel(SpGistBuildState *buildstate, Relation heap,
+								Relation index, bool isconcurrent,
+								int request);
+static double _spg_end_parallel(SpGistLeader *spgleader,
+								SpGistBuildState *buildstate);
+static void _spg_parallel_scan_and_insert(SpGistBuildState *buildstate,
+										  SpGistShared *spgshared,
+										  Relation heap, Relation index,
+										  bool progress);
+
+
 /* Callback to process one heap tuple during table_index_build_scan */
 static void
 spgistBuildCallback(Relation index, ItemPointer tid, Datum *values,
@@ -48,10 +129,11 @@ spgistBuildCallback(Relation index, ItemPointer tid, Datum *values,
 	oldCtx = MemoryContextSwitchTo(buildstate->tmpCtx);
 
 	/*
-	 * Even though no concurrent insertions can be happening, we still might
-	 * get a buffer-locking failure due to bgwriter or checkpointer taking a
-	 * lock on some buffer.  So we need to be willing to retry.  We can flush
-	 * any temp data when retrying.
+	 * Even in a serial build, where no concurrent insertions can be
+	 * happening, we might get a buffer-locking failure due to bgwriter or
+	 * checkpointer taking a lock on some buffer.  In a parallel build, lock
+	 * conflicts with other workers are routine.  So we need to be willing to
+	 * retry.  We can flush any temp data when retrying.
 	 */
 	while (!spgdoinsert(index, &buildstate->spgstate, tid,
 						values, isnull))
@@ -116,14 +198,40 @@ spgbuild(Relation heap, Relation index, IndexInfo *indexInfo)
 	initSpGistState(&buildstate.spgstate, index);
 	buildstate.spgstate.isBuild = true;
 	buildstate.indtuples = 0;
+	buildstate.spgleader = NULL;
 
 	buildstate.tmpCtx = AllocSetContextCreate(CurrentMemoryContext,
 											  "SP-GiST build temporary context",
 											  ALLOCSET_DEFAULT_SIZES);
 
-	reltuples = table_index_build_scan(heap, index, indexInfo, true, true,
-									   spgistBuildCallback, &buildstate,
-									   NULL);
+	/*
+	 * Attempt to launch parallel worker scan when required.  If this doesn't
+	 * work out (no DSM segment, or no workers could be launched), we silently
+	 * fall back to a serial build.
+	 */
+	if (indexInfo->ii_ParallelWorkers > 0)
+		_spg_begin_parallel(&buildstate, heap, index, indexInfo->ii_Concurrent,
+							indexInfo->ii_ParallelWorkers);
+
+	if (buildstate.spgleader != NULL)
+	{
+		/*
+		 * We're sharing the tree with the workers, so take the same code
+		 * paths that concurrent inserters do in normal operation.
+		 */
+		buildstate.spgstate.isBuildParallel = true;
+
+		/* participate in the parallel heap scan ourselves */
+		_spg_parallel_scan_and_insert(&buildstate, buildstate.spgleader->spgshared,
+									  heap, index, true);
+
+		/* wait for workers, then collect the totals */
+		reltuples = _spg_end_parallel(buildstate.spgleader, &buildstate);
+	}
+	else
+		reltuples = table_index_build_scan(heap, index, indexInfo, true, true,
+										   spgistBuildCallback, &buildstate,
+										   NULL);
 
 	MemoryContextDelete(buildstate.tmpCtx);
 
@@ -217,3 +325,323 @@ spginsert(Relation index, Datum *values, bool *isnull,
 	/* return false since we've not done any unique check */
 	return false;
 }
+
+/*
+ * Create parallel context, and launch workers for leader.
+ *
+ * buildstate argument should be initialized.
+ *
+ * isconcurrent indicates if operation is CREATE INDEX CONCURRENTLY.
+ *
+ * request is the target number of parallel worker processes to launch.
+ *
+ * Sets buildstate's SpGistLeader, which caller must use to shut down parallel
+ * mode by passing it to _spg_end_parallel() at the very end of its index
+ * build.  If not even a single worker process can be launched, this is
+ * never set, and caller should proceed with a serial index build.
+ */
+static void
+_spg_begin_parallel(SpGistBuildState *buildstate, Relation heap, Relation index,
+					bool isconcurrent, int request)
+{
+	ParallelContext *pcxt;
+	Snapshot	snapshot;
+	Size		estspgshared;
+	SpGistShared *spgshared;
+	SpGistLeader *spgleader = (SpGistLeader *) palloc0(sizeof(SpGistLeader));
+	WalUsage   *walusage;
+	BufferUsage *bufferusage;
+	int			querylen;
+
+	/*
+	 * Enter parallel mode, and create context for parallel build of spgist
+	 * index
+	 */
+	EnterParallelMode();
+	Assert(request > 0);
+	pcxt = CreateParallelContext("postgres", "_spg_parallel_build_main",
+								 request);
+
+	/*
+	 * Prepare for scan of the base relation.  In a normal index build, we use
+	 * SnapshotAny because we must retrieve all tuples and do our own time
+	 * qual checks (because we have to index RECENTLY_DEAD tuples).  In a
+	 * concurrent build, we take a regular MVCC snapshot and index whatever's
+	 * live according to that.
+	 */
+	if (!isconcurrent)
+		snapshot = SnapshotAny;
+	else
+		snapshot = RegisterSnapshot(GetTransactionSnapshot());
+
+	/*
+	 * Estimate size for our own PARALLEL_KEY_SPGIST_SHARED workspace.
+	 */
+	estspgshared = add_size(BUFFERALIGN(sizeof(SpGistShared)),
+							table_parallelscan_estimate(heap, snapshot));
+	shm_toc_estimate_chunk(&pcxt->estimator, estspgshared);
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+
+	/*
+	 * Estimate space for WalUsage and BufferUsage -- PARALLEL_KEY_WAL_USAGE
+	 * and PARALLEL_KEY_BUFFER_USAGE.
+	 *
+	 * If there are no extensions loaded that care, we could skip this.  We
+	 * have no way of knowing whether anyone's looking at pgWalUsage or
+	 * pgBufferUsage, so do it unconditionally.
+	 */
+	shm_toc_estimate_chunk(&pcxt->estimator,
+						   mul_size(sizeof(WalUsage), pcxt->nworkers));
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+	shm_toc_estimate_chunk(&pcxt->estimator,
+						   mul_size(sizeof(BufferUsage), pcxt->nworkers));
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+
+	/* Finally, estimate PARALLEL_KEY_QUERY_TEXT space */
+	if (debug_query_string)
+	{
+		querylen = strlen(debug_query_string);
+		shm_toc_estimate_chunk(&pcxt->estimator, querylen + 1);
+		shm_toc_estimate_keys(&pcxt->estimator, 1);
+	}
+	else
+		querylen = 0;			/* keep compiler quiet */
+
+	/* Everyone's had a chance to ask for space, so now create the DSM */
+	InitializeParallelDSM(pcxt);
+
+	/* If no DSM segment was available, back out (do serial build) */
+	if (pcxt->seg == NULL)
+	{
+		if (IsMVCCSnapshot(snapshot))
+			UnregisterSnapshot(snapshot);
+		DestroyParallelContext(pcxt);
+		ExitParallelMode();
+		return;
+	}
+
+	/* Store shared build state, for which we reserved space */
+	spgshared = (SpGistShared *) shm_toc_allocate(pcxt->toc, estspgshared);
+	/* Initialize immutable state */
+	spgshared->heaprelid = RelationGetRelid(heap);
+	spgshared->indexrelid = RelationGetRelid(index);
+	spgshared->isconcurrent = isconcurrent;
+	spgshared->queryid = pgstat_get_my_query_id();
+	SpinLockInit(&spgshared->mutex);
+
+	/* Initialize mutable state */
+	spgshared->reltuples = 0.0;
+	spgshared->indtuples = 0;
+
+	table_parallelscan_initialize(heap,
+								  ParallelTableScanFromSpGistShared(spgshared),
+								  snapshot);
+
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_SPGIST_SHARED, spgshared);
+
+	/* Store query string for workers */
+	if (debug_query_string)
+	{
+		char	   *sharedquery;
+
+		sharedquery = (char *) shm_toc_allocate(pcxt->toc, querylen + 1);
+		memcpy(sharedquery, debug_query_string, querylen + 1);
+		shm_toc_insert(pcxt->toc, PARALLEL_KEY_QUERY_TEXT, sharedquery);
+	}
+
+	/*
+	 * Allocate space for each worker's WalUsage and BufferUsage; no need to
+	 * initialize.
+	 */
+	walusage = shm_toc_allocate(pcxt->toc,
+								mul_size(sizeof(WalUsage), pcxt->nworkers));
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_WAL_USAGE, walusage);
+	bufferusage = shm_toc_allocate(pcxt->toc,
+								   mul_size(sizeof(BufferUsage), pcxt->nworkers));
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_BUFFER_USAGE, bufferusage);
+
+	/* Launch workers, saving status for leader/caller */
+	LaunchParallelWorkers(pcxt);
+	spgleader->pcxt = pcxt;
+	spgleader->spgshared = spgshared;
+	spgleader->snapshot = snapshot;
+	spgleader->walusage = walusage;
+	spgleader->bufferusage = bufferusage;
+
+	/* If no workers were successfully launched, back out (do serial build) */
+	if (pcxt->nworkers_launched == 0)
+	{
+		_spg_end_parallel(spgleader, NULL);
+		return;
+	}
+
+	/* Save leader state now that it's clear build will be parallel */
+	buildstate->spgleader = spgleader;
+
+	/*
+	 * Caller needs to wait for all launched workers when we return.  Make
+	 * sure that the failure-to-start case will not hang forever.
+	 */
+	WaitForParallelWorkersToAttach(pcxt);
+}
+
+/*
+ * Shut down workers, destroy parallel context, and end parallel mode.
+ *
+ * Returns the total number of heap tuples scanned, and sets buildstate's
+ * indtuples to the total number of index tuples inserted (both including
+ * the leader's own contribution).
+ */
+static double
+_spg_end_parallel(SpGistLeader *spgleader, SpGistBuildState *buildstate)
+{
+	double		reltuples = 0;
+
+	/* Shutdown worker processes */
+	WaitForParallelWorkersToFinish(spgleader->pcxt);
+
+	/*
+	 * Next, accumulate WAL usage.  (This must wait for the workers to finish,
+	 * or we might get incomplete data.)
+	 */
+	for (int i = 0; i < spgleader->pcxt->nworkers_launched; i++)
+		InstrAccumParallelQuery(&spgleader->bufferusage[i], &spgleader->walusage[i]);
+
+	/* Collect the build statistics accumulated by all participants */
+	if (buildstate != NULL)
+	{
+		SpGistShared *spgshared = spgleader->spgshared;
+
+		SpinLockAcquire(&spgshared->mutex);
+		reltuples = spgshared->reltuples;
+		buildstate->indtuples = spgshared->indtuples;
+		SpinLockRelease(&spgshared->mutex);
+	}
+
+	/* Free last reference to MVCC snapshot, if one was used */
+	if (IsMVCCSnapshot(spgleader->snapshot))
+		UnregisterSnapshot(spgleader->snapshot);
+	DestroyParallelContext(spgleader->pcxt);
+	ExitParallelMode();
+
+	return reltuples;
+}
+
+/*
+ * Perform a worker's portion of a parallel insertion scan.
+ *
+ * When this returns, the participant's portion of the heap has been
+ * inserted into the shared index, and its statistics have been added to
+ * the shared totals.
+ */
+static void
+_spg_parallel_scan_and_insert(SpGistBuildState *buildstate,
+							  SpGistShared *spgshared,
+							  Relation heap, Relation index,
+							  bool progress)
+{
+	TableScanDesc scan;
+	double		reltuples;
+	IndexInfo  *indexInfo;
+
+	/* Join parallel scan */
+	indexInfo = BuildIndexInfo(index);
+	indexInfo->ii_Concurrent = spgshared->isconcurrent;
+
+	scan = table_beginscan_parallel(heap,
+									ParallelTableScanFromSpGistShared(spgshared));
+
+	reltuples = table_index_build_scan(heap, index, indexInfo, true, progress,
+									   spgistBuildCallback, buildstate, scan);
+
+	/*
+	 * Done.  Push our lastUsedPages cache back to the metapage, and record
+	 * ambuild statistics.
+	 */
+	SpGistUpdateMetaPage(index);
+
+	SpinLockAcquire(&spgshared->mutex);
+	spgshared->reltuples += reltuples;
+	spgshared->indtuples += buildstate->indtuples;
+	SpinLockRelease(&spgshared->mutex);
+}
+
+/*
+ * Perform work within a launched parallel process.
+ */
+void
+_spg_parallel_build_main(dsm_segment *seg, shm_toc *toc)
+{
+	char	   *sharedquery;
+	SpGistShared *spgshared;
+	SpGistBuildState buildstate;
+	Relation	heapRel;
+	Relation	indexRel;
+	LOCKMODE	heapLockmode;
+	LOCKMODE	indexLockmode;
+	WalUsage   *walusage;
+	BufferUsage *bufferusage;
+
+	/*
+	 * The only possible status flag that can be set to the parallel worker is
+	 * PROC_IN_SAFE_IC.
+	 */
+	Assert((MyProc->statusFlags == 0) ||
+		   (MyProc->statusFlags == PROC_IN_SAFE_IC));
+
+	/* Set debug_query_string for individual workers first */
+	sharedquery = shm_toc_lookup(toc, PARALLEL_KEY_QUERY_TEXT, true);
+	debug_query_string = sharedquery;
+
+	/* Report the query string from leader */
+	pgstat_report_activity(STATE_RUNNING, debug_query_string);
+
+	/* Look up spgist shared state */
+	spgshared = shm_toc_lookup(toc, PARALLEL_KEY_SPGIST_SHARED, false);
+
+	/* Open relations using lock modes known to be obtained by index.c */
+	if (!spgshared->isconcurrent)
+	{
+		heapLockmode = ShareLock;
+		indexLockmode = AccessExclusiveLock;
+	}
+	else
+	{
+		heapLockmode = ShareUpdateExclusiveLock;
+		indexLockmode = RowExclusiveLock;
+	}
+
+	/* Track query ID */
+	pgstat_report_query_id(spgshared->queryid, false);
+
+	/* Open relations within worker */
+	heapRel = table_open(spgshared->heaprelid, heapLockmode);
+	indexRel = index_open(spgshared->indexrelid, indexLockmode);
+
+	initSpGistState(&buildstate.spgstate, indexRel);
+	buildstate.spgstate.isBuild = true;
+	buildstate.spgstate.isBuildParallel = true;
+	buildstate.indtuples = 0;
+	buildstate.spgleader = NULL;
+
+	buildstate.tmpCtx = AllocSetContextCreate(CurrentMemoryContext,
+											  "SP-GiST build temporary context",
+											  ALLOCSET_DEFAULT_SIZES);
+
+	/* Prepare to track buffer usage during parallel execution */
+	InstrStartParallelQuery();
+
+	_spg_parallel_scan_and_insert(&buildstate, spgshared,
+								  heapRel, indexRel, false);
+
+	/* Report WAL/buffer usage during parallel execution */
+	bufferusage = shm_toc_lookup(toc, PARALLEL_KEY_BUFFER_USAGE, false);
+	walusage = shm_toc_lookup(toc, PARALLEL_KEY_WAL_USAGE, false);
+	InstrEndParallelQuery(&bufferusage[ParallelWorkerNumber],
+						  &walusage[ParallelWorkerNumber]);
+
+	MemoryContextDelete(buildstate.tmpCtx);
+
+	index_close(indexRel, indexLockmode);
+	table_close(heapRel, heapLockmode);
+}
@@ -63,7 +63,7 @@ spghandler(PG_FUNCTION_ARGS)
 	amroutine->amclusterable = false;
 	amroutine->ampredlocks = false;
 	amroutine->amcanparallel = false;
-	amroutine->amcanbuildparallel = false;
+	amroutine->amcanbuildparallel = true;
 	amroutine->amcaninclude = true;
 	amroutine->amusemaintenanceworkmem = false;
 	amroutine->amsummarizing = false;
@@ -382,6 +382,7 @@ initSpGistState(SpGistState *state, Relation index)
 
 	/* Assume we're not in an index build (spgbuild will override) */
 	state->isBuild = false;
+	state->isBuildParallel = false;
 }
 
 /*
@@ -43,6 +43,7 @@
 #include "pg_trace.h"
 #include "pgstat.h"
 #include "storage/proc.h"
+#include "storage/shmem.h"
 #include "storage/sync.h"
 #include "utils/guc_hooks.h"
 
@@ -102,6 +103,22 @@ TransactionIdToPage(TransactionId xid)
  */
 #define THRESHOLD_SUBTRANS_CLOG_OPT	5
 
+/*
+ * Per-bank heads of the lists of processes waiting for a group transaction
+ * status update.  Keeping one list per SLRU bank, rather than a single
+ * global list, lets commit groups for pages in different banks form and be
+ * applied concurrently; all pages reachable through one list map to the same
+ * bank lock.  The heads are padded so that concurrently-updated heads don't
+ * share a cache line.
+ */
+typedef union ClogGroupFirstPadded
+{
+	pg_atomic_uint32 procno;	/* head of list, or INVALID_PROC_NUMBER */
+	char		pad[PG_CACHE_LINE_SIZE];
+} ClogGroupFirstPadded;
+
+static ClogGroupFirstPadded *ClogGroupFirst = NULL;
+
 /*
  * Link to shared-memory data structures for CLOG control
  */
@@ -121,7 +138,7 @@ static void TransactionIdSetStatusBit(TransactionId xid, XidStatus status,
 									  XLogRecPtr lsn, int slotno);
 static void set_status_by_pages(int nsubxids, TransactionId *subxids,
 								XidStatus status, XLogRecPtr lsn);
-static bool TransactionGroupUpdateXidStatus(TransactionId xid,
+static void TransactionGroupUpdateXidStatus(TransactionId xid,
 											XidStatus status, XLogRecPtr lsn, int64 pageno);
 static void TransactionIdSetPageStatusInternal(TransactionId xid, int nsubxids,
 											   TransactionId *subxids, XidStatus status,
@@ -325,9 +342,8 @@ TransactionIdSetPageStatus(TransactionId xid, int nsubxids,
 	{
 		/*
 		 * If we can immediately acquire the lock, we update the status of our
-		 * own XID and release the lock.  If not, try use group XID update. If
-		 * that doesn't work out, fall back to waiting for the lock to perform
-		 * an update for this transaction only.
+		 * own XID and release the lock.  If not, use group XID update, which
+		 * will have a leader perform the update on our behalf.
 		 */
 		if (LWLockConditionalAcquire(lock, LW_EXCLUSIVE))
 		{
@@ -335,18 +351,13 @@ TransactionIdSetPageStatus(TransactionId xid, int nsubxids,
 			TransactionIdSetPageStatusInternal(xid, nsubxids, subxids, status,
 											   lsn, pageno);
 			LWLockRelease(lock);
-			return;
 		}
-		else if (TransactionGroupUpdateXidStatus(xid, status, lsn, pageno))
-		{
-			/* Group update mechanism has done the work. */
-			return;
-		}
-
-		/* Fall through only if update isn't done yet. */
+		else
+			TransactionGroupUpdateXidStatus(xid, status, lsn, pageno);
+		return;
 	}
 
-	/* Group update not applicable, or couldn't accept this page number. */
+	/* Group update not applicable; wait for the lock in the normal way. */
 	LWLockAcquire(lock, LW_EXCLUSIVE);
 	TransactionIdSetPageStatusInternal(xid, nsubxids, subxids, status,
 									   lsn, pageno);
@@ -431,20 +442,21 @@ TransactionIdSetPageStatusInternal(TransactionId xid, int nsubxids,
  * processes are trying to commit at once, since the lock need not be
  * repeatedly handed off from one committing process to the next.
  *
- * Returns true when transaction status has been updated in clog; returns
- * false if we decided against applying the optimization because the page
- * number we need to update differs from those processes already waiting.
+ * There is one list per SLRU bank, so groups for pages in different banks
+ * form and proceed independently; within a bank, any mix of pages can join
+ * the same group, since they are all protected by the bank lock the leader
+ * holds while applying the updates.
  */
-static bool
+static void
 TransactionGroupUpdateXidStatus(TransactionId xid, XidStatus status,
 								XLogRecPtr lsn, int64 pageno)
 {
-	volatile PROC_HDR *procglobal = ProcGlobal;
 	PGPROC	   *proc = MyProc;
+	int			bankno = pageno % XactCtl->nbanks;
+	pg_atomic_uint32 *groupfirst = &ClogGroupFirst[bankno].procno;
 	uint32		nextidx;
 	uint32		wakeidx;
-	int64		prevpageno;
-	LWLock	   *prevlock = NULL;
+	LWLock	   *lock;
 
 	/* We should definitely have an XID whose status needs to be updated. */
 	Assert(TransactionIdIsValid(xid));
@@ -460,11 +472,8 @@ TransactionGroupUpdateXidStatus(TransactionId xid, XidStatus status,
 	proc->clogGroupMemberLsn = lsn;
 
 	/*
-	 * We put ourselves in the queue by writing MyProcNumber to
-	 * ProcGlobal->clogGroupFirst.  However, if there's already a process
-	 * listed there, we compare our pageno with that of that process; if it
-	 * differs, we cannot participate in the group, so we return for caller to
-	 * update pg_xact in the normal way.
+	 * We put ourselves in the queue by writing MyProcNumber to the list head
+	 * for the SLRU bank our page belongs to.
 	 *
 	 * If we're not the first process in the list, we must follow the leader.
 	 * We do this by storing the data we want updated in our PGPROC entry
@@ -472,48 +481,21 @@ TransactionGroupUpdateXidStatus(TransactionId xid, XidStatus status,
 	 *
 	 * If no process is already in the list, we're the leader; our first step
 	 * is to lock the SLRU bank to which our page belongs, then we close out
-	 * the group by resetting the list pointer from ProcGlobal->clogGroupFirst
-	 * (this lets other processes set up other groups later); finally we do
-	 * the SLRU updates, release the SLRU bank lock, and wake up the sleeping
-	 * processes.
+	 * the group by resetting the bank's list pointer (this lets other
+	 * processes set up other groups later); finally we do the SLRU updates,
+	 * release the SLRU bank lock, and wake up the sleeping processes.
 	 *
-	 * If another group starts to update a page in a different SLRU bank, they
-	 * can proceed concurrently, since the bank lock they're going to use is
-	 * different from ours.  If another group starts to update a page in the
-	 * same bank as ours, they wait until we release the lock.
+	 * A group updating pages in a different SLRU bank uses a different list
+	 * and a different bank lock, so it can proceed concurrently.  A second
+	 * group forming for our bank waits until we release the lock.
 	 */
-	nextidx = pg_atomic_read_u32(&procglobal->clogGroupFirst);
+	nextidx = pg_atomic_read_u32(groupfirst);
 
 	while (true)
 	{
-		/*
-		 * Add the proc to list, if the clog page where we need to update the
-		 * current transaction status is same as group leader's clog page.
-		 *
-		 * There is a race condition here, which is that after doing the below
-		 * check and before adding this proc's clog update to a group, the
-		 * group leader might have already finished the group update for this
-		 * page and becomes group leader of another group, updating a
-		 * different page.  This will lead to a situation where a single group
-		 * can have different clog page updates.  This isn't likely and will
-		 * still work, just less efficiently -- we handle this case by
-		 * switching to a different bank lock in the loop below.
-		 */
-		if (nextidx != INVALID_PROC_NUMBER &&
-			GetPGProcByNumber(nextidx)->clogGroupMemberPage != proc->clogGroupMemberPage)
-		{
-			/*
-			 * Ensure that this proc is not a member of any clog group that
-			 * needs an XID status update.
-			 */
-			proc->clogGroupMember = false;
-			pg_atomic_write_u32(&proc->clogGroupNext, INVALID_PROC_NUMBER);
-			return false;
-		}
-
 		pg_atomic_write_u32(&proc->clogGroupNext, nextidx);
 
-		if (pg_atomic_compare_exchange_u32(&procglobal->clogGroupFirst,
+		if (pg_atomic_compare_exchange_u32(groupfirst,
 										   &nextidx,
 										   (uint32) MyProcNumber))
 			break;
@@ -546,16 +528,15 @@ TransactionGroupUpdateXidStatus(TransactionId xid, XidStatus status,
 		/* Fix semaphore count for any absorbed wakeups */
 		while (extraWaits-- > 0)
 			PGSemaphoreUnlock(proc->sem);
-		return true;
+		return;
 	}
 
 	/*
 	 * By here, we know we're the leader process.  Acquire the SLRU bank lock
 	 * that corresponds to the page we originally wanted to modify.
 	 */
-	prevpageno = proc->clogGroupMemberPage;
-	prevlock = SimpleLruGetBankLock(XactCtl, prevpageno);
-	LWLockAcquire(prevlock, LW_EXCLUSIVE);
+	lock = SimpleLruGetBankLock(XactCtl, pageno);
+	LWLockAcquire(lock, LW_EXCLUSIVE);
 
 	/*
 	 * Now that we've got the lock, clear the list of processes waiting for
@@ -565,8 +546,7 @@ TransactionGroupUpdateXidStatus(TransactionId xid, XidStatus status,
 	 * At this point, any processes trying to do this would create a separate
 	 * group.
 	 */
-	nextidx = pg_atomic_exchange_u32(&procglobal->clogGroupFirst,
-									 INVALID_PROC_NUMBER);
+	nextidx = pg_atomic_exchange_u32(groupfirst, INVALID_PROC_NUMBER);
 
 	/* Remember head of list so we can perform wakeups after dropping lock. */
 	wakeidx = nextidx;
@@ -575,31 +555,12 @@ TransactionGroupUpdateXidStatus(TransactionId xid, XidStatus status,
 	while (nextidx != INVALID_PROC_NUMBER)
 	{
 		PGPROC	   *nextproc = &ProcGlobal->allProcs[nextidx];
-		int64		thispageno = nextproc->clogGroupMemberPage;
 
 		/*
-		 * If the page to update belongs to a different bank than the previous
-		 * one, exchange bank lock to the new one.  This should be quite rare,
-		 * as described above.
-		 *
-		 * (We could try to optimize this by waking up the processes for which
-		 * we have already updated the status while we exchange the lock, but
-		 * the code doesn't do that at present.  I think it'd require
-		 * additional bookkeeping, making the common path slower in order to
-		 * improve an infrequent case.)
+		 * Everything on this list belongs to the bank whose lock we hold;
+		 * the pages themselves can differ.
 		 */
-		if (thispageno != prevpageno)
-		{
-			LWLock	   *lock = SimpleLruGetBankLock(XactCtl, thispageno);
-
-			if (prevlock != lock)
-			{
-				LWLockRelease(prevlock);
-				LWLockAcquire(lock, LW_EXCLUSIVE);
-			}
-			prevlock = lock;
-			prevpageno = thispageno;
-		}
+		Assert(SimpleLruGetBankLock(XactCtl, nextproc->clogGroupMemberPage) == lock);
 
 		/*
 		 * Transactions with more than THRESHOLD_SUBTRANS_CLOG_OPT sub-XIDs
@@ -619,8 +580,7 @@ TransactionGroupUpdateXidStatus(TransactionId xid, XidStatus status,
 	}
 
 	/* We're done with the lock now. */
-	if (prevlock != NULL)
-		LWLockRelease(prevlock);
+	LWLockRelease(lock);
 
 	/*
 	 * Now that we've released the lock, go back and wake everybody up.  We
@@ -646,8 +606,6 @@ TransactionGroupUpdateXidStatus(TransactionId xid, XidStatus status,
 		if (wakeproc != MyProc)
 			PGSemaphoreUnlock(wakeproc->sem);
 	}
-
-	return true;
 }
 
 /*
@@ -778,12 +736,23 @@ CLOGShmemBuffers(void)
 Size
 CLOGShmemSize(void)
 {
-	return SimpleLruShmemSize(CLOGShmemBuffers(), CLOG_LSNS_PER_PAGE);
+	Size		sz;
+
+	sz = SimpleLruShmemSize(CLOGShmemBuffers(), CLOG_LSNS_PER_PAGE);
+
+	/* group update list heads, one per SLRU bank */
+	sz = add_size(sz, mul_size(CLOGShmemBuffers() / SLRU_BANK_SIZE,
+							   sizeof(ClogGroupFirstPadded)));
+
+	return sz;
 }
 
 void
 CLOGShmemInit(void)
 {
+	int			nbanks;
+	bool		found;
+
 	/* If auto-tuning is requested, now is the time to do it */
 	if (transaction_buffers == 0)
 	{
@@ -810,6 +779,19 @@ CLOGShmemInit(void)
 				  "pg_xact", LWTRANCHE_XACT_BUFFER,
 				  LWTRANCHE_XACT_SLRU, SYNC_HANDLER_CLOG, false);
 	SlruPagePrecedesUnitTests(XactCtl, CLOG_XACTS_PER_PAGE);
+
+	/* Create or attach to the per-bank group update list heads */
+	nbanks = CLOGShmemBuffers() / SLRU_BANK_SIZE;
+	ClogGroupFirst = (ClogGroupFirstPadded *)
+		ShmemInitStruct("CLOG Group Update Lists",
+						mul_size(nbanks, sizeof(ClogGroupFirstPadded)),
+						&found);
+	if (!found)
+	{
+		for (int bankno = 0; bankno < nbanks; bankno++)
+			pg_atomic_init_u32(&ClogGroupFirst[bankno].procno,
+							   INVALID_PROC_NUMBER);
+	}
 }
 
 /*
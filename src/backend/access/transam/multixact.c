@@ -1419,11 +1419,14 @@ retry:
 	pageno = MultiXactIdToOffsetPage(multi);
 	entryno = MultiXactIdToOffsetEntry(multi);
 
-	/* Acquire the bank lock for the page we need. */
+	/*
+	 * Take the read-only path, which holds the bank lock only in shared mode
+	 * when the page is resident.  Offset entries are written under the
+	 * exclusive bank lock before the multixact can appear in any tuple
+	 * header, so a shared lock suffices for reading them.
+	 */
+	slotno = SimpleLruReadPage_ReadOnly(MultiXactOffsetCtl, pageno, multi);
 	lock = SimpleLruGetBankLock(MultiXactOffsetCtl, pageno);
-	LWLockAcquire(lock, LW_EXCLUSIVE);
-
-	slotno = SimpleLruReadPage(MultiXactOffsetCtl, pageno, true, multi);
 	offptr = (MultiXactOffset *) MultiXactOffsetCtl->shared->page_buffer[slotno];
 	offptr += entryno;
 	offset = *offptr;
@@ -1456,21 +1459,15 @@ retry:
 
 		if (pageno != prev_pageno)
 		{
-			LWLock	   *newlock;
-
 			/*
-			 * Since we're going to access a different SLRU page, if this page
-			 * falls under a different bank, release the old bank's lock and
-			 * acquire the lock of the new bank.
+			 * Since we're going to access a different SLRU page, release the
+			 * old bank's lock; SimpleLruReadPage_ReadOnly acquires the new
+			 * bank's lock itself.
 			 */
-			newlock = SimpleLruGetBankLock(MultiXactOffsetCtl, pageno);
-			if (newlock != lock)
-			{
-				LWLockRelease(lock);
-				LWLockAcquire(newlock, LW_EXCLUSIVE);
-				lock = newlock;
-			}
-			slotno = SimpleLruReadPage(MultiXactOffsetCtl, pageno, true, tmpMXact);
+			LWLockRelease(lock);
+			slotno = SimpleLruReadPage_ReadOnly(MultiXactOffsetCtl, pageno,
+												tmpMXact);
+			lock = SimpleLruGetBankLock(MultiXactOffsetCtl, pageno);
 		}
 
 		offptr = (MultiXactOffset *) MultiXactOffsetCtl->shared->page_buffer[slotno];
@@ -1520,23 +1517,18 @@ retry:
 
 		if (pageno != prev_pageno)
 		{
-			LWLock	   *newlock;
-
 			/*
-			 * Since we're going to access a different SLRU page, if this page
-			 * falls under a different bank, release the old bank's lock and
-			 * acquire the lock of the new bank.
+			 * Since we're going to access a different SLRU page, release the
+			 * old bank's lock; SimpleLruReadPage_ReadOnly acquires the new
+			 * bank's lock itself.  Member data is fully written before the
+			 * multixact can be referenced from any tuple header, so a shared
+			 * lock suffices here too.
 			 */
-			newlock = SimpleLruGetBankLock(MultiXactMemberCtl, pageno);
-			if (newlock != lock)
-			{
-				if (lock)
-					LWLockRelease(lock);
-				LWLockAcquire(newlock, LW_EXCLUSIVE);
-				lock = newlock;
-			}
-
-			slotno = SimpleLruReadPage(MultiXactMemberCtl, pageno, true, multi);
+			if (lock)
+				LWLockRelease(lock);
+			slotno = SimpleLruReadPage_ReadOnly(MultiXactMemberCtl, pageno,
+												multi);
+			lock = SimpleLruGetBankLock(MultiXactMemberCtl, pageno);
 			prev_pageno = pageno;
 		}
 
@@ -71,6 +71,31 @@ TransactionIdToPage(TransactionId xid)
  */
 static SlruCtlData SubTransCtlData;
 
+/*
+ * Small direct-mapped cache for results of SubTransGetTopmostTransaction.
+ * Once any backend overflows its PGPROC subxid cache, every snapshot check
+ * on the system has to map subxids back to their top-level transaction, and
+ * scans then look up the same few subxids over and over; a handful of slots
+ * indexed by the XID's low bits resolves nearly all of those without
+ * touching pg_subtrans.  Caching is safe because a subxid's parent link
+ * never changes once set, and a result that "lies" by stopping at
+ * TransactionXmin (see SubTransGetTopmostTransaction) precedes any xmin a
+ * later caller can be interested in, so it stays as good as a fresh answer.
+ * Entries with xid == InvalidTransactionId are unused.
+ */
+#define NUM_CACHED_TOPMOST_XIDS 16
+
+typedef struct CachedTopmostXidEntry
+{
+	TransactionId xid;
+	TransactionId topmost;
+} CachedTopmostXidEntry;
+
+static CachedTopmostXidEntry cachedTopmostXids[NUM_CACHED_TOPMOST_XIDS];
+
+#define CachedTopmostXidSlot(xid) \
+	(&cachedTopmostXids[(xid) % NUM_CACHED_TOPMOST_XIDS])
+
 #define SubTransCtl  (&SubTransCtlData)
 
 
@@ -163,10 +188,15 @@ SubTransGetTopmostTransaction(TransactionId xid)
 {
 	TransactionId parentXid = xid,
 				previousXid = xid;
+	CachedTopmostXidEntry *entry;
 
 	/* Can't ask about stuff that might not be around anymore */
 	Assert(TransactionIdFollowsOrEquals(xid, TransactionXmin));
 
+	entry = CachedTopmostXidSlot(xid);
+	if (entry->xid == xid)
+		return entry->topmost;
+
 	while (TransactionIdIsValid(parentXid))
 	{
 		previousXid = parentXid;
@@ -186,6 +216,9 @@ SubTransGetTopmostTransaction(TransactionId xid)
 
 	Assert(TransactionIdIsValid(previousXid));
 
+	entry->xid = xid;
+	entry->topmost = previousXid;
+
 	return previousXid;
 }
 
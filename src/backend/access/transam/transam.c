@@ -25,14 +25,27 @@
 #include "utils/snapmgr.h"
 
 /*
- * Single-item cache for results of TransactionLogFetch.  It's worth having
- * such a cache because we frequently find ourselves repeatedly checking the
- * same XID, for example when scanning a table just after a bulk insert,
- * update, or delete.
+ * Small direct-mapped cache for results of TransactionLogFetch.  It's worth
+ * having such a cache because we frequently find ourselves repeatedly
+ * checking the same XIDs, for example when scanning a table just after a
+ * bulk insert, update, or delete.  Such scans typically see a handful of
+ * distinct XIDs over and over, so a few slots indexed by the XID's low bits
+ * resolve nearly all lookups without touching the clog at all.  Entries with
+ * xid == InvalidTransactionId are unused.
  */
-static TransactionId cachedFetchXid = InvalidTransactionId;
-static XidStatus cachedFetchXidStatus;
-static XLogRecPtr cachedCommitLSN;
+#define NUM_CACHED_FETCH_XIDS	16
+
+typedef struct CachedFetchXidEntry
+{
+	TransactionId xid;
+	XidStatus	status;
+	XLogRecPtr	commitLSN;
+} CachedFetchXidEntry;
+
+static CachedFetchXidEntry cachedFetchXids[NUM_CACHED_FETCH_XIDS];
+
+#define CachedFetchXidSlot(xid) \
+	(&cachedFetchXids[(xid) % NUM_CACHED_FETCH_XIDS])
 
 /* Local functions */
 static XidStatus TransactionLogFetch(TransactionId transactionId);
@@ -53,13 +66,14 @@ TransactionLogFetch(TransactionId transactionId)
 {
 	XidStatus	xidstatus;
 	XLogRecPtr	xidlsn;
+	CachedFetchXidEntry *cache = CachedFetchXidSlot(transactionId);
 
 	/*
-	 * Before going to the commit log manager, check our single item cache to
-	 * see if we didn't just check the transaction status a moment ago.
+	 * Before going to the commit log manager, check our local cache to see if
+	 * we didn't just check the transaction status a moment ago.
 	 */
-	if (TransactionIdEquals(transactionId, cachedFetchXid))
-		return cachedFetchXidStatus;
+	if (TransactionIdEquals(transactionId, cache->xid))
+		return cache->status;
 
 	/*
 	 * Also, check to see if the transaction ID is a permanent one.
@@ -85,9 +99,9 @@ TransactionLogFetch(TransactionId transactionId)
 	if (xidstatus != TRANSACTION_STATUS_IN_PROGRESS &&
 		xidstatus != TRANSACTION_STATUS_SUB_COMMITTED)
 	{
-		cachedFetchXid = transactionId;
-		cachedFetchXidStatus = xidstatus;
-		cachedCommitLSN = xidlsn;
+		cache->xid = transactionId;
+		cache->status = xidstatus;
+		cache->commitLSN = xidlsn;
 	}
 
 	return xidstatus;
@@ -382,6 +396,7 @@ XLogRecPtr
 TransactionIdGetCommitLSN(TransactionId xid)
 {
 	XLogRecPtr	result;
+	CachedFetchXidEntry *cache = CachedFetchXidSlot(xid);
 
 	/*
 	 * Currently, all uses of this function are for xids that were just
@@ -389,8 +404,8 @@ TransactionIdGetCommitLSN(TransactionId xid)
 	 * checking TransactionLogFetch's cache will usually succeed and avoid an
 	 * extra trip to shared memory.
 	 */
-	if (TransactionIdEquals(xid, cachedFetchXid))
-		return cachedCommitLSN;
+	if (TransactionIdEquals(xid, cache->xid))
+		return cache->commitLSN;
 
 	/* Special XIDs are always known committed */
 	if (!TransactionIdIsNormal(xid))
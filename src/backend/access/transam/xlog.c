@@ -390,7 +390,8 @@ static SessionBackupState sessionBackupState = SESSION_BACKUP_NONE;
  */
 typedef struct XLogCtlInsert
 {
-	slock_t		insertpos_lck;	/* protects CurrBytePos and PrevBytePos */
+	slock_t		insertpos_lck;	/* protects modifications of CurrBytePos and
+								 * PrevBytePos */
 
 	/*
 	 * CurrBytePos is the end of reserved WAL. The next record will be
@@ -398,8 +399,14 @@ typedef struct XLogCtlInsert
 	 * previously inserted (or rather, reserved) record - it is copied to the
 	 * prev-link of the next record. These are stored as "usable byte
 	 * positions" rather than XLogRecPtrs (see XLogBytePosToRecPtr()).
+	 *
+	 * The two positions must be modified together, holding insertpos_lck.
+	 * But CurrBytePos alone can be read without the spinlock; that spares
+	 * frequent readers that don't need a consistent pair, like
+	 * WaitXLogInsertionsToFinish(), from stealing the spinlock cache line
+	 * from concurrent inserters.
 	 */
-	uint64		CurrBytePos;
+	pg_atomic_uint64 CurrBytePos;
 	uint64		PrevBytePos;
 
 	/*
@@ -1140,10 +1147,10 @@ ReserveXLogInsertLocation(int size, XLogRecPtr *StartPos, XLogRecPtr *EndPos,
 	 */
 	SpinLockAcquire(&Insert->insertpos_lck);
 
-	startbytepos = Insert->CurrBytePos;
+	startbytepos = pg_atomic_read_u64(&Insert->CurrBytePos);
 	endbytepos = startbytepos + size;
 	prevbytepos = Insert->PrevBytePos;
-	Insert->CurrBytePos = endbytepos;
+	pg_atomic_write_u64(&Insert->CurrBytePos, endbytepos);
 	Insert->PrevBytePos = startbytepos;
 
 	SpinLockRelease(&Insert->insertpos_lck);
@@ -1184,12 +1191,11 @@ ReserveXLogSwitch(XLogRecPtr *StartPos, XLogRecPtr *EndPos, XLogRecPtr *PrevPtr)
 	/*
 	 * These calculations are a bit heavy-weight to be done while holding a
 	 * spinlock, but since we're holding all the WAL insertion locks, there
-	 * are no other inserters competing for it. GetXLogInsertRecPtr() does
-	 * compete for it, but that's not called very frequently.
+	 * are no other inserters competing for it.
 	 */
 	SpinLockAcquire(&Insert->insertpos_lck);
 
-	startbytepos = Insert->CurrBytePos;
+	startbytepos = pg_atomic_read_u64(&Insert->CurrBytePos);
 
 	ptr = XLogBytePosToEndRecPtr(startbytepos);
 	if (XLogSegmentOffset(ptr, wal_segment_size) == 0)
@@ -1212,7 +1218,7 @@ ReserveXLogSwitch(XLogRecPtr *StartPos, XLogRecPtr *EndPos, XLogRecPtr *PrevPtr)
 		*EndPos += segleft;
 		endbytepos = XLogRecPtrToBytePos(*EndPos);
 	}
-	Insert->CurrBytePos = endbytepos;
+	pg_atomic_write_u64(&Insert->CurrBytePos, endbytepos);
 	Insert->PrevBytePos = startbytepos;
 
 	SpinLockRelease(&Insert->insertpos_lck);
@@ -1532,9 +1538,7 @@ WaitXLogInsertionsToFinish(XLogRecPtr upto)
 		return inserted;
 
 	/* Read the current insert position */
-	SpinLockAcquire(&Insert->insertpos_lck);
-	bytepos = Insert->CurrBytePos;
-	SpinLockRelease(&Insert->insertpos_lck);
+	bytepos = pg_atomic_read_membarrier_u64(&Insert->CurrBytePos);
 	reservedUpto = XLogBytePosToEndRecPtr(bytepos);
 
 	/*
@@ -3789,12 +3793,11 @@ XLogFileClose(void)
 /*
  * Preallocate log files beyond the specified log endpoint.
  *
- * XXX this is currently extremely conservative, since it forces only one
- * future log segment to exist, and even that only if we are 75% done with
- * the current one.  This is only appropriate for very low-WAL-volume systems.
- * High-volume systems will be OK once they've built up a sufficient set of
- * recycled log segments, but the startup transient is likely to include
- * a lot of segment creations by foreground processes, which is not so good.
+ * The number of segments created ahead scales with the estimated checkpoint
+ * distance, up to a small cap, so that high-WAL-volume systems don't leave
+ * segment creation to foreground processes during the startup transient
+ * before a set of recycled segments has been built up.  Once recycling has
+ * caught up, the pre-existing future segments make this a no-op.
  *
  * XLogFileInitInternal() can ereport(ERROR).  All known causes indicate big
  * trouble; for example, a full filesystem is one cause.  The checkpoint WAL
@@ -3821,12 +3824,34 @@ PreallocXlogFiles(XLogRecPtr endptr, TimeLineID tli)
 	offset = XLogSegmentOffset(endptr - 1, wal_segment_size);
 	if (offset >= (uint32) (0.75 * wal_segment_size))
 	{
-		_logSegNo++;
-		lf = XLogFileInitInternal(_logSegNo, tli, &added, path);
-		if (lf >= 0)
-			close(lf);
-		if (added)
-			CheckpointStats.ckpt_segs_added++;
+		int			nsegs;
+
+		/*
+		 * Create as many future segments as the recent WAL volume suggests
+		 * we'll consume before the next checkpoint, within reason.  On a
+		 * low-volume system the distance estimate keeps this at a single
+		 * segment, as before.
+		 */
+		nsegs = (int) (CheckPointDistanceEstimate / wal_segment_size);
+		nsegs = Min(Max(nsegs, 1), 8);
+
+		for (int i = 0; i < nsegs; i++)
+		{
+			_logSegNo++;
+			lf = XLogFileInitInternal(_logSegNo, tli, &added, path);
+			if (lf >= 0)
+				close(lf);
+			if (added)
+				CheckpointStats.ckpt_segs_added++;
+			else
+			{
+				/*
+				 * The segment already existed, so recycling has supplied
+				 * future segments beyond this point; nothing more to do.
+				 */
+				break;
+			}
+		}
 	}
 }
 
@@ -5179,6 +5204,7 @@ XLOGShmemInit(void)
 	XLogCtl->WalWriterSleeping = false;
 
 	SpinLockInit(&XLogCtl->Insert.insertpos_lck);
+	pg_atomic_init_u64(&XLogCtl->Insert.CurrBytePos, 0);
 	SpinLockInit(&XLogCtl->info_lck);
 	pg_atomic_init_u64(&XLogCtl->logInsertResult, InvalidXLogRecPtr);
 	pg_atomic_init_u64(&XLogCtl->logWriteResult, InvalidXLogRecPtr);
@@ -6183,7 +6209,7 @@ StartupXLOG(void)
 	 */
 	Insert = &XLogCtl->Insert;
 	Insert->PrevBytePos = XLogRecPtrToBytePos(endOfRecoveryInfo->lastRec);
-	Insert->CurrBytePos = XLogRecPtrToBytePos(EndOfLog);
+	pg_atomic_write_u64(&Insert->CurrBytePos, XLogRecPtrToBytePos(EndOfLog));
 
 	/*
 	 * Tricky point here: lastPage contains the *last* block that the LastRec
@@ -7172,7 +7198,7 @@ CreateCheckPoint(int flags)
 
 	if (shutdown)
 	{
-		XLogRecPtr	curInsert = XLogBytePosToRecPtr(Insert->CurrBytePos);
+		XLogRecPtr	curInsert = XLogBytePosToRecPtr(pg_atomic_read_u64(&Insert->CurrBytePos));
 
 		/*
 		 * Compute new REDO record ptr = location of next XLOG record.
@@ -9582,9 +9608,7 @@ GetXLogInsertRecPtr(void)
 	XLogCtlInsert *Insert = &XLogCtl->Insert;
 	uint64		current_bytepos;
 
-	SpinLockAcquire(&Insert->insertpos_lck);
-	current_bytepos = Insert->CurrBytePos;
-	SpinLockRelease(&Insert->insertpos_lck);
+	current_bytepos = pg_atomic_read_membarrier_u64(&Insert->CurrBytePos);
 
 	return XLogBytePosToRecPtr(current_bytepos);
 }
@@ -32,6 +32,209 @@
 #include "storage/fd.h"
 #include "storage/ipc.h"
 
+#ifndef WIN32
+
+/*
+ * State of the speculative archive prefetch, if any.  While the recovery
+ * loop replays one segment, a single child process runs restore_command for
+ * the next segment in the background, staging it as RECOVERYPREFETCH in
+ * pg_wal.  With a high-latency archive (object storage, say) this overlaps
+ * fetch latency with replay instead of paying it serially per segment.
+ */
+#define XLOGPREFETCHNAME	"RECOVERYPREFETCH"
+
+static pid_t XLogArchivePrefetchPid = 0;
+static char XLogArchivePrefetchFname[MAXFNAMELEN];
+
+static void XLogArchivePrefetchStart(const char *xlogfname,
+									 const char *lastRestartPointFname);
+static bool XLogArchivePrefetchHarvest(const char *xlogfname,
+									   const char *xlogpath,
+									   off_t expectedSize);
+
+/*
+ * Begin fetching the segment after 'xlogfname' in the background.
+ *
+ * Speculation can go wrong in only one direction: recovery may never ask for
+ * the staged file (end of recovery, timeline switch), in which case it is
+ * discarded at the next harvest.  Fetch failures are expected near the
+ * archive's head and are simply forgotten; the synchronous path remains the
+ * one that reports errors.
+ */
+static void
+XLogArchivePrefetchStart(const char *xlogfname,
+						 const char *lastRestartPointFname)
+{
+	char		nextfname[MAXFNAMELEN];
+	char		prefetchpath[MAXPGPATH];
+	char	   *xlogRestoreCmd;
+	pid_t		pid;
+	TimeLineID	tli;
+	XLogSegNo	segno;
+
+	Assert(XLogArchivePrefetchPid == 0);
+
+	/* Only plain WAL segments have a predictable successor. */
+	if (!IsXLogFileName(xlogfname))
+		return;
+
+	XLogFromFileName(xlogfname, &tli, &segno, wal_segment_size);
+	XLogFileName(nextfname, tli, segno + 1, wal_segment_size);
+
+	snprintf(prefetchpath, MAXPGPATH, XLOGDIR "/%s", XLOGPREFETCHNAME);
+
+	/* Remove any leftover staging file from a previous attempt. */
+	if (unlink(prefetchpath) != 0 && errno != ENOENT)
+		return;
+
+	xlogRestoreCmd = BuildRestoreCommand(recoveryRestoreCommand,
+										 prefetchpath, nextfname,
+										 lastRestartPointFname);
+
+	ereport(DEBUG3,
+			(errmsg_internal("prefetching file \"%s\" with restore command",
+							 nextfname)));
+
+	fflush(NULL);
+	pid = fork();
+	if (pid == 0)
+	{
+		/* child: run the command; status is collected at harvest time */
+		(void) execl("/bin/sh", "sh", "-c", xlogRestoreCmd, (char *) NULL);
+		_exit(127);
+	}
+	if (pid > 0)
+	{
+		XLogArchivePrefetchPid = pid;
+		strlcpy(XLogArchivePrefetchFname, nextfname,
+				sizeof(XLogArchivePrefetchFname));
+	}
+	/* on fork() failure, just don't prefetch */
+	pfree(xlogRestoreCmd);
+}
+
+/*
+ * Collect the result of a previously started prefetch.  If it fetched
+ * exactly the file now being requested, rename it into place as 'xlogpath'
+ * and return true; otherwise clean up and return false, letting the caller
+ * fetch synchronously.
+ */
+static bool
+XLogArchivePrefetchHarvest(const char *xlogfname, const char *xlogpath,
+						   off_t expectedSize)
+{
+	char		prefetchpath[MAXPGPATH];
+	struct stat stat_buf;
+	int			status;
+	pid_t		rc;
+	bool		stale;
+
+	Assert(XLogArchivePrefetchPid != 0);
+
+	snprintf(prefetchpath, MAXPGPATH, XLOGDIR "/%s", XLOGPREFETCHNAME);
+
+	/* If the speculation went to the wrong file, stop the child early. */
+	stale = (strcmp(XLogArchivePrefetchFname, xlogfname) != 0);
+	if (stale)
+		(void) kill(XLogArchivePrefetchPid, SIGTERM);
+
+	/*
+	 * Wait for the child.  As with the system() call below, allow the
+	 * SIGTERM handler to proc_exit() right away if a fast shutdown arrives
+	 * while we wait.
+	 */
+	pgstat_report_wait_start(WAIT_EVENT_RESTORE_COMMAND);
+	PreRestoreCommand();
+
+	do
+	{
+		rc = waitpid(XLogArchivePrefetchPid, &status, 0);
+	} while (rc == -1 && errno == EINTR);
+
+	PostRestoreCommand();
+	pgstat_report_wait_end();
+
+	XLogArchivePrefetchPid = 0;
+
+	if (rc == -1 || status != 0 || stale)
+	{
+		/*
+		 * As in the synchronous case, exit cleanly if the child was killed
+		 * by a SIGTERM that presumably also means a fast shutdown request
+		 * for us -- but not when the SIGTERM was our own doing, above.
+		 */
+		if (!stale && rc != -1 && wait_result_is_signal(status, SIGTERM))
+			proc_exit(1);
+
+		if (rc != -1 && status != 0)
+			ereport(DEBUG2,
+					(errmsg_internal("could not prefetch file \"%s\" from archive: %s",
+									 XLogArchivePrefetchFname,
+									 wait_result_to_str(status))));
+
+		(void) unlink(prefetchpath);
+		return false;
+	}
+
+	/* Got the right file; cross-check its size like the synchronous path. */
+	if (stat(prefetchpath, &stat_buf) != 0 ||
+		(expectedSize > 0 && stat_buf.st_size != expectedSize) ||
+		rename(prefetchpath, xlogpath) != 0)
+	{
+		(void) unlink(prefetchpath);
+		return false;
+	}
+
+	return true;
+}
+
+#endif							/* !WIN32 */
+
+/*
+ * Stop any speculative archive prefetch.
+ *
+ * Called when recovery stops fetching WAL from the archive -- switching to
+ * streaming, or finishing recovery -- since the child is otherwise only
+ * reaped by the next RestoreArchivedFile() call, which may never come: the
+ * exited child would linger as a zombie in the startup process and the
+ * staging file would be left behind in pg_wal.
+ */
+void
+XLogArchivePrefetchCleanup(void)
+{
+#ifndef WIN32
+	char		prefetchpath[MAXPGPATH];
+
+	if (XLogArchivePrefetchPid != 0)
+	{
+		int			status;
+		pid_t		rc;
+
+		(void) kill(XLogArchivePrefetchPid, SIGTERM);
+
+		/*
+		 * As in XLogArchivePrefetchHarvest, let the SIGTERM handler
+		 * proc_exit() right away if a fast shutdown arrives while we wait.
+		 */
+		pgstat_report_wait_start(WAIT_EVENT_RESTORE_COMMAND);
+		PreRestoreCommand();
+
+		do
+		{
+			rc = waitpid(XLogArchivePrefetchPid, &status, 0);
+		} while (rc == -1 && errno == EINTR);
+
+		PostRestoreCommand();
+		pgstat_report_wait_end();
+
+		XLogArchivePrefetchPid = 0;
+	}
+
+	snprintf(prefetchpath, MAXPGPATH, XLOGDIR "/%s", XLOGPREFETCHNAME);
+	(void) unlink(prefetchpath);
+#endif
+}
+
 /*
  * Attempt to retrieve the specified file from off-line archival storage.
  * If successful, fill "path" with its complete path (note that this will be
@@ -149,6 +352,25 @@ RestoreArchivedFile(char *path, const char *xlogfname,
 	else
 		XLogFileName(lastRestartPointFname, 0, 0, wal_segment_size);
 
+#ifndef WIN32
+
+	/*
+	 * If a background prefetch was started for the previous segment, see
+	 * whether it already fetched the file we want; if so, skip running
+	 * restore_command synchronously and start prefetching the next segment.
+	 */
+	if (XLogArchivePrefetchPid != 0 &&
+		XLogArchivePrefetchHarvest(xlogfname, xlogpath, expectedSize))
+	{
+		ereport(LOG,
+				(errmsg("restored log file \"%s\" from archive",
+						xlogfname)));
+		XLogArchivePrefetchStart(xlogfname, lastRestartPointFname);
+		strcpy(path, xlogpath);
+		return true;
+	}
+#endif
+
 	/* Build the restore command to execute */
 	xlogRestoreCmd = BuildRestoreCommand(recoveryRestoreCommand,
 										 xlogpath, xlogfname,
@@ -221,6 +443,10 @@ RestoreArchivedFile(char *path, const char *xlogfname,
 				ereport(LOG,
 						(errmsg("restored log file \"%s\" from archive",
 								xlogfname)));
+#ifndef WIN32
+				/* fetch the next segment while this one is replayed */
+				XLogArchivePrefetchStart(xlogfname, lastRestartPointFname);
+#endif
 				strcpy(path, xlogpath);
 				return true;
 			}
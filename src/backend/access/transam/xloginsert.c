@@ -951,6 +951,19 @@ XLogRecordAssemble(RmgrId rmid, uint8 info,
  * Returns false if compression fails (i.e., compressed result is actually
  * bigger than original). Otherwise, returns true and sets 'dlen' to
  * the length of compressed block image.
+ *
+ * Note that full-page images are the only part of the WAL stream that
+ * wal_compression applies to, and that is not an accident.  Compressing
+ * batches of records (or the stream as a whole) at write/flush boundaries
+ * would break the invariant that an LSN is a physical byte position in the
+ * WAL, which recovery, replication and the various xlogreader-based tools
+ * all rely on for random access.  Compressing individual non-FPI records
+ * would preserve addressing, but those records are typically far too small
+ * to compress usefully on their own; the redundancy observed across
+ * consecutive records can only be exploited once the WAL leaves the server,
+ * e.g. by compressing archived segments or the transport stream.  FPIs are
+ * the exception: they are large, self-contained, and carry their own
+ * compression metadata in the block image header.
  */
 static bool
 XLogCompressBackupBlock(const PageData *page, uint16 hole_offset, uint16 hole_length,
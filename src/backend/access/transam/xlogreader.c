@@ -49,6 +49,8 @@ static void XLogReaderInvalReadState(XLogReaderState *state);
 static XLogPageReadResult XLogDecodeNextRecord(XLogReaderState *state, bool nonblocking);
 static bool ValidXLogRecordHeader(XLogReaderState *state, XLogRecPtr RecPtr,
 								  XLogRecPtr PrevRecPtr, XLogRecord *record, bool randAccess);
+static bool ValidXLogRecordFinish(XLogReaderState *state, pg_crc32c crc,
+								  XLogRecord *record, XLogRecPtr recptr);
 static bool ValidXLogRecord(XLogReaderState *state, XLogRecord *record,
 							XLogRecPtr recptr);
 static void ResetDecoder(XLogReaderState *state);
@@ -702,6 +704,8 @@ restart:
 		XLogPageHeader pageHeader;
 		char	   *buffer;
 		uint32		gotlen;
+		pg_crc32c	crc;
+		uint32		crclen;
 
 		assembled = true;
 
@@ -712,12 +716,28 @@ restart:
 		Assert(state->readRecordBufSize >= XLOG_BLCKSZ * 2);
 		Assert(state->readRecordBufSize >= len);
 
+		/*
+		 * The record's CRC is accumulated over each fragment as it is
+		 * appended, while the data is still cache-hot, instead of in a
+		 * second pass over the reassembled buffer.  'crclen' tracks how many
+		 * bytes past the record header have been summed so far.
+		 */
+		INIT_CRC32C(crc);
+		crclen = 0;
+
 		/* Copy the first fragment of the record from the first page. */
 		memcpy(state->readRecordBuf,
 			   state->readBuf + RecPtr % XLOG_BLCKSZ, len);
 		buffer = state->readRecordBuf + len;
 		gotlen = len;
 
+		if (gotlen > SizeOfXLogRecord)
+		{
+			COMP_CRC32C(crc, state->readRecordBuf + SizeOfXLogRecord,
+						gotlen - SizeOfXLogRecord);
+			crclen = gotlen - SizeOfXLogRecord;
+		}
+
 		do
 		{
 			/* Calculate pointer to beginning of next page */
@@ -798,6 +818,14 @@ restart:
 			buffer += len;
 			gotlen += len;
 
+			/* Fold the new fragment into the CRC, less any header bytes. */
+			if (gotlen > SizeOfXLogRecord && gotlen - SizeOfXLogRecord > crclen)
+			{
+				COMP_CRC32C(crc, state->readRecordBuf + SizeOfXLogRecord + crclen,
+							gotlen - SizeOfXLogRecord - crclen);
+				crclen = gotlen - SizeOfXLogRecord;
+			}
+
 			/* If we just reassembled the record header, validate it. */
 			if (!gotheader)
 			{
@@ -833,7 +861,8 @@ restart:
 		Assert(gotheader);
 
 		record = (XLogRecord *) state->readRecordBuf;
-		if (!ValidXLogRecord(state, record, RecPtr))
+		Assert(crclen == total_len - SizeOfXLogRecord);
+		if (!ValidXLogRecordFinish(state, crc, record, RecPtr))
 			goto err;
 
 		pageHeaderSize = XLogPageHeaderSize((XLogPageHeader) state->readBuf);
@@ -1197,9 +1226,23 @@ ValidXLogRecord(XLogReaderState *state, XLogRecord *record, XLogRecPtr recptr)
 
 	Assert(record->xl_tot_len >= SizeOfXLogRecord);
 
-	/* Calculate the CRC */
+	/* Calculate the CRC of the record data */
 	INIT_CRC32C(crc);
 	COMP_CRC32C(crc, ((char *) record) + SizeOfXLogRecord, record->xl_tot_len - SizeOfXLogRecord);
+
+	return ValidXLogRecordFinish(state, crc, record, recptr);
+}
+
+/*
+ * CRC-check an XLOG record whose data portion has already been summed into
+ * 'crc', e.g. incrementally while the record was reassembled from multiple
+ * pages.  Folds in the record header, which comes last in the CRC, and
+ * compares against the stored value.
+ */
+static bool
+ValidXLogRecordFinish(XLogReaderState *state, pg_crc32c crc,
+					  XLogRecord *record, XLogRecPtr recptr)
+{
 	/* include the record header last */
 	COMP_CRC32C(crc, (char *) record, offsetof(XLogRecord, xl_crc));
 	FIN_CRC32C(crc);
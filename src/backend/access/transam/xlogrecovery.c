@@ -1641,6 +1641,9 @@ ShutdownWalRecovery(void)
 		/* Get rid of any remaining recovered timeline-history file, too */
 		snprintf(recoveryPath, MAXPGPATH, XLOGDIR "/RECOVERYHISTORY");
 		unlink(recoveryPath);	/* ignore any error */
+
+		/* Reap any outstanding archive prefetch and its staging file */
+		XLogArchivePrefetchCleanup();
 	}
 
 	/*
@@ -2040,10 +2043,14 @@ ApplyWalRecord(XLogReaderState *xlogreader, XLogRecord *record, TimeLineID *repl
 	 *    replication is allowed
 	 *  - logical walsenders in case cascade replication is allowed (could not
 	 *    be created otherwise)
+	 *
+	 * Logical walsenders additionally require wal_level >= logical on this
+	 * server; with a lower setting, skip the condition-variable broadcast
+	 * entirely rather than paying for its spinlock on every record.
 	 * ------
 	 */
 	if (AllowCascadeReplication())
-		WalSndWakeup(switchedTLI, true);
+		WalSndWakeup(switchedTLI, wal_level >= WAL_LEVEL_LOGICAL);
 
 	/*
 	 * If rm_redo called XLogRequestWalReceiverReply, then we wake up the
@@ -3652,8 +3659,11 @@ WaitForWALToBecomeAvailable(XLogRecPtr RecPtr, bool randAccess,
 
 					/*
 					 * Move to XLOG_FROM_STREAM state, and set to start a
-					 * walreceiver if necessary.
+					 * walreceiver if necessary.  We're done fetching from the
+					 * archive for now, so stop any prefetch in flight rather
+					 * than leaving its child unreaped.
 					 */
+					XLogArchivePrefetchCleanup();
 					currentSource = XLOG_FROM_STREAM;
 					startWalReceiver = true;
 					break;
@@ -1709,6 +1709,7 @@ sendFile(bbsink *sink, const char *readfilename, const char *tarfilename,
 		else
 		{
 			BlockNumber relative_blkno;
+			unsigned	nblocks = 1;
 
 			/*
 			 * If we've read all the blocks, then it's time to stop.
@@ -1717,13 +1718,23 @@ sendFile(bbsink *sink, const char *readfilename, const char *tarfilename,
 				break;
 
 			/*
-			 * Read just one block, whichever one is the next that we're
-			 * supposed to include.
+			 * Read the next block that we're supposed to include, along with
+			 * any immediately following ones that are also included.  Blocks
+			 * modified since the prior backup tend to come in consecutive
+			 * runs, so this commonly reads large chunks in one call rather
+			 * than one block at a time.
 			 */
-			relative_blkno = incremental_blocks[ibindex++];
+			relative_blkno = incremental_blocks[ibindex];
+			while (ibindex + nblocks < num_incremental_blocks &&
+				   incremental_blocks[ibindex + nblocks] ==
+				   relative_blkno + nblocks &&
+				   (size_t) (nblocks + 1) * BLCKSZ <= sink->bbs_buffer_length)
+				nblocks++;
+			ibindex += nblocks;
+
 			cnt = read_file_data_into_buffer(sink, readfilename, fd,
 											 relative_blkno * BLCKSZ,
-											 BLCKSZ,
+											 nblocks * BLCKSZ,
 											 relative_blkno + segno * RELSEG_SIZE,
 											 verify_checksum,
 											 &checksum_failures);
@@ -1735,12 +1746,12 @@ sendFile(bbsink *sink, const char *readfilename, const char *tarfilename,
 			 * relation files, but we might transiently observe an
 			 * intermediate value.
 			 *
-			 * It should be fine to treat this just as if the entire block had
-			 * been truncated away - i.e. fill this and all later blocks with
-			 * zeroes. WAL replay will fix things up.
+			 * Keep whatever complete blocks we got and treat the rest as if
+			 * they had been truncated away - reads of the remaining blocks
+			 * will find zero bytes, and the missing data is filled with
+			 * zeroes below. WAL replay will fix things up.
 			 */
-			if (cnt < BLCKSZ)
-				break;
+			cnt -= cnt % BLCKSZ;
 		}
 
 		/*
@@ -28,6 +28,7 @@
 #include "access/multixact.h"
 #include "access/relscan.h"
 #include "access/tableam.h"
+#include "access/tidstore.h"
 #include "access/toast_compression.h"
 #include "access/transam.h"
 #include "access/visibilitymap.h"
@@ -79,7 +80,6 @@
 #include "utils/rel.h"
 #include "utils/snapmgr.h"
 #include "utils/syscache.h"
-#include "utils/tuplesort.h"
 
 /* Potentially set by pg_upgrade_support functions */
 Oid			binary_upgrade_next_index_pg_class_oid = InvalidOid;
@@ -3320,8 +3320,8 @@ IndexCheckExclusion(Relation heapRelation,
  * validate_index() works by first gathering all the TIDs currently in the
  * index, using a bulkdelete callback that just stores the TIDs and doesn't
  * ever say "delete it".  (This should be faster than a plain indexscan;
- * also, not all index AMs support full-index indexscan.)  Then we sort the
- * TIDs, and finally scan the table doing a "merge join" against the TID list
+ * also, not all index AMs support full-index indexscan.)  The TIDs are
+ * collected into a TidStore, and then we scan the table probing the store
  * to see which tuples are missing from the index.  Thus we will ensure that
  * all tuples valid according to the reference snapshot are in the index.
  *
@@ -3401,7 +3401,7 @@ validate_index(Oid heapId, Oid indexId, Snapshot snapshot)
 	indexInfo->ii_Concurrent = true;
 
 	/*
-	 * Scan the index and gather up all the TIDs into a tuplesort object.
+	 * Scan the index and gather up all the TIDs into a TidStore.
 	 */
 	ivinfo.index = indexRelation;
 	ivinfo.heaprel = heapRelation;
@@ -3413,39 +3413,23 @@ validate_index(Oid heapId, Oid indexId, Snapshot snapshot)
 	ivinfo.strategy = NULL;
 
 	/*
-	 * Encode TIDs as int8 values for the sort, rather than directly sorting
-	 * item pointers.  This can be significantly faster, primarily because TID
-	 * is a pass-by-reference type on all platforms, whereas int8 is
-	 * pass-by-value on most platforms.
+	 * Collect the TIDs into a TidStore, which supports O(1) membership
+	 * probes, rather than sorting them.  That lets the subsequent table scan
+	 * check each root TID directly, instead of merging against a sorted TID
+	 * stream, and avoids spilling the TIDs to disk.  maintenance_work_mem
+	 * only sizes the store's memory context; the radix tree representation
+	 * is dense enough that even very large indexes fit in little memory.
 	 */
-	state.tuplesort = tuplesort_begin_datum(INT8OID, Int8LessOperator,
-											InvalidOid, false,
-											maintenance_work_mem,
-											NULL, TUPLESORT_NONE);
+	state.tids = TidStoreCreateLocal((size_t) maintenance_work_mem * 1024,
+									 false);
 	state.htups = state.itups = state.tups_inserted = 0;
 
 	/* ambulkdelete updates progress metrics */
 	(void) index_bulk_delete(&ivinfo, NULL,
 							 validate_index_callback, &state);
 
-	/* Execute the sort */
-	{
-		const int	progress_index[] = {
-			PROGRESS_CREATEIDX_PHASE,
-			PROGRESS_SCAN_BLOCKS_DONE,
-			PROGRESS_SCAN_BLOCKS_TOTAL
-		};
-		const int64 progress_vals[] = {
-			PROGRESS_CREATEIDX_PHASE_VALIDATE_SORT,
-			0, 0
-		};
-
-		pgstat_progress_update_multi_param(3, progress_index, progress_vals);
-	}
-	tuplesort_performsort(state.tuplesort);
-
 	/*
-	 * Now scan the heap and "merge" it with the index
+	 * Now scan the heap and check it against the index
 	 */
 	pgstat_progress_update_param(PROGRESS_CREATEIDX_PHASE,
 								 PROGRESS_CREATEIDX_PHASE_VALIDATE_TABLESCAN);
@@ -3455,8 +3439,8 @@ validate_index(Oid heapId, Oid indexId, Snapshot snapshot)
 							  snapshot,
 							  &state);
 
-	/* Done with tuplesort object */
-	tuplesort_end(state.tuplesort);
+	/* Done with the TidStore */
+	TidStoreDestroy(state.tids);
 
 	/* Make sure to release resources cached in indexInfo (if needed). */
 	index_insert_cleanup(indexRelation, indexInfo);
@@ -3483,9 +3467,10 @@ static bool
 validate_index_callback(ItemPointer itemptr, void *opaque)
 {
 	ValidateIndexState *state = (ValidateIndexState *) opaque;
-	int64		encoded = itemptr_encode(itemptr);
 
-	tuplesort_putdatum(state->tuplesort, Int64GetDatum(encoded), false);
+	TidStoreSetOffset(state->tids,
+					  ItemPointerGetBlockNumber(itemptr),
+					  ItemPointerGetOffsetNumber(itemptr));
 	state->itups += 1;
 	return false;				/* never actually delete anything */
 }
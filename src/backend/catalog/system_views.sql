@@ -1157,6 +1157,7 @@ CREATE VIEW pg_stat_archiver AS
 
 CREATE VIEW pg_stat_bgwriter AS
     SELECT
+        pg_stat_get_bgwriter_buf_scanned_clean() AS buffers_scanned,
         pg_stat_get_bgwriter_buf_written_clean() AS buffers_clean,
         pg_stat_get_bgwriter_maxwritten_clean() AS maxwritten_clean,
         pg_stat_get_buf_alloc() AS buffers_alloc,
@@ -1296,11 +1297,10 @@ CREATE VIEW pg_stat_progress_create_index AS
                                     '')
                        WHEN 3 THEN 'waiting for writers before validation'
                        WHEN 4 THEN 'index validation: scanning index'
-                       WHEN 5 THEN 'index validation: sorting tuples'
-                       WHEN 6 THEN 'index validation: scanning table'
-                       WHEN 7 THEN 'waiting for old snapshots'
-                       WHEN 8 THEN 'waiting for readers before marking dead'
-                       WHEN 9 THEN 'waiting for readers before dropping'
+                       WHEN 5 THEN 'index validation: scanning table'
+                       WHEN 6 THEN 'waiting for old snapshots'
+                       WHEN 7 THEN 'waiting for readers before marking dead'
+                       WHEN 8 THEN 'waiting for readers before dropping'
                        END as phase,
         S.param4 AS lockers_total,
         S.param5 AS lockers_done,
@@ -1409,6 +1409,9 @@ CREATE VIEW pg_stat_subscription_stats AS
 CREATE VIEW pg_wait_events AS
     SELECT * FROM pg_get_wait_events();
 
+CREATE VIEW pg_wait_event_histogram AS
+    SELECT * FROM pg_get_wait_event_histogram();
+
 CREATE VIEW pg_aios AS
     SELECT * FROM pg_get_aios();
 REVOKE ALL ON pg_aios FROM PUBLIC;
@@ -1859,6 +1859,7 @@ typedef struct
 {
 	SortSupport ssup;
 	int		   *tupnoLink;
+	Datum	   *abbrevs;		/* abbreviated keys indexed by tupno, or NULL */
 } CompareScalarsContext;
 
 
@@ -2418,6 +2419,7 @@ compute_scalar_stats(VacAttrStatsP stats,
 	ScalarItem *values;
 	int			values_cnt = 0;
 	int		   *tupnoLink;
+	Datum	   *abbrevs = NULL;
 	ScalarMCVItem *track;
 	int			track_cnt = 0;
 	int			num_mcv = stats->attstattarget;
@@ -2434,14 +2436,19 @@ compute_scalar_stats(VacAttrStatsP stats,
 	ssup.ssup_nulls_first = false;
 
 	/*
-	 * For now, don't perform abbreviated key conversion, because full values
-	 * are required for MCV slot generation.  Supporting that optimization
-	 * would necessitate teaching compare_scalars() to call a tie-breaker.
+	 * Request abbreviated-key support to speed up the sort.  The full values
+	 * are kept alongside the abbreviations, which compare_scalars() uses only
+	 * together with an authoritative tie-breaker, so the datums available for
+	 * MCV and histogram slot generation are unaffected.
 	 */
-	ssup.abbreviate = false;
+	ssup.abbreviate = true;
 
 	PrepareSortSupportFromOrderingOp(mystats->ltopr, &ssup);
 
+	/* Set up for abbreviation, if the sort operator supports it */
+	if (ssup.abbrev_converter)
+		abbrevs = (Datum *) palloc(samplerows * sizeof(Datum));
+
 	/* Initial scan to find sortable values */
 	for (i = 0; i < samplerows; i++)
 	{
@@ -2494,6 +2501,26 @@ compute_scalar_stats(VacAttrStatsP stats,
 		values[values_cnt].value = value;
 		values[values_cnt].tupno = values_cnt;
 		tupnoLink[values_cnt] = values_cnt;
+
+		if (abbrevs)
+		{
+			abbrevs[values_cnt] = ssup.abbrev_converter(value, &ssup);
+
+			/*
+			 * If the converter's cost model concludes that abbreviation isn't
+			 * paying off for this column, fall back to sorting the full
+			 * datums.  The abbreviations formed so far are simply ignored.
+			 */
+			if (ssup.abbrev_abort != NULL &&
+				ssup.abbrev_abort(values_cnt + 1, &ssup))
+			{
+				abbrevs = NULL;
+				ssup.comparator = ssup.abbrev_full_comparator;
+				ssup.abbrev_converter = NULL;
+				ssup.abbrev_abort = NULL;
+				ssup.abbrev_full_comparator = NULL;
+			}
+		}
 		values_cnt++;
 	}
 
@@ -2510,6 +2537,7 @@ compute_scalar_stats(VacAttrStatsP stats,
 		/* Sort the collected values */
 		cxt.ssup = &ssup;
 		cxt.tupnoLink = tupnoLink;
+		cxt.abbrevs = abbrevs;
 		qsort_interruptible(values, values_cnt, sizeof(ScalarItem),
 							compare_scalars, &cxt);
 
@@ -2926,6 +2954,10 @@ compute_scalar_stats(VacAttrStatsP stats,
  * is indexed by tupno; for each ScalarItem, it contains the highest
  * tupno that that item's datum has been found to be equal to.  This allows
  * us to avoid additional comparisons in compute_scalar_stats().
+ *
+ * When abbreviated keys are in use, we compare those first, and fall back to
+ * the authoritative comparator when they compare equal.  Equality is thus
+ * always decided by the full datums, which tupnoLink[] depends on.
  */
 static int
 compare_scalars(const void *a, const void *b, void *arg)
@@ -2937,7 +2969,19 @@ compare_scalars(const void *a, const void *b, void *arg)
 	CompareScalarsContext *cxt = (CompareScalarsContext *) arg;
 	int			compare;
 
-	compare = ApplySortComparator(da, false, db, false, cxt->ssup);
+	if (cxt->abbrevs)
+	{
+		compare = ApplySortComparator(cxt->abbrevs[ta], false,
+									  cxt->abbrevs[tb], false,
+									  cxt->ssup);
+		if (compare != 0)
+			return compare;
+
+		compare = ApplySortAbbrevFullComparator(da, false, db, false,
+												cxt->ssup);
+	}
+	else
+		compare = ApplySortComparator(da, false, db, false, cxt->ssup);
 	if (compare != 0)
 		return compare;
 
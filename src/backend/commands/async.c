@@ -72,12 +72,13 @@
  *	  Then we signal any backends that may be interested in our messages
  *	  (including our own backend, if listening).  This is done by
  *	  SignalBackends(), which scans the list of listening backends and sends a
- *	  PROCSIG_NOTIFY_INTERRUPT signal to every listening backend (we don't
- *	  know which backend is listening on which channel so we must signal them
- *	  all).  We can exclude backends that are already up to date, though, and
- *	  we can also exclude backends that are in other databases (unless they
- *	  are way behind and should be kicked to make them advance their
- *	  pointers).
+ *	  PROCSIG_NOTIFY_INTERRUPT signal to every listening backend whose
+ *	  shared channel filter overlaps the channels we notified (each listener
+ *	  publishes a hashed summary of its channels, so we need not wake
+ *	  listeners that cannot be interested).  We can exclude backends that are
+ *	  already up to date, though, and we can also exclude backends that are
+ *	  in other databases or filtered out (unless they are way behind and
+ *	  should be kicked to make them advance their pointers).
  *
  *	  Finally, after we are out of the transaction altogether and about to go
  *	  idle, we scan the queue for messages that need to be sent to our
@@ -239,6 +240,14 @@ typedef struct QueuePosition
 
 /*
  * Struct describing a listening backend's status
+ *
+ * channelFilter is a Bloom-style summary of the channels the backend is
+ * listening on: for each channel, the bit selected by hashing the channel
+ * name is set.  Notifying backends use it to skip signaling listeners that
+ * cannot possibly be interested in any of the channels being notified.
+ * The filter may have extra bits set (making a listener merely wake up and
+ * find nothing to deliver), but must never lack a bit for a channel the
+ * backend could be listening on.
  */
 typedef struct QueueBackendStatus
 {
@@ -246,6 +255,7 @@ typedef struct QueueBackendStatus
 	Oid			dboid;			/* backend's database OID, or InvalidOid */
 	ProcNumber	nextListener;	/* id of next listener, or INVALID_PROC_NUMBER */
 	QueuePosition pos;			/* backend has read queue up to here */
+	uint64		channelFilter;	/* summary of channels listened on */
 } QueueBackendStatus;
 
 /*
@@ -301,6 +311,7 @@ static AsyncQueueControl *asyncQueueControl;
 #define QUEUE_BACKEND_DBOID(i)		(asyncQueueControl->backend[i].dboid)
 #define QUEUE_NEXT_LISTENER(i)		(asyncQueueControl->backend[i].nextListener)
 #define QUEUE_BACKEND_POS(i)		(asyncQueueControl->backend[i].pos)
+#define QUEUE_BACKEND_FILTER(i)		(asyncQueueControl->backend[i].channelFilter)
 
 /*
  * The SLRU buffer area through which we access the notification queue
@@ -437,6 +448,8 @@ static void Exec_ListenCommit(const char *channel);
 static void Exec_UnlistenCommit(const char *channel);
 static void Exec_UnlistenAllCommit(void);
 static bool IsListeningOn(const char *channel);
+static uint64 asyncChannelFilterBit(const char *channel);
+static void asyncQueueUpdateMyFilter(void);
 static void asyncQueueUnregister(void);
 static bool asyncQueueIsFull(void);
 static bool asyncQueueAdvance(volatile QueuePosition *position, int entryLength);
@@ -525,6 +538,7 @@ AsyncShmemInit(void)
 		{
 			QUEUE_BACKEND_PID(i) = InvalidPid;
 			QUEUE_BACKEND_DBOID(i) = InvalidOid;
+			QUEUE_BACKEND_FILTER(i) = 0;
 			QUEUE_NEXT_LISTENER(i) = INVALID_PROC_NUMBER;
 			SET_QUEUE_POS(QUEUE_BACKEND_POS(i), 0, 0);
 		}
@@ -879,6 +893,17 @@ PreCommit_Notify(void)
 			{
 				case LISTEN_LISTEN:
 					Exec_ListenPreCommit();
+
+					/*
+					 * Add the channel to our shared filter before commit, so
+					 * that any notification committing after us will
+					 * consider signaling us.  (If we abort after all, the
+					 * extra bit is removed by the next filter recompute.)
+					 */
+					LWLockAcquire(NotifyQueueLock, LW_SHARED);
+					QUEUE_BACKEND_FILTER(MyProcNumber) |=
+						asyncChannelFilterBit(actrec->channel);
+					LWLockRelease(NotifyQueueLock);
 					break;
 				case LISTEN_UNLISTEN:
 					/* there is no Exec_UnlistenPreCommit() */
@@ -968,6 +993,7 @@ void
 AtCommit_Notify(void)
 {
 	ListCell   *p;
+	bool		didUnlisten = false;
 
 	/*
 	 * Allow transactions that have not executed LISTEN/UNLISTEN/NOTIFY to
@@ -993,9 +1019,11 @@ AtCommit_Notify(void)
 					break;
 				case LISTEN_UNLISTEN:
 					Exec_UnlistenCommit(actrec->channel);
+					didUnlisten = true;
 					break;
 				case LISTEN_UNLISTEN_ALL:
 					Exec_UnlistenAllCommit();
+					didUnlisten = true;
 					break;
 			}
 		}
@@ -1004,6 +1032,11 @@ AtCommit_Notify(void)
 	/* If no longer listening to anything, get out of listener array */
 	if (amRegisteredListener && listenChannels == NIL)
 		asyncQueueUnregister();
+	else if (amRegisteredListener && didUnlisten)
+	{
+		/* Our channel set shrank, so recompute the shared filter */
+		asyncQueueUpdateMyFilter();
+	}
 
 	/*
 	 * Send signals to listening backends.  We need do this only if there are
@@ -1099,6 +1132,7 @@ Exec_ListenPreCommit(void)
 	QUEUE_BACKEND_POS(MyProcNumber) = max;
 	QUEUE_BACKEND_PID(MyProcNumber) = MyProcPid;
 	QUEUE_BACKEND_DBOID(MyProcNumber) = MyDatabaseId;
+	QUEUE_BACKEND_FILTER(MyProcNumber) = 0;
 	/* Insert backend into list of listeners at correct position */
 	if (prevListener != INVALID_PROC_NUMBER)
 	{
@@ -1223,6 +1257,43 @@ IsListeningOn(const char *channel)
 	return false;
 }
 
+/*
+ * Compute the channel's bit in a listen channel filter.
+ */
+static uint64
+asyncChannelFilterBit(const char *channel)
+{
+	uint32		h = hash_bytes((const unsigned char *) channel,
+							   strlen(channel));
+
+	return UINT64CONST(1) << (h % 64);
+}
+
+/*
+ * Recompute our shared channel filter from listenChannels.
+ *
+ * This is the only way filter bits ever get cleared: UNLISTEN recomputes
+ * the filter from scratch after updating listenChannels.  (A LISTEN that
+ * was aborted after PreCommit_Notify can leave a stale bit behind until
+ * then; that only causes spurious wakeups.)
+ */
+static void
+asyncQueueUpdateMyFilter(void)
+{
+	uint64		filter = 0;
+	ListCell   *p;
+
+	Assert(amRegisteredListener);
+
+	foreach(p, listenChannels)
+		filter |= asyncChannelFilterBit((const char *) lfirst(p));
+
+	/* Updating our own entry requires only shared lock */
+	LWLockAcquire(NotifyQueueLock, LW_SHARED);
+	QUEUE_BACKEND_FILTER(MyProcNumber) = filter;
+	LWLockRelease(NotifyQueueLock);
+}
+
 /*
  * Remove our entry from the listeners array when we are no longer listening
  * on any channel.  NB: must not fail if we're already not listening.
@@ -1242,6 +1313,7 @@ asyncQueueUnregister(void)
 	/* Mark our entry as invalid */
 	QUEUE_BACKEND_PID(MyProcNumber) = InvalidPid;
 	QUEUE_BACKEND_DBOID(MyProcNumber) = InvalidOid;
+	QUEUE_BACKEND_FILTER(MyProcNumber) = 0;
 	/* and remove it from the list */
 	if (QUEUE_FIRST_LISTENER == MyProcNumber)
 		QUEUE_FIRST_LISTENER = QUEUE_NEXT_LISTENER(MyProcNumber);
@@ -1565,12 +1637,14 @@ asyncQueueFillWarning(void)
 /*
  * Send signals to listening backends.
  *
- * Normally we signal only backends in our own database, since only those
- * backends could be interested in notifies we send.  However, if there's
- * notify traffic in our database but no traffic in another database that
- * does have listener(s), those listeners will fall further and further
- * behind.  Waken them anyway if they're far enough behind, so that they'll
- * advance their queue position pointers, allowing the global tail to advance.
+ * Normally we signal only backends in our own database whose channel filter
+ * overlaps the channels we notified, since only those backends could be
+ * interested in notifies we send.  However, if there's notify traffic in our
+ * database but no traffic of interest to some other listener (in another
+ * database, or listening only on other channels), that listener will fall
+ * further and further behind.  Waken them anyway if they're far enough
+ * behind, so that they'll advance their queue position pointers, allowing
+ * the global tail to advance.
  *
  * Since we know the ProcNumber and the Pid the signaling is quite cheap.
  *
@@ -1583,6 +1657,16 @@ SignalBackends(void)
 	int32	   *pids;
 	ProcNumber *procnos;
 	int			count;
+	uint64		notifyFilter = 0;
+	ListCell   *l;
+
+	/* Compute the union of the filter bits of the notified channels. */
+	foreach(l, pendingNotifies->events)
+	{
+		Notification *n = (Notification *) lfirst(l);
+
+		notifyFilter |= asyncChannelFilterBit(n->data);
+	}
 
 	/*
 	 * Identify backends that we need to signal.  We don't want to send
@@ -1604,11 +1688,13 @@ SignalBackends(void)
 
 		Assert(pid != InvalidPid);
 		pos = QUEUE_BACKEND_POS(i);
-		if (QUEUE_BACKEND_DBOID(i) == MyDatabaseId)
+		if (QUEUE_BACKEND_DBOID(i) == MyDatabaseId &&
+			(QUEUE_BACKEND_FILTER(i) & notifyFilter) != 0)
 		{
 			/*
-			 * Always signal listeners in our own database, unless they're
-			 * already caught up (unlikely, but possible).
+			 * Always signal possibly-interested listeners in our own
+			 * database, unless they're already caught up (unlikely, but
+			 * possible).
 			 */
 			if (QUEUE_POS_EQUAL(pos, QUEUE_HEAD))
 				continue;
@@ -1616,8 +1702,9 @@ SignalBackends(void)
 		else
 		{
 			/*
-			 * Listeners in other databases should be signaled only if they
-			 * are far behind.
+			 * Listeners in other databases, and listeners whose channel
+			 * filter shows no overlap with the notified channels, should be
+			 * signaled only if they are far behind.
 			 */
 			if (asyncQueuePageDiff(QUEUE_POS_PAGE(QUEUE_HEAD),
 								   QUEUE_POS_PAGE(pos)) < QUEUE_CLEANUP_DELAY)
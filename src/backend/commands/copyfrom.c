@@ -82,6 +82,7 @@ typedef struct CopyMultiInsertBuffer
 	BulkInsertState bistate;	/* BulkInsertState for this rel if plain
 								 * table; NULL if foreign table */
 	int			nused;			/* number of 'slots' containing tuples */
+	int			bufferedBytes;	/* number of bytes from those tuples */
 	uint64		linenos[MAX_BUFFERED_TUPLES];	/* Line # of tuple in copy
 												 * stream */
 } CopyMultiInsertBuffer;
@@ -369,6 +370,7 @@ CopyMultiInsertBufferInit(ResultRelInfo *rri)
 	buffer->resultRelInfo = rri;
 	buffer->bistate = (rri->ri_FdwRoutine == NULL) ? GetBulkInsertState() : NULL;
 	buffer->nused = 0;
+	buffer->bufferedBytes = 0;
 
 	return buffer;
 }
@@ -609,6 +611,7 @@ CopyMultiInsertBufferFlush(CopyMultiInsertInfo *miinfo,
 
 	/* Mark that all slots are free */
 	buffer->nused = 0;
+	buffer->bufferedBytes = 0;
 }
 
 /*
@@ -649,7 +652,15 @@ CopyMultiInsertBufferCleanup(CopyMultiInsertInfo *miinfo,
 }
 
 /*
- * Write out all stored tuples in all buffers out to the tables.
+ * Write out stored tuples to the tables.
+ *
+ * With 'flush_all' set, every buffer is written out; callers must use that
+ * when all pending rows need to become visible, and when the COPY is done.
+ * Otherwise, only the largest buffers are written out, until we're below
+ * half of each buffering limit.  That way, when rows are spread over many
+ * partitions, the partitions receiving only an occasional row keep
+ * accumulating rows into reasonably-sized batches instead of being written
+ * out a handful of tuples at a time whenever the shared limit is hit.
  *
  * Once flushed we also trim the tracked buffers list down to size by removing
  * the buffers created earliest first.
@@ -660,19 +671,53 @@ CopyMultiInsertBufferCleanup(CopyMultiInsertInfo *miinfo,
  */
 static inline void
 CopyMultiInsertInfoFlush(CopyMultiInsertInfo *miinfo, ResultRelInfo *curr_rri,
-						 int64 *processed)
+						 bool flush_all, int64 *processed)
 {
 	ListCell   *lc;
 
-	foreach(lc, miinfo->multiInsertBuffers)
+	if (flush_all || list_length(miinfo->multiInsertBuffers) == 1)
 	{
-		CopyMultiInsertBuffer *buffer = (CopyMultiInsertBuffer *) lfirst(lc);
+		foreach(lc, miinfo->multiInsertBuffers)
+		{
+			CopyMultiInsertBuffer *buffer = (CopyMultiInsertBuffer *) lfirst(lc);
+
+			CopyMultiInsertBufferFlush(miinfo, buffer, processed);
+		}
 
-		CopyMultiInsertBufferFlush(miinfo, buffer, processed);
+		miinfo->bufferedTuples = 0;
+		miinfo->bufferedBytes = 0;
 	}
+	else
+	{
+		while (miinfo->bufferedTuples > MAX_BUFFERED_TUPLES / 2 ||
+			   miinfo->bufferedBytes > MAX_BUFFERED_BYTES / 2)
+		{
+			CopyMultiInsertBuffer *biggest = NULL;
 
-	miinfo->bufferedTuples = 0;
-	miinfo->bufferedBytes = 0;
+			foreach(lc, miinfo->multiInsertBuffers)
+			{
+				CopyMultiInsertBuffer *buffer = (CopyMultiInsertBuffer *) lfirst(lc);
+
+				if (buffer->nused == 0)
+					continue;
+				if (biggest == NULL ||
+					buffer->bufferedBytes > biggest->bufferedBytes ||
+					(buffer->bufferedBytes == biggest->bufferedBytes &&
+					 buffer->nused > biggest->nused))
+					biggest = buffer;
+			}
+
+			/* should not happen, but don't loop forever if it does */
+			if (biggest == NULL)
+				break;
+
+			/* adjust the totals before the flush resets the buffer */
+			miinfo->bufferedTuples -= biggest->nused;
+			miinfo->bufferedBytes -= biggest->bufferedBytes;
+
+			CopyMultiInsertBufferFlush(miinfo, biggest, processed);
+		}
+	}
 
 	/*
 	 * Trim the list of tracked buffers down if it exceeds the limit.  Here we
@@ -704,6 +749,14 @@ CopyMultiInsertInfoFlush(CopyMultiInsertInfo *miinfo, ResultRelInfo *curr_rri,
 			buffer = (CopyMultiInsertBuffer *) linitial(miinfo->multiInsertBuffers);
 		}
 
+		/* a partial flush above may have left this buffer unflushed */
+		if (buffer->nused > 0)
+		{
+			miinfo->bufferedTuples -= buffer->nused;
+			miinfo->bufferedBytes -= buffer->bufferedBytes;
+			CopyMultiInsertBufferFlush(miinfo, buffer, processed);
+		}
+
 		CopyMultiInsertBufferCleanup(miinfo, buffer);
 		miinfo->multiInsertBuffers = list_delete_first(miinfo->multiInsertBuffers);
 	}
@@ -768,6 +821,7 @@ CopyMultiInsertInfoStore(CopyMultiInsertInfo *miinfo, ResultRelInfo *rri,
 	buffer->nused++;
 
 	/* Update how many tuples are stored and their size */
+	buffer->bufferedBytes += tuplen;
 	miinfo->bufferedTuples++;
 	miinfo->bufferedBytes += tuplen;
 }
@@ -1251,6 +1305,7 @@ CopyFrom(CopyFromState cstate)
 					 */
 					CopyMultiInsertInfoFlush(&multiInsertInfo,
 											 resultRelInfo,
+											 true,
 											 &processed);
 				}
 
@@ -1383,12 +1438,13 @@ CopyFrom(CopyFromState cstate)
 											 cstate->cur_lineno);
 
 					/*
-					 * If enough inserts have queued up, then flush all
-					 * buffers out to their tables.
+					 * If enough inserts have queued up, then write the
+					 * fullest buffers out to their tables.
 					 */
 					if (CopyMultiInsertInfoIsFull(&multiInsertInfo))
 						CopyMultiInsertInfoFlush(&multiInsertInfo,
 												 resultRelInfo,
+												 false,
 												 &processed);
 
 					/*
@@ -1461,7 +1517,7 @@ CopyFrom(CopyFromState cstate)
 	if (insertMethod != CIM_SINGLE)
 	{
 		if (!CopyMultiInsertInfoIsEmpty(&multiInsertInfo))
-			CopyMultiInsertInfoFlush(&multiInsertInfo, NULL, &processed);
+			CopyMultiInsertInfoFlush(&multiInsertInfo, NULL, true, &processed);
 	}
 
 	/* Done, clean up */
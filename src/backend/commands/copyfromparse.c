@@ -72,6 +72,7 @@
 #include "miscadmin.h"
 #include "pgstat.h"
 #include "port/pg_bswap.h"
+#include "port/simd.h"
 #include "utils/builtins.h"
 #include "utils/rel.h"
 
@@ -1236,6 +1237,58 @@ CopyReadLine(CopyFromState cstate, bool is_csv)
 	return result;
 }
 
+/*
+ * CopyFindSpecialByte - scan ahead for parser-relevant characters
+ *
+ * Returns the offset of the first byte in 's' (of length 'len') that
+ * matches any of the four given special characters, or 'len' if there is
+ * none.  The caller supplies the characters that its parsing state machine
+ * reacts to; duplicates are fine if fewer than four are needed.
+ *
+ * The bulk of most COPY input is ordinary data bytes, so this lets the
+ * parsing loops step over whole runs of them in SIMD-register-sized chunks
+ * instead of re-testing every byte against every special character.  All
+ * supported server encodings have the property that bytes of a multibyte
+ * character have the high bit set, so bytewise scanning for ASCII special
+ * characters is safe regardless of encoding.
+ */
+static inline int
+CopyFindSpecialByte(const char *s, int len, char c1, char c2, char c3, char c4)
+{
+	int			i = 0;
+
+#ifndef USE_NO_SIMD
+	const Vector8 v1 = vector8_broadcast((uint8) c1);
+	const Vector8 v2 = vector8_broadcast((uint8) c2);
+	const Vector8 v3 = vector8_broadcast((uint8) c3);
+	const Vector8 v4 = vector8_broadcast((uint8) c4);
+
+	for (; i + (int) sizeof(Vector8) <= len; i += sizeof(Vector8))
+	{
+		Vector8		chunk;
+		Vector8		hits;
+
+		vector8_load(&chunk, (const uint8 *) (s + i));
+		hits = vector8_or(vector8_or(vector8_eq(chunk, v1),
+									 vector8_eq(chunk, v2)),
+						  vector8_or(vector8_eq(chunk, v3),
+									 vector8_eq(chunk, v4)));
+		if (vector8_is_highbit_set(hits))
+			break;
+	}
+#endif
+
+	for (; i < len; i++)
+	{
+		char		c = s[i];
+
+		if (c == c1 || c == c2 || c == c3 || c == c4)
+			break;
+	}
+
+	return i;
+}
+
 /*
  * CopyReadLineText - inner loop of CopyReadLine for text mode
  */
@@ -1328,6 +1381,34 @@ CopyReadLineText(CopyFromState cstate, bool is_csv)
 			need_data = false;
 		}
 
+		/*
+		 * Fast-forward over any run of characters the state machine doesn't
+		 * react to.  In text mode only backslash and newlines are
+		 * interesting; in CSV mode also the quote and escape characters.
+		 * (When the escape character is disabled it is '\0', which never
+		 * matches data anyway; pass the quote character again instead.)
+		 */
+		if (!is_csv)
+			input_buf_ptr += CopyFindSpecialByte(copy_input_buf + input_buf_ptr,
+												 copy_buf_len - input_buf_ptr,
+												 '\\', '\r', '\n', '\n');
+		else
+		{
+			int			skip;
+
+			skip = CopyFindSpecialByte(copy_input_buf + input_buf_ptr,
+									   copy_buf_len - input_buf_ptr,
+									   quotec,
+									   escapec != '\0' ? escapec : quotec,
+									   '\r', '\n');
+			/* ordinary characters end any escape-escape sequence */
+			if (skip > 0)
+				last_was_esc = false;
+			input_buf_ptr += skip;
+		}
+		if (input_buf_ptr >= copy_buf_len)
+			continue;
+
 		/* OK to fetch a character */
 		prev_raw_ptr = input_buf_ptr;
 		c = copy_input_buf[input_buf_ptr++];
@@ -1645,6 +1726,22 @@ CopyReadAttributesText(CopyFromState cstate)
 		{
 			char		c;
 
+			/*
+			 * Copy any run of ordinary characters to the output wholesale;
+			 * only the delimiter and backslash need per-byte treatment.
+			 */
+			if (cur_ptr < line_end_ptr)
+			{
+				int			run = CopyFindSpecialByte(cur_ptr,
+													  line_end_ptr - cur_ptr,
+													  delimc, '\\',
+													  delimc, delimc);
+
+				memcpy(output_ptr, cur_ptr, run);
+				output_ptr += run;
+				cur_ptr += run;
+			}
+
 			end_ptr = cur_ptr;
 			if (cur_ptr >= line_end_ptr)
 				break;
@@ -1900,6 +1997,19 @@ CopyReadAttributesCSV(CopyFromState cstate)
 			/* Not in quote */
 			for (;;)
 			{
+				/* copy any run of ordinary characters wholesale */
+				if (cur_ptr < line_end_ptr)
+				{
+					int			run = CopyFindSpecialByte(cur_ptr,
+														  line_end_ptr - cur_ptr,
+														  delimc, quotec,
+														  delimc, delimc);
+
+					memcpy(output_ptr, cur_ptr, run);
+					output_ptr += run;
+					cur_ptr += run;
+				}
+
 				end_ptr = cur_ptr;
 				if (cur_ptr >= line_end_ptr)
 					goto endfield;
@@ -1923,6 +2033,19 @@ CopyReadAttributesCSV(CopyFromState cstate)
 			/* In quote */
 			for (;;)
 			{
+				/* copy any run of ordinary characters wholesale */
+				if (cur_ptr < line_end_ptr)
+				{
+					int			run = CopyFindSpecialByte(cur_ptr,
+														  line_end_ptr - cur_ptr,
+														  quotec, escapec,
+														  quotec, quotec);
+
+					memcpy(output_ptr, cur_ptr, run);
+					output_ptr += run;
+					cur_ptr += run;
+				}
+
 				end_ptr = cur_ptr;
 				if (cur_ptr >= line_end_ptr)
 					ereport(ERROR,
@@ -31,6 +31,7 @@
 #include "pgstat.h"
 #include "storage/fd.h"
 #include "tcop/tcopprot.h"
+#include "utils/fmgroids.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/rel.h"
@@ -93,6 +94,7 @@ typedef struct CopyToStateData
 	MemoryContext copycontext;	/* per-copy execution context */
 
 	FmgrInfo   *out_functions;	/* lookup info for output functions */
+	int		   *binary_raw_widths;	/* per-attr raw send width, or 0 */
 	MemoryContext rowcontext;	/* per-row evaluation context */
 	uint64		bytes_processed;	/* number of bytes processed so far */
 } CopyToStateData;
@@ -140,6 +142,7 @@ static void CopySendEndOfRow(CopyToState cstate);
 static void CopySendTextLikeEndOfRow(CopyToState cstate);
 static void CopySendInt32(CopyToState cstate, int32 val);
 static void CopySendInt16(CopyToState cstate, int16 val);
+static void CopySendInt64(CopyToState cstate, int64 val);
 
 /*
  * COPY TO routines for built-in formats.
@@ -323,6 +326,48 @@ CopyToBinaryStart(CopyToState cstate, TupleDesc tupDesc)
 	/* No header extension */
 	tmp = 0;
 	CopySendInt32(cstate, tmp);
+
+	/*
+	 * Identify attributes whose send function emits nothing but the raw
+	 * pass-by-value datum in network byte order.  For those, CopyToBinaryOneRow
+	 * can serialize the value directly into fe_msgbuf, skipping the
+	 * per-datum palloc and memcpy of a bytea round trip through
+	 * SendFunctionCall().  The send function OID, not the type's layout, is
+	 * what guarantees the wire format, so only functions on this list
+	 * qualify; attbyval filters out platforms where the type is byref.
+	 */
+	cstate->binary_raw_widths = (int *)
+		MemoryContextAllocZero(cstate->copycontext,
+							   tupDesc->natts * sizeof(int));
+	foreach_int(attnum, cstate->attnumlist)
+	{
+		Form_pg_attribute attr = TupleDescAttr(tupDesc, attnum - 1);
+		int			width = 0;
+
+		if (attr->attbyval)
+		{
+			switch (cstate->out_functions[attnum - 1].fn_oid)
+			{
+				case F_INT2SEND:
+					width = 2;
+					break;
+				case F_INT4SEND:
+				case F_OIDSEND:
+				case F_FLOAT4SEND:
+				case F_DATE_SEND:
+					width = 4;
+					break;
+				case F_INT8SEND:
+				case F_FLOAT8SEND:
+				case F_TIMESTAMP_SEND:
+				case F_TIMESTAMPTZ_SEND:
+				case F_TIME_SEND:
+					width = 8;
+					break;
+			}
+		}
+		cstate->binary_raw_widths[attnum - 1] = width;
+	}
 }
 
 /*
@@ -360,13 +405,40 @@ CopyToBinaryOneRow(CopyToState cstate, TupleTableSlot *slot)
 		}
 		else
 		{
-			bytea	   *outputbytes;
+			int			width = cstate->binary_raw_widths[attnum - 1];
 
-			outputbytes = SendFunctionCall(&out_functions[attnum - 1],
-										   value);
-			CopySendInt32(cstate, VARSIZE(outputbytes) - VARHDRSZ);
-			CopySendData(cstate, VARDATA(outputbytes),
-						 VARSIZE(outputbytes) - VARHDRSZ);
+			if (width > 0)
+			{
+				/*
+				 * The send function would emit just the raw value in
+				 * network byte order; do that directly.  The Datum holds
+				 * the value's bit pattern, so this also covers float4/8.
+				 */
+				CopySendInt32(cstate, width);
+				switch (width)
+				{
+					case 2:
+						CopySendInt16(cstate, DatumGetInt16(value));
+						break;
+					case 4:
+						CopySendInt32(cstate, DatumGetInt32(value));
+						break;
+					default:
+						Assert(width == 8);
+						CopySendInt64(cstate, DatumGetInt64(value));
+						break;
+				}
+			}
+			else
+			{
+				bytea	   *outputbytes;
+
+				outputbytes = SendFunctionCall(&out_functions[attnum - 1],
+											   value);
+				CopySendInt32(cstate, VARSIZE(outputbytes) - VARHDRSZ);
+				CopySendData(cstate, VARDATA(outputbytes),
+							 VARSIZE(outputbytes) - VARHDRSZ);
+			}
 		}
 	}
 
@@ -555,6 +627,18 @@ CopySendInt16(CopyToState cstate, int16 val)
 	CopySendData(cstate, &buf, sizeof(buf));
 }
 
+/*
+ * CopySendInt64 sends an int64 in network byte order
+ */
+static inline void
+CopySendInt64(CopyToState cstate, int64 val)
+{
+	uint64		buf;
+
+	buf = pg_hton64((uint64) val);
+	CopySendData(cstate, &buf, sizeof(buf));
+}
+
 /*
  * Closes the pipe to an external program, checking the pclose() return code.
  */
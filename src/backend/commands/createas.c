@@ -48,6 +48,13 @@
 #include "utils/rls.h"
 #include "utils/snapmgr.h"
 
+/*
+ * Limits on the number and total size of tuples buffered before flushing
+ * through table_multi_insert(), mirroring COPY FROM's buffering.
+ */
+#define CTAS_MAX_BUFFERED_TUPLES	1000
+#define CTAS_MAX_BUFFERED_BYTES		65535
+
 typedef struct
 {
 	DestReceiver pub;			/* publicly-known function pointers */
@@ -58,6 +65,10 @@ typedef struct
 	CommandId	output_cid;		/* cmin to insert in output tuples */
 	int			ti_options;		/* table_tuple_insert performance options */
 	BulkInsertState bistate;	/* bulk insert state */
+	MemoryContext mi_context;	/* query-lifespan context for the batch */
+	TupleTableSlot **mi_slots;	/* buffered tuples for table_multi_insert */
+	int			mi_nslots;		/* number of buffered tuples */
+	Size		mi_nbytes;		/* approximate size of buffered tuples */
 } DR_intorel;
 
 /* utility functions for CTAS definition creation */
@@ -565,7 +576,14 @@ intorel_startup(DestReceiver *self, int operation, TupleDesc typeinfo)
 	 * bulk inserts as there are no tuples to insert.
 	 */
 	if (!into->skipData)
+	{
 		myState->bistate = GetBulkInsertState();
+		myState->mi_context = CurrentMemoryContext;
+		myState->mi_slots = (TupleTableSlot **)
+			palloc0(CTAS_MAX_BUFFERED_TUPLES * sizeof(TupleTableSlot *));
+		myState->mi_nslots = 0;
+		myState->mi_nbytes = 0;
+	}
 	else
 		myState->bistate = NULL;
 
@@ -576,6 +594,26 @@ intorel_startup(DestReceiver *self, int operation, TupleDesc typeinfo)
 	Assert(RelationGetTargetBlock(intoRelationDesc) == InvalidBlockNumber);
 }
 
+/*
+ * intorel_flush --- flush buffered tuples through table_multi_insert
+ */
+static void
+intorel_flush(DR_intorel *myState)
+{
+	table_multi_insert(myState->rel,
+					   myState->mi_slots,
+					   myState->mi_nslots,
+					   myState->output_cid,
+					   myState->ti_options,
+					   myState->bistate);
+
+	for (int i = 0; i < myState->mi_nslots; i++)
+		ExecClearTuple(myState->mi_slots[i]);
+
+	myState->mi_nslots = 0;
+	myState->mi_nbytes = 0;
+}
+
 /*
  * intorel_receive --- receive one tuple
  */
@@ -587,22 +625,47 @@ intorel_receive(TupleTableSlot *slot, DestReceiver *self)
 	/* Nothing to insert if WITH NO DATA is specified. */
 	if (!myState->into->skipData)
 	{
+		TupleTableSlot *batchslot;
+		HeapTuple	tuple;
+		bool		shouldFree;
+
 		/*
-		 * Note that the input slot might not be of the type of the target
-		 * relation. That's supported by table_tuple_insert(), but slightly
-		 * less efficient than inserting with the right slot - but the
-		 * alternative would be to copy into a slot of the right type, which
-		 * would not be cheap either. This also doesn't allow accessing per-AM
-		 * data (say a tuple's xmin), but since we don't do that here...
+		 * Copy the tuple into a slot of the target relation's type and
+		 * buffer it, flushing a whole batch through table_multi_insert()
+		 * once enough has accumulated.  That lets the AM batch the WAL and
+		 * buffer-lock work for many tuples - heap logs entire pages' worth
+		 * of tuples in a single record - which per-tuple
+		 * table_tuple_insert() calls can't do.  We know this is a newly
+		 * created relation, so there are no indexes or triggers that would
+		 * require per-tuple processing.
 		 */
-		table_tuple_insert(myState->rel,
-						   slot,
-						   myState->output_cid,
-						   myState->ti_options,
-						   myState->bistate);
-	}
+		if (myState->mi_slots[myState->mi_nslots] == NULL)
+		{
+			MemoryContext oldcontext;
 
-	/* We know this is a newly created relation, so there are no indexes */
+			oldcontext = MemoryContextSwitchTo(myState->mi_context);
+			myState->mi_slots[myState->mi_nslots] =
+				table_slot_create(myState->rel, NULL);
+			MemoryContextSwitchTo(oldcontext);
+		}
+		batchslot = myState->mi_slots[myState->mi_nslots];
+
+		ExecCopySlot(batchslot, slot);
+
+		/*
+		 * Account for the tuple's size, so that batches of few very wide
+		 * rows don't accumulate unboundedly.  For heap this fetches the
+		 * tuple the copy above already materialized, so it's cheap.
+		 */
+		tuple = ExecFetchSlotHeapTuple(batchslot, false, &shouldFree);
+		myState->mi_nbytes += tuple->t_len;
+		if (shouldFree)
+			heap_freetuple(tuple);
+
+		if (++myState->mi_nslots >= CTAS_MAX_BUFFERED_TUPLES ||
+			myState->mi_nbytes >= CTAS_MAX_BUFFERED_BYTES)
+			intorel_flush(myState);
+	}
 
 	return true;
 }
@@ -618,6 +681,15 @@ intorel_shutdown(DestReceiver *self)
 
 	if (!into->skipData)
 	{
+		if (myState->mi_nslots > 0)
+			intorel_flush(myState);
+		for (int i = 0; i < CTAS_MAX_BUFFERED_TUPLES; i++)
+		{
+			if (myState->mi_slots[i] == NULL)
+				break;
+			ExecDropSingleTupleTableSlot(myState->mi_slots[i]);
+		}
+		pfree(myState->mi_slots);
 		FreeBulkInsertState(myState->bistate);
 		table_finish_bulk_insert(myState->rel, myState->ti_options);
 	}
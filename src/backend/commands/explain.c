@@ -1881,6 +1881,25 @@ ExplainNode(PlanState *planstate, List *ancestors,
 	if (es->format != EXPLAIN_FORMAT_TEXT || isdisabled)
 		ExplainPropertyBool("Disabled", isdisabled, es);
 
+	/*
+	 * Show sample counts collected by the sampling profiler, if it was
+	 * active for this query (see InstrProfileStart).  In text format, omit
+	 * nodes that no sample hit.
+	 */
+	if (planstate->state->es_plan_profiling)
+	{
+		uint64		samples = InstrProfileGetSamples(plan->plan_node_id);
+
+		if (es->format != EXPLAIN_FORMAT_TEXT)
+			ExplainPropertyUInteger("Profile Samples", NULL, samples, es);
+		else if (samples > 0)
+		{
+			ExplainIndentText(es);
+			appendStringInfo(es->str, "Profile Samples: " UINT64_FORMAT "\n",
+							 samples);
+		}
+	}
+
 	/* prepare per-worker general execution details */
 	if (es->workers_state && es->verbose)
 	{
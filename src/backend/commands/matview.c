@@ -42,6 +42,13 @@
 #include "utils/syscache.h"
 
 
+/*
+ * Limits on the number and total size of tuples buffered before flushing
+ * through table_multi_insert(), mirroring COPY FROM's buffering.
+ */
+#define MATVIEW_MAX_BUFFERED_TUPLES		1000
+#define MATVIEW_MAX_BUFFERED_BYTES		65535
+
 typedef struct
 {
 	DestReceiver pub;			/* publicly-known function pointers */
@@ -51,6 +58,10 @@ typedef struct
 	CommandId	output_cid;		/* cmin to insert in output tuples */
 	int			ti_options;		/* table_tuple_insert performance options */
 	BulkInsertState bistate;	/* bulk insert state */
+	MemoryContext mi_context;	/* query-lifespan context for the batch */
+	TupleTableSlot **mi_slots;	/* buffered tuples for table_multi_insert */
+	int			mi_nslots;		/* number of buffered tuples */
+	Size		mi_nbytes;		/* approximate size of buffered tuples */
 } DR_transientrel;
 
 static int	matview_maintenance_depth = 0;
@@ -494,6 +505,11 @@ transientrel_startup(DestReceiver *self, int operation, TupleDesc typeinfo)
 	myState->output_cid = GetCurrentCommandId(true);
 	myState->ti_options = TABLE_INSERT_SKIP_FSM | TABLE_INSERT_FROZEN;
 	myState->bistate = GetBulkInsertState();
+	myState->mi_context = CurrentMemoryContext;
+	myState->mi_slots = (TupleTableSlot **)
+		palloc0(MATVIEW_MAX_BUFFERED_TUPLES * sizeof(TupleTableSlot *));
+	myState->mi_nslots = 0;
+	myState->mi_nbytes = 0;
 
 	/*
 	 * Valid smgr_targblock implies something already wrote to the relation.
@@ -502,6 +518,26 @@ transientrel_startup(DestReceiver *self, int operation, TupleDesc typeinfo)
 	Assert(RelationGetTargetBlock(transientrel) == InvalidBlockNumber);
 }
 
+/*
+ * transientrel_flush --- flush buffered tuples through table_multi_insert
+ */
+static void
+transientrel_flush(DR_transientrel *myState)
+{
+	table_multi_insert(myState->transientrel,
+					   myState->mi_slots,
+					   myState->mi_nslots,
+					   myState->output_cid,
+					   myState->ti_options,
+					   myState->bistate);
+
+	for (int i = 0; i < myState->mi_nslots; i++)
+		ExecClearTuple(myState->mi_slots[i]);
+
+	myState->mi_nslots = 0;
+	myState->mi_nbytes = 0;
+}
+
 /*
  * transientrel_receive --- receive one tuple
  */
@@ -509,23 +545,45 @@ static bool
 transientrel_receive(TupleTableSlot *slot, DestReceiver *self)
 {
 	DR_transientrel *myState = (DR_transientrel *) self;
+	TupleTableSlot *batchslot;
+	HeapTuple	tuple;
+	bool		shouldFree;
 
 	/*
-	 * Note that the input slot might not be of the type of the target
-	 * relation. That's supported by table_tuple_insert(), but slightly less
-	 * efficient than inserting with the right slot - but the alternative
-	 * would be to copy into a slot of the right type, which would not be
-	 * cheap either. This also doesn't allow accessing per-AM data (say a
-	 * tuple's xmin), but since we don't do that here...
+	 * Copy the tuple into a slot of the target relation's type and buffer
+	 * it, flushing a whole batch through table_multi_insert() once enough
+	 * has accumulated.  That lets the AM batch the WAL and buffer-lock work
+	 * for many tuples - heap logs entire pages' worth of tuples in a single
+	 * record - which per-tuple table_tuple_insert() calls can't do.  We know
+	 * this is a newly created relation, so there are no indexes or triggers
+	 * that would require per-tuple processing.
 	 */
+	if (myState->mi_slots[myState->mi_nslots] == NULL)
+	{
+		MemoryContext oldcontext;
 
-	table_tuple_insert(myState->transientrel,
-					   slot,
-					   myState->output_cid,
-					   myState->ti_options,
-					   myState->bistate);
+		oldcontext = MemoryContextSwitchTo(myState->mi_context);
+		myState->mi_slots[myState->mi_nslots] =
+			table_slot_create(myState->transientrel, NULL);
+		MemoryContextSwitchTo(oldcontext);
+	}
+	batchslot = myState->mi_slots[myState->mi_nslots];
+
+	ExecCopySlot(batchslot, slot);
 
-	/* We know this is a newly created relation, so there are no indexes */
+	/*
+	 * Account for the tuple's size, so that batches of few very wide rows
+	 * don't accumulate unboundedly.  For heap this fetches the tuple the
+	 * copy above already materialized, so it's cheap.
+	 */
+	tuple = ExecFetchSlotHeapTuple(batchslot, false, &shouldFree);
+	myState->mi_nbytes += tuple->t_len;
+	if (shouldFree)
+		heap_freetuple(tuple);
+
+	if (++myState->mi_nslots >= MATVIEW_MAX_BUFFERED_TUPLES ||
+		myState->mi_nbytes >= MATVIEW_MAX_BUFFERED_BYTES)
+		transientrel_flush(myState);
 
 	return true;
 }
@@ -538,6 +596,16 @@ transientrel_shutdown(DestReceiver *self)
 {
 	DR_transientrel *myState = (DR_transientrel *) self;
 
+	if (myState->mi_nslots > 0)
+		transientrel_flush(myState);
+	for (int i = 0; i < MATVIEW_MAX_BUFFERED_TUPLES; i++)
+	{
+		if (myState->mi_slots[i] == NULL)
+			break;
+		ExecDropSingleTupleTableSlot(myState->mi_slots[i]);
+	}
+	pfree(myState->mi_slots);
+
 	FreeBulkInsertState(myState->bistate);
 
 	table_finish_bulk_insert(myState->transientrel, myState->ti_options);
@@ -626,6 +694,7 @@ refresh_by_match_merge(Oid matviewOid, Oid tempOid, Oid relowner,
 	ListCell   *indexoidscan;
 	int16		relnatts;
 	Oid		   *opUsedForQual;
+	uint64		ndiff;
 
 	initStringInfo(&querybuf);
 	matviewRel = table_open(matviewOid, NoLock);
@@ -846,42 +915,52 @@ refresh_by_match_merge(Oid matviewOid, Oid tempOid, Oid relowner,
 	/* Populate the temporary "diff" table. */
 	if (SPI_exec(querybuf.data, 0) != SPI_OK_INSERT)
 		elog(ERROR, "SPI_exec failed: %s", querybuf.data);
+	ndiff = SPI_processed;
 
 	/*
 	 * We have no further use for data from the "full-data" temp table, but we
 	 * must keep it around because its type is referenced from the diff table.
 	 */
 
-	/* Analyze the diff table. */
-	resetStringInfo(&querybuf);
-	appendStringInfo(&querybuf, "ANALYZE %s", diffname);
-	if (SPI_exec(querybuf.data, 0) != SPI_OK_UTILITY)
-		elog(ERROR, "SPI_exec failed: %s", querybuf.data);
-
-	OpenMatViewIncrementalMaintenance();
-
-	/* Deletes must come before inserts; do them first. */
-	resetStringInfo(&querybuf);
-	appendStringInfo(&querybuf,
-					 "DELETE FROM %s mv WHERE ctid OPERATOR(pg_catalog.=) ANY "
-					 "(SELECT diff.tid FROM %s diff "
-					 "WHERE diff.tid IS NOT NULL "
-					 "AND diff.newdata IS NULL)",
-					 matviewname, diffname);
-	if (SPI_exec(querybuf.data, 0) != SPI_OK_DELETE)
-		elog(ERROR, "SPI_exec failed: %s", querybuf.data);
-
-	/* Inserts go last. */
-	resetStringInfo(&querybuf);
-	appendStringInfo(&querybuf,
-					 "INSERT INTO %s SELECT (diff.newdata).* "
-					 "FROM %s diff WHERE tid IS NULL",
-					 matviewname, diffname);
-	if (SPI_exec(querybuf.data, 0) != SPI_OK_INSERT)
-		elog(ERROR, "SPI_exec failed: %s", querybuf.data);
-
-	/* We're done maintaining the materialized view. */
-	CloseMatViewIncrementalMaintenance();
+	/*
+	 * If the new data is identical to the existing contents, the diff table
+	 * is empty and there is nothing to apply; skip the DML against the
+	 * matview entirely so that a no-op refresh only pays for computing the
+	 * diff.
+	 */
+	if (ndiff > 0)
+	{
+		/* Analyze the diff table. */
+		resetStringInfo(&querybuf);
+		appendStringInfo(&querybuf, "ANALYZE %s", diffname);
+		if (SPI_exec(querybuf.data, 0) != SPI_OK_UTILITY)
+			elog(ERROR, "SPI_exec failed: %s", querybuf.data);
+
+		OpenMatViewIncrementalMaintenance();
+
+		/* Deletes must come before inserts; do them first. */
+		resetStringInfo(&querybuf);
+		appendStringInfo(&querybuf,
+						 "DELETE FROM %s mv WHERE ctid OPERATOR(pg_catalog.=) ANY "
+						 "(SELECT diff.tid FROM %s diff "
+						 "WHERE diff.tid IS NOT NULL "
+						 "AND diff.newdata IS NULL)",
+						 matviewname, diffname);
+		if (SPI_exec(querybuf.data, 0) != SPI_OK_DELETE)
+			elog(ERROR, "SPI_exec failed: %s", querybuf.data);
+
+		/* Inserts go last. */
+		resetStringInfo(&querybuf);
+		appendStringInfo(&querybuf,
+						 "INSERT INTO %s SELECT (diff.newdata).* "
+						 "FROM %s diff WHERE tid IS NULL",
+						 matviewname, diffname);
+		if (SPI_exec(querybuf.data, 0) != SPI_OK_INSERT)
+			elog(ERROR, "SPI_exec failed: %s", querybuf.data);
+
+		/* We're done maintaining the materialized view. */
+		CloseMatViewIncrementalMaintenance();
+	}
 	table_close(tempRel, NoLock);
 	table_close(matviewRel, NoLock);
 
@@ -54,9 +54,21 @@
  * We don't want to log each fetching of a value from a sequence,
  * so we pre-log a few fetches in advance. In the event of
  * crash we can lose (skip over) as many values as we pre-logged.
+ *
+ * For sequences with a larger CACHE setting, we pre-log at least one
+ * full cache's worth of values, so that successive cache refills don't
+ * each emit a WAL record; such sequences already accept gaps of that
+ * order when a backend exits without using its cached values.
  */
 #define SEQ_LOG_VALS	32
 
+/*
+ * Number of values to pre-log beyond the current fetch quantity.  The
+ * clamp avoids int64 overflow with absurdly large CACHE settings.
+ */
+#define seq_log_ahead(fetch) \
+	Max(SEQ_LOG_VALS, Min(fetch, PG_INT64_MAX / 2 - (fetch)))
+
 /*
  * The "special area" of a sequence's buffer page looks like this.
  */
@@ -702,8 +714,8 @@ nextval_internal(Oid relid, bool check_permissions)
 
 	/*
 	 * Decide whether we should emit a WAL log record.  If so, force up the
-	 * fetch count to grab SEQ_LOG_VALS more values than we actually need to
-	 * cache.  (These will then be usable without logging.)
+	 * fetch count to grab seq_log_ahead() more values than we actually need
+	 * to cache.  (These will then be usable without logging.)
 	 *
 	 * If this is the first nextval after a checkpoint, we must force a new
 	 * WAL record to be written anyway, else replay starting from the
@@ -713,7 +725,7 @@ nextval_internal(Oid relid, bool check_permissions)
 	if (log < fetch || !seq->is_called)
 	{
 		/* forced log to satisfy local demand for values */
-		fetch = log = fetch + SEQ_LOG_VALS;
+		fetch = log = fetch + seq_log_ahead(fetch);
 		logit = true;
 	}
 	else
@@ -723,7 +735,7 @@ nextval_internal(Oid relid, bool check_permissions)
 		if (PageGetLSN(page) <= redoptr)
 		{
 			/* last update of seq was before checkpoint */
-			fetch = log = fetch + SEQ_LOG_VALS;
+			fetch = log = fetch + seq_log_ahead(fetch);
 			logit = true;
 		}
 	}
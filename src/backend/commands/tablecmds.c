@@ -25,6 +25,7 @@
 #include "access/sysattr.h"
 #include "access/tableam.h"
 #include "access/toast_compression.h"
+#include "access/toast_internals.h"
 #include "access/xact.h"
 #include "access/xlog.h"
 #include "access/xloginsert.h"
@@ -475,6 +476,12 @@ static void ATRewriteTables(AlterTableStmt *parsetree,
 							List **wqueue, LOCKMODE lockmode,
 							AlterTableUtilityContext *context);
 static void ATRewriteTable(AlteredTableInfo *tab, Oid OIDNewHeap);
+static bool ATCopyTableByBlocks(Oid OIDOldHeap, Oid OIDNewHeap,
+								TransactionId *frozenXid,
+								MultiXactId *cutoffMulti,
+								bool *swapToastByContent);
+static void ATCopyStorageByBlocks(Relation src, Relation dst,
+								  char relpersistence);
 static AlteredTableInfo *ATGetQueueEntry(List **wqueue, Relation rel);
 static void ATSimplePermissions(AlterTableType cmdtype, Relation rel, int allowed_targets);
 static void ATSimpleRecursion(List **wqueue, Relation rel,
@@ -5879,6 +5886,11 @@ ATRewriteTables(AlterTableStmt *parsetree, List **wqueue, LOCKMODE lockmode,
 			Oid			NewAccessMethod;
 			Oid			NewTableSpace;
 			char		persistence;
+			bool		is_heap;
+			bool		copied_by_blocks = false;
+			bool		swap_toast_by_content;
+			TransactionId frozenXid;
+			MultiXactId cutoffMulti;
 
 			OldHeap = table_open(tab->relid, NoLock);
 
@@ -5935,6 +5947,8 @@ ATRewriteTables(AlterTableStmt *parsetree, List **wqueue, LOCKMODE lockmode,
 			persistence = tab->chgPersistence ?
 				tab->newrelpersistence : OldHeap->rd_rel->relpersistence;
 
+			is_heap = (OldHeap->rd_rel->relam == HEAP_TABLE_AM_OID);
+
 			table_close(OldHeap, NoLock);
 
 			/*
@@ -5972,25 +5986,59 @@ ATRewriteTables(AlterTableStmt *parsetree, List **wqueue, LOCKMODE lockmode,
 									   persistence, lockmode);
 
 			/*
-			 * Copy the heap data into the new table with the desired
-			 * modifications, and test the current data within the table
-			 * against new constraints generated by ALTER TABLE commands.
+			 * If the only reason for the rewrite is the persistence change
+			 * and the tuples themselves need neither modification nor
+			 * checking, copy the data block-by-block instead of
+			 * tuple-by-tuple; that ships whole pages into WAL in batches
+			 * rather than logging every tuple separately.  This can still
+			 * fall through to the tuple-level path if the transient table
+			 * lacks a toast table the old one has.
 			 */
-			ATRewriteTable(tab, OIDNewHeap);
+			if (tab->rewrite == AT_REWRITE_ALTER_PERSISTENCE &&
+				is_heap &&
+				tab->newvals == NIL &&
+				tab->constraints == NIL &&
+				!tab->verify_new_notnull &&
+				tab->partition_constraint == NULL)
+				copied_by_blocks = ATCopyTableByBlocks(tab->relid, OIDNewHeap,
+													   &frozenXid,
+													   &cutoffMulti,
+													   &swap_toast_by_content);
+
+			/*
+			 * Otherwise, copy the heap data into the new table with the
+			 * desired modifications, and test the current data within the
+			 * table against new constraints generated by ALTER TABLE
+			 * commands.
+			 */
+			if (!copied_by_blocks)
+			{
+				ATRewriteTable(tab, OIDNewHeap);
+
+				/*
+				 * We can use RecentXmin for the table's new relfrozenxid
+				 * because we rewrote all the tuples in ATRewriteTable, so no
+				 * older Xid remains in the table.  Also, we never try to
+				 * swap toast tables by content, since we have no interest in
+				 * letting this code work on system catalogs.  (The
+				 * block-level path above instead preserves the old
+				 * relfrozenxid and does swap toast by content, since it
+				 * copies the tuples verbatim.)
+				 */
+				swap_toast_by_content = false;
+				frozenXid = RecentXmin;
+				cutoffMulti = ReadNextMultiXactId();
+			}
 
 			/*
 			 * Swap the physical files of the old and new heaps, then rebuild
-			 * indexes and discard the old heap.  We can use RecentXmin for
-			 * the table's new relfrozenxid because we rewrote all the tuples
-			 * in ATRewriteTable, so no older Xid remains in the table.  Also,
-			 * we never try to swap toast tables by content, since we have no
-			 * interest in letting this code work on system catalogs.
+			 * indexes and discard the old heap.
 			 */
 			finish_heap_swap(tab->relid, OIDNewHeap,
-							 false, false, true,
+							 false, swap_toast_by_content, true,
 							 !OidIsValid(tab->newTableSpace),
-							 RecentXmin,
-							 ReadNextMultiXactId(),
+							 frozenXid,
+							 cutoffMulti,
 							 persistence);
 
 			InvokeObjectPostAlterHook(RelationRelationId, tab->relid, 0);
@@ -6105,6 +6153,159 @@ ATRewriteTables(AlterTableStmt *parsetree, List **wqueue, LOCKMODE lockmode,
 	}
 }
 
+/*
+ * ATCopyTableByBlocks: block-level data copy for a persistence-only rewrite
+ *
+ * When SET LOGGED/UNLOGGED is the only reason a table must be rewritten, the
+ * tuple contents do not change, so we can copy the data into the transient
+ * heap fork-by-fork at the smgr level instead of re-forming and re-inserting
+ * every tuple.  When the destination is permanent, RelationCopyStorage
+ * WAL-logs the copied pages as batched full-page images, which is much
+ * cheaper than emitting per-tuple WAL records.
+ *
+ * The toast table (if any) and its valid index are copied the same way.  The
+ * copied heap tuples contain toast pointers referencing the old toast
+ * table's OID, so the caller must then swap the toast tables by content;
+ * *swapToastByContent is set accordingly.  Because the tuples are copied
+ * verbatim, the caller must also carry forward the old relation's
+ * relfrozenxid and relminmxid, returned in *frozenXid and *cutoffMulti,
+ * rather than using fresh values as a tuple-level rewrite would.
+ *
+ * Returns false, without copying anything, if this technique cannot be
+ * applied because the old table has a toast table but the transient table
+ * does not (possible when toastable columns have been dropped); the caller
+ * must then fall back on ATRewriteTable.
+ */
+static bool
+ATCopyTableByBlocks(Oid OIDOldHeap, Oid OIDNewHeap,
+					TransactionId *frozenXid,
+					MultiXactId *cutoffMulti,
+					bool *swapToastByContent)
+{
+	Relation	OldHeap;
+	Relation	NewHeap;
+
+	/* Caller (ALTER TABLE) holds AccessExclusiveLock on the old heap */
+	OldHeap = table_open(OIDOldHeap, NoLock);
+	/* make_new_heap obtained AccessExclusiveLock on the new heap */
+	NewHeap = table_open(OIDNewHeap, NoLock);
+
+	if (OidIsValid(OldHeap->rd_rel->reltoastrelid) &&
+		!OidIsValid(NewHeap->rd_rel->reltoastrelid))
+	{
+		table_close(OldHeap, NoLock);
+		table_close(NewHeap, NoLock);
+		return false;
+	}
+
+	ATCopyStorageByBlocks(OldHeap, NewHeap,
+						  NewHeap->rd_rel->relpersistence);
+
+	if (OidIsValid(OldHeap->rd_rel->reltoastrelid))
+	{
+		Relation	OldToast;
+		Relation	NewToast;
+		Relation	OldToastIdx;
+		Relation	NewToastIdx;
+
+		/*
+		 * Lock the old toast table before copying it, to keep autovacuum
+		 * from modifying it under us; cf. copy_table_data().  The new toast
+		 * table was locked by make_new_heap.
+		 */
+		OldToast = table_open(OldHeap->rd_rel->reltoastrelid,
+							  AccessExclusiveLock);
+		NewToast = table_open(NewHeap->rd_rel->reltoastrelid, NoLock);
+
+		ATCopyStorageByBlocks(OldToast, NewToast,
+							  NewToast->rd_rel->relpersistence);
+
+		/*
+		 * Copy the toast index as well: the chunk TIDs are unchanged, so the
+		 * old index describes the copied data exactly, and
+		 * swap_relation_files will swap the toast indexes along with the
+		 * toast tables when swapping by content.  (The transient toast
+		 * index's own pages were written with the bulk-write facility, not
+		 * through shared buffers, so overwriting them at the smgr level is
+		 * safe.)
+		 */
+		OldToastIdx = index_open(toast_get_valid_index(RelationGetRelid(OldToast),
+													   NoLock),
+								 AccessExclusiveLock);
+		NewToastIdx = index_open(toast_get_valid_index(RelationGetRelid(NewToast),
+													   NoLock),
+								 AccessExclusiveLock);
+
+		ATCopyStorageByBlocks(OldToastIdx, NewToastIdx,
+							  NewToast->rd_rel->relpersistence);
+
+		index_close(OldToastIdx, NoLock);
+		index_close(NewToastIdx, NoLock);
+		table_close(OldToast, NoLock);
+		table_close(NewToast, NoLock);
+
+		*swapToastByContent = true;
+	}
+	else
+		*swapToastByContent = false;
+
+	*frozenXid = OldHeap->rd_rel->relfrozenxid;
+	*cutoffMulti = OldHeap->rd_rel->relminmxid;
+
+	table_close(OldHeap, NoLock);
+	table_close(NewHeap, NoLock);
+
+	return true;
+}
+
+/*
+ * Copy all forks of src except the init fork into dst, at the block level.
+ *
+ * dst must have been created in the current transaction and never read into
+ * shared buffers, since we write to it through smgr directly.  Its main fork
+ * (and init fork, when dst is unlogged) already exists; any other forks are
+ * created here.  relpersistence is dst's persistence, which determines
+ * whether the copied pages must be WAL-logged.
+ */
+static void
+ATCopyStorageByBlocks(Relation src, Relation dst, char relpersistence)
+{
+	/*
+	 * Since we read the source directly without looking at the shared
+	 * buffers, we'd better first flush out any pages of it that are in
+	 * shared buffers.  We assume no new changes will be made while we are
+	 * holding exclusive lock on the rel.
+	 */
+	FlushRelationBuffers(src);
+
+	/* copy main fork */
+	RelationCopyStorage(RelationGetSmgr(src), RelationGetSmgr(dst),
+						MAIN_FORKNUM, relpersistence);
+
+	/* copy those extra forks that exist */
+	for (ForkNumber forkNum = MAIN_FORKNUM + 1;
+		 forkNum <= MAX_FORKNUM; forkNum++)
+	{
+		/*
+		 * The source's init fork (if any) reflects its old persistence; dst
+		 * keeps whatever init fork it was created with.
+		 */
+		if (forkNum == INIT_FORKNUM)
+			continue;
+
+		if (smgrexists(RelationGetSmgr(src), forkNum))
+		{
+			smgrcreate(RelationGetSmgr(dst), forkNum, false);
+
+			/* WAL log creation if the relation is persistent */
+			if (relpersistence == RELPERSISTENCE_PERMANENT)
+				log_smgrcreate(&dst->rd_locator, forkNum);
+			RelationCopyStorage(RelationGetSmgr(src), RelationGetSmgr(dst),
+								forkNum, relpersistence);
+		}
+	}
+}
+
 /*
  * ATRewriteTable: scan or rewrite one table
  *
@@ -45,6 +45,7 @@
 #include "pgstat.h"
 #include "rewrite/rewriteHandler.h"
 #include "rewrite/rewriteManip.h"
+#include "storage/bufmgr.h"
 #include "storage/lmgr.h"
 #include "utils/acl.h"
 #include "utils/builtins.h"
@@ -56,6 +57,7 @@
 #include "utils/plancache.h"
 #include "utils/rel.h"
 #include "utils/snapmgr.h"
+#include "utils/spccache.h"
 #include "utils/syscache.h"
 #include "utils/tuplestore.h"
 
@@ -4637,6 +4639,77 @@ afterTriggerMarkEvents(AfterTriggerEventList *events,
 	return found;
 }
 
+#ifdef USE_PREFETCH
+/*
+ * afterTriggerInvokeEvents() keeps a second cursor running ahead of the
+ * firing loop and issues prefetch requests for the heap blocks that
+ * upcoming events will fetch their tuples from, so that the per-event
+ * table_tuple_fetch_row_version() calls don't stall on storage.
+ */
+typedef struct AfterTriggerPrefetchState
+{
+	AfterTriggerEvent next_event;	/* resume point within current chunk */
+	BlockNumber cur_blkno;		/* last block a request was issued for */
+	int			distance;		/* max distinct blocks to run ahead */
+	int			in_flight;		/* distinct blocks issued, not yet fired */
+} AfterTriggerPrefetchState;
+
+/*
+ * Issue prefetch requests for upcoming events in this chunk.  Each call
+ * picks up where the previous one left off, and stops once the cursor has
+ * run pfstate->distance distinct blocks ahead of the firing loop.  Only
+ * events on the relation currently being fired are considered; the caller
+ * resets the cursor on a relation switch.
+ */
+static void
+afterTriggerPrefetchTuples(AfterTriggerPrefetchState *pfstate,
+						   AfterTriggerEventChunk *chunk,
+						   Relation rel, Oid relid,
+						   CommandId firing_id)
+{
+	AfterTriggerEvent event = pfstate->next_event;
+	BlockNumber cur_blkno = pfstate->cur_blkno;
+
+	for_each_event_from(event, chunk)
+	{
+		TriggerFlags tupbits = event->ate_flags & AFTER_TRIGGER_TUP_BITS;
+		AfterTriggerShared evtshared;
+
+		if (pfstate->in_flight >= pfstate->distance)
+			break;
+
+		/* consider only events the firing loop will fetch tuples for */
+		if (!(event->ate_flags & AFTER_TRIGGER_IN_PROGRESS))
+			continue;
+		if (tupbits != AFTER_TRIGGER_1CTID && tupbits != AFTER_TRIGGER_2CTID)
+			continue;
+		evtshared = GetTriggerSharedData(event);
+		if (evtshared->ats_firing_id != firing_id ||
+			evtshared->ats_relid != relid)
+			continue;
+
+		if (ItemPointerIsValid(&event->ate_ctid1) &&
+			ItemPointerGetBlockNumber(&event->ate_ctid1) != cur_blkno)
+		{
+			cur_blkno = ItemPointerGetBlockNumber(&event->ate_ctid1);
+			PrefetchBuffer(rel, MAIN_FORKNUM, cur_blkno);
+			pfstate->in_flight++;
+		}
+		if (tupbits == AFTER_TRIGGER_2CTID &&
+			ItemPointerIsValid(&event->ate_ctid2) &&
+			ItemPointerGetBlockNumber(&event->ate_ctid2) != cur_blkno)
+		{
+			cur_blkno = ItemPointerGetBlockNumber(&event->ate_ctid2);
+			PrefetchBuffer(rel, MAIN_FORKNUM, cur_blkno);
+			pfstate->in_flight++;
+		}
+	}
+
+	pfstate->next_event = event;
+	pfstate->cur_blkno = cur_blkno;
+}
+#endif							/* USE_PREFETCH */
+
 /*
  * afterTriggerInvokeEvents()
  *
@@ -4675,6 +4748,10 @@ afterTriggerInvokeEvents(AfterTriggerEventList *events,
 	Instrumentation *instr = NULL;
 	TupleTableSlot *slot1 = NULL,
 			   *slot2 = NULL;
+#ifdef USE_PREFETCH
+	AfterTriggerPrefetchState pfstate = {0};
+	BlockNumber fire_blkno = InvalidBlockNumber;
+#endif
 
 	/* Make a local EState if need be */
 	if (estate == NULL)
@@ -4694,6 +4771,11 @@ afterTriggerInvokeEvents(AfterTriggerEventList *events,
 		AfterTriggerEvent event;
 		bool		all_fired_in_chunk = true;
 
+#ifdef USE_PREFETCH
+		/* the prefetch cursor never spans chunks */
+		pfstate.next_event = NULL;
+#endif
+
 		for_each_event(event, chunk)
 		{
 			AfterTriggerShared evtshared = GetTriggerSharedData(event);
@@ -4735,6 +4817,16 @@ afterTriggerInvokeEvents(AfterTriggerEventList *events,
 						slot2 = MakeSingleTupleTableSlot(rel->rd_att,
 														 &TTSOpsMinimalTuple);
 					}
+#ifdef USE_PREFETCH
+					/* restart the prefetch cursor for the new relation */
+					pfstate.next_event = NULL;
+					if (RELKIND_HAS_STORAGE(rel->rd_rel->relkind))
+						pfstate.distance =
+							get_tablespace_io_concurrency(rel->rd_rel->reltablespace);
+					else
+						pfstate.distance = 0;
+					fire_blkno = InvalidBlockNumber;
+#endif
 				}
 
 				/*
@@ -4756,6 +4848,52 @@ afterTriggerInvokeEvents(AfterTriggerEventList *events,
 				else
 					src_rInfo = dst_rInfo = rInfo;
 
+#ifdef USE_PREFETCH
+
+				/*
+				 * Keep prefetch requests running ahead of the firing loop
+				 * for the blocks that upcoming events will fetch their
+				 * tuples from.
+				 */
+				if (pfstate.distance > 0)
+				{
+					TriggerFlags tupbits =
+						event->ate_flags & AFTER_TRIGGER_TUP_BITS;
+
+					/* note when firing has caught up with a prefetched block */
+					if (tupbits == AFTER_TRIGGER_1CTID ||
+						tupbits == AFTER_TRIGGER_2CTID)
+					{
+						if (ItemPointerIsValid(&event->ate_ctid1) &&
+							ItemPointerGetBlockNumber(&event->ate_ctid1) != fire_blkno)
+						{
+							fire_blkno = ItemPointerGetBlockNumber(&event->ate_ctid1);
+							if (pfstate.in_flight > 0)
+								pfstate.in_flight--;
+						}
+						if (tupbits == AFTER_TRIGGER_2CTID &&
+							ItemPointerIsValid(&event->ate_ctid2) &&
+							ItemPointerGetBlockNumber(&event->ate_ctid2) != fire_blkno)
+						{
+							fire_blkno = ItemPointerGetBlockNumber(&event->ate_ctid2);
+							if (pfstate.in_flight > 0)
+								pfstate.in_flight--;
+						}
+					}
+
+					if (pfstate.next_event == NULL)
+					{
+						pfstate.next_event = (AfterTriggerEvent)
+							((char *) event + SizeofTriggerEvent(event));
+						pfstate.cur_blkno = InvalidBlockNumber;
+						pfstate.in_flight = 0;
+					}
+					afterTriggerPrefetchTuples(&pfstate, chunk, rel,
+											   evtshared->ats_relid,
+											   firing_id);
+				}
+#endif
+
 				/*
 				 * Fire it.  Note that the AFTER_TRIGGER_IN_PROGRESS flag is
 				 * still set, so recursive examinations of the event list
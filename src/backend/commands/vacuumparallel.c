@@ -6,15 +6,17 @@
  * This file contains routines that are intended to support setting up, using,
  * and tearing down a ParallelVacuumState.
  *
- * In a parallel vacuum, we perform both index bulk deletion and index cleanup
- * with parallel worker processes.  Individual indexes are processed by one
- * vacuum process.  ParallelVacuumState contains shared information as well as
- * the memory space for storing dead items allocated in the DSA area.  We
- * launch parallel worker processes at the start of parallel index
- * bulk-deletion and index cleanup and once all indexes are processed, the
- * parallel worker processes exit.  Each time we process indexes in parallel,
- * the parallel context is re-initialized so that the same DSM can be used for
- * multiple passes of index bulk-deletion and index cleanup.
+ * In a parallel vacuum, we perform index bulk deletion, index cleanup, and
+ * removal of dead items from the heap with parallel worker processes.  During
+ * index vacuuming, individual indexes are processed by one vacuum process;
+ * during heap vacuuming, each process removes dead items from its own stripe
+ * of the heap blocks.  ParallelVacuumState contains shared information as
+ * well as the memory space for storing dead items allocated in the DSA area.
+ * We launch parallel worker processes at the start of each parallel phase and
+ * once the phase's work is complete, the parallel worker processes exit.
+ * Each time a phase is executed in parallel, the parallel context is
+ * re-initialized so that the same DSM can be used for multiple passes of
+ * index bulk-deletion, heap vacuuming and index cleanup.
  *
  * Portions Copyright (c) 1996-2025, PostgreSQL Global Development Group
  * Portions Copyright (c) 1994, Regents of the University of California
@@ -27,6 +29,7 @@
 #include "postgres.h"
 
 #include "access/amapi.h"
+#include "access/heapam.h"
 #include "access/table.h"
 #include "access/xact.h"
 #include "commands/progress.h"
@@ -50,6 +53,13 @@
 #define PARALLEL_VACUUM_KEY_WAL_USAGE		4
 #define PARALLEL_VACUUM_KEY_INDEX_STATS		5
 
+/* The kind of work parallel vacuum workers perform when launched */
+typedef enum PVWorkPhase
+{
+	PV_WORK_PHASE_PROCESS_INDEXES,	/* index vacuum or cleanup */
+	PV_WORK_PHASE_VACUUM_HEAP,	/* removing dead items from the heap */
+} PVWorkPhase;
+
 /*
  * Shared information among parallel workers.  So this is allocated in the DSM
  * segment.
@@ -119,6 +129,24 @@ typedef struct PVShared
 
 	/* Statistics of shared dead items */
 	VacDeadItemsInfo dead_items_info;
+
+	/* The phase of parallel work to perform when workers are launched */
+	PVWorkPhase work_phase;
+
+	/*
+	 * Fields used during parallel heap vacuuming.  oldest_xmin is the
+	 * leader's visibility cutoff, so that all participants apply the same
+	 * horizon when re-checking whether a vacuumed page has become
+	 * all-visible.  heap_nparticipants is the planned number of participants
+	 * including the leader, used to divide the heap blocks into stripes.
+	 */
+	TransactionId heap_oldest_xmin;
+	int			heap_nparticipants;
+
+	/* Counters accumulated by parallel heap vacuuming workers */
+	pg_atomic_uint32 heap_vacuumed_pages;
+	pg_atomic_uint32 heap_vm_new_visible_pages;
+	pg_atomic_uint32 heap_vm_new_visible_frozen_pages;
 } PVShared;
 
 /* Status used during parallel index vacuum or cleanup */
@@ -390,6 +418,10 @@ parallel_vacuum_init(Relation rel, Relation *indrels, int nindexes,
 	pg_atomic_init_u32(&(shared->cost_balance), 0);
 	pg_atomic_init_u32(&(shared->active_nworkers), 0);
 	pg_atomic_init_u32(&(shared->idx), 0);
+	shared->work_phase = PV_WORK_PHASE_PROCESS_INDEXES;
+	pg_atomic_init_u32(&(shared->heap_vacuumed_pages), 0);
+	pg_atomic_init_u32(&(shared->heap_vm_new_visible_pages), 0);
+	pg_atomic_init_u32(&(shared->heap_vm_new_visible_frozen_pages), 0);
 
 	shm_toc_insert(pcxt->toc, PARALLEL_VACUUM_KEY_SHARED, shared);
 	pvs->shared = shared;
@@ -532,6 +564,114 @@ parallel_vacuum_cleanup_all_indexes(ParallelVacuumState *pvs, long num_table_tup
 	parallel_vacuum_process_all_indexes(pvs, num_index_scans, false);
 }
 
+/*
+ * Begin parallel heap vacuuming (vacuum's third phase) by launching parallel
+ * workers.  Returns the planned number of participants including the leader;
+ * the number of workers actually launched is returned via nworkers_launched.
+ *
+ * The caller must process the stripe of heap blocks belonging to participant
+ * 0, plus the stripes of any planned workers beyond the number actually
+ * launched, and then call parallel_vacuum_heap_end().
+ */
+int
+parallel_vacuum_heap_begin(ParallelVacuumState *pvs, TransactionId oldest_xmin,
+						   int *nworkers_launched)
+{
+	int			nworkers = pvs->pcxt->nworkers;
+
+	Assert(!IsParallelWorker());
+
+	pvs->shared->work_phase = PV_WORK_PHASE_VACUUM_HEAP;
+	pvs->shared->heap_oldest_xmin = oldest_xmin;
+
+	/*
+	 * The stripes are divided among the planned participants.  If some
+	 * workers fail to launch, the leader processes their stripes as well, so
+	 * it is okay that the workers see the planned number rather than the
+	 * launched number.
+	 */
+	pvs->shared->heap_nparticipants = nworkers + 1;
+
+	pg_atomic_write_u32(&(pvs->shared->heap_vacuumed_pages), 0);
+	pg_atomic_write_u32(&(pvs->shared->heap_vm_new_visible_pages), 0);
+	pg_atomic_write_u32(&(pvs->shared->heap_vm_new_visible_frozen_pages), 0);
+
+	/* Reinitialize parallel context to relaunch parallel workers */
+	ReinitializeParallelDSM(pvs->pcxt);
+
+	/*
+	 * Set up shared cost balance and the number of active workers for vacuum
+	 * delay.  We need to do this before launching workers as otherwise, they
+	 * might not see the updated values for these parameters.
+	 */
+	pg_atomic_write_u32(&(pvs->shared->cost_balance), VacuumCostBalance);
+	pg_atomic_write_u32(&(pvs->shared->active_nworkers), 0);
+
+	ReinitializeParallelWorkers(pvs->pcxt, nworkers);
+
+	LaunchParallelWorkers(pvs->pcxt);
+
+	if (pvs->pcxt->nworkers_launched > 0)
+	{
+		/*
+		 * Reset the local cost values for leader backend as we have already
+		 * accumulated the remaining balance of heap.
+		 */
+		VacuumCostBalance = 0;
+		VacuumCostBalanceLocal = 0;
+
+		/* Enable shared cost balance for leader backend */
+		VacuumSharedCostBalance = &(pvs->shared->cost_balance);
+		VacuumActiveNWorkers = &(pvs->shared->active_nworkers);
+	}
+
+	ereport(pvs->shared->elevel,
+			(errmsg(ngettext("launched %d parallel vacuum worker for heap vacuuming (planned: %d)",
+							 "launched %d parallel vacuum workers for heap vacuuming (planned: %d)",
+							 pvs->pcxt->nworkers_launched),
+					pvs->pcxt->nworkers_launched, nworkers)));
+
+	*nworkers_launched = pvs->pcxt->nworkers_launched;
+
+	return pvs->shared->heap_nparticipants;
+}
+
+/*
+ * Finish parallel heap vacuuming: wait for all workers to exit and return
+ * the totals of their per-worker counters, for the leader to combine with
+ * its own.
+ */
+void
+parallel_vacuum_heap_end(ParallelVacuumState *pvs, BlockNumber *vacuumed_pages,
+						 BlockNumber *vm_new_visible_pages,
+						 BlockNumber *vm_new_visible_frozen_pages)
+{
+	Assert(!IsParallelWorker());
+
+	/* Wait for all vacuum workers to finish */
+	WaitForParallelWorkersToFinish(pvs->pcxt);
+
+	/* Accumulate buffer and WAL usage incurred by the workers */
+	for (int i = 0; i < pvs->pcxt->nworkers_launched; i++)
+		InstrAccumParallelQuery(&pvs->buffer_usage[i], &pvs->wal_usage[i]);
+
+	*vacuumed_pages = pg_atomic_read_u32(&(pvs->shared->heap_vacuumed_pages));
+	*vm_new_visible_pages =
+		pg_atomic_read_u32(&(pvs->shared->heap_vm_new_visible_pages));
+	*vm_new_visible_frozen_pages =
+		pg_atomic_read_u32(&(pvs->shared->heap_vm_new_visible_frozen_pages));
+
+	/*
+	 * Carry the shared balance value to heap scan and disable shared costing
+	 */
+	if (VacuumSharedCostBalance)
+	{
+		VacuumCostBalance = pg_atomic_read_u32(VacuumSharedCostBalance);
+		VacuumSharedCostBalance = NULL;
+		VacuumActiveNWorkers = NULL;
+	}
+}
+
 /*
  * Compute the number of parallel worker processes to request.  Both index
  * vacuum and index cleanup can be executed with parallel workers.
@@ -664,6 +804,7 @@ parallel_vacuum_process_all_indexes(ParallelVacuumState *pvs, int num_index_scan
 	}
 
 	/* Reset the parallel index processing and progress counters */
+	pvs->shared->work_phase = PV_WORK_PHASE_PROCESS_INDEXES;
 	pg_atomic_write_u32(&(pvs->shared->idx), 0);
 
 	/* Setup the shared cost-based vacuum delay and launch workers */
@@ -982,8 +1123,10 @@ parallel_vacuum_index_is_parallel_safe(Relation indrel, int num_index_scans,
 /*
  * Perform work within a launched parallel process.
  *
- * Since parallel vacuum workers perform only index vacuum or index cleanup,
- * we don't need to report progress information.
+ * Depending on the phase the leader is in, workers either vacuum or clean up
+ * indexes, or remove dead items from their stripe of the heap blocks.  Since
+ * progress information is reported by the leader, we don't need to report it
+ * here.
  */
 void
 parallel_vacuum_main(dsm_segment *seg, shm_toc *toc)
@@ -1085,8 +1228,41 @@ parallel_vacuum_main(dsm_segment *seg, shm_toc *toc)
 	/* Prepare to track buffer usage during parallel execution */
 	InstrStartParallelQuery();
 
-	/* Process indexes to perform vacuum/cleanup */
-	parallel_vacuum_process_safe_indexes(&pvs);
+	if (shared->work_phase == PV_WORK_PHASE_VACUUM_HEAP)
+	{
+		BlockNumber vacuumed_pages;
+		BlockNumber vm_new_visible_pages;
+		BlockNumber vm_new_visible_frozen_pages;
+
+		/* Increment the active worker count, then reap our heap stripe */
+		if (VacuumActiveNWorkers)
+			pg_atomic_add_fetch_u32(VacuumActiveNWorkers, 1);
+
+		heap_parallel_vacuum_heap_rel(rel, dead_items,
+									  &shared->dead_items_info,
+									  shared->heap_oldest_xmin,
+									  pvs.bstrategy,
+									  ParallelWorkerNumber + 1,
+									  shared->heap_nparticipants,
+									  &vacuumed_pages,
+									  &vm_new_visible_pages,
+									  &vm_new_visible_frozen_pages);
+
+		pg_atomic_add_fetch_u32(&(shared->heap_vacuumed_pages),
+								vacuumed_pages);
+		pg_atomic_add_fetch_u32(&(shared->heap_vm_new_visible_pages),
+								vm_new_visible_pages);
+		pg_atomic_add_fetch_u32(&(shared->heap_vm_new_visible_frozen_pages),
+								vm_new_visible_frozen_pages);
+
+		if (VacuumActiveNWorkers)
+			pg_atomic_sub_fetch_u32(VacuumActiveNWorkers, 1);
+	}
+	else
+	{
+		/* Process indexes to perform vacuum/cleanup */
+		parallel_vacuum_process_safe_indexes(&pvs);
+	}
 
 	/* Report buffer/WAL usage during parallel execution */
 	buffer_usage = shm_toc_lookup(toc, PARALLEL_VACUUM_KEY_BUFFER_USAGE, false);
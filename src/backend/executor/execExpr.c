@@ -47,6 +47,7 @@
 #include "utils/acl.h"
 #include "utils/array.h"
 #include "utils/builtins.h"
+#include "utils/fmgroids.h"
 #include "utils/jsonfuncs.h"
 #include "utils/jsonpath.h"
 #include "utils/lsyscache.h"
@@ -74,6 +75,8 @@ static void ExecInitExprRec(Expr *node, ExprState *state,
 static void ExecInitFunc(ExprEvalStep *scratch, Expr *node, List *args,
 						 Oid funcid, Oid inputcollid,
 						 ExprState *state);
+static bool ExecInitStableConstExpr(Expr *node, ExprState *state,
+									Datum *resv, bool *resnull);
 static void ExecInitSubPlanExpr(SubPlan *subplan,
 								ExprState *state,
 								Datum *resv, bool *resnull);
@@ -1193,6 +1196,10 @@ ExecInitExprRec(Expr *node, ExprState *state,
 			{
 				FuncExpr   *func = (FuncExpr *) node;
 
+				/* evaluate just once if the value can't change */
+				if (ExecInitStableConstExpr(node, state, resv, resnull))
+					break;
+
 				ExecInitFunc(&scratch, node,
 							 func->args, func->funcid, func->inputcollid,
 							 state);
@@ -1204,6 +1211,10 @@ ExecInitExprRec(Expr *node, ExprState *state,
 			{
 				OpExpr	   *op = (OpExpr *) node;
 
+				/* evaluate just once if the value can't change */
+				if (ExecInitStableConstExpr(node, state, resv, resnull))
+					break;
+
 				ExecInitFunc(&scratch, node,
 							 op->args, op->opfuncid, op->inputcollid,
 							 state);
@@ -2692,6 +2703,88 @@ ExprEvalPushStep(ExprState *es, const ExprEvalStep *s)
 	memcpy(&es->steps[es->steps_len++], s, sizeof(ExprEvalStep));
 }
 
+/*
+ * Prepare once-per-execution evaluation of an expression whose value cannot
+ * change within a single execution of the plan, if node qualifies.
+ *
+ * Expressions such as "now() - interval '1 day'", possibly over bound
+ * PARAM_EXTERN parameters, are constant for the life of an executor
+ * invocation, but are re-evaluated for every row when they appear in a qual
+ * the planner could not fold: stable function calls can't be folded into a
+ * plan that may be cached and reused with a different snapshot, and a
+ * generic plan retains its Params.  For such expressions we push a single
+ * EEOP_STABLE_CONST step that computes the value on first use and replays
+ * the saved result afterwards, which recovers most of the benefit of
+ * custom-plan constant folding without re-planning.
+ *
+ * Returns true if an EEOP_STABLE_CONST step was pushed, or false if the
+ * node doesn't qualify and the caller should emit the ordinary opcode
+ * sequence instead.
+ */
+static bool
+ExecInitStableConstExpr(Expr *node, ExprState *state,
+						Datum *resv, bool *resnull)
+{
+	ExprEvalStep scratch = {0};
+	ExprEvalStep scratch2 = {0};
+	ExprState  *substate;
+	int16		typlen;
+	bool		typbyval;
+
+	/* don't recurse when already building such a subexpression */
+	if (state->flags & EEO_FLAG_STABLE_CONST_SUBEXPR)
+		return false;
+
+	/*
+	 * Restrict this to expressions belonging to a plan tree: the saved
+	 * result lives in the ExprState, so the ExprState must not outlive a
+	 * single executor invocation.  Standalone ExprStates can be kept around
+	 * longer than that (e.g. plpgsql caches simple-expression states for
+	 * the duration of a transaction), which would let a stale value of
+	 * statement_timestamp() and the like leak into a later statement.
+	 */
+	if (state->parent == NULL)
+		return false;
+
+	/*
+	 * Worth doing only if a stable function call is in there somewhere; a
+	 * fully immutable subexpression has been folded to a Const by the
+	 * planner already, or is too cheap to bother with.
+	 */
+	if (!contain_mutable_functions((Node *) node))
+		return false;
+
+	if (!is_stable_const_expression((Node *) node))
+		return false;
+
+	/* Build a standalone ExprState that computes the value on first use. */
+	substate = makeNode(ExprState);
+	substate->expr = node;
+	substate->parent = state->parent;
+	substate->ext_params = state->ext_params;
+	substate->flags = EEO_FLAG_STABLE_CONST_SUBEXPR;
+
+	ExecCreateExprSetupSteps(substate, (Node *) node);
+	ExecInitExprRec(node, substate, &substate->resvalue, &substate->resnull);
+	scratch2.opcode = EEOP_DONE_RETURN;
+	ExprEvalPushStep(substate, &scratch2);
+	ExecReadyExpr(substate);
+
+	/* Remember how to copy the result out of the per-tuple context. */
+	get_typlenbyval(exprType((Node *) node), &typlen, &typbyval);
+
+	scratch.opcode = EEOP_STABLE_CONST;
+	scratch.resvalue = resv;
+	scratch.resnull = resnull;
+	scratch.d.stableconst.exprstate = substate;
+	scratch.d.stableconst.evaluated = false;
+	scratch.d.stableconst.typlen = typlen;
+	scratch.d.stableconst.typbyval = typbyval;
+	ExprEvalPushStep(state, &scratch);
+
+	return true;
+}
+
 /*
  * Perform setup necessary for the evaluation of a function-like expression,
  * appending argument evaluation steps to the steps list in *state, and
@@ -2793,7 +2886,40 @@ ExecInitFunc(ExprEvalStep *scratch, Expr *node, List *args, Oid funcid,
 			if (nargs == 1)
 				scratch->opcode = EEOP_FUNCEXPR_STRICT_1;
 			else if (nargs == 2)
-				scratch->opcode = EEOP_FUNCEXPR_STRICT_2;
+			{
+				/*
+				 * A few builtin comparison functions are hot enough in
+				 * typical quals to deserve opcodes that evaluate the
+				 * comparison directly in the interpreter, avoiding
+				 * function-call overhead altogether.  fmgr resolves builtin
+				 * function OIDs from its constant builtins table, so the OID
+				 * determines exactly what would be called.
+				 */
+				switch (funcid)
+				{
+					case F_INT4EQ:
+						scratch->opcode = EEOP_FUNCEXPR_STRICT_INT4EQ;
+						break;
+					case F_INT4NE:
+						scratch->opcode = EEOP_FUNCEXPR_STRICT_INT4NE;
+						break;
+					case F_INT4LT:
+						scratch->opcode = EEOP_FUNCEXPR_STRICT_INT4LT;
+						break;
+					case F_INT4LE:
+						scratch->opcode = EEOP_FUNCEXPR_STRICT_INT4LE;
+						break;
+					case F_INT4GT:
+						scratch->opcode = EEOP_FUNCEXPR_STRICT_INT4GT;
+						break;
+					case F_INT4GE:
+						scratch->opcode = EEOP_FUNCEXPR_STRICT_INT4GE;
+						break;
+					default:
+						scratch->opcode = EEOP_FUNCEXPR_STRICT_2;
+						break;
+				}
+			}
 			else
 				scratch->opcode = EEOP_FUNCEXPR_STRICT;
 		}
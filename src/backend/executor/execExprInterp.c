@@ -59,6 +59,7 @@
 #include "access/heaptoast.h"
 #include "catalog/pg_type.h"
 #include "commands/sequence.h"
+#include "common/hashfn.h"
 #include "executor/execExpr.h"
 #include "executor/nodeSubplan.h"
 #include "funcapi.h"
@@ -161,6 +162,7 @@ static Datum ExecJustAssignInnerVar(ExprState *state, ExprContext *econtext, boo
 static Datum ExecJustAssignOuterVar(ExprState *state, ExprContext *econtext, bool *isnull);
 static Datum ExecJustAssignScanVar(ExprState *state, ExprContext *econtext, bool *isnull);
 static Datum ExecJustApplyFuncToCase(ExprState *state, ExprContext *econtext, bool *isnull);
+static Datum ExecJustScanQualStrict2(ExprState *state, ExprContext *econtext, bool *isnull);
 static Datum ExecJustConst(ExprState *state, ExprContext *econtext, bool *isnull);
 static Datum ExecJustInnerVarVirt(ExprState *state, ExprContext *econtext, bool *isnull);
 static Datum ExecJustOuterVarVirt(ExprState *state, ExprContext *econtext, bool *isnull);
@@ -280,7 +282,32 @@ ExecReadyInterpretedExpr(ExprState *state)
 	 * the full interpreter is a measurable overhead for these, and these
 	 * patterns occur often enough to be worth optimizing.
 	 */
-	if (state->steps_len == 5)
+	if (state->steps_len == 6)
+	{
+		ExprEvalOp	step0 = state->steps[0].opcode;
+		ExprEvalOp	step1 = state->steps[1].opcode;
+		ExprEvalOp	step2 = state->steps[2].opcode;
+		ExprEvalOp	step3 = state->steps[3].opcode;
+		ExprEvalOp	step4 = state->steps[4].opcode;
+
+		/*
+		 * A qual applying a single strict two-argument function to scan Vars
+		 * and/or Consts, e.g. a seqscan filter like "WHERE col < 42".  Such
+		 * quals run once per scanned tuple, so the interpreter's startup and
+		 * dispatch overhead is clearly measurable on filter-heavy scans.
+		 */
+		if (step0 == EEOP_SCAN_FETCHSOME &&
+			(step1 == EEOP_SCAN_VAR || step1 == EEOP_CONST) &&
+			(step2 == EEOP_SCAN_VAR || step2 == EEOP_CONST) &&
+			step3 == EEOP_FUNCEXPR_STRICT_2 &&
+			step4 == EEOP_QUAL &&
+			state->steps[4].d.qualexpr.jumpdone == 5)
+		{
+			state->evalfunc_private = ExecJustScanQualStrict2;
+			return;
+		}
+	}
+	else if (state->steps_len == 5)
 	{
 		ExprEvalOp	step0 = state->steps[0].opcode;
 		ExprEvalOp	step1 = state->steps[1].opcode;
@@ -446,6 +473,41 @@ ExecReadyInterpretedExpr(ExprState *state)
 	state->evalfunc_private = ExecInterpExpr;
 }
 
+/*
+ * ExecHashDatum
+ *		Invoke the hash function of a HASHDATUM step on a known-not-null
+ *		input and return the resulting hash value.
+ *
+ * The hash functions for the most common join and grouping key types are
+ * open-coded here to skip the indirect call and the callee's own call into
+ * hashfn.c.  Each open-coded path must produce exactly the same value as
+ * the corresponding SQL-callable function: cross-type hash opfamilies
+ * require hashint2, hashint4 and hashint8 to agree on logically equal
+ * inputs, which is why the int8 path folds the high half the same way
+ * hashint8() does before mixing.
+ */
+static pg_attribute_always_inline uint32
+ExecHashDatum(const ExprEvalStep *op, FunctionCallInfo fcinfo)
+{
+	PGFunction	fn_addr = op->d.hashdatum.fn_addr;
+
+	if (fn_addr == hashint4 || fn_addr == hashoid)
+		return hash_bytes_uint32_inlined((uint32) DatumGetInt32(fcinfo->args[0].value));
+
+	if (fn_addr == hashint8)
+	{
+		int64		val = DatumGetInt64(fcinfo->args[0].value);
+		uint32		lohalf = (uint32) val;
+		uint32		hihalf = (uint32) (val >> 32);
+
+		lohalf ^= (val >= 0) ? hihalf : ~hihalf;
+
+		return hash_bytes_uint32_inlined(lohalf);
+	}
+
+	return DatumGetUInt32(fn_addr(fcinfo));
+}
+
 
 /*
  * Evaluate expression identified by "state" in the execution context
@@ -502,6 +564,12 @@ ExecInterpExpr(ExprState *state, ExprContext *econtext, bool *isnull)
 		&&CASE_EEOP_FUNCEXPR_STRICT,
 		&&CASE_EEOP_FUNCEXPR_STRICT_1,
 		&&CASE_EEOP_FUNCEXPR_STRICT_2,
+		&&CASE_EEOP_FUNCEXPR_STRICT_INT4EQ,
+		&&CASE_EEOP_FUNCEXPR_STRICT_INT4NE,
+		&&CASE_EEOP_FUNCEXPR_STRICT_INT4LT,
+		&&CASE_EEOP_FUNCEXPR_STRICT_INT4LE,
+		&&CASE_EEOP_FUNCEXPR_STRICT_INT4GT,
+		&&CASE_EEOP_FUNCEXPR_STRICT_INT4GE,
 		&&CASE_EEOP_FUNCEXPR_FUSAGE,
 		&&CASE_EEOP_FUNCEXPR_STRICT_FUSAGE,
 		&&CASE_EEOP_BOOL_AND_STEP_FIRST,
@@ -537,6 +605,7 @@ ExecInterpExpr(ExprState *state, ExprContext *econtext, bool *isnull)
 		&&CASE_EEOP_NOT_DISTINCT,
 		&&CASE_EEOP_NULLIF,
 		&&CASE_EEOP_SQLVALUEFUNCTION,
+		&&CASE_EEOP_STABLE_CONST,
 		&&CASE_EEOP_CURRENTOFEXPR,
 		&&CASE_EEOP_NEXTVALUEEXPR,
 		&&CASE_EEOP_RETURNINGEXPR,
@@ -1006,6 +1075,67 @@ ExecInterpExpr(ExprState *state, ExprContext *econtext, bool *isnull)
 			EEO_NEXT();
 		}
 
+		/*
+		 * Dedicated implementations of the hottest builtin comparisons.
+		 * These behave exactly like EEOP_FUNCEXPR_STRICT_2 would with the
+		 * corresponding builtin, but dodge the function-call overhead, which
+		 * is a significant fraction of qual evaluation time in
+		 * comparison-heavy plans.  The implementations must track the
+		 * builtins exactly; execExpr.c selects these opcodes by function OID.
+		 */
+#define EEO_INT4_COMPARISON(CMP) \
+		do { \
+			NullableDatum *args = op->d.func.fcinfo_data->args; \
+			\
+			if (args[0].isnull || args[1].isnull) \
+				*op->resnull = true; \
+			else \
+			{ \
+				*op->resvalue = \
+					BoolGetDatum(DatumGetInt32(args[0].value) CMP \
+								 DatumGetInt32(args[1].value)); \
+				*op->resnull = false; \
+			} \
+		} while (0)
+
+		EEO_CASE(EEOP_FUNCEXPR_STRICT_INT4EQ)
+		{
+			EEO_INT4_COMPARISON(==);
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_FUNCEXPR_STRICT_INT4NE)
+		{
+			EEO_INT4_COMPARISON(!=);
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_FUNCEXPR_STRICT_INT4LT)
+		{
+			EEO_INT4_COMPARISON(<);
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_FUNCEXPR_STRICT_INT4LE)
+		{
+			EEO_INT4_COMPARISON(<=);
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_FUNCEXPR_STRICT_INT4GT)
+		{
+			EEO_INT4_COMPARISON(>);
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_FUNCEXPR_STRICT_INT4GE)
+		{
+			EEO_INT4_COMPARISON(>=);
+			EEO_NEXT();
+		}
+
+#undef EEO_INT4_COMPARISON
+
 		EEO_CASE(EEOP_FUNCEXPR_FUSAGE)
 		{
 			/* not common enough to inline */
@@ -1560,6 +1690,14 @@ ExecInterpExpr(ExprState *state, ExprContext *econtext, bool *isnull)
 			EEO_NEXT();
 		}
 
+		EEO_CASE(EEOP_STABLE_CONST)
+		{
+			/* too complex for an inline implementation */
+			ExecEvalStableConst(state, op, econtext);
+
+			EEO_NEXT();
+		}
+
 		EEO_CASE(EEOP_CURRENTOFEXPR)
 		{
 			/* error invocation uses space, and shouldn't ever occur */
@@ -1813,7 +1951,7 @@ ExecInterpExpr(ExprState *state, ExprContext *econtext, bool *isnull)
 			 * subsequent NEXT32 operations combine with an initialized value.
 			 */
 			if (!fcinfo->args[0].isnull)
-				*op->resvalue = op->d.hashdatum.fn_addr(fcinfo);
+				*op->resvalue = UInt32GetDatum(ExecHashDatum(op, fcinfo));
 			else
 				*op->resvalue = (Datum) 0;
 
@@ -1839,7 +1977,7 @@ ExecInterpExpr(ExprState *state, ExprContext *econtext, bool *isnull)
 			}
 
 			/* execute the hash function and save the resulting value */
-			*op->resvalue = op->d.hashdatum.fn_addr(fcinfo);
+			*op->resvalue = UInt32GetDatum(ExecHashDatum(op, fcinfo));
 			*op->resnull = false;
 
 			EEO_NEXT();
@@ -1860,7 +1998,7 @@ ExecInterpExpr(ExprState *state, ExprContext *econtext, bool *isnull)
 				uint32		hashvalue;
 
 				/* execute hash func and combine with previous hash value */
-				hashvalue = DatumGetUInt32(op->d.hashdatum.fn_addr(fcinfo));
+				hashvalue = ExecHashDatum(op, fcinfo);
 				existinghash = existinghash ^ hashvalue;
 			}
 
@@ -1895,7 +2033,7 @@ ExecInterpExpr(ExprState *state, ExprContext *econtext, bool *isnull)
 				existinghash = pg_rotate_left32(existinghash, 1);
 
 				/* execute hash func and combine with previous hash value */
-				hashvalue = DatumGetUInt32(op->d.hashdatum.fn_addr(fcinfo));
+				hashvalue = ExecHashDatum(op, fcinfo);
 				*op->resvalue = UInt32GetDatum(existinghash ^ hashvalue);
 				*op->resnull = false;
 			}
@@ -2664,6 +2802,57 @@ ExecJustApplyFuncToCase(ExprState *state, ExprContext *econtext, bool *isnull)
 	return d;
 }
 
+/* Evaluate a qual applying one strict 2-argument function to scan columns */
+static Datum
+ExecJustScanQualStrict2(ExprState *state, ExprContext *econtext, bool *isnull)
+{
+	TupleTableSlot *scanslot = econtext->ecxt_scantuple;
+	ExprEvalStep *fetchop = &state->steps[0];
+	ExprEvalStep *funcop = &state->steps[3];
+	FunctionCallInfo fcinfo = funcop->d.func.fcinfo_data;
+	NullableDatum *args = fcinfo->args;
+	Datum		d;
+
+	CheckOpSlotCompatibility(fetchop, scanslot);
+	slot_getsomeattrs(scanslot, fetchop->d.fetch.last_var);
+
+	/*
+	 * Steps 1 and 2 evaluate the function's arguments; each one is either a
+	 * scan Var or a Const, and stores through its own resvalue/resnull
+	 * pointers into the fcinfo, just as the interpreter would.
+	 */
+	for (int stepno = 1; stepno <= 2; stepno++)
+	{
+		ExprEvalStep *op = &state->steps[stepno];
+
+		if (op->opcode == EEOP_SCAN_VAR)
+		{
+			int			attnum = op->d.var.attnum;
+
+			Assert(attnum >= 0 && attnum < scanslot->tts_nvalid);
+			*op->resvalue = scanslot->tts_values[attnum];
+			*op->resnull = scanslot->tts_isnull[attnum];
+		}
+		else
+		{
+			Assert(op->opcode == EEOP_CONST);
+			*op->resvalue = op->d.constval.value;
+			*op->resnull = op->d.constval.isnull;
+		}
+	}
+
+	/* strict function, so check for NULL args; a NULL makes the qual fail */
+	*isnull = false;
+	if (args[0].isnull || args[1].isnull)
+		return BoolGetDatum(false);
+
+	fcinfo->isnull = false;
+	d = funcop->d.func.fn_addr(fcinfo);
+
+	/* EEOP_QUAL semantics: a NULL result is treated as FALSE */
+	return BoolGetDatum(!fcinfo->isnull && DatumGetBool(d));
+}
+
 /* Simple Const expression */
 static Datum
 ExecJustConst(ExprState *state, ExprContext *econtext, bool *isnull)
@@ -2788,7 +2977,7 @@ ExecJustHashInnerVarWithIV(ExprState *state, ExprContext *econtext,
 	{
 		uint32		hashvalue;
 
-		hashvalue = DatumGetUInt32(hashop->d.hashdatum.fn_addr(fcinfo));
+		hashvalue = ExecHashDatum(hashop, fcinfo);
 		hashkey = hashkey ^ hashvalue;
 	}
 
@@ -2815,7 +3004,7 @@ ExecJustHashVarImpl(ExprState *state, TupleTableSlot *slot, bool *isnull)
 	*isnull = false;
 
 	if (!fcinfo->args[0].isnull)
-		return DatumGetUInt32(hashop->d.hashdatum.fn_addr(fcinfo));
+		return UInt32GetDatum(ExecHashDatum(hashop, fcinfo));
 	else
 		return (Datum) 0;
 }
@@ -2849,7 +3038,7 @@ ExecJustHashVarVirtImpl(ExprState *state, TupleTableSlot *slot, bool *isnull)
 	*isnull = false;
 
 	if (!fcinfo->args[0].isnull)
-		return DatumGetUInt32(hashop->d.hashdatum.fn_addr(fcinfo));
+		return UInt32GetDatum(ExecHashDatum(hashop, fcinfo));
 	else
 		return (Datum) 0;
 }
@@ -2892,7 +3081,7 @@ ExecJustHashOuterVarStrict(ExprState *state, ExprContext *econtext,
 	if (!fcinfo->args[0].isnull)
 	{
 		*isnull = false;
-		return DatumGetUInt32(hashop->d.hashdatum.fn_addr(fcinfo));
+		return UInt32GetDatum(ExecHashDatum(hashop, fcinfo));
 	}
 	else
 	{
@@ -3249,6 +3438,41 @@ ExecEvalSQLValueFunction(ExprState *state, ExprEvalStep *op)
 	}
 }
 
+/*
+ * Evaluate an expression whose value cannot change within this execution of
+ * the plan, computing it on the first call and replaying the saved result
+ * on later ones.
+ *
+ * The saved datum has to survive resets of the per-tuple context, so a
+ * pass-by-reference result is copied into the per-query context.
+ */
+void
+ExecEvalStableConst(ExprState *state, ExprEvalStep *op, ExprContext *econtext)
+{
+	if (unlikely(!op->d.stableconst.evaluated))
+	{
+		Datum		value;
+		bool		isnull;
+
+		value = ExecEvalExprSwitchContext(op->d.stableconst.exprstate,
+										  econtext, &isnull);
+		if (!isnull && !op->d.stableconst.typbyval)
+		{
+			MemoryContext oldcontext;
+
+			oldcontext = MemoryContextSwitchTo(econtext->ecxt_per_query_memory);
+			value = datumCopy(value, false, op->d.stableconst.typlen);
+			MemoryContextSwitchTo(oldcontext);
+		}
+		op->d.stableconst.value = value;
+		op->d.stableconst.isnull = isnull;
+		op->d.stableconst.evaluated = true;
+	}
+
+	*op->resvalue = op->d.stableconst.value;
+	*op->resnull = op->d.stableconst.isnull;
+}
+
 /*
  * Raise error if a CURRENT OF expression is evaluated.
  *
@@ -37,6 +37,7 @@
  */
 #include "postgres.h"
 
+#include "access/parallel.h"
 #include "access/sysattr.h"
 #include "access/table.h"
 #include "access/tableam.h"
@@ -249,6 +250,15 @@ standard_ExecutorStart(QueryDesc *queryDesc, int eflags)
 	estate->es_instrument = queryDesc->instrument_options;
 	estate->es_jit_flags = queryDesc->plannedstmt->jitFlags;
 
+	/*
+	 * Enable sampling-based plan profiling, unless this is EXPLAIN-only mode
+	 * or a parallel worker (whose samples nobody would report).  This must
+	 * be decided before the plan state tree is initialized, since it
+	 * determines the choice of ExecProcNode wrappers.
+	 */
+	if (!(eflags & EXEC_FLAG_EXPLAIN_ONLY) && !IsParallelWorker())
+		estate->es_plan_profiling = InstrProfileStart(estate);
+
 	/*
 	 * Set up an AFTER-trigger statement context, unless told not to, or
 	 * unless it's EXPLAIN-only mode (when ExecutorFinish won't be called).
@@ -497,6 +507,10 @@ standard_ExecutorEnd(QueryDesc *queryDesc)
 	Assert(estate->es_finished ||
 		   (estate->es_top_eflags & EXEC_FLAG_EXPLAIN_ONLY));
 
+	/* stop sampling, if this query was being profiled */
+	if (estate->es_plan_profiling)
+		InstrProfileStop(estate);
+
 	/*
 	 * Switch into per-query memory context to run ExecEndPlan
 	 */
@@ -22,11 +22,13 @@
 #include "foreign/fdwapi.h"
 #include "mb/pg_wchar.h"
 #include "miscadmin.h"
+#include "nodes/nodeFuncs.h"
 #include "partitioning/partbounds.h"
 #include "partitioning/partdesc.h"
 #include "partitioning/partprune.h"
 #include "rewrite/rewriteManip.h"
 #include "utils/acl.h"
+#include "utils/datum.h"
 #include "utils/lsyscache.h"
 #include "utils/partcache.h"
 #include "utils/rls.h"
@@ -194,12 +196,37 @@ static void InitExecPartitionPruneContexts(PartitionPruneState *prunestate,
 										   PlanState *parent_plan,
 										   Bitmapset *initially_valid_subplans,
 										   int n_total_subplans);
+static void InitPartitionPruneParamMemo(PartitionPruneState *prunestate,
+										PartitionPruneInfo *pruneinfo);
+static bool PartitionPruneMemoUsable(PartitionPruneState *prunestate,
+									 bool *can_store);
 static void find_matching_subplans_recurse(PartitionPruningData *prunedata,
 										   PartitionedRelPruningData *pprune,
 										   bool initial_prune,
 										   Bitmapset **validsubplans,
 										   Bitmapset **validsubplan_rtis);
 
+/*
+ * Last-seen value of one of the PARAM_EXEC Params that exec-time pruning
+ * depends on, used to decide whether a previous pruning result can simply be
+ * reused.  The type information is needed to compare and copy saved datums.
+ */
+typedef struct PartitionParamMemo
+{
+	int			paramid;		/* PARAM_EXEC id */
+	int16		typlen;
+	bool		typbyval;
+	bool		isnull;			/* last-seen value of the Param */
+	Datum		value;
+} PartitionParamMemo;
+
+/* Working state for collect_pruning_param_types_walker */
+typedef struct CollectPruningParamTypesContext
+{
+	Bitmapset  *paramids;		/* the execparamids we care about */
+	Oid		   *paramtypes;		/* indexed by bms_member_index(paramids) */
+} CollectPruningParamTypesContext;
+
 
 /*
  * ExecSetupPartitionTupleRouting - sets up information needed during
@@ -2002,6 +2029,11 @@ CreatePartitionPruneState(EState *estate, PartitionPruneInfo *pruneinfo,
 	prunestate->other_subplans = bms_copy(pruneinfo->other_subplans);
 	prunestate->do_initial_prune = false;	/* may be set below */
 	prunestate->do_exec_prune = false;	/* may be set below */
+	prunestate->execparammemo = NULL;	/* may be set below */
+	prunestate->nexecparams = 0;
+	prunestate->memo_result = NULL;
+	prunestate->memo_valid = false;
+	prunestate->memo_cxt = CurrentMemoryContext;
 	prunestate->num_partprunedata = n_part_hierarchies;
 
 	/*
@@ -2224,9 +2256,192 @@ CreatePartitionPruneState(EState *estate, PartitionPruneInfo *pruneinfo,
 		i++;
 	}
 
+	/*
+	 * If exec-time pruning will happen, set up for memoizing its results by
+	 * Param value.
+	 */
+	if (prunestate->do_exec_prune &&
+		!bms_is_empty(prunestate->execparamids))
+		InitPartitionPruneParamMemo(prunestate, pruneinfo);
+
 	return prunestate;
 }
 
+/*
+ * collect_pruning_param_types_walker
+ *		Record the type of each PARAM_EXEC Param of interest appearing in
+ *		an exec pruning step's expressions.
+ */
+static bool
+collect_pruning_param_types_walker(Node *node,
+								   CollectPruningParamTypesContext *context)
+{
+	if (node == NULL)
+		return false;
+	if (IsA(node, Param))
+	{
+		Param	   *param = (Param *) node;
+
+		if (param->paramkind == PARAM_EXEC)
+		{
+			int			idx = bms_member_index(context->paramids,
+											   param->paramid);
+
+			if (idx >= 0)
+				context->paramtypes[idx] = param->paramtype;
+		}
+		return false;
+	}
+	return expression_tree_walker(node, collect_pruning_param_types_walker,
+								  context);
+}
+
+/*
+ * InitPartitionPruneParamMemo
+ *		Set up for memoizing exec-time pruning results by Param value.
+ *
+ * We need the type of each Param in prunestate->execparamids so that saved
+ * datums can be compared and copied; dig those out of the Params appearing
+ * in the exec pruning steps.  If any can't be found (which shouldn't
+ * happen), just leave execparammemo NULL, disabling memoization.
+ */
+static void
+InitPartitionPruneParamMemo(PartitionPruneState *prunestate,
+							PartitionPruneInfo *pruneinfo)
+{
+	CollectPruningParamTypesContext context;
+	PartitionParamMemo *memo;
+	int			nparams = bms_num_members(prunestate->execparamids);
+	int			paramid;
+	int			i;
+	ListCell   *lc;
+
+	context.paramids = prunestate->execparamids;
+	context.paramtypes = (Oid *) palloc0(nparams * sizeof(Oid));
+
+	foreach(lc, pruneinfo->prune_infos)
+	{
+		List	   *partrelpruneinfos = lfirst_node(List, lc);
+		ListCell   *lc2;
+
+		foreach(lc2, partrelpruneinfos)
+		{
+			PartitionedRelPruneInfo *pinfo = lfirst_node(PartitionedRelPruneInfo, lc2);
+			ListCell   *lc3;
+
+			foreach(lc3, pinfo->exec_pruning_steps)
+			{
+				PartitionPruneStep *step = lfirst(lc3);
+
+				if (IsA(step, PartitionPruneStepOp))
+					collect_pruning_param_types_walker((Node *) ((PartitionPruneStepOp *) step)->exprs,
+													   &context);
+			}
+		}
+	}
+
+	for (i = 0; i < nparams; i++)
+	{
+		if (!OidIsValid(context.paramtypes[i]))
+		{
+			pfree(context.paramtypes);
+			return;
+		}
+	}
+
+	memo = (PartitionParamMemo *) palloc0(nparams * sizeof(PartitionParamMemo));
+	i = 0;
+	paramid = -1;
+	while ((paramid = bms_next_member(prunestate->execparamids, paramid)) >= 0)
+	{
+		memo[i].paramid = paramid;
+		get_typlenbyval(context.paramtypes[i],
+						&memo[i].typlen, &memo[i].typbyval);
+		memo[i].isnull = true;
+		i++;
+	}
+	Assert(i == nparams);
+
+	prunestate->execparammemo = memo;
+	prunestate->nexecparams = nparams;
+	pfree(context.paramtypes);
+}
+
+/*
+ * PartitionPruneMemoUsable
+ *		Check whether the memoized exec-pruning result is still good, i.e.
+ *		whether all Params it depends on still have the values they had when
+ *		it was computed.
+ *
+ * If not, remember the current values, so that the result about to be
+ * computed for them can be reused next time.  *can_store is set to true if
+ * that was possible, telling the caller to memoize the new result; if any
+ * Param is the not-yet-evaluated output of a subplan, we can't know what
+ * value the pruning expressions will see, so neither reuse nor storing is
+ * safe and *can_store is set to false.
+ */
+static bool
+PartitionPruneMemoUsable(PartitionPruneState *prunestate, bool *can_store)
+{
+	EState	   *estate = prunestate->econtext->ecxt_estate;
+	bool		match = prunestate->memo_valid;
+	MemoryContext oldcontext;
+	int			i;
+
+	*can_store = false;
+
+	for (i = 0; i < prunestate->nexecparams; i++)
+	{
+		PartitionParamMemo *memo = &prunestate->execparammemo[i];
+		ParamExecData *prm = &estate->es_param_exec_vals[memo->paramid];
+
+		/*
+		 * If the Param is the output of a not-yet-evaluated subplan, its
+		 * stored value is stale; evaluation happens only when the pruning
+		 * expressions are run, so don't attempt to memoize on it.
+		 */
+		if (prm->execPlan != NULL)
+		{
+			prunestate->memo_valid = false;
+			return false;
+		}
+
+		if (match &&
+			(prm->isnull != memo->isnull ||
+			 (!prm->isnull &&
+			  !datumIsEqual(prm->value, memo->value,
+							memo->typbyval, memo->typlen))))
+			match = false;
+	}
+
+	if (match)
+		return true;
+
+	/* Remember the current values for next time. */
+	oldcontext = MemoryContextSwitchTo(prunestate->memo_cxt);
+	for (i = 0; i < prunestate->nexecparams; i++)
+	{
+		PartitionParamMemo *memo = &prunestate->execparammemo[i];
+		ParamExecData *prm = &estate->es_param_exec_vals[memo->paramid];
+
+		if (!memo->typbyval && !memo->isnull &&
+			DatumGetPointer(memo->value) != NULL)
+			pfree(DatumGetPointer(memo->value));
+		memo->isnull = prm->isnull;
+		if (prm->isnull)
+			memo->value = (Datum) 0;
+		else
+			memo->value = datumCopy(prm->value, memo->typbyval, memo->typlen);
+	}
+	MemoryContextSwitchTo(oldcontext);
+
+	/* result for these values not computed yet */
+	prunestate->memo_valid = false;
+	*can_store = true;
+
+	return false;
+}
+
 /*
  * Initialize a PartitionPruneContext for the given list of pruning steps.
  */
@@ -2496,6 +2711,7 @@ ExecFindMatchingSubPlans(PartitionPruneState *prunestate,
 {
 	Bitmapset  *result = NULL;
 	MemoryContext oldcontext;
+	bool		memo_store = false;
 	int			i;
 
 	/*
@@ -2506,6 +2722,21 @@ ExecFindMatchingSubPlans(PartitionPruneState *prunestate,
 	Assert(initial_prune || prunestate->do_exec_prune);
 	Assert(validsubplan_rtis != NULL || !initial_prune);
 
+	/*
+	 * During exec pruning, the comparison expressions are functions of the
+	 * Params in execparamids, so if none of those have changed value since
+	 * the last time we pruned, the previous result is still good.  This is
+	 * common in nested loops whose outer side produces duplicate values: the
+	 * parent node re-prunes whenever its chgParam overlaps execparamids,
+	 * which says nothing about whether the values actually differ.
+	 */
+	if (!initial_prune && validsubplan_rtis == NULL &&
+		prunestate->execparammemo != NULL)
+	{
+		if (PartitionPruneMemoUsable(prunestate, &memo_store))
+			return bms_copy(prunestate->memo_result);
+	}
+
 	/*
 	 * Switch to a temp context to avoid leaking memory in the executor's
 	 * query-lifespan memory context.
@@ -2551,6 +2782,16 @@ ExecFindMatchingSubPlans(PartitionPruneState *prunestate,
 
 	MemoryContextReset(prunestate->prune_context);
 
+	/* Memoize the result for the Param values saved above */
+	if (memo_store)
+	{
+		MemoryContextSwitchTo(prunestate->memo_cxt);
+		bms_free(prunestate->memo_result);
+		prunestate->memo_result = bms_copy(result);
+		prunestate->memo_valid = true;
+		MemoryContextSwitchTo(oldcontext);
+	}
+
 	return result;
 }
 
@@ -121,6 +121,7 @@
 
 static TupleTableSlot *ExecProcNodeFirst(PlanState *node);
 static TupleTableSlot *ExecProcNodeInstr(PlanState *node);
+static TupleTableSlot *ExecProcNodeProfile(PlanState *node);
 static bool ExecShutdownNode_walker(PlanState *node, void *context);
 
 
@@ -457,12 +458,15 @@ ExecProcNodeFirst(PlanState *node)
 	check_stack_depth();
 
 	/*
-	 * If instrumentation is required, change the wrapper to one that just
-	 * does instrumentation.  Otherwise we can dispense with all wrappers and
-	 * have ExecProcNode() directly call the relevant function from now on.
+	 * If instrumentation or sample profiling is required, change the wrapper
+	 * to one that performs just that.  Otherwise we can dispense with all
+	 * wrappers and have ExecProcNode() directly call the relevant function
+	 * from now on.
 	 */
 	if (node->instrument)
 		node->ExecProcNode = ExecProcNodeInstr;
+	else if (node->state->es_plan_profiling)
+		node->ExecProcNode = ExecProcNodeProfile;
 	else
 		node->ExecProcNode = node->ExecProcNodeReal;
 
@@ -480,6 +484,24 @@ ExecProcNodeInstr(PlanState *node)
 {
 	TupleTableSlot *result;
 
+	if (node->state->es_plan_profiling)
+	{
+		/* as in ExecProcNodeProfile, but with instrumentation as well */
+		int			save_id = InstrProfileCurrentId;
+
+		InstrProfileCurrentId = node->plan->plan_node_id + 1;
+
+		InstrStartNode(node->instrument);
+
+		result = node->ExecProcNodeReal(node);
+
+		InstrStopNode(node->instrument, TupIsNull(result) ? 0.0 : 1.0);
+
+		InstrProfileCurrentId = save_id;
+
+		return result;
+	}
+
 	InstrStartNode(node->instrument);
 
 	result = node->ExecProcNodeReal(node);
@@ -490,6 +512,29 @@ ExecProcNodeInstr(PlanState *node)
 }
 
 
+/*
+ * ExecProcNode wrapper that attributes profile samples to the node.  While
+ * the node function runs, the profiling timeout handler charges any ticks
+ * to this node, except during the execution of a child node, which installs
+ * its own id.  The id is restored, not cleared, on exit, so that time spent
+ * in a parent node after a child returns is charged to the parent again.
+ */
+static TupleTableSlot *
+ExecProcNodeProfile(PlanState *node)
+{
+	TupleTableSlot *result;
+	int			save_id = InstrProfileCurrentId;
+
+	InstrProfileCurrentId = node->plan->plan_node_id + 1;
+
+	result = node->ExecProcNodeReal(node);
+
+	InstrProfileCurrentId = save_id;
+
+	return result;
+}
+
+
 /* ----------------------------------------------------------------
  *		MultiExecProcNode
  *
@@ -977,6 +1022,28 @@ ExecSetTupleBound(int64 tuples_needed, PlanState *child_node)
 
 		ExecSetTupleBound(tuples_needed, outerPlanState(child_node));
 	}
+	else if (IsA(child_node, AggState))
+	{
+		/*
+		 * A hashed Agg computing no aggregate functions and applying no qual
+		 * -- a hashed DISTINCT -- returns one tuple per group and needs to
+		 * build no more groups than the number of tuples demanded, since
+		 * further input can only create new groups, never change an existing
+		 * one.  Tell it to stop filling the hash table at that many groups.
+		 * The bound cannot be propagated to the Agg's child, though.
+		 *
+		 * Note: as with Sort, nodeAgg.c is responsible for reacting properly
+		 * to changes of this parameter.
+		 */
+		AggState   *aggstate = (AggState *) child_node;
+		Agg		   *aggnode = (Agg *) child_node->plan;
+
+		if (aggstate->aggstrategy == AGG_HASHED &&
+			aggstate->numaggs == 0 &&
+			aggnode->plan.qual == NIL &&
+			aggnode->groupingSets == NIL)
+			aggstate->hash_group_bound = tuples_needed;
+	}
 
 	/*
 	 * In principle we could descend through any plan node type that is
@@ -504,7 +504,7 @@ ExecMakeFunctionResultSet(SetExprState *fcache,
 	Datum		result;
 	FunctionCallInfo fcinfo;
 	PgStat_FunctionCallUsage fcusage;
-	ReturnSetInfo rsinfo;
+	ReturnSetInfo *rsinfo;
 	bool		callit;
 	int			i;
 
@@ -575,58 +575,63 @@ restart:
 
 		ExecEvalFuncArgs(fcinfo, arguments, econtext);
 		MemoryContextSwitchTo(oldContext);
+
+		/*
+		 * If function is strict, and there are any NULL arguments, skip
+		 * calling the function.
+		 */
+		callit = true;
+		if (fcache->func.fn_strict)
+		{
+			for (i = 0; i < fcinfo->nargs; i++)
+			{
+				if (fcinfo->args[i].isnull)
+				{
+					callit = false;
+					break;
+				}
+			}
+		}
 	}
 	else
 	{
 		/* Reset flag (we may set it again below) */
 		fcache->setArgsValid = false;
+
+		/*
+		 * The saved arguments are the very ones the previous call was made
+		 * with, so don't repeat the strict-function check: had it failed, no
+		 * call series would be in progress.
+		 */
+		callit = true;
 	}
 
 	/*
 	 * Now call the function, passing the evaluated parameter values.
+	 *
+	 * The constant fields of the resultinfo node were filled in by
+	 * init_sexpr; we only reset the per-call ones.
 	 */
-
-	/* Prepare a resultinfo node for communication. */
-	fcinfo->resultinfo = (Node *) &rsinfo;
-	rsinfo.type = T_ReturnSetInfo;
-	rsinfo.econtext = econtext;
-	rsinfo.expectedDesc = fcache->funcResultDesc;
-	rsinfo.allowedModes = (int) (SFRM_ValuePerCall | SFRM_Materialize);
-	/* note we do not set SFRM_Materialize_Random or _Preferred */
-	rsinfo.returnMode = SFRM_ValuePerCall;
+	rsinfo = &fcache->rsinfo;
+	fcinfo->resultinfo = (Node *) rsinfo;
+	rsinfo->econtext = econtext;
+	rsinfo->returnMode = SFRM_ValuePerCall;
 	/* isDone is filled below */
-	rsinfo.setResult = NULL;
-	rsinfo.setDesc = NULL;
-
-	/*
-	 * If function is strict, and there are any NULL arguments, skip calling
-	 * the function.
-	 */
-	callit = true;
-	if (fcache->func.fn_strict)
-	{
-		for (i = 0; i < fcinfo->nargs; i++)
-		{
-			if (fcinfo->args[i].isnull)
-			{
-				callit = false;
-				break;
-			}
-		}
-	}
+	rsinfo->setResult = NULL;
+	rsinfo->setDesc = NULL;
 
 	if (callit)
 	{
 		pgstat_init_function_usage(fcinfo, &fcusage);
 
 		fcinfo->isnull = false;
-		rsinfo.isDone = ExprSingleResult;
+		rsinfo->isDone = ExprSingleResult;
 		result = FunctionCallInvoke(fcinfo);
 		*isNull = fcinfo->isnull;
-		*isDone = rsinfo.isDone;
+		*isDone = rsinfo->isDone;
 
 		pgstat_end_function_usage(&fcusage,
-								  rsinfo.isDone != ExprMultipleResult);
+								  rsinfo->isDone != ExprMultipleResult);
 	}
 	else
 	{
@@ -637,7 +642,7 @@ restart:
 	}
 
 	/* Which protocol does function want to use? */
-	if (rsinfo.returnMode == SFRM_ValuePerCall)
+	if (rsinfo->returnMode == SFRM_ValuePerCall)
 	{
 		if (*isDone != ExprEndResult)
 		{
@@ -658,19 +663,19 @@ restart:
 			}
 		}
 	}
-	else if (rsinfo.returnMode == SFRM_Materialize)
+	else if (rsinfo->returnMode == SFRM_Materialize)
 	{
 		/* check we're on the same page as the function author */
-		if (rsinfo.isDone != ExprSingleResult)
+		if (rsinfo->isDone != ExprSingleResult)
 			ereport(ERROR,
 					(errcode(ERRCODE_E_R_I_E_SRF_PROTOCOL_VIOLATED),
 					 errmsg("table-function protocol for materialize mode was not followed")));
-		if (rsinfo.setResult != NULL)
+		if (rsinfo->setResult != NULL)
 		{
 			/* prepare to return values from the tuplestore */
 			ExecPrepareTuplestoreResult(fcache, econtext,
-										rsinfo.setResult,
-										rsinfo.setDesc);
+										rsinfo->setResult,
+										rsinfo->setDesc);
 			/* loop back to top to start returning from tuplestore */
 			goto restart;
 		}
@@ -683,7 +688,7 @@ restart:
 		ereport(ERROR,
 				(errcode(ERRCODE_E_R_I_E_SRF_PROTOCOL_VIOLATED),
 				 errmsg("unrecognized table-function returnMode: %d",
-						(int) rsinfo.returnMode)));
+						(int) rsinfo->returnMode)));
 
 	return result;
 }
@@ -796,6 +801,15 @@ init_sexpr(Oid foid, Oid input_collation, Expr *node,
 	else
 		sexpr->funcResultDesc = NULL;
 
+	/*
+	 * Initialize the parts of the ReturnSetInfo that don't change from one
+	 * call to the next; ExecMakeFunctionResultSet fills in the rest.
+	 */
+	sexpr->rsinfo.type = T_ReturnSetInfo;
+	sexpr->rsinfo.expectedDesc = sexpr->funcResultDesc;
+	sexpr->rsinfo.allowedModes = (int) (SFRM_ValuePerCall | SFRM_Materialize);
+	/* note we do not set SFRM_Materialize_Random or _Preferred */
+
 	/* Initialize additional state */
 	sexpr->funcResultStore = NULL;
 	sexpr->funcResultSlot = NULL;
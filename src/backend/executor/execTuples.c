@@ -309,6 +309,127 @@ tts_virtual_copy_minimal_tuple(TupleTableSlot *slot, Size extra)
 }
 
 
+/*
+ * TupleTableSlotOps implementation for ColumnarTupleTableSlot.
+ *
+ * A columnar slot stores a batch of tuples in column-major order and exposes
+ * one of them at a time through the regular slot protocol.  Gathering the
+ * current row happens lazily in getsomeattrs, so consumers that touch only a
+ * few attributes never pay for the rest.  Once a row has been gathered the
+ * slot behaves exactly like a virtual slot, which lets several callbacks
+ * delegate to the tts_virtual_* implementations above.
+ */
+
+static void
+tts_columnar_init(TupleTableSlot *slot)
+{
+	/* column arrays are allocated on first ExecColumnarAllocBatch call */
+}
+
+static void
+tts_columnar_release(TupleTableSlot *slot)
+{
+	ColumnarTupleTableSlot *cslot = (ColumnarTupleTableSlot *) slot;
+	TupleDesc	desc = slot->tts_tupleDescriptor;
+
+	if (cslot->colvalues != NULL)
+	{
+		for (int natt = 0; natt < desc->natts; natt++)
+		{
+			pfree(cslot->colvalues[natt]);
+			pfree(cslot->colnulls[natt]);
+		}
+		pfree(cslot->colvalues);
+		pfree(cslot->colnulls);
+		cslot->colvalues = NULL;
+		cslot->colnulls = NULL;
+	}
+}
+
+static void
+tts_columnar_clear(TupleTableSlot *slot)
+{
+	ColumnarTupleTableSlot *cslot = (ColumnarTupleTableSlot *) slot;
+
+	/* frees any materialized data; batch arrays are kept for reuse */
+	tts_virtual_clear(slot);
+
+	cslot->nrows = 0;
+	cslot->currow = 0;
+}
+
+static void
+tts_columnar_getsomeattrs(TupleTableSlot *slot, int natts)
+{
+	ColumnarTupleTableSlot *cslot = (ColumnarTupleTableSlot *) slot;
+	int			currow = cslot->currow;
+
+	Assert(!TTS_EMPTY(slot));
+	Assert(currow >= 0 && currow < cslot->nrows);
+
+	for (int natt = slot->tts_nvalid; natt < natts; natt++)
+	{
+		slot->tts_values[natt] = cslot->colvalues[natt][currow];
+		slot->tts_isnull[natt] = cslot->colnulls[natt][currow];
+	}
+
+	slot->tts_nvalid = natts;
+}
+
+static void
+tts_columnar_materialize(TupleTableSlot *slot)
+{
+	/*
+	 * Gather the current row, then copy any byref datums into slot-local
+	 * storage the same way a virtual slot would.  The batch arrays may still
+	 * point elsewhere afterwards, but they are not consulted again for
+	 * already-gathered attributes.
+	 */
+	slot_getallattrs(slot);
+	tts_virtual_materialize(slot);
+}
+
+static void
+tts_columnar_copyslot(TupleTableSlot *dstslot, TupleTableSlot *srcslot)
+{
+	ColumnarTupleTableSlot *dcslot = (ColumnarTupleTableSlot *) dstslot;
+
+	/*
+	 * The copied row is stored in gathered (virtual) form; the destination's
+	 * batch, if any, is discarded.
+	 */
+	tts_virtual_copyslot(dstslot, srcslot);
+
+	dcslot->nrows = 0;
+	dcslot->currow = 0;
+}
+
+static HeapTuple
+tts_columnar_copy_heap_tuple(TupleTableSlot *slot)
+{
+	Assert(!TTS_EMPTY(slot));
+
+	slot_getallattrs(slot);
+
+	return heap_form_tuple(slot->tts_tupleDescriptor,
+						   slot->tts_values,
+						   slot->tts_isnull);
+}
+
+static MinimalTuple
+tts_columnar_copy_minimal_tuple(TupleTableSlot *slot, Size extra)
+{
+	Assert(!TTS_EMPTY(slot));
+
+	slot_getallattrs(slot);
+
+	return heap_form_minimal_tuple(slot->tts_tupleDescriptor,
+								   slot->tts_values,
+								   slot->tts_isnull,
+								   extra);
+}
+
+
 /*
  * TupleTableSlotOps implementation for HeapTupleTableSlot.
  */
@@ -1148,6 +1269,55 @@ slot_deform_heap_tuple(TupleTableSlot *slot, HeapTuple tuple, uint32 *offp,
 		slow = TTS_SLOW(slot);
 	}
 
+	/*
+	 * Fast path for the common OLTP case: no NULLs in the tuple and the
+	 * offsets of all requested attributes already known to be fixed.  If the
+	 * last requested attribute has a cached offset then every prior
+	 * attribute must be fixed-width with a cached offset too, since
+	 * attcacheoff is only ever filled in for attributes at fixed offsets.
+	 * That lets us fetch each attribute at its known offset in a tight loop
+	 * with no per-attribute alignment, length, or null checks.
+	 */
+	if (attnum == 0 && !hasnulls && natts > 0)
+	{
+		TupleDesc	tupleDesc = slot->tts_tupleDescriptor;
+		CompactAttribute *lastatt = TupleDescCompactAttr(tupleDesc, natts - 1);
+
+		if (lastatt->attcacheoff >= 0)
+		{
+			Datum	   *values = slot->tts_values;
+			bool	   *isnull = slot->tts_isnull;
+			char	   *tp = (char *) tuple->t_data + tuple->t_data->t_hoff;
+
+			for (int i = 0; i < natts; i++)
+			{
+				CompactAttribute *thisatt = TupleDescCompactAttr(tupleDesc, i);
+
+				values[i] = fetchatt(thisatt, tp + thisatt->attcacheoff);
+				isnull[i] = false;
+			}
+
+			/* Save state in case more attributes are wanted later */
+			off = lastatt->attcacheoff;
+			if (lastatt->attlen > 0)
+				off += lastatt->attlen;
+			else
+			{
+				/* final attribute is variable-width; further work is slow */
+				off = att_addlength_pointer(off, lastatt->attlen, tp + off);
+				slow = true;
+			}
+
+			slot->tts_nvalid = natts;
+			*offp = off;
+			if (slow)
+				slot->tts_flags |= TTS_FLAG_SLOW;
+			else
+				slot->tts_flags &= ~TTS_FLAG_SLOW;
+			return;
+		}
+	}
+
 	/*
 	 * If 'slow' isn't set, try deforming using deforming code that does not
 	 * contain any of the extra checks required for non-fixed offset
@@ -1228,6 +1398,27 @@ const TupleTableSlotOps TTSOpsVirtual = {
 	.copy_minimal_tuple = tts_virtual_copy_minimal_tuple
 };
 
+const TupleTableSlotOps TTSOpsColumnar = {
+	.base_slot_size = sizeof(ColumnarTupleTableSlot),
+	.init = tts_columnar_init,
+	.release = tts_columnar_release,
+	.clear = tts_columnar_clear,
+	.getsomeattrs = tts_columnar_getsomeattrs,
+	.getsysattr = tts_virtual_getsysattr,
+	.materialize = tts_columnar_materialize,
+	.is_current_xact_tuple = tts_virtual_is_current_xact_tuple,
+	.copyslot = tts_columnar_copyslot,
+
+	/*
+	 * Like a virtual slot, a columnar slot can not "own" a heap tuple or a
+	 * minimal tuple.
+	 */
+	.get_heap_tuple = NULL,
+	.get_minimal_tuple = NULL,
+	.copy_heap_tuple = tts_columnar_copy_heap_tuple,
+	.copy_minimal_tuple = tts_columnar_copy_minimal_tuple
+};
+
 const TupleTableSlotOps TTSOpsHeapTuple = {
 	.base_slot_size = sizeof(HeapTupleTableSlot),
 	.init = tts_heap_init,
@@ -1784,6 +1975,103 @@ ExecStoreAllNullTuple(TupleTableSlot *slot)
 	return ExecStoreVirtualTuple(slot);
 }
 
+/* --------------------------------
+ *		ExecColumnarAllocBatch
+ *			Size a columnar slot's batch storage for up to maxrows tuples.
+ *
+ * The per-attribute arrays are allocated in the slot's memory context and
+ * kept across ExecClearTuple calls, so a scan node can size the batch once
+ * and refill it for each new page or chunk of tuples.
+ * --------------------------------
+ */
+void
+ExecColumnarAllocBatch(TupleTableSlot *slot, int maxrows)
+{
+	ColumnarTupleTableSlot *cslot = (ColumnarTupleTableSlot *) slot;
+	TupleDesc	desc = slot->tts_tupleDescriptor;
+	MemoryContext oldcontext;
+
+	Assert(TTS_IS_COLUMNAR(slot));
+	Assert(desc != NULL);
+	Assert(maxrows > 0);
+
+	if (cslot->colvalues != NULL && cslot->maxrows >= maxrows)
+		return;
+
+	tts_columnar_release(slot);
+
+	oldcontext = MemoryContextSwitchTo(slot->tts_mcxt);
+
+	cslot->colvalues = (Datum **) palloc(desc->natts * sizeof(Datum *));
+	cslot->colnulls = (bool **) palloc(desc->natts * sizeof(bool *));
+	for (int natt = 0; natt < desc->natts; natt++)
+	{
+		cslot->colvalues[natt] = (Datum *) palloc(maxrows * sizeof(Datum));
+		cslot->colnulls[natt] = (bool *) palloc(maxrows * sizeof(bool));
+	}
+	cslot->maxrows = maxrows;
+
+	MemoryContextSwitchTo(oldcontext);
+}
+
+/* --------------------------------
+ *		ExecStoreColumnarBatch
+ *			Mark a columnar slot as containing a batch of nrows tuples.
+ *
+ * The protocol for loading a columnar slot is:
+ *		* Call ExecClearTuple to mark the slot empty.
+ *		* Call ExecColumnarAllocBatch if the batch may have grown.
+ *		* Store data into the per-attribute colvalues/colnulls arrays.
+ *		* Call ExecStoreColumnarBatch to mark the slot valid.
+ * The slot then exposes the batch's first row; use ExecColumnarNextRow to
+ * step through the remainder.
+ * --------------------------------
+ */
+TupleTableSlot *
+ExecStoreColumnarBatch(TupleTableSlot *slot, int nrows)
+{
+	ColumnarTupleTableSlot *cslot = (ColumnarTupleTableSlot *) slot;
+
+	Assert(TTS_IS_COLUMNAR(slot));
+	Assert(TTS_EMPTY(slot));
+	Assert(nrows > 0 && nrows <= cslot->maxrows);
+
+	cslot->nrows = nrows;
+	cslot->currow = 0;
+
+	slot->tts_flags &= ~TTS_FLAG_EMPTY;
+	slot->tts_nvalid = 0;
+
+	return slot;
+}
+
+/* --------------------------------
+ *		ExecColumnarNextRow
+ *			Advance a columnar slot to the next row of its batch.
+ *
+ * Returns false when the batch is exhausted, leaving the slot positioned on
+ * its last row.  The caller must not have materialized the slot, since the
+ * gathered row would then no longer track the cursor.
+ * --------------------------------
+ */
+bool
+ExecColumnarNextRow(TupleTableSlot *slot)
+{
+	ColumnarTupleTableSlot *cslot = (ColumnarTupleTableSlot *) slot;
+
+	Assert(TTS_IS_COLUMNAR(slot));
+	Assert(!TTS_EMPTY(slot));
+	Assert(!TTS_SHOULDFREE(slot));
+
+	if (cslot->currow + 1 >= cslot->nrows)
+		return false;
+
+	cslot->currow++;
+	slot->tts_nvalid = 0;
+
+	return true;
+}
+
 /*
  * Store a HeapTuple in datum form, into a slot. That always requires
  * deforming it and storing it in virtual form.
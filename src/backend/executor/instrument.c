@@ -16,14 +16,27 @@
 #include <unistd.h>
 
 #include "executor/instrument.h"
+#include "utils/timeout.h"
+#include "utils/timestamp.h"
 
 BufferUsage pgBufferUsage;
 static BufferUsage save_pgBufferUsage;
 WalUsage	pgWalUsage;
 static WalUsage save_pgWalUsage;
 
+/* GUC: sampling interval for plan profiling, in ms; 0 disables it */
+int			plan_profile_interval = 0;
+
+/* plan_node_id + 1 of the node being executed, or 0; see instrument.h */
+volatile int InstrProfileCurrentId = 0;
+
+static uint64 profile_samples[INSTR_PROFILE_MAX_NODES];
+static const void *profile_owner = NULL;
+static bool profile_timeout_registered = false;
+
 static void BufferUsageAdd(BufferUsage *dst, const BufferUsage *add);
 static void WalUsageAdd(WalUsage *dst, WalUsage *add);
+static void InstrProfileTimeoutHandler(void);
 
 
 /* Allocate new instrumentation structure(s) */
@@ -291,3 +304,100 @@ WalUsageAccumDiff(WalUsage *dst, const WalUsage *add, const WalUsage *sub)
 	dst->wal_fpi += add->wal_fpi - sub->wal_fpi;
 	dst->wal_buffers_full += add->wal_buffers_full - sub->wal_buffers_full;
 }
+
+/*
+ * Sampling-based plan profiling
+ *
+ * While a query runs with plan_profile_interval > 0, a repeating timeout
+ * charges each tick to the plan node identified by InstrProfileCurrentId,
+ * which the ExecProcNode wrappers in execProcnode.c keep up to date.  The
+ * sample counts per node, times the interval, approximate where the
+ * query's time went without any per-tuple clock readings.
+ *
+ * The counters are plain static memory: the timeout handler runs in signal
+ * context and so must not touch anything that could be freed under it.
+ * Only one query at a time is profiled; nested queries (SPI) have their
+ * time charged to the calling node of the outer query, which is normally
+ * what one wants to see.
+ */
+
+/*
+ * Timeout handler: charge one tick to the currently executing node.
+ */
+static void
+InstrProfileTimeoutHandler(void)
+{
+	int			id = InstrProfileCurrentId;
+
+	if (id > 0 && id <= INSTR_PROFILE_MAX_NODES)
+		profile_samples[id - 1]++;
+}
+
+/*
+ * Start profiling on behalf of the given owner (the query's EState), unless
+ * profiling is disabled or another query is already being profiled.
+ * Returns true if sampling is now active for this owner.
+ */
+bool
+InstrProfileStart(const void *owner)
+{
+	if (plan_profile_interval <= 0)
+		return false;
+
+	if (profile_owner != NULL)
+	{
+		/*
+		 * If the timeout is still ticking, some outer query owns the
+		 * profiler.  Otherwise the previous owner was torn down by error
+		 * recovery (which disables all timeouts) without reaching
+		 * InstrProfileStop(), and we can take over.
+		 */
+		if (get_timeout_active(PLAN_PROFILE_TIMEOUT))
+			return false;
+		profile_owner = NULL;
+	}
+
+	if (!profile_timeout_registered)
+	{
+		RegisterTimeout(PLAN_PROFILE_TIMEOUT, InstrProfileTimeoutHandler);
+		profile_timeout_registered = true;
+	}
+
+	memset(profile_samples, 0, sizeof(profile_samples));
+	InstrProfileCurrentId = 0;
+	profile_owner = owner;
+
+	enable_timeout_every(PLAN_PROFILE_TIMEOUT,
+						 TimestampTzPlusMilliseconds(GetCurrentTimestamp(),
+													 plan_profile_interval),
+						 plan_profile_interval);
+
+	return true;
+}
+
+/*
+ * Stop profiling if the given owner holds the profiler.  The sample counts
+ * remain available through InstrProfileGetSamples() until the next
+ * InstrProfileStart(), so EXPLAIN can report them after ExecutorEnd.
+ */
+void
+InstrProfileStop(const void *owner)
+{
+	if (profile_owner != owner)
+		return;
+
+	disable_timeout(PLAN_PROFILE_TIMEOUT, false);
+	InstrProfileCurrentId = 0;
+	profile_owner = NULL;
+}
+
+/*
+ * Return the number of samples charged to the given plan node.
+ */
+uint64
+InstrProfileGetSamples(int plan_node_id)
+{
+	if (plan_node_id < 0 || plan_node_id >= INSTR_PROFILE_MAX_NODES)
+		return 0;
+	return profile_samples[plan_node_id];
+}
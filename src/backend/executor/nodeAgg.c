@@ -420,6 +420,7 @@ static void lookup_hash_entries(AggState *aggstate);
 static TupleTableSlot *agg_retrieve_direct(AggState *aggstate);
 static void agg_fill_hash_table(AggState *aggstate);
 static bool agg_refill_hash_table(AggState *aggstate);
+static void hashagg_release_tables(AggState *aggstate);
 static TupleTableSlot *agg_retrieve_hash_table(AggState *aggstate);
 static TupleTableSlot *agg_retrieve_hash_table_in_memory(AggState *aggstate);
 static void hash_agg_check_limits(AggState *aggstate);
@@ -2634,6 +2635,19 @@ agg_fill_hash_table(AggState *aggstate)
 	 */
 	for (;;)
 	{
+		/*
+		 * If a group bound is in effect (a hashed DISTINCT under LIMIT, see
+		 * ExecSetTupleBound), we can stop reading input once that many
+		 * groups have been built: with no aggregates to advance, further
+		 * tuples could only create groups beyond the bound.  This doesn't
+		 * apply once we have spilled, since then the in-memory group count
+		 * no longer reflects the number of result groups.
+		 */
+		if (aggstate->hash_group_bound >= 0 &&
+			!aggstate->hash_ever_spilled &&
+			aggstate->hash_ngroups_current >= (uint64) aggstate->hash_group_bound)
+			break;
+
 		outerslot = fetch_input_tuple(aggstate);
 		if (TupIsNull(outerslot))
 			break;
@@ -2658,6 +2672,7 @@ agg_fill_hash_table(AggState *aggstate)
 	hashagg_finish_initial_spills(aggstate);
 
 	aggstate->table_filled = true;
+	aggstate->hash_group_bound_Done = aggstate->hash_group_bound;
 	/* Initialize to walk the first hash table */
 	select_current_set(aggstate, 0, true);
 	ResetTupleHashIterator(aggstate->perhash[0].hashtable,
@@ -2824,6 +2839,31 @@ agg_refill_hash_table(AggState *aggstate)
 	return true;
 }
 
+/*
+ * Release the memory of the hash tables, once they cannot produce any more
+ * tuples before a rescan rebuilds them.
+ *
+ * This matters when many sibling aggregate nodes run to completion one after
+ * another, as with partitionwise aggregation below an Append: without it,
+ * every finished Agg node would retain its filled hash table until executor
+ * shutdown, multiplying the memory footprint by the number of partitions.
+ */
+static void
+hashagg_release_tables(AggState *aggstate)
+{
+	/* free transition values, representative tuples, entries and buckets */
+	ReScanExprContext(aggstate->hashcontext);
+	MemoryContextReset(aggstate->hash_tablecxt);
+	MemoryContextReset(aggstate->hash_metacxt);
+
+	/* resetting hash_metacxt freed the TupleHashTables themselves */
+	for (int setno = 0; setno < aggstate->num_hashes; setno++)
+		aggstate->perhash[setno].hashtable = NULL;
+
+	aggstate->hash_ngroups_current = 0;
+	aggstate->hash_table_released = true;
+}
+
 /*
  * ExecAgg for hashed case: retrieving groups from hash table
  *
@@ -2844,6 +2884,15 @@ agg_retrieve_hash_table(AggState *aggstate)
 			if (!agg_refill_hash_table(aggstate))
 			{
 				aggstate->agg_done = true;
+
+				/*
+				 * Unless a rewind is expected, in which case the tables may
+				 * be rescanned as they stand, free their memory now that
+				 * they are exhausted; ExecReScanAgg rebuilds them if needed.
+				 */
+				if (aggstate->hash_release_on_done &&
+					!aggstate->hash_table_released)
+					hashagg_release_tables(aggstate);
 				break;
 			}
 		}
@@ -3030,6 +3079,7 @@ hashagg_spill_tuple(AggState *aggstate, HashAggSpill *spill,
 	TupleTableSlot *spillslot;
 	int			partition;
 	MinimalTuple tuple;
+	uint32		tupbodylen;
 	LogicalTape *tape;
 	int			total_written = 0;
 	bool		shouldFree;
@@ -3058,6 +3108,7 @@ hashagg_spill_tuple(AggState *aggstate, HashAggSpill *spill,
 		spillslot = inputslot;
 
 	tuple = ExecFetchSlotMinimalTuple(spillslot, &shouldFree);
+	tupbodylen = tuple->t_len - MINIMAL_TUPLE_DATA_OFFSET;
 
 	if (spill->shift < 32)
 		partition = (hash & spill->mask) >> spill->shift;
@@ -3078,8 +3129,13 @@ hashagg_spill_tuple(AggState *aggstate, HashAggSpill *spill,
 	LogicalTapeWrite(tape, &hash, sizeof(uint32));
 	total_written += sizeof(uint32);
 
-	LogicalTapeWrite(tape, tuple, tuple->t_len);
-	total_written += tuple->t_len;
+	LogicalTapeWrite(tape, &tupbodylen, sizeof(uint32));
+	total_written += sizeof(uint32);
+
+	/* as in tuplestore.c, do not write out the uninteresting pad bytes */
+	LogicalTapeWrite(tape, (char *) tuple + MINIMAL_TUPLE_DATA_OFFSET,
+					 tupbodylen);
+	total_written += tupbodylen;
 
 	if (shouldFree)
 		pfree(tuple);
@@ -3117,6 +3173,7 @@ hashagg_batch_read(HashAggBatch *batch, uint32 *hashp)
 {
 	LogicalTape *tape = batch->input_tape;
 	MinimalTuple tuple;
+	uint32		t_bodylen;
 	uint32		t_len;
 	size_t		nread;
 	uint32		hash;
@@ -3132,24 +3189,25 @@ hashagg_batch_read(HashAggBatch *batch, uint32 *hashp)
 	if (hashp != NULL)
 		*hashp = hash;
 
-	nread = LogicalTapeRead(tape, &t_len, sizeof(t_len));
+	nread = LogicalTapeRead(tape, &t_bodylen, sizeof(t_bodylen));
 	if (nread != sizeof(uint32))
 		ereport(ERROR,
 				(errcode_for_file_access(),
 				 errmsg_internal("unexpected EOF for tape %p: requested %zu bytes, read %zu bytes",
 								 tape, sizeof(uint32), nread)));
 
+	t_len = t_bodylen + MINIMAL_TUPLE_DATA_OFFSET;
 	tuple = (MinimalTuple) palloc(t_len);
 	tuple->t_len = t_len;
 
 	nread = LogicalTapeRead(tape,
-							(char *) tuple + sizeof(uint32),
-							t_len - sizeof(uint32));
-	if (nread != t_len - sizeof(uint32))
+							(char *) tuple + MINIMAL_TUPLE_DATA_OFFSET,
+							t_bodylen);
+	if (nread != t_bodylen)
 		ereport(ERROR,
 				(errcode_for_file_access(),
 				 errmsg_internal("unexpected EOF for tape %p: requested %zu bytes, read %zu bytes",
-								 tape, t_len - sizeof(uint32), nread)));
+								 tape, (size_t) t_bodylen, nread)));
 
 	return tuple;
 }
@@ -3395,8 +3453,16 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 	}
 
 	if (use_hashing)
+	{
 		hash_create_memory(aggstate);
 
+		/*
+		 * If no rewind is expected, the hash tables can be freed as soon as
+		 * they have been read to completion; see agg_retrieve_hash_table.
+		 */
+		aggstate->hash_release_on_done = (eflags & EXEC_FLAG_REWIND) == 0;
+	}
+
 	ExecAssignExprContext(estate, &aggstate->ss.ps);
 
 	/*
@@ -3723,6 +3789,10 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 
 		aggstate->table_filled = false;
 
+		/* No group bound unless ExecSetTupleBound is called */
+		aggstate->hash_group_bound = -1;
+		aggstate->hash_group_bound_Done = -1;
+
 		/* Initialize this to 1, meaning nothing spilled, yet */
 		aggstate->hash_batches_used = 1;
 	}
@@ -4486,14 +4556,18 @@ ExecReScanAgg(AggState *node)
 			return;
 
 		/*
-		 * If we do have the hash table, and it never spilled, and the subplan
-		 * does not have any parameter changes, and none of our own parameter
-		 * changes affect input expressions of the aggregated functions, then
-		 * we can just rescan the existing hash table; no need to build it
-		 * again.
+		 * If we do have the hash table, and its memory hasn't been released
+		 * after being read to completion, and it never spilled, and the
+		 * subplan does not have any parameter changes, and none of our own
+		 * parameter changes affect input expressions of the aggregated
+		 * functions, and the group bound (if any) is the same one the table
+		 * was built under, then we can just rescan the existing hash table;
+		 * no need to build it again.
 		 */
-		if (outerPlan->chgParam == NULL && !node->hash_ever_spilled &&
-			!bms_overlap(node->ss.ps.chgParam, aggnode->aggParams))
+		if (outerPlan->chgParam == NULL && !node->hash_table_released &&
+			!node->hash_ever_spilled &&
+			!bms_overlap(node->ss.ps.chgParam, aggnode->aggParams) &&
+			node->hash_group_bound == node->hash_group_bound_Done)
 		{
 			ResetTupleHashIterator(node->perhash[0].hashtable,
 								   &node->perhash[0].hashiter);
@@ -4554,6 +4628,7 @@ ExecReScanAgg(AggState *node)
 		node->hash_ever_spilled = false;
 		node->hash_spill_mode = false;
 		node->hash_ngroups_current = 0;
+		node->hash_table_released = false;
 
 		ReScanExprContext(node->hashcontext);
 		MemoryContextReset(node->hash_tablecxt);
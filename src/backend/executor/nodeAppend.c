@@ -65,19 +65,30 @@
 #include "pgstat.h"
 #include "storage/latch.h"
 
+/* Per-subplan shared state for parallel-aware Append. */
+typedef struct ParallelAppendPlanState
+{
+	int			pa_nworkers;	/* # of processes currently executing it */
+	bool		pa_finished;	/* no more processes should select it */
+} ParallelAppendPlanState;
+
 /* Shared state for parallel-aware Append. */
 struct ParallelAppendState
 {
 	LWLock		pa_lock;		/* mutual exclusion to choose next subplan */
-	int			pa_next_plan;	/* next plan to choose by any worker */
+	int			pa_next_plan;	/* set to INVALID_SUBPLAN_INDEX when the
+								 * subplans have all been exhausted */
 
 	/*
-	 * pa_finished[i] should be true if no more workers should select subplan
-	 * i.  for a non-partial plan, this should be set to true as soon as a
-	 * worker selects the plan; for a partial plan, it remains false until
-	 * some worker executes the plan to completion.
+	 * pa_plans[i].pa_finished should be true if no more workers should
+	 * select subplan i.  For a non-partial plan, this should be set to true
+	 * as soon as a worker selects the plan; for a partial plan, it remains
+	 * false until some worker executes the plan to completion.
+	 * pa_plans[i].pa_nworkers counts the processes currently executing the
+	 * subplan, which lets workers that run out of work join the
+	 * least-crowded partial subplan.
 	 */
-	bool		pa_finished[FLEXIBLE_ARRAY_MEMBER];
+	ParallelAppendPlanState pa_plans[FLEXIBLE_ARRAY_MEMBER];
 };
 
 #define INVALID_SUBPLAN_INDEX		-1
@@ -500,8 +511,8 @@ ExecAppendEstimate(AppendState *node,
 				   ParallelContext *pcxt)
 {
 	node->pstate_len =
-		add_size(offsetof(ParallelAppendState, pa_finished),
-				 sizeof(bool) * node->as_nplans);
+		add_size(offsetof(ParallelAppendState, pa_plans),
+				 mul_size(sizeof(ParallelAppendPlanState), node->as_nplans));
 
 	shm_toc_estimate_chunk(&pcxt->estimator, node->pstate_len);
 	shm_toc_estimate_keys(&pcxt->estimator, 1);
@@ -541,7 +552,8 @@ ExecAppendReInitializeDSM(AppendState *node, ParallelContext *pcxt)
 	ParallelAppendState *pstate = node->as_pstate;
 
 	pstate->pa_next_plan = 0;
-	memset(pstate->pa_finished, 0, sizeof(bool) * node->as_nplans);
+	memset(pstate->pa_plans, 0,
+		   sizeof(ParallelAppendPlanState) * node->as_nplans);
 }
 
 /* ----------------------------------------------------------------
@@ -647,7 +659,8 @@ choose_next_subplan_for_leader(AppendState *node)
 	if (node->as_whichplan != INVALID_SUBPLAN_INDEX)
 	{
 		/* Mark just-completed subplan as finished. */
-		node->as_pstate->pa_finished[node->as_whichplan] = true;
+		pstate->pa_plans[node->as_whichplan].pa_finished = true;
+		pstate->pa_plans[node->as_whichplan].pa_nworkers--;
 	}
 	else
 	{
@@ -674,7 +687,7 @@ choose_next_subplan_for_leader(AppendState *node)
 	}
 
 	/* Loop until we find a subplan to execute. */
-	while (pstate->pa_finished[node->as_whichplan])
+	while (pstate->pa_plans[node->as_whichplan].pa_finished)
 	{
 		if (node->as_whichplan == 0)
 		{
@@ -691,9 +704,11 @@ choose_next_subplan_for_leader(AppendState *node)
 		node->as_whichplan--;
 	}
 
+	pstate->pa_plans[node->as_whichplan].pa_nworkers++;
+
 	/* If non-partial, immediately mark as finished. */
 	if (node->as_whichplan < node->as_first_partial_plan)
-		node->as_pstate->pa_finished[node->as_whichplan] = true;
+		pstate->pa_plans[node->as_whichplan].pa_finished = true;
 
 	LWLockRelease(&pstate->pa_lock);
 
@@ -706,17 +721,22 @@ choose_next_subplan_for_leader(AppendState *node)
  *		Choose next subplan for a parallel-aware Append, returning
  *		false if there are no more.
  *
- *		We start from the first plan and advance through the list;
- *		when we get back to the end, we loop back to the first
- *		partial plan.  This assigns the non-partial plans first in
- *		order of descending cost and then spreads out the workers
- *		as evenly as possible across the remaining partial plans.
+ *		The non-partial plans are handed out first, in order of
+ *		descending cost, since each of them must be run by exactly
+ *		one process.  After that, each worker joins whichever
+ *		unfinished partial plan currently has the fewest processes
+ *		working on it.  This keeps the workers spread evenly across
+ *		the partial plans even when their sizes are badly skewed, as
+ *		workers that exhaust a small subplan migrate to whichever
+ *		subplans still have tuples to hand out.
  * ----------------------------------------------------------------
  */
 static bool
 choose_next_subplan_for_worker(AppendState *node)
 {
 	ParallelAppendState *pstate = node->as_pstate;
+	int			chosen = INVALID_SUBPLAN_INDEX;
+	int			i;
 
 	/* Backward scan is not supported by parallel-aware plans */
 	Assert(ScanDirectionIsForward(node->ps.state->es_direction));
@@ -728,7 +748,10 @@ choose_next_subplan_for_worker(AppendState *node)
 
 	/* Mark just-completed subplan as finished. */
 	if (node->as_whichplan != INVALID_SUBPLAN_INDEX)
-		node->as_pstate->pa_finished[node->as_whichplan] = true;
+	{
+		pstate->pa_plans[node->as_whichplan].pa_finished = true;
+		pstate->pa_plans[node->as_whichplan].pa_nworkers--;
+	}
 
 	/*
 	 * If we've yet to determine the valid subplans then do so now.  If
@@ -751,80 +774,55 @@ choose_next_subplan_for_worker(AppendState *node)
 		return false;
 	}
 
-	/* Save the plan from which we are starting the search. */
-	node->as_whichplan = pstate->pa_next_plan;
-
-	/* Loop until we find a valid subplan to execute. */
-	while (pstate->pa_finished[pstate->pa_next_plan])
+	/* Claim the next unfinished non-partial plan, if there is one. */
+	for (i = bms_next_member(node->as_valid_subplans, -1);
+		 i >= 0 && i < node->as_first_partial_plan;
+		 i = bms_next_member(node->as_valid_subplans, i))
 	{
-		int			nextplan;
-
-		nextplan = bms_next_member(node->as_valid_subplans,
-								   pstate->pa_next_plan);
-		if (nextplan >= 0)
-		{
-			/* Advance to the next valid plan. */
-			pstate->pa_next_plan = nextplan;
-		}
-		else if (node->as_whichplan > node->as_first_partial_plan)
-		{
-			/*
-			 * Try looping back to the first valid partial plan, if there is
-			 * one.  If there isn't, arrange to bail out below.
-			 */
-			nextplan = bms_next_member(node->as_valid_subplans,
-									   node->as_first_partial_plan - 1);
-			pstate->pa_next_plan =
-				nextplan < 0 ? node->as_whichplan : nextplan;
-		}
-		else
-		{
-			/*
-			 * At last plan, and either there are no partial plans or we've
-			 * tried them all.  Arrange to bail out.
-			 */
-			pstate->pa_next_plan = node->as_whichplan;
-		}
-
-		if (pstate->pa_next_plan == node->as_whichplan)
+		if (!pstate->pa_plans[i].pa_finished)
 		{
-			/* We've tried everything! */
-			pstate->pa_next_plan = INVALID_SUBPLAN_INDEX;
-			LWLockRelease(&pstate->pa_lock);
-			return false;
+			chosen = i;
+			break;
 		}
 	}
 
-	/* Pick the plan we found, and advance pa_next_plan one more time. */
-	node->as_whichplan = pstate->pa_next_plan;
-	pstate->pa_next_plan = bms_next_member(node->as_valid_subplans,
-										   pstate->pa_next_plan);
-
 	/*
-	 * If there are no more valid plans then try setting the next plan to the
-	 * first valid partial plan.
+	 * Failing that, join the unfinished partial plan with the fewest
+	 * processes currently executing it.
 	 */
-	if (pstate->pa_next_plan < 0)
+	if (chosen == INVALID_SUBPLAN_INDEX)
 	{
-		int			nextplan = bms_next_member(node->as_valid_subplans,
-											   node->as_first_partial_plan - 1);
+		int			minworkers = PG_INT32_MAX;
 
-		if (nextplan >= 0)
-			pstate->pa_next_plan = nextplan;
-		else
+		for (i = bms_next_member(node->as_valid_subplans,
+								 node->as_first_partial_plan - 1);
+			 i >= 0;
+			 i = bms_next_member(node->as_valid_subplans, i))
 		{
-			/*
-			 * There are no valid partial plans, and we already chose the last
-			 * non-partial plan; so flag that there's nothing more for our
-			 * fellow workers to do.
-			 */
-			pstate->pa_next_plan = INVALID_SUBPLAN_INDEX;
+			if (pstate->pa_plans[i].pa_finished)
+				continue;
+			if (pstate->pa_plans[i].pa_nworkers < minworkers)
+			{
+				minworkers = pstate->pa_plans[i].pa_nworkers;
+				chosen = i;
+			}
 		}
 	}
 
+	if (chosen == INVALID_SUBPLAN_INDEX)
+	{
+		/* We've tried everything! */
+		pstate->pa_next_plan = INVALID_SUBPLAN_INDEX;
+		LWLockRelease(&pstate->pa_lock);
+		return false;
+	}
+
+	node->as_whichplan = chosen;
+	pstate->pa_plans[chosen].pa_nworkers++;
+
 	/* If non-partial, immediately mark as finished. */
-	if (node->as_whichplan < node->as_first_partial_plan)
-		node->as_pstate->pa_finished[node->as_whichplan] = true;
+	if (chosen < node->as_first_partial_plan)
+		pstate->pa_plans[chosen].pa_finished = true;
 
 	LWLockRelease(&pstate->pa_lock);
 
@@ -858,7 +856,7 @@ mark_invalid_subplans_as_finished(AppendState *node)
 	for (i = 0; i < node->as_nplans; i++)
 	{
 		if (!bms_is_member(i, node->as_valid_subplans))
-			node->as_pstate->pa_finished[i] = true;
+			node->as_pstate->pa_plans[i].pa_finished = true;
 	}
 }
 
@@ -72,13 +72,20 @@ CteScanNext(CteScanState *node)
 	/*
 	 * If we can fetch another tuple from the tuplestore, return it.
 	 *
-	 * Note: we have to use copy=true in the tuplestore_gettupleslot call,
-	 * because we are sharing the tuplestore with other nodes that might write
-	 * into the tuplestore before we get called again.
+	 * Note: we have to use copy=true in the tuplestore_gettupleslot call
+	 * whenever we share the tuplestore with other nodes, because they might
+	 * write into the tuplestore before we get called again, which could
+	 * recycle the memory our slot would otherwise point at.  If this scan is
+	 * the only reader there is no such hazard: nothing appends except
+	 * ourselves, and by then the previous tuple is no longer interesting.
+	 * (A reader attaching after we've started, as can happen during EPQ
+	 * rechecks, materializes our slot first; see ExecInitCteScan.)
 	 */
 	if (!eof_tuplestore)
 	{
-		if (tuplestore_gettupleslot(tuplestorestate, forward, true, slot))
+		bool		copy = (node->leader->nreaders > 1);
+
+		if (tuplestore_gettupleslot(tuplestorestate, forward, copy, slot))
 			return slot;
 		if (forward)
 			eof_tuplestore = true;
@@ -235,6 +242,7 @@ ExecInitCteScan(CteScan *node, EState *estate, int eflags)
 		scanstate->cte_table = tuplestore_begin_heap(true, false, work_mem);
 		tuplestore_set_eflags(scanstate->cte_table, scanstate->eflags);
 		scanstate->readptr = 0;
+		scanstate->nreaders = 1;
 	}
 	else
 	{
@@ -246,6 +254,17 @@ ExecInitCteScan(CteScan *node, EState *estate, int eflags)
 		tuplestore_select_read_pointer(scanstate->leader->cte_table,
 									   scanstate->readptr);
 		tuplestore_rescan(scanstate->leader->cte_table);
+		scanstate->leader->nreaders++;
+
+		/*
+		 * While the leader was the only reader, CteScanNext may have left
+		 * its scan slot pointing directly into the tuplestore.  Now that our
+		 * reads can append to the tuplestore behind the leader's back (this
+		 * can only happen when we're initialized mid-query, e.g. in an EPQ
+		 * recheck tree), make sure any such tuple is safely copied first.
+		 */
+		if (!TupIsNull(scanstate->leader->ss.ss_ScanTupleSlot))
+			ExecMaterializeSlot(scanstate->leader->ss.ss_ScanTupleSlot);
 	}
 
 	/*
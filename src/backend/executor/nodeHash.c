@@ -43,7 +43,6 @@
 #include "utils/wait_event.h"
 
 static void ExecHashIncreaseNumBatches(HashJoinTable hashtable);
-static void ExecHashIncreaseNumBuckets(HashJoinTable hashtable);
 static void ExecParallelHashIncreaseNumBatches(HashJoinTable hashtable);
 static void ExecParallelHashIncreaseNumBuckets(HashJoinTable hashtable);
 static void ExecHashBuildSkewHash(HashState *hashstate,
@@ -510,6 +509,7 @@ ExecHashTableCreate(HashState *state)
 	hashtable->totalTuples = 0;
 	hashtable->partialTuples = 0;
 	hashtable->skewTuples = 0;
+	hashtable->batchTuples = 0;
 	hashtable->innerBatchFile = NULL;
 	hashtable->outerBatchFile = NULL;
 	hashtable->spaceUsed = 0;
@@ -520,6 +520,7 @@ ExecHashTableCreate(HashState *state)
 		hashtable->spaceAllowed * SKEW_HASH_MEM_PERCENT / 100;
 	hashtable->chunks = NULL;
 	hashtable->current_chunk = NULL;
+	hashtable->bloomfilter = NULL;
 	hashtable->parallel_state = state->parallel_state;
 	hashtable->area = state->ps.state->es_query_dsa;
 	hashtable->batches = NULL;
@@ -567,6 +568,21 @@ ExecHashTableCreate(HashState *state)
 		/* The files will not be opened until needed... */
 		/* ... but make sure we have temp tablespaces established for them */
 		PrepareTempTablespaces();
+
+		/*
+		 * Since we expect to spill, build a bloom filter over the inner
+		 * relation's hash values as they are inserted, so that probing can
+		 * discard outer tuples with no possible match before writing them to
+		 * a batch file.  Cap the filter at a modest fraction of the hash
+		 * table's memory budget; it is not charged against spaceUsed, since
+		 * it can never grow or move thereafter.  (We don't bother if the
+		 * join only becomes multi-batch at run time, so tuples inserted
+		 * before that point would be missing from a filter.)
+		 */
+		hashtable->bloomfilter =
+			bloom_create((int64) Max(rows, 1.0),
+						 (int) Min(space_allowed / 8192, (size_t) INT_MAX),
+						 0);
 	}
 
 	MemoryContextSwitchTo(oldcxt);
@@ -1165,6 +1181,8 @@ ExecHashIncreaseNumBatches(HashJoinTable hashtable)
 		   hashtable, nfreed, ninmemory, hashtable->spaceUsed);
 #endif
 
+	hashtable->batchTuples -= nfreed;
+
 	/*
 	 * If we dumped out either all or none of the tuples in the table, disable
 	 * further expansion of nbatch.  This situation implies that we have
@@ -1577,7 +1595,7 @@ ExecParallelHashMergeCounters(HashJoinTable hashtable)
  *		increase the original number of buckets in order to reduce
  *		number of tuples per bucket
  */
-static void
+void
 ExecHashIncreaseNumBuckets(HashJoinTable hashtable)
 {
 	HashMemoryChunk chunk;
@@ -1752,6 +1770,11 @@ ExecHashTableInsert(HashJoinTable hashtable,
 	ExecHashGetBucketAndBatch(hashtable, hashvalue,
 							  &bucketno, &batchno);
 
+	/* remember this hash value for the benefit of outer-side prefiltering */
+	if (hashtable->bloomfilter)
+		bloom_add_element(hashtable->bloomfilter,
+						  (unsigned char *) &hashvalue, sizeof(uint32));
+
 	/*
 	 * decide whether to put the tuple in the hash table or a temp file
 	 */
@@ -1762,7 +1785,6 @@ ExecHashTableInsert(HashJoinTable hashtable,
 		 */
 		HashJoinTuple hashTuple;
 		int			hashTupleSize;
-		double		ntuples = (hashtable->totalTuples - hashtable->skewTuples);
 
 		/* Create the HashJoinTuple */
 		hashTupleSize = HJTUPLE_OVERHEAD + tuple->t_len;
@@ -1783,13 +1805,16 @@ ExecHashTableInsert(HashJoinTable hashtable,
 		hashTuple->next.unshared = hashtable->buckets.unshared[bucketno];
 		hashtable->buckets.unshared[bucketno] = hashTuple;
 
+		hashtable->batchTuples += 1;
+
 		/*
 		 * Increase the (optimal) number of buckets if we just exceeded the
-		 * NTUP_PER_BUCKET threshold, but only when there's still a single
-		 * batch.
+		 * NTUP_PER_BUCKET threshold.  Judging this by the tuples in memory
+		 * for the current batch, rather than the overall input size, means
+		 * it also fires when reloading an unexpectedly large batch, e.g.
+		 * after a row estimate that was far too low forced batch growth.
 		 */
-		if (hashtable->nbatch == 1 &&
-			ntuples > (hashtable->nbuckets_optimal * NTUP_PER_BUCKET))
+		if (hashtable->batchTuples > (hashtable->nbuckets_optimal * NTUP_PER_BUCKET))
 		{
 			/* Guard against integer overflow and alloc size overflow */
 			if (hashtable->nbuckets_optimal <= INT_MAX / 2 &&
@@ -2334,6 +2359,7 @@ ExecHashTableReset(HashJoinTable hashtable)
 	hashtable->buckets.unshared = palloc0_array(HashJoinTuple, nbuckets);
 
 	hashtable->spaceUsed = 0;
+	hashtable->batchTuples = 0;
 
 	MemoryContextSwitchTo(oldcxt);
 
@@ -2602,6 +2628,11 @@ ExecHashSkewTableInsert(HashJoinTable hashtable,
 	HashJoinTuple hashTuple;
 	int			hashTupleSize;
 
+	/* as in ExecHashTableInsert, track the hash value in the bloom filter */
+	if (hashtable->bloomfilter)
+		bloom_add_element(hashtable->bloomfilter,
+						  (unsigned char *) &hashvalue, sizeof(uint32));
+
 	/* Create the HashJoinTuple */
 	hashTupleSize = HJTUPLE_OVERHEAD + tuple->t_len;
 	hashTuple = (HashJoinTuple) MemoryContextAlloc(hashtable->batchCxt,
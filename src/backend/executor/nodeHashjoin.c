@@ -199,6 +199,7 @@ static TupleTableSlot *ExecHashJoinGetSavedTuple(HashJoinState *hjstate,
 												 BufFile *file,
 												 uint32 *hashvalue,
 												 TupleTableSlot *tupleSlot);
+static void ExecHashJoinMergeBatches(HashJoinState *hjstate);
 static bool ExecHashJoinNewBatch(HashJoinState *hjstate);
 static bool ExecParallelHashJoinNewBatch(HashJoinState *hjstate);
 static void ExecParallelHashJoinPartitionOuter(HashJoinState *hjstate);
@@ -364,6 +365,15 @@ ExecHashJoinImpl(PlanState *pstate, bool parallel)
 					return NULL;
 				}
 
+				/*
+				 * If the inner relation came in far under the planner's
+				 * estimate, we may be carrying many batches whose contents
+				 * would all fit in memory; merge them back into one before
+				 * the probe phase partitions the outer relation to match.
+				 */
+				if (!parallel && hashtable->nbatch > 1)
+					ExecHashJoinMergeBatches(node);
+
 				/*
 				 * need to remember whether nbatch has increased since we
 				 * began scanning the outer relation
@@ -460,6 +470,26 @@ ExecHashJoinImpl(PlanState *pstate, bool parallel)
 					continue;
 				}
 
+				/*
+				 * If we built a bloom filter over the inner relation's hash
+				 * values, we may be able to discard this tuple without doing
+				 * any more work with it -- in particular, without writing it
+				 * out to a batch file.  This is only legal if an unmatched
+				 * outer tuple produces no join output.  Tuples reloaded from
+				 * outer batch files already passed the filter, so there's no
+				 * point in re-testing them in later batches.
+				 */
+				if (hashtable->bloomfilter != NULL &&
+					hashtable->curbatch == 0 &&
+					!HJ_FILL_OUTER(node) &&
+					bloom_lacks_element(hashtable->bloomfilter,
+										(unsigned char *) &hashvalue,
+										sizeof(uint32)))
+				{
+					/* Loop around, staying in HJ_NEED_NEW_OUTER state */
+					continue;
+				}
+
 				econtext->ecxt_outertuple = outerTupleSlot;
 				node->hj_MatchedOuter = false;
 
@@ -1120,6 +1150,98 @@ ExecParallelHashJoinOuterGetTuple(PlanState *outerNode,
 	return NULL;
 }
 
+/*
+ * ExecHashJoinMergeBatches
+ *		merge a multi-batch hash table back into a single batch, if the
+ *		inner relation turned out small enough
+ *
+ * If the planner badly overestimated the size of the inner relation, the
+ * hash table was split into many batches up front even though the actual
+ * inner data would fit in memory.  Left that way, the probe phase would
+ * partition the entire outer relation into batch temp files, only to join
+ * each outer batch against a handful of inner tuples.  Instead, reload the
+ * spilled inner tuples into the in-memory hash table and drop back to a
+ * single batch, so the outer relation is probed directly with no temp-file
+ * traffic.  As a further benefit, a single-batch hash table can be reused
+ * across rescans (see ExecReScanHashJoin).
+ *
+ * This is called once, after the hash table has been built and before the
+ * outer relation is scanned.  It is not used for parallel hash joins, whose
+ * batch bookkeeping is shared.
+ */
+static void
+ExecHashJoinMergeBatches(HashJoinState *hjstate)
+{
+	HashJoinTable hashtable = hjstate->hj_HashTable;
+	int			nbatch = hashtable->nbatch;
+	int64		filebytes = 0;
+	bool		save_growEnabled;
+	TupleTableSlot *slot;
+	uint32		hashvalue;
+
+	Assert(hashtable->parallel_state == NULL);
+	Assert(hashtable->curbatch == 0);
+	Assert(nbatch > 1);
+
+	for (int i = 1; i < nbatch; i++)
+	{
+		if (hashtable->innerBatchFile[i] != NULL)
+			filebytes += BufFileSize(hashtable->innerBatchFile[i]);
+	}
+
+	/*
+	 * Estimate whether everything would fit in memory.  The in-memory
+	 * representation costs somewhat more per tuple than the file format
+	 * (HashJoinTupleData header and allocation overhead versus a uint32
+	 * hash value), but since a saved minimal tuple is at least a few dozen
+	 * bytes, doubling the file size is a safe upper bound.  Requiring that
+	 * bound to fit also ensures the inserts below cannot force the number
+	 * of batches right back up.
+	 */
+	if (hashtable->spaceUsed + filebytes * 2 > hashtable->spaceAllowed)
+		return;
+
+	/*
+	 * Read back the spilled inner tuples.  Growth cannot trigger, per the
+	 * check above, but disable it anyway: we are iterating over the batch
+	 * file array, and a repartition would reuse it under us.
+	 */
+	save_growEnabled = hashtable->growEnabled;
+	hashtable->growEnabled = false;
+	hashtable->nbatch = 1;
+
+	for (int i = 1; i < nbatch; i++)
+	{
+		BufFile    *innerFile = hashtable->innerBatchFile[i];
+
+		if (innerFile == NULL)
+			continue;
+
+		if (BufFileSeek(innerFile, 0, 0, SEEK_SET))
+			ereport(ERROR,
+					(errcode_for_file_access(),
+					 errmsg("could not rewind hash-join temporary file")));
+
+		while ((slot = ExecHashJoinGetSavedTuple(hjstate,
+												 innerFile,
+												 &hashvalue,
+												 hjstate->hj_HashTupleSlot)))
+			ExecHashTableInsert(hashtable, slot, hashvalue);
+
+		BufFileClose(innerFile);
+		hashtable->innerBatchFile[i] = NULL;
+	}
+
+	hashtable->growEnabled = save_growEnabled;
+
+	/*
+	 * The bucket array was sized for the expected share of one batch, so
+	 * the reloaded tuples may well have overfilled it; resize if the
+	 * inserts above raised nbuckets_optimal.
+	 */
+	ExecHashIncreaseNumBuckets(hashtable);
+}
+
 /*
  * ExecHashJoinNewBatch
  *		switch to a new hashjoin batch
@@ -1241,6 +1363,13 @@ ExecHashJoinNewBatch(HashJoinState *hjstate)
 			ExecHashTableInsert(hashtable, slot, hashvalue);
 		}
 
+		/*
+		 * If the batch turned out to hold more tuples than the bucket array
+		 * was sized for, resize it before we start probing.  The inserts
+		 * above will have raised nbuckets_optimal if so.
+		 */
+		ExecHashIncreaseNumBuckets(hashtable);
+
 		/*
 		 * after we build the hash table, the inner batch file is no longer
 		 * needed
@@ -1402,8 +1531,11 @@ ExecParallelHashJoinNewBatch(HashJoinState *hjstate)
  * ExecHashJoinSaveTuple
  *		save a tuple to a batch file.
  *
- * The data recorded in the file for each tuple is its hash value,
- * then the tuple in MinimalTuple format.
+ * The data recorded in the file for each tuple is its hash value, then the
+ * tuple's data length, then the tuple in MinimalTuple format.  As in
+ * tuplestore.c, we do not write out the uninteresting pad bytes at the start
+ * of the MinimalTuple; this saves a few bytes per spilled tuple, which adds
+ * up quickly for large multi-batch joins.
  *
  * fileptr points to a batch file in one of the hashtable arrays.
  *
@@ -1415,6 +1547,7 @@ ExecHashJoinSaveTuple(MinimalTuple tuple, uint32 hashvalue,
 					  BufFile **fileptr, HashJoinTable hashtable)
 {
 	BufFile    *file = *fileptr;
+	uint32		tupbodylen;
 
 	/*
 	 * The batch file is lazily created. If this is the first tuple written to
@@ -1440,8 +1573,11 @@ ExecHashJoinSaveTuple(MinimalTuple tuple, uint32 hashvalue,
 		MemoryContextSwitchTo(oldctx);
 	}
 
+	tupbodylen = tuple->t_len - MINIMAL_TUPLE_DATA_OFFSET;
+
 	BufFileWrite(file, &hashvalue, sizeof(uint32));
-	BufFileWrite(file, tuple, tuple->t_len);
+	BufFileWrite(file, &tupbodylen, sizeof(uint32));
+	BufFileWrite(file, (char *) tuple + MINIMAL_TUPLE_DATA_OFFSET, tupbodylen);
 }
 
 /*
@@ -1460,6 +1596,7 @@ ExecHashJoinGetSavedTuple(HashJoinState *hjstate,
 	uint32		header[2];
 	size_t		nread;
 	MinimalTuple tuple;
+	uint32		tuplen;
 
 	/*
 	 * We check for interrupts here because this is typically taken as an
@@ -1469,7 +1606,7 @@ ExecHashJoinGetSavedTuple(HashJoinState *hjstate,
 	CHECK_FOR_INTERRUPTS();
 
 	/*
-	 * Since both the hash value and the MinimalTuple length word are uint32,
+	 * Since both the hash value and the tuple body length word are uint32,
 	 * we can read them both in one BufFileRead() call without any type
 	 * cheating.
 	 */
@@ -1480,11 +1617,12 @@ ExecHashJoinGetSavedTuple(HashJoinState *hjstate,
 		return NULL;
 	}
 	*hashvalue = header[0];
-	tuple = (MinimalTuple) palloc(header[1]);
-	tuple->t_len = header[1];
+	tuplen = header[1] + MINIMAL_TUPLE_DATA_OFFSET;
+	tuple = (MinimalTuple) palloc(tuplen);
+	tuple->t_len = tuplen;
 	BufFileReadExact(file,
-					 (char *) tuple + sizeof(uint32),
-					 header[1] - sizeof(uint32));
+					 (char *) tuple + MINIMAL_TUPLE_DATA_OFFSET,
+					 header[1]);
 	ExecForceStoreMinimalTuple(tuple, tupleSlot, true);
 	return tupleSlot;
 }
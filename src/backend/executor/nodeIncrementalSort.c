@@ -296,6 +296,12 @@ switchToPresortedPrefixMode(PlanState *pstate)
 	outerNode = outerPlanState(node);
 	tupDesc = ExecGetResultType(outerNode);
 
+	/*
+	 * We're about to drain tuples out of the full sort state, so it will no
+	 * longer hold an intact copy of the input that a rescan could rewind to.
+	 */
+	node->fullsort_first_batch = false;
+
 	/* Configure the prefix sort state the first time around. */
 	if (node->prefixsort_state == NULL)
 	{
@@ -591,6 +597,8 @@ ExecIncrementalSort(PlanState *pstate)
 		 */
 		if (fullsort_state == NULL)
 		{
+			int			sortopt = TUPLESORT_NONE;
+
 			/*
 			 * Initialize presorted column support structures for
 			 * isCurrentGroup(). It's correct to do this along with the
@@ -600,6 +608,17 @@ ExecIncrementalSort(PlanState *pstate)
 			 */
 			preparePresortedCols(node);
 
+			if (node->bounded)
+				sortopt |= TUPLESORT_ALLOWBOUNDED;
+
+			/*
+			 * If a rewind might be requested, ask for random access so that
+			 * ExecReScanIncrementalSort can rewind the full sort state in the
+			 * case where it ends up holding the entire input.
+			 */
+			if (node->randomAccess)
+				sortopt |= TUPLESORT_RANDOMACCESS;
+
 			/*
 			 * Since we optimize small prefix key groups by accumulating a
 			 * minimum number of tuples before sorting, we can't assume that a
@@ -615,15 +634,16 @@ ExecIncrementalSort(PlanState *pstate)
 												  plannode->sort.nullsFirst,
 												  work_mem,
 												  NULL,
-												  node->bounded ?
-												  TUPLESORT_ALLOWBOUNDED :
-												  TUPLESORT_NONE);
+												  sortopt);
 			node->fullsort_state = fullsort_state;
 		}
 		else
 		{
 			/* Reset sort for the next batch. */
 			tuplesort_reset(fullsort_state);
+
+			/* ... which means we're past the first batch of this scan. */
+			node->fullsort_first_batch = false;
 		}
 
 		/*
@@ -641,8 +661,17 @@ ExecIncrementalSort(PlanState *pstate)
 			 * heap sort anyway unless it hits (2 * bound) tuples.
 			 */
 			if (currentBound < DEFAULT_MIN_GROUP_SIZE)
+			{
 				tuplesort_set_bound(fullsort_state, currentBound);
 
+				/*
+				 * The stored result is now truncated to the bound, so a
+				 * rescan must not rewind it even if the bound has been
+				 * cleared by then.  See ExecReScanIncrementalSort.
+				 */
+				node->fullsort_bounded = true;
+			}
+
 			minGroupSize = Min(DEFAULT_MIN_GROUP_SIZE, currentBound);
 		}
 		else
@@ -993,8 +1022,18 @@ ExecInitIncrementalSort(IncrementalSort *node, EState *estate, int eflags)
 	incrsortstate->ss.ps.ExecProcNode = ExecIncrementalSort;
 
 	incrsortstate->execution_status = INCSORT_LOADFULLSORT;
+
+	/*
+	 * If a rewind is expected (EXEC_FLAG_BACKWARD and EXEC_FLAG_MARK are
+	 * ruled out above), request random access to the full sort output so
+	 * that we can rewind it on rescan when it turns out to hold the whole
+	 * input.  See ExecReScanIncrementalSort.
+	 */
+	incrsortstate->randomAccess = (eflags & EXEC_FLAG_REWIND) != 0;
 	incrsortstate->bounded = false;
 	incrsortstate->outerNodeDone = false;
+	incrsortstate->fullsort_first_batch = true;
+	incrsortstate->fullsort_bounded = false;
 	incrsortstate->bound_Done = 0;
 	incrsortstate->fullsort_state = NULL;
 	incrsortstate->prefixsort_state = NULL;
@@ -1109,18 +1148,41 @@ ExecReScanIncrementalSort(IncrementalSortState *node)
 	PlanState  *outerPlan = outerPlanState(node);
 
 	/*
-	 * Incremental sort doesn't support efficient rescan even when parameters
-	 * haven't changed (e.g., rewind) because unlike regular sort we don't
-	 * store all tuples at once for the full sort.
-	 *
-	 * So even if EXEC_FLAG_REWIND is set we just reset all of our state and
-	 * re-execute the sort along with the child node. Incremental sort itself
-	 * can't do anything smarter, but maybe the child nodes can.
+	 * Incremental sort doesn't generally support efficient rescan even when
+	 * parameters haven't changed (e.g., rewind) because unlike regular sort
+	 * we don't store all tuples at once for the full sort.
 	 *
-	 * In theory if we've only filled the full sort with one batch (and
-	 * haven't reset it for a new batch yet) then we could efficiently rewind,
-	 * but that seems a narrow enough case that it's not worth handling
-	 * specially at this time.
+	 * The exception is when the entire input fit into the first full sort
+	 * batch: then the full sort state holds the complete sorted result, and
+	 * if it was set up for random access and no parameter change requires
+	 * re-reading the subplan, we can simply rewind it rather than
+	 * re-executing the child node.  (We don't bother with the bounded case;
+	 * bound bookkeeping makes it not worth the complexity.)  Note that we
+	 * must check whether the completed sort had a bound applied, not just
+	 * the current bound state: the bound may have been cleared since (cf.
+	 * recompute_limits()), and a sort truncated to a previous bound no
+	 * longer holds the whole input.
+	 */
+	if (node->randomAccess &&
+		node->fullsort_first_batch &&
+		node->outerNodeDone &&
+		node->execution_status == INCSORT_READFULLSORT &&
+		node->n_fullsort_remaining == 0 &&
+		!node->bounded &&
+		!node->fullsort_bounded &&
+		outerPlan->chgParam == NULL)
+	{
+		/* must drop pointer to sort result tuple */
+		ExecClearTuple(node->ss.ps.ps_ResultTupleSlot);
+
+		tuplesort_rescan(node->fullsort_state);
+		return;
+	}
+
+	/*
+	 * Otherwise we just reset all of our state and re-execute the sort along
+	 * with the child node. Incremental sort itself can't do anything
+	 * smarter, but maybe the child nodes can.
 	 */
 
 	/* must drop pointer to sort result tuple */
@@ -1132,6 +1194,8 @@ ExecReScanIncrementalSort(IncrementalSortState *node)
 		ExecClearTuple(node->transfer_tuple);
 
 	node->outerNodeDone = false;
+	node->fullsort_first_batch = true;
+	node->fullsort_bounded = false;
 	node->n_fullsort_remaining = 0;
 	node->bound_Done = 0;
 
@@ -102,6 +102,7 @@ IndexOnlyNext(IndexOnlyScanState *node)
 		/* Set it up for index-only scan */
 		node->ioss_ScanDesc->xs_want_itup = true;
 		node->ioss_VMBuffer = InvalidBuffer;
+		node->ioss_HeapFetchBlock = InvalidBlockNumber;
 
 		/*
 		 * If no run-time keys to calculate or they are ready, go ahead and
@@ -120,6 +121,7 @@ IndexOnlyNext(IndexOnlyScanState *node)
 	 */
 	while ((tid = index_getnext_tid(scandesc, direction)) != NULL)
 	{
+		BlockNumber blkno = ItemPointerGetBlockNumber(tid);
 		bool		tuple_from_heap = false;
 
 		CHECK_FOR_INTERRUPTS();
@@ -157,11 +159,23 @@ IndexOnlyNext(IndexOnlyScanState *node)
 		 *
 		 * It's worth going through this complexity to avoid needing to lock
 		 * the VM buffer, which could cause significant contention.
+		 *
+		 * Index TIDs tend to arrive in runs referencing the same heap block,
+		 * so we remember the last block that failed this test and go
+		 * straight to the heap for further TIDs on it, saving a VM probe per
+		 * tuple on not-all-visible data.  Only the negative result may be
+		 * cached like this: skipping the probe can at worst cost us a heap
+		 * fetch that a concurrent VACUUM has just made unnecessary, whereas
+		 * caching an all-visible result would break the insert serialization
+		 * argument above.
 		 */
-		if (!VM_ALL_VISIBLE(scandesc->heapRelation,
-							ItemPointerGetBlockNumber(tid),
+		if (blkno == node->ioss_HeapFetchBlock ||
+			!VM_ALL_VISIBLE(scandesc->heapRelation,
+							blkno,
 							&node->ioss_VMBuffer))
 		{
+			node->ioss_HeapFetchBlock = blkno;
+
 			/*
 			 * Rats, we have to visit the heap to check visibility.
 			 */
@@ -792,6 +806,7 @@ ExecIndexOnlyScanInitializeDSM(IndexOnlyScanState *node,
 								 piscan);
 	node->ioss_ScanDesc->xs_want_itup = true;
 	node->ioss_VMBuffer = InvalidBuffer;
+	node->ioss_HeapFetchBlock = InvalidBlockNumber;
 
 	/*
 	 * If no run-time keys to calculate or they are ready, go ahead and pass
@@ -857,6 +872,7 @@ ExecIndexOnlyScanInitializeWorker(IndexOnlyScanState *node,
 								 node->ioss_NumOrderByKeys,
 								 piscan);
 	node->ioss_ScanDesc->xs_want_itup = true;
+	node->ioss_HeapFetchBlock = InvalidBlockNumber;
 
 	/*
 	 * If no run-time keys to calculate or they are ready, go ahead and pass
@@ -106,6 +106,7 @@ typedef struct MemoizeKey
 {
 	MinimalTuple params;
 	dlist_node	lru_node;		/* Pointer to next/prev key in LRU list */
+	bool		reused;			/* Has this entry had a cache hit? */
 } MemoizeKey;
 
 /*
@@ -544,9 +545,10 @@ cache_lookup(MemoizeState *mstate, bool *found)
 	{
 		/*
 		 * Move existing entry to the tail of the LRU list to mark it as the
-		 * most recently used item.
+		 * most recently used item and remember that it has proven useful.
 		 */
 		dlist_move_tail(&mstate->lru_list, &entry->key->lru_node);
+		entry->key->reused = true;
 
 		return entry;
 	}
@@ -556,6 +558,7 @@ cache_lookup(MemoizeState *mstate, bool *found)
 	/* Allocate a new key */
 	entry->key = key = (MemoizeKey *) palloc(sizeof(MemoizeKey));
 	key->params = ExecCopySlotMinimalTuple(mstate->probeslot);
+	key->reused = false;
 
 	/* Update the total cache memory utilization */
 	mstate->mem_used += EMPTY_ENTRY_MEMORY_BYTES(entry);
@@ -580,6 +583,30 @@ cache_lookup(MemoizeState *mstate, bool *found)
 	 */
 	if (mstate->mem_used > mstate->mem_limit)
 	{
+		MemoizeKey *lru_key = dlist_container(MemoizeKey, lru_node,
+											  dlist_head_node(&mstate->lru_list));
+
+		/*
+		 * When the least recently used entry has already proven itself
+		 * useful by receiving at least one cache hit, evicting it to admit
+		 * an entry of unknown worth is a bad trade; doing so consistently
+		 * makes the hit rate collapse whenever the set of repeatedly looked
+		 * up keys is just a little larger than the cache.  Instead, decline
+		 * to cache the current parameters: drop the entry we just added and
+		 * let the caller switch to reading the subplan without caching.
+		 *
+		 * Clearing the reused flag here gives second-chance semantics: an
+		 * entry keeps its protection only for as long as it keeps earning
+		 * hits, so sustained memory pressure without further hits will
+		 * eventually allow it to be evicted.
+		 */
+		if (lru_key != key && lru_key->reused)
+		{
+			lru_key->reused = false;
+			remove_cache_entry(mstate, entry);
+			return NULL;
+		}
+
 		/*
 		 * Try to free up some memory.  It's highly unlikely that we'll fail
 		 * to do so here since the entry we've just added is yet to contain
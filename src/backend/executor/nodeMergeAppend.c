@@ -129,6 +129,7 @@ ExecInitMergeAppend(MergeAppend *node, EState *estate, int eflags)
 	mergestate->ms_slots = (TupleTableSlot **) palloc0(sizeof(TupleTableSlot *) * nplans);
 	mergestate->ms_heap = binaryheap_allocate(nplans, heap_compare_slots,
 											  mergestate);
+	mergestate->ms_second = -1;
 
 	/*
 	 * call ExecInitNode on each of the valid plans to be executed and save
@@ -247,6 +248,7 @@ ExecMergeAppend(PlanState *pstate)
 				binaryheap_add_unordered(node->ms_heap, Int32GetDatum(i));
 		}
 		binaryheap_build(node->ms_heap);
+		node->ms_second = -1;
 		node->ms_initialized = true;
 	}
 	else
@@ -261,10 +263,51 @@ ExecMergeAppend(PlanState *pstate)
 		 */
 		i = DatumGetInt32(binaryheap_first(node->ms_heap));
 		node->ms_slots[i] = ExecProcNode(node->mergeplans[i]);
-		if (!TupIsNull(node->ms_slots[i]))
-			binaryheap_replace_first(node->ms_heap, Int32GetDatum(i));
-		else
+		if (TupIsNull(node->ms_slots[i]))
+		{
 			(void) binaryheap_remove_first(node->ms_heap);
+			node->ms_second = -1;
+		}
+		else if (binaryheap_size(node->ms_heap) > 1)
+		{
+			/*
+			 * When the inputs' sort key ranges barely overlap, the same
+			 * subplan tends to win many times in a row, and each win would
+			 * sift the unchanged heap for nothing.  Instead, compare the new
+			 * tuple against the best tuple among the other subplans; if it
+			 * still precedes that one, the heap is already in order and no
+			 * sifting is needed.  The best of the others is necessarily one
+			 * of the root's (at most two) children, and stays put while we
+			 * stream from the root, so we can cache it across calls.
+			 */
+			if (node->ms_second < 0)
+			{
+				SlotNumber	second;
+
+				second = DatumGetInt32(binaryheap_get_node(node->ms_heap, 1));
+				if (binaryheap_size(node->ms_heap) > 2)
+				{
+					SlotNumber	other;
+
+					other = DatumGetInt32(binaryheap_get_node(node->ms_heap, 2));
+					if (heap_compare_slots(Int32GetDatum(other),
+										   Int32GetDatum(second),
+										   node) > 0)
+						second = other;
+				}
+				node->ms_second = second;
+			}
+
+			if (heap_compare_slots(Int32GetDatum(i),
+								   Int32GetDatum(node->ms_second),
+								   node) < 0)
+			{
+				/* No longer the winner, so fix the heap ordering. */
+				binaryheap_replace_first(node->ms_heap, Int32GetDatum(i));
+				node->ms_second = -1;
+			}
+		}
+		/* else there's just one subplan left, which is trivially in order */
 	}
 
 	if (binaryheap_empty(node->ms_heap))
@@ -388,5 +431,6 @@ ExecReScanMergeAppend(MergeAppendState *node)
 			ExecReScan(subnode);
 	}
 	binaryheap_reset(node->ms_heap);
+	node->ms_second = -1;
 	node->ms_initialized = false;
 }
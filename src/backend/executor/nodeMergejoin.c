@@ -598,6 +598,7 @@ ExecMergeJoin(PlanState *pstate)
 	ExprState  *otherqual;
 	bool		qualResult;
 	int			compareResult;
+	MJEvalResult mjeval;
 	PlanState  *innerPlan;
 	TupleTableSlot *innerTupleSlot;
 	PlanState  *outerPlan;
@@ -1235,7 +1236,29 @@ ExecMergeJoin(PlanState *pstate)
 				node->mj_MatchedOuter = false;
 
 				/* Compute join values and check for unmatchability */
-				switch (MJEvalOuterValues(node))
+				mjeval = MJEvalOuterValues(node);
+
+				/*
+				 * If skipped outer tuples need no per-tuple side effects (no
+				 * left-join fill tuples), consume the whole run of outer
+				 * tuples preceding the current inner right here, instead of
+				 * bouncing through EXEC_MJ_SKIP_TEST for each one.  The final
+				 * comparison is redone there once per run, which is cheap.
+				 */
+				if (!doFillOuter)
+				{
+					while (mjeval == MJEVAL_MATCHABLE && MJCompare(node) < 0)
+					{
+						CHECK_FOR_INTERRUPTS();
+						outerTupleSlot = ExecProcNode(outerPlan);
+						node->mj_OuterTupleSlot = outerTupleSlot;
+						MJ_DEBUG_PROC_NODE(outerTupleSlot);
+						node->mj_MatchedOuter = false;
+						mjeval = MJEvalOuterValues(node);
+					}
+				}
+
+				switch (mjeval)
 				{
 					case MJEVAL_MATCHABLE:
 						/* Go test the new tuple against the current inner */
@@ -1301,7 +1324,28 @@ ExecMergeJoin(PlanState *pstate)
 				node->mj_MatchedInner = false;
 
 				/* Compute join values and check for unmatchability */
-				switch (MJEvalInnerValues(node, innerTupleSlot))
+				mjeval = MJEvalInnerValues(node, innerTupleSlot);
+
+				/*
+				 * As in EXEC_MJ_SKIPOUTER_ADVANCE, consume the whole run of
+				 * inner tuples preceding the current outer right here when
+				 * skipped inner tuples need no per-tuple side effects
+				 * (right-join fill tuples or extra marks).
+				 */
+				if (!doFillInner && !node->mj_ExtraMarks)
+				{
+					while (mjeval == MJEVAL_MATCHABLE && MJCompare(node) > 0)
+					{
+						CHECK_FOR_INTERRUPTS();
+						innerTupleSlot = ExecProcNode(innerPlan);
+						node->mj_InnerTupleSlot = innerTupleSlot;
+						MJ_DEBUG_PROC_NODE(innerTupleSlot);
+						node->mj_MatchedInner = false;
+						mjeval = MJEvalInnerValues(node, innerTupleSlot);
+					}
+				}
+
+				switch (mjeval)
 				{
 					case MJEVAL_MATCHABLE:
 						/* proceed to compare it to the current outer */
@@ -36,6 +36,7 @@
 #include "nodes/nodeFuncs.h"
 #include "optimizer/optimizer.h"
 #include "utils/array.h"
+#include "utils/datum.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 
@@ -234,6 +235,36 @@ ExecScanSubPlan(SubPlanState *node,
 	ListCell   *l;
 	ArrayBuildStateAny *astate = NULL;
 
+	/*
+	 * If we cached the result of our previous evaluation, and the current
+	 * parameter values match the ones that evaluation used, we can just
+	 * return the cached result.  (Our caller has already evaluated the
+	 * parameters into the econtext; since the values match, there's no need
+	 * to tell the subplan about them.)  Note that, as with curTuple, a
+	 * pass-by-reference result remains valid only until our next evaluation.
+	 */
+	if (node->cache_valid)
+	{
+		int			i;
+
+		for (i = 0; i < node->numCacheParams; i++)
+		{
+			ParamExecData *prm = &(econtext->ecxt_param_exec_vals[node->cacheParamIds[i]]);
+
+			if (prm->isnull != node->cacheParamNulls[i] ||
+				(!prm->isnull &&
+				 !datumIsEqual(prm->value, node->cacheParamValues[i],
+							   node->cacheParamByVals[i],
+							   node->cacheParamLens[i])))
+				break;
+		}
+		if (i >= node->numCacheParams)
+		{
+			*isNull = node->cacheResultNull;
+			return node->cacheResult;
+		}
+	}
+
 	/* Initialize ArrayBuildStateAny in caller's context, if needed */
 	if (subLinkType == ARRAY_SUBLINK)
 		astate = initArrayResultAny(subplan->firstColType,
@@ -486,6 +517,41 @@ ExecScanSubPlan(SubPlanState *node,
 		}
 	}
 
+	/*
+	 * If enabled, cache the parameter values and result for next time.
+	 * Pass-by-reference values are copied into cacheContext, which we reset
+	 * first to discard the previous cached evaluation.
+	 */
+	if (node->cache_enabled)
+	{
+		int			i;
+
+		node->cache_valid = false;
+		MemoryContextReset(node->cacheContext);
+		oldcontext = MemoryContextSwitchTo(node->cacheContext);
+		for (i = 0; i < node->numCacheParams; i++)
+		{
+			ParamExecData *prm = &(econtext->ecxt_param_exec_vals[node->cacheParamIds[i]]);
+
+			node->cacheParamNulls[i] = prm->isnull;
+			if (prm->isnull)
+				node->cacheParamValues[i] = (Datum) 0;
+			else
+				node->cacheParamValues[i] = datumCopy(prm->value,
+													  node->cacheParamByVals[i],
+													  node->cacheParamLens[i]);
+		}
+		node->cacheResultNull = *isNull;
+		if (*isNull)
+			node->cacheResult = (Datum) 0;
+		else
+			node->cacheResult = datumCopy(result,
+										  node->cacheResultByVal,
+										  node->cacheResultLen);
+		MemoryContextSwitchTo(oldcontext);
+		node->cache_valid = true;
+	}
+
 	return result;
 }
 
@@ -865,6 +931,87 @@ ExecInitSubPlan(SubPlan *subplan, PlanState *parent)
 	sstate->tab_hash_funcs = NULL;
 	sstate->tab_collations = NULL;
 	sstate->cur_eq_funcs = NULL;
+	sstate->cache_enabled = false;
+	sstate->cache_valid = false;
+	sstate->cacheContext = NULL;
+
+	/*
+	 * If the planner determined that the subplan's result is fully determined
+	 * by its parameter values, arrange to cache the result of the most
+	 * recent evaluation, so that re-evaluations with identical parameter
+	 * values can skip rescanning the subplan.  This pays off when the same
+	 * correlated subquery is referenced several times in one query, or when
+	 * outer rows arrive grouped by the correlation keys.
+	 *
+	 * We can only do this for sublink types whose result is computed from
+	 * the subplan output alone: types with a testexpr also depend directly
+	 * on the outer tuple, which we don't track here.  We must also insist
+	 * that the subplan has no run-time dependencies besides its own
+	 * parameters (such as the output of an initplan, which could be
+	 * re-evaluated between our calls).
+	 */
+	if (subplan->cacheable &&
+		subplan->parParam != NIL &&
+		subplan->testexpr == NULL &&
+		(subplan->subLinkType == EXISTS_SUBLINK ||
+		 subplan->subLinkType == EXPR_SUBLINK ||
+		 subplan->subLinkType == ARRAY_SUBLINK))
+	{
+		Bitmapset  *parParams = NULL;
+		ListCell   *l;
+
+		foreach(l, subplan->parParam)
+			parParams = bms_add_member(parParams, lfirst_int(l));
+
+		if (bms_is_subset(sstate->planstate->plan->extParam, parParams))
+		{
+			int			nparams = list_length(subplan->parParam);
+			int			i;
+
+			sstate->cache_enabled = true;
+			sstate->numCacheParams = nparams;
+			sstate->cacheParamIds = (int *) palloc(nparams * sizeof(int));
+			sstate->cacheParamLens = (int16 *) palloc(nparams * sizeof(int16));
+			sstate->cacheParamByVals = (bool *) palloc(nparams * sizeof(bool));
+			sstate->cacheParamValues = (Datum *) palloc(nparams * sizeof(Datum));
+			sstate->cacheParamNulls = (bool *) palloc(nparams * sizeof(bool));
+
+			i = 0;
+			foreach(l, subplan->parParam)
+				sstate->cacheParamIds[i++] = lfirst_int(l);
+			i = 0;
+			foreach(l, subplan->args)
+			{
+				get_typlenbyval(exprType((Node *) lfirst(l)),
+								&sstate->cacheParamLens[i],
+								&sstate->cacheParamByVals[i]);
+				i++;
+			}
+
+			if (subplan->subLinkType == EXPR_SUBLINK)
+				get_typlenbyval(subplan->firstColType,
+								&sstate->cacheResultLen,
+								&sstate->cacheResultByVal);
+			else if (subplan->subLinkType == ARRAY_SUBLINK)
+			{
+				/* the result is always an array */
+				sstate->cacheResultLen = -1;
+				sstate->cacheResultByVal = false;
+			}
+			else
+			{
+				/* EXISTS_SUBLINK yields a boolean */
+				sstate->cacheResultLen = sizeof(bool);
+				sstate->cacheResultByVal = true;
+			}
+
+			sstate->cacheContext =
+				AllocSetContextCreate(CurrentMemoryContext,
+									  "SubPlan cache",
+									  ALLOCSET_SMALL_SIZES);
+		}
+		bms_free(parParams);
+	}
 
 	/*
 	 * If this is an initplan, it has output parameters that the parent plan
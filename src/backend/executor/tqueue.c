@@ -8,6 +8,17 @@
  *
  * A TupleQueueReader reads tuples from a shm_mq and returns the tuples.
  *
+ * To reduce the per-tuple overhead of shm_mq message framing, the sender
+ * accumulates tuples into a chunk of up to TQUEUE_CHUNK_SIZE bytes and
+ * transmits each chunk as a single message; the reader iterates over the
+ * tuples within a received chunk.  Tuples larger than the chunk size are
+ * sent as single-tuple messages, which the reader handles identically.
+ *
+ * Tuples are packed into a chunk with no alignment padding between them,
+ * to keep the queue traffic small for narrow rows.  The reader returns a
+ * tuple in place when it happens to fall on a suitably aligned boundary,
+ * and otherwise restores alignment by copying it into a private buffer.
+ *
  * Portions Copyright (c) 1996-2025, PostgreSQL Global Development Group
  * Portions Copyright (c) 1994, Regents of the University of California
  *
@@ -21,6 +32,15 @@
 
 #include "access/htup_details.h"
 #include "executor/tqueue.h"
+#include "utils/memutils.h"
+
+/*
+ * Maximum size of a chunk of batched tuples.  This should be comfortably
+ * smaller than the tuple queue size (currently 64kB, see
+ * PARALLEL_TUPLE_QUEUE_SIZE), so that a full chunk doesn't come close to
+ * filling the ring by itself.
+ */
+#define TQUEUE_CHUNK_SIZE	8192
 
 /*
  * DestReceiver object's private contents
@@ -31,6 +51,8 @@ typedef struct TQueueDestReceiver
 {
 	DestReceiver pub;			/* public fields */
 	shm_mq_handle *queue;		/* shm_mq to send to */
+	char	   *chunk;			/* buffer for batching tuples, or NULL */
+	Size		chunk_used;		/* number of bytes used in chunk */
 } TQueueDestReceiver;
 
 /*
@@ -38,32 +60,39 @@ typedef struct TQueueDestReceiver
  *
  * queue is a pointer to data supplied by reader's caller.
  *
+ * chunk_next and chunk_len track our progress through the most recently
+ * received message, which may contain several tuples.
+ *
  * "typedef struct TupleQueueReader TupleQueueReader" is in tqueue.h
  */
 struct TupleQueueReader
 {
 	shm_mq_handle *queue;		/* shm_mq to receive from */
+	char	   *chunk;			/* most recently received message, or NULL */
+	Size		chunk_len;		/* length of that message */
+	Size		chunk_next;		/* offset of next unreturned tuple */
+	char	   *copybuf;		/* buffer for realigning tuples, or NULL */
+	Size		copybuf_len;	/* allocated size of copybuf */
 };
 
+static MinimalTuple TupleQueueReaderGetTuple(TupleQueueReader *reader);
+
 /*
- * Receive a tuple from a query, and send it to the designated shm_mq.
+ * Send the accumulated chunk of tuples, if any.
  *
  * Returns true if successful, false if shm_mq has been detached.
  */
 static bool
-tqueueReceiveSlot(TupleTableSlot *slot, DestReceiver *self)
+tqueueFlushChunk(TQueueDestReceiver *tqueue)
 {
-	TQueueDestReceiver *tqueue = (TQueueDestReceiver *) self;
-	MinimalTuple tuple;
 	shm_mq_result result;
-	bool		should_free;
 
-	/* Send the tuple itself. */
-	tuple = ExecFetchSlotMinimalTuple(slot, &should_free);
-	result = shm_mq_send(tqueue->queue, tuple->t_len, tuple, false, false);
+	if (tqueue->chunk_used == 0)
+		return true;
 
-	if (should_free)
-		pfree(tuple);
+	result = shm_mq_send(tqueue->queue, tqueue->chunk_used, tqueue->chunk,
+						 false, false);
+	tqueue->chunk_used = 0;
 
 	/* Check for failure. */
 	if (result == SHM_MQ_DETACHED)
@@ -76,6 +105,78 @@ tqueueReceiveSlot(TupleTableSlot *slot, DestReceiver *self)
 	return true;
 }
 
+/*
+ * Receive a tuple from a query, and send it to the designated shm_mq.
+ *
+ * Returns true if successful, false if shm_mq has been detached.
+ */
+static bool
+tqueueReceiveSlot(TupleTableSlot *slot, DestReceiver *self)
+{
+	TQueueDestReceiver *tqueue = (TQueueDestReceiver *) self;
+	MinimalTuple tuple;
+	shm_mq_result result;
+	bool		should_free;
+	Size		span;
+
+	tuple = ExecFetchSlotMinimalTuple(slot, &should_free);
+
+	/*
+	 * Tuples are appended to the chunk back to back, with no alignment
+	 * padding; the reader realigns them as necessary.
+	 */
+	span = tuple->t_len;
+
+	if (span > TQUEUE_CHUNK_SIZE)
+	{
+		/*
+		 * An oversized tuple is sent as a message of its own, preceded by
+		 * whatever we had batched up so as not to reorder tuples.
+		 */
+		if (!tqueueFlushChunk(tqueue))
+		{
+			if (should_free)
+				pfree(tuple);
+			return false;
+		}
+
+		result = shm_mq_send(tqueue->queue, tuple->t_len, tuple, false, false);
+
+		if (should_free)
+			pfree(tuple);
+
+		/* Check for failure. */
+		if (result == SHM_MQ_DETACHED)
+			return false;
+		else if (result != SHM_MQ_SUCCESS)
+			ereport(ERROR,
+					(errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+					 errmsg("could not send tuple to shared-memory queue")));
+
+		return true;
+	}
+
+	/* Flush if the tuple doesn't fit in the current chunk. */
+	if (tqueue->chunk_used + span > TQUEUE_CHUNK_SIZE &&
+		!tqueueFlushChunk(tqueue))
+	{
+		if (should_free)
+			pfree(tuple);
+		return false;
+	}
+
+	if (tqueue->chunk == NULL)
+		tqueue->chunk = palloc(TQUEUE_CHUNK_SIZE);
+
+	memcpy(tqueue->chunk + tqueue->chunk_used, tuple, tuple->t_len);
+	tqueue->chunk_used += span;
+
+	if (should_free)
+		pfree(tuple);
+
+	return true;
+}
+
 /*
  * Prepare to receive tuples from executor.
  */
@@ -94,7 +195,11 @@ tqueueShutdownReceiver(DestReceiver *self)
 	TQueueDestReceiver *tqueue = (TQueueDestReceiver *) self;
 
 	if (tqueue->queue != NULL)
+	{
+		/* Don't care whether the receiver is still attached. */
+		(void) tqueueFlushChunk(tqueue);
 		shm_mq_detach(tqueue->queue);
+	}
 	tqueue->queue = NULL;
 }
 
@@ -109,6 +214,8 @@ tqueueDestroyReceiver(DestReceiver *self)
 	/* We probably already detached from queue, but let's be sure */
 	if (tqueue->queue != NULL)
 		shm_mq_detach(tqueue->queue);
+	if (tqueue->chunk != NULL)
+		pfree(tqueue->chunk);
 	pfree(self);
 }
 
@@ -154,9 +261,46 @@ CreateTupleQueueReader(shm_mq_handle *handle)
 void
 DestroyTupleQueueReader(TupleQueueReader *reader)
 {
+	if (reader->copybuf != NULL)
+		pfree(reader->copybuf);
 	pfree(reader);
 }
 
+/*
+ * Return the next tuple of the current chunk, advancing over it.
+ *
+ * Since tuples are packed into the chunk without padding, the tuple may
+ * start at any offset.  If it happens to be suitably aligned we return it
+ * in place; otherwise we restore alignment by copying it into a private
+ * buffer, which stays valid no longer than the chunk itself would.
+ */
+static MinimalTuple
+TupleQueueReaderGetTuple(TupleQueueReader *reader)
+{
+	char	   *ptr = reader->chunk + reader->chunk_next;
+	uint32		t_len;
+
+	/* The length word may be unaligned too, so fetch it byte-wise. */
+	memcpy(&t_len, ptr, sizeof(uint32));
+	Assert(reader->chunk_next + t_len <= reader->chunk_len);
+	reader->chunk_next += t_len;
+
+	if ((uintptr_t) ptr == MAXALIGN((uintptr_t) ptr))
+		return (MinimalTuple) ptr;
+
+	if (reader->copybuf_len < t_len)
+	{
+		if (reader->copybuf != NULL)
+			pfree(reader->copybuf);
+		reader->copybuf = MemoryContextAlloc(GetMemoryChunkContext(reader),
+											 t_len);
+		reader->copybuf_len = t_len;
+	}
+	memcpy(reader->copybuf, ptr, t_len);
+
+	return (MinimalTuple) reader->copybuf;
+}
+
 /*
  * Fetch a tuple from a tuple queue reader.
  *
@@ -166,7 +310,8 @@ DestroyTupleQueueReader(TupleQueueReader *reader)
  *
  * The returned tuple, if any, is either in shared memory or a private buffer
  * and should not be freed.  The pointer is invalid after the next call to
- * TupleQueueReaderNext().
+ * TupleQueueReaderNext() that has to read a new message, which can happen
+ * no sooner than all tuples of the current chunk have been returned.
  *
  * Even when shm_mq_receive() returns SHM_MQ_WOULD_BLOCK, this can still
  * accumulate bytes from a partially-read message, so it's useful to call
@@ -175,7 +320,6 @@ DestroyTupleQueueReader(TupleQueueReader *reader)
 MinimalTuple
 TupleQueueReaderNext(TupleQueueReader *reader, bool nowait, bool *done)
 {
-	MinimalTuple tuple;
 	shm_mq_result result;
 	Size		nbytes;
 	void	   *data;
@@ -183,6 +327,10 @@ TupleQueueReaderNext(TupleQueueReader *reader, bool nowait, bool *done)
 	if (done != NULL)
 		*done = false;
 
+	/* If tuples remain in the last chunk we received, return the next one. */
+	if (reader->chunk_next < reader->chunk_len)
+		return TupleQueueReaderGetTuple(reader);
+
 	/* Attempt to read a message. */
 	result = shm_mq_receive(reader->queue, &nbytes, &data, nowait);
 
@@ -200,11 +348,12 @@ TupleQueueReaderNext(TupleQueueReader *reader, bool nowait, bool *done)
 	Assert(result == SHM_MQ_SUCCESS);
 
 	/*
-	 * Return a pointer to the queue memory directly (which had better be
-	 * sufficiently aligned).
+	 * Start on the new chunk.  The message may contain further tuples, which
+	 * we'll return from subsequent calls.
 	 */
-	tuple = (MinimalTuple) data;
-	Assert(tuple->t_len == nbytes);
+	reader->chunk = (char *) data;
+	reader->chunk_len = nbytes;
+	reader->chunk_next = 0;
 
-	return tuple;
+	return TupleQueueReaderGetTuple(reader);
 }
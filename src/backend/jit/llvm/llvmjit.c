@@ -324,6 +324,7 @@ llvm_mutable_module(LLVMJitContext *context)
 	{
 		context->compiled = false;
 		context->module_generation = llvm_generation++;
+		context->deform_cache = NIL;
 		context->module = LLVMModuleCreateWithNameInContext("pg", llvm_context);
 		LLVMSetTarget(context->module, llvm_triple);
 		LLVMSetDataLayout(context->module, llvm_layout);
@@ -671,10 +672,17 @@ llvm_optimize_module(LLVMJitContext *context, LLVMModuleRef module)
 	LLVMErrorRef err;
 	const char *passes;
 
+	/*
+	 * For the unoptimized tier, don't run the full O0 pipeline: the code we
+	 * emit only relies on mem2reg (we generate loads/stores to allocas) and
+	 * on always-inline functions getting inlined, which is also all the
+	 * legacy pass manager's O0 setup did.  That keeps compile latency low
+	 * for queries that barely exceed jit_above_cost.
+	 */
 	if (context->base.flags & PGJIT_OPT3)
 		passes = "default<O3>";
 	else
-		passes = "default<O0>,mem2reg";
+		passes = "always-inline,function(mem2reg)";
 
 	options = LLVMCreatePassBuilderOptions();
 
@@ -27,6 +27,23 @@
 #include "jit/llvmjit_emit.h"
 
 
+/*
+ * Key and generated function for one entry in the context's deform_cache.
+ * Several expressions of the same query commonly fetch from slots with the
+ * same descriptor (e.g. the qual and the targetlist of one scan node), so the
+ * identical deform function would otherwise be generated and optimized once
+ * per expression.  The cache is cleared by llvm_mutable_module() whenever a
+ * new module is started, so cached functions always belong to the module
+ * currently open for writing.
+ */
+typedef struct DeformCacheEntry
+{
+	TupleDesc	desc;
+	const TupleTableSlotOps *ops;
+	int			natts;
+	LLVMValueRef fn;
+} DeformCacheEntry;
+
 /*
  * Create a function that deforms a tuple of type desc up to natts columns.
  */
@@ -90,6 +107,9 @@ slot_compile_deform(LLVMJitContext *context, TupleDesc desc,
 
 	int			attnum;
 
+	ListCell   *cell;
+	DeformCacheEntry *entry;
+
 	/* virtual tuples never need deforming, so don't generate code */
 	if (ops == &TTSOpsVirtual)
 		return NULL;
@@ -102,6 +122,15 @@ slot_compile_deform(LLVMJitContext *context, TupleDesc desc,
 	mod = llvm_mutable_module(context);
 	lc = LLVMGetModuleContext(mod);
 
+	/* reuse a previously generated function for the same slot type, if any */
+	foreach(cell, context->deform_cache)
+	{
+		DeformCacheEntry *entry = (DeformCacheEntry *) lfirst(cell);
+
+		if (entry->desc == desc && entry->ops == ops && entry->natts == natts)
+			return entry->fn;
+	}
+
 	funcname = llvm_expand_funcname(context, "deform");
 
 	/*
@@ -760,5 +789,13 @@ slot_compile_deform(LLVMJitContext *context, TupleDesc desc,
 
 	LLVMDisposeBuilder(b);
 
+	/* remember the function for other expressions in this module */
+	entry = palloc_object(DeformCacheEntry);
+	entry->desc = desc;
+	entry->ops = ops;
+	entry->natts = natts;
+	entry->fn = v_deform_fn;
+	context->deform_cache = lappend(context->deform_cache, entry);
+
 	return v_deform_fn;
 }
@@ -664,14 +664,25 @@ llvm_compile_expr(ExprState *state)
 			case EEOP_FUNCEXPR_STRICT:
 			case EEOP_FUNCEXPR_STRICT_1:
 			case EEOP_FUNCEXPR_STRICT_2:
+
+				/*
+				 * The dedicated-comparison opcodes are handled as plain
+				 * strict function calls here; the fcinfo is fully set up for
+				 * the underlying builtin, whose JITed call gets inlined by
+				 * LLVM anyway.
+				 */
+			case EEOP_FUNCEXPR_STRICT_INT4EQ:
+			case EEOP_FUNCEXPR_STRICT_INT4NE:
+			case EEOP_FUNCEXPR_STRICT_INT4LT:
+			case EEOP_FUNCEXPR_STRICT_INT4LE:
+			case EEOP_FUNCEXPR_STRICT_INT4GT:
+			case EEOP_FUNCEXPR_STRICT_INT4GE:
 				{
 					FunctionCallInfo fcinfo = op->d.func.fcinfo_data;
 					LLVMValueRef v_fcinfo_isnull;
 					LLVMValueRef v_retval;
 
-					if (opcode == EEOP_FUNCEXPR_STRICT ||
-						opcode == EEOP_FUNCEXPR_STRICT_1 ||
-						opcode == EEOP_FUNCEXPR_STRICT_2)
+					if (opcode != EEOP_FUNCEXPR)
 					{
 						LLVMBasicBlockRef b_nonull;
 						LLVMBasicBlockRef *b_checkargnulls;
@@ -1711,6 +1722,12 @@ llvm_compile_expr(ExprState *state)
 				LLVMBuildBr(b, opblocks[opno + 1]);
 				break;
 
+			case EEOP_STABLE_CONST:
+				build_EvalXFunc(b, mod, "ExecEvalStableConst",
+								v_state, op, v_econtext);
+				LLVMBuildBr(b, opblocks[opno + 1]);
+				break;
+
 			case EEOP_CURRENTOFEXPR:
 				build_EvalXFunc(b, mod, "ExecEvalCurrentOfExpr",
 								v_state, op);
@@ -164,6 +164,7 @@ void	   *referenced_functions[] =
 	ExecEvalRowNull,
 	ExecEvalCoerceViaIOSafe,
 	ExecEvalSQLValueFunction,
+	ExecEvalStableConst,
 	ExecEvalScalarArrayOp,
 	ExecEvalHashedScalarArrayOp,
 	ExecEvalSubPlan,
@@ -654,6 +654,22 @@ ListenServerPort(int family, const char *hostName, unsigned short portNumber,
 			continue;
 		}
 
+		/*
+		 * Put the socket into non-blocking mode.  The postmaster only calls
+		 * accept() after the socket has been reported ready, but with a
+		 * non-blocking socket it can drain several queued connections per
+		 * wakeup, and a connection that's aborted between the readiness
+		 * report and the accept() call can't block it.
+		 */
+		if (!pg_set_noblock(fd))
+		{
+			ereport(LOG,
+					(errcode_for_socket_access(),
+					 errmsg("could not set socket to nonblocking mode: %m")));
+			closesocket(fd);
+			continue;
+		}
+
 		if (addr->ai_family == AF_UNIX)
 			ereport(LOG,
 					(errmsg("listening on Unix socket \"%s\"",
@@ -785,8 +801,9 @@ Setup_AF_UNIX(const char *sock_path)
  *		server port.  Fills *client_sock with the FD and endpoint info
  *		of the new connection.
  *
- * ASSUME: that this doesn't need to be non-blocking because
- *		the Postmaster waits for the socket to be ready to accept().
+ * The server socket is non-blocking, so the caller may retry until the
+ * pending-connection queue is drained; EWOULDBLOCK is reported as an
+ * ordinary failure without any log noise.
  *
  * RETURNS: STATUS_OK or STATUS_ERROR
  */
@@ -799,6 +816,10 @@ AcceptConnection(pgsocket server_fd, ClientSocket *client_sock)
 									(struct sockaddr *) &client_sock->raddr.addr,
 									&client_sock->raddr.salen)) == PGINVALID_SOCKET)
 	{
+		/* no (more) connections actually pending? */
+		if (errno == EWOULDBLOCK || errno == EAGAIN)
+			return STATUS_ERROR;
+
 		ereport(LOG,
 				(errcode_for_socket_access(),
 				 errmsg("could not accept new connection: %m")));
@@ -1290,9 +1311,13 @@ internal_putbytes(const void *b, size_t len)
 		}
 
 		/*
-		 * If the buffer is empty and data length is larger than the buffer
-		 * size, send it without buffering.  Otherwise, copy as much data as
-		 * possible into the buffer.
+		 * If data length is larger than the buffer size, send it without
+		 * copying it through the buffer.  If the buffer already holds some
+		 * data (for instance the message type and length words of the
+		 * message this data belongs to), top the buffer up and flush it
+		 * first, so that we still hand full-size blocks to the socket and
+		 * the message bytes go out in order.  Otherwise, copy as much data
+		 * as possible into the buffer.
 		 */
 		if (len >= PqSendBufferSize && PqSendStart == PqSendPointer)
 		{
@@ -1302,6 +1327,19 @@ internal_putbytes(const void *b, size_t len)
 			if (internal_flush_buffer(s, &start, &len))
 				return EOF;
 		}
+		else if (len >= PqSendBufferSize)
+		{
+			size_t		amount = PqSendBufferSize - PqSendPointer;
+
+			memcpy(PqSendBuffer + PqSendPointer, s, amount);
+			PqSendPointer += amount;
+			s += amount;
+			len -= amount;
+
+			socket_set_nonblocking(false);
+			if (internal_flush())
+				return EOF;
+		}
 		else
 		{
 			size_t		amount = PqSendBufferSize - PqSendPointer;
@@ -202,6 +202,14 @@ typedef struct PTIterationArray
 	int			index[FLEXIBLE_ARRAY_MEMBER];	/* index array */
 } PTIterationArray;
 
+/*
+ * Number of pages handed out per acquisition of the shared iterator's lock.
+ * Dispensing pages in batches keeps the lock from becoming a point of
+ * contention when many workers drain the same bitmap, while remaining small
+ * enough not to skew the distribution of work near the end of the scan.
+ */
+#define TBM_SHARED_BATCH_SIZE 16
+
 /*
  * same as TBMPrivateIterator, but it is used for joint iteration, therefore
  * this also holds a reference to the shared state.
@@ -212,6 +220,10 @@ struct TBMSharedIterator
 	PTEntryArray *ptbase;		/* pagetable element array */
 	PTIterationArray *ptpages;	/* sorted exact page index list */
 	PTIterationArray *ptchunks; /* sorted lossy page index list */
+	int			batch_next;		/* next unreturned batch[] entry */
+	int			batch_count;	/* number of valid batch[] entries */
+	bool		exhausted;		/* shared state has run dry */
+	TBMIterateResult batch[TBM_SHARED_BATCH_SIZE];	/* locally dispensed pages */
 };
 
 /* Local function prototypes */
@@ -227,6 +239,8 @@ static void tbm_lossify(TIDBitmap *tbm);
 static int	tbm_comparator(const void *left, const void *right);
 static int	tbm_shared_comparator(const void *left, const void *right,
 								  void *arg);
+static bool tbm_shared_iterate_one(TBMSharedIterator *iterator,
+								   TBMIterateResult *tbmres);
 
 /* define hashtable mapping block numbers to PagetableEntry's */
 #define SH_USE_NONDEFAULT_ALLOCATOR
@@ -1050,11 +1064,68 @@ tbm_private_iterate(TBMPrivateIterator *iterator, TBMIterateResult *tbmres)
  *	tbm_shared_iterate - scan through next page of a TIDBitmap
  *
  *	As above, but this will iterate using an iterator which is shared
- *	across multiple processes.  We need to acquire the iterator LWLock,
- *	before accessing the shared members.
+ *	across multiple processes.  To keep the iterator LWLock from becoming a
+ *	bottleneck, each acquisition dispenses a batch of up to
+ *	TBM_SHARED_BATCH_SIZE pages into the backend-local iterator, and
+ *	subsequent calls are served from there without touching the shared
+ *	state.
  */
 bool
 tbm_shared_iterate(TBMSharedIterator *iterator, TBMIterateResult *tbmres)
+{
+	TBMSharedIteratorState *istate = iterator->state;
+
+	/* serve any pages remaining from the current batch, without the lock */
+	if (iterator->batch_next < iterator->batch_count)
+	{
+		*tbmres = iterator->batch[iterator->batch_next++];
+		return true;
+	}
+
+	if (iterator->exhausted)
+	{
+		tbmres->blockno = InvalidBlockNumber;
+		return false;
+	}
+
+	/* Acquire the LWLock before accessing the shared members */
+	LWLockAcquire(&istate->lock, LW_EXCLUSIVE);
+
+	iterator->batch_next = 0;
+	iterator->batch_count = 0;
+
+	while (iterator->batch_count < TBM_SHARED_BATCH_SIZE)
+	{
+		if (!tbm_shared_iterate_one(iterator,
+									&iterator->batch[iterator->batch_count]))
+		{
+			iterator->exhausted = true;
+			break;
+		}
+		iterator->batch_count++;
+	}
+
+	LWLockRelease(&istate->lock);
+
+	if (iterator->batch_count == 0)
+	{
+		/* Nothing more in the bitmap */
+		tbmres->blockno = InvalidBlockNumber;
+		return false;
+	}
+
+	*tbmres = iterator->batch[iterator->batch_next++];
+	return true;
+}
+
+/*
+ * tbm_shared_iterate_one - fetch the next page from the shared state
+ *
+ * Caller must hold the shared iterator's lock.  Returns false if the bitmap
+ * is exhausted.
+ */
+static bool
+tbm_shared_iterate_one(TBMSharedIterator *iterator, TBMIterateResult *tbmres)
 {
 	TBMSharedIteratorState *istate = iterator->state;
 	PagetableEntry *ptbase = NULL;
@@ -1068,9 +1139,6 @@ tbm_shared_iterate(TBMSharedIterator *iterator, TBMIterateResult *tbmres)
 	if (iterator->ptchunks != NULL)
 		idxchunks = iterator->ptchunks->index;
 
-	/* Acquire the LWLock before accessing the shared members */
-	LWLockAcquire(&istate->lock, LW_EXCLUSIVE);
-
 	/*
 	 * If lossy chunk pages remain, make sure we've advanced schunkptr/
 	 * schunkbit to the next set bit.
@@ -1112,7 +1180,6 @@ tbm_shared_iterate(TBMSharedIterator *iterator, TBMIterateResult *tbmres)
 			tbmres->internal_page = NULL;
 			istate->schunkbit++;
 
-			LWLockRelease(&istate->lock);
 			return true;
 		}
 	}
@@ -1127,13 +1194,9 @@ tbm_shared_iterate(TBMSharedIterator *iterator, TBMIterateResult *tbmres)
 		tbmres->recheck = page->recheck;
 		istate->spageptr++;
 
-		LWLockRelease(&istate->lock);
-
 		return true;
 	}
 
-	LWLockRelease(&istate->lock);
-
 	/* Nothing more in the bitmap */
 	tbmres->blockno = InvalidBlockNumber;
 	return false;
@@ -14,6 +14,7 @@
  */
 #include "postgres.h"
 
+#include "catalog/pg_operator.h"
 #include "nodes/nodeFuncs.h"
 #include "optimizer/clauses.h"
 #include "optimizer/optimizer.h"
@@ -864,16 +865,39 @@ clause_selectivity_ext(PlannerInfo *root,
 	{
 		FuncExpr   *funcclause = (FuncExpr *) clause;
 
-		/* Try to get an estimate from the support function, if any */
-		s1 = function_selectivity(root,
-								  funcclause->funcid,
-								  funcclause->args,
-								  funcclause->inputcollid,
-								  treat_as_join_clause(root, clause, rinfo,
-													   varRelid, sjinfo),
-								  varRelid,
-								  jointype,
-								  sjinfo);
+		if (OidIsValid(get_func_support(funcclause->funcid)))
+		{
+			/* Get an estimate from the support function */
+			s1 = function_selectivity(root,
+									  funcclause->funcid,
+									  funcclause->args,
+									  funcclause->inputcollid,
+									  treat_as_join_clause(root, clause, rinfo,
+														   varRelid, sjinfo),
+									  varRelid,
+									  jointype,
+									  sjinfo);
+		}
+		else
+		{
+			VariableStatData vardata;
+
+			/*
+			 * No support function, but the whole expression may still have
+			 * statistics if it matches an expression index column or an
+			 * extended-statistics expression.  If so, estimate it like a
+			 * boolean variable, i.e. as though the clause were "expr = true"
+			 * (compare boolvarsel); otherwise fall back on the historical
+			 * default that function_selectivity would use.
+			 */
+			examine_variable(root, clause, varRelid, &vardata);
+			if (HeapTupleIsValid(vardata.statsTuple))
+				s1 = var_eq_const(&vardata, BooleanEqualOperator, InvalidOid,
+								  BoolGetDatum(true), false, true, false);
+			else
+				s1 = (Selectivity) 0.3333333;
+			ReleaseVariableStats(vardata);
+		}
 	}
 	else if (IsA(clause, ScalarArrayOpExpr))
 	{
@@ -1367,6 +1367,7 @@ cost_tidrangescan(Path *path, PlannerInfo *root,
 	Selectivity selectivity;
 	double		pages;
 	Cost		startup_cost = 0;
+	Cost		cpu_run_cost;
 	Cost		run_cost = 0;
 	QualCost	qpqual_cost;
 	Cost		cpu_per_tuple;
@@ -1432,11 +1433,28 @@ cost_tidrangescan(Path *path, PlannerInfo *root,
 	startup_cost += qpqual_cost.startup + tid_qual_cost.per_tuple;
 	cpu_per_tuple = cpu_tuple_cost + qpqual_cost.per_tuple -
 		tid_qual_cost.per_tuple;
-	run_cost += cpu_per_tuple * ntuples;
+	cpu_run_cost = cpu_per_tuple * ntuples;
 
 	/* tlist eval costs are paid per output row, not per tuple scanned */
 	startup_cost += path->pathtarget->cost.startup;
-	run_cost += path->pathtarget->cost.per_tuple * path->rows;
+	cpu_run_cost += path->pathtarget->cost.per_tuple * path->rows;
+
+	/* Adjust costing for parallelism, if used. */
+	if (path->parallel_workers > 0)
+	{
+		double		parallel_divisor = get_parallel_divisor(path);
+
+		/* The CPU cost is divided among all the workers. */
+		cpu_run_cost /= parallel_divisor;
+
+		/*
+		 * In the case of a parallel plan, the row count needs to represent
+		 * the number of tuples processed per worker.
+		 */
+		path->rows = clamp_row_est(path->rows / parallel_divisor);
+	}
+
+	run_cost += cpu_run_cost;
 
 	/* we should not generate this path type when enable_tidscan=false */
 	Assert(enable_tidscan);
@@ -81,6 +81,8 @@ static bool reconsider_outer_join_clause(PlannerInfo *root,
 static bool reconsider_full_join_clause(PlannerInfo *root,
 										OuterJoinClauseInfo *ojcinfo);
 static JoinDomain *find_join_domain(PlannerInfo *root, Relids relids);
+static Bitmapset *get_eclass_indexes_for_rel(PlannerInfo *root,
+											 RelOptInfo *rel);
 static Bitmapset *get_eclass_indexes_for_relids(PlannerInfo *root,
 												Relids relids);
 static Bitmapset *get_common_eclass_indexes(PlannerInfo *root, Relids relids1,
@@ -3383,8 +3385,8 @@ have_relevant_eclass_joinclause(PlannerInfo *root,
 	 * sufficient reason to prioritize this join over other ones.  The join
 	 * ordering rules will force the join to be made when necessary.
 	 */
-	matching_ecs = get_common_eclass_indexes(root, rel1->relids,
-											 rel2->relids);
+	matching_ecs = bms_intersect(get_eclass_indexes_for_rel(root, rel1),
+								 get_eclass_indexes_for_rel(root, rel2));
 
 	i = -1;
 	while ((i = bms_next_member(matching_ecs, i)) >= 0)
@@ -3393,8 +3395,8 @@ have_relevant_eclass_joinclause(PlannerInfo *root,
 															 i);
 
 		/*
-		 * Sanity check that get_common_eclass_indexes gave only ECs
-		 * containing both rels.
+		 * Sanity check that the intersection gave only ECs containing both
+		 * rels.
 		 */
 		Assert(bms_overlap(rel1->relids, ec->ec_relids));
 		Assert(bms_overlap(rel2->relids, ec->ec_relids));
@@ -3409,8 +3411,8 @@ have_relevant_eclass_joinclause(PlannerInfo *root,
 		/*
 		 * We do not need to examine the individual members of the EC, because
 		 * all that we care about is whether each rel overlaps the relids of
-		 * at least one member, and get_common_eclass_indexes() and the single
-		 * member check above are sufficient to prove that.  (As with
+		 * at least one member, and the eclass-index intersection and the
+		 * single member check above are sufficient to prove that.  (As with
 		 * have_relevant_joinclause(), it is not necessary that the EC be able
 		 * to form a joinclause relating exactly the two given rels, only that
 		 * it be able to form a joinclause mentioning both, and this will
@@ -3449,7 +3451,7 @@ has_relevant_eclass_joinclause(PlannerInfo *root, RelOptInfo *rel1)
 	int			i;
 
 	/* Examine only eclasses mentioning rel1 */
-	matched_ecs = get_eclass_indexes_for_relids(root, rel1->relids);
+	matched_ecs = get_eclass_indexes_for_rel(root, rel1);
 
 	i = -1;
 	while ((i = bms_next_member(matched_ecs, i)) >= 0)
@@ -3604,6 +3606,40 @@ is_redundant_with_indexclauses(RestrictInfo *rinfo, List *indexclauses)
 	return false;
 }
 
+/*
+ * get_eclass_indexes_for_rel
+ *		Return a Bitmapset containing the indexes into root's eq_classes
+ *		list for all eclasses that mention this rel.
+ *
+ * For simple rels this is just the eagerly-maintained eclass_indexes set.
+ * For join rels, which don't have that set maintained for them, we compute
+ * it on first use and cache it in the RelOptInfo, so that repeated tests
+ * against the same join rel (as happens throughout a join search level)
+ * don't rebuild the union of its base rels' sets each time.  New eclasses
+ * can still appear during path generation (e.g., from
+ * get_eclass_for_sort_expr), so we remember how many eclasses the cache
+ * accounts for and recompute if more exist now.
+ *
+ * The result is cached, so callers must not modify it.
+ */
+static Bitmapset *
+get_eclass_indexes_for_rel(PlannerInfo *root, RelOptInfo *rel)
+{
+	int			num_ecs = list_length(root->eq_classes);
+
+	/* Simple rels have eclass_indexes maintained as eclasses are built */
+	if (!IS_JOIN_REL(rel))
+		return rel->eclass_indexes;
+
+	if (rel->eclass_indexes_upto < num_ecs)
+	{
+		/* Stale or never filled; recompute from the component rels */
+		rel->eclass_indexes = get_eclass_indexes_for_relids(root, rel->relids);
+		rel->eclass_indexes_upto = num_ecs;
+	}
+	return rel->eclass_indexes;
+}
+
 /*
  * get_eclass_indexes_for_relids
  *		Build and return a Bitmapset containing the indexes into root's
@@ -488,6 +488,31 @@ ec_member_matches_ctid(PlannerInfo *root, RelOptInfo *rel,
 	return false;
 }
 
+/*
+ * create_parallel_tidrangescan_paths
+ *	  Generate parallel partial TID range scan paths for the given rel.
+ *
+ *	  Partial paths are added to the rel's partial_pathlist.
+ */
+static void
+create_parallel_tidrangescan_paths(PlannerInfo *root, RelOptInfo *rel,
+								   List *tidrangequals)
+{
+	int			parallel_workers;
+
+	parallel_workers = compute_parallel_worker(rel, rel->pages, -1,
+											   max_parallel_workers_per_gather);
+
+	/* If any limit was set to zero, the user doesn't want a parallel scan. */
+	if (parallel_workers <= 0)
+		return;
+
+	add_partial_path(rel, (Path *) create_tidrangescan_path(root, rel,
+															tidrangequals,
+															NULL,
+															parallel_workers));
+}
+
 /*
  * create_tidscan_paths
  *	  Create paths corresponding to direct TID scans of the given rel.
@@ -553,7 +578,12 @@ create_tidscan_paths(PlannerInfo *root, RelOptInfo *rel)
 
 		add_path(rel, (Path *) create_tidrangescan_path(root, rel,
 														tidrangequals,
-														required_outer));
+														required_outer,
+														0));
+
+		/* If appropriate, consider parallel TID range scan. */
+		if (rel->consider_parallel && required_outer == NULL)
+			create_parallel_tidrangescan_paths(root, rel, tidrangequals);
 	}
 
 	/*
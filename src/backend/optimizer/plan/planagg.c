@@ -33,6 +33,7 @@
 #include "catalog/pg_type.h"
 #include "nodes/makefuncs.h"
 #include "nodes/nodeFuncs.h"
+#include "optimizer/clauses.h"
 #include "optimizer/cost.h"
 #include "optimizer/optimizer.h"
 #include "optimizer/pathnode.h"
@@ -272,11 +273,16 @@ can_minmax_aggs(PlannerInfo *root, List **context)
 		/* note: we do not care if DISTINCT is mentioned ... */
 
 		/*
-		 * We might implement the optimization when a FILTER clause is present
-		 * by adding the filter to the quals of the generated subquery.  For
-		 * now, just punt.
+		 * We can implement the optimization when a FILTER clause is present
+		 * by adding the filter to the quals of the generated subquery.  That
+		 * only works if evaluating the filter there can't change the
+		 * results, so punt if it contains volatile functions; and we don't
+		 * wish to reason about how SubPlans would need to be adjusted for
+		 * the move, so punt on those too.
 		 */
-		if (aggref->aggfilter != NULL)
+		if (aggref->aggfilter != NULL &&
+			(contain_volatile_functions((Node *) aggref->aggfilter) ||
+			 contain_subplans((Node *) aggref->aggfilter)))
 			return false;
 
 		aggsortop = fetch_agg_sort_op(aggref->aggfnoid);
@@ -295,6 +301,7 @@ can_minmax_aggs(PlannerInfo *root, List **context)
 		mminfo->aggfnoid = aggref->aggfnoid;
 		mminfo->aggsortop = aggsortop;
 		mminfo->target = curTarget->expr;
+		mminfo->aggfilter = aggref->aggfilter;
 		mminfo->subroot = NULL; /* don't compute path yet */
 		mminfo->path = NULL;
 		mminfo->pathcost = 0;
@@ -362,7 +369,7 @@ build_minmax_path(PlannerInfo *root, MinMaxAggInfo *mminfo,
 	/*----------
 	 * Generate modified query of the form
 	 *		(SELECT col FROM tab
-	 *		 WHERE col IS NOT NULL AND existing-quals
+	 *		 WHERE col IS NOT NULL AND agg-filter AND existing-quals
 	 *		 ORDER BY col ASC/DESC
 	 *		 LIMIT 1)
 	 *----------
@@ -395,6 +402,17 @@ build_minmax_path(PlannerInfo *root, MinMaxAggInfo *mminfo,
 		parse->jointree->quals = (Node *)
 			lcons(ntest, (List *) parse->jointree->quals);
 
+	/* Add the aggregate's FILTER expression, if any, to the quals */
+	if (mminfo->aggfilter)
+	{
+		Node	   *filter = (Node *) copyObject(mminfo->aggfilter);
+
+		/* Any outer references are now one level higher than before */
+		IncrementVarSublevelsUp(filter, 1, 1);
+		parse->jointree->quals = (Node *)
+			lcons(filter, (List *) parse->jointree->quals);
+	}
+
 	/* Build suitable ORDER BY clause */
 	sortcl = makeNode(SortGroupClause);
 	sortcl->tleSortGroupRef = assignSortGroupRef(tle, subroot->processed_tlist);
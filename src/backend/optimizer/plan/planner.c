@@ -4131,12 +4131,13 @@ consider_groupingsets_paths(PlannerInfo *root,
 	 * If we're not being offered sorted input, then only consider plans that
 	 * can be done entirely by hashing.
 	 *
-	 * We can hash everything if it looks like it'll fit in hash_mem. But if
-	 * the input is actually sorted despite not being advertised as such, we
-	 * prefer to make use of that in order to use less memory.
-	 *
-	 * If none of the grouping sets are sortable, then ignore the hash_mem
-	 * limit and generate a path anyway, since otherwise we'll just fail.
+	 * Hash aggregation can spill to disk, so we generate this path even when
+	 * the estimated table size exceeds hash_mem; the spill costs charged by
+	 * cost_agg() let it compete fairly against the sorted and mixed paths
+	 * built from sorted input, which must re-sort the input once per
+	 * non-hashed rollup.  But if the input is actually sorted despite not
+	 * being advertised as such, we prefer to make use of that in order to use
+	 * less memory.
 	 */
 	if (!is_sorted)
 	{
@@ -4148,8 +4149,6 @@ consider_groupingsets_paths(PlannerInfo *root,
 		ListCell   *lc;
 		ListCell   *l_start = list_head(gd->rollups);
 		AggStrategy strat = AGG_HASHED;
-		double		hashsize;
-		double		exclude_groups = 0.0;
 
 		Assert(can_hash);
 
@@ -4177,23 +4176,9 @@ consider_groupingsets_paths(PlannerInfo *root,
 			pathkeys_contained_in(root->group_pathkeys, path->pathkeys))
 		{
 			unhashed_rollup = lfirst_node(RollupData, l_start);
-			exclude_groups = unhashed_rollup->numGroups;
 			l_start = lnext(gd->rollups, l_start);
 		}
 
-		hashsize = estimate_hashagg_tablesize(root,
-											  path,
-											  agg_costs,
-											  dNumGroups - exclude_groups);
-
-		/*
-		 * gd->rollups is empty if we have only unsortable columns to work
-		 * with.  Override hash_mem in that case; otherwise, we'll rely on the
-		 * sorted-input case to generate usable mixed paths.
-		 */
-		if (hashsize > hash_mem_limit && gd->rollups)
-			return;				/* nope, won't fit */
-
 		/*
 		 * We need to burst the existing rollups list into individual grouping
 		 * sets and recompute a groupClause for each set.
@@ -4813,6 +4798,8 @@ create_partial_distinct_paths(PlannerInfo *root, RelOptInfo *input_rel,
 	List	   *distinctExprs;
 	double		numDistinctRows;
 	Path	   *cheapest_partial_path;
+	bool		can_sort;
+	bool		can_hash;
 	ListCell   *lc;
 
 	/* nothing to do when there are no partial paths in the input rel */
@@ -4825,6 +4812,20 @@ create_partial_distinct_paths(PlannerInfo *root, RelOptInfo *input_rel,
 	if (parse->hasDistinctOn)
 		return;
 
+	/*
+	 * Determine up front whether sorted and/or hashed partial paths are
+	 * possible; if neither is, there's no point in building the partial
+	 * distinct rel or estimating the number of groups.  Note that we treat
+	 * enable_hashagg as a hard off-switch here, since we're not on the hook
+	 * to produce at least one path; create_final_distinct_paths applies the
+	 * slightly softer variant.
+	 */
+	can_sort = grouping_is_sortable(root->processed_distinctClause);
+	can_hash = enable_hashagg &&
+		grouping_is_hashable(root->processed_distinctClause);
+	if (!can_sort && !can_hash)
+		return;
+
 	partial_distinct_rel = fetch_upper_rel(root, UPPERREL_PARTIAL_DISTINCT,
 										   NULL);
 	partial_distinct_rel->reltarget = target;
@@ -4855,7 +4856,7 @@ create_partial_distinct_paths(PlannerInfo *root, RelOptInfo *input_rel,
 	 * pathkeys as much as possible, in hopes of avoiding a possible need to
 	 * re-sort.
 	 */
-	if (grouping_is_sortable(root->processed_distinctClause))
+	if (can_sort)
 	{
 		foreach(lc, input_rel->partial_pathlist)
 		{
@@ -4926,13 +4927,8 @@ create_partial_distinct_paths(PlannerInfo *root, RelOptInfo *input_rel,
 		}
 	}
 
-	/*
-	 * Now try hash aggregate paths, if enabled and hashing is possible. Since
-	 * we're not on the hook to ensure we do our best to create at least one
-	 * path here, we treat enable_hashagg as a hard off-switch rather than the
-	 * slightly softer variant in create_final_distinct_paths.
-	 */
-	if (enable_hashagg && grouping_is_hashable(root->processed_distinctClause))
+	/* Now try hash aggregate paths, if possible */
+	if (can_hash)
 	{
 		add_partial_path(partial_distinct_rel, (Path *)
 						 create_agg_path(root,
@@ -7256,6 +7252,18 @@ add_paths_to_grouping_rel(PlannerInfo *root, RelOptInfo *input_rel,
  * have been partially aggregated but require a subsequent FinalizeAggregate
  * step.
  *
+ * Note that the partial aggregation performed here always sits above the
+ * complete scan/join tree.  Pushing a partial aggregate below a join
+ * ("eager aggregation", attractive when a huge fact table is joined to
+ * small dimensions and then grouped) cannot be bolted on at this stage: a
+ * join above a partial aggregate can duplicate partially-aggregated groups
+ * (double-counting them at finalization) or filter rows out of them, so
+ * the partial grouping keys must be widened with the fact side's join
+ * columns, the other side must be proven unique over them, and such paths
+ * must be costed against plain ones while the join search runs.  That
+ * requires carrying separate grouped RelOptInfos through the entire join
+ * search, not a variant path here.
+ *
  * NB: This function is allowed to return NULL if it determines that there is
  * no real need to create a new RelOptInfo.
  */
@@ -3527,7 +3527,8 @@ find_minmax_agg_replacement_param(PlannerInfo *root, Aggref *aggref)
 			MinMaxAggInfo *mminfo = (MinMaxAggInfo *) lfirst(lc);
 
 			if (mminfo->aggfnoid == aggref->aggfnoid &&
-				equal(mminfo->target, curTarget->expr))
+				equal(mminfo->target, curTarget->expr) &&
+				equal(mminfo->aggfilter, aggref->aggfilter))
 				return mminfo->param;
 		}
 	}
@@ -86,6 +86,8 @@ static bool test_opexpr_is_hashable(OpExpr *testexpr, List *param_ids);
 static bool hash_ok_operator(OpExpr *expr);
 static bool contain_dml(Node *node);
 static bool contain_dml_walker(Node *node, void *context);
+static bool contain_uncacheable_subplan(Node *node);
+static bool contain_uncacheable_subplan_walker(Node *node, void *context);
 static bool contain_outer_selfref(Node *node);
 static bool contain_outer_selfref_walker(Node *node, Index *depth);
 static void inline_cte(PlannerInfo *root, CommonTableExpr *cte);
@@ -340,6 +342,19 @@ build_subplan(PlannerInfo *root, Plan *plan, Path *path,
 	splan->useHashTable = false;
 	splan->unknownEqFalse = unknownEqFalse;
 	splan->parallel_safe = plan->parallel_safe;
+
+	/*
+	 * The executor may cache the subplan's result across evaluations with
+	 * identical parameter values, but only if the result is fully determined
+	 * by those values.  Check the preprocessed subquery for volatile
+	 * functions.  contain_volatile_functions() doesn't look into already-made
+	 * SubPlans, so check any embedded ones via their own cacheable flags
+	 * (which were computed when they were built, since lower subqueries are
+	 * planned before upper ones).
+	 */
+	splan->cacheable = !contain_volatile_functions((Node *) subroot->parse) &&
+		!contain_uncacheable_subplan((Node *) subroot->parse);
+
 	splan->setParam = NIL;
 	splan->parParam = NIL;
 	splan->args = NIL;
@@ -1076,6 +1091,40 @@ contain_dml_walker(Node *node, void *context)
 	return expression_tree_walker(node, contain_dml_walker, context);
 }
 
+/*
+ * contain_uncacheable_subplan: is any embedded SubPlan not marked cacheable?
+ *
+ * This fills the gap left by contain_volatile_functions(), which doesn't
+ * look into the plans of already-built SubPlans.  (It does examine their
+ * testexprs and args, so we needn't repeat that here.)
+ */
+static bool
+contain_uncacheable_subplan(Node *node)
+{
+	return contain_uncacheable_subplan_walker(node, NULL);
+}
+
+static bool
+contain_uncacheable_subplan_walker(Node *node, void *context)
+{
+	if (node == NULL)
+		return false;
+	if (IsA(node, SubPlan))
+	{
+		SubPlan    *subplan = (SubPlan *) node;
+
+		if (!subplan->cacheable)
+			return true;
+		/* else fall through to examine its testexpr and args */
+	}
+	if (IsA(node, Query))
+		return query_tree_walker((Query *) node,
+								 contain_uncacheable_subplan_walker,
+								 context, 0);
+	return expression_tree_walker(node, contain_uncacheable_subplan_walker,
+								  context);
+}
+
 /*
  * contain_outer_selfref: is there an external recursive self-reference?
  */
@@ -106,6 +106,7 @@ static bool contain_nonstrict_functions_walker(Node *node, void *context);
 static bool contain_exec_param_walker(Node *node, List *param_ids);
 static bool contain_context_dependent_node(Node *clause);
 static bool contain_context_dependent_node_walker(Node *node, int *flags);
+static bool stable_const_expression_walker(Node *node, void *context);
 static bool contain_leaked_vars_walker(Node *node, void *context);
 static Relids find_nonnullable_rels_walker(Node *node, bool top_level);
 static List *find_nonnullable_vars_walker(Node *node, bool top_level);
@@ -1245,6 +1246,84 @@ contain_context_dependent_node_walker(Node *node, int *flags)
 								  flags);
 }
 
+/*****************************************************************************
+ *		Check clauses for stable-constant-ness
+ *****************************************************************************/
+
+/*
+ * is_stable_const_expression
+ *	  Detect whether an expression is certain to compute the same value,
+ *	  with no side effects, every time it is evaluated within one execution
+ *	  of a plan.
+ *
+ * This is the property the executor needs in order to evaluate an
+ * expression once per execution and replay the result (see
+ * EEOP_STABLE_CONST in execExpr.c).  Stable and immutable functions
+ * qualify, as do PARAM_EXTERN Params, whose values are fixed for the life
+ * of an executor invocation.  Vars, volatile or set-returning functions,
+ * Params that can change at runtime, sub-selects, and nodes whose value
+ * depends on context established elsewhere in a larger expression all
+ * disqualify the clause.
+ *
+ * Like contain_volatile_functions(), this expects an expression tree that
+ * has been through expression preprocessing.
+ */
+bool
+is_stable_const_expression(Node *clause)
+{
+	if (expression_returns_set(clause))
+		return false;
+	return !stable_const_expression_walker(clause, NULL);
+}
+
+static bool
+stable_const_expression_walker(Node *node, void *context)
+{
+	if (node == NULL)
+		return false;
+
+	switch (nodeTag(node))
+	{
+			/*
+			 * These produce values that can vary across evaluations within
+			 * one execution, or depend on evaluation context that we cannot
+			 * see from here.  CoerceToDomain is rejected because the
+			 * domain's CHECK expressions are not visible in the tree, so we
+			 * can't vouch for their volatility.
+			 */
+		case T_Var:
+		case T_Aggref:
+		case T_GroupingFunc:
+		case T_WindowFunc:
+		case T_MergeSupportFunc:
+		case T_SubLink:
+		case T_SubPlan:
+		case T_AlternativeSubPlan:
+		case T_CaseTestExpr:
+		case T_CoerceToDomain:
+		case T_CoerceToDomainValue:
+		case T_CurrentOfExpr:
+		case T_NextValueExpr:
+		case T_ReturningExpr:
+			return true;
+
+		case T_Param:
+			/* only extern Params are fixed for the whole execution */
+			return ((Param *) node)->paramkind != PARAM_EXTERN;
+
+		default:
+			break;
+	}
+
+	/* Reject volatile functions; stable and immutable ones are fine */
+	if (check_functions_in_node(node, contain_volatile_functions_checker,
+								context))
+		return true;
+
+	return expression_tree_walker(node, stable_const_expression_walker,
+								  context);
+}
+
 /*****************************************************************************
  *		  Check clauses for Vars passed to non-leakproof functions
  *****************************************************************************/
@@ -102,6 +102,11 @@ static PartitionBoundInfo create_list_bounds(PartitionBoundSpec **boundspecs,
 											 int nparts, PartitionKey key, int **mapping);
 static PartitionBoundInfo create_range_bounds(PartitionBoundSpec **boundspecs,
 											  int nparts, PartitionKey key, int **mapping);
+static PartitionBoundInfo merge_hash_bounds(RelOptInfo *outer_rel,
+											RelOptInfo *inner_rel,
+											JoinType jointype,
+											List **outer_parts,
+											List **inner_parts);
 static PartitionBoundInfo merge_list_bounds(FmgrInfo *partsupfunc,
 											Oid *partcollation,
 											RelOptInfo *outer_rel,
@@ -1138,20 +1143,21 @@ partition_bounds_merge(int partnatts,
 		case PARTITION_STRATEGY_HASH:
 
 			/*
-			 * For hash partitioned tables, we currently support partitioned
-			 * join only when they have exactly the same partition bounds.
+			 * For hash partitioned tables, we support partitioned join when
+			 * both sides' partitions all have the same modulus; one side may
+			 * have partitions missing (e.g. after DETACH).
 			 *
-			 * XXX: it might be possible to relax the restriction to support
-			 * cases where hash partitioned tables have missing partitions
-			 * and/or different moduli, but it's not clear if it would be
-			 * useful to support the former case since it's unusual to have
-			 * missing partitions.  On the other hand, it would be useful to
-			 * support the latter case, but in that case, there is a high
-			 * probability that a partition on one side will match multiple
-			 * partitions on the other side, which is the scenario the current
-			 * implementation of partitioned join can't handle.
+			 * XXX: it might be possible to support different moduli as well,
+			 * but in that case, there is a high probability that a partition
+			 * on one side will match multiple partitions on the other side,
+			 * which is the scenario the current implementation of
+			 * partitioned join can't handle.
 			 */
-			return NULL;
+			return merge_hash_bounds(outer_rel,
+									 inner_rel,
+									 jointype,
+									 outer_parts,
+									 inner_parts);
 
 		case PARTITION_STRATEGY_LIST:
 			return merge_list_bounds(partsupfunc,
@@ -1176,6 +1182,245 @@ partition_bounds_merge(int partnatts,
 	return NULL;
 }
 
+/*
+ * merge_hash_bounds
+ *		Create the partition bounds for a join relation between hash
+ *		partitioned tables, if possible
+ *
+ * We handle the case where every partition on both sides has the same
+ * modulus: each partition then covers exactly one remainder, so a partition
+ * on one side matches at most the one partition covering the same remainder
+ * on the other side.  A remainder covered on only one side has no rows on
+ * the other side at all, so for an inner join the pair is simply omitted; on
+ * the non-nullable side of an outer join the partition is instead matched
+ * with a dummy partition.  With differing moduli a partition on one side can
+ * match multiple partitions on the other, which the current implementation
+ * of partitioned join can't handle, so we give up.
+ */
+static PartitionBoundInfo
+merge_hash_bounds(RelOptInfo *outer_rel, RelOptInfo *inner_rel,
+				  JoinType jointype,
+				  List **outer_parts, List **inner_parts)
+{
+	PartitionBoundInfo merged_bounds = NULL;
+	PartitionBoundInfo outer_bi = outer_rel->boundinfo;
+	PartitionBoundInfo inner_bi = inner_rel->boundinfo;
+	PartitionMap outer_map;
+	PartitionMap inner_map;
+	int			outer_pos;
+	int			inner_pos;
+	int			next_index = 0;
+	int			default_index = -1;
+	List	   *merged_datums = NIL;
+	List	   *merged_indexes = NIL;
+	int			i;
+
+	Assert(*outer_parts == NIL);
+	Assert(*inner_parts == NIL);
+	Assert(outer_bi->strategy == inner_bi->strategy &&
+		   outer_bi->strategy == PARTITION_STRATEGY_HASH);
+	/* Hash partitioning doesn't require kinds, null or default partitions. */
+	Assert(!outer_bi->kind && !inner_bi->kind);
+	Assert(!partition_bound_has_default(outer_bi) &&
+		   !partition_bound_has_default(inner_bi));
+
+	/* The greatest moduli have to agree, ... */
+	if (outer_bi->nindexes != inner_bi->nindexes)
+		return NULL;
+
+	/* ... and every partition on both sides must have that modulus. */
+	for (i = 0; i < outer_bi->ndatums; i++)
+	{
+		if (DatumGetInt32(outer_bi->datums[i][0]) != outer_bi->nindexes)
+			return NULL;
+	}
+	for (i = 0; i < inner_bi->ndatums; i++)
+	{
+		if (DatumGetInt32(inner_bi->datums[i][0]) != inner_bi->nindexes)
+			return NULL;
+	}
+
+	init_partition_map(outer_rel, &outer_map);
+	init_partition_map(inner_rel, &inner_map);
+
+	/*
+	 * Merge partitions from both sides.  The datums are sorted by remainder,
+	 * so this is a simple merge-join-like pass over the two bounds.
+	 */
+	outer_pos = inner_pos = 0;
+	while (outer_pos < outer_bi->ndatums || inner_pos < inner_bi->ndatums)
+	{
+		int			outer_index = -1;
+		int			inner_index = -1;
+		int			cmpval;
+		Datum	   *merged_datum = NULL;
+		int			merged_index = -1;
+
+		if (outer_pos < outer_bi->ndatums)
+		{
+			/*
+			 * If the partition on the outer side has been proven empty,
+			 * ignore it and move to the next datum on the outer side.
+			 */
+			outer_index = outer_bi->indexes[DatumGetInt32(outer_bi->datums[outer_pos][1])];
+			if (is_dummy_partition(outer_rel, outer_index))
+			{
+				outer_pos++;
+				continue;
+			}
+		}
+		if (inner_pos < inner_bi->ndatums)
+		{
+			/*
+			 * If the partition on the inner side has been proven empty,
+			 * ignore it and move to the next datum on the inner side.
+			 */
+			inner_index = inner_bi->indexes[DatumGetInt32(inner_bi->datums[inner_pos][1])];
+			if (is_dummy_partition(inner_rel, inner_index))
+			{
+				inner_pos++;
+				continue;
+			}
+		}
+
+		/* As in merge_list_bounds, run this loop till both sides finish. */
+		if (outer_pos >= outer_bi->ndatums)
+			cmpval = 1;
+		else if (inner_pos >= inner_bi->ndatums)
+			cmpval = -1;
+		else
+		{
+			int32		outer_remainder = DatumGetInt32(outer_bi->datums[outer_pos][1]);
+			int32		inner_remainder = DatumGetInt32(inner_bi->datums[inner_pos][1]);
+
+			cmpval = (outer_remainder > inner_remainder) -
+				(outer_remainder < inner_remainder);
+		}
+
+		if (cmpval == 0)
+		{
+			/* Both sides have a partition for this remainder. */
+			Assert(outer_index >= 0);
+			Assert(inner_index >= 0);
+
+			merged_index = merge_matching_partitions(&outer_map, &inner_map,
+													 outer_index, inner_index,
+													 &next_index);
+			if (merged_index == -1)
+				goto cleanup;
+
+			merged_datum = outer_bi->datums[outer_pos];
+
+			/* Move to the next pair of remainders. */
+			outer_pos++;
+			inner_pos++;
+		}
+		else if (cmpval < 0)
+		{
+			/* A remainder covered only on the outer side. */
+			Assert(outer_pos < outer_bi->ndatums);
+
+			/*
+			 * The inner side can have no rows for this remainder, so the
+			 * outer partition only contributes to the result if this is an
+			 * outer join; it is then matched with a dummy partition.
+			 */
+			if (IS_OUTER_JOIN(jointype))
+			{
+				Assert(outer_index >= 0);
+				merged_index = process_outer_partition(&outer_map,
+													   &inner_map,
+													   false,
+													   false,
+													   outer_index,
+													   -1,
+													   jointype,
+													   &next_index,
+													   &default_index);
+				if (merged_index == -1)
+					goto cleanup;
+				merged_datum = outer_bi->datums[outer_pos];
+			}
+
+			/* Move to the next remainder on the outer side. */
+			outer_pos++;
+		}
+		else
+		{
+			/* A remainder covered only on the inner side. */
+			Assert(cmpval > 0);
+			Assert(inner_pos < inner_bi->ndatums);
+
+			/* Only a FULL join preserves unmatched inner partitions. */
+			if (jointype == JOIN_FULL)
+			{
+				Assert(inner_index >= 0);
+				merged_index = process_inner_partition(&outer_map,
+													   &inner_map,
+													   false,
+													   false,
+													   inner_index,
+													   -1,
+													   jointype,
+													   &next_index,
+													   &default_index);
+				if (merged_index == -1)
+					goto cleanup;
+				merged_datum = inner_bi->datums[inner_pos];
+			}
+
+			/* Move to the next remainder on the inner side. */
+			inner_pos++;
+		}
+
+		/*
+		 * If we assigned a merged partition, add the datum and index of the
+		 * merged partition.
+		 */
+		if (merged_index >= 0)
+		{
+			merged_datums = lappend(merged_datums, merged_datum);
+			merged_indexes = lappend_int(merged_indexes, merged_index);
+		}
+	}
+
+	/* If we have merged partitions, create the partition bounds. */
+	if (next_index > 0)
+	{
+		/* There are no default partitions, so no remapping can happen. */
+		Assert(!outer_map.did_remapping && !inner_map.did_remapping);
+		Assert(default_index == -1);
+
+		/* Use maps to match partitions from inputs. */
+		generate_matching_part_pairs(outer_rel, inner_rel,
+									 &outer_map, &inner_map,
+									 next_index,
+									 outer_parts, inner_parts);
+		Assert(*outer_parts != NIL);
+		Assert(*inner_parts != NIL);
+		Assert(list_length(*outer_parts) == list_length(*inner_parts));
+		Assert(list_length(*outer_parts) <= next_index);
+
+		/* Make a PartitionBoundInfo struct to return. */
+		merged_bounds = build_merged_partition_bounds(outer_bi->strategy,
+													  merged_datums,
+													  NIL,
+													  merged_indexes,
+													  -1,
+													  -1);
+		Assert(merged_bounds);
+	}
+
+cleanup:
+	/* Free local memory before returning. */
+	list_free(merged_datums);
+	list_free(merged_indexes);
+	free_partition_map(&outer_map);
+	free_partition_map(&inner_map);
+
+	return merged_bounds;
+}
+
 /*
  * merge_list_bounds
  *		Create the partition bounds for a join relation between list
@@ -2546,6 +2791,43 @@ build_merged_partition_bounds(char strategy, List *merged_datums,
 		merged_indexes = lappend_int(merged_indexes, -1);
 		ndatums++;
 	}
+	else if (strategy == PARTITION_STRATEGY_HASH)
+	{
+		int			greatest_modulus;
+
+		Assert(merged_kinds == NIL);
+		merged_bounds->kind = NULL;
+
+		/* interleaved_parts is always NULL for join relations. */
+		merged_bounds->interleaved_parts = NULL;
+
+		/*
+		 * For hash partitioning the indexes array is keyed by remainder, so
+		 * it has greatest-modulus entries with -1 for uncovered remainders.
+		 * merge_hash_bounds only merges bounds whose partitions all have the
+		 * greatest modulus, so we can read it off any datum pair.
+		 */
+		Assert(ndatums > 0);
+		greatest_modulus = DatumGetInt32(merged_bounds->datums[0][0]);
+		merged_bounds->nindexes = greatest_modulus;
+		merged_bounds->indexes = (int *) palloc(sizeof(int) * greatest_modulus);
+		for (pos = 0; pos < greatest_modulus; pos++)
+			merged_bounds->indexes[pos] = -1;
+		pos = 0;
+		foreach(lc, merged_indexes)
+		{
+			int			remainder = DatumGetInt32(merged_bounds->datums[pos][1]);
+
+			merged_bounds->indexes[remainder] = lfirst_int(lc);
+			pos++;
+		}
+
+		Assert(null_index == -1 && default_index == -1);
+		merged_bounds->null_index = null_index;
+		merged_bounds->default_index = default_index;
+
+		return merged_bounds;
+	}
 	else
 	{
 		Assert(strategy == PARTITION_STRATEGY_LIST);
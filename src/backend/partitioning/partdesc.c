@@ -310,6 +310,68 @@ retry:
 	if (nparts > 0)
 		boundinfo = partition_bounds_create(boundspecs, nparts, key, &mapping);
 
+	/*
+	 * Are we working with the partdesc that omits the detached partition, or
+	 * the one that includes it?
+	 *
+	 * Note that if a partition was found by the catalog's scan to have been
+	 * detached, but the pg_inherit tuple saying so was not visible to the
+	 * active snapshot (find_inheritance_children_extended will not have set
+	 * detached_xmin in that case), we consider there to be no "omittable"
+	 * detached partitions.
+	 */
+	is_omit = omit_detached && detached_exist && ActiveSnapshotSet() &&
+		TransactionIdIsValid(detached_xmin);
+
+	/*
+	 * Most relcache rebuilds of a partitioned table are not caused by a
+	 * change in its partition list -- and when nothing changed, the
+	 * descriptor we just computed is identical to the cached one.  Detect
+	 * that and reuse the existing descriptor rather than installing a copy,
+	 * which both skips the copying work and keeps the old-context chain
+	 * (see the "kluge" below) from growing with every invalidation.
+	 */
+	{
+		PartitionDesc olddesc;
+
+		olddesc = is_omit ? rel->rd_partdesc_nodetached : rel->rd_partdesc;
+
+		if (olddesc &&
+			olddesc->nparts == nparts &&
+			olddesc->detached_exist == detached_exist &&
+			(nparts == 0 ||
+			 partition_bounds_equal(key->partnatts, key->parttyplen,
+									key->parttypbyval, olddesc->boundinfo,
+									boundinfo)))
+		{
+			bool		match = true;
+
+			for (i = 0; i < nparts; i++)
+			{
+				int			index = mapping[i];
+
+				if (olddesc->oids[index] != oids[i] ||
+					olddesc->is_leaf[index] != is_leaf[i])
+				{
+					match = false;
+					break;
+				}
+			}
+
+			if (match)
+			{
+				/*
+				 * The stored xmin must still be updated: the cached
+				 * detach-pending partition set is the same, but its validity
+				 * for future snapshots is determined by the xmin we just saw.
+				 */
+				if (is_omit)
+					rel->rd_partdesc_nodetached_xmin = detached_xmin;
+				return olddesc;
+			}
+		}
+	}
+
 	/*
 	 * Now build the actual relcache partition descriptor, copying all the
 	 * data into a new, small context.  As per above comment, we don't make
@@ -356,19 +418,6 @@ retry:
 		MemoryContextSwitchTo(oldcxt);
 	}
 
-	/*
-	 * Are we working with the partdesc that omits the detached partition, or
-	 * the one that includes it?
-	 *
-	 * Note that if a partition was found by the catalog's scan to have been
-	 * detached, but the pg_inherit tuple saying so was not visible to the
-	 * active snapshot (find_inheritance_children_extended will not have set
-	 * detached_xmin in that case), we consider there to be no "omittable"
-	 * detached partitions.
-	 */
-	is_omit = omit_detached && detached_exist && ActiveSnapshotSet() &&
-		TransactionIdIsValid(detached_xmin);
-
 	/*
 	 * We have a fully valid partdesc.  Reparent it so that it has the right
 	 * lifespan.
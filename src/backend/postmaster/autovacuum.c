@@ -218,14 +218,19 @@ typedef struct autovac_table
  * wi_links		entry into free list or running list
  * wi_dboid		OID of the database this worker is supposed to work on
  * wi_tableoid	OID of the table currently being vacuumed, if any
+ * wi_tablespaceoid OID of that table's tablespace, if any
  * wi_sharedrel flag indicating whether table is marked relisshared
  * wi_proc		pointer to PGPROC of the running worker, NULL if not started
  * wi_launchtime Time at which this worker was launched
  * wi_dobalance Whether this worker should be included in balance calculations
+ * wi_nworkersForBalance the number of balance-participating workers vacuuming
+ *					tables in the same tablespace as this worker, used when
+ *					calculating the per worker cost limit
  *
- * All fields are protected by AutovacuumLock, except for wi_tableoid and
- * wi_sharedrel which are protected by AutovacuumScheduleLock (note these
- * two fields are read-only for everyone except that worker itself).
+ * All fields are protected by AutovacuumLock, except for wi_tableoid,
+ * wi_tablespaceoid and wi_sharedrel which are protected by
+ * AutovacuumScheduleLock (note these fields are read-only for everyone except
+ * that worker itself).
  *-------------
  */
 typedef struct WorkerInfoData
@@ -233,9 +238,11 @@ typedef struct WorkerInfoData
 	dlist_node	wi_links;
 	Oid			wi_dboid;
 	Oid			wi_tableoid;
+	Oid			wi_tablespaceoid;
 	PGPROC	   *wi_proc;
 	TimestampTz wi_launchtime;
 	pg_atomic_flag wi_dobalance;
+	pg_atomic_uint32 wi_nworkersForBalance;
 	bool		wi_sharedrel;
 } WorkerInfoData;
 
@@ -283,8 +290,6 @@ typedef struct AutoVacuumWorkItem
  * av_startingWorker pointer to WorkerInfo currently being started (cleared by
  *					the worker itself as soon as it's up and running)
  * av_workItems		work item array
- * av_nworkersForBalance the number of autovacuum workers to use when
- * 					calculating the per worker cost limit
  *
  * This struct is protected by AutovacuumLock, except for av_signal and parts
  * of the worker list (see above).
@@ -298,7 +303,6 @@ typedef struct
 	dlist_head	av_runningWorkers;
 	WorkerInfo	av_startingWorker;
 	AutoVacuumWorkItem av_workItems[NUM_WORKITEMS];
-	pg_atomic_uint32 av_nworkersForBalance;
 } AutoVacuumShmemStruct;
 
 static AutoVacuumShmemStruct *AutoVacuumShmem;
@@ -683,6 +687,7 @@ AutoVacLauncherMain(const void *startup_data, size_t startup_data_len)
 					worker = AutoVacuumShmem->av_startingWorker;
 					worker->wi_dboid = InvalidOid;
 					worker->wi_tableoid = InvalidOid;
+					worker->wi_tablespaceoid = InvalidOid;
 					worker->wi_sharedrel = false;
 					worker->wi_proc = NULL;
 					worker->wi_launchtime = 0;
@@ -1626,6 +1631,7 @@ FreeWorkerInfo(int code, Datum arg)
 		dlist_delete(&MyWorkerInfo->wi_links);
 		MyWorkerInfo->wi_dboid = InvalidOid;
 		MyWorkerInfo->wi_tableoid = InvalidOid;
+		MyWorkerInfo->wi_tablespaceoid = InvalidOid;
 		MyWorkerInfo->wi_sharedrel = false;
 		MyWorkerInfo->wi_proc = NULL;
 		MyWorkerInfo->wi_launchtime = 0;
@@ -1715,7 +1721,7 @@ VacuumUpdateCosts(void)
  * Update vacuum_cost_limit with the correct value for an autovacuum worker,
  * given the value of other relevant cost limit parameters and the number of
  * workers across which the limit must be balanced. Autovacuum workers must
- * call this regularly in case av_nworkersForBalance has been updated by
+ * call this regularly in case wi_nworkersForBalance has been updated by
  * another worker or by the autovacuum launcher. They must also call it after a
  * config reload.
  */
@@ -1747,7 +1753,7 @@ AutoVacuumUpdateCostLimit(void)
 
 		Assert(vacuum_cost_limit > 0);
 
-		nworkers_for_balance = pg_atomic_read_u32(&AutoVacuumShmem->av_nworkersForBalance);
+		nworkers_for_balance = pg_atomic_read_u32(&MyWorkerInfo->wi_nworkersForBalance);
 
 		/* There is at least 1 autovac worker (this worker) */
 		if (nworkers_for_balance <= 0)
@@ -1759,38 +1765,55 @@ AutoVacuumUpdateCostLimit(void)
 
 /*
  * autovac_recalculate_workers_for_balance
- *		Recalculate the number of workers to consider, given cost-related
- *		storage parameters and the current number of active workers.
+ *		Recalculate, for each active worker, the number of workers among
+ *		which its cost limit must be balanced, given cost-related storage
+ *		parameters and the tablespaces the workers are operating in.
+ *
+ * Workers only compete for I/O with workers vacuuming tables in the same
+ * tablespace, so the cost limit is divided per tablespace rather than
+ * globally; a worker on otherwise-idle storage is not throttled on account
+ * of activity elsewhere.  The double loop is fine since the number of
+ * workers is small.
  *
  * Caller must hold the AutovacuumLock in at least shared mode to access
- * worker->wi_proc.
+ * worker->wi_proc.  The wi_tablespaceoid values are updated under a
+ * different lock, so concurrent table switches can make the counts
+ * transiently stale; that only mis-throttles briefly, until the next
+ * recalculation.
  */
 static void
 autovac_recalculate_workers_for_balance(void)
 {
 	dlist_iter	iter;
-	int			orig_nworkers_for_balance;
-	int			nworkers_for_balance = 0;
 
 	Assert(LWLockHeldByMe(AutovacuumLock));
 
-	orig_nworkers_for_balance =
-		pg_atomic_read_u32(&AutoVacuumShmem->av_nworkersForBalance);
-
 	dlist_foreach(iter, &AutoVacuumShmem->av_runningWorkers)
 	{
 		WorkerInfo	worker = dlist_container(WorkerInfoData, wi_links, iter.cur);
+		dlist_iter	other_iter;
+		int			nworkers_for_balance = 0;
 
 		if (worker->wi_proc == NULL ||
 			pg_atomic_unlocked_test_flag(&worker->wi_dobalance))
 			continue;
 
-		nworkers_for_balance++;
-	}
+		dlist_foreach(other_iter, &AutoVacuumShmem->av_runningWorkers)
+		{
+			WorkerInfo	other = dlist_container(WorkerInfoData, wi_links,
+												other_iter.cur);
+
+			if (other->wi_proc == NULL ||
+				pg_atomic_unlocked_test_flag(&other->wi_dobalance))
+				continue;
 
-	if (nworkers_for_balance != orig_nworkers_for_balance)
-		pg_atomic_write_u32(&AutoVacuumShmem->av_nworkersForBalance,
+			if (other->wi_tablespaceoid == worker->wi_tablespaceoid)
+				nworkers_for_balance++;
+		}
+
+		pg_atomic_write_u32(&worker->wi_nworkersForBalance,
 							nworkers_for_balance);
+	}
 }
 
 /*
@@ -2294,6 +2317,7 @@ do_autovacuum(void)
 		HeapTuple	classTup;
 		autovac_table *tab;
 		bool		isshared;
+		Oid			tablespaceoid;
 		bool		skipit;
 		dlist_iter	iter;
 
@@ -2327,6 +2351,9 @@ do_autovacuum(void)
 		if (!HeapTupleIsValid(classTup))
 			continue;			/* somebody deleted the rel, forget it */
 		isshared = ((Form_pg_class) GETSTRUCT(classTup))->relisshared;
+		tablespaceoid = ((Form_pg_class) GETSTRUCT(classTup))->reltablespace;
+		if (!OidIsValid(tablespaceoid))
+			tablespaceoid = MyDatabaseTableSpace;
 		ReleaseSysCache(classTup);
 
 		/*
@@ -2375,6 +2402,7 @@ do_autovacuum(void)
 		 * AutovacuumScheduleLock while rechecking the stats.)
 		 */
 		MyWorkerInfo->wi_tableoid = relid;
+		MyWorkerInfo->wi_tablespaceoid = tablespaceoid;
 		MyWorkerInfo->wi_sharedrel = isshared;
 		LWLockRelease(AutovacuumScheduleLock);
 
@@ -2392,6 +2420,7 @@ do_autovacuum(void)
 			/* someone else vacuumed the table, or it went away */
 			LWLockAcquire(AutovacuumScheduleLock, LW_EXCLUSIVE);
 			MyWorkerInfo->wi_tableoid = InvalidOid;
+			MyWorkerInfo->wi_tablespaceoid = InvalidOid;
 			MyWorkerInfo->wi_sharedrel = false;
 			LWLockRelease(AutovacuumScheduleLock);
 			continue;
@@ -2516,6 +2545,7 @@ deleted:
 		 */
 		LWLockAcquire(AutovacuumScheduleLock, LW_EXCLUSIVE);
 		MyWorkerInfo->wi_tableoid = InvalidOid;
+		MyWorkerInfo->wi_tablespaceoid = InvalidOid;
 		MyWorkerInfo->wi_sharedrel = false;
 		LWLockRelease(AutovacuumScheduleLock);
 		pg_atomic_test_set_flag(&MyWorkerInfo->wi_dobalance);
@@ -3404,10 +3434,8 @@ AutoVacuumShmemInit(void)
 			dclist_push_head(&AutoVacuumShmem->av_freeWorkers,
 							 &worker[i].wi_links);
 			pg_atomic_init_flag(&worker[i].wi_dobalance);
+			pg_atomic_init_u32(&worker[i].wi_nworkersForBalance, 0);
 		}
-
-		pg_atomic_init_u32(&AutoVacuumShmem->av_nworkersForBalance, 0);
-
 	}
 	else
 		Assert(found);
@@ -234,6 +234,12 @@ int			ReservedConnections;
 static int	NumListenSockets = 0;
 static pgsocket *ListenSockets = NULL;
 
+/*
+ * Maximum number of connections to accept from one listen socket per
+ * wait-set wakeup.  See ServerLoop.
+ */
+#define MAX_ACCEPTS_PER_EVENT	64
+
 /* still more option variables */
 bool		EnableSSL = false;
 
@@ -1696,16 +1702,27 @@ ServerLoop(void)
 
 			if (events[i].events & WL_SOCKET_ACCEPT)
 			{
-				ClientSocket s;
+				/*
+				 * Accept as many pending connections as we can.  The listen
+				 * socket is non-blocking, so AcceptConnection fails once the
+				 * queue is drained.  The iteration limit bounds how long we
+				 * go without rechecking the pending-request flags above when
+				 * connections arrive faster than we can fork.
+				 */
+				for (int naccepted = 0; naccepted < MAX_ACCEPTS_PER_EVENT; naccepted++)
+				{
+					ClientSocket s;
 
-				if (AcceptConnection(events[i].fd, &s) == STATUS_OK)
+					if (AcceptConnection(events[i].fd, &s) != STATUS_OK)
+						break;
 					BackendStartup(&s);
 
-				/* We no longer need the open socket in this process */
-				if (s.sock != PGINVALID_SOCKET)
-				{
-					if (closesocket(s.sock) != 0)
-						elog(LOG, "could not close client socket: %m");
+					/* We no longer need the open socket in this process */
+					if (s.sock != PGINVALID_SOCKET)
+					{
+						if (closesocket(s.sock) != 0)
+							elog(LOG, "could not close client socket: %m");
+					}
 				}
 			}
 		}
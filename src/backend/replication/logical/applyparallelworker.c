@@ -1139,11 +1139,19 @@ ProcessParallelApplyMessages(void)
  * Send the data to the specified parallel apply worker via shared-memory
  * queue.
  *
+ * When force_flush is false, the data is made visible to the worker lazily
+ * (see shm_mq_send), avoiding setting the worker's latch for every change of
+ * a large streamed transaction.  Callers must pass force_flush as true for
+ * messages the worker has to act on promptly, such as the stream control
+ * messages; data queued lazily is guaranteed to be flushed no later than the
+ * next forced send.
+ *
  * Returns false if the attempt to send data via shared memory times out, true
  * otherwise.
  */
 bool
-pa_send_data(ParallelApplyWorkerInfo *winfo, Size nbytes, const void *data)
+pa_send_data(ParallelApplyWorkerInfo *winfo, Size nbytes, const void *data,
+			 bool force_flush)
 {
 	int			rc;
 	shm_mq_result result;
@@ -1170,7 +1178,7 @@ pa_send_data(ParallelApplyWorkerInfo *winfo, Size nbytes, const void *data)
 
 	for (;;)
 	{
-		result = shm_mq_send(winfo->mq_handle, nbytes, data, true, true);
+		result = shm_mq_send(winfo->mq_handle, nbytes, data, true, force_flush);
 
 		if (result == SHM_MQ_SUCCESS)
 			return true;
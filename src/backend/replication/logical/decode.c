@@ -588,6 +588,34 @@ FilterByOrigin(LogicalDecodingContext *ctx, RepOriginId origin_id)
 	return filter_by_origin_cb_wrapper(ctx, origin_id);
 }
 
+/*
+ * Ask the output plugin whether the given change should be discarded
+ * instead of being queued into the reorder buffer.  If so, release the
+ * change and return true.
+ *
+ * Filtering at this point saves the memory, and possibly spill I/O, that
+ * the change would otherwise consume while its transaction is in progress.
+ * The filter_change callback is optional; when not supplied, every change
+ * is queued.
+ */
+static bool
+FilterChange(LogicalDecodingContext *ctx, RelFileLocator *rlocator,
+			 ReorderBufferChange *change)
+{
+	if (ctx->callbacks.filter_change_cb == NULL)
+		return false;
+
+	if (!filter_change_cb_wrapper(ctx, rlocator, change))
+		return false;
+
+	/*
+	 * We don't need to update memory accounting for this change as we have
+	 * not added it to the queue yet.
+	 */
+	ReorderBufferFreeChange(ctx->reorder, change, false);
+	return true;
+}
+
 /*
  * Handle rmgr LOGICALMSG_ID records for LogicalDecodingProcessRecord().
  */
@@ -947,6 +975,16 @@ DecodeInsert(LogicalDecodingContext *ctx, XLogRecordBuffer *buf)
 
 	change->data.tp.clear_toast_afterwards = true;
 
+	/*
+	 * Let the output plugin filter the change before it is queued.  Toast
+	 * chunk inserts and speculative inserts must not be filtered: the
+	 * former belong to some other change, and the latter have internal
+	 * confirm/abort records to pair up with.
+	 */
+	if (!(xlrec->flags & (XLH_INSERT_ON_TOAST_RELATION | XLH_INSERT_IS_SPECULATIVE)) &&
+		FilterChange(ctx, &target_locator, change))
+		return;
+
 	ReorderBufferQueueChange(ctx->reorder, XLogRecGetXid(r), buf->origptr,
 							 change,
 							 xlrec->flags & XLH_INSERT_ON_TOAST_RELATION);
@@ -1016,6 +1054,10 @@ DecodeUpdate(LogicalDecodingContext *ctx, XLogRecordBuffer *buf)
 
 	change->data.tp.clear_toast_afterwards = true;
 
+	/* let the output plugin filter the change before it is queued */
+	if (FilterChange(ctx, &target_locator, change))
+		return;
+
 	ReorderBufferQueueChange(ctx->reorder, XLogRecGetXid(r), buf->origptr,
 							 change, false);
 }
@@ -1072,6 +1114,14 @@ DecodeDelete(LogicalDecodingContext *ctx, XLogRecordBuffer *buf)
 
 	change->data.tp.clear_toast_afterwards = true;
 
+	/*
+	 * Let the output plugin filter the change before it is queued.
+	 * Speculative aborts are internal bookkeeping and must go through.
+	 */
+	if (change->action == REORDER_BUFFER_CHANGE_DELETE &&
+		FilterChange(ctx, &target_locator, change))
+		return;
+
 	ReorderBufferQueueChange(ctx->reorder, XLogRecGetXid(r), buf->origptr,
 							 change, false);
 }
@@ -125,6 +125,12 @@
 #define MAX_DISTR_INVAL_MSG_PER_TXN \
 	((8 * 1024 * 1024) / sizeof(SharedInvalidationMessage))
 
+/*
+ * Size of the buffer used to batch writes of serialized changes to a spill
+ * file, so that spilling a transaction doesn't pay one write() per change.
+ */
+#define REORDER_BUFFER_SPILL_BUFFER_SIZE (64 * 1024)
+
 /* entry for a hash table we use to map from xid to our transaction state */
 typedef struct ReorderBufferTXNByIdEnt
 {
@@ -266,6 +272,10 @@ static void ReorderBufferCheckMemoryLimit(ReorderBuffer *rb);
 static void ReorderBufferSerializeTXN(ReorderBuffer *rb, ReorderBufferTXN *txn);
 static void ReorderBufferSerializeChange(ReorderBuffer *rb, ReorderBufferTXN *txn,
 										 int fd, ReorderBufferChange *change);
+static void ReorderBufferSpillWrite(ReorderBuffer *rb, ReorderBufferTXN *txn,
+									int fd, const char *data, Size size);
+static void ReorderBufferSpillFlush(ReorderBuffer *rb, ReorderBufferTXN *txn,
+									int fd);
 static Size ReorderBufferRestoreChanges(ReorderBuffer *rb, ReorderBufferTXN *txn,
 										TXNEntryFile *file, XLogSegNo *segno);
 static void ReorderBufferRestoreChange(ReorderBuffer *rb, ReorderBufferTXN *txn,
@@ -379,6 +389,9 @@ ReorderBufferAllocate(void)
 
 	buffer->outbuf = NULL;
 	buffer->outbufsize = 0;
+	buffer->spillbuf = NULL;
+	buffer->spillbufsize = 0;
+	buffer->spillbytes = 0;
 	buffer->size = 0;
 
 	/* txn_heap is ordered by transaction size */
@@ -3998,7 +4011,10 @@ ReorderBufferSerializeTXN(ReorderBuffer *rb, ReorderBufferTXN *txn)
 			char		path[MAXPGPATH];
 
 			if (fd != -1)
+			{
+				ReorderBufferSpillFlush(rb, txn, fd);
 				CloseTransientFile(fd);
+			}
 
 			XLByteToSeg(change->lsn, curOpenSegNo, wal_segment_size);
 
@@ -4048,7 +4064,10 @@ ReorderBufferSerializeTXN(ReorderBuffer *rb, ReorderBufferTXN *txn)
 	txn->txn_flags |= RBTXN_IS_SERIALIZED;
 
 	if (fd != -1)
+	{
+		ReorderBufferSpillFlush(rb, txn, fd);
 		CloseTransientFile(fd);
+	}
 }
 
 /*
@@ -4237,9 +4256,67 @@ ReorderBufferSerializeChange(ReorderBuffer *rb, ReorderBufferTXN *txn,
 
 	ondisk->size = sz;
 
+	ReorderBufferSpillWrite(rb, txn, fd, rb->outbuf, ondisk->size);
+
+	/*
+	 * Keep the transaction's final_lsn up to date with each change we send to
+	 * disk, so that ReorderBufferRestoreCleanup works correctly.  (We used to
+	 * only do this on commit and abort records, but that doesn't work if a
+	 * system crash leaves a transaction without its abort record).
+	 *
+	 * Make sure not to move it backwards.
+	 */
+	if (txn->final_lsn < change->lsn)
+		txn->final_lsn = change->lsn;
+
+	Assert(ondisk->change.action == change->action);
+}
+
+/*
+ * Append a serialized change to the spill write buffer, so that many small
+ * changes are written to the spill file with one large write() instead of
+ * one syscall per change.  Changes larger than the buffer are copied through
+ * it in chunks; the file is a plain byte stream, so a change may span two
+ * writes.
+ */
+static void
+ReorderBufferSpillWrite(ReorderBuffer *rb, ReorderBufferTXN *txn,
+						int fd, const char *data, Size size)
+{
+	if (rb->spillbuf == NULL)
+	{
+		rb->spillbuf = MemoryContextAlloc(rb->context,
+										  REORDER_BUFFER_SPILL_BUFFER_SIZE);
+		rb->spillbufsize = REORDER_BUFFER_SPILL_BUFFER_SIZE;
+	}
+
+	while (size > 0)
+	{
+		Size		chunk = Min(size, rb->spillbufsize - rb->spillbytes);
+
+		memcpy(rb->spillbuf + rb->spillbytes, data, chunk);
+		rb->spillbytes += chunk;
+		data += chunk;
+		size -= chunk;
+
+		if (rb->spillbytes == rb->spillbufsize)
+			ReorderBufferSpillFlush(rb, txn, fd);
+	}
+}
+
+/*
+ * Write out any changes batched up in the spill write buffer.  This must be
+ * called before closing a spill file the buffer was filled for.
+ */
+static void
+ReorderBufferSpillFlush(ReorderBuffer *rb, ReorderBufferTXN *txn, int fd)
+{
+	if (rb->spillbytes == 0)
+		return;
+
 	errno = 0;
 	pgstat_report_wait_start(WAIT_EVENT_REORDER_BUFFER_WRITE);
-	if (write(fd, rb->outbuf, ondisk->size) != ondisk->size)
+	if (write(fd, rb->spillbuf, rb->spillbytes) != rb->spillbytes)
 	{
 		int			save_errno = errno;
 
@@ -4254,18 +4331,7 @@ ReorderBufferSerializeChange(ReorderBuffer *rb, ReorderBufferTXN *txn,
 	}
 	pgstat_report_wait_end();
 
-	/*
-	 * Keep the transaction's final_lsn up to date with each change we send to
-	 * disk, so that ReorderBufferRestoreCleanup works correctly.  (We used to
-	 * only do this on commit and abort records, but that doesn't work if a
-	 * system crash leaves a transaction without its abort record).
-	 *
-	 * Make sure not to move it backwards.
-	 */
-	if (txn->final_lsn < change->lsn)
-		txn->final_lsn = change->lsn;
-
-	Assert(ondisk->change.action == change->action);
+	rb->spillbytes = 0;
 }
 
 /* Returns true, if the output plugin supports streaming, false, otherwise. */
@@ -523,6 +523,9 @@ SnapBuildInitialSnapshot(SnapBuild *builder)
 	snap->snapshot_type = SNAPSHOT_MVCC;
 	snap->xcnt = newxcnt;
 	snap->xip = newxip;
+	/* we just changed the snapshot's contents, so flush the XID cache */
+	snap->xicCount = 0;
+	snap->xicNext = 0;
 
 	return snap;
 }
@@ -770,10 +770,21 @@ copy_read_data(void *outbuf, int minread, int maxread)
 				bytesread += avail;
 			}
 
-			if (maxread <= 0 || bytesread >= minread)
+			/*
+			 * Note that we keep consuming messages that can be read without
+			 * blocking even once minread is satisfied, rather than returning
+			 * right away: the server sends one CopyData message per row, and
+			 * returning per message would refill the caller's raw buffer one
+			 * row at a time.
+			 */
+			if (maxread <= 0)
 				return bytesread;
 		}
 
+		/* If we have enough, don't block waiting for more. */
+		if (bytesread >= minread)
+			return bytesread;
+
 		/*
 		 * Wait for more data or latch.
 		 */
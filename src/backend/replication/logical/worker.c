@@ -603,8 +603,13 @@ handle_streamed_transaction(LogicalRepMsgType action, StringInfo s)
 			 * messages after the streaming transaction, so also update the
 			 * relation/type in leader apply worker. See function
 			 * cleanup_rel_sync_cache.
+			 *
+			 * Ordinary changes are sent without forcing a queue flush, so
+			 * that applying a large streamed transaction doesn't wake the
+			 * parallel apply worker once per change; the STREAM_STOP (or
+			 * later control message) ending this block forces the flush.
 			 */
-			if (pa_send_data(winfo, s->len, s->data))
+			if (pa_send_data(winfo, s->len, s->data, false))
 				return (action != LOGICAL_REP_MSG_RELATION &&
 						action != LOGICAL_REP_MSG_TYPE);
 
@@ -1335,7 +1340,7 @@ apply_handle_stream_prepare(StringInfo s)
 		case TRANS_LEADER_SEND_TO_PARALLEL:
 			Assert(winfo);
 
-			if (pa_send_data(winfo, s->len, s->data))
+			if (pa_send_data(winfo, s->len, s->data, true))
 			{
 				/* Finish processing the streaming transaction. */
 				pa_xact_finish(winfo, prepare_data.end_lsn);
@@ -1541,7 +1546,7 @@ apply_handle_stream_start(StringInfo s)
 			 * until the end of the transaction. So, we don't need to release
 			 * the lock or increment the stream count in that case.
 			 */
-			if (pa_send_data(winfo, s->len, s->data))
+			if (pa_send_data(winfo, s->len, s->data, true))
 			{
 				/*
 				 * Unlock the shared object lock so that the parallel apply
@@ -1669,7 +1674,7 @@ apply_handle_stream_stop(StringInfo s)
 			 */
 			pa_lock_stream(winfo->shared->xid, AccessExclusiveLock);
 
-			if (pa_send_data(winfo, s->len, s->data))
+			if (pa_send_data(winfo, s->len, s->data, true))
 			{
 				pa_set_stream_apply_worker(NULL);
 				break;
@@ -1893,7 +1898,7 @@ apply_handle_stream_abort(StringInfo s)
 				pa_lock_stream(xid, AccessExclusiveLock);
 			}
 
-			if (pa_send_data(winfo, s->len, s->data))
+			if (pa_send_data(winfo, s->len, s->data, true))
 			{
 				/*
 				 * Unlike STREAM_COMMIT and STREAM_PREPARE, we don't need to
@@ -2187,7 +2192,7 @@ apply_handle_stream_commit(StringInfo s)
 		case TRANS_LEADER_SEND_TO_PARALLEL:
 			Assert(winfo);
 
-			if (pa_send_data(winfo, s->len, s->data))
+			if (pa_send_data(winfo, s->len, s->data, true))
 			{
 				/* Finish processing the streaming transaction. */
 				pa_xact_finish(winfo, commit_data.end_lsn);
@@ -112,6 +112,19 @@ static struct
 	XLogRecPtr	Flush;			/* last byte + 1 flushed in the standby */
 }			LogstreamResult;
 
+/*
+ * Buffer used to stage received WAL data before writing it out, so that we
+ * keep draining the socket while the data accumulates and then issue one
+ * large write, instead of blocking the socket on one write per message.
+ * recvWriteBufStart is the start LSN of the staged data; staged data is
+ * always contiguous and from a single timeline.
+ */
+#define WALRCV_WRITEBUF_SIZE	(1024 * 1024)
+static char *recvWriteBuf = NULL;
+static Size recvWriteBufUsed = 0;
+static XLogRecPtr recvWriteBufStart = InvalidXLogRecPtr;
+static TimeLineID recvWriteBufTLI = 0;
+
 /*
  * Reasons to wake up and perform periodic tasks.
  */
@@ -137,6 +150,9 @@ static void WalRcvWaitForStartPosition(XLogRecPtr *startpoint, TimeLineID *start
 static void WalRcvDie(int code, Datum arg);
 static void XLogWalRcvProcessMsg(unsigned char type, char *buf, Size len,
 								 TimeLineID tli);
+static void XLogWalRcvQueueWrite(char *buf, Size nbytes, XLogRecPtr recptr,
+								 TimeLineID tli);
+static void XLogWalRcvWriteQueued(void);
 static void XLogWalRcvWrite(char *buf, Size nbytes, XLogRecPtr recptr,
 							TimeLineID tli);
 static void XLogWalRcvFlush(bool dying, TimeLineID tli);
@@ -479,6 +495,12 @@ WalReceiverMain(const void *startup_data, size_t startup_data_len)
 						len = walrcv_receive(wrconn, &buf, &wait_fd);
 					}
 
+					/*
+					 * The socket is drained (or the stream has ended), so
+					 * now write out any WAL data staged above.
+					 */
+					XLogWalRcvWriteQueued();
+
 					/* Let the primary know that we received some data. */
 					XLogWalRcvSendReply(false, false);
 
@@ -847,7 +869,7 @@ XLogWalRcvProcessMsg(unsigned char type, char *buf, Size len, TimeLineID tli)
 
 				buf += hdrlen;
 				len -= hdrlen;
-				XLogWalRcvWrite(buf, len, dataStart, tli);
+				XLogWalRcvQueueWrite(buf, len, dataStart, tli);
 				break;
 			}
 		case 'k':				/* Keepalive */
@@ -872,7 +894,11 @@ XLogWalRcvProcessMsg(unsigned char type, char *buf, Size len, TimeLineID tli)
 
 				/* If the primary requested a reply, send one immediately */
 				if (replyRequested)
+				{
+					/* Write out staged WAL so the reply reflects it */
+					XLogWalRcvWriteQueued();
 					XLogWalRcvSendReply(true, false);
+				}
 				break;
 			}
 		default:
@@ -883,6 +909,61 @@ XLogWalRcvProcessMsg(unsigned char type, char *buf, Size len, TimeLineID tli)
 	}
 }
 
+/*
+ * Stage received XLOG data for writing.
+ *
+ * The data is normally accumulated in recvWriteBuf and written out in one
+ * large write once the socket has been drained; see the caller of
+ * XLogWalRcvWriteQueued().  Data that is not contiguous with what is already
+ * staged, or too large to stage, forces the staged data out first.
+ */
+static void
+XLogWalRcvQueueWrite(char *buf, Size nbytes, XLogRecPtr recptr, TimeLineID tli)
+{
+	if (recvWriteBuf == NULL)
+		recvWriteBuf = MemoryContextAlloc(TopMemoryContext,
+										  WALRCV_WRITEBUF_SIZE);
+
+	/* Write staged data out if this message doesn't extend it */
+	if (recvWriteBufUsed > 0 &&
+		(recptr != recvWriteBufStart + recvWriteBufUsed ||
+		 tli != recvWriteBufTLI))
+		XLogWalRcvWriteQueued();
+
+	/* Bypass the buffer altogether for messages that can't fit in it */
+	if (nbytes >= WALRCV_WRITEBUF_SIZE)
+	{
+		XLogWalRcvWriteQueued();
+		XLogWalRcvWrite(buf, nbytes, recptr, tli);
+		return;
+	}
+
+	if (recvWriteBufUsed + nbytes > WALRCV_WRITEBUF_SIZE)
+		XLogWalRcvWriteQueued();
+
+	if (recvWriteBufUsed == 0)
+	{
+		recvWriteBufStart = recptr;
+		recvWriteBufTLI = tli;
+	}
+	memcpy(recvWriteBuf + recvWriteBufUsed, buf, nbytes);
+	recvWriteBufUsed += nbytes;
+}
+
+/*
+ * Write out any XLOG data staged by XLogWalRcvQueueWrite.
+ */
+static void
+XLogWalRcvWriteQueued(void)
+{
+	if (recvWriteBufUsed == 0)
+		return;
+
+	XLogWalRcvWrite(recvWriteBuf, recvWriteBufUsed, recvWriteBufStart,
+					recvWriteBufTLI);
+	recvWriteBufUsed = 0;
+}
+
 /*
  * Write XLOG data to disk.
  */
@@ -986,6 +1067,9 @@ XLogWalRcvFlush(bool dying, TimeLineID tli)
 {
 	Assert(tli != 0);
 
+	/* Write out any staged data first, so it is covered by the flush */
+	XLogWalRcvWriteQueued();
+
 	if (LogstreamResult.Flush < LogstreamResult.Write)
 	{
 		WalRcvData *walrcv = WalRcv;
@@ -102,13 +102,16 @@
 /*
  * Maximum data payload in a WAL data message.  Must be >= XLOG_BLCKSZ.
  *
- * We don't have a good idea of what a good value would be; there's some
- * overhead per message in both walsender and walreceiver, but on the other
- * hand sending large batches makes walsender less responsive to signals
- * because signals are checked only between messages.  128kB (with
- * default 8k blocks) seems like a reasonable guess for now.
+ * There's some overhead per message in both walsender and walreceiver, so
+ * larger batches mean fewer per-message round trips through the send loop,
+ * which matters most on high-latency links where the socket buffer must be
+ * kept full to sustain throughput.  Messages are sent with
+ * pq_putmessage_noblock(), so a large message doesn't block the walsender or
+ * delay signal handling; it just buffers more data ahead of the socket.  1MB
+ * (with default 8k blocks) matches the walreceiver's write buffer, so a full
+ * message can be staged and written out by the receiver in one go.
  */
-#define MAX_SEND_SIZE (XLOG_BLCKSZ * 16)
+#define MAX_SEND_SIZE (XLOG_BLCKSZ * 128)
 
 /* Array of WalSnds in shared memory */
 WalSndCtlData *WalSndCtl = NULL;
@@ -1029,6 +1032,7 @@ logical_read_xlog_page(XLogReaderState *state, XLogRecPtr targetPagePtr, int req
 {
 	XLogRecPtr	flushptr;
 	int			count;
+	Size		rbytes;
 	WALReadError errinfo;
 	XLogSegNo	segno;
 	TimeLineID	currTLI;
@@ -1069,11 +1073,23 @@ logical_read_xlog_page(XLogReaderState *state, XLogRecPtr targetPagePtr, int req
 	else
 		count = flushptr - targetPagePtr;	/* part of the page available */
 
-	/* now actually read the data, we know it's there */
-	if (!WALRead(state,
-				 cur_page,
-				 targetPagePtr,
-				 count,
+	/*
+	 * Attempt to read the page from WAL buffers first.  A caught-up logical
+	 * walsender mostly decodes recently flushed WAL, which is usually still
+	 * present in WAL buffers, so this saves the file read entirely; that
+	 * matters when many slots are decoding the same WAL concurrently.  Pass
+	 * the timeline the page is expected to be on, so that nothing is read
+	 * from the buffers while sending a historic timeline.
+	 */
+	rbytes = WALReadFromBuffers(cur_page, targetPagePtr, count,
+								state->currTLI);
+
+	/* now read the remaining WAL from WAL file, we know it's there */
+	if (rbytes < (Size) count &&
+		!WALRead(state,
+				 cur_page + rbytes,
+				 targetPagePtr + rbytes,
+				 count - rbytes,
 				 currTLI,		/* Pass the current TLI because only
 								 * WalSndSegmentOpen controls whether new TLI
 								 * is needed. */
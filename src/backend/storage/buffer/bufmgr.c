@@ -62,6 +62,7 @@
 #include "storage/smgr.h"
 #include "storage/standby.h"
 #include "utils/memdebug.h"
+#include "utils/memutils.h"
 #include "utils/ps_status.h"
 #include "utils/rel.h"
 #include "utils/resowner.h"
@@ -520,6 +521,8 @@ static void BufferSync(int flags);
 static uint32 WaitBufHdrUnlocked(BufferDesc *buf);
 static int	SyncOneBuffer(int buf_id, bool skip_recently_used,
 						  WritebackContext *wb_context);
+static int	SyncBufferRun(const CkptSortItem *items, int nitems, int *nwritten,
+						  WritebackContext *wb_context);
 static void WaitIO(BufferDesc *buf);
 static void AbortBufferIO(Buffer buffer);
 static void shared_buffer_write_error_callback(void *arg);
@@ -3534,43 +3537,71 @@ BufferSync(int flags)
 		BufferDesc *bufHdr = NULL;
 		CkptTsStatus *ts_stat = (CkptTsStatus *)
 			DatumGetPointer(binaryheap_first(ts_heap));
+		int			consumed;
 
 		buf_id = CkptBufferIds[ts_stat->index].buf_id;
 		Assert(buf_id != -1);
 
 		bufHdr = GetBufferDescriptor(buf_id);
 
-		num_processed++;
-
 		/*
 		 * We don't need to acquire the lock here, because we're only looking
 		 * at a single bit. It's possible that someone else writes the buffer
 		 * and clears the flag right after we check, but that doesn't matter
-		 * since SyncOneBuffer will then do nothing.  However, there is a
+		 * since SyncBufferRun will then do nothing.  However, there is a
 		 * further race condition: it's conceivable that between the time we
-		 * examine the bit here and the time SyncOneBuffer acquires the lock,
+		 * examine the bit here and the time SyncBufferRun acquires the lock,
 		 * someone else not only wrote the buffer but replaced it with another
-		 * page and dirtied it.  In that improbable case, SyncOneBuffer will
+		 * page and dirtied it.  In that improbable case, SyncBufferRun will
 		 * write the buffer though we didn't need to.  It doesn't seem worth
 		 * guarding against this, though.
 		 */
 		if (pg_atomic_read_u32(&bufHdr->state) & BM_CHECKPOINT_NEEDED)
 		{
-			if (SyncOneBuffer(buf_id, false, &wb_context) & BUF_WRITTEN)
+			CkptSortItem *item = &CkptBufferIds[ts_stat->index];
+			int			max_run;
+			int			run = 1;
+			int			nwritten;
+
+			/*
+			 * Look ahead in this tablespace's portion of the sorted list for
+			 * directly following blocks of the same relation fork, so that
+			 * the whole run can be written out with one vectored write.
+			 */
+			max_run = Min(io_combine_limit,
+						  ts_stat->num_to_scan - ts_stat->num_scanned);
+			while (run < max_run)
 			{
-				TRACE_POSTGRESQL_BUFFER_SYNC_WRITTEN(buf_id);
+				CkptSortItem *next = item + run;
+
+				if (next->relNumber != item->relNumber ||
+					next->forkNum != item->forkNum ||
+					next->blockNum != item->blockNum + run)
+					break;
+				run++;
+			}
+
+			consumed = SyncBufferRun(item, run, &nwritten, &wb_context);
+
+			for (int j = 0; j < nwritten; j++)
+			{
+				TRACE_POSTGRESQL_BUFFER_SYNC_WRITTEN(item[j].buf_id);
 				PendingCheckpointerStats.buffers_written++;
 				num_written++;
 			}
 		}
+		else
+			consumed = 1;
+
+		num_processed += consumed;
 
 		/*
 		 * Measure progress independent of actually having to flush the buffer
 		 * - otherwise writing become unbalanced.
 		 */
-		ts_stat->progress += ts_stat->progress_slice;
-		ts_stat->num_scanned++;
-		ts_stat->index++;
+		ts_stat->progress += ts_stat->progress_slice * consumed;
+		ts_stat->num_scanned += consumed;
+		ts_stat->index += consumed;
 
 		/* Have all the buffers from the tablespace been processed? */
 		if (ts_stat->num_scanned == ts_stat->num_to_scan)
@@ -3867,6 +3898,7 @@ BgBufferSync(WritebackContext *wb_context)
 			reusable_buffers++;
 	}
 
+	PendingBgWriterStats.buf_scanned_clean += bufs_to_lap - num_to_scan;
 	PendingBgWriterStats.buf_written_clean += num_written;
 
 #ifdef BGW_DEBUG
@@ -3985,6 +4017,227 @@ SyncOneBuffer(int buf_id, bool skip_recently_used, WritebackContext *wb_context)
 	return result | BUF_WRITTEN;
 }
 
+/*
+ * SyncBufferRun -- write out a run of adjacent buffers during a checkpoint.
+ *
+ * items points to nitems entries of the checkpoint's sorted buffer list that
+ * describe consecutive blocks of a single relation fork.  We write out as
+ * long a prefix of the run as possible with a single vectored write.  The
+ * first buffer is handled as SyncOneBuffer() would; further buffers are only
+ * included if they can be share-locked and their I/O started without
+ * waiting, so that we never sleep while already holding buffer locks, and if
+ * they still contain the expected blocks and still need writing.
+ *
+ * Returns the number of items dealt with (always at least 1; items beyond
+ * that must be revisited by the caller).  *nwritten is set to the number of
+ * buffers actually written, which is never more than the returned value.
+ */
+static int
+SyncBufferRun(const CkptSortItem *items, int nitems, int *nwritten,
+			  WritebackContext *wb_context)
+{
+	static char *copybuf = NULL;
+	BufferDesc *bufs[MAX_IO_COMBINE_LIMIT];
+	const void *pages[MAX_IO_COMBINE_LIMIT];
+	RelFileLocator rlocator = {0};
+	ForkNumber	forknum = items[0].forkNum;
+	BlockNumber firstblk = items[0].blockNum;
+	SMgrRelation reln;
+	ErrorContextCallback errcallback;
+	instr_time	io_start;
+	XLogRecPtr	maxlsn = InvalidXLogRecPtr;
+	bool		permanent = false;
+	int			ncollect = 0;
+
+	Assert(nitems >= 1 && nitems <= io_combine_limit);
+
+	/*
+	 * Collect the prefix of the run that is ready to be written: pin each
+	 * buffer, share-lock it and mark its I/O in progress.  We stop at the
+	 * first buffer that no longer needs writing or that we'd have to wait
+	 * for.
+	 */
+	for (int i = 0; i < nitems; i++)
+	{
+		BufferDesc *bufHdr = GetBufferDescriptor(items[i].buf_id);
+		LWLock	   *content_lock;
+		uint32		buf_state;
+		XLogRecPtr	recptr;
+
+		/* Make sure we can handle the pin */
+		ReservePrivateRefCountEntry();
+		ResourceOwnerEnlarge(CurrentResourceOwner);
+
+		/*
+		 * Check whether the buffer needs writing.  As in SyncOneBuffer, the
+		 * header spinlock is enough for this; see comments there.
+		 */
+		buf_state = LockBufHdr(bufHdr);
+
+		if (bufHdr->tag.blockNum != firstblk + i ||
+			BufTagGetForkNum(&bufHdr->tag) != forknum ||
+			!(buf_state & BM_VALID) || !(buf_state & BM_DIRTY))
+		{
+			/* Replaced or already clean, so nothing to do */
+			UnlockBufHdr(bufHdr, buf_state);
+			break;
+		}
+
+		if (i == 0)
+			rlocator = BufTagGetRelFileLocator(&bufHdr->tag);
+		else if (!RelFileLocatorEquals(BufTagGetRelFileLocator(&bufHdr->tag),
+									   rlocator) ||
+				 !(buf_state & BM_CHECKPOINT_NEEDED))
+		{
+			/*
+			 * The sorted list does not record the database OID, so the run
+			 * could straddle two relations that share a relfilenumber; end
+			 * it at the relation boundary.  Likewise end it at a buffer
+			 * someone else has written out for us already.
+			 */
+			UnlockBufHdr(bufHdr, buf_state);
+			break;
+		}
+
+		PinBuffer_Locked(bufHdr);
+
+		/*
+		 * After the first buffer, never wait for a content lock or for
+		 * another backend's I/O to finish: sleeping while holding the
+		 * buffer locks collected so far could deadlock against backends
+		 * that lock buffers in a different order.
+		 */
+		content_lock = BufferDescriptorGetContentLock(bufHdr);
+		if (i == 0)
+			LWLockAcquire(content_lock, LW_SHARED);
+		else if (!LWLockConditionalAcquire(content_lock, LW_SHARED))
+		{
+			UnpinBuffer(bufHdr);
+			break;
+		}
+
+		if (!StartBufferIO(bufHdr, false, i > 0))
+		{
+			/* Someone else flushed the buffer before we could */
+			LWLockRelease(content_lock);
+			UnpinBuffer(bufHdr);
+			break;
+		}
+
+		/*
+		 * Read the buffer's LSN while holding the header lock, as in
+		 * FlushBuffer(), and clear BM_JUST_DIRTIED so that we can detect
+		 * concurrent re-dirtying when the write is done.
+		 */
+		buf_state = LockBufHdr(bufHdr);
+		recptr = BufferGetLSN(bufHdr);
+		buf_state &= ~BM_JUST_DIRTIED;
+		UnlockBufHdr(bufHdr, buf_state);
+
+		if (buf_state & BM_PERMANENT)
+		{
+			permanent = true;
+			if (recptr > maxlsn)
+				maxlsn = recptr;
+		}
+
+		bufs[ncollect++] = bufHdr;
+	}
+
+	*nwritten = ncollect;
+	if (ncollect == 0)
+		return 1;
+
+	/* Setup error traceback support for ereport() */
+	errcallback.callback = shared_buffer_write_error_callback;
+	errcallback.arg = bufs[0];
+	errcallback.previous = error_context_stack;
+	error_context_stack = &errcallback;
+
+	reln = smgropen(rlocator, INVALID_PROC_NUMBER);
+
+	TRACE_POSTGRESQL_BUFFER_FLUSH_START(forknum, firstblk,
+										rlocator.spcOid,
+										rlocator.dbOid,
+										rlocator.relNumber);
+
+	/*
+	 * Force XLOG flush up to the newest LSN of the run.  This implements the
+	 * basic WAL rule that log updates must hit disk before any of the
+	 * data-file changes they describe do; see FlushBuffer() for why buffers
+	 * of unlogged relations are exempt.
+	 */
+	if (permanent)
+		XLogFlush(maxlsn);
+
+	/*
+	 * Assemble the array of pages to write.  When checksums are enabled,
+	 * each page is copied into private memory before computing its checksum,
+	 * since we hold only shared locks and hint bits could change under us
+	 * (cf. PageSetChecksumCopy).
+	 */
+	for (int i = 0; i < ncollect; i++)
+	{
+		Block		bufBlock = BufHdrGetBlock(bufs[i]);
+
+		if (!PageIsNew((Page) bufBlock) && DataChecksumsEnabled())
+		{
+			char	   *copy;
+
+			if (copybuf == NULL)
+				copybuf = MemoryContextAllocAligned(TopMemoryContext,
+													(Size) BLCKSZ * MAX_IO_COMBINE_LIMIT,
+													PG_IO_ALIGN_SIZE,
+													0);
+			copy = copybuf + (Size) BLCKSZ * i;
+			memcpy(copy, bufBlock, BLCKSZ);
+			PageSetChecksumInplace((Page) copy, firstblk + i);
+			pages[i] = copy;
+		}
+		else
+			pages[i] = bufBlock;
+	}
+
+	io_start = pgstat_prepare_io_time(track_io_timing);
+
+	smgrwritev(reln, forknum, firstblk, pages, ncollect, false);
+
+	pgstat_count_io_op_time(IOOBJECT_RELATION, IOCONTEXT_NORMAL,
+							IOOP_WRITE, io_start, 1,
+							(uint64) ncollect * BLCKSZ);
+
+	pgBufferUsage.shared_blks_written += ncollect;
+
+	for (int i = 0; i < ncollect; i++)
+	{
+		BufferDesc *bufHdr = bufs[i];
+		BufferTag	tag;
+
+		/*
+		 * Mark the buffer as clean (unless BM_JUST_DIRTIED has become set)
+		 * and end the BM_IO_IN_PROGRESS state.
+		 */
+		TerminateBufferIO(bufHdr, true, 0, true, false);
+
+		LWLockRelease(BufferDescriptorGetContentLock(bufHdr));
+
+		tag = bufHdr->tag;
+		UnpinBuffer(bufHdr);
+
+		ScheduleBufferTagForWriteback(wb_context, IOCONTEXT_NORMAL, &tag);
+	}
+
+	TRACE_POSTGRESQL_BUFFER_FLUSH_DONE(forknum, firstblk,
+									   rlocator.spcOid,
+									   rlocator.dbOid,
+									   rlocator.relNumber);
+
+	/* Pop the error context stack */
+	error_context_stack = errcallback.previous;
+
+	return ncollect;
+}
+
 /*
  *		AtEOXact_Buffers - clean up at end of transaction.
  *
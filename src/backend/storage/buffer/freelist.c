@@ -15,11 +15,13 @@
  */
 #include "postgres.h"
 
+#include "miscadmin.h"
 #include "pgstat.h"
 #include "port/atomics.h"
 #include "storage/buf_internals.h"
 #include "storage/bufmgr.h"
 #include "storage/proc.h"
+#include "utils/guc_hooks.h"
 
 #define INT_ACCESS_ONCE(var)	((int)(*((volatile int *)&(var))))
 
@@ -29,15 +31,19 @@
  */
 typedef struct
 {
-	/* Spinlock: protects the values below */
+	/* Spinlock: protects the freelist and bgwprocno */
 	slock_t		buffer_strategy_lock;
 
 	/*
 	 * Clock sweep hand: index of next buffer to consider grabbing. Note that
-	 * this isn't a concrete buffer - we only ever increase the value. So, to
-	 * get an actual buffer, it needs to be used modulo NBuffers.
+	 * this isn't a concrete buffer - we only ever increase the value, without
+	 * wrapping it, so to get an actual buffer it needs to be used modulo
+	 * NBuffers.  Keeping it monotonic makes the completed-pass count simply
+	 * nextVictimBuffer / NBuffers, so StrategySyncStart() can derive a
+	 * consistent (hand, passes) pair from one atomic read.  64 bits cannot
+	 * overflow in any plausible lifetime of a cluster.
 	 */
-	pg_atomic_uint32 nextVictimBuffer;
+	pg_atomic_uint64 nextVictimBuffer;
 
 	int			firstFreeBuffer;	/* Head of list of unused buffers */
 	int			lastFreeBuffer; /* Tail of list of unused buffers */
@@ -51,7 +57,6 @@ typedef struct
 	 * Statistics.  These counters should be wide enough that they can't
 	 * overflow during a single bgwriter cycle.
 	 */
-	uint32		completePasses; /* Complete cycles of the clock sweep */
 	pg_atomic_uint32 numBufferAllocs;	/* Buffers allocated since last reset */
 
 	/*
@@ -107,60 +112,21 @@ static void AddBufferToRing(BufferAccessStrategy strategy,
 static inline uint32
 ClockSweepTick(void)
 {
-	uint32		victim;
+	uint64		victim;
 
 	/*
 	 * Atomically move hand ahead one buffer - if there's several processes
 	 * doing this, this can lead to buffers being returned slightly out of
 	 * apparent order.
+	 *
+	 * nextVictimBuffer is never wrapped back into range, so no
+	 * pass-completion bookkeeping is needed here: the completed-pass count
+	 * is just the quotient of the counter and NBuffers.
 	 */
 	victim =
-		pg_atomic_fetch_add_u32(&StrategyControl->nextVictimBuffer, 1);
-
-	if (victim >= NBuffers)
-	{
-		uint32		originalVictim = victim;
-
-		/* always wrap what we look up in BufferDescriptors */
-		victim = victim % NBuffers;
-
-		/*
-		 * If we're the one that just caused a wraparound, force
-		 * completePasses to be incremented while holding the spinlock. We
-		 * need the spinlock so StrategySyncStart() can return a consistent
-		 * value consisting of nextVictimBuffer and completePasses.
-		 */
-		if (victim == 0)
-		{
-			uint32		expected;
-			uint32		wrapped;
-			bool		success = false;
-
-			expected = originalVictim + 1;
-
-			while (!success)
-			{
-				/*
-				 * Acquire the spinlock while increasing completePasses. That
-				 * allows other readers to read nextVictimBuffer and
-				 * completePasses in a consistent manner which is required for
-				 * StrategySyncStart().  In theory delaying the increment
-				 * could lead to an overflow of nextVictimBuffers, but that's
-				 * highly unlikely and wouldn't be particularly harmful.
-				 */
-				SpinLockAcquire(&StrategyControl->buffer_strategy_lock);
+		pg_atomic_fetch_add_u64(&StrategyControl->nextVictimBuffer, 1);
 
-				wrapped = expected % NBuffers;
-
-				success = pg_atomic_compare_exchange_u32(&StrategyControl->nextVictimBuffer,
-														 &expected, wrapped);
-				if (success)
-					StrategyControl->completePasses++;
-				SpinLockRelease(&StrategyControl->buffer_strategy_lock);
-			}
-		}
-	}
-	return victim;
+	return (uint32) (victim % NBuffers);
 }
 
 /*
@@ -393,29 +359,25 @@ StrategyFreeBuffer(BufferDesc *buf)
 int
 StrategySyncStart(uint32 *complete_passes, uint32 *num_buf_alloc)
 {
-	uint32		nextVictimBuffer;
+	uint64		nextVictimBuffer;
 	int			result;
 
-	SpinLockAcquire(&StrategyControl->buffer_strategy_lock);
-	nextVictimBuffer = pg_atomic_read_u32(&StrategyControl->nextVictimBuffer);
-	result = nextVictimBuffer % NBuffers;
+	/*
+	 * Since nextVictimBuffer is never wrapped, a single atomic read yields a
+	 * consistent hand position and completed-pass count; the combined count
+	 * (passes * NBuffers + hand) is monotonic, as BgBufferSync assumes when
+	 * computing how far the hand moved since the previous call.
+	 */
+	nextVictimBuffer = pg_atomic_read_u64(&StrategyControl->nextVictimBuffer);
+	result = (uint32) (nextVictimBuffer % NBuffers);
 
 	if (complete_passes)
-	{
-		*complete_passes = StrategyControl->completePasses;
-
-		/*
-		 * Additionally add the number of wraparounds that happened before
-		 * completePasses could be incremented. C.f. ClockSweepTick().
-		 */
-		*complete_passes += nextVictimBuffer / NBuffers;
-	}
+		*complete_passes = (uint32) (nextVictimBuffer / NBuffers);
 
 	if (num_buf_alloc)
 	{
 		*num_buf_alloc = pg_atomic_exchange_u32(&StrategyControl->numBufferAllocs, 0);
 	}
-	SpinLockRelease(&StrategyControl->buffer_strategy_lock);
 	return result;
 }
 
@@ -512,10 +474,9 @@ StrategyInitialize(bool init)
 		StrategyControl->lastFreeBuffer = NBuffers - 1;
 
 		/* Initialize the clock sweep pointer */
-		pg_atomic_init_u32(&StrategyControl->nextVictimBuffer, 0);
+		pg_atomic_init_u64(&StrategyControl->nextVictimBuffer, 0);
 
 		/* Clear statistics */
-		StrategyControl->completePasses = 0;
 		pg_atomic_init_u32(&StrategyControl->numBufferAllocs, 0);
 
 		/* No pending notification */
@@ -615,6 +576,29 @@ GetAccessStrategy(BufferAccessStrategyType btype)
 	return GetAccessStrategyWithSize(btype, ring_size_kb);
 }
 
+/*
+ * GUC check function to ensure GUC value specified is within the allowable
+ * range.  -1 means the ring is sized automatically by GetAccessStrategy().
+ */
+bool
+check_bulk_read_buffer_usage_limit(int *newval, void **extra,
+								   GucSource source)
+{
+	/* Value upper and lower hard limits are inclusive */
+	if (*newval == -1 || *newval == 0 ||
+		(*newval >= MIN_BAS_BULKREAD_RING_SIZE_KB &&
+		 *newval <= MAX_BAS_BULKREAD_RING_SIZE_KB))
+		return true;
+
+	/* Value does not fall within any allowable range */
+	GUC_check_errdetail("\"%s\" must be -1, 0, or between %d kB and %d kB.",
+						"bulk_read_buffer_usage_limit",
+						MIN_BAS_BULKREAD_RING_SIZE_KB,
+						MAX_BAS_BULKREAD_RING_SIZE_KB);
+
+	return false;
+}
+
 /*
  * GetAccessStrategyWithSize -- create a BufferAccessStrategy object with a
  *		number of buffers equivalent to the passed in size.
@@ -740,6 +724,18 @@ GetBufferFromRing(BufferAccessStrategy strategy, uint32 *buf_state)
 	Buffer		bufnum;
 	uint32		local_buf_state;	/* to avoid repeated (de-)referencing */
 
+	/*
+	 * While the pool still contains never-used buffers there is no eviction
+	 * pressure, so recycling our ring only starves the free pool and throws
+	 * away pages that could have stayed resident.  Decline, so that the
+	 * caller allocates from the freelist instead; the buffer previously in
+	 * this ring slot is left alone and thereby effectively promoted to a
+	 * normal buffer.  The unlocked read is the same harmless race as in
+	 * StrategyGetBuffer(); once the freelist empties, ring behavior resumes
+	 * and the pool is protected from being flushed by large scans as usual.
+	 */
+	if (StrategyControl->firstFreeBuffer >= 0)
+		return NULL;
 
 	/* Advance to next ring slot */
 	if (++strategy->current >= strategy->nbuffers)
@@ -177,12 +177,21 @@ LocalBufferAlloc(SMgrRelation smgr, ForkNumber forkNum, BlockNumber blockNum,
 
 /*
  * Like FlushBuffer(), just for local buffers.
+ *
+ * To combine writes, we also flush any dirty local buffers holding the
+ * blocks immediately following the given buffer's block, up to
+ * io_combine_limit blocks in total.  Temp-table ETL workloads dirty long
+ * runs of consecutive blocks, and the clock sweep tends to reach the head
+ * of such a run first, so a single smgrwritev() here typically replaces
+ * many one-block writes.
  */
 void
 FlushLocalBuffer(BufferDesc *bufHdr, SMgrRelation reln)
 {
 	instr_time	io_start;
-	Page		localpage = (char *) LocalBufHdrGetBlock(bufHdr);
+	BufferDesc *bufHdrs[MAX_IO_COMBINE_LIMIT];
+	const void *localpages[MAX_IO_COMBINE_LIMIT];
+	int			nbufs;
 
 	Assert(LocalRefCount[-BufferDescriptorGetBuffer(bufHdr) - 1] > 0);
 
@@ -193,30 +202,67 @@ FlushLocalBuffer(BufferDesc *bufHdr, SMgrRelation reln)
 	if (!StartLocalBufferIO(bufHdr, false, false))
 		elog(ERROR, "failed to start write IO on local buffer");
 
+	bufHdrs[0] = bufHdr;
+	nbufs = 1;
+
+	/*
+	 * Extend the run with successive blocks of the same relation fork, as
+	 * long as they reside in dirty local buffers.  We don't wait for AIO on
+	 * a neighbor; StartLocalBufferIO(nowait = true) just declines and we
+	 * stop extending.  Neighbors need not be pinned: we're single-threaded
+	 * here, so their contents cannot change underneath the write.
+	 */
+	while (nbufs < io_combine_limit)
+	{
+		BufferTag	tag = bufHdr->tag;
+		LocalBufferLookupEnt *hresult;
+		BufferDesc *nbrHdr;
+
+		tag.blockNum += nbufs;
+		hresult = (LocalBufferLookupEnt *)
+			hash_search(LocalBufHash, &tag, HASH_FIND, NULL);
+		if (!hresult)
+			break;
+
+		nbrHdr = GetLocalBufferDescriptor(hresult->id);
+		if (!StartLocalBufferIO(nbrHdr, false, true))
+			break;
+
+		bufHdrs[nbufs++] = nbrHdr;
+	}
+
 	/* Find smgr relation for buffer */
 	if (reln == NULL)
 		reln = smgropen(BufTagGetRelFileLocator(&bufHdr->tag),
 						MyProcNumber);
 
-	PageSetChecksumInplace(localpage, bufHdr->tag.blockNum);
+	for (int i = 0; i < nbufs; i++)
+	{
+		Page		localpage = (char *) LocalBufHdrGetBlock(bufHdrs[i]);
+
+		PageSetChecksumInplace(localpage, bufHdrs[i]->tag.blockNum);
+		localpages[i] = localpage;
+	}
 
 	io_start = pgstat_prepare_io_time(track_io_timing);
 
 	/* And write... */
-	smgrwrite(reln,
-			  BufTagGetForkNum(&bufHdr->tag),
-			  bufHdr->tag.blockNum,
-			  localpage,
-			  false);
+	smgrwritev(reln,
+			   BufTagGetForkNum(&bufHdr->tag),
+			   bufHdr->tag.blockNum,
+			   localpages,
+			   nbufs,
+			   false);
 
 	/* Temporary table I/O does not use Buffer Access Strategies */
 	pgstat_count_io_op_time(IOOBJECT_TEMP_RELATION, IOCONTEXT_NORMAL,
-							IOOP_WRITE, io_start, 1, BLCKSZ);
+							IOOP_WRITE, io_start, 1, nbufs * BLCKSZ);
 
 	/* Mark not-dirty */
-	TerminateLocalBufferIO(bufHdr, true, 0, false);
+	for (int i = 0; i < nbufs; i++)
+		TerminateLocalBufferIO(bufHdrs[i], true, 0, false);
 
-	pgBufferUsage.local_blks_written++;
+	pgBufferUsage.local_blks_written += nbufs;
 }
 
 static Buffer
@@ -107,7 +107,9 @@ static BufFile *makeBufFileCommon(int nfiles);
 static BufFile *makeBufFile(File firstfile);
 static void extendBufFile(BufFile *file);
 static void BufFileLoadBuffer(BufFile *file);
+static size_t BufFileReadDirect(BufFile *file, void *ptr, size_t size);
 static void BufFileDumpBuffer(BufFile *file);
+static void BufFileWriteDirect(BufFile *file, const void *ptr, size_t size);
 static void BufFileFlush(BufFile *file);
 static File MakeNewFileSetSegment(BufFile *buffile, int segment);
 
@@ -483,6 +485,94 @@ BufFileLoadBuffer(BufFile *file)
 		pgBufferUsage.temp_blks_read++;
 }
 
+/*
+ * BufFileReadDirect
+ *
+ * Read up to 'size' bytes straight into the caller's memory, bypassing our
+ * own buffer.  This avoids a memcpy per block and lets the kernel see large
+ * requests instead of BLCKSZ-sized ones.  The caller must have emptied the
+ * buffer (pos == nbytes == 0), so that curOffset is the logical read
+ * position; curOffset is advanced past what we read.  Returns the number of
+ * bytes read, which is less than 'size' only at end of file.
+ */
+static size_t
+BufFileReadDirect(BufFile *file, void *ptr, size_t size)
+{
+	size_t		nread = 0;
+
+	while (size > 0)
+	{
+		File		thisfile;
+		off_t		availbytes;
+		size_t		bytestoread;
+		int			nthistime;
+		instr_time	io_start;
+		instr_time	io_time;
+
+		/*
+		 * Advance to next component file if necessary and possible.
+		 */
+		if (file->curOffset >= MAX_PHYSICAL_FILESIZE &&
+			file->curFile + 1 < file->numFiles)
+		{
+			file->curFile++;
+			file->curOffset = 0;
+		}
+
+		/*
+		 * Read what we can from this file, up to the segment boundary.
+		 */
+		bytestoread = size;
+		availbytes = MAX_PHYSICAL_FILESIZE - file->curOffset;
+		if ((off_t) bytestoread > availbytes)
+			bytestoread = (size_t) availbytes;
+
+		/* at the very end of a full final segment? */
+		if (bytestoread == 0)
+			break;
+
+		thisfile = file->files[file->curFile];
+
+		if (track_io_timing)
+			INSTR_TIME_SET_CURRENT(io_start);
+		else
+			INSTR_TIME_SET_ZERO(io_start);
+
+		nthistime = FileRead(thisfile,
+							 ptr,
+							 bytestoread,
+							 file->curOffset,
+							 WAIT_EVENT_BUFFILE_READ);
+		if (nthistime < 0)
+			ereport(ERROR,
+					(errcode_for_file_access(),
+					 errmsg("could not read file \"%s\": %m",
+							FilePathName(thisfile))));
+
+		if (track_io_timing)
+		{
+			INSTR_TIME_SET_CURRENT(io_time);
+			INSTR_TIME_ACCUM_DIFF(pgBufferUsage.temp_blk_read_time, io_time, io_start);
+		}
+
+		pgBufferUsage.temp_blks_read += (nthistime + BLCKSZ - 1) / BLCKSZ;
+
+		file->curOffset += nthistime;
+		ptr = (char *) ptr + nthistime;
+		size -= nthistime;
+		nread += nthistime;
+
+		/*
+		 * A short read can only mean end of file: all segments but the last
+		 * have length exactly MAX_PHYSICAL_FILESIZE.
+		 */
+		if ((size_t) nthistime < bytestoread)
+			break;
+	}
+
+	return nread;
+}
+
 /*
  * BufFileDumpBuffer
  *
@@ -579,6 +669,80 @@ BufFileDumpBuffer(BufFile *file)
 	file->nbytes = 0;
 }
 
+/*
+ * BufFileWriteDirect
+ *
+ * Write 'size' bytes straight from the caller's memory, bypassing our own
+ * buffer.  Like BufFileReadDirect, this avoids a memcpy per block and issues
+ * large writes instead of BLCKSZ-sized ones.  The caller must have flushed
+ * and emptied the buffer (pos == nbytes == 0, not dirty), so that curOffset
+ * is the logical write position; curOffset is advanced past what we wrote.
+ */
+static void
+BufFileWriteDirect(BufFile *file, const void *ptr, size_t size)
+{
+	Assert(!file->dirty);
+
+	while (size > 0)
+	{
+		File		thisfile;
+		off_t		availbytes;
+		size_t		bytestowrite;
+		int			nthistime;
+		instr_time	io_start;
+		instr_time	io_time;
+
+		/*
+		 * Advance to next component file if necessary and possible.
+		 */
+		if (file->curOffset >= MAX_PHYSICAL_FILESIZE)
+		{
+			while (file->curFile + 1 >= file->numFiles)
+				extendBufFile(file);
+			file->curFile++;
+			file->curOffset = 0;
+		}
+
+		/*
+		 * Determine how much we can write into this file.
+		 */
+		bytestowrite = size;
+		availbytes = MAX_PHYSICAL_FILESIZE - file->curOffset;
+		if ((off_t) bytestowrite > availbytes)
+			bytestowrite = (size_t) availbytes;
+
+		thisfile = file->files[file->curFile];
+
+		if (track_io_timing)
+			INSTR_TIME_SET_CURRENT(io_start);
+		else
+			INSTR_TIME_SET_ZERO(io_start);
+
+		nthistime = FileWrite(thisfile,
+							  ptr,
+							  bytestowrite,
+							  file->curOffset,
+							  WAIT_EVENT_BUFFILE_WRITE);
+		if (nthistime <= 0)
+			ereport(ERROR,
+					(errcode_for_file_access(),
+					 errmsg("could not write to file \"%s\": %m",
+							FilePathName(thisfile))));
+
+		if (track_io_timing)
+		{
+			INSTR_TIME_SET_CURRENT(io_time);
+			INSTR_TIME_ACCUM_DIFF(pgBufferUsage.temp_blk_write_time, io_time, io_start);
+		}
+
+		pgBufferUsage.temp_blks_written += (nthistime + BLCKSZ - 1) / BLCKSZ;
+
+		file->curOffset += nthistime;
+		ptr = (const char *) ptr + nthistime;
+		size -= nthistime;
+	}
+}
+
 /*
  * BufFileRead variants
  *
@@ -602,10 +766,30 @@ BufFileReadCommon(BufFile *file, void *ptr, size_t size, bool exact, bool eofOK)
 	{
 		if (file->pos >= file->nbytes)
 		{
-			/* Try to load more data into buffer. */
+			/* Buffer is exhausted; set it empty at the logical position. */
 			file->curOffset += file->pos;
 			file->pos = 0;
 			file->nbytes = 0;
+
+			/*
+			 * If at least a full buffer's worth remains to be read, fetch
+			 * whole blocks directly into the caller's memory, and keep any
+			 * sub-block remainder for the buffered path below.
+			 */
+			if (size >= (size_t) BLCKSZ)
+			{
+				size_t		wanted = size - size % BLCKSZ;
+				size_t		ndirect = BufFileReadDirect(file, ptr, wanted);
+
+				ptr = (char *) ptr + ndirect;
+				size -= ndirect;
+				nread += ndirect;
+				if (ndirect < wanted)
+					break;		/* no more data available */
+				continue;
+			}
+
+			/* Try to load more data into buffer. */
 			BufFileLoadBuffer(file);
 			if (file->nbytes <= 0)
 				break;			/* no more data available */
@@ -695,6 +879,21 @@ BufFileWrite(BufFile *file, const void *ptr, size_t size)
 			}
 		}
 
+		/*
+		 * If the buffer is empty and at least a full buffer's worth remains
+		 * to be written, write whole blocks directly from the caller's
+		 * memory; any sub-block remainder goes through the buffer as usual.
+		 */
+		if (file->pos == 0 && file->nbytes == 0 && size >= (size_t) BLCKSZ)
+		{
+			size_t		ndirect = size - size % BLCKSZ;
+
+			BufFileWriteDirect(file, ptr, ndirect);
+			ptr = (const char *) ptr + ndirect;
+			size -= ndirect;
+			continue;
+		}
+
 		nthistime = BLCKSZ - file->pos;
 		if (nthistime > size)
 			nthistime = size;
@@ -141,6 +141,49 @@ GetPageWithFreeSpace(Relation rel, Size spaceNeeded)
 	return fsm_search(rel, min_cat);
 }
 
+/*
+ * GetPageWithFreeSpaceNear - try to find a page with at least the specified
+ *		amount of free space in the vicinity of the given heap block.
+ *
+ * Only the FSM leaf page covering 'nearBlock' is searched, i.e. pages within
+ * the same SLOTS_PER_FSM_PAGE-block neighborhood.  If nothing suitable is
+ * found there, InvalidBlockNumber is returned and the caller can fall back
+ * to an ordinary search or extension; we deliberately don't search the rest
+ * of the tree here, since a caller that wants a nearby page is better served
+ * by its usual placement logic than by a random far-away page.
+ */
+BlockNumber
+GetPageWithFreeSpaceNear(Relation rel, BlockNumber nearBlock, Size spaceNeeded)
+{
+	uint8		min_cat = fsm_space_needed_to_cat(spaceNeeded);
+	FSMAddress	addr;
+	uint16		slot;
+	Buffer		buf;
+	int			newslot = -1;
+
+	/* Get the location of the FSM byte representing the heap block */
+	addr = fsm_get_location(nearBlock, &slot);
+
+	buf = fsm_readbuf(rel, addr, false);
+	if (BufferIsValid(buf))
+	{
+		LockBuffer(buf, BUFFER_LOCK_SHARE);
+		newslot = fsm_search_avail(buf, min_cat, true, false);
+		UnlockReleaseBuffer(buf);
+	}
+
+	if (newslot != -1)
+	{
+		BlockNumber blknum = fsm_get_heap_blk(addr, newslot);
+
+		/* As in RecordAndGetPageWithFreeSpace, distrust stale FSM data. */
+		if (fsm_does_block_exist(rel, blknum))
+			return blknum;
+	}
+
+	return InvalidBlockNumber;
+}
+
 /*
  * RecordAndGetPageWithFreeSpace - update info about a page and try again.
  *
@@ -90,6 +90,9 @@ static bool dsm_impl_mmap(dsm_op op, dsm_handle handle, Size request_size,
 						  void **impl_private, void **mapped_address,
 						  Size *mapped_size, int elevel);
 #endif
+#ifndef WIN32
+static void dsm_impl_request_huge_pages(void *address, Size size, dsm_op op);
+#endif
 static int	errcode_for_dynamic_shared_memory(void);
 
 const struct config_enum_entry dynamic_shared_memory_options[] = {
@@ -114,6 +117,9 @@ int			dynamic_shared_memory_type = DEFAULT_DYNAMIC_SHARED_MEMORY_TYPE;
 /* Amount of space reserved for DSM segments in the main area. */
 int			min_dynamic_shared_memory;
 
+/* Ask the kernel for transparent huge pages backing DSM segments? */
+bool		dsm_huge_pages = false;
+
 /* Size of buffer to be used for zero-filling. */
 #define ZBUFFER_SIZE				8192
 
@@ -193,6 +199,40 @@ dsm_impl_op(dsm_op op, dsm_handle handle, Size request_size,
 	}
 }
 
+#ifndef WIN32
+/*
+ * Ask the kernel to back a freshly mapped segment with transparent huge
+ * pages, if dsm_huge_pages is enabled.
+ *
+ * This is strictly best effort: the advice is ignored on kernels without
+ * transparent huge page support for shared mappings, and failure of the
+ * madvise() calls is not an error.  We therefore need no fallback logic of
+ * our own, unlike MAP_HUGETLB for the main shared memory segment.
+ *
+ * Where available (Linux 6.1+), MADV_COLLAPSE additionally makes a
+ * synchronous attempt to assemble huge pages right away rather than leaving
+ * it to khugepaged.  Collapsing faults in the whole segment, so we only do
+ * that in the creating process; segments are created at their final size,
+ * and consumers such as dsa.c grow by creating progressively larger
+ * segments as occupancy increases.
+ */
+static void
+dsm_impl_request_huge_pages(void *address, Size size, dsm_op op)
+{
+#ifdef MADV_HUGEPAGE
+	if (!dsm_huge_pages)
+		return;
+
+	(void) madvise(address, size, MADV_HUGEPAGE);
+
+#ifdef MADV_COLLAPSE
+	if (op == DSM_OP_CREATE)
+		(void) madvise(address, size, MADV_COLLAPSE);
+#endif
+#endif							/* MADV_HUGEPAGE */
+}
+#endif							/* !WIN32 */
+
 #ifdef USE_DSM_POSIX
 /*
  * Operating system primitives to support POSIX shared memory.
@@ -334,6 +374,7 @@ dsm_impl_posix(dsm_op op, dsm_handle handle, Size request_size,
 	}
 	*mapped_address = address;
 	*mapped_size = request_size;
+	dsm_impl_request_huge_pages(address, request_size, op);
 	close(fd);
 	ReleaseExternalFD();
 
@@ -587,6 +628,7 @@ dsm_impl_sysv(dsm_op op, dsm_handle handle, Size request_size,
 	}
 	*mapped_address = address;
 	*mapped_size = request_size;
+	dsm_impl_request_huge_pages(address, request_size, op);
 
 	return true;
 }
@@ -936,6 +978,7 @@ dsm_impl_mmap(dsm_op op, dsm_handle handle, Size request_size,
 	}
 	*mapped_address = address;
 	*mapped_size = request_size;
+	dsm_impl_request_huge_pages(address, request_size, op);
 
 	if (CloseTransientFile(fd) != 0)
 	{
@@ -441,7 +441,7 @@ ProcArrayShmemInit(void)
 		procArray->lastOverflowedXid = InvalidTransactionId;
 		procArray->replication_slot_xmin = InvalidTransactionId;
 		procArray->replication_slot_catalog_xmin = InvalidTransactionId;
-		TransamVariables->xactCompletionCount = 1;
+		pg_atomic_init_u64(&TransamVariables->xactCompletionCount, 1);
 	}
 
 	allProcs = ProcGlobal->allProcs;
@@ -495,20 +495,33 @@ ProcArrayAdd(PGPROC *proc)
 	 * PGPROC structure in the cache.
 	 *
 	 * Since the occurrence of adding/removing a proc is much lower than the
-	 * access to the ProcArray itself, the overhead should be marginal
+	 * access to the ProcArray itself, the overhead should be marginal.
+	 *
+	 * Use a binary search to find the insertion point; with high connection
+	 * churn the linear scan's share of the exclusive-lock hold time becomes
+	 * measurable at large max_connections.
 	 */
-	for (index = 0; index < arrayP->numProcs; index++)
 	{
-		int			this_procno = arrayP->pgprocnos[index];
+		int			lo = 0;
+		int			hi = arrayP->numProcs;
 
-		Assert(this_procno >= 0 && this_procno < (arrayP->maxProcs + NUM_AUXILIARY_PROCS));
-		Assert(allProcs[this_procno].pgxactoff == index);
+		while (lo < hi)
+		{
+			int			mid = (lo + hi) / 2;
 
-		/* If we have found our right position in the array, break */
-		if (this_procno > pgprocno)
-			break;
+			if (arrayP->pgprocnos[mid] > pgprocno)
+				hi = mid;
+			else
+				lo = mid + 1;
+		}
+		index = lo;
 	}
 
+	/* verify the insertion point, and the array's sortedness around it */
+	Assert(index == arrayP->numProcs ||
+		   arrayP->pgprocnos[index] > pgprocno);
+	Assert(index == 0 || arrayP->pgprocnos[index - 1] < pgprocno);
+
 	movecount = arrayP->numProcs - index;
 	memmove(&arrayP->pgprocnos[index + 1],
 			&arrayP->pgprocnos[index],
@@ -591,7 +604,7 @@ ProcArrayRemove(PGPROC *proc, TransactionId latestXid)
 		MaintainLatestCompletedXid(latestXid);
 
 		/* Same with xactCompletionCount  */
-		TransamVariables->xactCompletionCount++;
+		pg_atomic_fetch_add_u64(&TransamVariables->xactCompletionCount, 1);
 
 		ProcGlobal->xids[myoff] = InvalidTransactionId;
 		ProcGlobal->subxidStates[myoff].overflowed = false;
@@ -773,7 +786,7 @@ ProcArrayEndTransactionInternal(PGPROC *proc, TransactionId latestXid)
 	MaintainLatestCompletedXid(latestXid);
 
 	/* Same with xactCompletionCount  */
-	TransamVariables->xactCompletionCount++;
+	pg_atomic_fetch_add_u64(&TransamVariables->xactCompletionCount, 1);
 }
 
 /*
@@ -916,8 +929,8 @@ ProcArrayClearTransaction(PGPROC *proc)
 	 * We could however, as this action does not actually change anyone's view
 	 * of the set of running XIDs (our entry is duplicate with the gxact that
 	 * has already been inserted into the ProcArray), lower the lock level to
-	 * shared if we were to make xactCompletionCount an atomic variable. But
-	 * that doesn't seem worth it currently, as a 2PC commit is heavyweight
+	 * shared now that xactCompletionCount is an atomic variable. But that
+	 * doesn't seem worth it currently, as a 2PC commit is heavyweight
 	 * enough for this not to be the bottleneck.  If it ever becomes a
 	 * bottleneck it may also be worth considering to combine this with the
 	 * subsequent ProcArrayRemove()
@@ -943,7 +956,7 @@ ProcArrayClearTransaction(PGPROC *proc)
 	 * otherwise could end up reusing the snapshot later. Which would be bad,
 	 * because it might not count the prepared transaction as running.
 	 */
-	TransamVariables->xactCompletionCount++;
+	pg_atomic_fetch_add_u64(&TransamVariables->xactCompletionCount, 1);
 
 	/* Clear the subtransaction-XID cache too */
 	Assert(ProcGlobal->subxidStates[pgxactoff].count == proc->subxidStatus.count &&
@@ -2036,20 +2049,28 @@ GetMaxSnapshotSubxidCount(void)
  * the fields that need to change and returns true. Otherwise it returns
  * false.
  *
- * This very likely can be evolved to not need ProcArrayLock held (at very
- * least in the case we already hold a snapshot), but that's for another day.
+ * This may be called without ProcArrayLock held, provided the caller's xmin
+ * is already published (i.e. MyProc->xmin is valid).  See the comments below
+ * for why that is safe.
  */
 static bool
 GetSnapshotDataReuse(Snapshot snapshot)
 {
 	uint64		curXactCompletionCount;
 
-	Assert(LWLockHeldByMe(ProcArrayLock));
+	Assert(LWLockHeldByMe(ProcArrayLock) ||
+		   TransactionIdIsValid(MyProc->xmin));
 
 	if (unlikely(snapshot->snapXactCompletionCount == 0))
 		return false;
 
-	curXactCompletionCount = TransamVariables->xactCompletionCount;
+	/*
+	 * The full barrier in this read pairs with the lock operations around
+	 * the increment in ProcArrayEndTransaction() et al: if the completion of
+	 * any transaction could causally have been observed by whoever prompted
+	 * this snapshot to be taken, the incremented counter is visible here.
+	 */
+	curXactCompletionCount = pg_atomic_read_membarrier_u64(&TransamVariables->xactCompletionCount);
 	if (curXactCompletionCount != snapshot->snapXactCompletionCount)
 		return false;
 
@@ -2072,6 +2093,14 @@ GetSnapshotDataReuse(Snapshot snapshot)
 	 * require the set of running transactions to change) and it fulfills the
 	 * requirement that concurrent GetSnapshotData() calls yield the same
 	 * xmin.
+	 *
+	 * When called without ProcArrayLock, the caller's already-published xmin
+	 * (which is <= snapshot->xmin) prevents rows visible under the snapshot
+	 * from being removed while we decide.  Transactions completing
+	 * concurrently may be treated as still running, but that is no different
+	 * from having built the snapshot just before they completed; the barrier
+	 * in the read above ensures we cannot miss a completion that anyone has
+	 * been able to observe.
 	 */
 	if (!TransactionIdIsValid(MyProc->xmin))
 		MyProc->xmin = TransactionXmin = snapshot->xmin;
@@ -2172,6 +2201,16 @@ GetSnapshotData(Snapshot snapshot)
 					 errmsg("out of memory")));
 	}
 
+	/*
+	 * If our xmin is already published by an earlier snapshot, we can try to
+	 * reuse the previous snapshot contents without touching ProcArrayLock at
+	 * all, making snapshot acquisition O(1) for the common case of a
+	 * read-mostly backend whose transaction already holds a snapshot.
+	 */
+	if (TransactionIdIsValid(MyProc->xmin) &&
+		GetSnapshotDataReuse(snapshot))
+		return snapshot;
+
 	/*
 	 * It is sufficient to get shared lock on ProcArrayLock, even if we are
 	 * going to set MyProc->xmin.
@@ -2190,7 +2229,7 @@ GetSnapshotData(Snapshot snapshot)
 	Assert(myxid == MyProc->xid);
 
 	oldestxid = TransamVariables->oldestXid;
-	curXactCompletionCount = TransamVariables->xactCompletionCount;
+	curXactCompletionCount = pg_atomic_read_u64(&TransamVariables->xactCompletionCount);
 
 	/* xmax is always latestCompletedXid + 1 */
 	xmax = XidFromFullTransactionId(latest_completed);
@@ -2452,6 +2491,9 @@ GetSnapshotData(Snapshot snapshot)
 	snapshot->subxcnt = subcount;
 	snapshot->suboverflowed = suboverflowed;
 	snapshot->snapXactCompletionCount = curXactCompletionCount;
+	/* the contents may differ from the previous use, so flush the XID cache */
+	snapshot->xicCount = 0;
+	snapshot->xicNext = 0;
 
 	snapshot->curcid = GetCurrentCommandId(false);
 
@@ -4013,7 +4055,7 @@ XidCacheRemoveRunningXids(TransactionId xid,
 	MaintainLatestCompletedXid(latestXid);
 
 	/* ... and xactCompletionCount */
-	TransamVariables->xactCompletionCount++;
+	pg_atomic_fetch_add_u64(&TransamVariables->xactCompletionCount, 1);
 
 	LWLockRelease(ProcArrayLock);
 }
@@ -4433,7 +4475,7 @@ ExpireTreeKnownAssignedTransactionIds(TransactionId xid, int nsubxids,
 	MaintainLatestCompletedXidRecovery(max_xid);
 
 	/* ... and xactCompletionCount */
-	TransamVariables->xactCompletionCount++;
+	pg_atomic_fetch_add_u64(&TransamVariables->xactCompletionCount, 1);
 
 	LWLockRelease(ProcArrayLock);
 }
@@ -4460,7 +4502,7 @@ ExpireAllKnownAssignedTransactionIds(void)
 	 * Any transactions that were in-progress were effectively aborted, so
 	 * advance xactCompletionCount.
 	 */
-	TransamVariables->xactCompletionCount++;
+	pg_atomic_fetch_add_u64(&TransamVariables->xactCompletionCount, 1);
 
 	/*
 	 * Reset lastOverflowedXid.  Currently, lastOverflowedXid has no use after
@@ -4489,7 +4531,7 @@ ExpireOldKnownAssignedTransactionIds(TransactionId xid)
 	MaintainLatestCompletedXidRecovery(latestXid);
 
 	/* ... and xactCompletionCount */
-	TransamVariables->xactCompletionCount++;
+	pg_atomic_fetch_add_u64(&TransamVariables->xactCompletionCount, 1);
 
 	/*
 	 * Reset lastOverflowedXid if we know all transactions that have been
@@ -4596,6 +4638,16 @@ KnownAssignedTransactionIdsIdleMaintenance(void)
  * currently valid XIDs in the array (N).  Except in special cases, we'll
  * compress when S >= 2N.  Bounding S at 2N in turn bounds the time for
  * taking a snapshot to be O(N), which it would have to be anyway.
+ *
+ * Note that most standby snapshots never scan the array at all: the
+ * snapshot-reuse logic in GetSnapshotDataReuse() applies during recovery
+ * too.  xactCompletionCount is advanced whenever the replay of a commit or
+ * abort removes entries (ExpireTreeKnownAssignedTransactionIds), which is
+ * the only kind of change that can affect an existing snapshot's contents.
+ * Adding entries doesn't invalidate cached snapshots, because newly observed
+ * XIDs follow latestObservedXid and hence the xmax of any snapshot taken
+ * earlier, so such XIDs are treated as running by those snapshots with or
+ * without an array entry.
  */
 
 
@@ -69,7 +69,13 @@ void
 ReceiveSharedInvalidMessages(void (*invalFunction) (SharedInvalidationMessage *msg),
 							 void (*resetFunction) (void))
 {
-#define MAXINVALMSGS 32
+	/*
+	 * The batch size is a tradeoff: larger batches amortize the locking in
+	 * SIGetDataEntries over more messages, which matters when a DDL-heavy
+	 * workload queues messages faster than backends consume them, but the
+	 * (static) buffer exists for the life of the backend.
+	 */
+#define MAXINVALMSGS 256
 	static SharedInvalidationMessage messages[MAXINVALMSGS];
 
 	/*
@@ -79,12 +85,22 @@ ReceiveSharedInvalidMessages(void (*invalFunction) (SharedInvalidationMessage *m
 	static volatile int nextmsg = 0;
 	static volatile int nummsgs = 0;
 
+	SharedInvalidationMessage lastmsg;
+	bool		havelast = false;
+
 	/* Deal with any messages still pending from an outer recursion */
 	while (nextmsg < nummsgs)
 	{
 		SharedInvalidationMessage msg = messages[nextmsg++];
 
 		SharedInvalidMessageCounter++;
+
+		/* Skip duplicates; see below */
+		if (havelast && memcmp(&msg, &lastmsg, sizeof(msg)) == 0)
+			continue;
+		lastmsg = msg;
+		havelast = true;
+
 		invalFunction(&msg);
 	}
 
@@ -115,6 +131,21 @@ ReceiveSharedInvalidMessages(void (*invalFunction) (SharedInvalidationMessage *m
 			SharedInvalidationMessage msg = messages[nextmsg++];
 
 			SharedInvalidMessageCounter++;
+
+			/*
+			 * Consecutive duplicate messages are common when many backends
+			 * invalidate the same object, or when a command queues the same
+			 * message in several subcommands.  Applying an invalidation
+			 * message is idempotent, so it's always safe to skip an exact
+			 * repeat of the message we just applied.  (Uninitialized padding
+			 * in the message can defeat the comparison, but only in the
+			 * direction of processing the message redundantly.)
+			 */
+			if (havelast && memcmp(&msg, &lastmsg, sizeof(msg)) == 0)
+				continue;
+			lastmsg = msg;
+			havelast = true;
+
 			invalFunction(&msg);
 		}
 
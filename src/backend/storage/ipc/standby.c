@@ -455,6 +455,16 @@ ResolveRecoveryConflictWithVirtualXIDs(VirtualTransactionId *waitlist,
 
 }
 
+/*
+ * Newest snapshot conflict horizon we have fully resolved conflicts for,
+ * and the database it was for.  A vacuum or prune pass over a table emits a
+ * long run of records whose horizons are equal or advance only slowly, so
+ * remembering this lets us skip a ProcArrayLock scan for most of them; see
+ * ResolveRecoveryConflictWithSnapshot.
+ */
+static TransactionId lastResolvedConflictXid = InvalidTransactionId;
+static Oid	lastResolvedConflictDb = InvalidOid;
+
 /*
  * Generate whatever recovery conflicts are needed to eliminate snapshots that
  * might see XIDs <= snapshotConflictHorizon as still running.
@@ -486,12 +496,31 @@ ResolveRecoveryConflictWithSnapshot(TransactionId snapshotConflictHorizon,
 		return;
 
 	Assert(TransactionIdIsNormal(snapshotConflictHorizon));
-	backends = GetConflictingVirtualXIDs(snapshotConflictHorizon,
-										 locator.dbOid);
-	ResolveRecoveryConflictWithVirtualXIDs(backends,
-										   PROCSIG_RECOVERY_CONFLICT_SNAPSHOT,
-										   WAIT_EVENT_RECOVERY_CONFLICT_SNAPSHOT,
-										   true);
+
+	/*
+	 * If we have already resolved conflicts up to this horizon for this
+	 * database, there is nothing left to cancel.  Resolution returns only
+	 * once the conflicting backends are gone, and a snapshot taken after
+	 * that computes its xmin from the transactions still running at this
+	 * point in the WAL, which all follow the horizon; such a backend may
+	 * still satisfy the conservative xmin test below, but it cannot actually
+	 * see any of the removed tuples, so re-checking would only issue
+	 * needless cancellations.
+	 */
+	if (locator.dbOid != lastResolvedConflictDb ||
+		!TransactionIdIsValid(lastResolvedConflictXid) ||
+		TransactionIdFollows(snapshotConflictHorizon,
+							 lastResolvedConflictXid))
+	{
+		backends = GetConflictingVirtualXIDs(snapshotConflictHorizon,
+											 locator.dbOid);
+		ResolveRecoveryConflictWithVirtualXIDs(backends,
+											   PROCSIG_RECOVERY_CONFLICT_SNAPSHOT,
+											   WAIT_EVENT_RECOVERY_CONFLICT_SNAPSHOT,
+											   true);
+		lastResolvedConflictDb = locator.dbOid;
+		lastResolvedConflictXid = snapshotConflictHorizon;
+	}
 
 	/*
 	 * Note that WaitExceedsMaxStandbyDelay() is not taken into account here
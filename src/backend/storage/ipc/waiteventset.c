@@ -37,6 +37,18 @@
  * The Windows implementation uses Windows events that are inherited by all
  * postmaster child processes. There's no need for the self-pipe trick there.
  *
+ * An io_uring-backed implementation that shares the ring created by
+ * method_io_uring.c has been considered, so that AIO completions, socket
+ * readiness and latch wakeups would all arrive through one ring.  It is not
+ * attempted for now: that ring is owned by the AIO subsystem, whose
+ * completion draining assumes every CQE corresponds to a PgAioHandle, so
+ * socket/latch poll CQEs would need a demultiplexing layer between here and
+ * aio; and the steady-state win is small, since with epoll a wakeup already
+ * costs just epoll_wait() plus, for latch wakeups only, a single signalfd
+ * read (SIGURG coalesces, so drain() never needs a second read).  Anyone
+ * revisiting this should also keep a fallback, as io_uring can be disabled
+ * by seccomp policies even where liburing is present.
+ *
  * Portions Copyright (c) 1996-2025, PostgreSQL Global Development Group
  * Portions Copyright (c) 1994, Regents of the University of California
  *
@@ -2755,6 +2755,21 @@ FastPathGrantRelationLock(Oid relid, LOCKMODE lockmode)
 	/* fast-path group the lock belongs to */
 	uint32		group = FAST_PATH_REL_GROUP(relid);
 
+	/*
+	 * Common case in partition-heavy workloads: the group is entirely empty,
+	 * so there's no existing entry to find and the first slot is free.  This
+	 * skips the per-slot scan below.
+	 */
+	if (MyProc->fpLockBits[group] == 0)
+	{
+		uint32		f = FAST_PATH_SLOT(group, 0);
+
+		MyProc->fpRelId[f] = relid;
+		FAST_PATH_SET_LOCKMODE(MyProc, f, lockmode);
+		++FastPathLocalUseCounts[group];
+		return true;
+	}
+
 	/* Scan for existing entry for this relid, remembering empty slot. */
 	for (i = 0; i < FP_LOCK_SLOTS_PER_GROUP; i++)
 	{
@@ -413,6 +413,19 @@ static LWLock *ScratchPartitionLock;
  */
 static HTAB *LocalPredicateLockHash = NULL;
 
+/*
+ * Single-entry cache remembering the page or relation lock target most
+ * recently found to cover a requested predicate lock.  A scan streaming many
+ * tuples from one heap or index page requests a long run of locks all covered
+ * by the same coarser lock; the cache lets those requests skip the local hash
+ * table probes entirely.  Since predicate locks are only ever promoted to
+ * coarser granularity, never released before end of transaction, a positive
+ * coverage verdict stays valid until the local lock table is destroyed, at
+ * which point the cache must be invalidated too.
+ */
+static PREDICATELOCKTARGETTAG CoveringLockCacheTag;
+static bool CoveringLockCacheValid = false;
+
 /*
  * Keep a pointer to the currently-running serializable transaction (if any)
  * for quick reference. Also, remember if we have written anything that could
@@ -457,6 +470,7 @@ static bool PredicateLockExists(const PREDICATELOCKTARGETTAG *targettag);
 static bool GetParentPredicateLockTag(const PREDICATELOCKTARGETTAG *tag,
 									  PREDICATELOCKTARGETTAG *parent);
 static bool CoarserLockCovers(const PREDICATELOCKTARGETTAG *newtargettag);
+static bool CoveringLockCacheCovers(const PREDICATELOCKTARGETTAG *newtargettag);
 static void RemoveScratchTarget(bool lockheld);
 static void RestoreScratchTarget(bool lockheld);
 static void RemoveTargetIfNoLongerUsed(PREDICATELOCKTARGET *target,
@@ -2120,13 +2134,50 @@ CoarserLockCovers(const PREDICATELOCKTARGETTAG *newtargettag)
 	{
 		targettag = parenttag;
 		if (PredicateLockExists(&targettag))
+		{
+			/* remember the covering lock for later requests */
+			CoveringLockCacheTag = targettag;
+			CoveringLockCacheValid = true;
 			return true;
+		}
 	}
 
 	/* no more parents to check; lock is not covered */
 	return false;
 }
 
+/*
+ * Check whether the lock we are considering is covered by the cached
+ * covering lock: the cached tag must equal the new tag or one of its
+ * ancestors in the lock hierarchy.
+ *
+ * The cache is conservative in the same way as the local lock table it
+ * shadows: it might miss a lock that is actually covered, but it never
+ * claims coverage that we don't have.  (A cached lock may since have been
+ * promoted away, but the coarser lock that replaced it necessarily covers
+ * everything it covered.)
+ */
+static bool
+CoveringLockCacheCovers(const PREDICATELOCKTARGETTAG *newtargettag)
+{
+	PREDICATELOCKTARGETTAG targettag,
+				parenttag;
+
+	if (!CoveringLockCacheValid)
+		return false;
+
+	targettag = *newtargettag;
+	for (;;)
+	{
+		if (memcmp(&targettag, &CoveringLockCacheTag,
+				   sizeof(PREDICATELOCKTARGETTAG)) == 0)
+			return true;
+		if (!GetParentPredicateLockTag(&targettag, &parenttag))
+			return false;
+		targettag = parenttag;
+	}
+}
+
 /*
  * Remove the dummy entry from the predicate lock target hash, to free up some
  * scratch space. The caller must be holding SerializablePredicateListLock,
@@ -2521,8 +2572,19 @@ PredicateLockAcquire(const PREDICATELOCKTARGETTAG *targettag)
 	LOCALPREDICATELOCK *locallock;
 
 	/* Do we have the lock already, or a covering lock? */
+	if (CoveringLockCacheCovers(targettag))
+		return;
+
 	if (PredicateLockExists(targettag))
+	{
+		/* a page or relation lock also covers later finer requests */
+		if (GET_PREDICATELOCKTARGETTAG_TYPE(*targettag) != PREDLOCKTAG_TUPLE)
+		{
+			CoveringLockCacheTag = *targettag;
+			CoveringLockCacheValid = true;
+		}
 		return;
+	}
 
 	if (CoarserLockCovers(targettag))
 		return;
@@ -2559,7 +2621,13 @@ PredicateLockAcquire(const PREDICATELOCKTARGETTAG *targettag)
 	{
 		/* Clean up any finer-granularity locks */
 		if (GET_PREDICATELOCKTARGETTAG_TYPE(*targettag) != PREDLOCKTAG_TUPLE)
+		{
 			DeleteChildTargetLocks(targettag);
+
+			/* the lock we just took covers later finer-grained requests */
+			CoveringLockCacheTag = *targettag;
+			CoveringLockCacheValid = true;
+		}
 	}
 }
 
@@ -3681,12 +3749,13 @@ ReleasePredicateLocksLocal(void)
 	MySerializableXact = InvalidSerializableXact;
 	MyXactDidWrite = false;
 
-	/* Delete per-transaction lock table */
+	/* Delete per-transaction lock table, and the cache shadowing it */
 	if (LocalPredicateLockHash != NULL)
 	{
 		hash_destroy(LocalPredicateLockHash);
 		LocalPredicateLockHash = NULL;
 	}
+	CoveringLockCacheValid = false;
 }
 
 /*
@@ -4868,6 +4937,7 @@ PostPrepare_PredicateLocks(FullTransactionId fxid)
 
 	hash_destroy(LocalPredicateLockHash);
 	LocalPredicateLockHash = NULL;
+	CoveringLockCacheValid = false;
 
 	MySerializableXact = InvalidSerializableXact;
 	MyXactDidWrite = false;
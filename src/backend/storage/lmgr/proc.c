@@ -121,13 +121,18 @@ FastPathLockShmemSize(void)
 				fpRelIdSize;
 
 	/*
-	 * Memory needed for PGPROC fast-path lock arrays. Make sure the sizes are
-	 * nicely aligned in each backend.
+	 * Memory needed for PGPROC fast-path lock arrays.  Each backend's arrays
+	 * are padded out to full cache lines: the owning backend writes them on
+	 * every fast-path lock acquisition while other backends read them when
+	 * checking for conflicts, so letting two backends' arrays share a cache
+	 * line would cause needless coherence traffic between their (possibly
+	 * remote) sockets.
 	 */
 	fpLockBitsSize = MAXALIGN(FastPathLockGroupsPerBackend * sizeof(uint64));
 	fpRelIdSize = MAXALIGN(FastPathLockSlotsPerBackend() * sizeof(Oid));
 
-	size = add_size(size, mul_size(TotalProcs, (fpLockBitsSize + fpRelIdSize)));
+	size = add_size(size, mul_size(TotalProcs,
+								   CACHELINEALIGN(fpLockBitsSize + fpRelIdSize)));
 
 	return size;
 }
@@ -222,7 +227,6 @@ InitProcGlobal(void)
 	ProcGlobal->walwriterProc = INVALID_PROC_NUMBER;
 	ProcGlobal->checkpointerProc = INVALID_PROC_NUMBER;
 	pg_atomic_init_u32(&ProcGlobal->procArrayGroupFirst, INVALID_PROC_NUMBER);
-	pg_atomic_init_u32(&ProcGlobal->clogGroupFirst, INVALID_PROC_NUMBER);
 
 	/*
 	 * Create and initialize all the PGPROC structures we'll need.  There are
@@ -295,12 +299,13 @@ InitProcGlobal(void)
 		/*
 		 * Set the fast-path lock arrays, and move the pointer. We interleave
 		 * the two arrays, to (hopefully) get some locality for each backend.
+		 * Each backend's chunk is padded to a cache line boundary so that
+		 * backends running on different sockets don't false-share lines at
+		 * the chunk boundaries (see FastPathLockShmemSize).
 		 */
 		proc->fpLockBits = (uint64 *) fpPtr;
-		fpPtr += fpLockBitsSize;
-
-		proc->fpRelId = (Oid *) fpPtr;
-		fpPtr += fpRelIdSize;
+		proc->fpRelId = (Oid *) (fpPtr + fpLockBitsSize);
+		fpPtr += CACHELINEALIGN(fpLockBitsSize + fpRelIdSize);
 
 		Assert(fpPtr <= fpEndPtr);
 
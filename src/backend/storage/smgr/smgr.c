@@ -64,6 +64,7 @@
 #include "postgres.h"
 
 #include "access/xlogutils.h"
+#include "common/hashfn.h"
 #include "lib/ilist.h"
 #include "miscadmin.h"
 #include "storage/aio.h"
@@ -71,63 +72,23 @@
 #include "storage/ipc.h"
 #include "storage/md.h"
 #include "storage/smgr.h"
-#include "utils/hsearch.h"
 #include "utils/inval.h"
+#include "utils/memutils.h"
 
 
 /*
- * This struct of function pointers defines the API between smgr.c and
- * any individual storage manager module.  Note that smgr subfunctions are
- * generally expected to report problems via elog(ERROR).  An exception is
- * that smgr_unlink should use elog(WARNING), rather than erroring out,
- * because we normally unlink relations during post-commit/abort cleanup,
- * and so it's too late to raise an error.  Also, various conditions that
- * would normally be errors should be allowed during bootstrap and/or WAL
- * recovery --- see comments in md.c for details.
+ * Table of the available storage managers (see the f_smgr comments in
+ * smgr.h).  Slot 0 is always md.c; further slots can be claimed by
+ * extensions via smgr_register() while shared_preload_libraries are being
+ * processed.  Since every process loads those libraries in the same order,
+ * the assigned smgr ids are the same in every process.
  */
-typedef struct f_smgr
-{
-	void		(*smgr_init) (void);	/* may be NULL */
-	void		(*smgr_shutdown) (void);	/* may be NULL */
-	void		(*smgr_open) (SMgrRelation reln);
-	void		(*smgr_close) (SMgrRelation reln, ForkNumber forknum);
-	void		(*smgr_create) (SMgrRelation reln, ForkNumber forknum,
-								bool isRedo);
-	bool		(*smgr_exists) (SMgrRelation reln, ForkNumber forknum);
-	void		(*smgr_unlink) (RelFileLocatorBackend rlocator, ForkNumber forknum,
-								bool isRedo);
-	void		(*smgr_extend) (SMgrRelation reln, ForkNumber forknum,
-								BlockNumber blocknum, const void *buffer, bool skipFsync);
-	void		(*smgr_zeroextend) (SMgrRelation reln, ForkNumber forknum,
-									BlockNumber blocknum, int nblocks, bool skipFsync);
-	bool		(*smgr_prefetch) (SMgrRelation reln, ForkNumber forknum,
-								  BlockNumber blocknum, int nblocks);
-	uint32		(*smgr_maxcombine) (SMgrRelation reln, ForkNumber forknum,
-									BlockNumber blocknum);
-	void		(*smgr_readv) (SMgrRelation reln, ForkNumber forknum,
-							   BlockNumber blocknum,
-							   void **buffers, BlockNumber nblocks);
-	void		(*smgr_startreadv) (PgAioHandle *ioh,
-									SMgrRelation reln, ForkNumber forknum,
-									BlockNumber blocknum,
-									void **buffers, BlockNumber nblocks);
-	void		(*smgr_writev) (SMgrRelation reln, ForkNumber forknum,
-								BlockNumber blocknum,
-								const void **buffers, BlockNumber nblocks,
-								bool skipFsync);
-	void		(*smgr_writeback) (SMgrRelation reln, ForkNumber forknum,
-								   BlockNumber blocknum, BlockNumber nblocks);
-	BlockNumber (*smgr_nblocks) (SMgrRelation reln, ForkNumber forknum);
-	void		(*smgr_truncate) (SMgrRelation reln, ForkNumber forknum,
-								  BlockNumber old_blocks, BlockNumber nblocks);
-	void		(*smgr_immedsync) (SMgrRelation reln, ForkNumber forknum);
-	void		(*smgr_registersync) (SMgrRelation reln, ForkNumber forknum);
-	int			(*smgr_fd) (SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, uint32 *off);
-} f_smgr;
-
-static const f_smgr smgrsw[] = {
+#define MAX_SMGRS	8
+
+static f_smgr smgrsw[MAX_SMGRS] = {
 	/* magnetic disk */
-	{
+	[MdSMgrId] = {
+		.smgr_name = "md",
 		.smgr_init = mdinit,
 		.smgr_shutdown = NULL,
 		.smgr_open = mdopen,
@@ -151,13 +112,61 @@ static const f_smgr smgrsw[] = {
 	}
 };
 
-static const int NSmgr = lengthof(smgrsw);
+static int	NSmgr = 1;
+
+/* Hook for extensions to choose the storage manager for a relation */
+smgr_select_hook_type smgr_select_hook = NULL;
 
 /*
  * Each backend has a hashtable that stores all extant SMgrRelation objects.
  * In addition, "unpinned" SMgrRelation objects are chained together in a list.
+ *
+ * The table is a specialized simplehash rather than a dynahash, avoiding the
+ * indirect hash-function call and chain walk on every smgropen().  Because
+ * callers hold SMgrRelation pointers across transaction lifetime, the
+ * SMgrRelationData objects themselves cannot live inside the table (entries
+ * move when a simplehash grows); instead each element stores a pointer to a
+ * separately allocated object, which also serves as the key via its embedded
+ * smgr_rlocator.  Lookups use a stack dummy whose rlocator is filled in.
  */
-static HTAB *SMgrRelationHash = NULL;
+typedef struct SMgrEntry
+{
+	int			status;			/* simplehash status */
+	uint32		hash;			/* hash of the rlocator, cached */
+	SMgrRelation data;			/* the SMgrRelation object */
+} SMgrEntry;
+
+static inline uint32 smgrtable_hash_key(SMgrRelation key);
+static inline bool smgrtable_equal_keys(SMgrRelation a, SMgrRelation b);
+
+#define SH_PREFIX		smgrtable
+#define SH_ELEMENT_TYPE	SMgrEntry
+#define SH_KEY_TYPE		SMgrRelation
+#define SH_KEY			data
+#define SH_HASH_KEY(tb, key)	smgrtable_hash_key(key)
+#define SH_EQUAL(tb, a, b)		smgrtable_equal_keys(a, b)
+#define SH_SCOPE		static inline
+#define SH_STORE_HASH
+#define SH_GET_HASH(tb, a)		a->hash
+#define SH_DEFINE
+#define SH_DECLARE
+#include "lib/simplehash.h"
+
+static inline uint32
+smgrtable_hash_key(SMgrRelation key)
+{
+	return hash_bytes((const unsigned char *) &key->smgr_rlocator,
+					  sizeof(RelFileLocatorBackend));
+}
+
+static inline bool
+smgrtable_equal_keys(SMgrRelation a, SMgrRelation b)
+{
+	return memcmp(&a->smgr_rlocator, &b->smgr_rlocator,
+				  sizeof(RelFileLocatorBackend)) == 0;
+}
+
+static smgrtable_hash *SMgrRelationHash = NULL;
 
 static dlist_head unpinned_relns;
 
@@ -176,6 +185,60 @@ const PgAioTargetInfo aio_smgr_target_info = {
 };
 
 
+/*
+ * smgr_register() -- Register an extension-provided storage manager.
+ *
+ * This must be called from the extension's _PG_init() function while
+ * shared_preload_libraries are being processed, so that the smgr table is
+ * identical in every process and complete before smgrinit() runs.  The
+ * returned smgr id can subsequently be handed out by smgr_select_hook to
+ * direct relations to the new storage manager.
+ */
+int
+smgr_register(const f_smgr *smgr)
+{
+	if (!process_shared_preload_libraries_in_progress)
+		ereport(ERROR,
+				(errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+				 errmsg("storage managers can only be registered while shared_preload_libraries are being loaded")));
+
+	/* All callbacks except smgr_init and smgr_shutdown are required */
+	if (smgr->smgr_name == NULL ||
+		smgr->smgr_open == NULL ||
+		smgr->smgr_close == NULL ||
+		smgr->smgr_create == NULL ||
+		smgr->smgr_exists == NULL ||
+		smgr->smgr_unlink == NULL ||
+		smgr->smgr_extend == NULL ||
+		smgr->smgr_zeroextend == NULL ||
+		smgr->smgr_prefetch == NULL ||
+		smgr->smgr_maxcombine == NULL ||
+		smgr->smgr_readv == NULL ||
+		smgr->smgr_startreadv == NULL ||
+		smgr->smgr_writev == NULL ||
+		smgr->smgr_writeback == NULL ||
+		smgr->smgr_nblocks == NULL ||
+		smgr->smgr_truncate == NULL ||
+		smgr->smgr_immedsync == NULL ||
+		smgr->smgr_registersync == NULL ||
+		smgr->smgr_fd == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("storage manager is missing a required callback")));
+
+	if (NSmgr >= MAX_SMGRS)
+		ereport(ERROR,
+				(errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+				 errmsg("cannot register storage manager \"%s\"",
+						smgr->smgr_name),
+				 errdetail("Maximum of %d storage managers are supported.",
+						   MAX_SMGRS)));
+
+	smgrsw[NSmgr] = *smgr;
+
+	return NSmgr++;
+}
+
 /*
  * smgrinit(), smgrshutdown() -- Initialize or shut down storage
  *								 managers.
@@ -240,8 +303,9 @@ SMgrRelation
 smgropen(RelFileLocator rlocator, ProcNumber backend)
 {
 	RelFileLocatorBackend brlocator;
+	SMgrRelationData dummy;
+	SMgrEntry  *entry;
 	SMgrRelation reln;
-	bool		found;
 
 	Assert(RelFileNumberIsValid(rlocator.relNumber));
 
@@ -250,30 +314,39 @@ smgropen(RelFileLocator rlocator, ProcNumber backend)
 	if (SMgrRelationHash == NULL)
 	{
 		/* First time through: initialize the hash table */
-		HASHCTL		ctl;
-
-		ctl.keysize = sizeof(RelFileLocatorBackend);
-		ctl.entrysize = sizeof(SMgrRelationData);
-		SMgrRelationHash = hash_create("smgr relation table", 400,
-									   &ctl, HASH_ELEM | HASH_BLOBS);
+		SMgrRelationHash = smgrtable_create(TopMemoryContext, 400, NULL);
 		dlist_init(&unpinned_relns);
 	}
 
 	/* Look up or create an entry */
 	brlocator.locator = rlocator;
 	brlocator.backend = backend;
-	reln = (SMgrRelation) hash_search(SMgrRelationHash,
-									  &brlocator,
-									  HASH_ENTER, &found);
+	dummy.smgr_rlocator = brlocator;
+	entry = smgrtable_lookup(SMgrRelationHash, &dummy);
 
 	/* Initialize it if not present before */
-	if (!found)
+	if (entry == NULL)
 	{
-		/* hash_search already filled in the lookup key */
+		bool		found;
+
+		reln = MemoryContextAlloc(TopMemoryContext,
+								  sizeof(SMgrRelationData));
+		reln->smgr_rlocator = brlocator;
+		entry = smgrtable_insert(SMgrRelationHash, reln, &found);
+		Assert(!found);
+
 		reln->smgr_targblock = InvalidBlockNumber;
 		for (int i = 0; i <= MAX_FORKNUM; ++i)
 			reln->smgr_cached_nblocks[i] = InvalidBlockNumber;
-		reln->smgr_which = 0;	/* we only have md.c at present */
+		if (smgr_select_hook)
+		{
+			reln->smgr_which = (*smgr_select_hook) (brlocator);
+			if (reln->smgr_which < 0 || reln->smgr_which >= NSmgr)
+				elog(ERROR, "invalid storage manager id %d",
+					 reln->smgr_which);
+		}
+		else
+			reln->smgr_which = MdSMgrId;
 
 		/* it is not pinned yet */
 		reln->pincount = 0;
@@ -282,6 +355,8 @@ smgropen(RelFileLocator rlocator, ProcNumber backend)
 		/* implementation-specific initialization */
 		smgrsw[reln->smgr_which].smgr_open(reln);
 	}
+	else
+		reln = entry->data;
 
 	RESUME_INTERRUPTS();
 
@@ -333,11 +408,11 @@ smgrdestroy(SMgrRelation reln)
 
 	dlist_delete(&reln->node);
 
-	if (hash_search(SMgrRelationHash,
-					&(reln->smgr_rlocator),
-					HASH_REMOVE, NULL) == NULL)
+	if (!smgrtable_delete(SMgrRelationHash, reln))
 		elog(ERROR, "SMgrRelation hashtable corrupted");
 
+	pfree(reln);
+
 	RESUME_INTERRUPTS();
 }
 
@@ -411,8 +486,8 @@ smgrdestroyall(void)
 void
 smgrreleaseall(void)
 {
-	HASH_SEQ_STATUS status;
-	SMgrRelation reln;
+	smgrtable_iterator iterator;
+	SMgrEntry  *entry;
 
 	/* Nothing to do if hashtable not set up */
 	if (SMgrRelationHash == NULL)
@@ -421,11 +496,11 @@ smgrreleaseall(void)
 	/* seems unsafe to accept interrupts while iterating */
 	HOLD_INTERRUPTS();
 
-	hash_seq_init(&status, SMgrRelationHash);
+	smgrtable_start_iterate(SMgrRelationHash, &iterator);
 
-	while ((reln = (SMgrRelation) hash_seq_search(&status)) != NULL)
+	while ((entry = smgrtable_iterate(SMgrRelationHash, &iterator)) != NULL)
 	{
-		smgrrelease(reln);
+		smgrrelease(entry->data);
 	}
 
 	RESUME_INTERRUPTS();
@@ -442,17 +517,17 @@ smgrreleaseall(void)
 void
 smgrreleaserellocator(RelFileLocatorBackend rlocator)
 {
-	SMgrRelation reln;
+	SMgrRelationData dummy;
+	SMgrEntry  *entry;
 
 	/* Nothing to do if hashtable not set up */
 	if (SMgrRelationHash == NULL)
 		return;
 
-	reln = (SMgrRelation) hash_search(SMgrRelationHash,
-									  &rlocator,
-									  HASH_FIND, NULL);
-	if (reln != NULL)
-		smgrrelease(reln);
+	dummy.smgr_rlocator = rlocator;
+	entry = smgrtable_lookup(SMgrRelationHash, &dummy);
+	if (entry != NULL)
+		smgrrelease(entry->data);
 }
 
 /*
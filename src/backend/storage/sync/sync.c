@@ -279,6 +279,35 @@ SyncPostCheckpoint(void)
 	}
 }
 
+/*
+ * Comparator used to sort pending fsync requests.
+ *
+ * Processing the requests in file order groups the segments of a relation
+ * together and keeps each tablespace's files adjacent, which gives the
+ * kernel a better shot at merging writeback than the hash order we'd
+ * otherwise visit them in.
+ */
+static int
+sync_request_comparator(const void *a, const void *b)
+{
+	const FileTag *taga = &(*(const PendingFsyncEntry *const *) a)->tag;
+	const FileTag *tagb = &(*(const PendingFsyncEntry *const *) b)->tag;
+
+	if (taga->handler != tagb->handler)
+		return taga->handler < tagb->handler ? -1 : 1;
+	if (taga->rlocator.spcOid != tagb->rlocator.spcOid)
+		return taga->rlocator.spcOid < tagb->rlocator.spcOid ? -1 : 1;
+	if (taga->rlocator.dbOid != tagb->rlocator.dbOid)
+		return taga->rlocator.dbOid < tagb->rlocator.dbOid ? -1 : 1;
+	if (taga->rlocator.relNumber != tagb->rlocator.relNumber)
+		return taga->rlocator.relNumber < tagb->rlocator.relNumber ? -1 : 1;
+	if (taga->forknum != tagb->forknum)
+		return taga->forknum < tagb->forknum ? -1 : 1;
+	if (taga->segno != tagb->segno)
+		return taga->segno < tagb->segno ? -1 : 1;
+	return 0;
+}
+
 /*
  *	ProcessSyncRequests() -- Process queued fsync requests.
  */
@@ -289,6 +318,8 @@ ProcessSyncRequests(void)
 
 	HASH_SEQ_STATUS hstat;
 	PendingFsyncEntry *entry;
+	PendingFsyncEntry **synclist;
+	int			nsyncs;
 	int			absorb_counter;
 
 	/* Statistics on sync times */
@@ -358,24 +389,42 @@ ProcessSyncRequests(void)
 	/* Set flag to detect failure if we don't reach the end of the loop */
 	sync_in_progress = true;
 
-	/* Now scan the hashtable for fsync requests to process */
-	absorb_counter = FSYNCS_PER_ABSORB;
+	/*
+	 * Collect the requests to process.  Entries that are new (i.e. were
+	 * added after the cycle counter was bumped) are left for next time.
+	 * Note that absorbing requests below never removes hashtable entries,
+	 * only adds or cancels them, so the collected pointers stay valid.
+	 */
+	synclist = (PendingFsyncEntry **)
+		palloc(hash_get_num_entries(pendingOps) * sizeof(PendingFsyncEntry *));
+	nsyncs = 0;
 	hash_seq_init(&hstat, pendingOps);
 	while ((entry = (PendingFsyncEntry *) hash_seq_search(&hstat)) != NULL)
 	{
-		int			failures;
-
-		/*
-		 * If the entry is new then don't process it this time; it is new.
-		 * Note "continue" bypasses the hash-remove call at the bottom of the
-		 * loop.
-		 */
 		if (entry->cycle_ctr == sync_cycle_ctr)
 			continue;
 
 		/* Else assert we haven't missed it */
 		Assert((CycleCtr) (entry->cycle_ctr + 1) == sync_cycle_ctr);
 
+		synclist[nsyncs++] = entry;
+	}
+
+	/*
+	 * Sort the requests into file order, so that segments of the same
+	 * relation are synced consecutively and tablespaces aren't interleaved.
+	 */
+	qsort(synclist, nsyncs, sizeof(PendingFsyncEntry *),
+		  sync_request_comparator);
+
+	/* Now process the collected fsync requests */
+	absorb_counter = FSYNCS_PER_ABSORB;
+	for (int i = 0; i < nsyncs; i++)
+	{
+		int			failures;
+
+		entry = synclist[i];
+
 		/*
 		 * If fsync is off then we don't have to bother opening the file at
 		 * all.  (We delay checking until this point so that changing fsync on
@@ -463,7 +512,9 @@ ProcessSyncRequests(void)
 		/* We are done with this entry, remove it */
 		if (hash_search(pendingOps, &entry->tag, HASH_REMOVE, NULL) == NULL)
 			elog(ERROR, "pendingOps corrupted");
-	}							/* end loop over hashtable entries */
+	}							/* end loop over collected requests */
+
+	pfree(synclist);
 
 	/* Return sync performance metrics for report at checkpoint end */
 	CheckpointStats.ckpt_sync_rels = processed;
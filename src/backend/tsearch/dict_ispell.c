@@ -17,55 +17,201 @@
 #include "commands/defrem.h"
 #include "tsearch/dicts/spell.h"
 #include "tsearch/ts_public.h"
+#include "utils/catcache.h"
 #include "utils/fmgrprotos.h"
 #include "utils/formatting.h"
+#include "utils/inval.h"
+#include "utils/memutils.h"
+#include "utils/syscache.h"
 
 
 typedef struct
 {
 	StopList	stoplist;
-	IspellDict	obj;
+	IspellDict *obj;			/* shared compiled dictionary */
 } DictISpell;
 
+/*
+ * Compiled ispell dictionaries are large and expensive to build: a sizable
+ * hunspell dictionary can cost hundreds of milliseconds and tens of
+ * megabytes.  Since several pg_ts_dict entries frequently point at the same
+ * DictFile/AffFile pair (for example, one dictionary per configuration over
+ * a common hunspell file set), we compile each file pair only once per
+ * backend and share the result among all dictionary cache entries that
+ * reference it.  The stop list is cheap and remains per-dictionary.
+ *
+ * lookup_ts_dictionary_cache() rebuilds dictionary entries only after a
+ * pg_ts_dict or pg_ts_template change, and a no-op ALTER TEXT SEARCH
+ * DICTIONARY is the documented way to force re-reading modified dictionary
+ * files.  To preserve that, the same syscache events mark all compiled
+ * entries stale, so the next rebuild compiles afresh; a stale entry is freed
+ * once the last dictionary referencing it goes away.
+ */
+typedef struct CompiledIspell
+{
+	struct CompiledIspell *next;
+	char	   *dictfile;		/* resolved DictFile path */
+	char	   *afffile;		/* resolved AffFile path */
+	MemoryContext cxt;			/* context holding this struct and obj */
+	IspellDict *obj;
+	int			refcount;		/* number of dictionaries using this */
+	bool		stale;			/* catalog change; do not reuse */
+} CompiledIspell;
+
+static CompiledIspell *compiledIspellList = NULL;
+static bool compiledIspellCallbackRegistered = false;
+
+/*
+ * Memory context reset callback: a dictionary referencing a compiled entry
+ * is being rebuilt or thrown away.
+ */
+static void
+release_compiled_ispell(void *arg)
+{
+	CompiledIspell *entry = (CompiledIspell *) arg;
+
+	Assert(entry->refcount > 0);
+	if (--entry->refcount == 0 && entry->stale)
+	{
+		CompiledIspell **prev;
+
+		for (prev = &compiledIspellList; *prev; prev = &(*prev)->next)
+		{
+			if (*prev == entry)
+			{
+				*prev = entry->next;
+				break;
+			}
+		}
+		MemoryContextDelete(entry->cxt);
+	}
+}
+
+/*
+ * Syscache callback on pg_ts_dict/pg_ts_template changes: stop reusing all
+ * compiled entries, freeing those that are no longer referenced.  This fires
+ * whenever the dictionary cache entries themselves are invalidated, so the
+ * next dispell_init() re-reads the files just as it always has.
+ */
+static void
+InvalidateCompiledIspell(Datum arg, int cacheid, uint32 hashvalue)
+{
+	CompiledIspell **prev = &compiledIspellList;
+	CompiledIspell *cur;
+
+	while ((cur = *prev) != NULL)
+	{
+		cur->stale = true;
+		if (cur->refcount == 0)
+		{
+			*prev = cur->next;
+			MemoryContextDelete(cur->cxt);
+		}
+		else
+			prev = &cur->next;
+	}
+}
+
+/*
+ * Find or build the compiled form of the given dictionary file pair.
+ */
+static CompiledIspell *
+compile_ispell_files(const char *dictfile, const char *afffile)
+{
+	CompiledIspell *entry;
+	MemoryContext cxt;
+
+	if (!compiledIspellCallbackRegistered)
+	{
+		if (!CacheMemoryContext)
+			CreateCacheMemoryContext();
+		CacheRegisterSyscacheCallback(TSDICTOID, InvalidateCompiledIspell,
+									  (Datum) 0);
+		CacheRegisterSyscacheCallback(TSTEMPLATEOID, InvalidateCompiledIspell,
+									  (Datum) 0);
+		compiledIspellCallbackRegistered = true;
+	}
+
+	for (entry = compiledIspellList; entry; entry = entry->next)
+	{
+		if (!entry->stale &&
+			strcmp(entry->dictfile, dictfile) == 0 &&
+			strcmp(entry->afffile, afffile) == 0)
+			return entry;
+	}
+
+	/*
+	 * Compile into a dedicated context under CacheMemoryContext, so the data
+	 * outlives any one dictionary cache entry and can be dropped as a unit.
+	 */
+	cxt = AllocSetContextCreate(CacheMemoryContext,
+								"ispell dictionary",
+								ALLOCSET_DEFAULT_SIZES);
+	PG_TRY();
+	{
+		MemoryContext oldcxt = MemoryContextSwitchTo(cxt);
+
+		entry = (CompiledIspell *) palloc0(sizeof(CompiledIspell));
+		entry->cxt = cxt;
+		entry->dictfile = pstrdup(dictfile);
+		entry->afffile = pstrdup(afffile);
+		entry->obj = (IspellDict *) palloc0(sizeof(IspellDict));
+
+		NIStartBuild(entry->obj);
+		NIImportDictionary(entry->obj, dictfile);
+		NIImportAffixes(entry->obj, afffile);
+		NISortDictionary(entry->obj);
+		NISortAffixes(entry->obj);
+		NIFinishBuild(entry->obj);
+
+		MemoryContextSwitchTo(oldcxt);
+	}
+	PG_CATCH();
+	{
+		MemoryContextDelete(cxt);
+		PG_RE_THROW();
+	}
+	PG_END_TRY();
+
+	entry->next = compiledIspellList;
+	compiledIspellList = entry;
+
+	return entry;
+}
+
 Datum
 dispell_init(PG_FUNCTION_ARGS)
 {
 	List	   *dictoptions = (List *) PG_GETARG_POINTER(0);
 	DictISpell *d;
-	bool		affloaded = false,
-				dictloaded = false,
-				stoploaded = false;
+	char	   *dictfile = NULL,
+			   *afffile = NULL;
+	bool		stoploaded = false;
 	ListCell   *l;
 
 	d = (DictISpell *) palloc0(sizeof(DictISpell));
 
-	NIStartBuild(&(d->obj));
-
 	foreach(l, dictoptions)
 	{
 		DefElem    *defel = (DefElem *) lfirst(l);
 
 		if (strcmp(defel->defname, "dictfile") == 0)
 		{
-			if (dictloaded)
+			if (dictfile)
 				ereport(ERROR,
 						(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
 						 errmsg("multiple DictFile parameters")));
-			NIImportDictionary(&(d->obj),
-							   get_tsearch_config_filename(defGetString(defel),
-														   "dict"));
-			dictloaded = true;
+			dictfile = get_tsearch_config_filename(defGetString(defel),
+												   "dict");
 		}
 		else if (strcmp(defel->defname, "afffile") == 0)
 		{
-			if (affloaded)
+			if (afffile)
 				ereport(ERROR,
 						(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
 						 errmsg("multiple AffFile parameters")));
-			NIImportAffixes(&(d->obj),
-							get_tsearch_config_filename(defGetString(defel),
-														"affix"));
-			affloaded = true;
+			afffile = get_tsearch_config_filename(defGetString(defel),
+												  "affix");
 		}
 		else if (strcmp(defel->defname, "stopwords") == 0)
 		{
@@ -85,12 +231,24 @@ dispell_init(PG_FUNCTION_ARGS)
 		}
 	}
 
-	if (affloaded && dictloaded)
+	if (afffile && dictfile)
 	{
-		NISortDictionary(&(d->obj));
-		NISortAffixes(&(d->obj));
+		CompiledIspell *compiled = compile_ispell_files(dictfile, afffile);
+		MemoryContextCallback *cb;
+
+		d->obj = compiled->obj;
+		compiled->refcount++;
+
+		/*
+		 * Release our reference when this dictionary's private context (the
+		 * current context, per the dictionary API) is reset or deleted.
+		 */
+		cb = (MemoryContextCallback *) palloc0(sizeof(MemoryContextCallback));
+		cb->func = release_compiled_ispell;
+		cb->arg = compiled;
+		MemoryContextRegisterResetCallback(CurrentMemoryContext, cb);
 	}
-	else if (!affloaded)
+	else if (!afffile)
 	{
 		ereport(ERROR,
 				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
@@ -103,8 +261,6 @@ dispell_init(PG_FUNCTION_ARGS)
 				 errmsg("missing DictFile parameter")));
 	}
 
-	NIFinishBuild(&(d->obj));
-
 	PG_RETURN_POINTER(d);
 }
 
@@ -123,7 +279,7 @@ dispell_lexize(PG_FUNCTION_ARGS)
 		PG_RETURN_POINTER(NULL);
 
 	txt = str_tolower(in, len, DEFAULT_COLLATION_OID);
-	res = NINormalizeWord(&(d->obj), txt);
+	res = NINormalizeWord(d->obj, txt);
 
 	if (res == NULL)
 		PG_RETURN_POINTER(NULL);
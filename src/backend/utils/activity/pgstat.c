@@ -292,6 +292,7 @@ static const PgStat_KindInfo pgstat_kind_builtin_infos[PGSTAT_KIND_BUILTIN_SIZE]
 		.pending_size = sizeof(PgStat_StatDBEntry),
 
 		.flush_pending_cb = pgstat_database_flush_cb,
+		.delete_pending_cb = pgstat_database_delete_pending_cb,
 		.reset_timestamp_cb = pgstat_database_reset_timestamp_cb,
 	},
 
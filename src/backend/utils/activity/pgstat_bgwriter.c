@@ -46,6 +46,7 @@ pgstat_report_bgwriter(void)
 	pgstat_begin_changecount_write(&stats_shmem->changecount);
 
 #define BGWRITER_ACC(fld) stats_shmem->stats.fld += PendingBgWriterStats.fld
+	BGWRITER_ACC(buf_scanned_clean);
 	BGWRITER_ACC(buf_written_clean);
 	BGWRITER_ACC(maxwritten_clean);
 	BGWRITER_ACC(buf_alloc);
@@ -117,6 +118,7 @@ pgstat_bgwriter_snapshot_cb(void)
 
 	/* compensate by reset offsets */
 #define BGWRITER_COMP(fld) pgStatLocal.snapshot.bgwriter.fld -= reset.fld;
+	BGWRITER_COMP(buf_scanned_clean);
 	BGWRITER_COMP(buf_written_clean);
 	BGWRITER_COMP(maxwritten_clean);
 	BGWRITER_COMP(buf_alloc);
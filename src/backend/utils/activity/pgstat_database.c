@@ -36,6 +36,15 @@ static int	pgStatXactCommit = 0;
 static int	pgStatXactRollback = 0;
 static PgStat_Counter pgLastSessionReportTime = 0;
 
+/*
+ * The pending entry returned by the last pgstat_prep_database_pending call,
+ * so repeated updates for the same database skip the hash lookup.  Note that
+ * InvalidOid is a valid database oid (shared relations), so pending_dbentry
+ * being NULL is what marks the cache invalid.
+ */
+static Oid	pending_dbentry_dboid = InvalidOid;
+static PgStat_StatDBEntry *pending_dbentry = NULL;
+
 
 /*
  * Remove entry for the database being dropped.
@@ -393,10 +402,33 @@ pgstat_prep_database_pending(Oid dboid)
 	 */
 	Assert(!OidIsValid(dboid) || OidIsValid(MyDatabaseId));
 
+	/*
+	 * This is called for every database-level counter update and for every
+	 * relation or function entry flushed, so it is worth remembering the
+	 * entry prepared last.  The cache is reset by
+	 * pgstat_database_delete_pending_cb when the pending entry is removed.
+	 */
+	if (pending_dbentry != NULL && pending_dbentry_dboid == dboid)
+		return pending_dbentry;
+
 	entry_ref = pgstat_prep_pending_entry(PGSTAT_KIND_DATABASE, dboid, InvalidOid,
 										  NULL);
 
-	return entry_ref->pending;
+	pending_dbentry = entry_ref->pending;
+	pending_dbentry_dboid = dboid;
+
+	return pending_dbentry;
+}
+
+/*
+ * Reset the cache maintained by pgstat_prep_database_pending when a pending
+ * database entry goes away.
+ */
+void
+pgstat_database_delete_pending_cb(PgStat_EntryRef *entry_ref)
+{
+	if (entry_ref->pending == pending_dbentry)
+		pending_dbentry = NULL;
 }
 
 /*
@@ -22,6 +22,9 @@
  */
 #include "postgres.h"
 
+#include "common/hashfn.h"
+#include "port/pg_bitutils.h"
+#include "portability/instr_time.h"
 #include "storage/lmgr.h"		/* for GetLockNameFromTagType */
 #include "storage/lwlock.h"		/* for GetLWLockIdentifier */
 #include "storage/spin.h"
@@ -39,6 +42,9 @@ static const char *pgstat_get_wait_io(WaitEventIO w);
 static uint32 local_my_wait_event_info;
 uint32	   *my_wait_event_info = &local_my_wait_event_info;
 
+/* GUC: whether to time wait events; see pgstat_wait_timing_end() */
+bool		track_wait_timing = false;
+
 #define WAIT_EVENT_CLASS_MASK	0xFF000000
 #define WAIT_EVENT_ID_MASK		0x0000FFFF
 
@@ -337,6 +343,123 @@ GetWaitEventCustomNames(uint32 classId, int *nwaitevents)
 	return waiteventnames;
 }
 
+/*
+ * Wait event timing, enabled by track_wait_timing.
+ *
+ * Waits are accumulated into a fixed-size, statically allocated table of
+ * per-event histograms, addressed by open hashing on the wait event
+ * information.  A static table is essential here: wait events are reported
+ * from critical sections (LWLockAcquire, WaitIO, ...), where allocating
+ * memory is not an option.  The table is part of BSS and costs nothing
+ * until the first timed wait touches it.  In the unlikely event that a
+ * backend sees more distinct wait events than the table has slots, further
+ * events are silently not timed.
+ *
+ * Timing a wait takes one clock reading at wait start and one at wait end.
+ * When track_wait_timing is off, the only cost is a test of that flag in
+ * pgstat_report_wait_start()/end().
+ */
+#define WAIT_TIMING_TABLE_SIZE	256 /* must be a power of two */
+
+static WaitEventTiming wait_timing_table[WAIT_TIMING_TABLE_SIZE];
+static instr_time wait_timing_start_time;
+static uint32 wait_timing_pending = 0;
+
+/*
+ * Record the starting time of a wait.
+ *
+ * Wait events do not nest, but a process can switch from one wait event
+ * directly to another without an intervening pgstat_report_wait_end(); in
+ * that case the time spent under the first event is attributed to nothing,
+ * just as pg_stat_activity sampling would miss it.
+ */
+void
+pgstat_wait_timing_start(uint32 wait_event_info)
+{
+	wait_timing_pending = wait_event_info;
+	INSTR_TIME_SET_CURRENT(wait_timing_start_time);
+}
+
+/*
+ * Accumulate the just-ended wait into its histogram.
+ */
+void
+pgstat_wait_timing_end(void)
+{
+	instr_time	end_time;
+	uint64		elapsed_us;
+	uint32		wait_event_info = wait_timing_pending;
+	uint32		hash;
+	int			bucket;
+	WaitEventTiming *entry;
+
+	/* nothing to do when no timed wait is in progress */
+	if (wait_event_info == 0)
+		return;
+	wait_timing_pending = 0;
+
+	INSTR_TIME_SET_CURRENT(end_time);
+	INSTR_TIME_SUBTRACT(end_time, wait_timing_start_time);
+	elapsed_us = INSTR_TIME_GET_MICROSEC(end_time);
+
+	/* find the event's entry, or claim a free slot for it */
+	hash = murmurhash32(wait_event_info);
+	for (int i = 0; i < WAIT_TIMING_TABLE_SIZE; i++)
+	{
+		entry = &wait_timing_table[(hash + i) % WAIT_TIMING_TABLE_SIZE];
+		if (entry->wait_event_info == wait_event_info)
+			break;
+		if (entry->wait_event_info == 0)
+		{
+			entry->wait_event_info = wait_event_info;
+			break;
+		}
+		entry = NULL;
+	}
+	if (entry == NULL)
+		return;					/* table full, drop the sample */
+
+	if (elapsed_us == 0)
+		bucket = 0;
+	else
+		bucket = Min(pg_leftmost_one_pos64(elapsed_us) + 1,
+					 WAIT_TIMING_NBUCKETS - 1);
+
+	entry->count++;
+	entry->total_us += elapsed_us;
+	entry->buckets[bucket]++;
+}
+
+/*
+ * Return a palloc'd array of this backend's wait event timing entries, for
+ * the SQL-level functions.  The number of entries is returned in *nentries.
+ */
+WaitEventTiming *
+pgstat_get_wait_timing(int *nentries)
+{
+	WaitEventTiming *result;
+	int			n = 0;
+
+	result = palloc(sizeof(WaitEventTiming) * WAIT_TIMING_TABLE_SIZE);
+	for (int i = 0; i < WAIT_TIMING_TABLE_SIZE; i++)
+	{
+		if (wait_timing_table[i].wait_event_info != 0)
+			result[n++] = wait_timing_table[i];
+	}
+
+	*nentries = n;
+	return result;
+}
+
+/*
+ * Forget all wait event timing data collected so far by this backend.
+ */
+void
+pgstat_reset_wait_timing(void)
+{
+	memset(wait_timing_table, 0, sizeof(wait_timing_table));
+}
+
 /*
  * Configure wait event reporting to report wait events to *wait_event_info.
  * *wait_event_info needs to be valid until pgstat_reset_wait_event_storage()
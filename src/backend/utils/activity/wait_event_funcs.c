@@ -15,6 +15,7 @@
 #include "postgres.h"
 
 #include "funcapi.h"
+#include "utils/array.h"
 #include "utils/builtins.h"
 #include "utils/wait_event.h"
 
@@ -116,3 +117,65 @@ pg_get_wait_events(PG_FUNCTION_ARGS)
 
 	return (Datum) 0;
 }
+
+/*
+ * pg_get_wait_event_histogram
+ *
+ * List the wait event timing data collected by the calling backend while
+ * track_wait_timing was enabled: one row per wait event, with the number of
+ * timed waits, their total duration and a histogram of log2(microsecond)
+ * buckets (element i of the array counts the waits that took less than 2^i
+ * microseconds, but no less than half that; the last element also absorbs
+ * all longer waits).
+ */
+Datum
+pg_get_wait_event_histogram(PG_FUNCTION_ARGS)
+{
+#define PG_GET_WAIT_EVENT_HISTOGRAM_COLS 5
+	ReturnSetInfo *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	WaitEventTiming *entries;
+	int			nentries;
+
+	/* Build tuplestore to hold the result rows */
+	InitMaterializedSRF(fcinfo, 0);
+
+	entries = pgstat_get_wait_timing(&nentries);
+
+	for (int idx = 0; idx < nentries; idx++)
+	{
+		WaitEventTiming *entry = &entries[idx];
+		Datum		values[PG_GET_WAIT_EVENT_HISTOGRAM_COLS] = {0};
+		bool		nulls[PG_GET_WAIT_EVENT_HISTOGRAM_COLS] = {0};
+		Datum		buckets[WAIT_TIMING_NBUCKETS];
+
+		values[0] = CStringGetTextDatum(pgstat_get_wait_event_type(entry->wait_event_info));
+		values[1] = CStringGetTextDatum(pgstat_get_wait_event(entry->wait_event_info));
+		values[2] = Int64GetDatum((int64) entry->count);
+		values[3] = Float8GetDatum((double) entry->total_us / 1000.0);
+
+		for (int i = 0; i < WAIT_TIMING_NBUCKETS; i++)
+			buckets[i] = Int64GetDatum((int64) entry->buckets[i]);
+		values[4] = PointerGetDatum(construct_array_builtin(buckets,
+															WAIT_TIMING_NBUCKETS,
+															INT8OID));
+
+		tuplestore_putvalues(rsinfo->setResult, rsinfo->setDesc, values, nulls);
+	}
+
+	pfree(entries);
+
+	return (Datum) 0;
+}
+
+/*
+ * pg_wait_event_histogram_reset
+ *
+ * Discard the wait event timing data collected by the calling backend.
+ */
+Datum
+pg_wait_event_histogram_reset(PG_FUNCTION_ARGS)
+{
+	pgstat_reset_wait_timing();
+
+	PG_RETURN_VOID();
+}
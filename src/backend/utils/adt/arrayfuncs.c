@@ -26,6 +26,7 @@
 #include "optimizer/optimizer.h"
 #include "parser/scansup.h"
 #include "port/pg_bitutils.h"
+#include "port/pg_lfind.h"
 #include "utils/array.h"
 #include "utils/arrayaccess.h"
 #include "utils/builtins.h"
@@ -4370,6 +4371,53 @@ hash_array_extended(PG_FUNCTION_ARGS)
  *----------------------------------------------------------------------------
  */
 
+/*
+ * Does the equality operator amount to plain datum comparison?
+ *
+ * For these operators two by-value elements are equal if and only if their
+ * datum representations are equal, letting array_contain_compare() probe the
+ * deconstructed array directly instead of going through fmgr for every
+ * element pair.  Note that float4eq/float8eq do not qualify: NaNs compare
+ * equal and minus zero equals plus zero, neither of which holds for their bit
+ * patterns.
+ */
+static bool
+array_eq_opr_is_datum_eq(Oid eq_opr_fn)
+{
+	switch (eq_opr_fn)
+	{
+		case F_BOOLEQ:
+		case F_CHAREQ:
+		case F_INT2EQ:
+		case F_INT4EQ:
+		case F_INT8EQ:
+		case F_OIDEQ:
+		case F_DATE_EQ:
+		case F_TIMESTAMP_EQ:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/*
+ * Narrow a by-value datum of the given length to a 32-bit probe key.
+ * Equality of two values is equivalent to equality of their probe keys.
+ */
+static inline uint32
+array_datum_to_probe32(Datum value, int typlen)
+{
+	switch (typlen)
+	{
+		case 1:
+			return (uint32) DatumGetUInt8(value);
+		case 2:
+			return (uint32) DatumGetUInt16(value);
+		default:
+			return DatumGetUInt32(value);
+	}
+}
+
 /*
  * array_contain_compare :
  *		  compares two arrays for overlap/containment
@@ -4442,16 +4490,102 @@ array_contain_compare(AnyArrayType *array1, AnyArrayType *array2, Oid collation,
 						  element_type, typlen, typbyval, typalign,
 						  &values2, &nulls2, &nelems2);
 
+	/* Loop over source data */
+	nelems1 = ArrayGetNItems(AARR_NDIM(array1), AARR_DIMS(array1));
+	array_iter_setup(&it1, array1);
+
+	/*
+	 * If the equality operator is plain datum comparison of a by-value type,
+	 * probe array2 directly rather than calling the operator for each element
+	 * pair.  For types no wider than 32 bits, collect the non-null elements
+	 * of array2 into a dense probe array once, so each lookup can use the
+	 * SIMD-accelerated pg_lfind32(); wider types use a simple datum loop.
+	 * Either way, a NULL can't match anything, same as below.
+	 */
+	if (typbyval &&
+		array_eq_opr_is_datum_eq(typentry->eq_opr_finfo.fn_oid))
+	{
+		uint32	   *probe2 = NULL;
+		int			nprobe2 = 0;
+
+		if (typlen <= 4)
+		{
+			probe2 = (uint32 *) palloc(nelems2 * sizeof(uint32));
+			for (j = 0; j < nelems2; j++)
+			{
+				if (nulls2 && nulls2[j])
+					continue;
+				probe2[nprobe2++] = array_datum_to_probe32(values2[j], typlen);
+			}
+		}
+
+		for (i = 0; i < nelems1; i++)
+		{
+			Datum		elt1;
+			bool		isnull1;
+			bool		found;
+
+			elt1 = array_iter_next(&it1, &isnull1, i,
+								   typlen, typbyval, typalign);
+
+			if (isnull1)
+			{
+				if (matchall)
+				{
+					result = false;
+					break;
+				}
+				continue;
+			}
+
+			if (probe2)
+				found = pg_lfind32(array_datum_to_probe32(elt1, typlen),
+								   probe2, nprobe2);
+			else
+			{
+				found = false;
+				for (j = 0; j < nelems2; j++)
+				{
+					if (nulls2 && nulls2[j])
+						continue;
+					if (values2[j] == elt1)
+					{
+						found = true;
+						break;
+					}
+				}
+			}
+
+			if (found)
+			{
+				if (!matchall)
+				{
+					result = true;
+					break;
+				}
+			}
+			else
+			{
+				if (matchall)
+				{
+					result = false;
+					break;
+				}
+			}
+		}
+
+		if (probe2)
+			pfree(probe2);
+
+		return result;
+	}
+
 	/*
 	 * Apply the comparison operator to each pair of array elements.
 	 */
 	InitFunctionCallInfoData(*locfcinfo, &typentry->eq_opr_finfo, 2,
 							 collation, NULL, NULL);
 
-	/* Loop over source data */
-	nelems1 = ArrayGetNItems(AARR_NDIM(array1), AARR_DIMS(array1));
-	array_iter_setup(&it1, array1);
-
 	for (i = 0; i < nelems1; i++)
 	{
 		Datum		elt1;
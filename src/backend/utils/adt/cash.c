@@ -29,6 +29,7 @@
 #include "utils/float.h"
 #include "utils/numeric.h"
 #include "utils/pg_locale.h"
+#include "utils/skipsupport.h"
 
 
 /*************************************************************************
@@ -682,6 +683,51 @@ cash_cmp(PG_FUNCTION_ARGS)
 		PG_RETURN_INT32(-1);
 }
 
+static Datum
+cash_decrement(Relation rel, Datum existing, bool *underflow)
+{
+	Cash		cexisting = DatumGetCash(existing);
+
+	if (cexisting == PG_INT64_MIN)
+	{
+		/* return value is undefined */
+		*underflow = true;
+		return (Datum) 0;
+	}
+
+	*underflow = false;
+	return CashGetDatum(cexisting - 1);
+}
+
+static Datum
+cash_increment(Relation rel, Datum existing, bool *overflow)
+{
+	Cash		cexisting = DatumGetCash(existing);
+
+	if (cexisting == PG_INT64_MAX)
+	{
+		/* return value is undefined */
+		*overflow = true;
+		return (Datum) 0;
+	}
+
+	*overflow = false;
+	return CashGetDatum(cexisting + 1);
+}
+
+Datum
+cash_skipsupport(PG_FUNCTION_ARGS)
+{
+	SkipSupport sksup = (SkipSupport) PG_GETARG_POINTER(0);
+
+	sksup->decrement = cash_decrement;
+	sksup->increment = cash_increment;
+	sksup->low_elem = CashGetDatum(PG_INT64_MIN);
+	sksup->high_elem = CashGetDatum(PG_INT64_MAX);
+
+	PG_RETURN_VOID();
+}
+
 
 /* cash_pl()
  * Add two cash values.
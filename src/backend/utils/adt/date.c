@@ -1890,6 +1890,52 @@ time_cmp(PG_FUNCTION_ARGS)
 	PG_RETURN_INT32(0);
 }
 
+static Datum
+time_decrement(Relation rel, Datum existing, bool *underflow)
+{
+	TimeADT		texisting = DatumGetTimeADT(existing);
+
+	if (texisting == 0)
+	{
+		/* return value is undefined */
+		*underflow = true;
+		return (Datum) 0;
+	}
+
+	*underflow = false;
+	return TimeADTGetDatum(texisting - 1);
+}
+
+static Datum
+time_increment(Relation rel, Datum existing, bool *overflow)
+{
+	TimeADT		texisting = DatumGetTimeADT(existing);
+
+	if (texisting == USECS_PER_DAY)
+	{
+		/* return value is undefined */
+		*overflow = true;
+		return (Datum) 0;
+	}
+
+	*overflow = false;
+	return TimeADTGetDatum(texisting + 1);
+}
+
+Datum
+time_skipsupport(PG_FUNCTION_ARGS)
+{
+	SkipSupport sksup = (SkipSupport) PG_GETARG_POINTER(0);
+
+	/* 24:00:00 is a valid time value, so it is our upper bound */
+	sksup->decrement = time_decrement;
+	sksup->increment = time_increment;
+	sksup->low_elem = TimeADTGetDatum(0);
+	sksup->high_elem = TimeADTGetDatum(USECS_PER_DAY);
+
+	PG_RETURN_VOID();
+}
+
 Datum
 time_hash(PG_FUNCTION_ARGS)
 {
@@ -2496,6 +2496,33 @@ from_char_seq_search(int *dest, const char **src, const char *const *array,
 	return true;
 }
 
+/* ----------
+ * Append the decimal string representation of 'value' at 's', zero-padded
+ * to 'minwidth' digits (0 disables padding), and NUL-terminate it.
+ *
+ * This is equivalent to sprintf(s, "%0*d", minwidth, value), done by hand
+ * for the common non-negative case: digit emission dominates the cost of
+ * formatting a timestamp, and re-interpreting a printf format string for
+ * every field is far slower than the digit tables in numutils.c.
+ * ----------
+ */
+static void
+DCH_emit_int(char *s, int value, int minwidth)
+{
+	if (likely(value >= 0))
+	{
+		char	   *end;
+
+		if (minwidth > 0)
+			end = pg_ultostr_zeropad(s, (uint32) value, minwidth);
+		else
+			end = pg_ultostr(s, (uint32) value);
+		*end = '\0';
+	}
+	else
+		sprintf(s, "%0*d", minwidth, value);
+}
+
 /* ----------
  * Process a TmToChar struct as denoted by a list of FormatNodes.
  * The formatted data is written to the string pointed to by 'out'.
@@ -2571,45 +2598,45 @@ DCH_to_char(FormatNode *node, bool is_interval, TmToChar *in, char *out, Oid col
 				s += strlen(s);
 				break;
 			case DCH_MI:
-				sprintf(s, "%0*d", S_FM(n->suffix) ? 0 : (tm->tm_min >= 0) ? 2 : 3,
-						tm->tm_min);
+				DCH_emit_int(s, tm->tm_min,
+							 S_FM(n->suffix) ? 0 : (tm->tm_min >= 0) ? 2 : 3);
 				if (S_THth(n->suffix))
 					str_numth(s, s, S_TH_TYPE(n->suffix));
 				s += strlen(s);
 				break;
 			case DCH_SS:
-				sprintf(s, "%0*d", S_FM(n->suffix) ? 0 : (tm->tm_sec >= 0) ? 2 : 3,
-						tm->tm_sec);
+				DCH_emit_int(s, tm->tm_sec,
+							 S_FM(n->suffix) ? 0 : (tm->tm_sec >= 0) ? 2 : 3);
 				if (S_THth(n->suffix))
 					str_numth(s, s, S_TH_TYPE(n->suffix));
 				s += strlen(s);
 				break;
 
-#define DCH_to_char_fsec(frac_fmt, frac_val) \
-				sprintf(s, frac_fmt, (int) (frac_val)); \
+#define DCH_to_char_fsec(frac_width, frac_val) \
+				DCH_emit_int(s, (int) (frac_val), frac_width); \
 				if (S_THth(n->suffix)) \
 					str_numth(s, s, S_TH_TYPE(n->suffix)); \
 				s += strlen(s)
 
 			case DCH_FF1:		/* tenth of second */
-				DCH_to_char_fsec("%01d", in->fsec / 100000);
+				DCH_to_char_fsec(1, in->fsec / 100000);
 				break;
 			case DCH_FF2:		/* hundredth of second */
-				DCH_to_char_fsec("%02d", in->fsec / 10000);
+				DCH_to_char_fsec(2, in->fsec / 10000);
 				break;
 			case DCH_FF3:
 			case DCH_MS:		/* millisecond */
-				DCH_to_char_fsec("%03d", in->fsec / 1000);
+				DCH_to_char_fsec(3, in->fsec / 1000);
 				break;
 			case DCH_FF4:		/* tenth of a millisecond */
-				DCH_to_char_fsec("%04d", in->fsec / 100);
+				DCH_to_char_fsec(4, in->fsec / 100);
 				break;
 			case DCH_FF5:		/* hundredth of a millisecond */
-				DCH_to_char_fsec("%05d", in->fsec / 10);
+				DCH_to_char_fsec(5, in->fsec / 10);
 				break;
 			case DCH_FF6:
 			case DCH_US:		/* microsecond */
-				DCH_to_char_fsec("%06d", in->fsec);
+				DCH_to_char_fsec(6, in->fsec);
 				break;
 #undef DCH_to_char_fsec
 			case DCH_SSSS:
@@ -2810,8 +2837,8 @@ DCH_to_char(FormatNode *node, bool is_interval, TmToChar *in, char *out, Oid col
 				s += strlen(s);
 				break;
 			case DCH_MM:
-				sprintf(s, "%0*d", S_FM(n->suffix) ? 0 : (tm->tm_mon >= 0) ? 2 : 3,
-						tm->tm_mon);
+				DCH_emit_int(s, tm->tm_mon,
+							 S_FM(n->suffix) ? 0 : (tm->tm_mon >= 0) ? 2 : 3);
 				if (S_THth(n->suffix))
 					str_numth(s, s, S_TH_TYPE(n->suffix));
 				s += strlen(s);
@@ -2923,16 +2950,17 @@ DCH_to_char(FormatNode *node, bool is_interval, TmToChar *in, char *out, Oid col
 				break;
 			case DCH_DDD:
 			case DCH_IDDD:
-				sprintf(s, "%0*d", S_FM(n->suffix) ? 0 : 3,
-						(n->key->id == DCH_DDD) ?
-						tm->tm_yday :
-						date2isoyearday(tm->tm_year, tm->tm_mon, tm->tm_mday));
+				DCH_emit_int(s,
+							 (n->key->id == DCH_DDD) ?
+							 tm->tm_yday :
+							 date2isoyearday(tm->tm_year, tm->tm_mon, tm->tm_mday),
+							 S_FM(n->suffix) ? 0 : 3);
 				if (S_THth(n->suffix))
 					str_numth(s, s, S_TH_TYPE(n->suffix));
 				s += strlen(s);
 				break;
 			case DCH_DD:
-				sprintf(s, "%0*d", S_FM(n->suffix) ? 0 : 2, tm->tm_mday);
+				DCH_emit_int(s, tm->tm_mday, S_FM(n->suffix) ? 0 : 2);
 				if (S_THth(n->suffix))
 					str_numth(s, s, S_TH_TYPE(n->suffix));
 				s += strlen(s);
@@ -2952,15 +2980,16 @@ DCH_to_char(FormatNode *node, bool is_interval, TmToChar *in, char *out, Oid col
 				s += strlen(s);
 				break;
 			case DCH_WW:
-				sprintf(s, "%0*d", S_FM(n->suffix) ? 0 : 2,
-						(tm->tm_yday - 1) / 7 + 1);
+				DCH_emit_int(s, (tm->tm_yday - 1) / 7 + 1,
+							 S_FM(n->suffix) ? 0 : 2);
 				if (S_THth(n->suffix))
 					str_numth(s, s, S_TH_TYPE(n->suffix));
 				s += strlen(s);
 				break;
 			case DCH_IW:
-				sprintf(s, "%0*d", S_FM(n->suffix) ? 0 : 2,
-						date2isoweek(tm->tm_year, tm->tm_mon, tm->tm_mday));
+				DCH_emit_int(s,
+							 date2isoweek(tm->tm_year, tm->tm_mon, tm->tm_mday),
+							 S_FM(n->suffix) ? 0 : 2);
 				if (S_THth(n->suffix))
 					str_numth(s, s, S_TH_TYPE(n->suffix));
 				s += strlen(s);
@@ -2986,7 +3015,8 @@ DCH_to_char(FormatNode *node, bool is_interval, TmToChar *in, char *out, Oid col
 						i = tm->tm_year / 100 - 1;
 				}
 				if (i <= 99 && i >= -99)
-					sprintf(s, "%0*d", S_FM(n->suffix) ? 0 : (i >= 0) ? 2 : 3, i);
+					DCH_emit_int(s, i,
+								 S_FM(n->suffix) ? 0 : (i >= 0) ? 2 : 3);
 				else
 					sprintf(s, "%d", i);
 				if (S_THth(n->suffix))
@@ -3003,45 +3033,45 @@ DCH_to_char(FormatNode *node, bool is_interval, TmToChar *in, char *out, Oid col
 				break;
 			case DCH_YYYY:
 			case DCH_IYYY:
-				sprintf(s, "%0*d",
-						S_FM(n->suffix) ? 0 :
-						(ADJUST_YEAR(tm->tm_year, is_interval) >= 0) ? 4 : 5,
-						(n->key->id == DCH_YYYY ?
-						 ADJUST_YEAR(tm->tm_year, is_interval) :
-						 ADJUST_YEAR(date2isoyear(tm->tm_year,
-												  tm->tm_mon,
-												  tm->tm_mday),
-									 is_interval)));
+				DCH_emit_int(s,
+							 (n->key->id == DCH_YYYY ?
+							  ADJUST_YEAR(tm->tm_year, is_interval) :
+							  ADJUST_YEAR(date2isoyear(tm->tm_year,
+													   tm->tm_mon,
+													   tm->tm_mday),
+										  is_interval)),
+							 S_FM(n->suffix) ? 0 :
+							 (ADJUST_YEAR(tm->tm_year, is_interval) >= 0) ? 4 : 5);
 				if (S_THth(n->suffix))
 					str_numth(s, s, S_TH_TYPE(n->suffix));
 				s += strlen(s);
 				break;
 			case DCH_YYY:
 			case DCH_IYY:
-				sprintf(s, "%0*d",
-						S_FM(n->suffix) ? 0 :
-						(ADJUST_YEAR(tm->tm_year, is_interval) >= 0) ? 3 : 4,
-						(n->key->id == DCH_YYY ?
-						 ADJUST_YEAR(tm->tm_year, is_interval) :
-						 ADJUST_YEAR(date2isoyear(tm->tm_year,
-												  tm->tm_mon,
-												  tm->tm_mday),
-									 is_interval)) % 1000);
+				DCH_emit_int(s,
+							 (n->key->id == DCH_YYY ?
+							  ADJUST_YEAR(tm->tm_year, is_interval) :
+							  ADJUST_YEAR(date2isoyear(tm->tm_year,
+													   tm->tm_mon,
+													   tm->tm_mday),
+										  is_interval)) % 1000,
+							 S_FM(n->suffix) ? 0 :
+							 (ADJUST_YEAR(tm->tm_year, is_interval) >= 0) ? 3 : 4);
 				if (S_THth(n->suffix))
 					str_numth(s, s, S_TH_TYPE(n->suffix));
 				s += strlen(s);
 				break;
 			case DCH_YY:
 			case DCH_IY:
-				sprintf(s, "%0*d",
-						S_FM(n->suffix) ? 0 :
-						(ADJUST_YEAR(tm->tm_year, is_interval) >= 0) ? 2 : 3,
-						(n->key->id == DCH_YY ?
-						 ADJUST_YEAR(tm->tm_year, is_interval) :
-						 ADJUST_YEAR(date2isoyear(tm->tm_year,
-												  tm->tm_mon,
-												  tm->tm_mday),
-									 is_interval)) % 100);
+				DCH_emit_int(s,
+							 (n->key->id == DCH_YY ?
+							  ADJUST_YEAR(tm->tm_year, is_interval) :
+							  ADJUST_YEAR(date2isoyear(tm->tm_year,
+													   tm->tm_mon,
+													   tm->tm_mday),
+										  is_interval)) % 100,
+							 S_FM(n->suffix) ? 0 :
+							 (ADJUST_YEAR(tm->tm_year, is_interval) >= 0) ? 2 : 3);
 				if (S_THth(n->suffix))
 					str_numth(s, s, S_TH_TYPE(n->suffix));
 				s += strlen(s);
@@ -45,6 +45,7 @@ static Jsonb *convertToJsonb(JsonbValue *val);
 static void convertJsonbValue(StringInfo buffer, JEntry *header, JsonbValue *val, int level);
 static void convertJsonbArray(StringInfo buffer, JEntry *header, JsonbValue *val, int level);
 static void convertJsonbObject(StringInfo buffer, JEntry *header, JsonbValue *val, int level);
+static void convertJsonbBinary(StringInfo buffer, JEntry *header, JsonbValue *val);
 static void convertJsonbScalar(StringInfo buffer, JEntry *header, JsonbValue *scalarVal);
 
 static int	reserveFromBuffer(StringInfo buffer, int len);
@@ -609,6 +610,19 @@ pushJsonbValue(JsonbParseState **pstate, JsonbIteratorToken seq,
 		return pushJsonbValueScalar(pstate, seq, jbval);
 	}
 
+	/*
+	 * If a container is already open, we can add a non-scalar binary value
+	 * to it as-is: the serializer copies the binary representation verbatim
+	 * (see convertJsonbBinary).  Unpacking it here token by token would only
+	 * rebuild an identical copy, which gets expensive when large unchanged
+	 * sub-documents pass through, e.g. in jsonb_set or jsonb concatenation.
+	 * Raw-scalar pseudo-arrays must still be unwrapped, below, and with no
+	 * parse state we unpack so that callers always get a fully-expanded tree
+	 * for a lone value.
+	 */
+	if (*pstate && !(jbval->val.binary.data->header & JB_FSCALAR))
+		return pushJsonbValueScalar(pstate, seq, jbval);
+
 	/* unpack the binary and add each piece to the pstate */
 	it = JsonbIteratorInit(jbval->val.binary.data);
 
@@ -687,11 +701,11 @@ pushJsonbValueScalar(JsonbParseState **pstate, JsonbIteratorToken seq,
 			appendKey(*pstate, scalarVal);
 			break;
 		case WJB_VALUE:
-			Assert(IsAJsonbScalar(scalarVal));
+			Assert(IsAJsonbScalar(scalarVal) || scalarVal->type == jbvBinary);
 			appendValue(*pstate, scalarVal);
 			break;
 		case WJB_ELEM:
-			Assert(IsAJsonbScalar(scalarVal));
+			Assert(IsAJsonbScalar(scalarVal) || scalarVal->type == jbvBinary);
 			appendElement(*pstate, scalarVal);
 			break;
 		case WJB_END_OBJECT:
@@ -1602,10 +1616,9 @@ convertJsonbValue(StringInfo buffer, JEntry *header, JsonbValue *val, int level)
 		return;
 
 	/*
-	 * A JsonbValue passed as val should never have a type of jbvBinary, and
-	 * neither should any of its sub-components. Those values will be produced
-	 * by convertJsonbArray and convertJsonbObject, the results of which will
-	 * not be passed back to this function as an argument.
+	 * A jbvBinary value is an already-serialized container (stashed in the
+	 * parse tree by pushJsonbValue); its bytes are copied verbatim rather
+	 * than being re-serialized node by node.
 	 */
 
 	if (IsAJsonbScalar(val))
@@ -1614,6 +1627,8 @@ convertJsonbValue(StringInfo buffer, JEntry *header, JsonbValue *val, int level)
 		convertJsonbArray(buffer, header, val, level);
 	else if (val->type == jbvObject)
 		convertJsonbObject(buffer, header, val, level);
+	else if (val->type == jbvBinary)
+		convertJsonbBinary(buffer, header, val);
 	else
 		elog(ERROR, "unknown type of jsonb container to convert");
 }
@@ -1818,6 +1833,44 @@ convertJsonbObject(StringInfo buffer, JEntry *header, JsonbValue *val, int level
 	*header = JENTRY_ISCONTAINER | totallen;
 }
 
+/*
+ * Copy an already-serialized container into the buffer verbatim.
+ *
+ * The binary representation of a container is position-independent except
+ * for alignment: JEntry offsets are relative to the container, and any
+ * interior alignment padding was laid down relative to a 4-byte-aligned
+ * container start.  So after aligning the buffer the bytes can simply be
+ * copied, and the copy is indistinguishable from a node-by-node rebuild.
+ */
+static void
+convertJsonbBinary(StringInfo buffer, JEntry *header, JsonbValue *val)
+{
+	int			base_offset;
+	int			totallen;
+
+	Assert(val->type == jbvBinary);
+	Assert(!(val->val.binary.data->header & JB_FSCALAR));
+
+	/* Remember where in the buffer this container starts. */
+	base_offset = buffer->len;
+
+	/* Align to 4-byte boundary (any padding counts as part of my data) */
+	padBufferToInt(buffer);
+
+	appendToBuffer(buffer, (char *) val->val.binary.data, val->val.binary.len);
+
+	/* Total data size is everything we've appended to buffer */
+	totallen = buffer->len - base_offset;
+
+	if (totallen > JENTRY_OFFLENMASK)
+		ereport(ERROR,
+				(errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+				 errmsg("total size of jsonb element exceeds the maximum of %d bytes",
+						JENTRY_OFFLENMASK)));
+
+	*header = JENTRY_ISCONTAINER | totallen;
+}
+
 static void
 convertJsonbScalar(StringInfo buffer, JEntry *header, JsonbValue *scalarVal)
 {
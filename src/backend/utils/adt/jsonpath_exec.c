@@ -123,6 +123,15 @@ typedef struct JsonLikeRegexContext
 	int			cflags;
 } JsonLikeRegexContext;
 
+/*
+ * Cross-call cache for a constant jsonpath argument, kept in fn_extra.
+ */
+typedef struct JsonPathArgCache
+{
+	bool		stable;			/* is the argument a query constant? */
+	JsonPath   *path;			/* detoasted copy in fn_mcxt, or NULL */
+} JsonPathArgCache;
+
 /* Result of jsonpath predicate evaluation */
 typedef enum JsonPathBool
 {
@@ -381,6 +390,56 @@ const TableFuncRoutine JsonbTableRoutine =
 
 /****************** User interface to JsonPath executor ********************/
 
+/*
+ * Fetch a jsonpath argument, caching the detoasted form across calls.
+ *
+ * The jsonpath argument is nearly always a query constant, yet it is fetched
+ * and (when compressed or short-headered) detoasted over again for every row
+ * processed.  When the argument is stable, detoast it just once into fn_mcxt
+ * and reuse that copy for all subsequent calls.  On return, *release tells
+ * whether the caller must release the result with PG_FREE_IF_COPY; a cached
+ * path must be left alone.
+ *
+ * This must not be used by set-returning functions, whose fn_extra is taken
+ * by the SRF machinery.
+ */
+static JsonPath *
+getJsonPathArg(FunctionCallInfo fcinfo, int argno, bool *release)
+{
+	FmgrInfo   *flinfo = fcinfo->flinfo;
+
+	if (flinfo != NULL)
+	{
+		JsonPathArgCache *cache = (JsonPathArgCache *) flinfo->fn_extra;
+
+		if (cache == NULL)
+		{
+			cache = (JsonPathArgCache *)
+				MemoryContextAlloc(flinfo->fn_mcxt, sizeof(JsonPathArgCache));
+			cache->stable = get_fn_expr_arg_stable(flinfo, argno);
+			cache->path = NULL;
+			flinfo->fn_extra = cache;
+		}
+
+		if (cache->stable)
+		{
+			if (cache->path == NULL)
+			{
+				MemoryContext oldcxt = MemoryContextSwitchTo(flinfo->fn_mcxt);
+
+				cache->path = DatumGetJsonPathPCopy(PG_GETARG_DATUM(argno));
+				MemoryContextSwitchTo(oldcxt);
+			}
+
+			*release = false;
+			return cache->path;
+		}
+	}
+
+	*release = true;
+	return DatumGetJsonPathP(PG_GETARG_DATUM(argno));
+}
+
 /*
  * jsonb_path_exists
  *		Returns true if jsonpath returns at least one item for the specified
@@ -397,7 +456,8 @@ static Datum
 jsonb_path_exists_internal(FunctionCallInfo fcinfo, bool tz)
 {
 	Jsonb	   *jb = PG_GETARG_JSONB_P(0);
-	JsonPath   *jp = PG_GETARG_JSONPATH_P(1);
+	bool		release;
+	JsonPath   *jp = getJsonPathArg(fcinfo, 1, &release);
 	JsonPathExecResult res;
 	Jsonb	   *vars = NULL;
 	bool		silent = true;
@@ -413,7 +473,8 @@ jsonb_path_exists_internal(FunctionCallInfo fcinfo, bool tz)
 						  jb, !silent, NULL, tz);
 
 	PG_FREE_IF_COPY(jb, 0);
-	PG_FREE_IF_COPY(jp, 1);
+	if (release)
+		PG_FREE_IF_COPY(jp, 1);
 
 	if (jperIsError(res))
 		PG_RETURN_NULL();
@@ -454,7 +515,8 @@ static Datum
 jsonb_path_match_internal(FunctionCallInfo fcinfo, bool tz)
 {
 	Jsonb	   *jb = PG_GETARG_JSONB_P(0);
-	JsonPath   *jp = PG_GETARG_JSONPATH_P(1);
+	bool		release;
+	JsonPath   *jp = getJsonPathArg(fcinfo, 1, &release);
 	JsonValueList found = {0};
 	Jsonb	   *vars = NULL;
 	bool		silent = true;
@@ -470,7 +532,8 @@ jsonb_path_match_internal(FunctionCallInfo fcinfo, bool tz)
 						   jb, !silent, &found, tz);
 
 	PG_FREE_IF_COPY(jb, 0);
-	PG_FREE_IF_COPY(jp, 1);
+	if (release)
+		PG_FREE_IF_COPY(jp, 1);
 
 	if (JsonValueListLength(&found) == 1)
 	{
@@ -589,7 +652,8 @@ static Datum
 jsonb_path_query_array_internal(FunctionCallInfo fcinfo, bool tz)
 {
 	Jsonb	   *jb = PG_GETARG_JSONB_P(0);
-	JsonPath   *jp = PG_GETARG_JSONPATH_P(1);
+	bool		release;
+	JsonPath   *jp = getJsonPathArg(fcinfo, 1, &release);
 	JsonValueList found = {0};
 	Jsonb	   *vars = PG_GETARG_JSONB_P(2);
 	bool		silent = PG_GETARG_BOOL(3);
@@ -622,7 +686,8 @@ static Datum
 jsonb_path_query_first_internal(FunctionCallInfo fcinfo, bool tz)
 {
 	Jsonb	   *jb = PG_GETARG_JSONB_P(0);
-	JsonPath   *jp = PG_GETARG_JSONPATH_P(1);
+	bool		release;
+	JsonPath   *jp = getJsonPathArg(fcinfo, 1, &release);
 	JsonValueList found = {0};
 	Jsonb	   *vars = PG_GETARG_JSONB_P(2);
 	bool		silent = PG_GETARG_BOOL(3);
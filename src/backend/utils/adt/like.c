@@ -22,6 +22,8 @@
 #include "catalog/pg_collation.h"
 #include "mb/pg_wchar.h"
 #include "miscadmin.h"
+#include "port/pg_bitutils.h"
+#include "port/simd.h"
 #include "utils/fmgrprotos.h"
 #include "utils/pg_locale.h"
 #include "varatt.h"
@@ -145,6 +147,173 @@ SB_lower_char(unsigned char c, pg_locale_t locale)
 
 #include "like_match.c"
 
+/*
+ * Fast paths for simple patterns
+ *
+ * A large fraction of real-world patterns are just a literal string,
+ * optionally preceded and/or followed by a single '%': exact, prefix,
+ * suffix and infix (substring) matches.  Those need none of the recursive
+ * backtracking machinery in like_match.c; they can be evaluated with flat
+ * memory comparisons, and the infix case with a SIMD substring search.
+ *
+ * The fast paths compare bytes, not characters, so they can be used only
+ * when that is equivalent: with deterministic collations, and with
+ * single-byte encodings or UTF-8.  (In UTF-8 a match of the literal's
+ * bytes can only start on a character boundary, because the literal's
+ * first byte is never a continuation byte.)  Callers are responsible for
+ * checking those conditions.
+ */
+
+/*
+ * Check whether a pattern qualifies for the fast paths, and if so return
+ * the literal "needle" within it and which ends of the text it is
+ * anchored to.  Wildcards other than the anchoring '%'s, and escape
+ * characters, disqualify the pattern.
+ */
+static bool
+SimplePatternAnalyze(const char *p, int plen, const char **needle, int *nlen,
+					 bool *anchor_head, bool *anchor_tail)
+{
+	*anchor_head = true;
+	*anchor_tail = true;
+
+	if (plen > 0 && p[0] == '%')
+	{
+		p++;
+		plen--;
+		*anchor_head = false;
+	}
+	if (plen > 0 && p[plen - 1] == '%')
+	{
+		plen--;
+		*anchor_tail = false;
+	}
+
+	for (int i = 0; i < plen; i++)
+	{
+		if (p[i] == '%' || p[i] == '_' || p[i] == '\\')
+			return false;
+	}
+
+	*needle = p;
+	*nlen = plen;
+	return true;
+}
+
+/*
+ * Compare two byte ranges, optionally folding ASCII case on both sides
+ * (which is all that case-insensitive matching means in the C ctype).
+ */
+static inline bool
+SimpleEqBytes(const char *a, const char *b, int len, bool icase)
+{
+	if (!icase)
+		return memcmp(a, b, len) == 0;
+
+	while (len-- > 0)
+	{
+		if (pg_ascii_tolower((unsigned char) *a++) !=
+			pg_ascii_tolower((unsigned char) *b++))
+			return false;
+	}
+	return true;
+}
+
+/*
+ * Search for the needle anywhere in the text.
+ *
+ * The SIMD loop scans for positions where both the first and the last
+ * byte of the needle appear the right distance apart, and verifies only
+ * those candidates.  When folding case, ORing 0x20 into both sides makes
+ * the byte filter accept every ASCII-case-insensitive match (plus some
+ * false candidates, which verification weeds out).
+ */
+static bool
+SimpleFindSubstring(const char *t, int tlen, const char *needle, int nlen,
+					bool icase)
+{
+	int			last_start = tlen - nlen;
+	uint8		first = (uint8) needle[0];
+	uint8		last = (uint8) needle[nlen - 1];
+	int			i = 0;
+
+	Assert(nlen > 0);
+
+	if (last_start < 0)
+		return false;
+
+	if (icase)
+	{
+		first |= 0x20;
+		last |= 0x20;
+	}
+
+#ifndef USE_NO_SIMD
+	{
+		const Vector8 vfirst = vector8_broadcast(first);
+		const Vector8 vlast = vector8_broadcast(last);
+		const Vector8 vcase = vector8_broadcast(icase ? 0x20 : 0);
+
+		for (; i + (int) sizeof(Vector8) <= last_start + 1;
+			 i += sizeof(Vector8))
+		{
+			Vector8		vhead;
+			Vector8		vtail;
+			uint32		candidates;
+
+			vector8_load(&vhead, (const uint8 *) (t + i));
+			vector8_load(&vtail, (const uint8 *) (t + i + nlen - 1));
+			vhead = vector8_or(vhead, vcase);
+			vtail = vector8_or(vtail, vcase);
+			candidates = vector8_highbit_mask(vector8_eq(vhead, vfirst)) &
+				vector8_highbit_mask(vector8_eq(vtail, vlast));
+
+			while (candidates != 0)
+			{
+				int			off = pg_rightmost_one_pos32(candidates);
+
+				if (SimpleEqBytes(t + i + off, needle, nlen, icase))
+					return true;
+				candidates &= candidates - 1;
+			}
+		}
+	}
+#endif
+
+	for (; i <= last_start; i++)
+	{
+		if (SimpleEqBytes(t + i, needle, nlen, icase))
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * Match the text against an analyzed simple pattern.
+ */
+static int
+SimpleMatchText(const char *t, int tlen, const char *needle, int nlen,
+				bool anchor_head, bool anchor_tail, bool icase)
+{
+	if (anchor_head && anchor_tail && tlen != nlen)
+		return LIKE_FALSE;
+	if (tlen < nlen)
+		return LIKE_FALSE;
+
+	if (anchor_head)
+		return SimpleEqBytes(t, needle, nlen, icase) ? LIKE_TRUE : LIKE_FALSE;
+	if (anchor_tail)
+		return SimpleEqBytes(t + tlen - nlen, needle, nlen, icase) ?
+			LIKE_TRUE : LIKE_FALSE;
+
+	if (nlen == 0)
+		return LIKE_TRUE;
+
+	return SimpleFindSubstring(t, tlen, needle, nlen, icase) ?
+		LIKE_TRUE : LIKE_FALSE;
+}
+
 /* Generic for all cases not requiring inline case-folding */
 static inline int
 GenericMatchText(const char *s, int slen, const char *p, int plen, Oid collation)
@@ -166,9 +335,33 @@ GenericMatchText(const char *s, int slen, const char *p, int plen, Oid collation
 	locale = pg_newlocale_from_collation(collation);
 
 	if (pg_database_encoding_max_length() == 1)
+	{
+		const char *needle;
+		int			nlen;
+		bool		anchor_head,
+					anchor_tail;
+
+		if (locale->deterministic &&
+			SimplePatternAnalyze(p, plen, &needle, &nlen,
+								 &anchor_head, &anchor_tail))
+			return SimpleMatchText(s, slen, needle, nlen,
+								   anchor_head, anchor_tail, false);
 		return SB_MatchText(s, slen, p, plen, locale);
+	}
 	else if (GetDatabaseEncoding() == PG_UTF8)
+	{
+		const char *needle;
+		int			nlen;
+		bool		anchor_head,
+					anchor_tail;
+
+		if (locale->deterministic &&
+			SimplePatternAnalyze(p, plen, &needle, &nlen,
+								 &anchor_head, &anchor_tail))
+			return SimpleMatchText(s, slen, needle, nlen,
+								   anchor_head, anchor_tail, false);
 		return UTF8_MatchText(s, slen, p, plen, locale);
+	}
 	else
 		return MB_MatchText(s, slen, p, plen, locale);
 }
@@ -217,6 +410,23 @@ Generic_Text_IC_like(text *str, text *pat, Oid collation)
 		plen = VARSIZE_ANY_EXHDR(pat);
 		s = VARDATA_ANY(str);
 		slen = VARSIZE_ANY_EXHDR(str);
+
+		/*
+		 * In the C ctype, case folding is plain ASCII folding of each byte,
+		 * so simple patterns can use the bytewise fast paths.
+		 */
+		if (locale->ctype_is_c)
+		{
+			const char *needle;
+			int			nlen;
+			bool		anchor_head,
+						anchor_tail;
+
+			if (SimplePatternAnalyze(p, plen, &needle, &nlen,
+									 &anchor_head, &anchor_tail))
+				return SimpleMatchText(s, slen, needle, nlen,
+									   anchor_head, anchor_tail, true);
+		}
 		return SB_IMatchText(s, slen, p, plen, locale);
 	}
 	else
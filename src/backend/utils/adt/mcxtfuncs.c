@@ -71,7 +71,7 @@ PutMemoryContextsStatsTupleStore(Tuplestorestate *tupstore,
 								 TupleDesc tupdesc, MemoryContext context,
 								 HTAB *context_id_lookup)
 {
-#define PG_GET_BACKEND_MEMORY_CONTEXTS_COLS	10
+#define PG_GET_BACKEND_MEMORY_CONTEXTS_COLS	11
 
 	Datum		values[PG_GET_BACKEND_MEMORY_CONTEXTS_COLS];
 	bool		nulls[PG_GET_BACKEND_MEMORY_CONTEXTS_COLS];
@@ -170,6 +170,7 @@ PutMemoryContextsStatsTupleStore(Tuplestorestate *tupstore,
 	values[7] = Int64GetDatum(stat.freespace);
 	values[8] = Int64GetDatum(stat.freechunks);
 	values[9] = Int64GetDatum(stat.totalspace - stat.freespace);
+	values[10] = Int64GetDatum(context->peak_allocated);
 
 	tuplestore_putvalues(tupstore, tupdesc, values, nulls);
 	list_free(path);
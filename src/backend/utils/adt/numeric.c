@@ -4914,6 +4914,12 @@ typedef struct NumericAggState
 	int64		N;				/* count of processed numbers */
 	NumericSumAccum sumX;		/* sum of processed numbers */
 	NumericSumAccum sumX2;		/* sum of squares of processed numbers */
+#ifdef HAVE_INT128
+	int128		fastSumX;		/* pending inputs not yet folded into sumX,
+								 * as an integer scaled by NBASE^fastScale */
+	int			fastScale;		/* # of NBASE digits after the decimal point
+								 * carried in fastSumX */
+#endif
 	int			maxScale;		/* maximum scale seen so far */
 	int64		maxScaleCount;	/* number of values seen with maximum scale */
 	/* These counts are *not* included in N!  Use NA_TOTAL_COUNT() as needed */
@@ -4966,6 +4972,113 @@ makeNumericAggStateCurrentContext(bool calcSumX2)
 	return state;
 }
 
+#ifdef HAVE_INT128
+
+/*
+ * Limits for the int128 fast-path accumulation of sum(X), used when no
+ * sum(X*X) is required.  An input qualifies if it spans no more than
+ * NUMERIC_FASTSUM_MAX_DIGITS NBASE digits once brought to the common scale,
+ * so its scaled value is below NBASE^8 = 10^32.  The running sum is folded
+ * into the NumericSumAccum whenever it approaches 2^120, long before an
+ * int128 could overflow from one more such addition.
+ */
+#define NUMERIC_FASTSUM_MAX_DIGITS	8
+#define NUMERIC_FASTSUM_ABS_LIMIT	(((int128) 1) << 120)
+
+/*
+ * Fold the pending fast-path sum, if any, into state->sumX.
+ *
+ * This must be called before looking at state->sumX directly, e.g. to
+ * finalize, serialize or combine the state.  Like accum_sum_carry(), it
+ * changes only the representation, not the logical value, so it is safe to
+ * reach it from final functions.
+ */
+static void
+numeric_fastsum_flush(NumericAggState *state)
+{
+	NumericVar	tmp_var;
+	MemoryContext old_context;
+
+	if (state->fastSumX == 0)
+		return;
+
+	init_var(&tmp_var);
+	int128_to_numericvar(state->fastSumX, &tmp_var);
+	tmp_var.weight -= state->fastScale;
+	tmp_var.dscale = state->maxScale;
+
+	old_context = MemoryContextSwitchTo(state->agg_context);
+	accum_sum_add(&state->sumX, &tmp_var);
+	MemoryContextSwitchTo(old_context);
+
+	free_var(&tmp_var);
+	state->fastSumX = 0;
+}
+
+/*
+ * Try to accumulate X into (or, if subtract, discard it from) the int128
+ * fast-path sum.  Returns false if X is too wide to qualify, in which case
+ * the caller must fall back on the NumericSumAccum path.
+ *
+ * The point of this path is that for typical narrow inputs, such as money
+ * amounts, it touches no memory beyond the state struct itself: no digit
+ * buffer allocation, no memory context switch, just integer arithmetic.
+ */
+static bool
+numeric_fastsum_accum(NumericAggState *state, const NumericVar *X,
+					  bool subtract)
+{
+	int			xrscale;
+	int128		val;
+	int			i;
+
+	if (state->calcSumX2)
+		return false;
+
+	/* # of NBASE digits of X after the decimal point */
+	xrscale = X->ndigits - X->weight - 1;
+	if (xrscale < 0)
+		xrscale = 0;
+
+	if (X->weight + 1 + Max(state->fastScale, xrscale) >
+		NUMERIC_FASTSUM_MAX_DIGITS)
+		return false;
+
+	/*
+	 * If X is wider on the right than the scale carried so far, flush the
+	 * pending sum (at its old scale) and adopt the new one, rather than
+	 * risking overflow by rescaling the pending sum in place.
+	 */
+	if (xrscale > state->fastScale)
+	{
+		numeric_fastsum_flush(state);
+		state->fastScale = xrscale;
+	}
+
+	/* compose X as an integer scaled by NBASE^fastScale */
+	val = 0;
+	for (i = 0; i < X->ndigits; i++)
+		val = val * NBASE + X->digits[i];
+	for (i = X->ndigits; i < X->weight + 1 + state->fastScale; i++)
+		val *= NBASE;
+	if ((X->sign == NUMERIC_NEG) != subtract)
+		val = -val;
+
+	/* keep the running sum comfortably clear of int128 overflow */
+	if (state->fastSumX > NUMERIC_FASTSUM_ABS_LIMIT ||
+		state->fastSumX < -NUMERIC_FASTSUM_ABS_LIMIT)
+		numeric_fastsum_flush(state);
+
+	state->fastSumX += val;
+	return true;
+}
+
+#else							/* !HAVE_INT128 */
+
+#define numeric_fastsum_flush(state)	((void) 0)
+
+#endif							/* HAVE_INT128 */
+
 /*
  * Accumulate a new input value for numeric aggregate functions.
  */
@@ -5003,6 +5116,15 @@ do_numeric_accum(NumericAggState *state, Numeric newval)
 	else if (X.dscale == state->maxScale)
 		state->maxScaleCount++;
 
+#ifdef HAVE_INT128
+	/* Try the fast path first; it handles most sum() and avg() inputs */
+	if (numeric_fastsum_accum(state, &X, false))
+	{
+		state->N++;
+		return;
+	}
+#endif
+
 	/* if we need X^2, calculate that in short-lived context */
 	if (state->calcSumX2)
 	{
@@ -5091,6 +5213,15 @@ do_numeric_discard(NumericAggState *state, Numeric newval)
 		}
 	}
 
+#ifdef HAVE_INT128
+	/* As in do_numeric_accum, try the fast path first */
+	if (state->N > 1 && numeric_fastsum_accum(state, &X, true))
+	{
+		state->N--;
+		return true;
+	}
+#endif
+
 	/* if we need X^2, calculate that in short-lived context */
 	if (state->calcSumX2)
 	{
@@ -5122,6 +5253,10 @@ do_numeric_discard(NumericAggState *state, Numeric newval)
 		accum_sum_reset(&state->sumX);
 		if (state->calcSumX2)
 			accum_sum_reset(&state->sumX2);
+#ifdef HAVE_INT128
+		state->fastSumX = 0;
+		state->fastScale = 0;
+#endif
 	}
 
 	MemoryContextSwitchTo(old_context);
@@ -5261,6 +5396,9 @@ numeric_avg_combine(PG_FUNCTION_ARGS)
 	if (state2 == NULL)
 		PG_RETURN_POINTER(state1);
 
+	/* ensure state2's value is all in its sumX before we read that */
+	numeric_fastsum_flush(state2);
+
 	/* manually copy all fields from state2 to state1 */
 	if (state1 == NULL)
 	{
@@ -5330,6 +5468,8 @@ numeric_avg_serialize(PG_FUNCTION_ARGS)
 
 	state = (NumericAggState *) PG_GETARG_POINTER(0);
 
+	numeric_fastsum_flush(state);
+
 	init_var(&tmp_var);
 
 	pq_begintypsend(&buf);
@@ -6267,6 +6407,8 @@ numeric_avg(PG_FUNCTION_ARGS)
 
 	N_datum = NumericGetDatum(int64_to_numeric(state->N));
 
+	numeric_fastsum_flush(state);
+
 	init_var(&sumX_var);
 	accum_sum_final(&state->sumX, &sumX_var);
 	sumX_datum = NumericGetDatum(make_result(&sumX_var));
@@ -6299,6 +6441,8 @@ numeric_sum(PG_FUNCTION_ARGS)
 	if (state->nInfcount > 0)
 		PG_RETURN_NUMERIC(make_result(&const_ninf));
 
+	numeric_fastsum_flush(state);
+
 	init_var(&sumX_var);
 	accum_sum_final(&state->sumX, &sumX_var);
 	result = make_result(&sumX_var);
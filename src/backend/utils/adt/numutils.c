@@ -1275,6 +1275,12 @@ pg_ultostr_zeropad(char *str, uint32 value, int32 minwidth)
 		memcpy(str, DIGIT_TABLE + value * 2, 2);
 		return str + 2;
 	}
+	if (value < 10000 && minwidth == 4) /* Zero-padded years in ISO dates */
+	{
+		memcpy(str, DIGIT_TABLE + (value / 100) * 2, 2);
+		memcpy(str + 2, DIGIT_TABLE + (value % 100) * 2, 2);
+		return str + 4;
+	}
 
 	len = pg_ultoa_n(value, str);
 	if (len >= minwidth)
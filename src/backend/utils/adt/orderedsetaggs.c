@@ -20,6 +20,7 @@
 #include "catalog/pg_operator.h"
 #include "catalog/pg_type.h"
 #include "executor/executor.h"
+#include "libpq/pqformat.h"
 #include "miscadmin.h"
 #include "nodes/nodeFuncs.h"
 #include "optimizer/optimizer.h"
@@ -1428,3 +1429,416 @@ hypothetical_dense_rank_final(PG_FUNCTION_ARGS)
 
 	PG_RETURN_INT64(rank);
 }
+
+
+/*
+ * Approximate percentile support
+ *
+ * approx_percentile(value, fraction) estimates a percentile using a t-digest
+ * sketch rather than sorting the input.  Unlike the exact percentile_cont and
+ * percentile_disc above, the transition state is small (a bounded set of
+ * centroids), mergeable, and serializable, so the aggregate can run in
+ * parallel through the regular partial-aggregate machinery.  The tradeoff is
+ * a small relative error, smallest near the tails, which is where percentile
+ * monitoring usually looks.
+ *
+ * Incoming values are collected into a buffer and periodically folded into
+ * the centroid list; a centroid's maximum weight depends on the quantile it
+ * covers, keeping the digest detailed near q=0 and q=1.
+ */
+
+#define TDIGEST_COMPRESSION		200.0
+#define TDIGEST_BUFFER_SIZE		1024
+
+typedef struct TDigestCentroid
+{
+	double		mean;
+	double		count;
+} TDigestCentroid;
+
+typedef struct TDigestAggState
+{
+	MemoryContext agg_context;	/* context the state lives in */
+	double		fraction;		/* requested percentile fraction */
+	bool		fraction_set;	/* has any row supplied it yet? */
+	double		total;			/* summed count of all centroids */
+	int			ncentroids;
+	int			maxcentroids;	/* allocated length of centroids[] */
+	TDigestCentroid *centroids; /* centroids, sorted by mean */
+	int			nbuffered;
+	double		buffer[TDIGEST_BUFFER_SIZE];	/* values not yet digested */
+} TDigestAggState;
+
+static TDigestAggState *
+tdigest_create(MemoryContext agg_context)
+{
+	TDigestAggState *state;
+
+	state = (TDigestAggState *)
+		MemoryContextAllocZero(agg_context, sizeof(TDigestAggState));
+	state->agg_context = agg_context;
+	state->maxcentroids = 64;
+	state->centroids = (TDigestCentroid *)
+		MemoryContextAlloc(agg_context,
+						   state->maxcentroids * sizeof(TDigestCentroid));
+
+	return state;
+}
+
+static int
+tdigest_cmp_double(const void *a, const void *b)
+{
+	double		da = *(const double *) a;
+	double		db = *(const double *) b;
+
+	if (da < db)
+		return -1;
+	if (da > db)
+		return 1;
+	return 0;
+}
+
+/*
+ * Merge 'nin' incoming centroids (sorted by mean) into the state's centroid
+ * list, then recompress the result under the t-digest weight limit.
+ */
+static void
+tdigest_compress(TDigestAggState *state, const TDigestCentroid *incoming,
+				 int nin)
+{
+	int			ntotal = state->ncentroids + nin;
+	TDigestCentroid *merged;
+	TDigestCentroid cur;
+	double		total = 0.0;
+	double		weight_so_far = 0.0;
+	int			i = 0,
+				j = 0,
+				k,
+				nout = 0;
+
+	if (ntotal == 0)
+		return;
+
+	/* merge the two sorted sequences */
+	merged = (TDigestCentroid *) palloc(ntotal * sizeof(TDigestCentroid));
+	for (k = 0; k < ntotal; k++)
+	{
+		if (j >= nin ||
+			(i < state->ncentroids &&
+			 state->centroids[i].mean <= incoming[j].mean))
+			merged[k] = state->centroids[i++];
+		else
+			merged[k] = incoming[j++];
+		total += merged[k].count;
+	}
+
+	/*
+	 * Recompress in place: absorb each centroid into its predecessor while
+	 * the pair stays within the weight allowed for the quantile range it
+	 * would cover.  The output never outruns the scan position.
+	 */
+	cur = merged[0];
+	for (k = 1; k < ntotal; k++)
+	{
+		double		q = (weight_so_far + (cur.count + merged[k].count) / 2.0) / total;
+		double		limit = 4.0 * total * q * (1.0 - q) / TDIGEST_COMPRESSION;
+
+		if (cur.count + merged[k].count <= limit)
+		{
+			cur.count += merged[k].count;
+			cur.mean += (merged[k].mean - cur.mean) * merged[k].count / cur.count;
+		}
+		else
+		{
+			weight_so_far += cur.count;
+			merged[nout++] = cur;
+			cur = merged[k];
+		}
+	}
+	merged[nout++] = cur;
+
+	if (nout > state->maxcentroids)
+	{
+		state->maxcentroids = nout * 2;
+		state->centroids = (TDigestCentroid *)
+			repalloc(state->centroids,
+					 state->maxcentroids * sizeof(TDigestCentroid));
+	}
+	memcpy(state->centroids, merged, nout * sizeof(TDigestCentroid));
+	state->ncentroids = nout;
+	state->total = total;
+
+	pfree(merged);
+}
+
+/*
+ * Fold any buffered raw values into the centroid list.
+ */
+static void
+tdigest_flush_buffer(TDigestAggState *state)
+{
+	TDigestCentroid *incoming;
+	int			i;
+
+	if (state->nbuffered == 0)
+		return;
+
+	qsort(state->buffer, state->nbuffered, sizeof(double),
+		  tdigest_cmp_double);
+
+	incoming = (TDigestCentroid *)
+		palloc(state->nbuffered * sizeof(TDigestCentroid));
+	for (i = 0; i < state->nbuffered; i++)
+	{
+		incoming[i].mean = state->buffer[i];
+		incoming[i].count = 1.0;
+	}
+
+	tdigest_compress(state, incoming, state->nbuffered);
+	state->nbuffered = 0;
+
+	pfree(incoming);
+}
+
+/*
+ * Estimate the value at fraction 'q' by interpolating between the cumulative
+ * midpoints of adjacent centroids.
+ */
+static double
+tdigest_quantile(TDigestAggState *state, double q)
+{
+	double		target = q * state->total;
+	double		cum = 0.0;
+	double		prev_mid;
+	double		prev_mean;
+	int			i;
+
+	Assert(state->ncentroids > 0);
+
+	if (state->ncentroids == 1)
+		return state->centroids[0].mean;
+
+	prev_mid = state->centroids[0].count / 2.0;
+	prev_mean = state->centroids[0].mean;
+	if (target <= prev_mid)
+		return prev_mean;
+
+	for (i = 1; i < state->ncentroids; i++)
+	{
+		double		mid;
+
+		cum += state->centroids[i - 1].count;
+		mid = cum + state->centroids[i].count / 2.0;
+		if (target <= mid)
+		{
+			if (mid <= prev_mid)
+				return state->centroids[i].mean;
+			return prev_mean +
+				(target - prev_mid) *
+				(state->centroids[i].mean - prev_mean) / (mid - prev_mid);
+		}
+		prev_mid = mid;
+		prev_mean = state->centroids[i].mean;
+	}
+
+	return state->centroids[state->ncentroids - 1].mean;
+}
+
+/*
+ * Record the percentile fraction requested by a row, insisting that it's the
+ * same for every row of the group.
+ */
+static void
+tdigest_set_fraction(TDigestAggState *state, double fraction)
+{
+	if (fraction < 0.0 || fraction > 1.0 || isnan(fraction))
+		ereport(ERROR,
+				(errcode(ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE),
+				 errmsg("percentile value %g is not between 0 and 1",
+						fraction)));
+	if (state->fraction_set && fraction != state->fraction)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("percentile fraction must be the same for all rows")));
+	state->fraction = fraction;
+	state->fraction_set = true;
+}
+
+/*
+ * Transition function for approx_percentile(float8, float8)
+ */
+Datum
+approx_percentile_transfn(PG_FUNCTION_ARGS)
+{
+	TDigestAggState *state;
+	MemoryContext agg_context;
+
+	if (!AggCheckCallContext(fcinfo, &agg_context))
+		elog(ERROR, "aggregate function called in non-aggregate context");
+
+	state = PG_ARGISNULL(0) ? NULL : (TDigestAggState *) PG_GETARG_POINTER(0);
+	if (state == NULL)
+		state = tdigest_create(agg_context);
+
+	if (!PG_ARGISNULL(2))
+		tdigest_set_fraction(state, PG_GETARG_FLOAT8(2));
+
+	if (!PG_ARGISNULL(1))
+	{
+		double		value = PG_GETARG_FLOAT8(1);
+
+		/* the sketch's weighted means can't represent these */
+		if (isnan(value) || isinf(value))
+			ereport(ERROR,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("NaN and infinity input values are not supported by approx_percentile")));
+
+		state->buffer[state->nbuffered++] = value;
+		if (state->nbuffered >= TDIGEST_BUFFER_SIZE)
+			tdigest_flush_buffer(state);
+	}
+
+	PG_RETURN_POINTER(state);
+}
+
+/*
+ * Combine function for approx_percentile - merges the second digest into the
+ * first.
+ */
+Datum
+approx_percentile_combinefn(PG_FUNCTION_ARGS)
+{
+	TDigestAggState *state1;
+	TDigestAggState *state2;
+	MemoryContext agg_context;
+
+	if (!AggCheckCallContext(fcinfo, &agg_context))
+		elog(ERROR, "aggregate function called in non-aggregate context");
+
+	state1 = PG_ARGISNULL(0) ? NULL : (TDigestAggState *) PG_GETARG_POINTER(0);
+	state2 = PG_ARGISNULL(1) ? NULL : (TDigestAggState *) PG_GETARG_POINTER(1);
+
+	if (state2 == NULL)
+	{
+		if (state1 == NULL)
+			PG_RETURN_NULL();
+		PG_RETURN_POINTER(state1);
+	}
+	if (state1 == NULL)
+		state1 = tdigest_create(agg_context);
+
+	if (state2->fraction_set)
+		tdigest_set_fraction(state1, state2->fraction);
+
+	tdigest_flush_buffer(state2);
+	tdigest_compress(state1, state2->centroids, state2->ncentroids);
+
+	PG_RETURN_POINTER(state1);
+}
+
+/*
+ * Serialize function for approx_percentile
+ */
+Datum
+approx_percentile_serialfn(PG_FUNCTION_ARGS)
+{
+	TDigestAggState *state;
+	StringInfoData buf;
+	bytea	   *result;
+	int			i;
+
+	/* Ensure we disallow calling when not in aggregate context */
+	if (!AggCheckCallContext(fcinfo, NULL))
+		elog(ERROR, "aggregate function called in non-aggregate context");
+
+	state = (TDigestAggState *) PG_GETARG_POINTER(0);
+
+	/* fold buffered values in, so we only transmit centroids */
+	tdigest_flush_buffer(state);
+
+	pq_begintypsend(&buf);
+	pq_sendbyte(&buf, state->fraction_set ? 1 : 0);
+	pq_sendfloat8(&buf, state->fraction);
+	pq_sendint32(&buf, state->ncentroids);
+	for (i = 0; i < state->ncentroids; i++)
+	{
+		pq_sendfloat8(&buf, state->centroids[i].mean);
+		pq_sendfloat8(&buf, state->centroids[i].count);
+	}
+
+	result = pq_endtypsend(&buf);
+
+	PG_RETURN_BYTEA_P(result);
+}
+
+/*
+ * Deserialize function for approx_percentile
+ */
+Datum
+approx_percentile_deserialfn(PG_FUNCTION_ARGS)
+{
+	bytea	   *sstate;
+	TDigestAggState *state;
+	StringInfoData buf;
+	MemoryContext agg_context;
+	int			ncentroids;
+	int			i;
+
+	if (!AggCheckCallContext(fcinfo, &agg_context))
+		elog(ERROR, "aggregate function called in non-aggregate context");
+
+	sstate = PG_GETARG_BYTEA_PP(0);
+
+	/*
+	 * Initialize a StringInfo so that we can "receive" it using the standard
+	 * recv-function infrastructure.
+	 */
+	initReadOnlyStringInfo(&buf, VARDATA_ANY(sstate),
+						   VARSIZE_ANY_EXHDR(sstate));
+
+	state = tdigest_create(agg_context);
+	state->fraction_set = (pq_getmsgbyte(&buf) != 0);
+	state->fraction = pq_getmsgfloat8(&buf);
+	ncentroids = pq_getmsgint(&buf, 4);
+	if (ncentroids > state->maxcentroids)
+	{
+		state->maxcentroids = ncentroids;
+		state->centroids = (TDigestCentroid *)
+			repalloc(state->centroids,
+					 state->maxcentroids * sizeof(TDigestCentroid));
+	}
+	for (i = 0; i < ncentroids; i++)
+	{
+		state->centroids[i].mean = pq_getmsgfloat8(&buf);
+		state->centroids[i].count = pq_getmsgfloat8(&buf);
+		state->total += state->centroids[i].count;
+	}
+	state->ncentroids = ncentroids;
+
+	pq_getmsgend(&buf);
+
+	PG_RETURN_POINTER(state);
+}
+
+/*
+ * Final function for approx_percentile
+ */
+Datum
+approx_percentile_finalfn(PG_FUNCTION_ARGS)
+{
+	TDigestAggState *state;
+
+	if (!AggCheckCallContext(fcinfo, NULL))
+		elog(ERROR, "aggregate function called in non-aggregate context");
+
+	state = PG_ARGISNULL(0) ? NULL : (TDigestAggState *) PG_GETARG_POINTER(0);
+
+	if (state == NULL || !state->fraction_set)
+		PG_RETURN_NULL();
+
+	tdigest_flush_buffer(state);
+	if (state->ncentroids == 0)
+		PG_RETURN_NULL();
+
+	PG_RETURN_FLOAT8(tdigest_quantile(state, state->fraction));
+}
@@ -17,6 +17,7 @@
 #include "utils/fmgrprotos.h"
 #include "utils/numeric.h"
 #include "utils/pg_lsn.h"
+#include "utils/skipsupport.h"
 
 #define MAXPG_LSNLEN			17
 #define MAXPG_LSNCOMPONENT	8
@@ -201,6 +202,51 @@ pg_lsn_cmp(PG_FUNCTION_ARGS)
 		PG_RETURN_INT32(-1);
 }
 
+static Datum
+pg_lsn_decrement(Relation rel, Datum existing, bool *underflow)
+{
+	XLogRecPtr	lexisting = DatumGetLSN(existing);
+
+	if (lexisting == 0)
+	{
+		/* return value is undefined */
+		*underflow = true;
+		return (Datum) 0;
+	}
+
+	*underflow = false;
+	return LSNGetDatum(lexisting - 1);
+}
+
+static Datum
+pg_lsn_increment(Relation rel, Datum existing, bool *overflow)
+{
+	XLogRecPtr	lexisting = DatumGetLSN(existing);
+
+	if (lexisting == PG_UINT64_MAX)
+	{
+		/* return value is undefined */
+		*overflow = true;
+		return (Datum) 0;
+	}
+
+	*overflow = false;
+	return LSNGetDatum(lexisting + 1);
+}
+
+Datum
+pg_lsn_skipsupport(PG_FUNCTION_ARGS)
+{
+	SkipSupport sksup = (SkipSupport) PG_GETARG_POINTER(0);
+
+	sksup->decrement = pg_lsn_decrement;
+	sksup->increment = pg_lsn_increment;
+	sksup->low_elem = LSNGetDatum(0);
+	sksup->high_elem = LSNGetDatum(PG_UINT64_MAX);
+
+	PG_RETURN_VOID();
+}
+
 /* hash index opclass support */
 Datum
 pg_lsn_hash(PG_FUNCTION_ARGS)
@@ -1258,6 +1258,12 @@ pg_stat_get_checkpointer_slru_written(PG_FUNCTION_ARGS)
 	PG_RETURN_INT64(pgstat_fetch_stat_checkpointer()->slru_written);
 }
 
+Datum
+pg_stat_get_bgwriter_buf_scanned_clean(PG_FUNCTION_ARGS)
+{
+	PG_RETURN_INT64(pgstat_fetch_stat_bgwriter()->buf_scanned_clean);
+}
+
 Datum
 pg_stat_get_bgwriter_buf_written_clean(PG_FUNCTION_ARGS)
 {
@@ -175,14 +175,46 @@ typedef struct RI_CompareHashEntry
 } RI_CompareHashEntry;
 
 
+/*
+ * RI_LastCheckedKey
+ *
+ * Remembers, per constraint, the FK key most recently verified to exist in
+ * the PK table, so that subsequent checks of an identical key within the
+ * same command can skip the SPI probe.  This is safe because the row found
+ * by the earlier check is still locked by our FOR KEY SHARE: the lock is
+ * only released by (sub)transaction end, and our own transaction cannot
+ * have deleted the row without starting a new command.  Accordingly, an
+ * entry is only trusted while both the command counter and the
+ * (sub)transaction-event generation counter are unchanged.
+ *
+ * Key values are compared with datumIsEqual; a false negative just means we
+ * redo the full check.  Non-byval values are copied into TopMemoryContext
+ * and freed when the entry is replaced.
+ */
+typedef struct RI_LastCheckedKey
+{
+	Oid			constraint_id;	/* OID of pg_constraint entry (hash key) */
+	bool		valid;			/* successfully initialized? */
+	CommandId	cid;			/* command the key was checked in */
+	uint64		generation;		/* ri_key_cache_generation at check time */
+	int			nkeys;			/* number of stored key values */
+	Datum		keys[RI_MAX_NUMKEYS];	/* the checked FK key values */
+	int16		typlen[RI_MAX_NUMKEYS];
+	bool		typbyval[RI_MAX_NUMKEYS];
+} RI_LastCheckedKey;
+
 /*
  * Local data
  */
 static HTAB *ri_constraint_cache = NULL;
 static HTAB *ri_query_cache = NULL;
 static HTAB *ri_compare_cache = NULL;
+static HTAB *ri_checked_key_cache = NULL;
 static dclist_head ri_constraint_cache_valid_list;
 
+/* bumped on any transaction or subtransaction event, see above */
+static uint64 ri_key_cache_generation = 0;
+
 
 /*
  * Local function prototypes
@@ -212,6 +244,14 @@ static bool ri_CompareWithCast(Oid eq_opr, Oid typeid, Oid collid,
 
 static void ri_InitHashTables(void);
 static void InvalidateConstraintCacheCallBack(Datum arg, int cacheid, uint32 hashvalue);
+static void RIKeyCacheXactCallback(XactEvent event, void *arg);
+static void RIKeyCacheSubXactCallback(SubXactEvent event,
+									  SubTransactionId mySubid,
+									  SubTransactionId parentSubid, void *arg);
+static bool ri_KeyAlreadyChecked(const RI_ConstraintInfo *riinfo,
+								 TupleTableSlot *newslot);
+static void ri_RememberCheckedKey(const RI_ConstraintInfo *riinfo,
+								  Relation fk_rel, TupleTableSlot *newslot);
 static SPIPlanPtr ri_FetchPreparedPlan(RI_QueryKey *key);
 static void ri_HashPreparedPlan(RI_QueryKey *key, SPIPlanPtr plan);
 static RI_CompareHashEntry *ri_HashCompareOp(Oid eq_opr, Oid typeid);
@@ -349,6 +389,18 @@ RI_FKey_check(TriggerData *trigdata)
 			break;
 	}
 
+	/*
+	 * If this command already verified the identical key against the PK
+	 * table, the row found then is still locked by our FOR KEY SHARE and
+	 * cannot have gone away, so the check can be skipped.  This saves the
+	 * SPI overhead in bulk loads that insert many rows with the same key.
+	 */
+	if (ri_KeyAlreadyChecked(riinfo, newslot))
+	{
+		table_close(pk_rel, RowShareLock);
+		return PointerGetDatum(NULL);
+	}
+
 	SPI_connect();
 
 	/* Fetch or prepare a saved plan for the real check */
@@ -457,6 +509,9 @@ RI_FKey_check(TriggerData *trigdata)
 	if (SPI_finish() != SPI_OK_FINISH)
 		elog(ERROR, "SPI_finish failed");
 
+	/* the check succeeded, so remember the key for subsequent rows */
+	ri_RememberCheckedKey(riinfo, fk_rel, newslot);
+
 	table_close(pk_rel, RowShareLock);
 
 	return PointerGetDatum(NULL);
@@ -2881,6 +2936,136 @@ ri_InitHashTables(void)
 	ri_compare_cache = hash_create("RI compare cache",
 								   RI_INIT_QUERYHASHSIZE,
 								   &ctl, HASH_ELEM | HASH_BLOBS);
+
+	ctl.keysize = sizeof(Oid);
+	ctl.entrysize = sizeof(RI_LastCheckedKey);
+	ri_checked_key_cache = hash_create("RI checked key cache",
+									   RI_INIT_CONSTRAINTHASHSIZE,
+									   &ctl, HASH_ELEM | HASH_BLOBS);
+
+	/* Arrange to distrust checked-key entries across (sub)xact events */
+	RegisterXactCallback(RIKeyCacheXactCallback, NULL);
+	RegisterSubXactCallback(RIKeyCacheSubXactCallback, NULL);
+}
+
+/*
+ * Transaction-event callbacks for the checked-key cache.
+ *
+ * Any transaction or subtransaction event might release FOR KEY SHARE locks
+ * taken by earlier checks (most notably subtransaction abort), so bump the
+ * generation counter unconditionally; that is cheap and invalidates all
+ * cached keys.
+ */
+static void
+RIKeyCacheXactCallback(XactEvent event, void *arg)
+{
+	ri_key_cache_generation++;
+}
+
+static void
+RIKeyCacheSubXactCallback(SubXactEvent event, SubTransactionId mySubid,
+						  SubTransactionId parentSubid, void *arg)
+{
+	ri_key_cache_generation++;
+}
+
+/*
+ * ri_KeyAlreadyChecked -
+ *
+ * Return true if the FK key in newslot is identical to the key most
+ * recently verified for this constraint within the current command.
+ */
+static bool
+ri_KeyAlreadyChecked(const RI_ConstraintInfo *riinfo, TupleTableSlot *newslot)
+{
+	RI_LastCheckedKey *entry;
+
+	/* Be conservative about temporal FKs; they don't use plain equality */
+	if (riinfo->hasperiod)
+		return false;
+
+	if (!ri_checked_key_cache)
+		ri_InitHashTables();
+
+	entry = (RI_LastCheckedKey *) hash_search(ri_checked_key_cache,
+											  &riinfo->constraint_id,
+											  HASH_FIND, NULL);
+	if (entry == NULL || !entry->valid)
+		return false;
+
+	if (entry->generation != ri_key_cache_generation ||
+		entry->cid != GetCurrentCommandId(false) ||
+		entry->nkeys != riinfo->nkeys)
+		return false;
+
+	for (int i = 0; i < riinfo->nkeys; i++)
+	{
+		Datum		value;
+		bool		isnull;
+
+		value = slot_getattr(newslot, riinfo->fk_attnums[i], &isnull);
+		if (isnull ||
+			!datumIsEqual(entry->keys[i], value,
+						  entry->typbyval[i], entry->typlen[i]))
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * ri_RememberCheckedKey -
+ *
+ * Record the FK key in newslot as verified for this constraint, replacing
+ * any previously remembered key.
+ */
+static void
+ri_RememberCheckedKey(const RI_ConstraintInfo *riinfo, Relation fk_rel,
+					  TupleTableSlot *newslot)
+{
+	RI_LastCheckedKey *entry;
+	bool		found;
+	TupleDesc	tupdesc = RelationGetDescr(fk_rel);
+	MemoryContext oldcxt;
+
+	if (riinfo->hasperiod)
+		return;
+
+	entry = (RI_LastCheckedKey *) hash_search(ri_checked_key_cache,
+											  &riinfo->constraint_id,
+											  HASH_ENTER, &found);
+	if (!found)
+		entry->nkeys = 0;
+
+	/* release storage of the previous key values, if any */
+	for (int i = 0; i < entry->nkeys; i++)
+	{
+		if (!entry->typbyval[i])
+			pfree(DatumGetPointer(entry->keys[i]));
+	}
+	entry->valid = false;
+	entry->nkeys = 0;
+
+	oldcxt = MemoryContextSwitchTo(TopMemoryContext);
+	for (int i = 0; i < riinfo->nkeys; i++)
+	{
+		Form_pg_attribute att = TupleDescAttr(tupdesc,
+											  riinfo->fk_attnums[i] - 1);
+		Datum		value;
+		bool		isnull;
+
+		value = slot_getattr(newslot, riinfo->fk_attnums[i], &isnull);
+		Assert(!isnull);
+		entry->typlen[i] = att->attlen;
+		entry->typbyval[i] = att->attbyval;
+		entry->keys[i] = datumCopy(value, att->attbyval, att->attlen);
+		entry->nkeys = i + 1;
+	}
+	MemoryContextSwitchTo(oldcxt);
+
+	entry->cid = GetCurrentCommandId(false);
+	entry->generation = ri_key_cache_generation;
+	entry->valid = true;
 }
 
 
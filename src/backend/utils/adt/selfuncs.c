@@ -6468,6 +6468,20 @@ get_stats_slot_range(AttStatsSlot *sslot, Oid opfuncoid, FmgrInfo *opproc,
  *
  * sortop is the "<" comparison operator to use.
  * collation is the required collation.
+ *
+ * This probe is our mechanism for keeping boundary estimates fresh between
+ * ANALYZE runs: on high-churn tables the histogram endpoints go stale
+ * almost immediately, and reading the live extremes from the index at plan
+ * time corrects the estimates that are most sensitive to that staleness.
+ * The alternative of maintaining summary statistics (distinct sketches,
+ * boundary values) from the btree insert and delete paths has been
+ * considered and rejected: it would add a contended shared structure and
+ * WAL traffic to every index write to benefit only the occasional plan,
+ * whereas probing here charges the cost to the planning cycle that needs
+ * the numbers.  Estimates that don't depend on boundary values already
+ * degrade gracefully: estimate_rel_size() rescales tuple density by the
+ * relation's actual size in blocks, and ndistinct recorded as a fraction
+ * of the row count (negative stadistinct) scales with it.
  */
 static bool
 get_actual_variable_range(PlannerInfo *root, VariableStatData *vardata,
@@ -637,20 +637,27 @@ CatCacheInvalidate(CatCache *cache, uint32 hashValue)
 
 	/*
 	 * Invalidate *all* CatCLists in this cache; it's too hard to tell which
-	 * searches might still be correct, so just zap 'em all.
+	 * searches might still be correct, so just zap 'em all.  If the cache
+	 * holds no lists we can skip the bucket sweep altogether; that matters
+	 * during invalidation storms, where the first message empties the list
+	 * buckets and each of the (possibly many thousand) messages that follow
+	 * would otherwise rescan them for nothing.
 	 */
-	for (int i = 0; i < cache->cc_nlbuckets; i++)
+	if (cache->cc_nlist > 0)
 	{
-		dlist_head *bucket = &cache->cc_lbucket[i];
-
-		dlist_foreach_modify(iter, bucket)
+		for (int i = 0; i < cache->cc_nlbuckets; i++)
 		{
-			CatCList   *cl = dlist_container(CatCList, cache_elem, iter.cur);
+			dlist_head *bucket = &cache->cc_lbucket[i];
 
-			if (cl->refcount > 0)
-				cl->dead = true;
-			else
-				CatCacheRemoveCList(cache, cl);
+			dlist_foreach_modify(iter, bucket)
+			{
+				CatCList   *cl = dlist_container(CatCList, cache_elem, iter.cur);
+
+				if (cl->refcount > 0)
+					cl->dead = true;
+				else
+					CatCacheRemoveCList(cache, cl);
+			}
 		}
 	}
 
@@ -1437,12 +1444,12 @@ SearchCatCacheInternal(CatCache *cache,
 	{
 		ct = dlist_container(CatCTup, cache_elem, iter.cur);
 
-		if (ct->dead)
-			continue;			/* ignore dead entries */
-
 		if (ct->hash_value != hashValue)
 			continue;			/* quickly skip entry if wrong hash val */
 
+		if (ct->dead)
+			continue;			/* ignore dead entries */
+
 		if (!CatalogCacheCompareTuple(cache, nkeys, ct->keys, arguments))
 			continue;
 
@@ -1801,12 +1808,12 @@ SearchCatCacheList(CatCache *cache,
 	{
 		cl = dlist_container(CatCList, cache_elem, iter.cur);
 
-		if (cl->dead)
-			continue;			/* ignore dead entries */
-
 		if (cl->hash_value != lHashValue)
 			continue;			/* quickly skip entry if wrong hash val */
 
+		if (cl->dead)
+			continue;			/* ignore dead entries */
+
 		/*
 		 * see if the cached list matches our key.
 		 */
@@ -43,6 +43,15 @@
  * bare-bones; it's the caller's responsibility to build a new expression
  * if the old one gets invalidated.
  *
+ * A recurring idea is to reuse this dependency tracking to cache query
+ * *results*, not just plans.  That cannot work: sinval events are emitted
+ * for catalog changes that affect parsing or planning, not for ordinary
+ * data modification, so a result cache invalidated off relationOids would
+ * keep returning stale rows after any other backend's committed DML.
+ * Result caching needs its own data-change signal (e.g. triggers feeding an
+ * extension that intercepts execution via the executor hooks); it is not
+ * something the plan cache's machinery can provide.
+ *
  *
  * Portions Copyright (c) 1996-2025, PostgreSQL Global Development Group
  * Portions Copyright (c) 1994, Regents of the University of California
@@ -240,6 +249,8 @@ CreateCachedPlan(RawStmt *raw_parse_tree,
 	plansource->generation = 0;
 	plansource->generic_cost = -1;
 	plansource->total_custom_cost = 0;
+	plansource->min_custom_cost = 0;
+	plansource->max_custom_cost = 0;
 	plansource->num_generic_plans = 0;
 	plansource->num_custom_plans = 0;
 
@@ -339,6 +350,8 @@ CreateOneShotCachedPlan(RawStmt *raw_parse_tree,
 	plansource->generation = 0;
 	plansource->generic_cost = -1;
 	plansource->total_custom_cost = 0;
+	plansource->min_custom_cost = 0;
+	plansource->max_custom_cost = 0;
 	plansource->num_generic_plans = 0;
 	plansource->num_custom_plans = 0;
 
@@ -1140,6 +1153,7 @@ BuildCachedPlan(CachedPlanSource *plansource, List *qlist,
 	plan->is_oneshot = plansource->is_oneshot;
 	plan->is_saved = false;
 	plan->is_valid = true;
+	plan->result_outinfo = NULL;
 
 	/* assign generation number to new plan */
 	plan->generation = ++(plansource->generation);
@@ -1188,6 +1202,26 @@ choose_custom_plan(CachedPlanSource *plansource, ParamListInfo boundParams)
 
 	avg_custom_cost = plansource->total_custom_cost / plansource->num_custom_plans;
 
+	/*
+	 * If the costs of the custom plans we've seen span a very wide range, the
+	 * workload is evidently heterogeneous: the parameter values fall into
+	 * regimes with hugely different amounts of work (consider a filter on a
+	 * tenant column where tenant sizes vary by orders of magnitude).  An
+	 * average over such a range is not a useful yardstick: a generic plan
+	 * that beats the average can still be catastrophic for the expensive
+	 * parameter values, which dominate total execution time.  So keep making
+	 * custom plans, unless the generic plan undercuts even the cheapest
+	 * custom plan seen, in which case it's safe for every regime.  The
+	 * cutoff of 100x is arbitrary, but a spread that large means replanning
+	 * cost is trivial next to the cost of running the wrong plan.
+	 *
+	 * This test never fires while generic_cost is -1 (not yet known), so we
+	 * still build the generic plan once to learn its cost.
+	 */
+	if (plansource->max_custom_cost > 100 * plansource->min_custom_cost &&
+		plansource->generic_cost >= plansource->min_custom_cost)
+		return true;
+
 	/*
 	 * Prefer generic plan if it's less expensive than the average custom
 	 * plan.  (Because we include a charge for cost of planning in the
@@ -1352,10 +1386,18 @@ GetCachedPlan(CachedPlanSource *plansource, ParamListInfo boundParams,
 
 	if (customplan)
 	{
+		double		custom_cost;
+
 		/* Build a custom plan */
 		plan = BuildCachedPlan(plansource, qlist, boundParams, queryEnv);
-		/* Accumulate total costs of custom plans */
-		plansource->total_custom_cost += cached_plan_cost(plan, true);
+		/* Accumulate total costs of custom plans, and track their spread */
+		custom_cost = cached_plan_cost(plan, true);
+		plansource->total_custom_cost += custom_cost;
+		if (plansource->num_custom_plans == 0 ||
+			custom_cost < plansource->min_custom_cost)
+			plansource->min_custom_cost = custom_cost;
+		if (custom_cost > plansource->max_custom_cost)
+			plansource->max_custom_cost = custom_cost;
 
 		plansource->num_custom_plans++;
 	}
@@ -1722,6 +1764,8 @@ CopyCachedPlan(CachedPlanSource *plansource)
 	/* We may as well copy any acquired cost knowledge */
 	newsource->generic_cost = plansource->generic_cost;
 	newsource->total_custom_cost = plansource->total_custom_cost;
+	newsource->min_custom_cost = plansource->min_custom_cost;
+	newsource->max_custom_cost = plansource->max_custom_cost;
 	newsource->num_generic_plans = plansource->num_generic_plans;
 	newsource->num_custom_plans = plansource->num_custom_plans;
 
@@ -6151,6 +6151,22 @@ errtableconstraint(Relation rel, const char *conname)
  *		need to be invalidated (due to catalog updates) also arranges to
  *		unlink the initialization files when the contents may be out of date.
  *		The files will then be rebuilt during the next backend startup.
+ *
+ *		It is tempting to go further still and keep relcache entries (or at
+ *		least their immutable parts, such as tuple descriptors) in shared
+ *		memory, so that new backends need not deserialize anything at all.
+ *		That has been investigated several times and founders on
+ *		invalidation: RelationData is full of pointers into
+ *		backend-private structures (index support info, partition
+ *		descriptors, rules and policies), reference counting assumes
+ *		process-local lifetimes, and a shared entry could not be swapped
+ *		out from under a backend holding a refcount without a
+ *		copy-on-invalidate protocol whose bookkeeping would cost more than
+ *		it saves in the common case.  The init files plus sinval-driven
+ *		unlinking give most of the startup benefit for the catalogs, which
+ *		is where it matters; user relations are deliberately excluded (see
+ *		RelationIdIsInInitFile) so that a relcache inval can always
+ *		invalidate the file that might contain the stale entry.
  */
 
 /*
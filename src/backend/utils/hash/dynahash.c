@@ -157,6 +157,20 @@ typedef struct
 	HASHELEMENT *freeList;		/* chain of free elements */
 } FreeListData;
 
+/*
+ * Pad each freelist out to a full cache line.  FreeListData is small enough
+ * that several freelists would otherwise share a line, and in heavily
+ * contended partitioned tables (notably the shared buffer mapping table) the
+ * constant nentries updates then bounce the neighboring freelists' mutexes
+ * between sockets.  The cost is a little over a kilobyte per hash table,
+ * which is noise compared to the table proper.
+ */
+typedef union
+{
+	FreeListData l;
+	char		pad[PG_CACHE_LINE_SIZE];
+} FreeListPadded;
+
 /*
  * Header structure for a hash table --- contains all changeable info
  *
@@ -177,7 +191,7 @@ struct HASHHDR
 	 * If the hash table is not partitioned, only freeList[0] is used and its
 	 * spinlock is not used at all; callers' locking is assumed sufficient.
 	 */
-	FreeListData freeList[NUM_FREELISTS];
+	FreeListPadded freeList[NUM_FREELISTS];
 
 	/* These fields can change, but not in a partitioned table */
 	/* Also, dsize can't change in a shared table, even if unpartitioned */
@@ -700,7 +714,7 @@ init_htab(HTAB *hashp, long nelem)
 	 */
 	if (IS_PARTITIONED(hctl))
 		for (i = 0; i < NUM_FREELISTS; i++)
-			SpinLockInit(&(hctl->freeList[i].mutex));
+			SpinLockInit(&(hctl->freeList[i].l.mutex));
 
 	/*
 	 * Allocate space for the next greater power of two number of buckets,
@@ -998,7 +1012,7 @@ hash_search_with_hash_value(HTAB *hashp,
 		 * Can't split if running in partitioned mode, nor if frozen, nor if
 		 * table is the subject of any active hash_seq_search scans.
 		 */
-		if (hctl->freeList[0].nentries > (long) hctl->max_bucket &&
+		if (hctl->freeList[0].l.nentries > (long) hctl->max_bucket &&
 			!IS_PARTITIONED(hctl) && !hashp->frozen &&
 			!has_seq_scans(hashp))
 			(void) expand_table(hashp);
@@ -1047,21 +1061,21 @@ hash_search_with_hash_value(HTAB *hashp,
 			{
 				/* if partitioned, must lock to touch nentries and freeList */
 				if (IS_PARTITIONED(hctl))
-					SpinLockAcquire(&(hctl->freeList[freelist_idx].mutex));
+					SpinLockAcquire(&(hctl->freeList[freelist_idx].l.mutex));
 
 				/* delete the record from the appropriate nentries counter. */
-				Assert(hctl->freeList[freelist_idx].nentries > 0);
-				hctl->freeList[freelist_idx].nentries--;
+				Assert(hctl->freeList[freelist_idx].l.nentries > 0);
+				hctl->freeList[freelist_idx].l.nentries--;
 
 				/* remove record from hash bucket's chain. */
 				*prevBucketPtr = currBucket->link;
 
 				/* add the record to the appropriate freelist. */
-				currBucket->link = hctl->freeList[freelist_idx].freeList;
-				hctl->freeList[freelist_idx].freeList = currBucket;
+				currBucket->link = hctl->freeList[freelist_idx].l.freeList;
+				hctl->freeList[freelist_idx].l.freeList = currBucket;
 
 				if (IS_PARTITIONED(hctl))
-					SpinLockRelease(&hctl->freeList[freelist_idx].mutex);
+					SpinLockRelease(&hctl->freeList[freelist_idx].l.mutex);
 
 				/*
 				 * better hope the caller is synchronizing access to this
@@ -1263,16 +1277,16 @@ get_hash_entry(HTAB *hashp, int freelist_idx)
 	{
 		/* if partitioned, must lock to touch nentries and freeList */
 		if (IS_PARTITIONED(hctl))
-			SpinLockAcquire(&hctl->freeList[freelist_idx].mutex);
+			SpinLockAcquire(&hctl->freeList[freelist_idx].l.mutex);
 
 		/* try to get an entry from the freelist */
-		newElement = hctl->freeList[freelist_idx].freeList;
+		newElement = hctl->freeList[freelist_idx].l.freeList;
 
 		if (newElement != NULL)
 			break;
 
 		if (IS_PARTITIONED(hctl))
-			SpinLockRelease(&hctl->freeList[freelist_idx].mutex);
+			SpinLockRelease(&hctl->freeList[freelist_idx].l.mutex);
 
 		/*
 		 * No free elements in this freelist.  In a partitioned table, there
@@ -1301,23 +1315,23 @@ get_hash_entry(HTAB *hashp, int freelist_idx)
 				if (borrow_from_idx == freelist_idx)
 					break;		/* examined all freelists, fail */
 
-				SpinLockAcquire(&(hctl->freeList[borrow_from_idx].mutex));
-				newElement = hctl->freeList[borrow_from_idx].freeList;
+				SpinLockAcquire(&(hctl->freeList[borrow_from_idx].l.mutex));
+				newElement = hctl->freeList[borrow_from_idx].l.freeList;
 
 				if (newElement != NULL)
 				{
-					hctl->freeList[borrow_from_idx].freeList = newElement->link;
-					SpinLockRelease(&(hctl->freeList[borrow_from_idx].mutex));
+					hctl->freeList[borrow_from_idx].l.freeList = newElement->link;
+					SpinLockRelease(&(hctl->freeList[borrow_from_idx].l.mutex));
 
 					/* careful: count the new element in its proper freelist */
-					SpinLockAcquire(&hctl->freeList[freelist_idx].mutex);
-					hctl->freeList[freelist_idx].nentries++;
-					SpinLockRelease(&hctl->freeList[freelist_idx].mutex);
+					SpinLockAcquire(&hctl->freeList[freelist_idx].l.mutex);
+					hctl->freeList[freelist_idx].l.nentries++;
+					SpinLockRelease(&hctl->freeList[freelist_idx].l.mutex);
 
 					return newElement;
 				}
 
-				SpinLockRelease(&(hctl->freeList[borrow_from_idx].mutex));
+				SpinLockRelease(&(hctl->freeList[borrow_from_idx].l.mutex));
 			}
 
 			/* no elements available to borrow either, so out of memory */
@@ -1326,11 +1340,11 @@ get_hash_entry(HTAB *hashp, int freelist_idx)
 	}
 
 	/* remove entry from freelist, bump nentries */
-	hctl->freeList[freelist_idx].freeList = newElement->link;
-	hctl->freeList[freelist_idx].nentries++;
+	hctl->freeList[freelist_idx].l.freeList = newElement->link;
+	hctl->freeList[freelist_idx].l.nentries++;
 
 	if (IS_PARTITIONED(hctl))
-		SpinLockRelease(&hctl->freeList[freelist_idx].mutex);
+		SpinLockRelease(&hctl->freeList[freelist_idx].l.mutex);
 
 	return newElement;
 }
@@ -1342,7 +1356,7 @@ long
 hash_get_num_entries(HTAB *hashp)
 {
 	int			i;
-	long		sum = hashp->hctl->freeList[0].nentries;
+	long		sum = hashp->hctl->freeList[0].l.nentries;
 
 	/*
 	 * We currently don't bother with acquiring the mutexes; it's only
@@ -1352,7 +1366,7 @@ hash_get_num_entries(HTAB *hashp)
 	if (IS_PARTITIONED(hashp->hctl))
 	{
 		for (i = 1; i < NUM_FREELISTS; i++)
-			sum += hashp->hctl->freeList[i].nentries;
+			sum += hashp->hctl->freeList[i].l.nentries;
 	}
 
 	return sum;
@@ -1737,14 +1751,14 @@ element_alloc(HTAB *hashp, int nelem, int freelist_idx)
 
 	/* if partitioned, must lock to touch freeList */
 	if (IS_PARTITIONED(hctl))
-		SpinLockAcquire(&hctl->freeList[freelist_idx].mutex);
+		SpinLockAcquire(&hctl->freeList[freelist_idx].l.mutex);
 
 	/* freelist could be nonempty if two backends did this concurrently */
-	firstElement->link = hctl->freeList[freelist_idx].freeList;
-	hctl->freeList[freelist_idx].freeList = prevElement;
+	firstElement->link = hctl->freeList[freelist_idx].l.freeList;
+	hctl->freeList[freelist_idx].l.freeList = prevElement;
 
 	if (IS_PARTITIONED(hctl))
-		SpinLockRelease(&hctl->freeList[freelist_idx].mutex);
+		SpinLockRelease(&hctl->freeList[freelist_idx].l.mutex);
 
 	return true;
 }
@@ -148,6 +148,8 @@ int			MaxBackends = 0;
 /* GUC parameters for vacuum */
 int			VacuumBufferUsageLimit = 2048;
 
+int			BulkReadBufferUsageLimit = -1;
+
 int			VacuumCostPageHit = 1;
 int			VacuumCostPageMiss = 2;
 int			VacuumCostPageDirty = 20;
@@ -50,6 +50,7 @@
 #include "commands/vacuum.h"
 #include "common/file_utils.h"
 #include "common/scram-common.h"
+#include "executor/instrument.h"
 #include "jit/jit.h"
 #include "libpq/auth.h"
 #include "libpq/libpq.h"
@@ -100,6 +101,7 @@
 #include "utils/plancache.h"
 #include "utils/ps_status.h"
 #include "utils/rls.h"
+#include "utils/wait_event.h"
 #include "utils/xml.h"
 
 #ifdef TRACE_SYNCSCAN
@@ -1095,6 +1097,16 @@ struct config_bool ConfigureNamesBool[] =
 		false,
 		NULL, NULL, NULL
 	},
+	{
+		{"dsm_huge_pages", PGC_SIGHUP, RESOURCES_MEM,
+			gettext_noop("Requests transparent huge pages for dynamic shared memory segments."),
+			gettext_noop("This is a best-effort request and has no effect on platforms "
+						 "lacking transparent huge page support for shared mappings.")
+		},
+		&dsm_huge_pages,
+		false,
+		NULL, NULL, NULL
+	},
 	{
 		{"ssl", PGC_SIGHUP, CONN_AUTH_SSL,
 			gettext_noop("Enables SSL connections."),
@@ -1508,6 +1520,15 @@ struct config_bool ConfigureNamesBool[] =
 		false,
 		NULL, NULL, NULL
 	},
+	{
+		{"track_wait_timing", PGC_SUSET, STATS_CUMULATIVE,
+			gettext_noop("Collects timing statistics for wait events."),
+			NULL
+		},
+		&track_wait_timing,
+		false,
+		NULL, NULL, NULL
+	},
 	{
 		{"track_wal_io_timing", PGC_SUSET, STATS_CUMULATIVE,
 			gettext_noop("Collects timing statistics for WAL I/O activity."),
@@ -2387,6 +2408,17 @@ struct config_int ConfigureNamesInt[] =
 		check_vacuum_buffer_usage_limit, NULL, NULL
 	},
 
+	{
+		{"bulk_read_buffer_usage_limit", PGC_USERSET, RESOURCES_MEM,
+			gettext_noop("Sets the buffer pool size for large sequential scans."),
+			gettext_noop("-1 selects a size automatically; 0 lets scans use the whole buffer pool."),
+			GUC_UNIT_KB
+		},
+		&BulkReadBufferUsageLimit,
+		-1, -1, MAX_BAS_BULKREAD_RING_SIZE_KB,
+		check_bulk_read_buffer_usage_limit, NULL, NULL
+	},
+
 	{
 		{"shared_memory_size", PGC_INTERNAL, PRESET_OPTIONS,
 			gettext_noop("Shows the size of the server's main shared memory area (rounded up to the nearest MB)."),
@@ -3770,6 +3802,17 @@ struct config_int ConfigureNamesInt[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"plan_profile_interval", PGC_SUSET, STATS_MONITORING,
+			gettext_noop("Sets the sampling interval for plan profiling."),
+			gettext_noop("Zero disables sampling-based plan profiling."),
+			GUC_UNIT_MS
+		},
+		&plan_profile_interval,
+		0, 0, 60000,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gin_pending_list_limit", PGC_USERSET, CLIENT_CONN_STATEMENT,
 			gettext_noop("Sets the maximum size of the pending list for GIN index."),
@@ -701,7 +701,27 @@ disable_timeout(TimeoutId id, bool keep_indicator)
 
 	/* Reschedule the interrupt, if any timeouts remain active. */
 	if (num_active_timeouts > 0)
-		schedule_alarm(GetCurrentTimestamp());
+	{
+		/*
+		 * Re-enable the signal handler before inspecting signal_pending, for
+		 * the same reasons schedule_alarm() does so before its own setitimer()
+		 * suppression test.
+		 *
+		 * If an interrupt is already due at or before the nearest remaining
+		 * timeout, it can simply be left pending: when it fires, the signal
+		 * handler will reschedule whatever is needed then.  This saves a
+		 * clock reading per cancellation in the common case of disabling a
+		 * timeout (such as lock_timeout) while an unreached later timeout
+		 * such as statement_timeout stays armed.  The price is that recovery
+		 * from a lost interrupt (see the stale-signal check in
+		 * schedule_alarm()) is postponed until the next enable_timeout call
+		 * or signal handler run; lost interrupts are kernel misbehavior that
+		 * should be rare enough for that to be acceptable.
+		 */
+		enable_alarm();
+		if (!(signal_pending && active_timeouts[0]->fin_time >= signal_due_at))
+			schedule_alarm(GetCurrentTimestamp());
+	}
 }
 
 /*
@@ -740,7 +760,15 @@ disable_timeouts(const DisableTimeoutParams *timeouts, int count)
 
 	/* Reschedule the interrupt, if any timeouts remain active. */
 	if (num_active_timeouts > 0)
-		schedule_alarm(GetCurrentTimestamp());
+	{
+		/*
+		 * Leave an already-adequate pending interrupt in place; see
+		 * disable_timeout().
+		 */
+		enable_alarm();
+		if (!(signal_pending && active_timeouts[0]->fin_time >= signal_due_at))
+			schedule_alarm(GetCurrentTimestamp());
+	}
 }
 
 /*
@@ -424,6 +424,7 @@ AllocSetContextCreateInternal(MemoryContext parent,
 
 			((MemoryContext) set)->mem_allocated =
 				KeeperBlock(set)->endptr - ((char *) set);
+			MemoryContextUpdatePeak((MemoryContext) set);
 
 			return (MemoryContext) set;
 		}
@@ -517,6 +518,7 @@ AllocSetContextCreateInternal(MemoryContext parent,
 						name);
 
 	((MemoryContext) set)->mem_allocated = firstBlockSize;
+	MemoryContextUpdatePeak((MemoryContext) set);
 
 	return (MemoryContext) set;
 }
@@ -717,6 +719,7 @@ AllocSetAllocLarge(MemoryContext context, Size size, int flags)
 		return MemoryContextAllocationFailure(context, size, flags);
 
 	context->mem_allocated += blksize;
+	MemoryContextUpdatePeak(context);
 
 	block->aset = set;
 	block->freeptr = block->endptr = ((char *) block) + blksize;
@@ -923,6 +926,7 @@ AllocSetAllocFromNewBlock(MemoryContext context, Size size, int flags,
 		return MemoryContextAllocationFailure(context, size, flags);
 
 	context->mem_allocated += blksize;
+	MemoryContextUpdatePeak(context);
 
 	block->aset = set;
 	block->freeptr = ((char *) block) + ALLOC_BLOCKHDRSZ;
@@ -1234,6 +1238,7 @@ AllocSetRealloc(void *pointer, Size size, int flags)
 		/* updated separately, not to underflow when (oldblksize > blksize) */
 		set->header.mem_allocated -= oldblksize;
 		set->header.mem_allocated += blksize;
+		MemoryContextUpdatePeak(&set->header);
 
 		block->freeptr = block->endptr = ((char *) block) + blksize;
 
@@ -228,6 +228,7 @@ BumpContextCreate(MemoryContext parent, const char *name, Size minContextSize,
 						parent, name);
 
 	((MemoryContext) set)->mem_allocated = allocSize;
+	MemoryContextUpdatePeak((MemoryContext) set);
 
 	return (MemoryContext) set;
 }
@@ -319,6 +320,7 @@ BumpAllocLarge(MemoryContext context, Size size, int flags)
 		return MemoryContextAllocationFailure(context, size, flags);
 
 	context->mem_allocated += blksize;
+	MemoryContextUpdatePeak(context);
 
 	/* the block is completely full */
 	block->freeptr = block->endptr = ((char *) block) + blksize;
@@ -456,6 +458,7 @@ BumpAllocFromNewBlock(MemoryContext context, Size size, int flags,
 		return MemoryContextAllocationFailure(context, size, flags);
 
 	context->mem_allocated += blksize;
+	MemoryContextUpdatePeak(context);
 
 	/* initialize the new block */
 	BumpBlockInit(set, block, blksize);
@@ -27,7 +27,10 @@
  * of large objects and new superblocks is serialized by a single LWLock, but
  * allocation of small objects from pre-existing superblocks uses one LWLock
  * per pool.  Currently there is one pool, and therefore one lock, per size
- * class.  Per-core pools to increase concurrency and strategies for reducing
+ * class.  To keep that lock off the fast path, each backend additionally
+ * caches a small batch of chunks per size class, claimed from the active
+ * superblock in one locked operation and then consumed with no locking at
+ * all.  Per-core pools to increase concurrency and strategies for reducing
  * the resulting fragmentation are areas for future research.  Each superblock
  * is managed with a 'span', which tracks the superblock's freelist.  Free
  * requests are handled by looking in the page map to find which span an
@@ -265,6 +268,16 @@ static const uint8 dsa_size_class_map[] = {
  */
 #define DSA_FULLNESS_CLASSES		4
 
+/*
+ * Limits on the per-backend chunk cache, per size class: we cache at most
+ * DSA_CHUNK_CACHE_CHUNKS chunks, and no more than about
+ * DSA_CHUNK_CACHE_BYTES worth of memory.  The byte limit keeps the amount
+ * of memory parked in any one backend small for the larger size classes,
+ * for which batching matters little anyway.
+ */
+#define DSA_CHUNK_CACHE_CHUNKS		64
+#define DSA_CHUNK_CACHE_BYTES		8192
+
 /*
  * A dsa_area_pool represents a set of objects of a given size class.
  *
@@ -370,6 +383,19 @@ struct dsa_area
 
 	/* The last observed freed_segment_counter. */
 	size_t		freed_segment_counter;
+
+	/*
+	 * Per-size-class cache of chunks available for allocation by this
+	 * backend without locking.  The cache is refilled in batch from the
+	 * active superblock while holding the pool's lock, and then consumed
+	 * with no locking at all, so allocation-heavy users such as parallel
+	 * hash join don't hammer the pool locks for every small chunk.  Cached
+	 * chunks are counted as allocated in the shared span bookkeeping, which
+	 * keeps concurrent frees of neighboring chunks safe and prevents the
+	 * containing superblock from being destroyed under us.
+	 */
+	int			ncached_chunks[DSA_NUM_SIZE_CLASSES];
+	dsa_pointer cached_chunks[DSA_NUM_SIZE_CLASSES][DSA_CHUNK_CACHE_CHUNKS];
 };
 
 #define DSA_SPAN_NOTHING_FREE	((uint16) -1)
@@ -385,6 +411,8 @@ static void init_span(dsa_area *area, dsa_pointer span_pointer,
 static bool transfer_first_span(dsa_area *area, dsa_area_pool *pool,
 								int fromclass, int toclass);
 static inline dsa_pointer alloc_object(dsa_area *area, int size_class);
+static int	refill_chunk_cache(dsa_area *area, int size_class);
+static void flush_chunk_caches(dsa_area *area);
 static bool ensure_active_superblock(dsa_area *area, dsa_area_pool *pool,
 									 int size_class);
 static dsa_segment_map *get_segment_by_index(dsa_area *area,
@@ -812,8 +840,15 @@ dsa_allocate_extended(dsa_area *area, size_t size, int flags)
 	Assert(size <= dsa_size_classes[size_class]);
 	Assert(size_class == 0 || size > dsa_size_classes[size_class - 1]);
 
-	/* Attempt to allocate an object from the appropriate pool. */
-	result = alloc_object(area, size_class);
+	/*
+	 * Attempt to allocate an object from the backend-local chunk cache for
+	 * this size class, refilling it from the appropriate pool if it's empty.
+	 */
+	if (area->ncached_chunks[size_class] > 0 ||
+		refill_chunk_cache(area, size_class) > 0)
+		result = area->cached_chunks[size_class][--area->ncached_chunks[size_class]];
+	else
+		result = InvalidDsaPointer;
 
 	/* Check for failure to allocate. */
 	if (!DsaPointerIsValid(result))
@@ -1059,6 +1094,13 @@ dsa_trim(dsa_area *area)
 {
 	int			size_class;
 
+	/*
+	 * Return our own cached chunks first, so that superblocks they pin can
+	 * be considered for release below.  (Chunks cached by other backends
+	 * necessarily stay put.)
+	 */
+	flush_chunk_caches(area);
+
 	/*
 	 * Trim in reverse pool order so we get to the spans-of-spans last, just
 	 * in case any become entirely free while processing all the other pools.
@@ -1301,6 +1343,7 @@ create_internal(void *place, size_t size,
 	memset(area->segment_maps, 0, sizeof(dsa_segment_map) * DSA_MAX_SEGMENTS);
 	area->high_segment_index = 0;
 	area->freed_segment_counter = 0;
+	memset(area->ncached_chunks, 0, sizeof(area->ncached_chunks));
 	LWLockInitialize(&control->lock, control->lwlock_tranche_id);
 	for (i = 0; i < DSA_NUM_SIZE_CLASSES; ++i)
 		LWLockInitialize(DSA_SCLASS_LOCK(area, i),
@@ -1357,6 +1400,7 @@ attach_internal(void *place, dsm_segment *segment, dsa_handle handle)
 	memset(&area->segment_maps[0], 0,
 		   sizeof(dsa_segment_map) * DSA_MAX_SEGMENTS);
 	area->high_segment_index = 0;
+	memset(area->ncached_chunks, 0, sizeof(area->ncached_chunks));
 
 	/* Set up the segment map for this process's mapping. */
 	segment_map = &area->segment_maps[0];
@@ -1549,6 +1593,96 @@ alloc_object(dsa_area *area, int size_class)
 	return result;
 }
 
+/*
+ * Refill this backend's chunk cache for the given size class by popping a
+ * batch of chunks from the active superblock while holding the pool's lock
+ * just once.  The cached chunks remain allocated as far as the shared
+ * bookkeeping is concerned, so they are private to this backend until
+ * allocated and freed, or returned by flush_chunk_caches.  Returns the
+ * number of chunks now in the cache, which is zero only if no more memory
+ * could be obtained.
+ *
+ * We take only what the active superblock has free rather than forcing new
+ * superblocks into existence to fill the cache, so a refill never allocates
+ * more than a single allocation would have.
+ */
+static int
+refill_chunk_cache(dsa_area *area, int size_class)
+{
+	dsa_area_pool *pool = &area->control->pools[size_class];
+	size_t		size = dsa_size_classes[size_class];
+	int			nmax;
+	int			n = 0;
+
+	/* The special span classes must use alloc_object directly. */
+	Assert(size_class != DSA_SCLASS_BLOCK_OF_SPANS &&
+		   size_class != DSA_SCLASS_SPAN_LARGE);
+	Assert(area->ncached_chunks[size_class] == 0);
+
+	nmax = Min(DSA_CHUNK_CACHE_CHUNKS,
+			   Max(1, DSA_CHUNK_CACHE_BYTES / (int) size));
+
+	LWLockAcquire(DSA_SCLASS_LOCK(area, size_class), LW_EXCLUSIVE);
+	if (DsaPointerIsValid(pool->spans[1]) ||
+		ensure_active_superblock(area, pool, size_class))
+	{
+		dsa_area_span *span;
+		dsa_pointer block;
+
+		/*
+		 * Pop chunks from the active superblock exactly as alloc_object
+		 * would, but stash them in the cache instead of handing them out.
+		 */
+		Assert(DsaPointerIsValid(pool->spans[1]));
+		span = (dsa_area_span *) dsa_get_address(area, pool->spans[1]);
+		Assert(span->nallocatable > 0);
+		block = span->start;
+		while (n < nmax && span->nallocatable > 0)
+		{
+			dsa_pointer result;
+
+			if (span->firstfree != DSA_SPAN_NOTHING_FREE)
+			{
+				char	   *object;
+
+				result = block + span->firstfree * size;
+				object = dsa_get_address(area, result);
+				span->firstfree = NextFreeObjectIndex(object);
+			}
+			else
+			{
+				result = block + span->ninitialized * size;
+				++span->ninitialized;
+			}
+			--span->nallocatable;
+			area->cached_chunks[size_class][n++] = result;
+		}
+
+		/* If it's now full, move it to the highest-numbered fullness class. */
+		if (span->nallocatable == 0)
+			transfer_first_span(area, pool, 1, DSA_FULLNESS_CLASSES - 1);
+	}
+	LWLockRelease(DSA_SCLASS_LOCK(area, size_class));
+
+	area->ncached_chunks[size_class] = n;
+
+	return n;
+}
+
+/*
+ * Give all chunks in this backend's chunk caches back to the shared pools.
+ */
+static void
+flush_chunk_caches(dsa_area *area)
+{
+	for (int size_class = 0; size_class < DSA_NUM_SIZE_CLASSES; ++size_class)
+	{
+		while (area->ncached_chunks[size_class] > 0)
+			dsa_free(area,
+					 area->cached_chunks[size_class][--area->ncached_chunks[size_class]]);
+	}
+}
+
 /*
  * Ensure an active (i.e. fullness class 1) superblock, unless all existing
  * superblocks are completely full and no more can be allocated.
@@ -1968,6 +2102,12 @@ dsa_detach(dsa_area *area)
 {
 	int			i;
 
+	/*
+	 * Give back any chunks parked in this backend's caches, so they don't
+	 * remain unusable for the area's remaining lifetime.
+	 */
+	flush_chunk_caches(area);
+
 	/* Detach from all segments. */
 	for (i = 0; i <= area->high_segment_index; ++i)
 		if (area->segment_maps[i].segment != NULL)
@@ -266,6 +266,7 @@ GenerationContextCreate(MemoryContext parent,
 						name);
 
 	((MemoryContext) set)->mem_allocated = firstBlockSize;
+	MemoryContextUpdatePeak((MemoryContext) set);
 
 	return (MemoryContext) set;
 }
@@ -366,6 +367,7 @@ GenerationAllocLarge(MemoryContext context, Size size, int flags)
 		return MemoryContextAllocationFailure(context, size, flags);
 
 	context->mem_allocated += blksize;
+	MemoryContextUpdatePeak(context);
 
 	/* block with a single (used) chunk */
 	block->context = set;
@@ -488,6 +490,7 @@ GenerationAllocFromNewBlock(MemoryContext context, Size size, int flags,
 		return MemoryContextAllocationFailure(context, size, flags);
 
 	context->mem_allocated += blksize;
+	MemoryContextUpdatePeak(context);
 
 	/* initialize the new block */
 	GenerationBlockInit(set, block, blksize);
@@ -1117,6 +1117,7 @@ MemoryContextCreate(MemoryContext node,
 	node->parent = parent;
 	node->firstchild = NULL;
 	node->mem_allocated = 0;
+	node->peak_allocated = 0;
 	node->prevchild = NULL;
 	node->name = name;
 	node->ident = NULL;
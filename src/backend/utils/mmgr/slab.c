@@ -569,6 +569,7 @@ SlabAllocFromNewBlock(MemoryContext context, Size size, int flags)
 
 		block->slab = slab;
 		context->mem_allocated += slab->blockSize;
+		MemoryContextUpdatePeak(context);
 
 		/* use the first chunk in the new block */
 		chunk = SlabBlockGetChunk(slab, block, 0);
@@ -293,42 +293,89 @@ ltsReadBlock(LogicalTapeSet *lts, int64 blocknum, void *buffer)
  * Read as many blocks as we can into the per-tape buffer.
  *
  * Returns true if anything was read, 'false' on EOF.
+ *
+ * A tape's blocks are very often laid out physically consecutively, because
+ * they are allocated in ascending order while the tape is the only one being
+ * written (as in tuplesort run building), or come from a preallocated range
+ * (as with concurrently-written HashAgg tapes).  We exploit that by reading a
+ * whole range of consecutive blocks in one call, speculatively, and then
+ * consuming as many of them as the block chain confirms belong to this tape.
+ * Blocks past a jump in the chain are simply discarded and read again from
+ * the right place, so a fragmented tape costs some extra bytes read but never
+ * reads wrong data.  A short read can happen when the speculative range runs
+ * past the end of the file, or into a hole left by BufFile concatenation;
+ * that just limits how many blocks we can consume.
  */
 static bool
 ltsReadFillBuffer(LogicalTape *lt)
 {
+	LogicalTapeSet *lts = lt->tapeSet;
+
 	lt->pos = 0;
 	lt->nbytes = 0;
 
-	do
+	while (lt->nextBlockNumber != -1L &&
+		   lt->buffer_size - lt->nbytes >= BLCKSZ)
 	{
 		char	   *thisbuf = lt->buffer + lt->nbytes;
-		int64		datablocknum = lt->nextBlockNumber;
 
-		/* Fetch next block number */
-		if (datablocknum == -1L)
-			break;				/* EOF */
 		/* Apply worker offset, needed for leader tapesets */
-		datablocknum += lt->offsetBlockNumber;
-
-		/* Read the block */
-		ltsReadBlock(lt->tapeSet, datablocknum, thisbuf);
-		if (!lt->frozen)
-			ltsReleaseBlock(lt->tapeSet, datablocknum);
-		lt->curBlockNumber = lt->nextBlockNumber;
+		int64		datablocknum = lt->nextBlockNumber + lt->offsetBlockNumber;
+		int64		maxblocks;
+		int			nblocks;
 
-		lt->nbytes += TapeBlockGetNBytes(thisbuf);
-		if (TapeBlockIsLast(thisbuf))
+		/*
+		 * Figure out how many consecutive blocks to read at once.  Only the
+		 * next block is known to be ours; the rest of the range is
+		 * speculative.  Don't ask for blocks past the end of the underlying
+		 * file.
+		 */
+		maxblocks = (lt->buffer_size - lt->nbytes) / BLCKSZ;
+		if (maxblocks > lts->nBlocksWritten - datablocknum)
+			maxblocks = lts->nBlocksWritten - datablocknum;
+		if (maxblocks < 1)
+			maxblocks = 1;
+
+		if (BufFileSeekBlock(lts->pfile, datablocknum) != 0)
+			ereport(ERROR,
+					(errcode_for_file_access(),
+					 errmsg("could not seek to block %" PRId64 " of temporary file",
+							datablocknum)));
+		nblocks = (int) (BufFileRead(lts->pfile, thisbuf,
+									 (size_t) maxblocks * BLCKSZ) / BLCKSZ);
+		if (nblocks < 1)
+			ereport(ERROR,
+					(errcode_for_file_access(),
+					 errmsg("could not read block %" PRId64 " of temporary file",
+							datablocknum)));
+
+		/* Consume the blocks that the block chain confirms are ours. */
+		for (int i = 0; i < nblocks; i++)
 		{
-			lt->nextBlockNumber = -1L;
-			/* EOF */
-			break;
-		}
-		else
-			lt->nextBlockNumber = TapeBlockGetTrailer(thisbuf)->next;
+			char	   *blockbuf = lt->buffer + lt->nbytes;
+
+			/* pack the payload tight against the preceding block's */
+			if (i > 0)
+				memmove(blockbuf, thisbuf + (size_t) i * BLCKSZ, BLCKSZ);
+
+			lt->curBlockNumber = lt->nextBlockNumber;
+			if (!lt->frozen)
+				ltsReleaseBlock(lts, lt->curBlockNumber + lt->offsetBlockNumber);
+
+			lt->nbytes += TapeBlockGetNBytes(blockbuf);
+			if (TapeBlockIsLast(blockbuf))
+			{
+				lt->nextBlockNumber = -1L;
+				/* EOF */
+				break;
+			}
+			lt->nextBlockNumber = TapeBlockGetTrailer(blockbuf)->next;
 
-		/* Advance to next block, if we have buffer space left */
-	} while (lt->buffer_size - lt->nbytes > BLCKSZ);
+			/* Discard any remaining speculative blocks if the chain jumps. */
+			if (lt->nextBlockNumber != lt->curBlockNumber + 1)
+				break;
+		}
+	}
 
 	return (lt->nbytes > 0);
 }
@@ -269,6 +269,22 @@ struct Tuplesortstate
 	 */
 	int			currentRun;
 
+	/*
+	 * While building initial runs, the current run is left open on destTape
+	 * (its end marker not yet written) so that the next sorted batch can be
+	 * appended to it if every tuple in the batch follows the run's last
+	 * tuple in the sort order.  runOpen says whether an end marker is still
+	 * pending; lastDumpedDatum1/lastDumpedIsnull1 hold the leading-key datum
+	 * of the last tuple written, valid only when lastDumpedValid.  With
+	 * nearly sorted input this merges what would otherwise be many
+	 * memory-sized runs into a few long ones, often avoiding merge passes
+	 * entirely.
+	 */
+	bool		runOpen;
+	bool		lastDumpedValid;
+	Datum		lastDumpedDatum1;
+	bool		lastDumpedIsnull1;
+
 	/*
 	 * Logical tapes, for merging.
 	 *
@@ -1890,6 +1906,8 @@ inittapes(Tuplesortstate *state, bool mergeruns)
 							 state->worker);
 
 	state->currentRun = 0;
+	state->runOpen = false;
+	state->lastDumpedValid = false;
 
 	/*
 	 * Initialize logical tape arrays.
@@ -2308,6 +2326,7 @@ dumptuples(Tuplesortstate *state, bool alltuples)
 {
 	int			memtupwrite;
 	int			i;
+	bool		extendrun;
 
 	/*
 	 * Nothing to do if we still fit in available memory and have array slots,
@@ -2326,7 +2345,15 @@ dumptuples(Tuplesortstate *state, bool alltuples)
 	 * at least one tape, even if it's empty.
 	 */
 	if (state->memtupcount == 0 && state->currentRun > 0)
+	{
+		/* ... but the final run must still get its end marker */
+		if (alltuples && state->runOpen)
+		{
+			markrunend(state->destTape);
+			state->runOpen = false;
+		}
 		return;
+	}
 
 	Assert(state->status == TSS_BUILDRUNS);
 
@@ -2340,10 +2367,50 @@ dumptuples(Tuplesortstate *state, bool alltuples)
 				 errmsg("cannot have more than %d runs for an external sort",
 						INT_MAX)));
 
-	if (state->currentRun > 0)
-		selectnewtape(state);
+	/*
+	 * If the previous run was left open and every tuple in this batch
+	 * strictly follows its last tuple on the leading sort key, append this
+	 * batch to that run instead of starting a new one.  Strict leading-key
+	 * inequality implies full sort-order precedence regardless of any
+	 * tiebreak keys, and for abbreviated keys a nonzero comparison result is
+	 * authoritative, so no full-key comparison is needed.  On unordered
+	 * input the scan below almost always fails on the first tuple.
+	 */
+	extendrun = state->runOpen && state->lastDumpedValid;
+	if (extendrun)
+	{
+		for (i = 0; i < state->memtupcount; i++)
+		{
+			SortTuple  *stup = &state->memtuples[i];
+
+			if (ApplySortComparator(state->lastDumpedDatum1,
+									state->lastDumpedIsnull1,
+									stup->datum1, stup->isnull1,
+									&state->base.sortKeys[0]) >= 0)
+			{
+				extendrun = false;
+				break;
+			}
+		}
+	}
+
+	if (!extendrun)
+	{
+		if (state->runOpen)
+		{
+			markrunend(state->destTape);
+			state->runOpen = false;
+		}
+
+		if (state->currentRun > 0)
+			selectnewtape(state);
 
-	state->currentRun++;
+		state->currentRun++;
+	}
+	else if (trace_sort)
+		elog(LOG, "worker %d extending run %d with next batch: %s",
+			 state->worker, state->currentRun,
+			 pg_rusage_show(&state->ru_start));
 
 	if (trace_sort)
 		elog(LOG, "worker %d starting quicksort of run %d: %s",
@@ -2369,6 +2436,29 @@ dumptuples(Tuplesortstate *state, bool alltuples)
 		WRITETUP(state, state->destTape, stup);
 	}
 
+	/*
+	 * Remember the leading-key datum of the last (largest) tuple written, so
+	 * that the next batch can be checked for run extension above.  This must
+	 * be done before the tuple memory is reset, and is only safe when datum1
+	 * remains valid afterwards: when it's pass-by-value, or holds an
+	 * abbreviated key (always pass-by-value).  A NULL needs no datum at all.
+	 */
+	state->lastDumpedValid = false;
+	if (memtupwrite > 0 && state->base.haveDatum1 &&
+		state->base.sortKeys != NULL)
+	{
+		SortTuple  *last = &state->memtuples[memtupwrite - 1];
+
+		if (last->isnull1 ||
+			state->base.sortKeys[0].abbrev_converter != NULL ||
+			state->base.datum1ByVal)
+		{
+			state->lastDumpedDatum1 = last->datum1;
+			state->lastDumpedIsnull1 = last->isnull1;
+			state->lastDumpedValid = true;
+		}
+	}
+
 	state->memtupcount = 0;
 
 	/*
@@ -2387,7 +2477,18 @@ dumptuples(Tuplesortstate *state, bool alltuples)
 	FREEMEM(state, state->tupleMem);
 	state->tupleMem = 0;
 
-	markrunend(state->destTape);
+	/*
+	 * Leave the run open if more input may arrive, so that a later batch can
+	 * extend it; the end marker is written when the run is closed, either
+	 * above or here on the final call.
+	 */
+	if (alltuples)
+	{
+		markrunend(state->destTape);
+		state->runOpen = false;
+	}
+	else
+		state->runOpen = true;
 
 	if (trace_sort)
 		elog(LOG, "worker %d finished writing run %d to tape %d: %s",
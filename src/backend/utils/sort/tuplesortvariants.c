@@ -211,6 +211,7 @@ tuplesort_begin_heap(TupleDesc tupDesc,
 	base->writetup = writetup_heap;
 	base->readtup = readtup_heap;
 	base->haveDatum1 = true;
+	base->datum1ByVal = TupleDescAttr(tupDesc, attNums[0] - 1)->attbyval;
 	base->arg = tupDesc;		/* assume we need not copy tupDesc */
 
 	/* Prepare SortSupport data for each column */
@@ -298,7 +299,12 @@ tuplesort_begin_cluster(TupleDesc tupDesc,
 	if (arg->indexInfo->ii_IndexAttrNumbers[0] == 0)
 		base->haveDatum1 = false;
 	else
+	{
 		base->haveDatum1 = true;
+		base->datum1ByVal =
+			TupleDescAttr(tupDesc,
+						  arg->indexInfo->ii_IndexAttrNumbers[0] - 1)->attbyval;
+	}
 
 	arg->tupDesc = tupDesc;		/* assume we need not copy tupDesc */
 
@@ -394,6 +400,7 @@ tuplesort_begin_index_btree(Relation heapRel,
 	base->writetup = writetup_index;
 	base->readtup = readtup_index;
 	base->haveDatum1 = true;
+	base->datum1ByVal = TupleDescAttr(RelationGetDescr(indexRel), 0)->attbyval;
 	base->arg = arg;
 
 	arg->index.heapRel = heapRel;
@@ -516,6 +523,7 @@ tuplesort_begin_index_gist(Relation heapRel,
 	base->writetup = writetup_index;
 	base->readtup = readtup_index;
 	base->haveDatum1 = true;
+	base->datum1ByVal = TupleDescAttr(RelationGetDescr(indexRel), 0)->attbyval;
 	base->arg = arg;
 
 	arg->index.heapRel = heapRel;
@@ -691,6 +699,7 @@ tuplesort_begin_datum(Oid datumType, Oid sortOperator, Oid sortCollation,
 	get_typlenbyval(datumType, &typlen, &typbyval);
 	arg->datumTypeLen = typlen;
 	base->tuples = !typbyval;
+	base->datum1ByVal = typbyval;
 
 	/* Prepare SortSupport data */
 	base->sortKeys = (SortSupport) palloc0(sizeof(SortSupportData));
@@ -1263,9 +1272,28 @@ comparetup_heap_tiebreak(const SortTuple *a, const SortTuple *b, Tuplesortstate
 		datum1 = heap_getattr(&ltup, attno, tupDesc, &isnull1);
 		datum2 = heap_getattr(&rtup, attno, tupDesc, &isnull2);
 
-		compare = ApplySortComparator(datum1, isnull1,
-									  datum2, isnull2,
-									  sortKey);
+		/*
+		 * Match the comparators of the common pass-by-value types so that
+		 * the comparison is applied inline rather than via an indirect
+		 * function call, much as tuplesort_sort_memtuples does for the
+		 * leading key.  This mostly helps multi-key sorts whose leading key
+		 * has many duplicates, since that is when the trailing keys get
+		 * compared at all.
+		 */
+		if (sortKey->comparator == ssup_datum_int32_cmp)
+			compare = ApplyInt32SortComparator(datum1, isnull1,
+											   datum2, isnull2,
+											   sortKey);
+#if SIZEOF_DATUM >= 8
+		else if (sortKey->comparator == ssup_datum_signed_cmp)
+			compare = ApplySignedSortComparator(datum1, isnull1,
+												datum2, isnull2,
+												sortKey);
+#endif
+		else
+			compare = ApplySortComparator(datum1, isnull1,
+										  datum2, isnull2,
+										  sortKey);
 		if (compare != 0)
 			return compare;
 	}
@@ -16,6 +16,14 @@
  * A temporary file is used to handle the data if it exceeds the
  * space limit specified by the caller.
  *
+ * Note that tuplestore does no column pruning: it stores tuples exactly as
+ * wide as the caller forms them.  Plan nodes that spool their input through
+ * a tuplestore (or tuplesort) should instead arrange at plan creation time
+ * for the input to carry only the needed columns, by requesting
+ * CP_SMALL_TLIST for their subplan; see createplan.c.  Don't "fix" a
+ * wide-row spill here without checking that the relevant create_*_plan
+ * function does that.
+ *
  * The (approximate) amount of memory allowed to the tuplestore is specified
  * in kilobytes by the caller.  We absorb tuples and simply store them in an
  * in-memory array as long as we haven't exceeded maxKBytes.  If we do exceed
@@ -213,6 +213,7 @@ static List *exportedSnapshots = NIL;
 
 /* Prototypes for local functions */
 static Snapshot CopySnapshot(Snapshot snapshot);
+static bool XidInMVCCSnapshotSearch(TransactionId xid, Snapshot snapshot);
 static void UnregisterSnapshotNoOwner(Snapshot snapshot);
 static void FreeSnapshot(Snapshot snapshot);
 static void SnapshotResetXmin(void);
@@ -533,6 +534,9 @@ SetTransactionSnapshot(Snapshot sourcesnap, VirtualTransactionId *sourcevxid,
 			   sourcesnap->subxcnt * sizeof(TransactionId));
 	CurrentSnapshot->suboverflowed = sourcesnap->suboverflowed;
 	CurrentSnapshot->takenDuringRecovery = sourcesnap->takenDuringRecovery;
+	/* we just changed the snapshot's contents, so flush the XID cache */
+	CurrentSnapshot->xicCount = 0;
+	CurrentSnapshot->xicNext = 0;
 	/* NB: curcid should NOT be copied, it's a local matter */
 
 	CurrentSnapshot->snapXactCompletionCount = 0;
@@ -1807,6 +1811,8 @@ RestoreSnapshot(char *start_address)
 	snapshot->takenDuringRecovery = serialized_snapshot.takenDuringRecovery;
 	snapshot->curcid = serialized_snapshot.curcid;
 	snapshot->snapXactCompletionCount = 0;
+	snapshot->xicCount = 0;
+	snapshot->xicNext = 0;
 
 	/* Copy XIDs, if present. */
 	if (serialized_snapshot.xcnt > 0)
@@ -1858,6 +1864,9 @@ RestoreTransactionSnapshot(Snapshot snapshot, void *source_pgproc)
 bool
 XidInMVCCSnapshot(TransactionId xid, Snapshot snapshot)
 {
+	bool		result;
+	uint32		slot;
+
 	/*
 	 * Make a quick range check to eliminate most XIDs without looking at the
 	 * xip arrays.  Note that this is OK even if we convert a subxact XID to
@@ -1873,6 +1882,37 @@ XidInMVCCSnapshot(TransactionId xid, Snapshot snapshot)
 	if (TransactionIdFollowsOrEquals(xid, snapshot->xmax))
 		return true;
 
+	/*
+	 * The XIDs encountered while scanning a page tend to repeat; consult the
+	 * cache of recent verdicts before searching the arrays.
+	 */
+	for (slot = 0; slot < snapshot->xicCount; slot++)
+	{
+		if (snapshot->xicXids[slot] == xid)
+			return snapshot->xicVerdicts[slot];
+	}
+
+	result = XidInMVCCSnapshotSearch(xid, snapshot);
+
+	/* Remember the verdict, replacing entries round-robin once full */
+	slot = snapshot->xicNext;
+	snapshot->xicXids[slot] = xid;
+	snapshot->xicVerdicts[slot] = result;
+	snapshot->xicNext = (slot + 1) % XID_IN_SNAPSHOT_CACHE_SIZE;
+	if (snapshot->xicCount <= slot)
+		snapshot->xicCount = slot + 1;
+
+	return result;
+}
+
+/*
+ * Workhorse for XidInMVCCSnapshot: search the snapshot's xip arrays (and
+ * possibly pg_subtrans) for an XID already known to be within the
+ * snapshot's xmin/xmax range.
+ */
+static bool
+XidInMVCCSnapshotSearch(TransactionId xid, Snapshot snapshot)
+{
 	/*
 	 * Snapshot information is stored slightly differently in snapshots taken
 	 * during recovery.
@@ -117,6 +117,7 @@ static void mark_restore_job_done(ArchiveHandle *AH,
 								  void *callback_data);
 static void fix_dependencies(ArchiveHandle *AH);
 static bool has_lock_conflicts(TocEntry *te1, TocEntry *te2);
+static bool indexes_on_same_table(TocEntry *te1, TocEntry *te2);
 static void repoint_table_dependencies(ArchiveHandle *AH);
 static void identify_locking_dependencies(ArchiveHandle *AH, TocEntry *te);
 static void reduce_dependencies(ArchiveHandle *AH, TocEntry *te,
@@ -4575,6 +4576,37 @@ has_lock_conflicts(TocEntry *te1, TocEntry *te2)
 	return false;
 }
 
+/*
+ * Check if te1 and te2 are both index builds on the same table.
+ *
+ * An INDEX entry depends on its table's TOC entry, so two INDEX entries
+ * that share a dependency are (in practice) indexes on the same table.
+ * Running such builds concurrently lets the later-started scans find the
+ * table's heap pages already in shared buffers or the kernel cache,
+ * instead of each build re-reading the table from disk at a different
+ * time.
+ */
+static bool
+indexes_on_same_table(TocEntry *te1, TocEntry *te2)
+{
+	int			j,
+				k;
+
+	if (strcmp(te1->desc, "INDEX") != 0 ||
+		strcmp(te2->desc, "INDEX") != 0)
+		return false;
+
+	for (j = 0; j < te1->nDeps; j++)
+	{
+		for (k = 0; k < te2->nDeps; k++)
+		{
+			if (te1->dependencies[j] == te2->dependencies[k])
+				return true;
+		}
+	}
+	return false;
+}
+
 
 /*
  * Initialize the header of the pending-items list.
@@ -4687,6 +4719,27 @@ static TocEntry *
 pop_next_work_item(binaryheap *ready_heap,
 				   ParallelState *pstate)
 {
+	bool		running_index = false;
+	int			first_candidate = -1;
+
+	/*
+	 * If some worker is currently building an index, it pays to look for a
+	 * ready index build on the same table before settling for the largest
+	 * runnable item: concurrent builds share the table's heap pages through
+	 * shared buffers and the kernel cache, while builds run at different
+	 * times each read the table anew.
+	 */
+	for (int k = 0; k < pstate->numWorkers; k++)
+	{
+		TocEntry   *running_te = pstate->te[k];
+
+		if (running_te != NULL && strcmp(running_te->desc, "INDEX") == 0)
+		{
+			running_index = true;
+			break;
+		}
+	}
+
 	/*
 	 * Search the ready_heap until we find a suitable item.  Note that we do a
 	 * sequential scan through the heap nodes, so even though we will first
@@ -4723,7 +4776,42 @@ pop_next_work_item(binaryheap *ready_heap,
 			continue;
 
 		/* passed all tests, so this item can run */
-		binaryheap_remove_node(ready_heap, i);
+		if (!running_index)
+		{
+			binaryheap_remove_node(ready_heap, i);
+			return te;
+		}
+
+		/*
+		 * Remember the first runnable item, but keep looking for an index
+		 * build on the same table as one currently in progress; prefer that
+		 * if we find it.
+		 */
+		if (first_candidate < 0)
+			first_candidate = i;
+
+		if (strcmp(te->desc, "INDEX") == 0)
+		{
+			for (int k = 0; k < pstate->numWorkers; k++)
+			{
+				TocEntry   *running_te = pstate->te[k];
+
+				if (running_te != NULL &&
+					indexes_on_same_table(te, running_te))
+				{
+					binaryheap_remove_node(ready_heap, i);
+					return te;
+				}
+			}
+		}
+	}
+
+	if (first_candidate >= 0)
+	{
+		TocEntry   *te = (TocEntry *) binaryheap_get_node(ready_heap,
+														  first_candidate);
+
+		binaryheap_remove_node(ready_heap, first_candidate);
 		return te;
 	}
 
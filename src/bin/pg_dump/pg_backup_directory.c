@@ -54,10 +54,20 @@ typedef struct
 	char	   *directory;
 
 	CompressFileHandle *dataFH; /* currently open data file */
+	char	   *databuf;		/* staging buffer for writes to dataFH */
+	size_t		databufused;	/* amount of valid data in databuf */
 	CompressFileHandle *LOsTocFH;	/* file handle for blobs_NNN.toc */
 	ParallelState *pstate;		/* for parallel backup / restore */
 } lclContext;
 
+/*
+ * Size of the staging buffer for table and LO data.  The dumper hands us one
+ * COPY row (or LO chunk) per WriteData call; batching them up before calling
+ * into the compression layer keeps the per-call compressor and stdio overhead
+ * off the per-row path.
+ */
+#define DATA_STAGING_BUFFER_SIZE	(16 * DEFAULT_IO_BUFFER_SIZE)
+
 typedef struct
 {
 	char	   *filename;		/* filename excluding the directory (basename) */
@@ -95,6 +105,7 @@ static int	_WorkerJobDumpDirectory(ArchiveHandle *AH, TocEntry *te);
 
 static void setFilePath(ArchiveHandle *AH, char *buf,
 						const char *relativeFilename);
+static void _FlushDataBuffer(ArchiveHandle *AH);
 
 /*
  *	Init routine required by ALL formats. This is a global routine
@@ -308,16 +319,63 @@ _StartData(ArchiveHandle *AH, TocEntry *te)
  *
  * It should only be called from within a DataDumper routine.
  *
- * We write the data to the open data file.
+ * We stage the data in a local buffer and pass it to the compression layer
+ * in large blocks, since this routine is typically called once per table row.
  */
 static void
 _WriteData(ArchiveHandle *AH, const void *data, size_t dLen)
+{
+	lclContext *ctx = (lclContext *) AH->formatData;
+
+	if (ctx->databuf == NULL)
+		ctx->databuf = pg_malloc(DATA_STAGING_BUFFER_SIZE);
+
+	while (dLen > 0)
+	{
+		size_t		chunk;
+
+		/* Large writes bypass the buffer once it has been emptied */
+		if (ctx->databufused == 0 && dLen >= DATA_STAGING_BUFFER_SIZE)
+		{
+			CompressFileHandle *CFH = ctx->dataFH;
+
+			errno = 0;
+			if (!CFH->write_func(data, dLen, CFH))
+			{
+				/* if write didn't set errno, assume problem is no disk space */
+				if (errno == 0)
+					errno = ENOSPC;
+				pg_fatal("could not write to output file: %s",
+						 CFH->get_error_func(CFH));
+			}
+			return;
+		}
+
+		chunk = Min(dLen, DATA_STAGING_BUFFER_SIZE - ctx->databufused);
+		memcpy(ctx->databuf + ctx->databufused, data, chunk);
+		ctx->databufused += chunk;
+		data = (const char *) data + chunk;
+		dLen -= chunk;
+
+		if (ctx->databufused == DATA_STAGING_BUFFER_SIZE)
+			_FlushDataBuffer(AH);
+	}
+}
+
+/*
+ * Push any staged data out to the currently open data file.
+ */
+static void
+_FlushDataBuffer(ArchiveHandle *AH)
 {
 	lclContext *ctx = (lclContext *) AH->formatData;
 	CompressFileHandle *CFH = ctx->dataFH;
 
+	if (ctx->databufused == 0)
+		return;
+
 	errno = 0;
-	if (dLen > 0 && !CFH->write_func(data, dLen, CFH))
+	if (!CFH->write_func(ctx->databuf, ctx->databufused, CFH))
 	{
 		/* if write didn't set errno, assume problem is no disk space */
 		if (errno == 0)
@@ -325,6 +383,8 @@ _WriteData(ArchiveHandle *AH, const void *data, size_t dLen)
 		pg_fatal("could not write to output file: %s",
 				 CFH->get_error_func(CFH));
 	}
+
+	ctx->databufused = 0;
 }
 
 /*
@@ -338,6 +398,8 @@ _EndData(ArchiveHandle *AH, TocEntry *te)
 {
 	lclContext *ctx = (lclContext *) AH->formatData;
 
+	_FlushDataBuffer(AH);
+
 	/* Close the file */
 	if (!EndCompressFileHandle(ctx->dataFH))
 		pg_fatal("could not close data file: %m");
@@ -670,6 +732,8 @@ _EndLO(ArchiveHandle *AH, TocEntry *te, Oid oid)
 	char		buf[50];
 	int			len;
 
+	_FlushDataBuffer(AH);
+
 	/* Close the BLOB data file itself */
 	if (!EndCompressFileHandle(ctx->dataFH))
 		pg_fatal("could not close LO data file: %m");
@@ -803,6 +867,10 @@ _Clone(ArchiveHandle *AH)
 	memcpy(AH->formatData, ctx, sizeof(lclContext));
 	ctx = (lclContext *) AH->formatData;
 
+	/* The staging buffer can't be shared; each clone allocates its own. */
+	ctx->databuf = NULL;
+	ctx->databufused = 0;
+
 	/*
 	 * TOC-entry-local state isn't an issue because any one TOC entry is
 	 * touched by just one worker child.
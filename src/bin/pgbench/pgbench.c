@@ -364,6 +364,21 @@ typedef struct SimpleStats
 	double		sum2;			/* sum of squared values */
 } SimpleStats;
 
+/*
+ * A log-linear histogram of latencies, for reporting percentiles.  Values are
+ * microseconds; each power-of-two range is split into 16 sub-buckets, keeping
+ * the relative quantization error below about 6% over the whole int64 range.
+ * The array is small enough to zero per thread and merge once at end of run.
+ */
+#define LATENCY_SUBBUCKET_BITS	4
+#define LATENCY_SUBBUCKETS		(1 << LATENCY_SUBBUCKET_BITS)
+#define LATENCY_NBUCKETS		((64 - LATENCY_SUBBUCKET_BITS + 1) * LATENCY_SUBBUCKETS)
+
+typedef struct LatencyHistogram
+{
+	int64		buckets[LATENCY_NBUCKETS];
+} LatencyHistogram;
+
 /*
  * The instr_time type is expensive when dealing with time arithmetic.  Define
  * a type to hold microseconds instead.  Type int64 is good enough for about
@@ -442,6 +457,7 @@ typedef struct StatsData
 									 * error */
 	SimpleStats latency;
 	SimpleStats lag;
+	LatencyHistogram latency_hist;
 } StatsData;
 
 /*
@@ -1453,6 +1469,75 @@ mergeSimpleStats(SimpleStats *acc, SimpleStats *ss)
 	acc->sum2 += ss->sum2;
 }
 
+/*
+ * Accumulate one latency value (in usec) into a histogram.
+ */
+static void
+addToLatencyHistogram(LatencyHistogram *h, double val)
+{
+	int64		us = (int64) val;
+	int			idx;
+
+	if (us < LATENCY_SUBBUCKETS)
+		idx = (us < 0) ? 0 : (int) us;
+	else
+	{
+		int			e = pg_leftmost_one_pos64(us);
+
+		idx = ((e - LATENCY_SUBBUCKET_BITS + 1) << LATENCY_SUBBUCKET_BITS) |
+			(int) ((us >> (e - LATENCY_SUBBUCKET_BITS)) &
+				   (LATENCY_SUBBUCKETS - 1));
+	}
+	h->buckets[idx]++;
+}
+
+/*
+ * Merge two latency histograms.
+ */
+static void
+mergeLatencyHistogram(LatencyHistogram *acc, const LatencyHistogram *h)
+{
+	for (int i = 0; i < LATENCY_NBUCKETS; i++)
+		acc->buckets[i] += h->buckets[i];
+}
+
+/*
+ * Extract one percentile (0.0 < p <= 1.0) from a histogram holding the given
+ * total number of values.  Returns the midpoint of the bucket containing the
+ * requested rank, in usec.
+ */
+static double
+latencyHistogramPercentile(const LatencyHistogram *h, int64 count, double p)
+{
+	int64		rank = (int64) ceil(p * count);
+	int64		seen = 0;
+
+	if (rank < 1)
+		rank = 1;
+
+	for (int idx = 0; idx < LATENCY_NBUCKETS; idx++)
+	{
+		seen += h->buckets[idx];
+		if (seen >= rank)
+		{
+			if (idx < LATENCY_SUBBUCKETS)
+				return (double) idx + 0.5;
+			else
+			{
+				int			bucket = idx >> LATENCY_SUBBUCKET_BITS;
+				int			sub = idx & (LATENCY_SUBBUCKETS - 1);
+				int64		lower;
+				int64		width;
+
+				width = (int64) 1 << (bucket - 1);
+				lower = (int64) (LATENCY_SUBBUCKETS + sub) << (bucket - 1);
+				return (double) lower + (double) width / 2.0;
+			}
+		}
+	}
+	return 0.0;					/* cannot happen if count > 0 */
+}
+
 /*
  * Initialize a StatsData struct to mostly zeroes, with its start time set to
  * the given value.
@@ -1469,6 +1554,7 @@ initStats(StatsData *sd, pg_time_usec_t start)
 	sd->deadlock_failures = 0;
 	initSimpleStats(&sd->latency);
 	initSimpleStats(&sd->lag);
+	memset(&sd->latency_hist, 0, sizeof(LatencyHistogram));
 }
 
 /*
@@ -1503,6 +1589,7 @@ accumStats(StatsData *stats, bool skipped, double lat, double lag,
 			stats->cnt++;
 
 			addToSimpleStats(&stats->latency, lat);
+			addToLatencyHistogram(&stats->latency_hist, lat);
 
 			/* and possibly the same for schedule lag */
 			if (throttle_delay)
@@ -6352,6 +6439,20 @@ printSimpleStats(const char *prefix, SimpleStats *ss)
 	}
 }
 
+static void
+printLatencyPercentiles(const char *prefix, const LatencyHistogram *h,
+						int64 count)
+{
+	if (count > 0)
+		printf("%s percentiles: p50 = %.3f ms, p90 = %.3f ms, p95 = %.3f ms, p99 = %.3f ms, p99.9 = %.3f ms\n",
+			   prefix,
+			   0.001 * latencyHistogramPercentile(h, count, 0.50),
+			   0.001 * latencyHistogramPercentile(h, count, 0.90),
+			   0.001 * latencyHistogramPercentile(h, count, 0.95),
+			   0.001 * latencyHistogramPercentile(h, count, 0.99),
+			   0.001 * latencyHistogramPercentile(h, count, 0.999));
+}
+
 /* print version banner */
 static void
 printVersion(PGconn *con)
@@ -6463,7 +6564,11 @@ printResults(StatsData *total,
 			   (total->cnt > 0) ? 100.0 * latency_late / total->cnt : 0.0);
 
 	if (throttle_delay || progress || latency_limit)
+	{
 		printSimpleStats("latency", &total->latency);
+		printLatencyPercentiles("latency", &total->latency_hist,
+								total->latency.count);
+	}
 	else
 	{
 		/* no measurement, show average latency computed from run time */
@@ -6568,6 +6673,8 @@ printResults(StatsData *total,
 
 				}
 				printSimpleStats(" - latency", &sstats->latency);
+			printLatencyPercentiles(" - latency", &sstats->latency_hist,
+									sstats->latency.count);
 			}
 
 			/*
@@ -7407,6 +7514,7 @@ main(int argc, char **argv)
 		/* aggregate thread level stats */
 		mergeSimpleStats(&stats.latency, &thread->stats.latency);
 		mergeSimpleStats(&stats.lag, &thread->stats.lag);
+		mergeLatencyHistogram(&stats.latency_hist, &thread->stats.latency_hist);
 		stats.cnt += thread->stats.cnt;
 		stats.skipped += thread->stats.skipped;
 		stats.retries += thread->stats.retries;
@@ -354,6 +354,16 @@ do_copy(const char *args)
 		}
 	}
 
+	/*
+	 * Bulk transfers go through stdio one data message at a time; with the
+	 * default stdio buffer that means a kernel call every few rows.  Use a
+	 * bigger buffer for file and program targets so large \copy runs make
+	 * fewer, larger read/write calls.  (We leave the terminal/session
+	 * streams alone.)
+	 */
+	if (options->file != NULL)
+		setvbuf(copystream, NULL, _IOFBF, 65536);
+
 	/* build the command we will send to the backend */
 	initPQExpBuffer(&query);
 	printfPQExpBuffer(&query, "COPY ");
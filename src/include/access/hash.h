@@ -25,8 +25,10 @@
 #include "lib/stringinfo.h"
 #include "storage/bufmgr.h"
 #include "storage/lockdefs.h"
+#include "storage/shm_toc.h"
 #include "utils/hsearch.h"
 #include "utils/relcache.h"
+#include "utils/tuplesort.h"
 
 /*
  * Mapping from hash bucket number to physical block number of bucket's
@@ -451,10 +453,12 @@ extern bool _hash_first(IndexScanDesc scan, ScanDirection dir);
 /* hashsort.c */
 typedef struct HSpool HSpool;	/* opaque struct in hashsort.c */
 
-extern HSpool *_h_spoolinit(Relation heap, Relation index, uint32 num_buckets);
+extern HSpool *_h_spoolinit(Relation heap, Relation index, uint32 num_buckets,
+							SortCoordinate coordinate, int sortmem);
 extern void _h_spooldestroy(HSpool *hspool);
 extern void _h_spool(HSpool *hspool, ItemPointer self,
 					 const Datum *values, const bool *isnull);
+extern void _h_performsort(HSpool *hspool);
 extern void _h_indexbuild(HSpool *hspool, Relation heapRel);
 
 /* hashutil.c */
@@ -479,6 +483,7 @@ extern Bucket _hash_get_newbucket_from_oldbucket(Relation rel, Bucket old_bucket
 extern void _hash_kill_items(IndexScanDesc scan);
 
 /* hash.c */
+extern void _h_parallel_build_main(dsm_segment *seg, shm_toc *toc);
 extern void hashbucketcleanup(Relation rel, Bucket cur_bucket,
 							  Buffer bucket_buf, BlockNumber bucket_blkno,
 							  BufferAccessStrategy bstrategy,
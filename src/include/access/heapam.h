@@ -399,6 +399,14 @@ extern void log_heap_prune_and_freeze(Relation relation, Buffer buffer,
 /* in heap/vacuumlazy.c */
 extern void heap_vacuum_rel(Relation rel,
 							const VacuumParams params, BufferAccessStrategy bstrategy);
+extern void heap_parallel_vacuum_heap_rel(Relation rel, TidStore *dead_items,
+										  VacDeadItemsInfo *dead_items_info,
+										  TransactionId oldest_xmin,
+										  BufferAccessStrategy bstrategy,
+										  int participant_id, int nparticipants,
+										  BlockNumber *vacuumed_pages,
+										  BlockNumber *vm_new_visible_pages,
+										  BlockNumber *vm_new_visible_frozen_pages);
 
 /* in heap/heapam_visibility.c */
 extern bool HeapTupleSatisfiesVisibility(HeapTuple htup, Snapshot snapshot,
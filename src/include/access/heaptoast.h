@@ -29,7 +29,11 @@
  * These symbols control toaster activation.  If a tuple is larger than
  * TOAST_TUPLE_THRESHOLD, we will try to toast it down to no more than
  * TOAST_TUPLE_TARGET bytes through compressing compressible fields and
- * moving EXTENDED and EXTERNAL data out-of-line.
+ * moving EXTENDED and EXTERNAL data out-of-line.  Both the activation
+ * threshold and the target can be lowered per relation with the
+ * toast_tuple_target reloption, which makes medium-sized compressible
+ * fields eligible for inline compression even though the tuple would
+ * otherwise be left alone.
  *
  * The numbers need not be the same, though they currently are.  It doesn't
  * make sense for TARGET to exceed THRESHOLD, but it could be useful to make
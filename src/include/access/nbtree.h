@@ -1067,6 +1067,14 @@ typedef struct BTScanOpaqueData
 	FmgrInfo   *orderProcs;		/* ORDER procs for required equality keys */
 	MemoryContext arrayContext; /* scan-lifespan context for array data */
 
+	/*
+	 * Leaf page reached by the previous _bt_first descent, if any.  Used as
+	 * a hint to avoid repeating the root-to-leaf descent when successive
+	 * primitive scans (e.g. ordered nested loop probes) land on the same
+	 * leaf page.  Revalidated against page contents before use.
+	 */
+	BlockNumber lastLeafBlkno;	/* or InvalidBlockNumber */
+
 	/* info about killed items if any (killedItems is NULL if never used) */
 	int		   *killedItems;	/* currPos.items indexes of killed items */
 	int			numKilled;		/* number of currently stored items */
@@ -159,6 +159,9 @@ typedef struct SpGistState
 
 	TransactionId redirectXid;	/* XID to use when creating a redirect tuple */
 	bool		isBuild;		/* true if doing index build */
+	bool		isBuildParallel;	/* true if parallel workers share the
+									 * build; forces the concurrent-safe
+									 * redirect handling despite isBuild */
 } SpGistState;
 
 /* Item to be re-examined later during a search */
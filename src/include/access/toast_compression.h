@@ -62,6 +62,8 @@ extern struct varlena *pglz_decompress_datum_slice(const struct varlena *value,
 /* lz4 compression/decompression routines */
 extern struct varlena *lz4_compress_datum(const struct varlena *value);
 extern struct varlena *lz4_decompress_datum(const struct varlena *value);
+extern int32 lz4_maximum_compressed_size(int32 slicelength,
+										 int32 total_compressed_size);
 extern struct varlena *lz4_decompress_datum_slice(const struct varlena *value,
 												  int32 slicelength);
 
@@ -15,6 +15,9 @@
 #define TRANSAM_H
 
 #include "access/xlogdefs.h"
+#ifndef FRONTEND
+#include "port/atomics.h"
+#endif
 
 
 /* ----------------
@@ -205,7 +208,11 @@ FullTransactionIdAdvance(FullTransactionId *dest)
  * Note: xidWrapLimit and oldestXidDB are not "active" values, but are
  * used just to generate useful messages when xidWarnLimit or xidStopLimit
  * are exceeded.
+ *
+ * It contains atomics, so hide it from frontend programs, some of which
+ * include this header; they only need the constants above.
  */
+#ifndef FRONTEND
 typedef struct TransamVariablesData
 {
 	/*
@@ -244,8 +251,12 @@ typedef struct TransamVariablesData
 	 * the server. This currently is solely used to check whether
 	 * GetSnapshotData() needs to recompute the contents of the snapshot, or
 	 * not. There are likely other users of this.  Always above 1.
+	 *
+	 * Incremented while holding ProcArrayLock exclusively.  Unlike the
+	 * fields above, this can also be read without any lock, by the snapshot
+	 * reuse fast path in GetSnapshotData(); see GetSnapshotDataReuse().
 	 */
-	uint64		xactCompletionCount;
+	pg_atomic_uint64 xactCompletionCount;
 
 	/*
 	 * These fields are protected by XactTruncationLock
@@ -253,6 +264,7 @@ typedef struct TransamVariablesData
 	TransactionId oldestClogXid;	/* oldest it's safe to look up in clog */
 
 } TransamVariablesData;
+#endif							/* FRONTEND */
 
 
 /* ----------------
@@ -263,8 +275,10 @@ typedef struct TransamVariablesData
 /* in transam/xact.c */
 extern bool TransactionStartedDuringRecovery(void);
 
+#ifndef FRONTEND
 /* in transam/varsup.c */
 extern PGDLLIMPORT TransamVariablesData *TransamVariables;
+#endif
 
 /*
  * prototypes for functions in transam/transam.c
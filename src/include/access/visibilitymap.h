@@ -38,6 +38,8 @@ extern uint8 visibilitymap_set(Relation rel,
 							   TransactionId cutoff_xid,
 							   uint8 flags);
 extern uint8 visibilitymap_get_status(Relation rel, BlockNumber heapBlk, Buffer *vmbuf);
+extern BlockNumber visibilitymap_next_unfrozen(Relation rel, BlockNumber heapBlk,
+											   BlockNumber bound, Buffer *vmbuf);
 extern void visibilitymap_count(Relation rel, BlockNumber *all_visible, BlockNumber *all_frozen);
 extern BlockNumber visibilitymap_prepare_truncate(Relation rel,
 												  BlockNumber nheapblocks);
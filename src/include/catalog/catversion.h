@@ -57,6 +57,6 @@
  */
 
 /*							yyyymmddN */
-#define CATALOG_VERSION_NO	202507091
+#define CATALOG_VERSION_NO	202508287
 
 #endif
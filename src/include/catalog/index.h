@@ -14,6 +14,7 @@
 #ifndef INDEX_H
 #define INDEX_H
 
+#include "access/tidstore.h"
 #include "catalog/objectaddress.h"
 #include "nodes/execnodes.h"
 
@@ -46,7 +47,7 @@ typedef struct ReindexParams
 /* state info for validate_index bulkdelete callback */
 typedef struct ValidateIndexState
 {
-	Tuplesortstate *tuplesort;	/* for sorting the index TIDs */
+	TidStore   *tids;			/* TIDs currently present in the index */
 	/* statistics (for debug purposes only): */
 	double		htups,
 				itups,
@@ -97,11 +97,10 @@
 #define PROGRESS_CREATEIDX_PHASE_BUILD			2
 #define PROGRESS_CREATEIDX_PHASE_WAIT_2			3
 #define PROGRESS_CREATEIDX_PHASE_VALIDATE_IDXSCAN	4
-#define PROGRESS_CREATEIDX_PHASE_VALIDATE_SORT		5
-#define PROGRESS_CREATEIDX_PHASE_VALIDATE_TABLESCAN	6
-#define PROGRESS_CREATEIDX_PHASE_WAIT_3			7
-#define PROGRESS_CREATEIDX_PHASE_WAIT_4			8
-#define PROGRESS_CREATEIDX_PHASE_WAIT_5			9
+#define PROGRESS_CREATEIDX_PHASE_VALIDATE_TABLESCAN	5
+#define PROGRESS_CREATEIDX_PHASE_WAIT_3			6
+#define PROGRESS_CREATEIDX_PHASE_WAIT_4			7
+#define PROGRESS_CREATEIDX_PHASE_WAIT_5			8
 
 /*
  * Subphases of CREATE INDEX, for index_build.
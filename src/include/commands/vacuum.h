@@ -394,6 +394,13 @@ extern void parallel_vacuum_cleanup_all_indexes(ParallelVacuumState *pvs,
 												long num_table_tuples,
 												int num_index_scans,
 												bool estimated_count);
+extern int	parallel_vacuum_heap_begin(ParallelVacuumState *pvs,
+									   TransactionId oldest_xmin,
+									   int *nworkers_launched);
+extern void parallel_vacuum_heap_end(ParallelVacuumState *pvs,
+									 BlockNumber *vacuumed_pages,
+									 BlockNumber *vm_new_visible_pages,
+									 BlockNumber *vm_new_visible_frozen_pages);
 extern void parallel_vacuum_main(dsm_segment *seg, shm_toc *toc);
 
 /* in commands/analyze.c */
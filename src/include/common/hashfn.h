@@ -26,6 +26,44 @@ extern uint64 hash_bytes_extended(const unsigned char *k,
 extern uint32 hash_bytes_uint32(uint32 k);
 extern uint64 hash_bytes_uint32_extended(uint32 k, uint64 seed);
 
+/*
+ * hash_bytes_uint32_inlined
+ *
+ * Inline equivalent of hash_bytes_uint32(), for hot paths where the
+ * out-of-line call is measurable.  The hand-unrolled mixing code below must
+ * produce exactly the same result as the final() macro in hashfn.c; since
+ * the values produced by these functions are effectively frozen (hash
+ * partitioning depends on them), duplicating the constants here carries no
+ * maintenance risk.
+ */
+static inline uint32
+hash_bytes_uint32_inlined(uint32 k)
+{
+	uint32		a,
+				b,
+				c;
+
+	a = b = c = 0x9e3779b9 + (uint32) sizeof(uint32) + 3923095;
+	a += k;
+
+	c ^= b;
+	c -= ((b << 14) | (b >> 18));
+	a ^= c;
+	a -= ((c << 11) | (c >> 21));
+	b ^= a;
+	b -= ((a << 25) | (a >> 7));
+	c ^= b;
+	c -= ((b << 16) | (b >> 16));
+	a ^= c;
+	a -= ((c << 4) | (c >> 28));
+	b ^= a;
+	b -= ((a << 14) | (a >> 18));
+	c ^= b;
+	c -= ((b << 24) | (b >> 8));
+
+	return c;
+}
+
 #ifndef FRONTEND
 static inline Datum
 hash_any(const unsigned char *k, int keylen)
@@ -29,6 +29,8 @@ struct JsonConstructorExprState;
 #define EEO_FLAG_INTERPRETER_INITIALIZED	(1 << 5)
 /* jump-threading is in use */
 #define EEO_FLAG_DIRECT_THREADED			(1 << 6)
+/* expression computes the cached value of an EEOP_STABLE_CONST step */
+#define EEO_FLAG_STABLE_CONST_SUBEXPR		(1 << 7)
 
 /* Typical API for out-of-line evaluation subroutines */
 typedef void (*ExecEvalSubroutine) (ExprState *state,
@@ -123,6 +125,18 @@ typedef enum ExprEvalOp
 	EEOP_FUNCEXPR_STRICT,
 	EEOP_FUNCEXPR_STRICT_1,
 	EEOP_FUNCEXPR_STRICT_2,
+
+	/*
+	 * Dedicated opcodes for some hot builtin comparison functions, evaluating
+	 * the comparison directly instead of calling the function.
+	 */
+	EEOP_FUNCEXPR_STRICT_INT4EQ,
+	EEOP_FUNCEXPR_STRICT_INT4NE,
+	EEOP_FUNCEXPR_STRICT_INT4LT,
+	EEOP_FUNCEXPR_STRICT_INT4LE,
+	EEOP_FUNCEXPR_STRICT_INT4GT,
+	EEOP_FUNCEXPR_STRICT_INT4GE,
+
 	EEOP_FUNCEXPR_FUSAGE,
 	EEOP_FUNCEXPR_STRICT_FUSAGE,
 
@@ -190,6 +204,13 @@ typedef enum ExprEvalOp
 	EEOP_NOT_DISTINCT,
 	EEOP_NULLIF,
 	EEOP_SQLVALUEFUNCTION,
+
+	/*
+	 * Evaluate a subexpression whose value cannot change during this
+	 * execution of the plan; the first evaluation's result is saved and
+	 * replayed on subsequent calls.
+	 */
+	EEOP_STABLE_CONST,
 	EEOP_CURRENTOFEXPR,
 	EEOP_NEXTVALUEEXPR,
 	EEOP_RETURNINGEXPR,
@@ -467,6 +488,17 @@ typedef struct ExprEvalStep
 			SQLValueFunction *svf;
 		}			sqlvaluefunction;
 
+		/* for EEOP_STABLE_CONST */
+		struct
+		{
+			ExprState  *exprstate;	/* subexpression to evaluate once */
+			bool		evaluated;	/* have we computed value/isnull yet? */
+			bool		isnull;
+			Datum		value;		/* saved result of first evaluation */
+			int16		typlen;		/* result type's typlen, for datumCopy */
+			bool		typbyval;	/* result type's typbyval */
+		}			stableconst;
+
 		/* for EEOP_NEXTVALUEEXPR */
 		struct
 		{
@@ -860,6 +892,8 @@ extern void ExecEvalParamExtern(ExprState *state, ExprEvalStep *op,
 								ExprContext *econtext);
 extern void ExecEvalCoerceViaIOSafe(ExprState *state, ExprEvalStep *op);
 extern void ExecEvalSQLValueFunction(ExprState *state, ExprEvalStep *op);
+extern void ExecEvalStableConst(ExprState *state, ExprEvalStep *op,
+								ExprContext *econtext);
 extern void ExecEvalCurrentOfExpr(ExprState *state, ExprEvalStep *op);
 extern void ExecEvalNextValueExpr(ExprState *state, ExprEvalStep *op);
 extern void ExecEvalRowNull(ExprState *state, ExprEvalStep *op,
@@ -117,6 +117,10 @@ typedef struct PartitionPruningData
  * partprunedata		Array of PartitionPruningData pointers for the plan's
  *						partitioned relation(s), one for each partitioning
  *						hierarchy that requires run-time pruning.
+ *
+ * The memo_* fields and execparammemo memoize the result of the last
+ * exec-time pruning run, keyed by the values of the "execparamids" Params;
+ * see ExecFindMatchingSubPlans.
  */
 typedef struct PartitionPruneState
 {
@@ -126,6 +130,13 @@ typedef struct PartitionPruneState
 	MemoryContext prune_context;
 	bool		do_initial_prune;
 	bool		do_exec_prune;
+	struct PartitionParamMemo *execparammemo;	/* last-seen Param values, or
+												 * NULL; private to
+												 * execPartition.c */
+	int			nexecparams;	/* number of entries in execparammemo */
+	Bitmapset  *memo_result;	/* subplans those values matched */
+	bool		memo_valid;		/* is memo_result usable? */
+	MemoryContext memo_cxt;		/* where the above are allocated */
 	int			num_partprunedata;
 	PartitionPruningData *partprunedata[FLEXIBLE_ARRAY_MEMBER];
 } PartitionPruneState;
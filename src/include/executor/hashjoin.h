@@ -14,6 +14,7 @@
 #ifndef HASHJOIN_H
 #define HASHJOIN_H
 
+#include "lib/bloomfilter.h"
 #include "nodes/execnodes.h"
 #include "port/atomics.h"
 #include "storage/barrier.h"
@@ -330,6 +331,7 @@ typedef struct HashJoinTableData
 	double		totalTuples;	/* # tuples obtained from inner plan */
 	double		partialTuples;	/* # tuples obtained from inner plan by me */
 	double		skewTuples;		/* # tuples inserted into skew tuples */
+	double		batchTuples;	/* # tuples in memory for current batch */
 
 	/*
 	 * These arrays are allocated for the life of the hash join, but only if
@@ -341,6 +343,14 @@ typedef struct HashJoinTableData
 	BufFile   **innerBatchFile; /* buffered virtual temp file per batch */
 	BufFile   **outerBatchFile; /* buffered virtual temp file per batch */
 
+	/*
+	 * Bloom filter over the hash values of all inner tuples, across all
+	 * batches, used to discard outer tuples that cannot possibly find a
+	 * match before writing them out to a batch file.  Only created for
+	 * initially multi-batch non-parallel hash joins; NULL otherwise.
+	 */
+	bloom_filter *bloomfilter;
+
 	Size		spaceUsed;		/* memory space currently used by tuples */
 	Size		spaceAllowed;	/* upper limit for space used */
 	Size		spacePeak;		/* peak space used */
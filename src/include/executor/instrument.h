@@ -118,4 +118,23 @@ extern void BufferUsageAccumDiff(BufferUsage *dst,
 extern void WalUsageAccumDiff(WalUsage *dst, const WalUsage *add,
 							  const WalUsage *sub);
 
+/*
+ * Sampling-based plan profiling, enabled by the plan_profile_interval GUC.
+ * A repeating timeout samples which plan node the backend is currently
+ * executing; the ExecProcNode wrappers keep InstrProfileCurrentId pointing
+ * at the active node (as plan_node_id + 1, zero meaning "none").  Sample
+ * counts are kept per plan_node_id, up to this many nodes; further nodes
+ * are simply not sampled.
+ */
+#define INSTR_PROFILE_MAX_NODES		1024
+
+/* GUC */
+extern PGDLLIMPORT int plan_profile_interval;
+
+extern PGDLLIMPORT volatile int InstrProfileCurrentId;
+
+extern bool InstrProfileStart(const void *owner);
+extern void InstrProfileStop(const void *owner);
+extern uint64 InstrProfileGetSamples(int plan_node_id);
+
 #endif							/* INSTRUMENT_H */
@@ -231,11 +231,13 @@ struct TupleTableSlotOps
  * same are used to identify the type of a given slot.
  */
 extern PGDLLIMPORT const TupleTableSlotOps TTSOpsVirtual;
+extern PGDLLIMPORT const TupleTableSlotOps TTSOpsColumnar;
 extern PGDLLIMPORT const TupleTableSlotOps TTSOpsHeapTuple;
 extern PGDLLIMPORT const TupleTableSlotOps TTSOpsMinimalTuple;
 extern PGDLLIMPORT const TupleTableSlotOps TTSOpsBufferHeapTuple;
 
 #define TTS_IS_VIRTUAL(slot) ((slot)->tts_ops == &TTSOpsVirtual)
+#define TTS_IS_COLUMNAR(slot) ((slot)->tts_ops == &TTSOpsColumnar)
 #define TTS_IS_HEAPTUPLE(slot) ((slot)->tts_ops == &TTSOpsHeapTuple)
 #define TTS_IS_MINIMALTUPLE(slot) ((slot)->tts_ops == &TTSOpsMinimalTuple)
 #define TTS_IS_BUFFERTUPLE(slot) ((slot)->tts_ops == &TTSOpsBufferHeapTuple)
@@ -254,6 +256,24 @@ typedef struct VirtualTupleTableSlot
 	char	   *data;			/* data for materialized slots */
 } VirtualTupleTableSlot;
 
+/*
+ * Column-major batch of tuples, exposing one row at a time through the
+ * regular slot protocol.  The gathered row is stored in virtual form, hence
+ * the embedded VirtualTupleTableSlot.
+ */
+typedef struct ColumnarTupleTableSlot
+{
+	pg_node_attr(abstract)
+
+	VirtualTupleTableSlot base;
+
+	int			maxrows;		/* allocated batch capacity */
+	int			nrows;			/* number of rows stored in the batch */
+	int			currow;			/* row currently exposed by the slot */
+	Datum	  **colvalues;		/* per-attribute value arrays */
+	bool	  **colnulls;		/* per-attribute null flag arrays */
+} ColumnarTupleTableSlot;
+
 typedef struct HeapTupleTableSlot
 {
 	pg_node_attr(abstract)
@@ -320,6 +340,9 @@ extern TupleTableSlot *MakeSingleTupleTableSlot(TupleDesc tupdesc,
 												const TupleTableSlotOps *tts_ops);
 extern void ExecDropSingleTupleTableSlot(TupleTableSlot *slot);
 extern void ExecSetSlotDescriptor(TupleTableSlot *slot, TupleDesc tupdesc);
+extern void ExecColumnarAllocBatch(TupleTableSlot *slot, int maxrows);
+extern TupleTableSlot *ExecStoreColumnarBatch(TupleTableSlot *slot, int nrows);
+extern bool ExecColumnarNextRow(TupleTableSlot *slot);
 extern TupleTableSlot *ExecStoreHeapTuple(HeapTuple tuple,
 										  TupleTableSlot *slot,
 										  bool shouldFree);
@@ -66,6 +66,9 @@ typedef struct LLVMJitContext
 	/* # of objects emitted, used to generate non-conflicting names */
 	int			counter;
 
+	/* deform functions already generated for the current module */
+	List	   *deform_cache;
+
 	/* list of handles for code emitted via Orc */
 	List	   *handles;
 } LLVMJitContext;
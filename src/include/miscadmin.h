@@ -277,7 +277,16 @@ extern PGDLLIMPORT int max_parallel_maintenance_workers;
 #define MIN_BAS_VAC_RING_SIZE_KB 128
 #define MAX_BAS_VAC_RING_SIZE_KB (16 * 1024 * 1024)
 
+/*
+ * Likewise for the BulkReadBufferUsageLimit GUC, which controls the ring
+ * used by large sequential scans.  -1 selects the automatic ring size
+ * computed by GetAccessStrategy().
+ */
+#define MIN_BAS_BULKREAD_RING_SIZE_KB 128
+#define MAX_BAS_BULKREAD_RING_SIZE_KB (16 * 1024 * 1024)
+
 extern PGDLLIMPORT int VacuumBufferUsageLimit;
+extern PGDLLIMPORT int BulkReadBufferUsageLimit;
 extern PGDLLIMPORT int VacuumCostPageHit;
 extern PGDLLIMPORT int VacuumCostPageMiss;
 extern PGDLLIMPORT int VacuumCostPageDirty;
@@ -722,6 +722,8 @@ typedef struct EState
 
 	int			es_top_eflags;	/* eflags passed to ExecutorStart */
 	int			es_instrument;	/* OR of InstrumentOption flags */
+	bool		es_plan_profiling;	/* sampling profiler active for this
+									 * query (see InstrProfileStart) */
 	bool		es_finished;	/* true when ExecutorFinish is done */
 
 	List	   *es_exprcontexts;	/* List of ExprContexts within EState */
@@ -998,6 +1000,15 @@ typedef struct SetExprState
 	 * argument values between calls, when setArgsValid is true.
 	 */
 	FunctionCallInfo fcinfo;
+
+	/*
+	 * ReturnSetInfo for ExecMakeFunctionResultSet's calls of a set-returning
+	 * function.  The fields that stay the same across all calls are filled
+	 * in by init_sexpr, so that only the per-call fields need to be reset
+	 * for each row.  (ExecMakeTableFunctionResult uses its own local
+	 * ReturnSetInfo instead, since it needs per-call allowedModes.)
+	 */
+	ReturnSetInfo rsinfo;
 } SetExprState;
 
 /* ----------------
@@ -1013,6 +1024,20 @@ typedef struct SubPlanState
 	ExprState  *testexpr;		/* state of combining expression */
 	HeapTuple	curTuple;		/* copy of most recent tuple from subplan */
 	Datum		curArray;		/* most recent array from ARRAY() subplan */
+	/* these are used when caching the result of a correlated subplan: */
+	bool		cache_enabled;	/* do we cache the most recent result? */
+	bool		cache_valid;	/* do the cache fields hold valid data? */
+	int			numCacheParams; /* number of correlation parameters */
+	int		   *cacheParamIds;	/* their param IDs */
+	int16	   *cacheParamLens; /* their typlens */
+	bool	   *cacheParamByVals;	/* their typbyvals */
+	Datum	   *cacheParamValues;	/* param values of cached evaluation */
+	bool	   *cacheParamNulls;	/* their null flags */
+	Datum		cacheResult;	/* result of cached evaluation */
+	bool		cacheResultNull;	/* its null flag */
+	int16		cacheResultLen; /* typlen of result */
+	bool		cacheResultByVal;	/* typbyval of result */
+	MemoryContext cacheContext; /* context holding cached values */
 	/* these are used when hashing the subselect's output: */
 	TupleDesc	descRight;		/* subselect desc after projection */
 	ProjectionInfo *projLeft;	/* for projecting lefthand exprs */
@@ -1527,6 +1552,7 @@ struct AppendState
  *		sortkeys		sort keys in SortSupport representation
  *		slots			current output tuple of each subplan
  *		heap			heap of active tuples
+ *		second			subplan with the heap's second-best tuple, or -1
  *		initialized		true if we have fetched first tuple from each subplan
  *		prune_state		details required to allow partitions to be
  *						eliminated from the scan, or NULL if not possible.
@@ -1543,6 +1569,7 @@ typedef struct MergeAppendState
 	SortSupport ms_sortkeys;	/* array of length ms_nkeys */
 	TupleTableSlot **ms_slots;	/* array of length ms_nplans */
 	struct binaryheap *ms_heap; /* binary heap of slot indices */
+	int32		ms_second;		/* index of second-best subplan, or -1 */
 	bool		ms_initialized; /* are subplans started? */
 	struct PartitionPruneState *ms_prune_state;
 	Bitmapset  *ms_valid_subplans;
@@ -1751,6 +1778,7 @@ typedef struct IndexScanState
  *		SharedInfo		   parallel worker instrumentation (no leader entry)
  *		TableSlot		   slot for holding tuples fetched from the table
  *		VMBuffer		   buffer in use for visibility map testing, if any
+ *		HeapFetchBlock	   last block we had to fetch from the heap, if any
  *		PscanLen		   size of parallel index-only scan descriptor
  *		NameCStringAttNums attnums of name typed columns to pad to NAMEDATALEN
  *		NameCStringCount   number of elements in the NameCStringAttNums array
@@ -1774,6 +1802,7 @@ typedef struct IndexOnlyScanState
 	SharedIndexScanInstrumentation *ioss_SharedInfo;
 	TupleTableSlot *ioss_TableSlot;
 	Buffer		ioss_VMBuffer;
+	BlockNumber ioss_HeapFetchBlock;
 	Size		ioss_PscanLen;
 	AttrNumber *ioss_NameCStringAttNums;
 	int			ioss_NameCStringCount;
@@ -1929,6 +1958,7 @@ typedef struct TidScanState
  *		trss_mintid			the lowest TID in the scan range
  *		trss_maxtid			the highest TID in the scan range
  *		trss_inScan			is a scan currently in progress?
+ *		trss_pscanlen		size of parallel heap scan descriptor
  * ----------------
  */
 typedef struct TidRangeScanState
@@ -1938,6 +1968,7 @@ typedef struct TidRangeScanState
 	ItemPointerData trss_mintid;
 	ItemPointerData trss_maxtid;
 	bool		trss_inScan;
+	Size		trss_pscanlen;
 } TidRangeScanState;
 
 /* ----------------
@@ -2065,6 +2096,7 @@ typedef struct CteScanState
 	/* The remaining fields are only valid in the "leader" CteScanState */
 	Tuplestorestate *cte_table; /* rows already read from the CTE query */
 	bool		eof_cte;		/* reached end of CTE query? */
+	int			nreaders;		/* # of CteScanStates sharing cte_table */
 } CteScanState;
 
 /* ----------------
@@ -2456,9 +2488,14 @@ typedef enum
 typedef struct IncrementalSortState
 {
 	ScanState	ss;				/* its first field is NodeTag */
+	bool		randomAccess;	/* need random access to full sort output? */
 	bool		bounded;		/* is the result set bounded? */
 	int64		bound;			/* if bounded, how many tuples are needed */
 	bool		outerNodeDone;	/* finished fetching tuples from outer node */
+	bool		fullsort_first_batch;	/* is the full sort state still on the
+										 * first batch of this scan? */
+	bool		fullsort_bounded;	/* was the full sort state's current batch
+									 * sorted with a bound applied? */
 	int64		bound_Done;		/* value of bound we did the sort with */
 	IncrementalSortExecutionStatus execution_status;
 	int64		n_fullsort_remaining;
@@ -2582,6 +2619,12 @@ typedef struct AggState
 	bool		hash_ever_spilled;	/* ever spilled during this execution? */
 	bool		hash_spill_mode;	/* we hit a limit during the current batch
 									 * and we must not create new groups */
+	bool		hash_release_on_done;	/* free hash tables once exhausted? */
+	bool		hash_table_released;	/* hash table memory freed? */
+	int64		hash_group_bound;	/* max groups needed, or -1 if no bound;
+									 * see ExecSetTupleBound */
+	int64		hash_group_bound_Done;	/* value of above when table was
+										 * filled */
 	Size		hash_mem_limit; /* limit before spilling hash table */
 	uint64		hash_ngroups_limit; /* limit before spilling hash table */
 	int			hash_planned_partitions;	/* number of partitions planned
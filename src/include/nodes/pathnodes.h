@@ -974,6 +974,8 @@ typedef struct RelOptInfo
 	double		allvisfrac;
 	/* indexes in PlannerInfo's eq_classes list of ECs that mention this rel */
 	Bitmapset  *eclass_indexes;
+	/* # of ECs accounted for in eclass_indexes; used for join rels only */
+	int			eclass_indexes_upto pg_node_attr(read_write_ignore);
 	PlannerInfo *subroot;		/* if subquery */
 	List	   *subplan_params; /* if subquery */
 	/* wanted number of parallel workers */
@@ -3258,6 +3260,9 @@ typedef struct MinMaxAggInfo
 	/* expression we are aggregating on */
 	Expr	   *target;
 
+	/* expression from the aggregate's FILTER clause, or NULL if none */
+	Expr	   *aggfilter;
+
 	/*
 	 * modified "root" for planning the subquery; not printed, too large, not
 	 * interesting enough
@@ -1102,6 +1102,9 @@ typedef struct SubPlan
 								 * simpler handling of null values */
 	bool		parallel_safe;	/* is the subplan parallel-safe? */
 	/* Note: parallel_safe does not consider contents of testexpr or args */
+	bool		cacheable;		/* is the subplan's result fully determined
+								 * by its parameters, i.e. is there no
+								 * volatile function anywhere within? */
 	/* Information for passing params into and out of the subselect: */
 	/* setParam and parParam are lists of integers (param IDs) */
 	List	   *setParam;		/* initplan and MULTIEXPR subqueries have to
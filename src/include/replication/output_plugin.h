@@ -96,6 +96,18 @@ typedef void (*LogicalDecodeMessageCB) (struct LogicalDecodingContext *ctx,
 typedef bool (*LogicalDecodeFilterByOriginCB) (struct LogicalDecodingContext *ctx,
 											   RepOriginId origin_id);
 
+/*
+ * Filter individual changes at decode time, before they are queued into the
+ * reorder buffer.  Returning true discards the change.
+ *
+ * This is called while the change's transaction is still in progress, so no
+ * historic snapshot is available: the callback must not access catalogs or
+ * user tables, and can only rely on the passed-in data.
+ */
+typedef bool (*LogicalDecodeFilterChangeCB) (struct LogicalDecodingContext *ctx,
+											 RelFileLocator *rlocator,
+											 ReorderBufferChange *change);
+
 /*
  * Called to shutdown an output plugin.
  */
@@ -222,6 +234,7 @@ typedef struct OutputPluginCallbacks
 	LogicalDecodeCommitCB commit_cb;
 	LogicalDecodeMessageCB message_cb;
 	LogicalDecodeFilterByOriginCB filter_by_origin_cb;
+	LogicalDecodeFilterChangeCB filter_change_cb;
 	LogicalDecodeShutdownCB shutdown_cb;
 
 	/* streaming of changes at prepare time */
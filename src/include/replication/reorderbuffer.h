@@ -668,6 +668,11 @@ struct ReorderBuffer
 	char	   *outbuf;
 	Size		outbufsize;
 
+	/* write-behind buffer for batching serialized changes spilled to disk */
+	char	   *spillbuf;
+	Size		spillbufsize;	/* allocated size of spillbuf */
+	Size		spillbytes;		/* bytes currently buffered in spillbuf */
+
 	/* memory accounting */
 	Size		size;
 
@@ -41,6 +41,7 @@
 /* GUC. */
 extern PGDLLIMPORT int dynamic_shared_memory_type;
 extern PGDLLIMPORT int min_dynamic_shared_memory;
+extern PGDLLIMPORT bool dsm_huge_pages;
 
 /*
  * Directory for on-disk state.
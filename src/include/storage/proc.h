@@ -412,8 +412,6 @@ typedef struct PROC_HDR
 	dlist_head	walsenderFreeProcs;
 	/* First pgproc waiting for group XID clear */
 	pg_atomic_uint32 procArrayGroupFirst;
-	/* First pgproc waiting for group transaction status update */
-	pg_atomic_uint32 clogGroupFirst;
 
 	/*
 	 * Current slot numbers of some auxiliary processes. There can be only one
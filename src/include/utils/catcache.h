@@ -90,20 +90,17 @@ typedef struct catctup
 	int			ct_magic;		/* for identifying CatCTup entries */
 #define CT_MAGIC   0x57261502
 
-	uint32		hash_value;		/* hash value for this tuple's keys */
-
-	/*
-	 * Lookup keys for the entry. By-reference datums point into the tuple for
-	 * positive cache entries, and are separately allocated for negative ones.
-	 */
-	Datum		keys[CATCACHE_MAXKEYS];
-
 	/*
 	 * Each tuple in a cache is a member of a dlist that stores the elements
 	 * of its hash bucket.  We keep each dlist in LRU order to speed repeated
 	 * lookups.
+	 *
+	 * The fields consulted while probing a bucket -- the list link, the hash
+	 * value, and the dead flag -- are kept adjacent, so that walking a chain
+	 * normally touches just one cache line per entry that doesn't match.
 	 */
 	dlist_node	cache_elem;		/* list member of per-bucket list */
+	uint32		hash_value;		/* hash value for this tuple's keys */
 
 	/*
 	 * A tuple marked "dead" must not be returned by subsequent searches.
@@ -117,9 +114,16 @@ typedef struct catctup
 	 * avoiding catalog searches is concerned.  Management of positive and
 	 * negative entries is identical.
 	 */
-	int			refcount;		/* number of active references */
 	bool		dead;			/* dead but not yet removed? */
 	bool		negative;		/* negative cache entry? */
+
+	/*
+	 * Lookup keys for the entry. By-reference datums point into the tuple for
+	 * positive cache entries, and are separately allocated for negative ones.
+	 */
+	Datum		keys[CATCACHE_MAXKEYS];
+
+	int			refcount;		/* number of active references */
 	HeapTupleData tuple;		/* tuple management header */
 
 	/*
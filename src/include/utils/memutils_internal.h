@@ -95,6 +95,18 @@ extern void BumpStats(MemoryContext context, MemoryStatsPrintFunc printfunc,
 extern void BumpCheck(MemoryContext context);
 #endif
 
+/*
+ * MemoryContextUpdatePeak
+ *		Maintain the high-water mark of mem_allocated.  The context-type-
+ *		specific code must call this after any increase of mem_allocated.
+ */
+static inline void
+MemoryContextUpdatePeak(MemoryContext context)
+{
+	if (context->mem_allocated > context->peak_allocated)
+		context->peak_allocated = context->mem_allocated;
+}
+
 /*
  * How many extra bytes do we need to request in order to ensure that we can
  * align a pointer to 'alignto'.  Since palloc'd pointers are already aligned
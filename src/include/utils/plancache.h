@@ -142,6 +142,8 @@ typedef struct CachedPlanSource
 	/* State kept to help decide whether to use custom or generic plans: */
 	double		generic_cost;	/* cost of generic plan, or -1 if not known */
 	double		total_custom_cost;	/* total cost of custom plans so far */
+	double		min_custom_cost;	/* cheapest custom plan seen so far */
+	double		max_custom_cost;	/* most expensive custom plan seen so far */
 	int64		num_custom_plans;	/* # of custom plans included in total */
 	int64		num_generic_plans;	/* # of generic plans */
 } CachedPlanSource;
@@ -170,6 +172,14 @@ typedef struct CachedPlan
 	int			generation;		/* parent's generation number for this plan */
 	int			refcount;		/* count of live references to this struct */
 	MemoryContext context;		/* context containing this CachedPlan */
+
+	/*
+	 * Lazily-built cache of output-function lookup data for the plan's
+	 * result columns, or NULL.  This is backend-local memoization managed
+	 * entirely by printtup.c; it lives in the plan's context and goes away
+	 * with the plan.
+	 */
+	void	   *result_outinfo;
 } CachedPlan;
 
 /*
@@ -354,6 +354,7 @@ typedef struct StdRdOptions
 	 * to freeze. 0 if disabled, -1 if unspecified.
 	 */
 	double		vacuum_max_eager_freeze_failure_rate;
+	bool		clustered_inserts;	/* place new row versions near old ones */
 } StdRdOptions;
 
 #define HEAP_MIN_FILLFACTOR			10
@@ -400,6 +401,15 @@ typedef struct StdRdOptions
 	  (relation)->rd_rel->relkind == RELKIND_MATVIEW) ? \
 	 ((StdRdOptions *) (relation)->rd_options)->user_catalog_table : false)
 
+/*
+ * RelationUsesClusteredInserts
+ *		Returns whether UPDATEs moving a row off its page should try to place
+ *		the new version nearby.  Note multiple eval of argument!
+ */
+#define RelationUsesClusteredInserts(relation)	\
+	((relation)->rd_options ? \
+	 ((StdRdOptions *) (relation)->rd_options)->clustered_inserts : false)
+
 /*
  * RelationGetParallelWorkers
  *		Returns the relation's parallel_workers reloption setting.
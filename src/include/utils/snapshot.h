@@ -207,6 +207,20 @@ typedef struct SnapshotData
 	 * transactions completed since the last GetSnapshotData().
 	 */
 	uint64		snapXactCompletionCount;
+
+	/*
+	 * Small cache of recent XidInMVCCSnapshot() lookups against this
+	 * snapshot.  The XIDs encountered while scanning a page cluster heavily,
+	 * so remembering the last few verdicts avoids most searches of the xip
+	 * and subxip arrays (and pg_subtrans lookups, if the snapshot
+	 * overflowed).  Any code that (re)fills the fields above for an MVCC
+	 * snapshot must reset xicCount to invalidate the cache.
+	 */
+#define XID_IN_SNAPSHOT_CACHE_SIZE	4
+	uint32		xicCount;		/* # of valid cache entries */
+	uint32		xicNext;		/* next cache slot to replace */
+	TransactionId xicXids[XID_IN_SNAPSHOT_CACHE_SIZE];
+	bool		xicVerdicts[XID_IN_SNAPSHOT_CACHE_SIZE];
 } SnapshotData;
 
 #endif							/* SNAPSHOT_H */
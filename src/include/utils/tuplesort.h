@@ -227,6 +227,16 @@ typedef struct
 	 */
 	bool		haveDatum1;
 
+	/*
+	 * Whether datum1 is a pass-by-value representation of the leading sort
+	 * key.  If so (or if datum1 holds an abbreviated key, which is always
+	 * pass-by-value), datum1 remains usable after the tuple it was extracted
+	 * from has been freed; dumptuples relies on this to decide whether a
+	 * newly sorted batch can extend the previous on-tape run.  Leave this
+	 * false when in doubt; it only disables that optimization.
+	 */
+	bool		datum1ByVal;
+
 	/*
 	 * The sortKeys variable is used by every case other than the hash index
 	 * case; it is set by tuplesort_begin_xxx.  tupDesc is only used by the
@@ -22,6 +22,31 @@ extern void pgstat_reset_wait_event_storage(void);
 
 extern PGDLLIMPORT uint32 *my_wait_event_info;
 
+/* GUC */
+extern PGDLLIMPORT bool track_wait_timing;
+
+/*
+ * Per-backend wait event timing, enabled by track_wait_timing.  Each timed
+ * wait is accumulated into a per-event histogram of log2(microsecond)
+ * buckets: bucket 0 counts waits shorter than one microsecond, bucket i
+ * waits of [2^(i-1), 2^i) microseconds, and the last bucket everything
+ * longer.
+ */
+#define WAIT_TIMING_NBUCKETS	24
+
+typedef struct WaitEventTiming
+{
+	uint32		wait_event_info;
+	uint64		count;			/* number of timed waits */
+	uint64		total_us;		/* total wait time, in microseconds */
+	uint64		buckets[WAIT_TIMING_NBUCKETS];
+} WaitEventTiming;
+
+extern void pgstat_wait_timing_start(uint32 wait_event_info);
+extern void pgstat_wait_timing_end(void);
+extern WaitEventTiming *pgstat_get_wait_timing(int *nentries);
+extern void pgstat_reset_wait_timing(void);
+
 
 /*
  * Wait Events - Extension, InjectionPoint
@@ -73,6 +98,9 @@ pgstat_report_wait_start(uint32 wait_event_info)
 	 * four-bytes, updates are atomic.
 	 */
 	*(volatile uint32 *) my_wait_event_info = wait_event_info;
+
+	if (unlikely(track_wait_timing))
+		pgstat_wait_timing_start(wait_event_info);
 }
 
 /* ----------
@@ -84,6 +112,9 @@ pgstat_report_wait_start(uint32 wait_event_info)
 static inline void
 pgstat_report_wait_end(void)
 {
+	if (unlikely(track_wait_timing))
+		pgstat_wait_timing_end();
+
 	/* see pgstat_report_wait_start() */
 	*(volatile uint32 *) my_wait_event_info = 0;
 }
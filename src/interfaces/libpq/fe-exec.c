@@ -1209,6 +1209,8 @@ pqRowProcessor(PGconn *conn, const char **errmsgp)
 	int			nfields = res->numAttributes;
 	const PGdataValue *columns = conn->rowBuf;
 	PGresAttValue *tup;
+	char	   *space;
+	size_t		offset;
 	int			i;
 
 	/*
@@ -1236,18 +1238,36 @@ pqRowProcessor(PGconn *conn, const char **errmsgp)
 
 	/*
 	 * Basically we just allocate space in the PGresult for each field and
-	 * copy the data over.
+	 * copy the data over.  To cut down per-row bookkeeping, compute the
+	 * space needed for the PGresAttValue array plus all the field values
+	 * up front, and grab it with a single pqResultAlloc call rather than
+	 * one call per field.  The array itself and any binary field value
+	 * must be aligned; text values can be packed on any byte boundary.
 	 *
 	 * Note: on malloc failure, we return 0 leaving *errmsgp still NULL, which
 	 * caller will take to mean "out of memory".  This is preferable to trying
 	 * to set up such a message here, because evidently there's not enough
 	 * memory for gettext() to do anything.
 	 */
-	tup = (PGresAttValue *)
-		pqResultAlloc(res, nfields * sizeof(PGresAttValue), true);
-	if (tup == NULL)
+	offset = nfields * sizeof(PGresAttValue);
+	for (i = 0; i < nfields; i++)
+	{
+		int			clen = columns[i].len;
+
+		if (clen < 0)
+			continue;			/* null field needs no space */
+		if (res->attDescs[i].format != 0 &&
+			offset % PGRESULT_ALIGN_BOUNDARY != 0)
+			offset += PGRESULT_ALIGN_BOUNDARY - offset % PGRESULT_ALIGN_BOUNDARY;
+		offset += (size_t) clen + 1;
+	}
+
+	space = (char *) pqResultAlloc(res, offset, true);
+	if (space == NULL)
 		return 0;
+	tup = (PGresAttValue *) space;
 
+	offset = nfields * sizeof(PGresAttValue);
 	for (i = 0; i < nfields; i++)
 	{
 		int			clen = columns[i].len;
@@ -1260,12 +1280,14 @@ pqRowProcessor(PGconn *conn, const char **errmsgp)
 		}
 		else
 		{
-			bool		isbinary = (res->attDescs[i].format != 0);
 			char	   *val;
 
-			val = (char *) pqResultAlloc(res, clen + 1, isbinary);
-			if (val == NULL)
-				return 0;
+			/* keep binary values aligned, matching the sizing loop above */
+			if (res->attDescs[i].format != 0 &&
+				offset % PGRESULT_ALIGN_BOUNDARY != 0)
+				offset += PGRESULT_ALIGN_BOUNDARY - offset % PGRESULT_ALIGN_BOUNDARY;
+			val = space + offset;
+			offset += (size_t) clen + 1;
 
 			/* copy and zero-terminate the data (even if it's binary) */
 			memcpy(val, columns[i].value, clen);
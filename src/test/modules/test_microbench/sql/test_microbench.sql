@@ -0,0 +1,16 @@
+CREATE EXTENSION test_microbench;
+
+--
+-- Run each benchmark for a handful of iterations, merely to verify that it
+-- executes; timings are machine-dependent, so show only the names.
+--
+SELECT name FROM test_microbench(NULL, 10) ORDER BY name;
+
+-- filtering by name
+SELECT name, iters FROM test_microbench('murmurhash32', 10);
+
+-- unknown names select nothing
+SELECT name FROM test_microbench('no_such_benchmark', 10);
+
+-- negative iteration counts are rejected
+SELECT name FROM test_microbench(NULL, -1);
@@ -0,0 +1,14 @@
+/* src/test/modules/test_microbench/test_microbench--1.0.sql */
+
+-- complain if script is sourced in psql, rather than via CREATE EXTENSION
+\echo Use "CREATE EXTENSION test_microbench" to load this file. \quit
+
+CREATE FUNCTION test_microbench(
+	filter pg_catalog.text DEFAULT NULL,
+	iterations pg_catalog.int8 DEFAULT 0,
+	OUT name pg_catalog.text,
+	OUT iters pg_catalog.int8,
+	OUT total_ms pg_catalog.float8,
+	OUT ns_per_op pg_catalog.float8)
+RETURNS SETOF record
+AS 'MODULE_PATHNAME' LANGUAGE C;
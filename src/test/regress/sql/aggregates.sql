@@ -998,6 +998,17 @@ from unnest('{fred,jim,fred,jack,jill,fred,jill,jim,jim,sheila,jim,sheila}'::tex
 select pg_collation_for(percentile_disc(1) within group (order by x collate "POSIX"))
   from (values ('fred'),('jim')) v(x);
 
+-- approx_percentile: results are approximate, so check against tolerances
+select approx_percentile(thousand, 0.5) between 450 and 550,
+       approx_percentile(thousand, 0.95) between 940 and 960,
+       approx_percentile(thousand, 0) = 0,
+       approx_percentile(thousand, 1) = 999
+from tenk1;
+select approx_percentile(x, 0.5) from (values (42.0)) v(x);
+select approx_percentile(x, 0.5) from (select null::float8) v(x);
+select approx_percentile(x, null) from (values (42.0)) v(x);
+select approx_percentile(x, 1.5) from (values (42.0)) v(x);  -- error
+
 -- ordered-set aggs created with CREATE AGGREGATE
 select test_rank(3) within group (order by x)
 from (values (1),(1),(2),(2),(3),(3),(4)) v(x);
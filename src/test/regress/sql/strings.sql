@@ -488,6 +488,28 @@ SELECT 'be_r' NOT LIKE 'b_e__r' ESCAPE '_' AS "false";
 SELECT 'be_r' LIKE '__e__r' ESCAPE '_' AS "false";
 SELECT 'be_r' NOT LIKE '__e__r' ESCAPE '_' AS "true";
 
+-- simple constant patterns (exact, prefix, suffix and infix fast paths)
+SELECT 'hawkeye' LIKE 'hawkeye' AS "true";
+SELECT 'hawkeye' NOT LIKE 'hawkeye' AS "false";
+
+SELECT 'hawkeye' LIKE 'hawkey' AS "false";
+SELECT 'hawkeye' NOT LIKE 'hawkey' AS "true";
+
+SELECT 'hawkeye' LIKE '%keye' AS "true";
+SELECT 'hawkeye' NOT LIKE '%keye' AS "false";
+
+SELECT 'hawkeye' LIKE '%wkey%' AS "true";
+SELECT 'hawkeye' NOT LIKE '%wkey%' AS "false";
+
+SELECT 'hawkeye' LIKE '%hawkeyes%' AS "false";
+SELECT 'hawkeye' NOT LIKE '%hawkeyes%' AS "true";
+
+SELECT 'hawkeye' LIKE '%%' AS "true";
+SELECT 'hawkeye' NOT LIKE '%%' AS "false";
+
+SELECT '' LIKE '' AS "true";
+SELECT '' NOT LIKE '' AS "false";
+
 
 --
 -- test ILIKE (case-insensitive LIKE)
@@ -509,6 +531,19 @@ SELECT 'Hawkeye' NOT ILIKE 'h%' AS "false";
 SELECT 'ABC'::name ILIKE '_b_' AS "true";
 SELECT 'ABC'::name NOT ILIKE '_b_' AS "false";
 
+-- simple constant patterns, case-insensitively
+SELECT 'Hawkeye' ILIKE '%WKEY%' AS "true";
+SELECT 'Hawkeye' NOT ILIKE '%WKEY%' AS "false";
+
+SELECT 'Hawkeye' ILIKE '%EYE' AS "true";
+SELECT 'Hawkeye' NOT ILIKE '%EYE' AS "false";
+
+SELECT 'Hawkeye' ILIKE 'HAWKEYE' AS "true";
+SELECT 'Hawkeye' NOT ILIKE 'HAWKEYE' AS "false";
+
+SELECT 'Hawkeye' ILIKE '%Hawkeyes%' AS "false";
+SELECT 'Hawkeye' NOT ILIKE '%Hawkeyes%' AS "true";
+
 --
 -- test %/_ combination cases, cf bugs #4821 and #5478
 --
@@ -1747,6 +1747,18 @@ SELECT i,AVG(v::numeric) OVER (ORDER BY i ROWS BETWEEN CURRENT ROW AND UNBOUNDED
 SELECT i,AVG(v::interval) OVER (ORDER BY i ROWS BETWEEN CURRENT ROW AND UNBOUNDED FOLLOWING)
   FROM (VALUES(1,'1 sec'),(2,'2 sec'),(3,NULL),(4,NULL)) t(i,v);
 
+-- test that MIN/MAX use their moving-aggregate multiset state to shrink
+-- the frame, including duplicate and NULL inputs
+SELECT i, MIN(v::int) OVER w, MAX(v::int) OVER w
+  FROM (VALUES(1,1),(2,3),(3,2),(4,NULL),(5,2),(6,5),(7,NULL)) t(i,v)
+  WINDOW w AS (ORDER BY i ROWS BETWEEN 1 PRECEDING AND CURRENT ROW);
+SELECT i, MIN(v) OVER w, MAX(v) OVER w
+  FROM (VALUES(1,'cherry'),(2,'apple'),(3,'pear'),(4,'banana')) t(i,v)
+  WINDOW w AS (ORDER BY i ROWS BETWEEN 1 PRECEDING AND CURRENT ROW);
+SELECT i, MIN(v::date) OVER w, MAX(v::date) OVER w
+  FROM (VALUES(1,'2024-01-03'),(2,'2024-01-01'),(3,'2024-01-05'),(4,NULL)) t(i,v)
+  WINDOW w AS (ORDER BY i ROWS BETWEEN 1 PRECEDING AND CURRENT ROW);
+
 -- moving aggregates over infinite intervals
 SELECT  x
         ,avg(x) OVER(ROWS BETWEEN CURRENT ROW AND 1 FOLLOWING ) as curr_next_avg